@@ -0,0 +1,170 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAtomicReferenceCount.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Has many threads register and unregister the same objects concurrently
+// and checks that no reference is lost and that shared objects are deleted
+// exactly once by whichever thread releases the last reference, after
+// invoking their delete event once.  This is done with an array, with an
+// information vector, which participates in garbage collection, and with a
+// reference loop that only the garbage collector can delete.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkInformation.h"
+#include "vtkInformationInformationVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkMultiThreader.h"
+#include "vtkWeakPointer.h"
+
+static const int NumberOfThreads = 16;
+static const int NumberOfIterations = 100000;
+
+struct vtkAtomicReferenceCountData
+{
+  vtkObjectBase* Object;
+};
+
+// Registers and unregisters the shared object many times, holding a few
+// references at once so that the count moves in both directions.
+static VTK_THREAD_RETURN_TYPE vtkRegisterUnRegisterThread(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkAtomicReferenceCountData* data =
+    static_cast<vtkAtomicReferenceCountData*>(info->UserData);
+  for (int i = 0; i < NumberOfIterations; ++i)
+    {
+    data->Object->Register(0);
+    data->Object->Register(0);
+    data->Object->UnRegister(0);
+    data->Object->Register(0);
+    data->Object->UnRegister(0);
+    data->Object->UnRegister(0);
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Releases one reference that was taken on behalf of this thread.  The
+// last thread to get here deletes the object.
+static VTK_THREAD_RETURN_TYPE vtkReleaseThread(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkAtomicReferenceCountData* data =
+    static_cast<vtkAtomicReferenceCountData*>(info->UserData);
+  for (int i = 0; i < NumberOfIterations; ++i)
+    {
+    data->Object->Register(0);
+    data->Object->UnRegister(0);
+    }
+  data->Object->UnRegister(0);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Counts the delete events of the shared object.  Only the thread that
+// releases the last reference invokes it.
+static void vtkCountDeleteEvents(vtkObject*, unsigned long, void* clientData,
+                                 void*)
+{
+  ++*static_cast<int*>(clientData);
+}
+
+// Races the threads of the threader on registering and unregistering
+// object, then on releasing its last reference.  Takes over the reference
+// of the caller.
+static int TestObject(vtkMultiThreader* threader, vtkObject* object)
+{
+  int numThreads = threader->GetNumberOfThreads();
+  int count = object->GetReferenceCount();
+  vtkAtomicReferenceCountData data;
+  data.Object = object;
+
+  int deleteEvents = 0;
+  vtkCallbackCommand* callback = vtkCallbackCommand::New();
+  callback->SetCallback(vtkCountDeleteEvents);
+  callback->SetClientData(&deleteEvents);
+  object->AddObserver(vtkCommand::DeleteEvent, callback);
+  callback->Delete();
+
+  // Balanced register/unregister calls leave the count unchanged.
+  threader->SetSingleMethod(vtkRegisterUnRegisterThread, &data);
+  threader->SingleMethodExecute();
+  if (object->GetReferenceCount() != count || deleteEvents != 0)
+    {
+    cerr << object->GetClassName() << ": expected a reference count of "
+         << count << ", got "
+         << object->GetReferenceCount() << " and " << deleteEvents
+         << " delete events" << endl;
+    object->Delete();
+    return 1;
+    }
+
+  // Hand one reference to each thread and drop our own, so that the
+  // threads race to release the last one.
+  vtkWeakPointer<vtkObject> weak = object;
+  for (int i = 0; i < numThreads; ++i)
+    {
+    object->Register(0);
+    }
+  object->Delete();
+  threader->SetSingleMethod(vtkReleaseThread, &data);
+  threader->SingleMethodExecute();
+
+  if (weak != 0)
+    {
+    cerr << "The shared " << weak->GetClassName()
+         << " was not deleted, reference count is "
+         << weak->GetReferenceCount() << endl;
+    return 1;
+    }
+  if (deleteEvents != 1)
+    {
+    cerr << "Expected 1 delete event, got " << deleteEvents << endl;
+    return 1;
+    }
+  return 0;
+}
+
+int TestAtomicReferenceCount(int, char*[])
+{
+  vtkMultiThreader* threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(NumberOfThreads);
+
+  int retVal = TestObject(threader, vtkIntArray::New());
+
+  // The references of an information vector are checked by the garbage
+  // collector whenever they are released.
+  vtkInformationVector* vector = vtkInformationVector::New();
+  vtkInformation* info = vtkInformation::New();
+  vector->Append(info);
+  info->Delete();
+  retVal |= TestObject(threader, vector);
+
+  // An information vector holding an information object that refers back
+  // to it.  Every release of an outside reference starts a collection
+  // check, which must not see the loop deleted under it by another thread.
+  // The key is deleted by the key manager of vtkCommon.
+  vtkInformationInformationVectorKey* loopKey =
+    new vtkInformationInformationVectorKey("Loop", "TestAtomicReferenceCount");
+  vtkInformationVector* loop = vtkInformationVector::New();
+  info = vtkInformation::New();
+  loop->Append(info);
+  info->Set(loopKey, loop);
+  info->Delete();
+  retVal |= TestObject(threader, loop);
+
+  threader->Delete();
+  return retVal;
+}
@@ -0,0 +1,208 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the LRU eviction of vtkDataArrayCache across clients, client
+// capacities, statistics and invalidation, and that concurrent clients
+// leave the cache consistent.
+
+#include "vtkDataArrayCache.h"
+#include "vtkDoubleArray.h"
+#include "vtkMultiThreader.h"
+
+#define CHECK(cond) \
+  if ( !(cond) ) \
+    { \
+    cerr << "Failed at line " << __LINE__ << ": " #cond << endl; \
+    return 1; \
+    }
+
+// Insert an array of the given size in MiB under a key and drop our
+// reference to it.
+static void InsertArray(vtkDataArrayCache* cache, int client, int time,
+  int arrayId, int sizeInMiB)
+{
+  vtkDoubleArray* arr = vtkDoubleArray::New();
+  arr->SetNumberOfTuples( sizeInMiB * 128 * 1024 );
+  arr->FillComponent( 0, time );
+  cache->Insert( client, vtkDataArrayCacheKey( time, 0, 0, arrayId ), arr );
+  arr->Delete();
+}
+
+static bool Has(vtkDataArrayCache* cache, int client, int time, int arrayId)
+{
+  vtkDataArray* arr = cache->Find(
+    client, vtkDataArrayCacheKey( time, 0, 0, arrayId ) );
+  if ( !arr )
+    {
+    return false;
+    }
+  arr->Delete();
+  return true;
+}
+
+struct vtkDataArrayCacheThreadData
+{
+  vtkDataArrayCache* Cache;
+  int Clients[4];
+  int Errors;
+};
+
+static VTK_THREAD_RETURN_TYPE vtkDataArrayCacheThread(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>( arg );
+  vtkDataArrayCacheThreadData* data =
+    static_cast<vtkDataArrayCacheThreadData*>( info->UserData );
+  int client = data->Clients[info->ThreadID];
+  for ( int i = 0; i < 200; ++i )
+    {
+    vtkDoubleArray* arr = vtkDoubleArray::New();
+    arr->SetNumberOfTuples( 16 * 1024 ); // 1/8 MiB
+    arr->FillComponent( 0, i % 20 );
+    data->Cache->Insert( client, vtkDataArrayCacheKey( i % 20, 0, 0, 0 ), arr );
+    arr->Delete();
+
+    // The array found stays valid while the other threads insert arrays
+    // and drop it from the cache.
+    int time = ( i * 7 ) % 20;
+    vtkDataArray* found =
+      data->Cache->Find( client, vtkDataArrayCacheKey( time, 0, 0, 0 ) );
+    if ( found )
+      {
+      for ( vtkIdType j = 0; j < found->GetNumberOfTuples(); j += 1024 )
+        {
+        if ( found->GetComponent( j, 0 ) != time )
+          {
+          data->Errors = 1;
+          }
+        }
+      found->Delete();
+      }
+    if ( i % 50 == 49 )
+      {
+      data->Cache->Invalidate( client, vtkDataArrayCacheKey( 0, 0, 0, 0 ),
+        vtkDataArrayCacheKey( 1, 0, 0, 0 ) );
+      }
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+int TestDataArrayCache(int, char *[])
+{
+  CHECK( vtkDataArrayCache::GetGlobalCache() != 0 );
+  CHECK( vtkDataArrayCache::GetGlobalCache() ==
+    vtkDataArrayCache::GetGlobalCache() );
+
+  vtkDataArrayCache* cache = vtkDataArrayCache::New();
+  cache->SetCapacity( 4. );
+  int a = cache->AddClient( "a" );
+  int b = cache->AddClient( "b" );
+  CHECK( a != b );
+
+  // Clients do not see each other's keys.
+  InsertArray( cache, a, 0, 0, 1 );
+  CHECK( Has( cache, a, 0, 0 ) );
+  CHECK( !Has( cache, b, 0, 0 ) );
+  CHECK( cache->GetNumberOfHits( a ) == 1 );
+  CHECK( cache->GetNumberOfMisses( b ) == 1 );
+  CHECK( cache->GetSize() == 1. );
+
+  // Eviction is least recently used across clients.
+  InsertArray( cache, b, 1, 0, 1 );
+  InsertArray( cache, a, 2, 0, 1 );
+  InsertArray( cache, b, 3, 0, 1 );
+  CHECK( cache->GetSize() == 4. );
+  CHECK( Has( cache, a, 0, 0 ) ); // a/0 is now the most recently used
+  InsertArray( cache, a, 4, 0, 1 );
+  CHECK( cache->GetSize() == 4. );
+  CHECK( !Has( cache, b, 1, 0 ) );
+  CHECK( Has( cache, a, 0, 0 ) );
+  CHECK( cache->GetNumberOfEvictions( b ) == 1 );
+  CHECK( cache->GetClientSize( a ) == 3. );
+  CHECK( cache->GetClientSize( b ) == 1. );
+
+  // A client capacity evicts the client's own arrays first.
+  cache->SetClientCapacity( b, 2. );
+  InsertArray( cache, b, 5, 0, 1 );
+  InsertArray( cache, b, 6, 0, 1 );
+  CHECK( !Has( cache, b, 3, 0 ) );
+  CHECK( cache->GetClientSize( b ) == 2. );
+  CHECK( cache->GetSize() <= 4. );
+
+  // Replacing an array keeps one entry for the key.
+  cache->SetClientCapacity( b, -1. );
+  cache->Clear( b );
+  CHECK( cache->GetClientSize( b ) == 0. );
+  InsertArray( cache, b, 7, 0, 1 );
+  InsertArray( cache, b, 7, 0, 1 );
+  CHECK( cache->GetClientSize( b ) == 1. );
+
+  // An array larger than the capacity is still kept until the next
+  // insertion.
+  InsertArray( cache, a, 8, 0, 8 );
+  CHECK( Has( cache, a, 8, 0 ) );
+  CHECK( cache->GetSize() == 8. );
+  InsertArray( cache, a, 9, 0, 1 );
+  CHECK( !Has( cache, a, 8, 0 ) );
+
+  // Invalidate by pattern only affects the given client.
+  cache->Clear( a );
+  cache->Clear( b );
+  for ( int i = 0; i < 3; ++i )
+    {
+    InsertArray( cache, a, 10, i, 0 );
+    InsertArray( cache, b, 10, i, 0 );
+    }
+  InsertArray( cache, a, 11, 0, 0 );
+  CHECK( cache->Invalidate( a, vtkDataArrayCacheKey( 10, 0, 0, 0 ),
+      vtkDataArrayCacheKey( 1, 0, 0, 0 ) ) == 3 );
+  CHECK( Has( cache, a, 11, 0 ) );
+  CHECK( Has( cache, b, 10, 2 ) );
+  CHECK( cache->Invalidate( b, vtkDataArrayCacheKey( 10, 0, 0, 1 ) ) == 1 );
+  CHECK( cache->Invalidate( b, vtkDataArrayCacheKey( 10, 0, 0, 1 ) ) == 0 );
+
+  cache->ResetStatistics();
+  CHECK( cache->GetNumberOfHits( -1 ) == 0 );
+  cache->RemoveClient( a );
+  cache->RemoveClient( b );
+  CHECK( cache->GetSize() == 0. );
+
+  // Concurrent clients.
+  vtkDataArrayCacheThreadData data;
+  data.Cache = cache;
+  data.Errors = 0;
+  cache->SetCapacity( 2. );
+  for ( int i = 0; i < 4; ++i )
+    {
+    data.Clients[i] = cache->AddClient( "thread" );
+    }
+  vtkMultiThreader* threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads( 4 );
+  threader->SetSingleMethod( vtkDataArrayCacheThread, &data );
+  threader->SingleMethodExecute();
+  threader->Delete();
+  double sum = 0.;
+  for ( int i = 0; i < 4; ++i )
+    {
+    sum += cache->GetClientSize( data.Clients[i] );
+    }
+  CHECK( sum == cache->GetSize() );
+  CHECK( cache->GetSize() <= 2. );
+  CHECK( data.Errors == 0 );
+  CHECK( cache->GetNumberOfHits( -1 ) + cache->GetNumberOfMisses( -1 ) == 800 );
+  cache->Print( cout );
+
+  cache->Delete();
+  return 0;
+}
@@ -0,0 +1,267 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMultiThreaderPool.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Runs many short SingleMethodExecute and MultipleMethodExecute calls
+// through the vtkMultiThreader thread pool and checks that every ThreadID
+// is used exactly once per call, that the methods of one call run
+// concurrently (they meet at a barrier) and that nested calls work.  Also
+// checks that SingleMethodExecute(numberOfTasks) runs every task once.
+
+#include "vtkConditionVariable.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+
+static const int NumberOfThreads = 8;
+static const int NumberOfNestedThreads = 3;
+static const int NumberOfExecutions = 200;
+static const int NumberOfTasks = 3 * VTK_MAX_THREADS + 5;
+
+// Counts the calls per ThreadID and lets the threads of one execution wait
+// for each other.
+struct vtkPoolTestData
+{
+  vtkSimpleMutexLock Lock;
+  vtkSimpleConditionVariable Condition;
+  int Calls[VTK_MAX_THREADS];
+  int Arrived;
+  int Generation;
+  int Errors;
+  int Nest;
+};
+
+static void vtkPoolTestBarrier(vtkPoolTestData *data, int numThreads)
+{
+  data->Lock.Lock();
+  int generation = data->Generation;
+  if (++data->Arrived == numThreads)
+    {
+    data->Arrived = 0;
+    data->Generation++;
+    data->Condition.Broadcast();
+    }
+  else
+    {
+    while (generation == data->Generation)
+      {
+      data->Condition.Wait(data->Lock);
+      }
+    }
+  data->Lock.Unlock();
+}
+
+// Counts the calls per task of SingleMethodExecute(numberOfTasks).
+struct vtkPoolTestTasks
+{
+  vtkSimpleMutexLock Lock;
+  int Calls[NumberOfTasks];
+  int Errors;
+};
+
+static VTK_THREAD_RETURN_TYPE vtkPoolTestTaskMethod(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkPoolTestTasks *tasks = static_cast<vtkPoolTestTasks *>(info->UserData);
+
+  tasks->Lock.Lock();
+  if (info->NumberOfThreads != NumberOfTasks ||
+      info->ThreadID < 0 || info->ThreadID >= NumberOfTasks)
+    {
+    tasks->Errors++;
+    }
+  else
+    {
+    tasks->Calls[info->ThreadID]++;
+    }
+  tasks->Lock.Unlock();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+static int vtkPoolTestCheckTasks(vtkPoolTestTasks *tasks, int numExecutions,
+                                 const char *what)
+{
+  int ok = (tasks->Errors == 0);
+  if (!ok)
+    {
+    cerr << what << ": " << tasks->Errors << " calls had a wrong ThreadInfo"
+         << endl;
+    }
+  for (int i = 0; i < NumberOfTasks; i++)
+    {
+    if (tasks->Calls[i] != numExecutions)
+      {
+      cerr << what << ": task " << i << " was run " << tasks->Calls[i]
+           << " times instead of " << numExecutions << endl;
+      ok = 0;
+      }
+    tasks->Calls[i] = 0;
+    }
+  tasks->Errors = 0;
+  return ok;
+}
+
+static VTK_THREAD_RETURN_TYPE vtkPoolTestMethod(void *arg);
+
+static void vtkPoolTestExecute(vtkPoolTestData *data, int numThreads,
+                               int multiple)
+{
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(numThreads);
+  if (multiple)
+    {
+    for (int i = 0; i < numThreads; i++)
+      {
+      threader->SetMultipleMethod(i, vtkPoolTestMethod, data);
+      }
+    threader->MultipleMethodExecute();
+    }
+  else
+    {
+    threader->SetSingleMethod(vtkPoolTestMethod, data);
+    threader->SingleMethodExecute();
+    }
+  threader->Delete();
+}
+
+static VTK_THREAD_RETURN_TYPE vtkPoolTestMethod(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkPoolTestData *data = static_cast<vtkPoolTestData *>(info->UserData);
+
+  data->Lock.Lock();
+  if (info->ThreadID < 0 || info->ThreadID >= info->NumberOfThreads)
+    {
+    data->Errors++;
+    }
+  else
+    {
+    data->Calls[info->ThreadID]++;
+    }
+  data->Lock.Unlock();
+
+  // This deadlocks unless all the methods of the execution run at once.
+  vtkPoolTestBarrier(data, info->NumberOfThreads);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Each thread of the outer execution runs an execution of its own.
+static VTK_THREAD_RETURN_TYPE vtkPoolTestNestedMethod(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkPoolTestData *data = static_cast<vtkPoolTestData *>(info->UserData);
+  vtkPoolTestExecute(&data[info->ThreadID + 1], NumberOfNestedThreads, 0);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+static int vtkPoolTestCheck(vtkPoolTestData *data, int numThreads,
+                            int numExecutions, const char *what)
+{
+  int ok = (data->Errors == 0);
+  for (int i = 0; i < numThreads; i++)
+    {
+    if (data->Calls[i] != numExecutions)
+      {
+      cerr << what << ": thread " << i << " was called " << data->Calls[i]
+           << " times instead of " << numExecutions << endl;
+      ok = 0;
+      }
+    data->Calls[i] = 0;
+    }
+  data->Errors = 0;
+  return ok;
+}
+
+int TestMultiThreaderPool(int, char *[])
+{
+  int ok = 1;
+  vtkPoolTestData data[NumberOfThreads + 1];
+  for (int i = 0; i <= NumberOfThreads; i++)
+    {
+    for (int j = 0; j < VTK_MAX_THREADS; j++)
+      {
+      data[i].Calls[j] = 0;
+      }
+    data[i].Arrived = 0;
+    data[i].Generation = 0;
+    data[i].Errors = 0;
+    }
+
+  int useThreadPool = vtkMultiThreader::GetGlobalUseThreadPool();
+  vtkMultiThreader::SetGlobalUseThreadPool(1);
+
+  int numThreads = NumberOfThreads;
+  if (numThreads > VTK_MAX_THREADS)
+    {
+    numThreads = VTK_MAX_THREADS;
+    }
+
+  int e;
+  for (e = 0; e < NumberOfExecutions; e++)
+    {
+    vtkPoolTestExecute(data, numThreads, 0);
+    }
+  ok &= vtkPoolTestCheck(data, numThreads, NumberOfExecutions,
+                         "SingleMethodExecute");
+
+  for (e = 0; e < NumberOfExecutions; e++)
+    {
+    vtkPoolTestExecute(data, numThreads, 1);
+    }
+  ok &= vtkPoolTestCheck(data, numThreads, NumberOfExecutions,
+                         "MultipleMethodExecute");
+
+  // nested executions need more threads than the pool keeps around
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(numThreads);
+  threader->SetSingleMethod(vtkPoolTestNestedMethod, data);
+  for (e = 0; e < NumberOfExecutions / 10; e++)
+    {
+    threader->SingleMethodExecute();
+    }
+  threader->Delete();
+  for (int i = 1; i <= numThreads; i++)
+    {
+    ok &= vtkPoolTestCheck(&data[i], NumberOfNestedThreads,
+                           NumberOfExecutions / 10, "Nested execution");
+    }
+
+  // more tasks than threads
+  vtkPoolTestTasks tasks;
+  for (int i = 0; i < NumberOfTasks; i++)
+    {
+    tasks.Calls[i] = 0;
+    }
+  tasks.Errors = 0;
+  threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(numThreads);
+  threader->SetSingleMethod(vtkPoolTestTaskMethod, &tasks);
+  for (e = 0; e < NumberOfExecutions; e++)
+    {
+    threader->SingleMethodExecute(NumberOfTasks);
+    }
+  ok &= vtkPoolTestCheckTasks(&tasks, NumberOfExecutions, "Tasks");
+
+  // the old code path still works
+  vtkMultiThreader::SetGlobalUseThreadPool(0);
+  vtkPoolTestExecute(data, numThreads, 0);
+  ok &= vtkPoolTestCheck(data, numThreads, 1, "Without the pool");
+  threader->SingleMethodExecute(NumberOfTasks);
+  ok &= vtkPoolTestCheckTasks(&tasks, 1, "Tasks without the pool");
+  threader->Delete();
+
+  vtkMultiThreader::SetGlobalUseThreadPool(useThreadPool);
+  return ok ? 0 : 1;
+}
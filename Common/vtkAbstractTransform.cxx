@@ -335,7 +335,7 @@ void vtkAbstractTransform::UnRegister(vtkObjectBase *o)
   if (this->InUnRegister)
     { // we don't want to go into infinite recursion...
     vtkDebugMacro(<<"UnRegister: circular reference eliminated"); 
-    this->ReferenceCount--;
+    this->DecrementReferenceCount();
     return;
     }
 
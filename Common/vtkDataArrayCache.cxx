@@ -0,0 +1,527 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArrayCache.h"
+
+#include "vtkCriticalSection.h"
+#include "vtkDataArray.h"
+#include "vtkObjectFactory.h"
+
+#include <vtkstd/list>
+#include <vtkstd/map>
+#include <vtkstd/string>
+
+vtkStandardNewMacro(vtkDataArrayCache);
+
+vtkDataArrayCache* vtkDataArrayCache::GlobalCache = 0;
+vtkDataArrayCacheCleanup vtkDataArrayCache::Cleanup;
+
+// Guards the creation of the global cache.
+static vtkSimpleCriticalSection vtkDataArrayCacheGlobalLock;
+
+//----------------------------------------------------------------------------
+// An array in the cache.  The entries of all clients are in one list in
+// least-recently-used order, the entries of each client also in a list
+// of its own, so that eviction is O(1) both across clients and within one.
+struct vtkDataArrayCacheEntry;
+typedef vtkstd::list<vtkDataArrayCacheEntry*> vtkDataArrayCacheLRU;
+
+struct vtkDataArrayCacheEntry
+{
+  int Client;
+  vtkDataArrayCacheKey Key;
+  vtkDataArray* Value;
+  double Size; // in MiB, as counted when inserted
+  vtkDataArrayCacheLRU::iterator LRUEntry;
+  vtkDataArrayCacheLRU::iterator ClientLRUEntry;
+};
+
+typedef vtkstd::map<vtkDataArrayCacheKey,vtkDataArrayCacheEntry*>
+  vtkDataArrayCacheSet;
+
+struct vtkDataArrayCacheClient
+{
+  vtkstd::string Name;
+  double Capacity;
+  double Size;
+  vtkDataArrayCacheSet Entries;
+  vtkDataArrayCacheLRU LRU;
+  unsigned long Hits;
+  unsigned long Misses;
+  unsigned long Evictions;
+
+  vtkDataArrayCacheClient()
+    : Capacity(-1.), Size(0.), Hits(0), Misses(0), Evictions(0) {}
+};
+
+typedef vtkstd::map<int,vtkDataArrayCacheClient> vtkDataArrayCacheClients;
+
+//----------------------------------------------------------------------------
+class vtkDataArrayCacheInternals
+{
+public:
+  vtkDataArrayCacheClients Clients;
+  // Most recently used first.
+  vtkDataArrayCacheLRU LRU;
+  int NextClient;
+
+  vtkDataArrayCacheInternals() : NextClient(0) {}
+
+  vtkDataArrayCacheClient* GetClient(int client)
+    {
+    vtkDataArrayCacheClients::iterator it = this->Clients.find(client);
+    return it == this->Clients.end() ? 0 : &it->second;
+    }
+
+  // Remove an entry from the cache and release its array.
+  void Drop(vtkDataArrayCacheEntry* entry, double& size, bool evicted)
+    {
+    vtkDataArrayCacheClient& client = this->Clients[entry->Client];
+    client.Entries.erase(entry->Key);
+    client.LRU.erase(entry->ClientLRUEntry);
+    this->LRU.erase(entry->LRUEntry);
+    client.Size = client.Entries.empty() ? 0. : client.Size - entry->Size;
+    size = this->LRU.empty() ? 0. : size - entry->Size;
+    if (evicted)
+      {
+      ++client.Evictions;
+      }
+    entry->Value->Delete();
+    delete entry;
+    }
+
+  // Make an entry the most recently used one.
+  void Touch(vtkDataArrayCacheEntry* entry)
+    {
+    vtkDataArrayCacheClient& client = this->Clients[entry->Client];
+    this->LRU.erase(entry->LRUEntry);
+    entry->LRUEntry = this->LRU.insert(this->LRU.begin(), entry);
+    client.LRU.erase(entry->ClientLRUEntry);
+    entry->ClientLRUEntry = client.LRU.insert(client.LRU.begin(), entry);
+    }
+
+  int ReduceToSize(double& size, double newSize)
+    {
+    int deletedSomething = 0;
+    while (size > newSize && !this->LRU.empty())
+      {
+      this->Drop(this->LRU.back(), size, true);
+      deletedSomething = 1;
+      }
+    return deletedSomething;
+    }
+
+  int ReduceClientToSize(vtkDataArrayCacheClient& client, double& size,
+    double newSize)
+    {
+    int deletedSomething = 0;
+    while (client.Size > newSize && !client.LRU.empty())
+      {
+      this->Drop(client.LRU.back(), size, true);
+      deletedSomething = 1;
+      }
+    return deletedSomething;
+    }
+};
+
+//----------------------------------------------------------------------------
+vtkDataArrayCacheCleanup::vtkDataArrayCacheCleanup()
+{
+}
+
+vtkDataArrayCacheCleanup::~vtkDataArrayCacheCleanup()
+{
+  // Destroy the global cache and the arrays it still holds.
+  if (vtkDataArrayCache::GlobalCache)
+    {
+    vtkDataArrayCache::GlobalCache->Delete();
+    vtkDataArrayCache::GlobalCache = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkDataArrayCache::vtkDataArrayCache()
+{
+  this->Capacity = 256.;
+  this->Size = 0.;
+  this->Internals = new vtkDataArrayCacheInternals;
+  this->Lock = new vtkSimpleCriticalSection;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArrayCache::~vtkDataArrayCache()
+{
+  this->Internals->ReduceToSize(this->Size, -1.);
+  delete this->Internals;
+  delete this->Lock;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArrayCache* vtkDataArrayCache::GetGlobalCache()
+{
+  vtkDataArrayCacheGlobalLock.Lock();
+  if (!vtkDataArrayCache::GlobalCache)
+    {
+    vtkDataArrayCache::GlobalCache = vtkDataArrayCache::New();
+    }
+  vtkDataArrayCacheGlobalLock.Unlock();
+  return vtkDataArrayCache::GlobalCache;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayCache::SetCapacity(double sizeInMiB)
+{
+  if (sizeInMiB < 0.)
+    {
+    sizeInMiB = 0.;
+    }
+  this->Lock->Lock();
+  if (this->Capacity == sizeInMiB)
+    {
+    this->Lock->Unlock();
+    return;
+    }
+  this->Capacity = sizeInMiB;
+  this->Internals->ReduceToSize(this->Size, this->Capacity);
+  this->Lock->Unlock();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+double vtkDataArrayCache::GetCapacity()
+{
+  this->Lock->Lock();
+  double capacity = this->Capacity;
+  this->Lock->Unlock();
+  return capacity;
+}
+
+//----------------------------------------------------------------------------
+double vtkDataArrayCache::GetSize()
+{
+  this->Lock->Lock();
+  double size = this->Size;
+  this->Lock->Unlock();
+  return size;
+}
+
+//----------------------------------------------------------------------------
+int vtkDataArrayCache::AddClient(const char* name)
+{
+  this->Lock->Lock();
+  int client = this->Internals->NextClient++;
+  this->Internals->Clients[client].Name = name ? name : "";
+  this->Lock->Unlock();
+  return client;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayCache::RemoveClient(int client)
+{
+  this->Lock->Lock();
+  vtkDataArrayCacheClient* info = this->Internals->GetClient(client);
+  if (info)
+    {
+    while (!info->LRU.empty())
+      {
+      this->Internals->Drop(info->LRU.back(), this->Size, false);
+      }
+    this->Internals->Clients.erase(client);
+    }
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayCache::SetClientCapacity(int client, double sizeInMiB)
+{
+  this->Lock->Lock();
+  vtkDataArrayCacheClient* info = this->Internals->GetClient(client);
+  if (info)
+    {
+    info->Capacity = sizeInMiB;
+    if (sizeInMiB >= 0.)
+      {
+      this->Internals->ReduceClientToSize(*info, this->Size, sizeInMiB);
+      }
+    }
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+double vtkDataArrayCache::GetClientCapacity(int client)
+{
+  this->Lock->Lock();
+  vtkDataArrayCacheClient* info = this->Internals->GetClient(client);
+  double capacity = info ? info->Capacity : -1.;
+  this->Lock->Unlock();
+  return capacity;
+}
+
+//----------------------------------------------------------------------------
+double vtkDataArrayCache::GetClientSize(int client)
+{
+  this->Lock->Lock();
+  vtkDataArrayCacheClient* info = this->Internals->GetClient(client);
+  double size = info ? info->Size : 0.;
+  this->Lock->Unlock();
+  return size;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayCache::Clear(int client)
+{
+  this->Lock->Lock();
+  vtkDataArrayCacheClient* info = this->Internals->GetClient(client);
+  if (info)
+    {
+    while (!info->LRU.empty())
+      {
+      this->Internals->Drop(info->LRU.back(), this->Size, false);
+      }
+    }
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkDataArrayCache::ReduceClientToSize(int client, double sizeInMiB)
+{
+  int deletedSomething = 0;
+  this->Lock->Lock();
+  vtkDataArrayCacheClient* info = this->Internals->GetClient(client);
+  if (info)
+    {
+    deletedSomething =
+      this->Internals->ReduceClientToSize(*info, this->Size, sizeInMiB);
+    }
+  this->Lock->Unlock();
+  return deletedSomething;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkDataArrayCache::GetNumberOfHits(int client)
+{
+  unsigned long n = 0;
+  this->Lock->Lock();
+  vtkDataArrayCacheClients::iterator it;
+  for (it = this->Internals->Clients.begin();
+       it != this->Internals->Clients.end(); ++it)
+    {
+    if (client < 0 || it->first == client)
+      {
+      n += it->second.Hits;
+      }
+    }
+  this->Lock->Unlock();
+  return n;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkDataArrayCache::GetNumberOfMisses(int client)
+{
+  unsigned long n = 0;
+  this->Lock->Lock();
+  vtkDataArrayCacheClients::iterator it;
+  for (it = this->Internals->Clients.begin();
+       it != this->Internals->Clients.end(); ++it)
+    {
+    if (client < 0 || it->first == client)
+      {
+      n += it->second.Misses;
+      }
+    }
+  this->Lock->Unlock();
+  return n;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkDataArrayCache::GetNumberOfEvictions(int client)
+{
+  unsigned long n = 0;
+  this->Lock->Lock();
+  vtkDataArrayCacheClients::iterator it;
+  for (it = this->Internals->Clients.begin();
+       it != this->Internals->Clients.end(); ++it)
+    {
+    if (client < 0 || it->first == client)
+      {
+      n += it->second.Evictions;
+      }
+    }
+  this->Lock->Unlock();
+  return n;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayCache::ResetStatistics()
+{
+  this->Lock->Lock();
+  vtkDataArrayCacheClients::iterator it;
+  for (it = this->Internals->Clients.begin();
+       it != this->Internals->Clients.end(); ++it)
+    {
+    it->second.Hits = 0;
+    it->second.Misses = 0;
+    it->second.Evictions = 0;
+    }
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayCache::Insert(int client, const vtkDataArrayCacheKey& key,
+  vtkDataArray* value)
+{
+  if (!value)
+    {
+    this->Invalidate(client, key);
+    return;
+    }
+
+  double vsize = value->GetActualMemorySize() / 1024.;
+
+  this->Lock->Lock();
+  vtkDataArrayCacheClient* info = this->Internals->GetClient(client);
+  if (!info)
+    {
+    this->Lock->Unlock();
+    vtkErrorMacro("Unknown cache client " << client << ".");
+    return;
+    }
+
+  vtkDataArrayCacheSet::iterator it = info->Entries.find(key);
+  if (it != info->Entries.end())
+    {
+    if (it->second->Value == value)
+      {
+      this->Internals->Touch(it->second);
+      this->Lock->Unlock();
+      return;
+      }
+    // Drop the array being replaced before making space for the new one.
+    this->Internals->Drop(it->second, this->Size, false);
+    }
+
+  if (info->Capacity >= 0.)
+    {
+    this->Internals->ReduceClientToSize(*info, this->Size,
+      info->Capacity - vsize);
+    }
+  this->Internals->ReduceToSize(this->Size, this->Capacity - vsize);
+
+  vtkDataArrayCacheEntry* entry = new vtkDataArrayCacheEntry;
+  entry->Client = client;
+  entry->Key = key;
+  entry->Value = value;
+  entry->Value->Register(0);
+  entry->Size = vsize;
+  entry->LRUEntry =
+    this->Internals->LRU.insert(this->Internals->LRU.begin(), entry);
+  entry->ClientLRUEntry = info->LRU.insert(info->LRU.begin(), entry);
+  info->Entries[key] = entry;
+  info->Size += vsize;
+  this->Size += vsize;
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray* vtkDataArrayCache::Find(int client,
+  const vtkDataArrayCacheKey& key)
+{
+  vtkDataArray* value = 0;
+  this->Lock->Lock();
+  vtkDataArrayCacheClient* info = this->Internals->GetClient(client);
+  if (info)
+    {
+    vtkDataArrayCacheSet::iterator it = info->Entries.find(key);
+    if (it != info->Entries.end())
+      {
+      this->Internals->Touch(it->second);
+      // Take a reference while no other thread can drop the array.
+      value = it->second->Value;
+      value->Register(0);
+      ++info->Hits;
+      }
+    else
+      {
+      ++info->Misses;
+      }
+    }
+  this->Lock->Unlock();
+  return value;
+}
+
+//----------------------------------------------------------------------------
+int vtkDataArrayCache::Invalidate(int client, const vtkDataArrayCacheKey& key)
+{
+  int dropped = 0;
+  this->Lock->Lock();
+  vtkDataArrayCacheClient* info = this->Internals->GetClient(client);
+  if (info)
+    {
+    vtkDataArrayCacheSet::iterator it = info->Entries.find(key);
+    if (it != info->Entries.end())
+      {
+      this->Internals->Drop(it->second, this->Size, false);
+      dropped = 1;
+      }
+    }
+  this->Lock->Unlock();
+  return dropped;
+}
+
+//----------------------------------------------------------------------------
+int vtkDataArrayCache::Invalidate(int client, const vtkDataArrayCacheKey& key,
+  const vtkDataArrayCacheKey& pattern)
+{
+  int nDropped = 0;
+  this->Lock->Lock();
+  vtkDataArrayCacheClient* info = this->Internals->GetClient(client);
+  if (info)
+    {
+    vtkDataArrayCacheSet::iterator it = info->Entries.begin();
+    while (it != info->Entries.end())
+      {
+      vtkDataArrayCacheEntry* entry = it->second;
+      ++it;
+      if (entry->Key.match(key, pattern))
+        {
+        this->Internals->Drop(entry, this->Size, false);
+        ++nDropped;
+        }
+      }
+    }
+  this->Lock->Unlock();
+  return nDropped;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  this->Lock->Lock();
+  os << indent << "Capacity: " << this->Capacity << " MiB\n";
+  os << indent << "Size: " << this->Size << " MiB\n";
+  os << indent << "Clients: " << this->Internals->Clients.size() << "\n";
+  vtkDataArrayCacheClients::iterator it;
+  for (it = this->Internals->Clients.begin();
+       it != this->Internals->Clients.end(); ++it)
+    {
+    const vtkDataArrayCacheClient& info = it->second;
+    os << indent.GetNextIndent() << it->first << " " << info.Name.c_str()
+       << ": " << info.Entries.size() << " arrays, " << info.Size << " MiB"
+       << ", Capacity " << info.Capacity << " MiB"
+       << ", Hits " << info.Hits << ", Misses " << info.Misses
+       << ", Evictions " << info.Evictions << "\n";
+    }
+  this->Lock->Unlock();
+}
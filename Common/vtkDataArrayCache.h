@@ -0,0 +1,230 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayCache.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkDataArrayCache - process-wide LRU cache of data arrays
+// .SECTION Description
+// vtkDataArrayCache keeps data arrays that readers have loaded so that
+// revisiting a time step, block or variable does not read the file
+// again.  There is one cache per process, returned by GetGlobalCache(),
+// and all readers share its memory budget (the capacity, in MiB).
+//
+// Each reader adds itself as a client with AddClient() and gets a client
+// id that namespaces its keys, so readers never see each other's arrays.
+// A key holds a time step, an object type, an object id and an array id;
+// what these mean is up to the client.  When an insertion would exceed
+// the capacity, the least recently used arrays are dropped, whichever
+// client they belong to.  A client may also be given a capacity of its
+// own, in which case its own least recently used arrays are dropped
+// first to stay within it.
+//
+// All methods may be called from any thread.  Find() returns a reference
+// that the caller owns, since another thread may drop the array from the
+// cache at any time.
+//
+// .SECTION See Also
+// vtkExodusIICache
+
+#ifndef __vtkDataArrayCache_h
+#define __vtkDataArrayCache_h
+
+#include "vtkObject.h"
+
+class vtkDataArray;
+class vtkDataArrayCacheInternals;
+class vtkSimpleCriticalSection;
+
+//BTX
+class VTK_COMMON_EXPORT vtkDataArrayCacheKey
+{
+public:
+  int Time;
+  int ObjectType;
+  int ObjectId;
+  int ArrayId;
+  vtkDataArrayCacheKey()
+    {
+    Time = -1;
+    ObjectType = -1;
+    ObjectId = -1;
+    ArrayId = -1;
+    }
+  vtkDataArrayCacheKey( int time, int objType, int objId, int arrId )
+    {
+    Time = time;
+    ObjectType = objType;
+    ObjectId = objId;
+    ArrayId = arrId;
+    }
+  vtkDataArrayCacheKey( const vtkDataArrayCacheKey& src )
+    {
+    Time = src.Time;
+    ObjectType = src.ObjectType;
+    ObjectId = src.ObjectId;
+    ArrayId = src.ArrayId;
+    }
+  bool match( const vtkDataArrayCacheKey&other, const vtkDataArrayCacheKey& pattern ) const
+    {
+    if ( pattern.Time && this->Time != other.Time )
+      return false;
+    if ( pattern.ObjectType && this->ObjectType != other.ObjectType )
+      return false;
+    if ( pattern.ObjectId && this->ObjectId != other.ObjectId )
+      return false;
+    if ( pattern.ArrayId && this->ArrayId != other.ArrayId )
+      return false;
+    return true;
+    }
+  bool operator < ( const vtkDataArrayCacheKey& other ) const
+    {
+    if ( this->Time < other.Time )
+      return true;
+    else if ( this->Time > other.Time )
+      return false;
+    if ( this->ObjectType < other.ObjectType )
+      return true;
+    else if ( this->ObjectType > other.ObjectType )
+      return false;
+    if ( this->ObjectId < other.ObjectId )
+      return true;
+    else if ( this->ObjectId > other.ObjectId )
+      return false;
+    if ( this->ArrayId < other.ArrayId )
+      return true;
+    return false;
+    }
+};
+
+class VTK_COMMON_EXPORT vtkDataArrayCacheCleanup
+{
+public:
+  vtkDataArrayCacheCleanup();
+  ~vtkDataArrayCacheCleanup();
+};
+//ETX
+
+class VTK_COMMON_EXPORT vtkDataArrayCache : public vtkObject
+{
+public:
+  static vtkDataArrayCache *New();
+  vtkTypeMacro(vtkDataArrayCache,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Return the cache shared by all readers of the process.  It is
+  // created on first use and deleted when the program exits.
+  static vtkDataArrayCache *GetGlobalCache();
+
+  // Description:
+  // Set/Get the maximum size of all arrays in the cache, in MiB.
+  // Reducing it drops least recently used arrays right away.  The
+  // default is 256.
+  void SetCapacity(double sizeInMiB);
+  double GetCapacity();
+
+  // Description:
+  // Get the current size of all arrays in the cache, in MiB.
+  double GetSize();
+
+  // Description:
+  // Add a client and return its id.  The name is only used when
+  // printing.  The capacity of the client is unlimited (negative) until
+  // set.
+  int AddClient(const char *name);
+
+  // Description:
+  // Drop all arrays of a client and forget the client.
+  void RemoveClient(int client);
+
+  // Description:
+  // Set/Get the maximum size of the arrays of one client, in MiB.  A
+  // negative capacity leaves the client bounded by the capacity of the
+  // cache only.
+  void SetClientCapacity(int client, double sizeInMiB);
+  double GetClientCapacity(int client);
+
+  // Description:
+  // Get the current size of the arrays of one client, in MiB.
+  double GetClientSize(int client);
+
+  // Description:
+  // Drop the arrays of one client.
+  void Clear(int client);
+
+  // Description:
+  // Drop the least recently used arrays of one client until its size is
+  // at or below the given size.  Returns nonzero if arrays were dropped.
+  int ReduceClientToSize(int client, double sizeInMiB);
+
+  // Description:
+  // Get the number of lookups that found an array, that found none and
+  // the number of arrays dropped to make space, for one client or, with
+  // a negative client id, for all clients.  ResetStatistics() sets them
+  // to zero.
+  unsigned long GetNumberOfHits(int client);
+  unsigned long GetNumberOfMisses(int client);
+  unsigned long GetNumberOfEvictions(int client);
+  void ResetStatistics();
+
+  //BTX
+  // Description:
+  // Insert an array for a key, replacing any array the key had.  This
+  // can drop other arrays to make space, but the inserted array is kept
+  // even if it alone exceeds the capacity.
+  void Insert(int client, const vtkDataArrayCacheKey& key,
+    vtkDataArray* value);
+
+  // Description:
+  // Return the array of a key, or NULL if the key has none, and mark it
+  // as most recently used.  The array is registered before it leaves the
+  // cache, so the caller must release it with Delete() when done.
+  vtkDataArray* Find(int client, const vtkDataArrayCacheKey& key);
+
+  // Description:
+  // Drop the array of a key.  Returns 1 if the key had an array and 0
+  // otherwise.
+  int Invalidate(int client, const vtkDataArrayCacheKey& key);
+
+  // Description:
+  // Drop the arrays of all keys matching a pattern and return their
+  // number.  Any nonzero member of the pattern forces a comparison of
+  // that member of the keys with the given key; a pattern of all zeros
+  // drops all arrays of the client.
+  int Invalidate(int client, const vtkDataArrayCacheKey& key,
+    const vtkDataArrayCacheKey& pattern);
+  //ETX
+
+protected:
+  vtkDataArrayCache();
+  ~vtkDataArrayCache();
+
+  double Capacity;
+  double Size;
+
+  vtkDataArrayCacheInternals *Internals;
+  vtkSimpleCriticalSection *Lock;
+
+  //BTX
+  // use this as a way of memory management when the program exits
+  static vtkDataArrayCacheCleanup Cleanup;
+  friend class vtkDataArrayCacheCleanup;
+  //ETX
+
+private:
+  static vtkDataArrayCache *GlobalCache;
+
+  vtkDataArrayCache(const vtkDataArrayCache&);  // Not implemented.
+  void operator=(const vtkDataArrayCache&);  // Not implemented.
+};
+
+#endif
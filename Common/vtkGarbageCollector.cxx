@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkGarbageCollector.h"
 
+#include "vtkCriticalSection.h"
 #include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointerBase.h"
@@ -75,6 +76,18 @@ static int vtkGarbageCollectorGlobalDebugFlag;
 // handle it.
 static vtkMultiThreaderIDType vtkGarbageCollectorMainThread;
 
+//----------------------------------------------------------------------------
+// Serializes the collection checks of several threads, which could
+// otherwise walk the same reference graph and delete the same objects at
+// once.  Collecting deletes objects whose destructors may start nested
+// checks, so the thread holding the lock and its nesting depth are kept
+// to let that thread in again.  These must be default initialized to zero
+// by the compiler.  The ClassInitialize and ClassFinalize methods handle
+// the lock.
+static vtkSimpleCriticalSection* vtkGarbageCollectorCollectLock;
+static vtkMultiThreaderIDType vtkGarbageCollectorCollectThread;
+static int vtkGarbageCollectorCollectDepth;
+
 //----------------------------------------------------------------------------
 vtkGarbageCollector::vtkGarbageCollector()
 {
@@ -849,6 +862,9 @@ void vtkGarbageCollector::ClassInitialize()
   // Allocate the singleton used for delayed collection in the main
   // thread.
   vtkGarbageCollectorSingletonInstance = new vtkGarbageCollectorSingleton;
+
+  // Allocate the lock serializing collection checks.
+  vtkGarbageCollectorCollectLock = new vtkSimpleCriticalSection;
 }
 
 //----------------------------------------------------------------------------
@@ -862,6 +878,9 @@ void vtkGarbageCollector::ClassFinalize()
   // longer.
   delete vtkGarbageCollectorSingletonInstance;
   vtkGarbageCollectorSingletonInstance = 0;
+
+  delete vtkGarbageCollectorCollectLock;
+  vtkGarbageCollectorCollectLock = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -892,6 +911,11 @@ void vtkGarbageCollector::Collect()
 //----------------------------------------------------------------------------
 void vtkGarbageCollector::Collect(vtkObjectBase* root)
 {
+  // Let one thread collect at a time, and that thread again when the
+  // check is nested.
+  vtkGarbageCollector::LockCollection();
+
+  {
   // Create a collector instance.
   vtkGarbageCollectorImpl collector;
 
@@ -901,6 +925,33 @@ void vtkGarbageCollector::Collect(vtkObjectBase* root)
   collector.CollectInternal(root);
 
   vtkDebugWithObjectMacro((&collector), "Finished collection check.");
+  }
+
+  vtkGarbageCollector::UnlockCollection();
+}
+
+//----------------------------------------------------------------------------
+void vtkGarbageCollector::LockCollection()
+{
+  vtkMultiThreaderIDType self = vtkMultiThreader::GetCurrentThreadID();
+  if(vtkGarbageCollectorCollectLock &&
+     !(vtkGarbageCollectorCollectDepth > 0 &&
+       vtkMultiThreader::ThreadsEqual(vtkGarbageCollectorCollectThread,
+                                      self)))
+    {
+    vtkGarbageCollectorCollectLock->Lock();
+    vtkGarbageCollectorCollectThread = self;
+    }
+  ++vtkGarbageCollectorCollectDepth;
+}
+
+//----------------------------------------------------------------------------
+void vtkGarbageCollector::UnlockCollection()
+{
+  if(--vtkGarbageCollectorCollectDepth == 0 && vtkGarbageCollectorCollectLock)
+    {
+    vtkGarbageCollectorCollectLock->Unlock();
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -118,7 +118,9 @@ public:
   // reference loop but are held by objects in the original component.
   // These removed references are handled as any other and their
   // corresponding checks may be deferred.  This method does continue
-  // collecting in this case.
+  // collecting in this case.  vtkObjectBase::UnRegister calls this from
+  // any thread that releases a reference to an object participating in
+  // garbage collection; the checks of several threads are serialized.
   static void Collect(vtkObjectBase* root);
 
   // Description:
@@ -161,6 +163,14 @@ private:
   // available, returns 0.
   static int TakeReference(vtkObjectBase* obj);
 
+  // Description:
+  // Serialize with the collection checks of other threads.  The thread
+  // holding the lock may lock it again.  vtkObjectBase holds it while it
+  // releases a reference to an object taking part in garbage collection,
+  // so the object is not deleted during a check started on it.
+  static void LockCollection();
+  static void UnlockCollection();
+
   // Singleton management functions.
   static void ClassInitialize();
   static void ClassFinalize();
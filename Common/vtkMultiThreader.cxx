@@ -18,6 +18,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkWindows.h"
 
+#include <vtkstd/vector>
+
 vtkStandardNewMacro(vtkMultiThreader);
 
 // These are the includes necessary for multithreaded rendering on an SGI
@@ -45,6 +47,15 @@ typedef vtkThreadFunctionType vtkExternCThreadFunctionType;
 #include <sys/sysctl.h>
 #endif
 
+// The thread pool is available with POSIX and Win32 threads.
+#if (defined(VTK_USE_PTHREADS) && !defined(VTK_HP_PTHREADS)) || \
+  defined(VTK_USE_WIN32_THREADS)
+#define VTK_MULTITHREADER_USE_POOL
+#include "vtkConditionVariable.h"
+#include <vtkstd/deque>
+static void vtkMultiThreaderPoolTrim();
+#endif
+
 // Initialize static member that controls global maximum number of threads
 static int vtkMultiThreaderGlobalMaximumNumberOfThreads = 0;
 
@@ -55,6 +66,10 @@ void vtkMultiThreader::SetGlobalMaximumNumberOfThreads(int val)
     return;
     }
   vtkMultiThreaderGlobalMaximumNumberOfThreads = val;
+#ifdef VTK_MULTITHREADER_USE_POOL
+  // let idle pool threads beyond the new maximum exit
+  vtkMultiThreaderPoolTrim();
+#endif
 }
 
 int vtkMultiThreader::GetGlobalMaximumNumberOfThreads()
@@ -143,6 +158,439 @@ int vtkMultiThreader::GetGlobalDefaultNumberOfThreads()
   return vtkMultiThreaderGlobalDefaultNumberOfThreads;
 }
 
+// Initialize static member that controls the use of the thread pool
+#ifdef VTK_MULTITHREADER_USE_POOL
+static int vtkMultiThreaderGlobalUseThreadPool = 1;
+#else
+static int vtkMultiThreaderGlobalUseThreadPool = 0;
+#endif
+
+void vtkMultiThreader::SetGlobalUseThreadPool(int val)
+{
+#ifdef VTK_MULTITHREADER_USE_POOL
+  vtkMultiThreaderGlobalUseThreadPool = (val != 0);
+#else
+  (void)val;
+#endif
+}
+
+int vtkMultiThreader::GetGlobalUseThreadPool()
+{
+  return vtkMultiThreaderGlobalUseThreadPool;
+}
+
+//----------------------------------------------------------------------------
+// Tasks of one execution.  Each thread running the execution takes the next
+// task that has not been started until none is left, so with as many
+// threads as tasks every task starts without waiting for another one to
+// finish, and with fewer threads the tasks are balanced among them.
+struct vtkMultiThreaderTasks
+{
+  vtkSimpleMutexLock Lock;
+  vtkThreadFunctionType *Methods; // one per task, or one for all of them
+  int SameMethod;
+  vtkMultiThreader::ThreadInfo *Infos;
+  int NumberOfTasks;
+  int NextTask;
+};
+
+static void vtkMultiThreaderRunTasks(vtkMultiThreaderTasks *tasks)
+{
+  for (;;)
+    {
+    tasks->Lock.Lock();
+    int i = tasks->NextTask;
+    if (i < tasks->NumberOfTasks)
+      {
+      tasks->NextTask++;
+      }
+    tasks->Lock.Unlock();
+    if (i >= tasks->NumberOfTasks)
+      {
+      return;
+      }
+    vtkThreadFunctionType method =
+      tasks->SameMethod ? tasks->Methods[0] : tasks->Methods[i];
+    method(static_cast<void *>(&tasks->Infos[i]));
+    }
+}
+
+// Thread method running the tasks passed as its UserData.
+static VTK_THREAD_RETURN_TYPE vtkMultiThreaderTaskRunner(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkMultiThreaderRunTasks(static_cast<vtkMultiThreaderTasks *>(info->UserData));
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+#ifdef VTK_MULTITHREADER_USE_POOL
+//----------------------------------------------------------------------------
+// Process-wide pool of worker threads used by SingleMethodExecute and
+// MultipleMethodExecute.  An execution queues one pool task per thread it
+// runs on; each pool task runs tasks of the execution (see
+// vtkMultiThreaderTasks) until none is left.  Each worker owns a queue of
+// pool tasks; they are dealt out to the queues round-robin, and a worker
+// takes them from the front of its own queue and steals from the back of
+// the others when it runs dry.
+//
+// The methods of one execution may wait on each other (barriers, condition
+// variables), so every pool task must start without waiting for another
+// one to finish.  The pool guarantees this by never having more queued
+// pool tasks than idle workers: Execute starts new workers when needed,
+// which also keeps nested executions (a method that itself calls
+// SingleMethodExecute) from deadlocking.
+
+// Completion state of the pool tasks queued by one execution.
+struct vtkMultiThreaderPoolBatch
+{
+  vtkSimpleMutexLock Lock;
+  vtkSimpleConditionVariable Done;
+  int Remaining;
+};
+
+// A thread of an execution run by a worker.
+struct vtkMultiThreaderPoolTask
+{
+  vtkMultiThreaderTasks *Tasks;
+  vtkMultiThreaderPoolBatch *Batch;
+};
+
+class vtkMultiThreaderPool;
+
+// A worker thread and its task queue.  Slots are reused when workers exit.
+struct vtkMultiThreaderPoolSlot
+{
+  vtkMultiThreaderPool *Pool;
+  int Id;
+  int InUse;
+  vtkSimpleMutexLock Lock;
+  vtkstd::deque<vtkMultiThreaderPoolTask> Tasks;
+};
+
+// Upper bound on the number of pool threads, including the extra workers
+// started for nested executions.  Beyond it executions fall back to
+// creating their own threads.
+#define VTK_MULTITHREADER_POOL_MAX_WORKERS (4 * VTK_MAX_THREADS)
+
+class vtkMultiThreaderPool
+{
+public:
+  vtkMultiThreaderPool();
+  ~vtkMultiThreaderPool();
+
+  // Run tasks on n threads: n-1 pool threads and the calling thread.
+  // Returns 0 without running anything if the pool could not start enough
+  // workers.
+  int Execute(vtkMultiThreaderTasks *tasks, int n);
+
+  // Wake idle workers so that those beyond the target count exit.
+  void Trim();
+
+  static VTK_THREAD_RETURN_TYPE WorkerMain(void *arg);
+
+protected:
+  int GetTargetNumberOfWorkers();
+  int StartWorker();
+  void RunWorker(vtkMultiThreaderPoolSlot *slot);
+  void TakeTask(vtkMultiThreaderPoolSlot *slot, int numberOfSlots,
+                vtkMultiThreaderPoolTask &task);
+
+  // Lock protects everything below except the slot queues, which have
+  // their own locks.  When both are needed Lock is taken first.
+  vtkSimpleMutexLock Lock;
+  vtkSimpleConditionVariable WorkAvailable;
+  vtkSimpleConditionVariable WorkerExited;
+  vtkMultiThreaderPoolSlot Slots[VTK_MULTITHREADER_POOL_MAX_WORKERS];
+  int NumberOfSlots;     // slots that have ever been used
+  int NextSlot;          // round-robin position for new tasks
+  int NumberOfWorkers;   // running worker threads
+  int NumberOfBusy;      // workers that have claimed or are running a task
+  int NumberOfQueued;    // tasks not yet claimed by a worker
+  int LargestExecution;  // most pool tasks queued at once
+  int ShutDown;
+};
+
+static vtkMultiThreaderPool *vtkMultiThreaderPoolInstance = 0;
+static vtkSimpleMutexLock vtkMultiThreaderPoolInstanceLock;
+
+// Shuts the pool down when the program exits.  On Windows the workers
+// have already been terminated by then (or, when the library is unloaded,
+// cannot exit while the loader lock is held), so the pool is left alone.
+class vtkMultiThreaderPoolCleanup
+{
+public:
+  ~vtkMultiThreaderPoolCleanup()
+    {
+#ifndef VTK_USE_WIN32_THREADS
+    delete vtkMultiThreaderPoolInstance;
+    vtkMultiThreaderPoolInstance = 0;
+#endif
+    }
+};
+static vtkMultiThreaderPoolCleanup vtkMultiThreaderPoolCleanupInstance;
+
+static vtkMultiThreaderPool *vtkMultiThreaderGetPool()
+{
+  vtkMultiThreaderPoolInstanceLock.Lock();
+  if (!vtkMultiThreaderPoolInstance)
+    {
+    vtkMultiThreaderPoolInstance = new vtkMultiThreaderPool;
+    }
+  vtkMultiThreaderPool *pool = vtkMultiThreaderPoolInstance;
+  vtkMultiThreaderPoolInstanceLock.Unlock();
+  return pool;
+}
+
+static void vtkMultiThreaderPoolTrim()
+{
+  vtkMultiThreaderPoolInstanceLock.Lock();
+  if (vtkMultiThreaderPoolInstance)
+    {
+    vtkMultiThreaderPoolInstance->Trim();
+    }
+  vtkMultiThreaderPoolInstanceLock.Unlock();
+}
+
+vtkMultiThreaderPool::vtkMultiThreaderPool()
+{
+  for (int i = 0; i < VTK_MULTITHREADER_POOL_MAX_WORKERS; i++)
+    {
+    this->Slots[i].Pool = this;
+    this->Slots[i].Id = i;
+    this->Slots[i].InUse = 0;
+    }
+  this->NumberOfSlots = 0;
+  this->NextSlot = 0;
+  this->NumberOfWorkers = 0;
+  this->NumberOfBusy = 0;
+  this->NumberOfQueued = 0;
+  this->LargestExecution = 0;
+  this->ShutDown = 0;
+}
+
+vtkMultiThreaderPool::~vtkMultiThreaderPool()
+{
+  this->Lock.Lock();
+  this->ShutDown = 1;
+  this->WorkAvailable.Broadcast();
+  while (this->NumberOfWorkers > 0)
+    {
+    this->WorkerExited.Wait(this->Lock);
+    }
+  this->Lock.Unlock();
+}
+
+int vtkMultiThreaderPool::GetTargetNumberOfWorkers()
+{
+  int max = vtkMultiThreader::GetGlobalMaximumNumberOfThreads();
+  if (max > 0)
+    {
+    return max - 1;
+    }
+  int target = vtkMultiThreader::GetGlobalDefaultNumberOfThreads() - 1;
+  return (this->LargestExecution > target ? this->LargestExecution : target);
+}
+
+void vtkMultiThreaderPool::Trim()
+{
+  this->Lock.Lock();
+  this->WorkAvailable.Broadcast();
+  this->Lock.Unlock();
+}
+
+// Must be called with Lock held.
+int vtkMultiThreaderPool::StartWorker()
+{
+  int id;
+  for (id = 0; id < VTK_MULTITHREADER_POOL_MAX_WORKERS; id++)
+    {
+    if (!this->Slots[id].InUse)
+      {
+      break;
+      }
+    }
+  if (id == VTK_MULTITHREADER_POOL_MAX_WORKERS)
+    {
+    return 0;
+    }
+  vtkMultiThreaderPoolSlot *slot = &this->Slots[id];
+
+#ifdef VTK_USE_WIN32_THREADS
+  DWORD threadId;
+  HANDLE handle = CreateThread(NULL, 0, vtkMultiThreaderPool::WorkerMain,
+                               static_cast<void *>(slot), 0, &threadId);
+  if (handle == NULL)
+    {
+    return 0;
+    }
+  CloseHandle(handle);
+#else
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+#if !defined(__CYGWIN__)
+  pthread_attr_setscope(&attr, PTHREAD_SCOPE_PROCESS);
+#endif
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  pthread_t thread;
+  int threadError =
+    pthread_create(&thread, &attr,
+                   reinterpret_cast<vtkExternCThreadFunctionType>(
+                     vtkMultiThreaderPool::WorkerMain),
+                   static_cast<void *>(slot));
+  pthread_attr_destroy(&attr);
+  if (threadError != 0)
+    {
+    return 0;
+    }
+#endif
+
+  slot->InUse = 1;
+  if (id >= this->NumberOfSlots)
+    {
+    this->NumberOfSlots = id + 1;
+    }
+  this->NumberOfWorkers++;
+  return 1;
+}
+
+int vtkMultiThreaderPool::Execute(vtkMultiThreaderTasks *tasks, int n)
+{
+  vtkMultiThreaderPoolBatch batch;
+  batch.Remaining = n - 1;
+
+  this->Lock.Lock();
+  if (n - 1 > this->LargestExecution)
+    {
+    this->LargestExecution = n - 1;
+    }
+  while (this->NumberOfWorkers - this->NumberOfBusy - this->NumberOfQueued <
+         n - 1)
+    {
+    if (!this->StartWorker())
+      {
+      this->Lock.Unlock();
+      return 0;
+      }
+    }
+  for (int i = 1; i < n; i++)
+    {
+    vtkMultiThreaderPoolTask task;
+    task.Tasks = tasks;
+    task.Batch = &batch;
+    vtkMultiThreaderPoolSlot *slot;
+    do
+      {
+      slot = &this->Slots[this->NextSlot];
+      this->NextSlot = (this->NextSlot + 1) % this->NumberOfSlots;
+      }
+    while (!slot->InUse);
+    slot->Lock.Lock();
+    slot->Tasks.push_back(task);
+    slot->Lock.Unlock();
+    }
+  this->NumberOfQueued += n - 1;
+  this->WorkAvailable.Broadcast();
+  this->Lock.Unlock();
+
+  // The calling thread takes its share of the tasks too.
+  vtkMultiThreaderRunTasks(tasks);
+
+  batch.Lock.Lock();
+  while (batch.Remaining > 0)
+    {
+    batch.Done.Wait(batch.Lock);
+    }
+  batch.Lock.Unlock();
+  return 1;
+}
+
+// Takes a task claimed by the worker owning slot, first from the front of
+// its own queue and otherwise from the back of another one.
+void vtkMultiThreaderPool::TakeTask(vtkMultiThreaderPoolSlot *slot,
+                                    int numberOfSlots,
+                                    vtkMultiThreaderPoolTask &task)
+{
+  slot->Lock.Lock();
+  if (!slot->Tasks.empty())
+    {
+    task = slot->Tasks.front();
+    slot->Tasks.pop_front();
+    slot->Lock.Unlock();
+    return;
+    }
+  slot->Lock.Unlock();
+
+  // A claimed task is always queued somewhere, but another worker may get
+  // to it first, in which case the one it leaves behind is found on the
+  // next pass.
+  for (int i = slot->Id + 1; ; i++)
+    {
+    vtkMultiThreaderPoolSlot *victim = &this->Slots[i % numberOfSlots];
+    victim->Lock.Lock();
+    if (!victim->Tasks.empty())
+      {
+      task = victim->Tasks.back();
+      victim->Tasks.pop_back();
+      victim->Lock.Unlock();
+      return;
+      }
+    victim->Lock.Unlock();
+    }
+}
+
+void vtkMultiThreaderPool::RunWorker(vtkMultiThreaderPoolSlot *slot)
+{
+  this->Lock.Lock();
+  for (;;)
+    {
+    while (!this->ShutDown && this->NumberOfQueued == 0 &&
+           this->NumberOfWorkers <= this->GetTargetNumberOfWorkers())
+      {
+      this->WorkAvailable.Wait(this->Lock);
+      }
+    if (this->NumberOfQueued == 0)
+      {
+      // shutting down or surplus to requirements
+      break;
+      }
+
+    // Claim a task; the claim guarantees that one is queued for us.
+    this->NumberOfQueued--;
+    this->NumberOfBusy++;
+    int numberOfSlots = this->NumberOfSlots;
+    this->Lock.Unlock();
+
+    vtkMultiThreaderPoolTask task;
+    this->TakeTask(slot, numberOfSlots, task);
+    vtkMultiThreaderRunTasks(task.Tasks);
+
+    vtkMultiThreaderPoolBatch *batch = task.Batch;
+    batch->Lock.Lock();
+    if (--batch->Remaining == 0)
+      {
+      batch->Done.Signal();
+      }
+    batch->Lock.Unlock();
+
+    this->Lock.Lock();
+    this->NumberOfBusy--;
+    }
+
+  slot->InUse = 0;
+  this->NumberOfWorkers--;
+  this->WorkerExited.Broadcast();
+  this->Lock.Unlock();
+}
+
+VTK_THREAD_RETURN_TYPE vtkMultiThreaderPool::WorkerMain(void *arg)
+{
+  vtkMultiThreaderPoolSlot *slot = static_cast<vtkMultiThreaderPoolSlot *>(arg);
+  slot->Pool->RunWorker(slot);
+  return VTK_THREAD_RETURN_VALUE;
+}
+#endif
+
 // Constructor. Default all the methods to NULL. Since the
 // ThreadInfoArray is static, the ThreadIDs can be initialized here
 // and will not change.
@@ -259,6 +707,28 @@ void vtkMultiThreader::SingleMethodExecute()
     this->NumberOfThreads = vtkMultiThreaderGlobalMaximumNumberOfThreads;
     }
   
+#ifdef VTK_MULTITHREADER_USE_POOL
+  // Hand the work to the thread pool when it is enabled.  If it cannot
+  // provide enough threads, fall back to creating them below.
+  if (vtkMultiThreaderGlobalUseThreadPool && this->NumberOfThreads > 1)
+    {
+    for (thread_loop = 0; thread_loop < this->NumberOfThreads; thread_loop++)
+      {
+      this->ThreadInfoArray[thread_loop].UserData        = this->SingleData;
+      this->ThreadInfoArray[thread_loop].NumberOfThreads = this->NumberOfThreads;
+      }
+    vtkMultiThreaderTasks tasks;
+    tasks.Methods = &this->SingleMethod;
+    tasks.SameMethod = 1;
+    tasks.Infos = this->ThreadInfoArray;
+    tasks.NumberOfTasks = this->NumberOfThreads;
+    tasks.NextTask = 0;
+    if (vtkMultiThreaderGetPool()->Execute(&tasks, this->NumberOfThreads))
+      {
+      return;
+      }
+    }
+#endif
     
   // We are using sproc (on SGIs), pthreads(on Suns), or a single thread
   // (the default)  
@@ -413,6 +883,69 @@ void vtkMultiThreader::SingleMethodExecute()
 #endif
 }
 
+// Execute the method set as the SingleMethod for numberOfTasks tasks on at
+// most NumberOfThreads threads.
+void vtkMultiThreader::SingleMethodExecute(int numberOfTasks)
+{
+  if ( !this->SingleMethod )
+    {
+    vtkErrorMacro( << "No single method set!" );
+    return;
+    }
+  if ( numberOfTasks < 1 )
+    {
+    return;
+    }
+
+  int numberOfThreads = this->GetNumberOfThreads();
+  if (numberOfThreads > numberOfTasks)
+    {
+    numberOfThreads = numberOfTasks;
+    }
+
+  vtkstd::vector<ThreadInfo> infos(numberOfTasks);
+  for (int i = 0; i < numberOfTasks; i++)
+    {
+    infos[i].ThreadID        = i;
+    infos[i].NumberOfThreads = numberOfTasks;
+    infos[i].ActiveFlag      = NULL;
+    infos[i].ActiveFlagLock  = NULL;
+    infos[i].UserData        = this->SingleData;
+    }
+  vtkThreadFunctionType method = this->SingleMethod;
+  vtkMultiThreaderTasks tasks;
+  tasks.Methods = &method;
+  tasks.SameMethod = 1;
+  tasks.Infos = &infos[0];
+  tasks.NumberOfTasks = numberOfTasks;
+  tasks.NextTask = 0;
+
+  if (numberOfThreads == 1)
+    {
+    vtkMultiThreaderRunTasks(&tasks);
+    return;
+    }
+
+#ifdef VTK_MULTITHREADER_USE_POOL
+  if (vtkMultiThreaderGlobalUseThreadPool &&
+      vtkMultiThreaderGetPool()->Execute(&tasks, numberOfThreads))
+    {
+    return;
+    }
+#endif
+
+  // Otherwise start threads that run the tasks as their single method.
+  void *data = this->SingleData;
+  int numThreads = this->NumberOfThreads;
+  this->SingleMethod = vtkMultiThreaderTaskRunner;
+  this->SingleData = &tasks;
+  this->NumberOfThreads = numberOfThreads;
+  this->SingleMethodExecute();
+  this->SingleMethod = method;
+  this->SingleData = data;
+  this->NumberOfThreads = numThreads;
+}
+
 void vtkMultiThreader::MultipleMethodExecute()
 {
   int                thread_loop;
@@ -448,6 +981,30 @@ void vtkMultiThreader::MultipleMethodExecute()
       }
     }
 
+#ifdef VTK_MULTITHREADER_USE_POOL
+  // Hand the work to the thread pool when it is enabled.  If it cannot
+  // provide enough threads, fall back to creating them below.
+  if (vtkMultiThreaderGlobalUseThreadPool && this->NumberOfThreads > 1)
+    {
+    for (thread_loop = 0; thread_loop < this->NumberOfThreads; thread_loop++)
+      {
+      this->ThreadInfoArray[thread_loop].UserData = 
+        this->MultipleData[thread_loop];
+      this->ThreadInfoArray[thread_loop].NumberOfThreads = this->NumberOfThreads;
+      }
+    vtkMultiThreaderTasks tasks;
+    tasks.Methods = this->MultipleMethod;
+    tasks.SameMethod = 0;
+    tasks.Infos = this->ThreadInfoArray;
+    tasks.NumberOfTasks = this->NumberOfThreads;
+    tasks.NextTask = 0;
+    if (vtkMultiThreaderGetPool()->Execute(&tasks, this->NumberOfThreads))
+      {
+      return;
+      }
+    }
+#endif
+
   // We are using sproc (on SGIs), pthreads(on Suns), CreateThread
   // on a PC or a single thread (the default)  
 
@@ -829,6 +1386,8 @@ void vtkMultiThreader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Thread Count: " << this->NumberOfThreads << "\n";
   os << indent << "Global Maximum Number Of Threads: " << 
     vtkMultiThreaderGlobalMaximumNumberOfThreads << endl;
+  os << indent << "Global Use Thread Pool: " << 
+    vtkMultiThreaderGlobalUseThreadPool << endl;
   os << "Thread system used: " <<
 #ifdef VTK_USE_PTHREADS  
    "PTHREADS"
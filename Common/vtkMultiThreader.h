@@ -18,6 +18,10 @@
 // execution using sproc() on an SGI, or pthread_create on any platform
 // supporting POSIX threads.  This class can be used to execute a single
 // method on multiple threads, or to specify a method per thread. 
+// With POSIX or Win32 threads, SingleMethodExecute and MultipleMethodExecute
+// hand their methods to a persistent, process-wide pool of worker threads
+// instead of creating and joining new threads on every call (see
+// SetGlobalUseThreadPool).
 
 #ifndef __vtkMultiThreader_h
 #define __vtkMultiThreader_h
@@ -100,7 +104,9 @@ public:
   // The ThreadID is a number between 0 and NumberOfThreads-1 that indicates
   // the id of this thread. The NumberOfThreads is this->NumberOfThreads for
   // threads created from SingleMethodExecute or MultipleMethodExecute,
-  // and it is 1 for threads created from SpawnThread.
+  // the number of tasks for SingleMethodExecute(numberOfTasks), in which
+  // case the ThreadID is the index of the task, and it is 1 for threads
+  // created from SpawnThread.
   // The UserData is the (void *)arg passed into the SetSingleMethod,
   // SetMultipleMethod, or SpawnThread method.
 
@@ -138,6 +144,19 @@ public:
   static void SetGlobalDefaultNumberOfThreads(int val);
   static int  GetGlobalDefaultNumberOfThreads();
 
+  // Description:
+  // Set/Get whether SingleMethodExecute and MultipleMethodExecute run
+  // their methods on the process-wide thread pool.  The pool keeps
+  // GlobalMaximumNumberOfThreads - 1 worker threads (or, if there is no
+  // global maximum, GlobalDefaultNumberOfThreads - 1 or as many as the
+  // largest execution needed) alive between executions; the calling
+  // thread always runs the method for ThreadID 0.  The methods still get
+  // ThreadIDs 0 to NumberOfThreads-1 and run concurrently, so methods
+  // that wait on each other keep working.  The default is on where the
+  // pool is supported (POSIX and Win32 threads).
+  static void SetGlobalUseThreadPool(int val);
+  static int  GetGlobalUseThreadPool();
+
   // These methods are excluded from Tcl wrapping 1) because the
   // wrapper gives up on them and 2) because they really shouldn't be
   // called from a script anyway.
@@ -148,6 +167,17 @@ public:
   // this->NumberOfThreads threads.
   void SingleMethodExecute();
 
+  // Description:
+  // Execute the SingleMethod numberOfTasks times using at most
+  // this->NumberOfThreads threads.  The ThreadInfo of each call has the
+  // index of the task as ThreadID and numberOfTasks as NumberOfThreads, so
+  // a method that splits its work by ThreadID processes one of
+  // numberOfTasks chunks per call.  Each thread runs the next task that has
+  // not been started until none is left, which balances uneven chunks.
+  // Unlike the methods run by SingleMethodExecute(), the tasks do not all
+  // run at once and must not wait on each other.
+  void SingleMethodExecute(int numberOfTasks);
+
   // Description:
   // Execute the MultipleMethods (as define by calling SetMultipleMethod
   // for each of the required this->NumberOfThreads methods) using
@@ -871,16 +871,22 @@ void vtkObject::UnRegisterInternal(vtkObjectBase* o, int check)
                   << (this->ReferenceCount-1));
     }
 
-  if(this->ReferenceCount == 1)
+  // Release the reference right away unless it is the last one.  The
+  // count is only decremented atomically from a larger value, so when
+  // several threads release references at once exactly one of them gets
+  // past this point.
+  if(this->UnRegisterSharedReference(check))
     {
-    // The reference count is 1, so the object is about to be deleted.
-    // Invoke the delete event.
-    this->InvokeEvent(vtkCommand::DeleteEvent, 0);
-
-    // Clean out observers prior to entering destructor
-    this->RemoveAllObservers();
+    return;
     }
 
+  // The reference count is 1, so the object is about to be deleted.
+  // Invoke the delete event.
+  this->InvokeEvent(vtkCommand::DeleteEvent, 0);
+
+  // Clean out observers prior to entering destructor
+  this->RemoveAllObservers();
+
   // Decrement the reference count.
   this->Superclass::UnRegisterInternal(o, check);
 }
@@ -20,6 +20,19 @@
 
 #include <vtksys/ios/sstream>
 
+#if defined(VTK_HAVE_SYNC_BUILTINS)
+// use the compiler builtins
+#elif defined(_WIN32)
+# include "vtkWindows.h"
+#elif defined(__APPLE__)
+# include <libkern/OSAtomic.h>
+#else
+# include "vtkCriticalSection.h"
+// Serializes reference count updates where no atomic operations are
+// available.
+static vtkSimpleCriticalSection vtkObjectBaseReferenceCountLock;
+#endif
+
 #define vtkBaseDebugMacro(x)
 
 class vtkObjectBaseToGarbageCollectorFriendship
@@ -33,6 +46,14 @@ public:
     {
     return vtkGarbageCollector::TakeReference(obj);
     }
+  static void LockCollection()
+    {
+    vtkGarbageCollector::LockCollection();
+    }
+  static void UnlockCollection()
+    {
+    vtkGarbageCollector::UnlockCollection();
+    }
 };
 
 class vtkObjectBaseToWeakPointerBaseFriendship
@@ -245,23 +266,31 @@ void vtkObjectBase::RegisterInternal(vtkObjectBase*, int check)
   if(!(check &&
        vtkObjectBaseToGarbageCollectorFriendship::TakeReference(this)))
     {
-    ++this->ReferenceCount;
+    this->IncrementReferenceCount();
     }
 }
 
 //----------------------------------------------------------------------------
 void vtkObjectBase::UnRegisterInternal(vtkObjectBase*, int check)
 {
-  // If the garbage collector accepts a reference, do not decrement
-  // the count.
-  if(check && this->ReferenceCount > 1 &&
-     vtkObjectBaseToGarbageCollectorFriendship::GiveReference(this))
+  // Release the reference right away unless it is the last one.
+  if(this->UnRegisterSharedReference(check))
     {
     return;
     }
 
+  // The last reference to an object taking part in garbage collection is
+  // released with the collection checks serialized, so the object is not
+  // deleted while another thread checks it.
+  if(check)
+    {
+    vtkObjectBaseToGarbageCollectorFriendship::LockCollection();
+    }
+
   // Decrement the reference count, delete object if count goes to zero.
-  if(--this->ReferenceCount <= 0)
+  // Only the thread whose decrement reaches zero sees a count <= 0, so
+  // the object is deleted exactly once.
+  if(this->DecrementReferenceCount() <= 0)
     {
     // Clear all weak pointers to the object before deleting it.
     if (this->WeakPointers)
@@ -279,6 +308,40 @@ void vtkObjectBase::UnRegisterInternal(vtkObjectBase*, int check)
     delete this;
     }
   else if(check)
+    {
+    vtkGarbageCollector::Collect(this);
+    }
+
+  if(check)
+    {
+    vtkObjectBaseToGarbageCollectorFriendship::UnlockCollection();
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkObjectBase::UnRegisterSharedReference(int check)
+{
+  // If the garbage collector accepts a reference, do not decrement
+  // the count.
+  if(check && this->ReferenceCount > 1 &&
+     vtkObjectBaseToGarbageCollectorFriendship::GiveReference(this))
+    {
+    return 1;
+    }
+
+  if(!check)
+    {
+    return this->DecrementReferenceCountIfShared();
+    }
+
+  // Another thread could release the last reference and delete the
+  // object between the decrement and the check.  Deleting an object
+  // taking part in garbage collection takes the lock of the collection
+  // checks (see UnRegisterInternal), so holding it keeps the object alive
+  // until the check is over.
+  vtkObjectBaseToGarbageCollectorFriendship::LockCollection();
+  int shared = this->DecrementReferenceCountIfShared();
+  if(shared)
     {
     // The garbage collector did not accept the reference, but the
     // object still exists and is participating in garbage collection.
@@ -286,6 +349,98 @@ void vtkObjectBase::UnRegisterInternal(vtkObjectBase*, int check)
     // or the collector has decided it is time to do a check.
     vtkGarbageCollector::Collect(this);
     }
+  vtkObjectBaseToGarbageCollectorFriendship::UnlockCollection();
+  return shared;
+}
+
+//----------------------------------------------------------------------------
+int vtkObjectBase::IncrementReferenceCount()
+{
+#if defined(VTK_HAVE_SYNC_BUILTINS)
+  return __sync_add_and_fetch(&this->ReferenceCount, 1);
+#elif defined(_WIN32)
+  return InterlockedIncrement(reinterpret_cast<long*>(&this->ReferenceCount));
+#elif defined(__APPLE__)
+  return OSAtomicIncrement32Barrier(
+    reinterpret_cast<int32_t*>(&this->ReferenceCount));
+#else
+  vtkObjectBaseReferenceCountLock.Lock();
+  int count = ++this->ReferenceCount;
+  vtkObjectBaseReferenceCountLock.Unlock();
+  return count;
+#endif
+}
+
+//----------------------------------------------------------------------------
+int vtkObjectBase::DecrementReferenceCount()
+{
+#if defined(VTK_HAVE_SYNC_BUILTINS)
+  return __sync_sub_and_fetch(&this->ReferenceCount, 1);
+#elif defined(_WIN32)
+  return InterlockedDecrement(reinterpret_cast<long*>(&this->ReferenceCount));
+#elif defined(__APPLE__)
+  return OSAtomicDecrement32Barrier(
+    reinterpret_cast<int32_t*>(&this->ReferenceCount));
+#else
+  vtkObjectBaseReferenceCountLock.Lock();
+  int count = --this->ReferenceCount;
+  vtkObjectBaseReferenceCountLock.Unlock();
+  return count;
+#endif
+}
+
+//----------------------------------------------------------------------------
+int vtkObjectBase::DecrementReferenceCountIfShared()
+{
+#if defined(VTK_HAVE_SYNC_BUILTINS)
+  int count = this->ReferenceCount;
+  while(count > 1)
+    {
+    int old = __sync_val_compare_and_swap(&this->ReferenceCount,
+                                          count, count - 1);
+    if(old == count)
+      {
+      return 1;
+      }
+    count = old;
+    }
+  return 0;
+#elif defined(_WIN32)
+  long count = this->ReferenceCount;
+  while(count > 1)
+    {
+    long old = InterlockedCompareExchange(
+      reinterpret_cast<long*>(&this->ReferenceCount), count - 1, count);
+    if(old == count)
+      {
+      return 1;
+      }
+    count = old;
+    }
+  return 0;
+#elif defined(__APPLE__)
+  int32_t count = this->ReferenceCount;
+  while(count > 1)
+    {
+    if(OSAtomicCompareAndSwap32Barrier(
+         count, count - 1, reinterpret_cast<int32_t*>(&this->ReferenceCount)))
+      {
+      return 1;
+      }
+    count = this->ReferenceCount;
+    }
+  return 0;
+#else
+  int shared = 0;
+  vtkObjectBaseReferenceCountLock.Lock();
+  if(this->ReferenceCount > 1)
+    {
+    --this->ReferenceCount;
+    shared = 1;
+    }
+  vtkObjectBaseReferenceCountLock.Unlock();
+  return shared;
+#endif
 }
 
 //----------------------------------------------------------------------------
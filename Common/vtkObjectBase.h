@@ -129,6 +129,8 @@ public:
 
   // Description:
   // Increase the reference count (mark as used by another object).
+  // The reference count is updated atomically, so objects may be
+  // registered and unregistered concurrently from several threads.
   virtual void Register(vtkObjectBase* o);
 
   // Description:
@@ -170,6 +172,23 @@ protected:
   virtual void RegisterInternal(vtkObjectBase*, int check);
   virtual void UnRegisterInternal(vtkObjectBase*, int check);
 
+  // Atomically increment/decrement the reference count and return the
+  // new value.  These do not delete the object when the count drops to
+  // zero; use UnRegister for that.
+  int IncrementReferenceCount();
+  int DecrementReferenceCount();
+
+  // Atomically decrement the reference count unless it is 1, and return
+  // whether it was decremented.  The thread releasing the last reference
+  // thereby always finds a count of 1, even when several threads release
+  // references at once.
+  int DecrementReferenceCountIfShared();
+
+  // Release a reference that is not the last one, as UnRegisterInternal
+  // does, and return 1, or return 0 without changing the count when it is
+  // the last one.
+  int UnRegisterSharedReference(int check);
+
   // See vtkGarbageCollector.h:
   virtual void ReportReferences(vtkGarbageCollector*);
 
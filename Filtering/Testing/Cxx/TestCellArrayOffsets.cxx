@@ -0,0 +1,386 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellArrayOffsets.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkCellArray behaves the same with the offsets storage, with
+// 32 and 64 bit ids, as with the legacy storage, including when it is
+// given external buffers, when it is converted by GetData() and when it is
+// used by vtkPolyData and vtkUnstructuredGrid.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static const vtkIdType NumberOfPoints = 100;
+static const vtkIdType NumberOfCells = 500;
+
+// Returns 1 if both cell arrays hold the same cells.
+static int CompareCells(vtkCellArray *a, vtkCellArray *b, const char *what)
+{
+  if ( a->GetNumberOfCells() != b->GetNumberOfCells() ||
+       a->GetNumberOfConnectivityEntries() !=
+       b->GetNumberOfConnectivityEntries() ||
+       a->GetMaxCellSize() != b->GetMaxCellSize() )
+    {
+    cerr << what << ": the sizes differ." << endl;
+    return 0;
+    }
+
+  vtkIdType na, *pa, nb, *pb, cellId = 0;
+  a->InitTraversal();
+  b->InitTraversal();
+  while ( a->GetNextCell(na, pa) )
+    {
+    if ( !b->GetNextCell(nb, pb) || na != nb ||
+         a->GetTraversalLocation(na) != b->GetTraversalLocation(nb) )
+      {
+      cerr << what << ": cell " << cellId << " differs." << endl;
+      return 0;
+      }
+    for (vtkIdType i = 0; i < na; i++)
+      {
+      if ( pa[i] != pb[i] )
+        {
+        cerr << what << ": cell " << cellId << " differs." << endl;
+        return 0;
+        }
+      }
+    cellId++;
+    }
+
+  // random access, by cell id and by location, with the internal buffer
+  // and with buffers of the caller
+  vtkIdList *ida = vtkIdList::New();
+  vtkIdList *idb = vtkIdList::New();
+  vtkIdType loc = 0;
+  int ok = 1;
+  for (cellId = 0; ok && cellId < a->GetNumberOfCells(); cellId++)
+    {
+    a->GetCellAtId(cellId, na, pa);
+    b->GetCellAtId(cellId, nb, pb, idb);
+    ok &= ( na == nb && (na == 0 || pa[na-1] == pb[nb-1]) );
+    a->GetCell(loc, na, pa, ida);
+    b->GetCell(loc, nb, pb);
+    ok &= ( na == nb && (na == 0 || pa[0] == pb[0]) );
+    a->GetCellAtId(cellId, ida);
+    b->GetCell(loc, idb);
+    ok &= ( ida->GetNumberOfIds() == na && idb->GetNumberOfIds() == na &&
+            (na == 0 || ida->GetId(na-1) == idb->GetId(na-1)) );
+    loc += na + 1;
+    }
+  ida->Delete();
+  idb->Delete();
+  if ( !ok )
+    {
+    cerr << what << ": cell " << cellId - 1 << " differs." << endl;
+    }
+  return ok;
+}
+
+// Returns 1 if the interleaved list of the cells is the one of reference.
+// This converts cells to the legacy storage.
+static int CompareLegacy(vtkCellArray *reference, vtkCellArray *cells,
+                         const char *what)
+{
+  vtkIdType *la = reference->GetPointer(), *lb = cells->GetPointer();
+  if ( cells->IsStorageOffsets() )
+    {
+    cerr << what << ": GetPointer did not convert the storage." << endl;
+    return 0;
+    }
+  for (vtkIdType i = 0; i < reference->GetNumberOfConnectivityEntries(); i++)
+    {
+    if ( la[i] != lb[i] )
+      {
+      cerr << what << ": the interleaved lists differ." << endl;
+      return 0;
+      }
+    }
+  return CompareCells(reference, cells, what);
+}
+
+// Fills the cell array with the same pseudo-random cells each time, using
+// both ways to insert cells.
+static void FillCells(vtkCellArray *cells)
+{
+  vtkIdType pts[8];
+  for (vtkIdType cellId = 0; cellId < NumberOfCells; cellId++)
+    {
+    vtkIdType npts = 1 + (cellId * 7) % 8;
+    if ( cellId % 3 )
+      {
+      for (vtkIdType i = 0; i < npts; i++)
+        {
+        pts[i] = (cellId * 13 + i * 29) % NumberOfPoints;
+        }
+      cells->InsertNextCell(npts, pts);
+      }
+    else
+      {
+      cells->InsertNextCell(static_cast<int>(npts));
+      for (vtkIdType i = 0; i < npts; i++)
+        {
+        cells->InsertCellPoint((cellId * 13 + i * 29) % NumberOfPoints);
+        }
+      cells->UpdateCellCount(static_cast<int>(npts));
+      }
+    }
+}
+
+static int TestStorage(vtkCellArray *reference, int idWidth)
+{
+  int ok = 1;
+
+  // conversion of existing cells, both ways
+  vsp(CellArray, converted);
+  converted->DeepCopy(reference);
+  converted->SetStorageToOffsets(idWidth);
+  if ( !converted->IsStorageOffsets() || converted->GetIdWidth() != idWidth )
+    {
+    cerr << "The storage was not converted to " << idWidth << " bits." << endl;
+    return 0;
+    }
+  ok &= CompareCells(reference, converted, "SetStorageToOffsets");
+
+  vsp(CellArray, copy);
+  copy->DeepCopy(converted);
+  ok &= CompareCells(reference, copy, "DeepCopy");
+
+  copy->SetStorageToLegacy();
+  ok &= CompareCells(reference, copy, "SetStorageToLegacy");
+
+  copy->DeepCopy(converted);
+  ok &= CompareLegacy(reference, copy, "GetPointer");
+
+  // insertion
+  vsp(CellArray, inserted);
+  inserted->SetStorageToOffsets(idWidth);
+  inserted->Allocate(inserted->EstimateSize(NumberOfCells, 8));
+  FillCells(inserted);
+  ok &= CompareCells(reference, inserted, "InsertNextCell");
+
+  // modification through the locations
+  vsp(CellArray, legacy);
+  legacy->DeepCopy(reference);
+  vtkIdType npts, *pts, cellId = 0, replacement[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  for (inserted->InitTraversal(); inserted->GetNextCell(npts, pts); cellId++)
+    {
+    if ( cellId % 5 == 0 )
+      {
+      inserted->ReverseCell(inserted->GetTraversalLocation(npts));
+      }
+    else if ( cellId % 5 == 1 )
+      {
+      inserted->ReplaceCell(inserted->GetTraversalLocation(npts),
+                            npts, replacement);
+      }
+    }
+  cellId = 0;
+  for (legacy->InitTraversal(); legacy->GetNextCell(npts, pts); cellId++)
+    {
+    if ( cellId % 5 == 0 )
+      {
+      legacy->ReverseCell(legacy->GetTraversalLocation(npts));
+      }
+    else if ( cellId % 5 == 1 )
+      {
+      legacy->ReplaceCell(legacy->GetTraversalLocation(npts),
+                          npts, replacement);
+      }
+    }
+  ok &= CompareCells(legacy, inserted, "ReverseCell/ReplaceCell");
+
+  // cells can still be inserted after the conversion
+  copy->DeepCopy(inserted);
+  copy->GetData();
+  inserted->InsertNextCell(3, replacement);
+  copy->InsertNextCell(3, replacement);
+  ok &= CompareCells(inserted, copy, "InsertNextCell after GetData");
+
+  inserted->Reset();
+  if ( inserted->GetNumberOfCells() != 0 ||
+       inserted->GetNumberOfConnectivityEntries() != 0 ||
+       !inserted->IsStorageOffsets() )
+    {
+    cerr << "Reset did not empty the offsets storage." << endl;
+    ok = 0;
+    }
+
+  // use within datasets
+  vsp(Points, points);
+  for (vtkIdType i = 0; i < NumberOfPoints; i++)
+    {
+    points->InsertNextPoint(i, i % 10, i % 7);
+    }
+  vsp(PolyData, polys);
+  polys->SetPoints(points);
+  polys->SetPolys(converted);
+  vsp(UnstructuredGrid, grid);
+  grid->SetPoints(points);
+  grid->SetCells(VTK_POLY_VERTEX, converted);
+  vtkIdList *cellIds = vtkIdList::New();
+  vtkIdList *ptIds = vtkIdList::New();
+  for (cellId = 0; cellId < NumberOfCells; cellId++)
+    {
+    reference->GetCellAtId(cellId, npts, pts);
+    polys->GetCellPoints(cellId, ptIds);
+    if ( ptIds->GetNumberOfIds() != npts || ptIds->GetId(npts-1) != pts[npts-1] )
+      {
+      cerr << "vtkPolyData cell " << cellId << " differs." << endl;
+      ok = 0;
+      break;
+      }
+    grid->GetCellPoints(cellId, ptIds);
+    if ( ptIds->GetNumberOfIds() != npts || ptIds->GetId(0) != pts[0] )
+      {
+      cerr << "vtkUnstructuredGrid cell " << cellId << " differs." << endl;
+      ok = 0;
+      break;
+      }
+    }
+
+  // the locations of the grid are the ones of the legacy storage, and stay
+  // valid when the cells are converted
+  vsp(UnstructuredGrid, legacyGrid);
+  legacyGrid->SetPoints(points);
+  legacyGrid->SetCells(VTK_POLY_VERTEX, reference);
+  vsp(UnstructuredGrid, copiedGrid);
+  copiedGrid->DeepCopy(grid);
+  vtkIdTypeArray *locations = grid->GetCellLocationsArray();
+  for (cellId = 0; cellId < NumberOfCells; cellId++)
+    {
+    if ( locations->GetValue(cellId) !=
+         legacyGrid->GetCellLocationsArray()->GetValue(cellId) )
+      {
+      cerr << "vtkUnstructuredGrid location " << cellId << " differs." << endl;
+      ok = 0;
+      break;
+      }
+    }
+  vtkIdType *list = copiedGrid->GetCells()->GetPointer();
+  for (cellId = 0; cellId < NumberOfCells; cellId++)
+    {
+    vtkIdType loc = copiedGrid->GetCellLocationsArray()->GetValue(cellId);
+    reference->GetCellAtId(cellId, npts, pts);
+    if ( list[loc] != npts || list[loc+npts] != pts[npts-1] )
+      {
+      cerr << "The converted location of cell " << cellId << " is wrong."
+           << endl;
+      ok = 0;
+      break;
+      }
+    }
+  polys->BuildLinks();
+  polys->GetPointCells(pts[0], cellIds);
+  if ( cellIds->IsId(NumberOfCells - 1) < 0 )
+    {
+    cerr << "vtkPolyData links are wrong." << endl;
+    ok = 0;
+    }
+  cellIds->Delete();
+  ptIds->Delete();
+
+  return ok;
+}
+
+int TestCellArrayOffsets(int, char *[])
+{
+  int ok = 1;
+
+  vsp(CellArray, reference);
+  FillCells(reference);
+
+  ok &= TestStorage(reference, 32);
+  ok &= TestStorage(reference, 64);
+
+#ifdef VTK_USE_64BIT_IDS
+  // point ids that do not fit in 32 bits are stored with 64 bits
+  vsp(CellArray, large);
+  vtkIdType largeIds[2] = { 1, static_cast<vtkIdType>(VTK_INT_MAX) + 2 };
+  large->InsertNextCell(2, largeIds);
+  large->SetStorageToOffsets(32);
+  vtkIdType nlarge, *plarge;
+  large->GetCellAtId(0, nlarge, plarge);
+  if ( large->GetIdWidth() != 64 || nlarge != 2 ||
+       plarge[1] != largeIds[1] )
+    {
+    cerr << "A point id larger than VTK_INT_MAX was truncated." << endl;
+    ok = 0;
+    }
+#endif
+
+  // externally owned buffers are used in place
+  int offsets[4] = { 0, 3, 7, 8 };
+  int connectivity[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  vsp(IntArray, offsetsArray);
+  offsetsArray->SetArray(offsets, 4, 1);
+  vsp(IntArray, connectivityArray);
+  connectivityArray->SetArray(connectivity, 8, 1);
+
+  vsp(CellArray, external);
+  if ( !external->SetData(offsetsArray, connectivityArray) ||
+       external->GetNumberOfCells() != 3 ||
+       external->GetIdWidth() != 32 ||
+       external->GetOffsetsArray()->GetVoidPointer(0) != offsets ||
+       external->GetConnectivityArray()->GetVoidPointer(0) != connectivity )
+    {
+    cerr << "SetData did not use the arrays in place." << endl;
+    return 1;
+    }
+
+  // changes made to the buffers are seen until the cells are converted
+  vtkIdType npts, *pts;
+  connectivity[7] = 8;
+  external->GetCellAtId(2, npts, pts);
+  if ( npts != 1 || pts[0] != 8 )
+    {
+    cerr << "The cells do not follow the external buffers." << endl;
+    ok = 0;
+    }
+
+  vtkIdType expected[11] = { 3, 0, 1, 2, 4, 3, 4, 5, 6, 1, 8 };
+  vtkIdTypeArray *legacy = external->GetData();
+  if ( external->IsStorageOffsets() )
+    {
+    cerr << "GetData did not convert the storage." << endl;
+    return 1;
+    }
+  for (int i = 0; i < 11; i++)
+    {
+    if ( legacy->GetValue(i) != expected[i] )
+      {
+      cerr << "GetData differs from the external buffers." << endl;
+      return 1;
+      }
+    }
+
+  // writes through the pointer are kept
+  external->GetPointer()[10] = 9;
+  external->GetCellAtId(2, npts, pts);
+  if ( npts != 1 || pts[0] != 9 || connectivity[7] != 8 )
+    {
+    cerr << "A write through GetPointer was lost." << endl;
+    ok = 0;
+    }
+
+  return ok ? 0 : 1;
+}
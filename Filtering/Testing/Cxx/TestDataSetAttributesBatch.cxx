@@ -0,0 +1,196 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetAttributesBatch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the batched CopyData(), InterpolatePoints() and
+// InterpolateEdges() of vtkDataSetAttributes give the same tuples as their
+// one tuple at a time counterparts, for numeric, bit and string arrays.
+
+#include "vtkBitArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkUnsignedCharArray.h"
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static const vtkIdType NumberOfTuples = 200;
+
+static void FillAttributes(vtkPointData *pd)
+{
+  vsp(FloatArray, scalars);
+  scalars->SetName("Scalars");
+  vsp(DoubleArray, vectors);
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vsp(IntArray, ints);
+  ints->SetName("Ints");
+  ints->SetNumberOfComponents(2);
+  vsp(UnsignedCharArray, chars);
+  chars->SetName("Chars");
+  vsp(BitArray, bits);
+  bits->SetName("Bits");
+  vsp(StringArray, strings);
+  strings->SetName("Strings");
+  for (vtkIdType i = 0; i < NumberOfTuples; i++)
+    {
+    scalars->InsertNextValue(0.37f * i - 11.0f);
+    vectors->InsertNextTuple3(i, 1.0 / (i + 1), -0.5 * i);
+    ints->InsertNextTuple2(7 * i - 300, (i * i) % 101);
+    chars->InsertNextValue(static_cast<unsigned char>((i * 13) % 256));
+    bits->InsertNextValue(i % 3 == 0);
+    char name[16];
+    sprintf(name, "s%d", static_cast<int>(i));
+    strings->InsertNextValue(name);
+    }
+  pd->SetScalars(scalars);
+  pd->SetVectors(vectors);
+  pd->AddArray(ints);
+  pd->AddArray(chars);
+  pd->AddArray(bits);
+  pd->AddArray(strings);
+}
+
+static int CompareAttributes(vtkPointData *a, vtkPointData *b,
+                             const char *what)
+{
+  if ( a->GetNumberOfArrays() != b->GetNumberOfArrays() )
+    {
+    cerr << what << ": the numbers of arrays differ." << endl;
+    return 0;
+    }
+  for (int i = 0; i < a->GetNumberOfArrays(); i++)
+    {
+    vtkAbstractArray *x = a->GetAbstractArray(i);
+    vtkAbstractArray *y = b->GetAbstractArray(x->GetName());
+    if ( !y || x->GetNumberOfTuples() != y->GetNumberOfTuples() )
+      {
+      cerr << what << ": array " << x->GetName() << " has "
+           << (y ? y->GetNumberOfTuples() : 0) << " tuples instead of "
+           << x->GetNumberOfTuples() << endl;
+      return 0;
+      }
+    vtkIdType numValues = x->GetNumberOfTuples() * x->GetNumberOfComponents();
+    for (vtkIdType j = 0; j < numValues; j++)
+      {
+      if ( x->GetVariantValue(j) != y->GetVariantValue(j) )
+        {
+        cerr << what << ": array " << x->GetName() << " differs at value "
+             << j << endl;
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+int TestDataSetAttributesBatch(int, char *[])
+{
+  int ok = 1;
+  vsp(PointData, input);
+  FillAttributes(input);
+
+  // scattered and consecutive copies
+  vsp(IdList, fromIds);
+  vsp(IdList, toIds);
+  for (vtkIdType i = 0; i < NumberOfTuples / 2; i++)
+    {
+    fromIds->InsertNextId((i * 37) % NumberOfTuples);
+    toIds->InsertNextId((i * 11) % (NumberOfTuples / 2));
+    }
+
+  vsp(PointData, copied);
+  copied->CopyAllocate(input, 10);
+  vsp(PointData, batchCopied);
+  batchCopied->CopyAllocate(input, 10);
+  for (vtkIdType i = 0; i < fromIds->GetNumberOfIds(); i++)
+    {
+    copied->CopyData(input, fromIds->GetId(i), toIds->GetId(i));
+    }
+  batchCopied->CopyData(input, fromIds, toIds);
+  ok &= CompareAttributes(copied, batchCopied, "CopyData to a list");
+
+  for (vtkIdType i = 0; i < fromIds->GetNumberOfIds(); i++)
+    {
+    copied->CopyData(input, fromIds->GetId(i), NumberOfTuples / 2 + i);
+    }
+  batchCopied->CopyConsecutiveData(input, fromIds, NumberOfTuples / 2);
+  ok &= CompareAttributes(copied, batchCopied, "CopyConsecutiveData");
+
+  // edges, with nearest neighbor interpolation of the scalars
+  const vtkIdType numEdges = 50;
+  vtkIdType edges[2 * numEdges];
+  double t[numEdges];
+  for (vtkIdType e = 0; e < numEdges; e++)
+    {
+    edges[2 * e] = (e * 7) % NumberOfTuples;
+    edges[2 * e + 1] = (e * 13 + 1) % NumberOfTuples;
+    t[e] = (e % 11) / 10.0;
+    }
+
+  vsp(PointData, interpolated);
+  interpolated->SetCopyScalars(2, vtkDataSetAttributes::INTERPOLATE);
+  interpolated->InterpolateAllocate(input);
+  vsp(PointData, batchInterpolated);
+  batchInterpolated->SetCopyScalars(2, vtkDataSetAttributes::INTERPOLATE);
+  batchInterpolated->InterpolateAllocate(input);
+  for (vtkIdType e = 0; e < numEdges; e++)
+    {
+    interpolated->InterpolateEdge(input, e, edges[2 * e], edges[2 * e + 1],
+                                  t[e]);
+    }
+  batchInterpolated->InterpolateEdges(input, 0, numEdges, edges, t);
+  ok &= CompareAttributes(interpolated, batchInterpolated, "InterpolateEdges");
+
+  // points, each one from the edges written before it as well
+  const vtkIdType numPoints = 40;
+  vtkIdType offsets[numPoints + 1];
+  vtkIdType ids[4 * numPoints];
+  double weights[4 * numPoints];
+  vtkIdType loc = 0;
+  for (vtkIdType p = 0; p < numPoints; p++)
+    {
+    offsets[p] = loc;
+    vtkIdType n = 1 + p % 4;
+    for (vtkIdType j = 0; j < n; j++)
+      {
+      ids[loc + j] = (p * 3 + j * 17) % (numEdges + p);
+      weights[loc + j] = 1.0 / n;
+      }
+    loc += n;
+    }
+  offsets[numPoints] = loc;
+
+  vsp(IdList, ptIds);
+  for (vtkIdType p = 0; p < numPoints; p++)
+    {
+    ptIds->Reset();
+    for (vtkIdType j = offsets[p]; j < offsets[p + 1]; j++)
+      {
+      ptIds->InsertNextId(ids[j]);
+      }
+    interpolated->InterpolatePoint(interpolated, numEdges + p, ptIds,
+                                   weights + offsets[p]);
+    }
+  batchInterpolated->InterpolatePoints(batchInterpolated, numEdges, numPoints,
+                                       offsets, ids, weights);
+  ok &= CompareAttributes(interpolated, batchInterpolated,
+                          "InterpolatePoints");
+
+  return ok ? 0 : 1;
+}
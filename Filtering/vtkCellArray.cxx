@@ -17,6 +17,222 @@
 
 vtkStandardNewMacro(vtkCellArray);
 
+// Calls the given templated expression with VTK_TT set to the integer type
+// of the offsets storage.
+#define vtkCellArrayOffsetsCall(call)         \
+  if ( this->IdWidth == 32 )                  \
+    {                                         \
+    typedef vtkTypeInt32 VTK_TT; call;        \
+    }                                         \
+  else                                        \
+    {                                         \
+    typedef vtkTypeInt64 VTK_TT; call;        \
+    }
+
+//----------------------------------------------------------------------------
+// Creates an empty array of integers of the given number of bits, using
+// vtkIdTypeArray when vtkIdType has that size so that the point ids can be
+// returned without copying them.
+static vtkDataArray *vtkCellArrayNewIdArray(int idWidth)
+{
+  if ( idWidth == 8*VTK_SIZEOF_ID_TYPE )
+    {
+    return vtkIdTypeArray::New();
+    }
+  return vtkDataArray::CreateDataArray(
+    idWidth == 32 ? VTK_TYPE_INT32 : VTK_TYPE_INT64);
+}
+
+//----------------------------------------------------------------------------
+// Appends a cell to the offsets storage.
+template <class T>
+static void vtkCellArrayInsertCell(vtkDataArray *offsets,
+                                   vtkDataArray *connectivity,
+                                   vtkIdType cellId, vtkIdType npts,
+                                   const vtkIdType *pts)
+{
+  vtkIdType loc = connectivity->GetMaxId() + 1;
+  T *ids = static_cast<T *>(connectivity->WriteVoidPointer(loc, npts));
+  for (vtkIdType i = 0; i < npts; i++)
+    {
+    ids[i] = static_cast<T>(pts[i]);
+    }
+  T *offset = static_cast<T *>(offsets->WriteVoidPointer(cellId + 1, 1));
+  *offset = static_cast<T>(loc + npts);
+}
+
+//----------------------------------------------------------------------------
+// Returns the point ids of a cell of the offsets storage, either in place
+// or copied to the given buffer.
+template <class T>
+static void vtkCellArrayGetCell(vtkDataArray *offsets,
+                                vtkDataArray *connectivity,
+                                vtkIdType cellId, vtkIdType &npts,
+                                vtkIdType* &pts, vtkIdType* &buffer,
+                                vtkIdType &bufferSize)
+{
+  const T *offset = static_cast<T *>(offsets->GetVoidPointer(cellId));
+  T *ids = static_cast<T *>(connectivity->GetVoidPointer(offset[0]));
+  npts = static_cast<vtkIdType>(offset[1] - offset[0]);
+  if ( sizeof(T) == sizeof(vtkIdType) )
+    {
+    pts = reinterpret_cast<vtkIdType *>(ids);
+    return;
+    }
+
+  if ( npts > bufferSize )
+    {
+    delete [] buffer;
+    bufferSize = (npts > 2*bufferSize ? npts : 2*bufferSize);
+    buffer = new vtkIdType[bufferSize];
+    }
+  for (vtkIdType i = 0; i < npts; i++)
+    {
+    buffer[i] = static_cast<vtkIdType>(ids[i]);
+    }
+  pts = buffer;
+}
+
+//----------------------------------------------------------------------------
+// Copies the point ids of a cell of the offsets storage to ptIds.
+template <class T>
+static void vtkCellArrayCopyCell(vtkDataArray *offsets,
+                                 vtkDataArray *connectivity,
+                                 vtkIdType cellId, vtkIdList *ptIds)
+{
+  const T *offset = static_cast<T *>(offsets->GetVoidPointer(cellId));
+  const T *ids = static_cast<T *>(connectivity->GetVoidPointer(offset[0]));
+  vtkIdType npts = static_cast<vtkIdType>(offset[1] - offset[0]);
+  ptIds->SetNumberOfIds(npts);
+  vtkIdType *pts = ptIds->GetPointer(0);
+  for (vtkIdType i = 0; i < npts; i++)
+    {
+    pts[i] = static_cast<vtkIdType>(ids[i]);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Finds the cell at a position of the interleaved list, where the cell
+// cellId starts at offset[cellId]+cellId.
+template <class T>
+static vtkIdType vtkCellArrayGetCellIdAtLocation(vtkDataArray *offsets,
+                                                 vtkIdType numCells,
+                                                 vtkIdType loc)
+{
+  const T *offset = static_cast<T *>(offsets->GetVoidPointer(0));
+  vtkIdType low = 0;
+  vtkIdType high = numCells;
+  while (low < high)
+    {
+    vtkIdType mid = low + (high - low) / 2;
+    if ( static_cast<vtkIdType>(offset[mid]) + mid < loc )
+      {
+      low = mid + 1;
+      }
+    else
+      {
+      high = mid;
+      }
+    }
+  return low;
+}
+
+//----------------------------------------------------------------------------
+// Writes the offsets storage as an interleaved (npts,ids...) list.
+template <class T>
+static void vtkCellArrayToLegacy(vtkDataArray *offsets,
+                                 vtkDataArray *connectivity,
+                                 vtkIdType numCells, vtkIdType *legacy)
+{
+  const T *offset = static_cast<T *>(offsets->GetVoidPointer(0));
+  const T *ids = static_cast<T *>(connectivity->GetVoidPointer(0));
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+    *legacy++ = static_cast<vtkIdType>(offset[cellId+1] - offset[cellId]);
+    for (T i = offset[cellId]; i < offset[cellId+1]; i++)
+      {
+      *legacy++ = static_cast<vtkIdType>(ids[i]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Fills offsets and connectivity arrays, already sized, from the first
+// numCells cells of a cell array. Returns the largest point id.
+template <class T>
+static vtkIdType vtkCellArrayToOffsets(vtkCellArray *cells,
+                                       vtkIdType numCells, T *offset, T *ids)
+{
+  vtkIdType npts, *pts, maxId = -1;
+  T loc = 0;
+  *offset++ = 0;
+  cells->InitTraversal();
+  for (vtkIdType cellId = 0;
+       cellId < numCells && cells->GetNextCell(npts, pts); cellId++)
+    {
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      if ( pts[i] > maxId )
+        {
+        maxId = pts[i];
+        }
+      *ids++ = static_cast<T>(pts[i]);
+      }
+    loc += static_cast<T>(npts);
+    *offset++ = loc;
+    }
+  return maxId;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+static int vtkCellArrayGetMaxCellSize(vtkDataArray *offsets,
+                                      vtkIdType numCells)
+{
+  const T *offset = static_cast<T *>(offsets->GetVoidPointer(0));
+  T maxSize = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+    if ( offset[cellId+1] - offset[cellId] > maxSize )
+      {
+      maxSize = offset[cellId+1] - offset[cellId];
+      }
+    }
+  return static_cast<int>(maxSize);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+static void vtkCellArrayReverseCell(vtkDataArray *offsets,
+                                    vtkDataArray *connectivity,
+                                    vtkIdType cellId)
+{
+  const T *offset = static_cast<T *>(offsets->GetVoidPointer(cellId));
+  T *ids = static_cast<T *>(connectivity->GetVoidPointer(offset[0]));
+  T npts = offset[1] - offset[0];
+  for (T i = 0; i < (npts/2); i++)
+    {
+    T tmp = ids[i];
+    ids[i] = ids[npts-i-1];
+    ids[npts-i-1] = tmp;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+static void vtkCellArrayReplaceCell(vtkDataArray *offsets,
+                                    vtkDataArray *connectivity,
+                                    vtkIdType cellId, int npts,
+                                    const vtkIdType *pts)
+{
+  const T *offset = static_cast<T *>(offsets->GetVoidPointer(cellId));
+  T *ids = static_cast<T *>(connectivity->GetVoidPointer(offset[0]));
+  for (int i = 0; i < npts; i++)
+    {
+    ids[i] = static_cast<T>(pts[i]);
+    }
+}
+
 //----------------------------------------------------------------------------
 vtkCellArray::vtkCellArray()
 {
@@ -24,6 +240,13 @@ vtkCellArray::vtkCellArray()
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->TraversalCellId = 0;
+
+  this->Offsets = NULL;
+  this->Connectivity = NULL;
+  this->IdWidth = 8*VTK_SIZEOF_ID_TYPE;
+  this->CellBuffer = NULL;
+  this->CellBufferSize = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -35,16 +258,33 @@ void vtkCellArray::DeepCopy (vtkCellArray *ca)
     return;
     }
 
-  this->Ia->DeepCopy(ca->Ia);
+  if ( ca->Offsets )
+    {
+    this->ReleaseOffsets();
+    this->Ia->Initialize();
+    this->Offsets = ca->Offsets->NewInstance();
+    this->Offsets->DeepCopy(ca->Offsets);
+    this->Connectivity = ca->Connectivity->NewInstance();
+    this->Connectivity->DeepCopy(ca->Connectivity);
+    this->IdWidth = ca->IdWidth;
+    }
+  else
+    {
+    this->ReleaseOffsets();
+    this->Ia->DeepCopy(ca->Ia);
+    }
   this->NumberOfCells = ca->NumberOfCells;
   this->InsertLocation = ca->InsertLocation;
   this->TraversalLocation = ca->TraversalLocation;
+  this->TraversalCellId = ca->TraversalCellId;
 }
 
 //----------------------------------------------------------------------------
 vtkCellArray::~vtkCellArray()
 {
   this->Ia->Delete();
+  this->ReleaseOffsets();
+  delete [] this->CellBuffer;
 }
 
 //----------------------------------------------------------------------------
@@ -54,6 +294,13 @@ void vtkCellArray::Initialize()
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->TraversalCellId = 0;
+  if ( this->Offsets )
+    {
+    this->Offsets->Initialize();
+    this->Connectivity->Initialize();
+    this->ResetOffsets();
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -61,6 +308,12 @@ void vtkCellArray::Initialize()
 // defining the cell.
 int vtkCellArray::GetMaxCellSize()
 {
+  if ( this->Offsets )
+    {
+    vtkCellArrayOffsetsCall(return vtkCellArrayGetMaxCellSize<VTK_TT>(
+      this->Offsets, this->NumberOfCells));
+    }
+
   int i, npts=0, maxSize=0;
 
   for (i=0; i<this->Ia->GetMaxId(); i+=(npts+1))
@@ -77,6 +330,14 @@ int vtkCellArray::GetMaxCellSize()
 // Specify a group of cells.
 void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
 {
+  if ( cells && this->Offsets )
+    {
+    this->Modified();
+    this->ReleaseOffsets();
+    this->NumberOfCells = ncells;
+    this->InsertLocation = this->Ia->GetMaxId() + 1;
+    this->TraversalLocation = 0;
+    }
   if ( cells && cells != this->Ia )
     {
     this->Modified();
@@ -93,12 +354,40 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
 //----------------------------------------------------------------------------
 unsigned long vtkCellArray::GetActualMemorySize()
 {
-  return this->Ia->GetActualMemorySize();
+  unsigned long size = this->Ia->GetActualMemorySize();
+  if ( this->Offsets )
+    {
+    size += this->Offsets->GetActualMemorySize() +
+      this->Connectivity->GetActualMemorySize();
+    }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::Squeeze()
+{
+  if ( this->Offsets )
+    {
+    this->Offsets->Squeeze();
+    this->Connectivity->Squeeze();
+    }
+  this->Ia->Squeeze();
 }
 
 //----------------------------------------------------------------------------
 int vtkCellArray::GetNextCell(vtkIdList *pts)
 {
+  if ( this->Offsets )
+    {
+    if ( this->TraversalCellId < this->NumberOfCells )
+      {
+      this->GetCellAtId(this->TraversalCellId++, pts);
+      this->TraversalLocation += pts->GetNumberOfIds() + 1;
+      return 1;
+      }
+    return 0;
+    }
+
   vtkIdType npts, *ppts;
   if (this->GetNextCell(npts, ppts))
     {
@@ -115,8 +404,14 @@ int vtkCellArray::GetNextCell(vtkIdList *pts)
 //----------------------------------------------------------------------------
 void vtkCellArray::GetCell(vtkIdType loc, vtkIdList *pts)
 {
-  vtkIdType npts = this->Ia->GetValue(loc++);
-  vtkIdType *ppts = this->Ia->GetPointer(loc);
+  if ( this->Offsets )
+    {
+    this->GetCellAtId(this->GetCellIdAtLocation(loc), pts);
+    return;
+    }
+
+  vtkIdType npts, *ppts;
+  this->GetCell(loc, npts, ppts);
   pts->SetNumberOfIds(npts);
   for (vtkIdType i = 0; i < npts; i++)
     {
@@ -124,6 +419,316 @@ void vtkCellArray::GetCell(vtkIdType loc, vtkIdList *pts)
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType &npts,
+                               vtkIdType* &pts)
+{
+  if ( this->Offsets )
+    {
+    this->GetOffsetsCell(cellId, npts, pts);
+    return;
+    }
+
+  vtkIdType loc = 0;
+  for (vtkIdType i = 0; i < cellId; i++)
+    {
+    loc += this->Ia->GetValue(loc) + 1;
+    }
+  this->GetCell(loc, npts, pts);
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts, vtkIdType* &pts,
+                           vtkIdList *ptIds)
+{
+  if ( this->Offsets )
+    {
+    this->GetOffsetsCell(this->GetCellIdAtLocation(loc), npts, pts, ptIds);
+    return;
+    }
+  this->GetCell(loc, npts, pts);
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType &npts,
+                               vtkIdType* &pts, vtkIdList *ptIds)
+{
+  if ( this->Offsets )
+    {
+    this->GetOffsetsCell(cellId, npts, pts, ptIds);
+    return;
+    }
+  this->GetCellAtId(cellId, npts, pts);
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdList *ptIds)
+{
+  if ( this->Offsets )
+    {
+    vtkCellArrayOffsetsCall(vtkCellArrayCopyCell<VTK_TT>(
+      this->Offsets, this->Connectivity, cellId, ptIds));
+    return;
+    }
+
+  vtkIdType npts, *pts;
+  this->GetCellAtId(cellId, npts, pts);
+  ptIds->SetNumberOfIds(npts);
+  for (vtkIdType i = 0; i < npts; i++)
+    {
+    ptIds->SetId(i, pts[i]);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::SetStorageToLegacy()
+{
+  if ( !this->Offsets )
+    {
+    return;
+    }
+  this->ConvertToLegacy();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::SetStorageToOffsets(int idWidth)
+{
+  if ( idWidth != 32 && idWidth != 64 )
+    {
+    vtkErrorMacro("Cannot store point ids with " << idWidth << " bits.");
+    return;
+    }
+  if ( this->Offsets && this->IdWidth == idWidth )
+    {
+    return;
+    }
+
+  vtkIdType numEntries = this->GetNumberOfConnectivityEntries();
+  if ( idWidth == 32 && numEntries - this->NumberOfCells > VTK_INT_MAX )
+    {
+    vtkWarningMacro("The connectivity does not fit in 32 bit integers, "
+                    "storing the point ids with 64 bits.");
+    idWidth = 64;
+    if ( this->Offsets && this->IdWidth == idWidth )
+      {
+      return;
+      }
+    }
+  vtkDataArray *offsets = vtkCellArrayNewIdArray(idWidth);
+  vtkDataArray *connectivity = vtkCellArrayNewIdArray(idWidth);
+  offsets->SetNumberOfTuples(this->NumberOfCells + 1);
+  connectivity->SetNumberOfTuples(numEntries - this->NumberOfCells);
+  if ( idWidth == 32 &&
+       vtkCellArrayToOffsets(this, this->NumberOfCells,
+         static_cast<vtkTypeInt32 *>(offsets->GetVoidPointer(0)),
+         static_cast<vtkTypeInt32 *>(connectivity->GetVoidPointer(0)))
+       > VTK_INT_MAX )
+    {
+    // The point ids were truncated, convert the cells again.
+    vtkWarningMacro("The point ids do not fit in 32 bit integers, "
+                    "storing them with 64 bits.");
+    idWidth = 64;
+    offsets->Delete();
+    connectivity->Delete();
+    if ( this->Offsets && this->IdWidth == idWidth )
+      {
+      return;
+      }
+    offsets = vtkCellArrayNewIdArray(idWidth);
+    connectivity = vtkCellArrayNewIdArray(idWidth);
+    offsets->SetNumberOfTuples(this->NumberOfCells + 1);
+    connectivity->SetNumberOfTuples(numEntries - this->NumberOfCells);
+    }
+  if ( idWidth == 64 )
+    {
+    vtkCellArrayToOffsets(this, this->NumberOfCells,
+      static_cast<vtkTypeInt64 *>(offsets->GetVoidPointer(0)),
+      static_cast<vtkTypeInt64 *>(connectivity->GetVoidPointer(0)));
+    }
+
+  this->ReleaseOffsets();
+  this->Ia->Initialize();
+  this->Offsets = offsets;
+  this->Connectivity = connectivity;
+  this->IdWidth = idWidth;
+  this->InsertLocation = numEntries;
+  this->TraversalLocation = 0;
+  this->TraversalCellId = 0;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::SetData(vtkDataArray *offsets, vtkDataArray *connectivity)
+{
+  if ( !offsets || !connectivity )
+    {
+    vtkErrorMacro("Both the offsets and the connectivity arrays are needed.");
+    return 0;
+    }
+
+  vtkDataArray *arrays[2] = { offsets, connectivity };
+  for (int i = 0; i < 2; i++)
+    {
+    int type = arrays[i]->GetDataType();
+    if ( type != VTK_INT && type != VTK_LONG && type != VTK_ID_TYPE &&
+         type != VTK_LONG_LONG && type != VTK___INT64 )
+      {
+      vtkErrorMacro("Cannot use an array of "
+                    << arrays[i]->GetDataTypeAsString() << " for the cells.");
+      return 0;
+      }
+    }
+  int idWidth = 8*offsets->GetDataTypeSize();
+  if ( 8*connectivity->GetDataTypeSize() != idWidth ||
+       (idWidth != 32 && idWidth != 64) )
+    {
+    vtkErrorMacro("The offsets and the connectivity must both be 32 or 64 "
+                  "bit integers.");
+    return 0;
+    }
+  if ( offsets->GetNumberOfComponents() != 1 ||
+       connectivity->GetNumberOfComponents() != 1 )
+    {
+    vtkErrorMacro("The offsets and the connectivity must have one component.");
+    return 0;
+    }
+
+  offsets->Register(this);
+  connectivity->Register(this);
+  this->ReleaseOffsets();
+  this->Ia->Initialize();
+  this->Offsets = offsets;
+  this->Connectivity = connectivity;
+  this->IdWidth = idWidth;
+  if ( offsets->GetMaxId() < 0 )
+    {
+    this->ResetOffsets();
+    }
+  this->NumberOfCells = offsets->GetMaxId();
+  this->InsertLocation = this->NumberOfCells + connectivity->GetMaxId() + 1;
+  this->TraversalLocation = 0;
+  this->TraversalCellId = 0;
+  this->Modified();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkCellArray::AllocateOffsets(vtkIdType sz, int ext)
+{
+  this->NumberOfCells = 0;
+  this->InsertLocation = 0;
+  this->TraversalLocation = 0;
+  this->TraversalCellId = 0;
+  int ok = this->Connectivity->Allocate(sz, ext);
+  this->ResetOffsets();
+  return ok;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::GetOffsetsCell(vtkIdType cellId, vtkIdType &npts,
+                                  vtkIdType* &pts)
+{
+  vtkCellArrayOffsetsCall(vtkCellArrayGetCell<VTK_TT>(
+    this->Offsets, this->Connectivity, cellId, npts, pts,
+    this->CellBuffer, this->CellBufferSize));
+}
+
+//----------------------------------------------------------------------------
+// Same as above, with ptIds as the buffer.
+void vtkCellArray::GetOffsetsCell(vtkIdType cellId, vtkIdType &npts,
+                                  vtkIdType* &pts, vtkIdList *ptIds)
+{
+  if ( this->IdWidth == 8*VTK_SIZEOF_ID_TYPE )
+    {
+    this->GetOffsetsCell(cellId, npts, pts);
+    return;
+    }
+  vtkCellArrayOffsetsCall(vtkCellArrayCopyCell<VTK_TT>(
+    this->Offsets, this->Connectivity, cellId, ptIds));
+  npts = ptIds->GetNumberOfIds();
+  pts = ptIds->GetPointer(0);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::GetCellIdAtLocation(vtkIdType loc)
+{
+  vtkCellArrayOffsetsCall(return vtkCellArrayGetCellIdAtLocation<VTK_TT>(
+    this->Offsets, this->NumberOfCells, loc));
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::InsertNextOffsetsCell(vtkIdType npts,
+                                              const vtkIdType* pts)
+{
+  vtkCellArrayOffsetsCall(vtkCellArrayInsertCell<VTK_TT>(
+    this->Offsets, this->Connectivity, this->NumberOfCells, npts, pts));
+  this->InsertLocation += npts + 1;
+  return this->NumberOfCells++;
+}
+
+//----------------------------------------------------------------------------
+// Adds a point to the last cell.
+void vtkCellArray::InsertOffsetsCellPoint(vtkIdType id)
+{
+  vtkCellArrayOffsetsCall(vtkCellArrayInsertCell<VTK_TT>(
+    this->Offsets, this->Connectivity, this->NumberOfCells - 1, 1, &id));
+  this->InsertLocation++;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ReverseOffsetsCell(vtkIdType cellId)
+{
+  vtkCellArrayOffsetsCall(vtkCellArrayReverseCell<VTK_TT>(
+    this->Offsets, this->Connectivity, cellId));
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ReplaceOffsetsCell(vtkIdType cellId, int npts,
+                                      const vtkIdType *pts)
+{
+  vtkCellArrayOffsetsCall(vtkCellArrayReplaceCell<VTK_TT>(
+    this->Offsets, this->Connectivity, cellId, npts, pts));
+}
+
+//----------------------------------------------------------------------------
+// Empties the offsets storage, leaving the single offset of the end of the
+// (no) cells.
+void vtkCellArray::ResetOffsets()
+{
+  this->Offsets->Reset();
+  this->Connectivity->Reset();
+  vtkIdType zero = 0;
+  vtkCellArrayOffsetsCall(*static_cast<VTK_TT *>(
+    this->Offsets->WriteVoidPointer(0, 1)) = static_cast<VTK_TT>(zero));
+}
+
+//----------------------------------------------------------------------------
+// Moves the cells from the offsets storage to Ia. The locations of the
+// cells, and the traversal and insertion locations, do not change.
+void vtkCellArray::ConvertToLegacy()
+{
+  this->Ia->SetNumberOfValues(this->NumberOfCells +
+                              this->Connectivity->GetMaxId() + 1);
+  vtkCellArrayOffsetsCall(vtkCellArrayToLegacy<VTK_TT>(
+    this->Offsets, this->Connectivity, this->NumberOfCells,
+    this->Ia->GetPointer(0)));
+  this->ReleaseOffsets();
+}
+
+//----------------------------------------------------------------------------
+// Drops the offsets storage; whatever Ia holds becomes the cells.
+void vtkCellArray::ReleaseOffsets()
+{
+  if ( this->Offsets )
+    {
+    this->Offsets->UnRegister(this);
+    this->Offsets = NULL;
+    this->Connectivity->UnRegister(this);
+    this->Connectivity = NULL;
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkCellArray::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -132,4 +737,7 @@ void vtkCellArray::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Cells: " << this->NumberOfCells << endl;
   os << indent << "Insert Location: " << this->InsertLocation << endl;
   os << indent << "Traversal Location: " << this->TraversalLocation << endl;
+  os << indent << "Storage: "
+     << (this->Offsets ? "Offsets" : "Legacy") << endl;
+  os << indent << "Id Width: " << this->GetIdWidth() << endl;
 }
@@ -26,6 +26,27 @@
 // using the vtkCellTypes and vtkCellLinks objects to extend the definition of
 // the data structure.
 //
+// Alternatively the cells can be stored as two arrays: a connectivity array
+// with the point ids of all the cells one after the other, and an offsets
+// array of NumberOfCells+1 entries where the cell i uses the ids from
+// offsets[i] up to (but not including) offsets[i+1]. This layout gives
+// constant time access to any cell (see GetCellAtId()), can store the ids
+// with 32 bit integers when vtkIdType is 64 bits wide, and can use
+// existing arrays (and through them externally owned buffers) without
+// copying them (see SetData()). The offsets storage is only used when asked
+// for with SetStorageToOffsets() or SetData(). The "locations" used by
+// GetCell(), ReverseCell(), ReplaceCell(), GetInsertLocation() and
+// GetTraversalLocation() are the positions of the cells in the interleaved
+// list with both storages, so they stay valid when the storage changes;
+// with the offsets storage, GetCell() finds the cell of a location with a
+// binary search, and GetCellAtId() is faster. GetData(), GetPointer() and
+// WritePointer() need the interleaved list and convert the cells to the
+// legacy storage. When the ids are not stored with the size of vtkIdType,
+// the point ids returned by GetNextCell(), GetCell() and GetCellAtId() are
+// copied to an internal buffer that is overwritten by the next such call,
+// so these methods must not be called by several threads at once; the
+// variants taking a vtkIdList copy the ids to that list instead.
+//
 // .SECTION See Also
 // vtkCellTypes vtkCellLinks
 
@@ -50,7 +71,13 @@ public:
   // Description:
   // Allocate memory and set the size to extend by.
   int Allocate(const vtkIdType sz, const int ext=1000)
-    {return this->Ia->Allocate(sz,ext);}
+    {
+    if ( this->Offsets )
+      {
+      return this->AllocateOffsets(sz,ext);
+      }
+    return this->Ia->Allocate(sz,ext);
+    }
 
   // Description:
   // Free any memory and reset to an empty state.
@@ -78,7 +105,8 @@ public:
   // Description:
   // A cell traversal methods that is more efficient than vtkDataSet traversal
   // methods.  InitTraversal() initializes the traversal of the list of cells.
-  void InitTraversal() {this->TraversalLocation=0;};
+  void InitTraversal()
+    {this->TraversalLocation=0; this->TraversalCellId=0;};
 
   // Description:
   // A cell traversal methods that is more efficient than vtkDataSet traversal
@@ -95,14 +123,27 @@ public:
   // Description:
   // Get the size of the allocated connectivity array.
   vtkIdType GetSize()
-    {return this->Ia->GetSize();}
+    {
+    if ( this->Offsets )
+      {
+      return this->NumberOfCells + this->Connectivity->GetSize();
+      }
+    return this->Ia->GetSize();
+    }
 
   // Description:
   // Get the total number of entries (i.e., data values) in the connectivity
   // array. This may be much less than the allocated size (i.e., return value
-  // from GetSize().)
+  // from GetSize().) With the offsets storage this is the size the
+  // interleaved list would have.
   vtkIdType GetNumberOfConnectivityEntries()
-    {return this->Ia->GetMaxId()+1;}
+    {
+    if ( this->Offsets )
+      {
+      return this->NumberOfCells + this->Connectivity->GetMaxId() + 1;
+      }
+    return this->Ia->GetMaxId()+1;
+    }
 
   // Description:
   // Internal method used to retrieve a cell given an offset into
@@ -114,6 +155,23 @@ public:
   // the internal array.
   void GetCell(vtkIdType loc, vtkIdList* pts);
 
+  // Description:
+  // Like GetCell(loc,npts,pts), but when the ids have to be copied they are
+  // copied to ptIds, and pts points into it. Unlike the internal buffer,
+  // ptIds is owned by the caller, so several threads can read cells at once.
+  void GetCell(vtkIdType loc, vtkIdType &npts, vtkIdType* &pts,
+               vtkIdList *ptIds);
+
+  // Description:
+  // Retrieve the cell with the given id. This takes constant time with the
+  // offsets storage, and walks the list from its beginning with the legacy
+  // storage. The variants taking a vtkIdList can be called by several
+  // threads at once (see GetCell()).
+  void GetCellAtId(vtkIdType cellId, vtkIdType &npts, vtkIdType* &pts);
+  void GetCellAtId(vtkIdType cellId, vtkIdType &npts, vtkIdType* &pts,
+                   vtkIdList *ptIds);
+  void GetCellAtId(vtkIdType cellId, vtkIdList *ptIds);
+
   // Description:
   // Insert a cell object. Return the cell id of the cell.
   vtkIdType InsertNextCell(vtkCell *cell);
@@ -156,7 +214,13 @@ public:
   vtkIdType GetTraversalLocation()
     {return this->TraversalLocation;}
   void SetTraversalLocation(vtkIdType loc)
-    {this->TraversalLocation = loc;}
+    {
+    this->TraversalLocation = loc;
+    if ( this->Offsets )
+      {
+      this->TraversalCellId = this->GetCellIdAtLocation(loc);
+      }
+    }
 
   // Description:
   // Computes the current traversal location within the internal array. Used
@@ -179,14 +243,16 @@ public:
   int GetMaxCellSize();
 
   // Description:
-  // Get pointer to array of cell data.
+  // Get pointer to array of cell data. This converts the cells to the
+  // legacy storage (see GetData()).
   vtkIdType *GetPointer()
-    {return this->Ia->GetPointer(0);}
+    {return this->GetData()->GetPointer(0);}
 
   // Description:
   // Get pointer to data array for purpose of direct writes of data. Size is the
   // total storage consumed by the cell array. ncells is the number of cells
-  // represented in the array.
+  // represented in the array. This switches the cell array to the legacy
+  // storage.
   vtkIdType *WritePointer(const vtkIdType ncells, const vtkIdType size);
 
   // Description:
@@ -196,17 +262,67 @@ public:
   // referring these cells becomes invalid (for example, if BuildCells() has
   // been called see vtkPolyData).  The traversal location is reset to the
   // beginning of the list; the insertion location is set to the end of the
-  // list.
+  // list. This switches the cell array to the legacy storage.
   void SetCells(vtkIdType ncells, vtkIdTypeArray *cells);
 
+  // Description:
+  // Select the storage of the cells: the legacy interleaved list, or
+  // separate offsets and connectivity arrays of 32 or 64 bit integers. The
+  // cells already present are converted; their locations do not change.
+  // When the connectivity or the point ids do not fit in 32 bit integers,
+  // they are stored with 64 bits instead, with a warning.
+  void SetStorageToLegacy();
+  void SetStorageToOffsets(int idWidth);
+
+  // Description:
+  // Return 1 if the cells are stored in offsets and connectivity arrays.
+  int IsStorageOffsets()
+    {return (this->Offsets != 0);}
+
+  // Description:
+  // Get the number of bits of the integers used to store the point ids.
+  int GetIdWidth()
+    {return (this->Offsets ? this->IdWidth : 8*VTK_SIZEOF_ID_TYPE);}
+
+  // Description:
+  // Use the given offsets and connectivity arrays as the storage of the
+  // cells, without copying them. The arrays must have a single component
+  // of signed 32 or 64 bit integers (both the same) and the offsets array
+  // at least one entry: the number of cells is one less than its number of
+  // values. To use an externally owned buffer, wrap it in an array with
+  // SetArray(ptr,size,1) first. Returns 0 if the arrays cannot be used.
+  int SetData(vtkDataArray *offsets, vtkDataArray *connectivity);
+
+  // Description:
+  // Return the offsets and connectivity arrays, or NULL with the legacy
+  // storage.
+  vtkDataArray *GetOffsetsArray()
+    {return this->Offsets;}
+  vtkDataArray *GetConnectivityArray()
+    {return this->Connectivity;}
+
   // Description:
   // Perform a deep copy (no reference counting) of the given cell array.
   void DeepCopy(vtkCellArray *ca);
 
   // Description:
-  // Return the underlying data as a data array.
+  // Return the underlying data as a data array. With the offsets storage,
+  // the cells are converted to the legacy storage first (as by
+  // SetStorageToLegacy(), but without modifying the cell array, as the
+  // cells and their locations do not change) so that the array returned can
+  // be modified. The conversion changes the storage, so it must not happen
+  // while other threads read the cells. Code that only reads the cells
+  // should use GetNextCell(), GetCellAtId(), or GetOffsetsArray() and
+  // GetConnectivityArray(), which keep the offsets storage.
   vtkIdTypeArray* GetData()
-    {return this->Ia;}
+    {
+    if ( this->Offsets )
+      {
+      vtkDebugMacro("Converting the cells to the legacy storage.");
+      this->ConvertToLegacy();
+      }
+    return this->Ia;
+    }
 
   // Description:
   // Reuse list. Reset to initial condition.
@@ -214,8 +330,7 @@ public:
 
   // Description:
   // Reclaim any extra memory.
-  void Squeeze()
-    {this->Ia->Squeeze();}
+  void Squeeze();
 
   // Description:
   // Return the memory in kilobytes consumed by this cell array. Used to
@@ -233,8 +348,31 @@ protected:
   vtkIdType NumberOfCells;
   vtkIdType InsertLocation;     //keep track of current insertion point
   vtkIdType TraversalLocation;   //keep track of traversal position
+  vtkIdType TraversalCellId;     //traversal position of the offsets storage
   vtkIdTypeArray *Ia;
 
+  // Offsets storage; Offsets is NULL with the legacy storage.
+  vtkDataArray *Offsets;
+  vtkDataArray *Connectivity;
+  int IdWidth;
+
+  // Holds the ids of the current cell when they are not stored as vtkIdType.
+  vtkIdType *CellBuffer;
+  vtkIdType CellBufferSize;
+
+  int AllocateOffsets(vtkIdType sz, int ext);
+  void GetOffsetsCell(vtkIdType cellId, vtkIdType &npts, vtkIdType* &pts);
+  void GetOffsetsCell(vtkIdType cellId, vtkIdType &npts, vtkIdType* &pts,
+                      vtkIdList *ptIds);
+  vtkIdType GetCellIdAtLocation(vtkIdType loc);
+  vtkIdType InsertNextOffsetsCell(vtkIdType npts, const vtkIdType* pts);
+  void InsertOffsetsCellPoint(vtkIdType id);
+  void ReverseOffsetsCell(vtkIdType cellId);
+  void ReplaceOffsetsCell(vtkIdType cellId, int npts, const vtkIdType *pts);
+  void ResetOffsets();
+  void ConvertToLegacy();
+  void ReleaseOffsets();
+
 private:
   vtkCellArray(const vtkCellArray&);  // Not implemented.
   void operator=(const vtkCellArray&);  // Not implemented.
@@ -245,6 +383,11 @@ private:
 inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
                                               const vtkIdType* pts)
 {
+  if ( this->Offsets )
+    {
+    return this->InsertNextOffsetsCell(npts, pts);
+    }
+
   vtkIdType i = this->Ia->GetMaxId() + 1;
   vtkIdType *ptr = this->Ia->WritePointer(i, npts+1);
 
@@ -262,6 +405,11 @@ inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 {
+  if ( this->Offsets )
+    {
+    return this->InsertNextOffsetsCell(0, 0);
+    }
+
   this->InsertLocation = this->Ia->InsertNextValue(npts) + 1;
   this->NumberOfCells++;
 
@@ -271,12 +419,24 @@ inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::InsertCellPoint(vtkIdType id)
 {
+  if ( this->Offsets )
+    {
+    this->InsertOffsetsCellPoint(id);
+    return;
+    }
+
   this->Ia->InsertValue(this->InsertLocation++, id);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::UpdateCellCount(int npts)
 {
+  // the offsets always match the points inserted so far
+  if ( this->Offsets )
+    {
+    return;
+    }
+
   this->Ia->SetValue(this->InsertLocation-npts-1, npts);
 }
 
@@ -299,12 +459,30 @@ inline void vtkCellArray::Reset()
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->TraversalCellId = 0;
   this->Ia->Reset();
+  if ( this->Offsets )
+    {
+    this->ResetOffsets();
+    }
 }
 
 //----------------------------------------------------------------------------
 inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 {
+  if ( this->Offsets )
+    {
+    if ( this->TraversalCellId < this->NumberOfCells )
+      {
+      this->GetOffsetsCell(this->TraversalCellId++, npts, pts);
+      this->TraversalLocation += npts + 1;
+      return 1;
+      }
+    npts=0;
+    pts=0;
+    return 0;
+    }
+
   if ( this->Ia->GetMaxId() >= 0 &&
        this->TraversalLocation <= this->Ia->GetMaxId() )
     {
@@ -322,6 +500,12 @@ inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 inline void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts,
                                   vtkIdType* &pts)
 {
+  if ( this->Offsets )
+    {
+    this->GetOffsetsCell(this->GetCellIdAtLocation(loc), npts, pts);
+    return;
+    }
+
   npts = this->Ia->GetValue(loc++);
   pts  = this->Ia->GetPointer(loc);
 }
@@ -329,6 +513,12 @@ inline void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts,
 //----------------------------------------------------------------------------
 inline void vtkCellArray::ReverseCell(vtkIdType loc)
 {
+  if ( this->Offsets )
+    {
+    this->ReverseOffsetsCell(this->GetCellIdAtLocation(loc));
+    return;
+    }
+
   int i;
   vtkIdType tmp;
   vtkIdType npts=this->Ia->GetValue(loc);
@@ -345,6 +535,12 @@ inline void vtkCellArray::ReverseCell(vtkIdType loc)
 inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
                                       const vtkIdType *pts)
 {
+  if ( this->Offsets )
+    {
+    this->ReplaceOffsetsCell(this->GetCellIdAtLocation(loc), npts, pts);
+    return;
+    }
+
   vtkIdType *oldPts=this->Ia->GetPointer(loc+1);
   for (int i=0; i < npts; i++)
     {
@@ -356,9 +552,14 @@ inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
 inline vtkIdType *vtkCellArray::WritePointer(const vtkIdType ncells,
                                              const vtkIdType size)
 {
+  if ( this->Offsets )
+    {
+    this->ReleaseOffsets();
+    }
   this->NumberOfCells = ncells;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->TraversalCellId = 0;
   return this->Ia->WritePointer(0,size);
 }
 
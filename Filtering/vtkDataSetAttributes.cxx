@@ -27,6 +27,7 @@
 #include "vtkUnsignedLongArray.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkObjectFactory.h"
 #include "vtkInformation.h"
@@ -713,6 +714,127 @@ void vtkDataSetAttributes::CopyData(vtkDataSetAttributes* fromPd,
     }
 }
 
+//--------------------------------------------------------------------------
+// Returns the two arrays as numeric arrays of the same type and number of
+// components, or 0 if the typed loops cannot be used for them.
+static int vtkDataSetAttributesGetTypedArrays(vtkAbstractArray* fromArray,
+                                              vtkAbstractArray* toArray,
+                                              vtkDataArray*& from,
+                                              vtkDataArray*& to)
+{
+  from = vtkDataArray::SafeDownCast(fromArray);
+  to = vtkDataArray::SafeDownCast(toArray);
+  return from && to && from->GetDataType() == to->GetDataType() &&
+    from->GetDataType() != VTK_BIT &&
+    from->GetNumberOfComponents() == to->GetNumberOfComponents();
+}
+
+//--------------------------------------------------------------------------
+template <class T>
+void vtkDataSetAttributesCopyTuples(const T* from, T* to, int numComp,
+                                    vtkIdType numIds, const vtkIdType* fromIds,
+                                    const vtkIdType* toIds, vtkIdType toId)
+{
+  for (vtkIdType i = 0; i < numIds; ++i)
+    {
+    const T* src = from + fromIds[i]*numComp;
+    T* dst = to + (toIds ? toIds[i] : toId + i)*numComp;
+    for (int c = 0; c < numComp; ++c)
+      {
+      dst[c] = src[c];
+      }
+    }
+}
+
+//--------------------------------------------------------------------------
+// Copies the tuples fromIds of one array into the tuples toIds, or into
+// consecutive tuples starting at toId when toIds is NULL. Arrays that are
+// not numeric arrays of the same type go through InsertTuple().
+static void vtkDataSetAttributesCopyArray(vtkAbstractArray* fromArray,
+                                          vtkAbstractArray* toArray,
+                                          vtkIdType numIds,
+                                          const vtkIdType* fromIds,
+                                          const vtkIdType* toIds,
+                                          vtkIdType toId, vtkIdType maxToId)
+{
+  vtkDataArray *from, *to;
+  if (vtkDataSetAttributesGetTypedArrays(fromArray, toArray, from, to))
+    {
+    int numComp = from->GetNumberOfComponents();
+    // Note that we must call WriteVoidPointer before GetVoidPointer
+    // in case WriteVoidPointer reallocates memory and from == to.
+    switch (from->GetDataType())
+      {
+      vtkTemplateMacro(
+        VTK_TT* vto = static_cast<VTK_TT*>(
+          to->WriteVoidPointer(0, (maxToId + 1)*numComp));
+        VTK_TT* vfrom = static_cast<VTK_TT*>(from->GetVoidPointer(0));
+        vtkDataSetAttributesCopyTuples(vfrom, vto, numComp, numIds,
+                                       fromIds, toIds, toId);
+        return;
+      );
+      }
+    }
+  for (vtkIdType i = 0; i < numIds; ++i)
+    {
+    toArray->InsertTuple(toIds ? toIds[i] : toId + i, fromIds[i], fromArray);
+    }
+}
+
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::CopyData(vtkDataSetAttributes* fromPd,
+                                    vtkIdList* fromIds, vtkIdList* toIds)
+{
+  vtkIdType numIds = fromIds->GetNumberOfIds();
+  if (toIds->GetNumberOfIds() != numIds)
+    {
+    vtkErrorMacro("The lists of ids to copy from and to differ in length.");
+    return;
+    }
+  if (numIds == 0)
+    {
+    return;
+    }
+  const vtkIdType* to = toIds->GetPointer(0);
+  vtkIdType maxToId = to[0];
+  for (vtkIdType j = 1; j < numIds; ++j)
+    {
+    maxToId = (to[j] > maxToId ? to[j] : maxToId);
+    }
+
+  int i;
+  for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
+      i=this->RequiredArrays.NextIndex())
+    {
+    vtkDataSetAttributesCopyArray(fromPd->Data[i],
+                                  this->Data[this->TargetIndices[i]],
+                                  numIds, fromIds->GetPointer(0), to, 0,
+                                  maxToId);
+    }
+}
+
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::CopyConsecutiveData(vtkDataSetAttributes* fromPd,
+                                               vtkIdList* fromIds,
+                                               vtkIdType toId)
+{
+  vtkIdType numIds = fromIds->GetNumberOfIds();
+  if (numIds == 0)
+    {
+    return;
+    }
+
+  int i;
+  for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
+      i=this->RequiredArrays.NextIndex())
+    {
+    vtkDataSetAttributesCopyArray(fromPd->Data[i],
+                                  this->Data[this->TargetIndices[i]],
+                                  numIds, fromIds->GetPointer(0), 0, toId,
+                                  toId + numIds - 1);
+    }
+}
+
 //--------------------------------------------------------------------------
 void vtkDataSetAttributes::CopyAllocate(vtkDataSetAttributes* pd,
                                         vtkIdType sze, vtkIdType ext,
@@ -777,6 +899,198 @@ void vtkDataSetAttributes::InterpolateEdge(vtkDataSetAttributes *fromPd,
     }
 }
 
+//--------------------------------------------------------------------------
+// Rounds as vtkDataArray::InterpolateTuple() does.
+template <class T>
+inline void vtkDataSetAttributesRound(double val, T* retVal)
+{
+  *retVal = static_cast<T>((val>=0.0)?(val + 0.5):(val - 0.5));
+}
+
+//--------------------------------------------------------------------------
+VTK_TEMPLATE_SPECIALIZE
+inline void vtkDataSetAttributesRound(double val, double* retVal)
+{
+  *retVal = val;
+}
+
+//--------------------------------------------------------------------------
+VTK_TEMPLATE_SPECIALIZE
+inline void vtkDataSetAttributesRound(double val, float* retVal)
+{
+  *retVal = static_cast<float>(val);
+}
+
+//--------------------------------------------------------------------------
+template <class T>
+void vtkDataSetAttributesInterpolateTuples(const T* from, T* to, int numComp,
+                                           vtkIdType toId,
+                                           vtkIdType numPoints,
+                                           const vtkIdType* offsets,
+                                           const vtkIdType* ids,
+                                           const double* weights)
+{
+  for (vtkIdType p = 0; p < numPoints; ++p)
+    {
+    T* dst = to + (toId + p)*numComp;
+    const vtkIdType* pids = ids + offsets[p];
+    const double* w = weights + offsets[p];
+    vtkIdType numIds = offsets[p+1] - offsets[p];
+    for (int i = 0; i < numComp; ++i)
+      {
+      double c = 0;
+      for (vtkIdType j = 0; j < numIds; ++j)
+        {
+        c += w[j]*static_cast<double>(from[pids[j]*numComp+i]);
+        }
+      // Round integer types. Don't round floating point types.
+      vtkDataSetAttributesRound(c, dst + i);
+      }
+    }
+}
+
+//--------------------------------------------------------------------------
+template <class T>
+void vtkDataSetAttributesInterpolateEdges(const T* from, T* to, int numComp,
+                                          vtkIdType toId, vtkIdType numEdges,
+                                          const vtkIdType* edges,
+                                          const double* t, int nearest)
+{
+  for (vtkIdType e = 0; e < numEdges; ++e)
+    {
+    double te = t[e];
+    if (nearest)
+      {
+      te = (te < 0.5) ? 0.0 : 1.0;
+      }
+    const T* from1 = from + edges[2*e]*numComp;
+    const T* from2 = from + edges[2*e+1]*numComp;
+    T* dst = to + (toId + e)*numComp;
+    for (int i = 0; i < numComp; ++i)
+      {
+      double c = (1.0 - te) * static_cast<double>(from1[i])
+        + te * static_cast<double>(from2[i]);
+      dst[i] = static_cast<T>(c);
+      }
+    }
+}
+
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::InterpolatePoints(vtkDataSetAttributes* fromPd,
+                                             vtkIdType toId,
+                                             vtkIdType numPoints,
+                                             const vtkIdType* offsets,
+                                             const vtkIdType* ids,
+                                             const double* weights)
+{
+  if (numPoints <= 0)
+    {
+    return;
+    }
+
+  vtkIdList* ptIds = 0;
+  int i;
+  for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
+      i=this->RequiredArrays.NextIndex())
+    {
+    vtkAbstractArray* fromArray = fromPd->Data[i];
+    vtkAbstractArray* toArray = this->Data[this->TargetIndices[i]];
+    vtkDataArray *from, *to;
+    if (vtkDataSetAttributesGetTypedArrays(fromArray, toArray, from, to))
+      {
+      int numComp = from->GetNumberOfComponents();
+      // Note that we must call WriteVoidPointer before GetVoidPointer
+      // in case WriteVoidPointer reallocates memory and from == to.
+      switch (from->GetDataType())
+        {
+        vtkTemplateMacro(
+          VTK_TT* vto = static_cast<VTK_TT*>(
+            to->WriteVoidPointer(0, (toId + numPoints)*numComp));
+          VTK_TT* vfrom = static_cast<VTK_TT*>(from->GetVoidPointer(0));
+          vtkDataSetAttributesInterpolateTuples(vfrom, vto, numComp, toId,
+                                                numPoints, offsets, ids,
+                                                weights);
+          continue;
+        );
+        }
+      }
+
+    if (!ptIds)
+      {
+      ptIds = vtkIdList::New();
+      }
+    for (vtkIdType p = 0; p < numPoints; ++p)
+      {
+      vtkIdType numIds = offsets[p+1] - offsets[p];
+      ptIds->SetNumberOfIds(numIds);
+      for (vtkIdType j = 0; j < numIds; ++j)
+        {
+        ptIds->SetId(j, ids[offsets[p] + j]);
+        }
+      toArray->InterpolateTuple(toId + p, ptIds, fromArray,
+                                const_cast<double*>(weights + offsets[p]));
+      }
+    }
+  if (ptIds)
+    {
+    ptIds->Delete();
+    }
+}
+
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::InterpolateEdges(vtkDataSetAttributes* fromPd,
+                                            vtkIdType toId, vtkIdType numEdges,
+                                            const vtkIdType* edges,
+                                            const double* t)
+{
+  if (numEdges <= 0)
+    {
+    return;
+    }
+
+  int i;
+  for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
+      i=this->RequiredArrays.NextIndex())
+    {
+    vtkAbstractArray* fromArray = fromPd->Data[i];
+    vtkAbstractArray* toArray = this->Data[this->TargetIndices[i]];
+
+    //check if the destination array needs nearest neighbor interpolation
+    int attributeIndex = this->IsArrayAnAttribute(this->TargetIndices[i]);
+    int nearest = (attributeIndex != -1
+                   && 
+                   this->CopyAttributeFlags[INTERPOLATE][attributeIndex]==2);
+
+    vtkDataArray *from, *to;
+    if (vtkDataSetAttributesGetTypedArrays(fromArray, toArray, from, to))
+      {
+      int numComp = from->GetNumberOfComponents();
+      switch (from->GetDataType())
+        {
+        vtkTemplateMacro(
+          VTK_TT* vto = static_cast<VTK_TT*>(
+            to->WriteVoidPointer(0, (toId + numEdges)*numComp));
+          VTK_TT* vfrom = static_cast<VTK_TT*>(from->GetVoidPointer(0));
+          vtkDataSetAttributesInterpolateEdges(vfrom, vto, numComp, toId,
+                                               numEdges, edges, t, nearest);
+          continue;
+        );
+        }
+      }
+
+    for (vtkIdType e = 0; e < numEdges; ++e)
+      {
+      double bt = t[e];
+      if (nearest)
+        {
+        bt = (bt < 0.5) ? 0.0 : 1.0;
+        }
+      toArray->InterpolateTuple(toId + e, edges[2*e], fromArray,
+                                edges[2*e+1], fromArray, bt);
+      }
+    }
+}
+
 //--------------------------------------------------------------------------
 // Interpolate data from the two points p1,p2 (forming an edge) and an 
 // interpolation factor, t, along the edge. The weight ranges from (0,1), 
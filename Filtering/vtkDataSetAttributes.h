@@ -450,6 +450,21 @@ public:
   // CopyAllOn/Off
   void CopyData(vtkDataSetAttributes *fromPd, vtkIdType fromId, vtkIdType toId);
 
+  // Description:
+  // Copy the attribute data of the tuples fromIds into the tuples toIds
+  // (the i-th id of one list into the i-th id of the other). This gives
+  // the same result as calling CopyData() for each pair of ids, but every
+  // numeric array is copied in one typed loop instead of one virtual call
+  // per tuple. Make sure CopyAllocate() has been invoked before using this
+  // method.
+  void CopyData(vtkDataSetAttributes *fromPd, vtkIdList *fromIds,
+                vtkIdList *toIds);
+
+  // Description:
+  // Same as the method above, copying into the consecutive tuples starting
+  // at toId.
+  void CopyConsecutiveData(vtkDataSetAttributes *fromPd, vtkIdList *fromIds,
+                           vtkIdType toId);
 
   // Description:
   // Copy a tuple of data from one data array to another. This method
@@ -497,6 +512,28 @@ public:
   void InterpolateEdge(vtkDataSetAttributes *fromPd, vtkIdType toId,
                        vtkIdType p1, vtkIdType p2, double t);
 
+//BTX
+  // Description:
+  // Interpolate numPoints consecutive tuples starting at toId. The i-th
+  // tuple is interpolated from the tuples ids[offsets[i]] to
+  // ids[offsets[i+1]-1] with the matching weights, as InterpolatePoint()
+  // does. fromPd may be this object, in which case a tuple may be
+  // interpolated from tuples written earlier in the same call. Every
+  // numeric array is interpolated in one typed loop.
+  void InterpolatePoints(vtkDataSetAttributes *fromPd, vtkIdType toId,
+                         vtkIdType numPoints, const vtkIdType *offsets,
+                         const vtkIdType *ids, const double *weights);
+
+  // Description:
+  // Interpolate numEdges consecutive tuples starting at toId, the i-th one
+  // along the edge (edges[2*i], edges[2*i+1]) with the factor t[i], as
+  // InterpolateEdge() does. Every numeric array is interpolated in one
+  // typed loop.
+  void InterpolateEdges(vtkDataSetAttributes *fromPd, vtkIdType toId,
+                        vtkIdType numEdges, const vtkIdType *edges,
+                        const double *t);
+//ETX
+
   // Description:
   // Interpolate data from the same id (point or cell) at different points
   // in time (parameter t). Two input data set attributes objects are input.
@@ -22,6 +22,7 @@
 #include "vtkEmptyCell.h"
 #include "vtkGenericCell.h"
 #include "vtkHexahedron.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -478,9 +479,16 @@ vtkCell *vtkUnstructuredGrid::GetCell(vtkIdType cellId)
   vtkCell *cell = NULL;
   vtkIdType *pts, numPts;
 
-  loc = this->Locations->GetValue(cellId);
-  vtkDebugMacro(<< "location = " <<  loc);
-  this->Connectivity->GetCell(loc,numPts,pts);
+  if ( this->Connectivity->IsStorageOffsets() )
+    {
+    this->Connectivity->GetCellAtId(cellId,numPts,pts);
+    }
+  else
+    {
+    loc = this->Locations->GetValue(cellId);
+    vtkDebugMacro(<< "location = " <<  loc);
+    this->Connectivity->GetCell(loc,numPts,pts);
+    }
 
   int cellType = static_cast<int>(this->Types->GetValue(cellId));
   switch (cellType)
@@ -792,17 +800,34 @@ void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
   int cellType = static_cast<int>(this->Types->GetValue(cellId));
   cell->SetCellType(cellType);
 
-  loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
+  // With the offsets storage, the ids are copied to the cell rather than
+  // to the buffer of the cell array, so that threads can read cells at once.
+  if ( this->Connectivity->IsStorageOffsets() )
+    {
+    this->Connectivity->GetCellAtId(cellId, cell->PointIds);
+    numPts = cell->PointIds->GetNumberOfIds();
+    pts = cell->PointIds->GetPointer(0);
+    cell->Points->SetNumberOfPoints(numPts);
+    for (i=0; i<numPts; i++)
+      {
+      this->Points->GetPoint(pts[i], x);
+      cell->Points->SetPoint(i, x);
+      }
+    }
+  else
+    {
+    loc = this->Locations->GetValue(cellId);
+    this->Connectivity->GetCell(loc,numPts,pts);
 
-  cell->PointIds->SetNumberOfIds(numPts);
-  cell->Points->SetNumberOfPoints(numPts);
+    cell->PointIds->SetNumberOfIds(numPts);
+    cell->Points->SetNumberOfPoints(numPts);
 
-  for (i=0; i<numPts; i++)
-    {
-    cell->PointIds->SetId(i,pts[i]);
-    this->Points->GetPoint(pts[i], x);
-    cell->Points->SetPoint(i, x);
+    for (i=0; i<numPts; i++)
+      {
+      cell->PointIds->SetId(i,pts[i]);
+      this->Points->GetPoint(pts[i], x);
+      cell->Points->SetPoint(i, x);
+      }
     }
 
   // Explicit face representation
@@ -828,9 +853,18 @@ void vtkUnstructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
   vtkIdType loc;
   double x[3];
   vtkIdType *pts, numPts;
+  vtkIdList *ptIds = NULL;
 
-  loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
+  if ( this->Connectivity->IsStorageOffsets() )
+    {
+    ptIds = vtkIdList::New();
+    this->Connectivity->GetCellAtId(cellId,numPts,pts,ptIds);
+    }
+  else
+    {
+    loc = this->Locations->GetValue(cellId);
+    this->Connectivity->GetCell(loc,numPts,pts);
+    }
 
   // carefully compute the bounds
   if (numPts)
@@ -858,6 +892,11 @@ void vtkUnstructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
     vtkMath::UninitializeBounds(bounds);
     }
 
+  if ( ptIds )
+    {
+    ptIds->Delete();
+    }
+
 }
 
 //----------------------------------------------------------------------------
@@ -959,13 +998,14 @@ vtkIdType vtkUnstructuredGrid::InsertNextCell(int type, vtkIdType npts,
         }
       }
     
-    // insert cell location
-    this->Locations->InsertNextValue(this->Connectivity->GetData()->GetMaxId()+1);
     // insert face location
     this->FaceLocations->InsertNextValue(this->Faces->GetMaxId()+1);
     // insert cell connectivity and faces stream
     vtkUnstructuredGrid::DecomposeAPolyhedronCell(
         npts, ptIds, realnpts, this->Connectivity, this->Faces);
+    // insert cell location
+    this->Locations->InsertNextValue(
+      this->Connectivity->GetInsertLocation(realnpts));
     }
 
   return this->Types->InsertNextValue(static_cast<unsigned char>(type));
@@ -1294,6 +1334,12 @@ void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
   vtkIdType i, loc;
   vtkIdType *pts, numPts;
 
+  if ( this->Connectivity->IsStorageOffsets() )
+    {
+    this->Connectivity->GetCellAtId(cellId,ptIds);
+    return;
+    }
+
   loc = this->Locations->GetValue(cellId);
   this->Connectivity->GetCell(loc,numPts,pts);
   ptIds->SetNumberOfIds(numPts);
@@ -1312,6 +1358,14 @@ void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
 {
   vtkIdType loc;
 
+  // The offsets storage finds the cell by its id, without the binary
+  // search of its location.
+  if ( this->Connectivity->IsStorageOffsets() )
+    {
+    this->Connectivity->GetCellAtId(cellId,npts,pts);
+    return;
+    }
+
   loc = this->Locations->GetValue(cellId);
 
   this->Connectivity->GetCell(loc,npts,pts);
@@ -121,6 +121,11 @@ public:
 
   int GetCellType(vtkIdType cellId);
   vtkUnsignedCharArray* GetCellTypesArray() { return this->Types; }
+
+  // Description:
+  // The locations of the cells in the cell array, which are the positions
+  // of the cells in its interleaved list (see vtkCellArray::GetCell()) with
+  // either storage of the cell array.
   vtkIdTypeArray* GetCellLocationsArray() { return this->Locations; }
   void Squeeze();
   void Initialize();
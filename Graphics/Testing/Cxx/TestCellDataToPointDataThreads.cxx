@@ -0,0 +1,220 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellDataToPointDataThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkPointDataToCellData and vtkCellDataToPointData, serial and
+// threaded, produce exactly the averages that InterpolatePoint() gives, for
+// image data, structured grids, poly data and unstructured grids carrying
+// arrays of several types and numbers of components.
+
+#include <vtkCellData.h>
+#include <vtkCellDataToPointData.h>
+#include <vtkDataSetSurfaceFilter.h>
+#include <vtkDataSetTriangleFilter.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkIdList.h>
+#include <vtkImageData.h>
+#include <vtkIntArray.h>
+#include <vtkPointData.h>
+#include <vtkPointDataToCellData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkRTAnalyticSource.h>
+#include <vtkSmartPointer.h>
+#include <vtkStructuredGrid.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <math.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+// Compares the arrays of a with those of the same name in b, exactly, or
+// within a relative tolerance for the floating point arrays only.
+static int CompareData(vtkDataSetAttributes* a, vtkDataSetAttributes* b,
+                       double tolerance, const char* what)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+    {
+    cerr << what << ": " << a->GetNumberOfArrays() << " arrays instead of "
+         << b->GetNumberOfArrays() << endl;
+    return 0;
+    }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray* x = a->GetArray(i);
+    vtkDataArray* y = b->GetArray(x->GetName());
+    if (!y || x->GetDataType() != y->GetDataType() ||
+        x->GetNumberOfTuples() != y->GetNumberOfTuples() ||
+        x->GetNumberOfComponents() != y->GetNumberOfComponents())
+      {
+      cerr << what << ": array " << x->GetName() << " differs." << endl;
+      return 0;
+      }
+    int c = x->GetNumberOfComponents();
+    if (tolerance != 0.0 && x->GetDataType() != VTK_FLOAT &&
+        x->GetDataType() != VTK_DOUBLE)
+      {
+      continue;
+      }
+    for (vtkIdType j = 0; j < x->GetNumberOfTuples() * c; ++j)
+      {
+      double u = x->GetComponent(j / c, j % c);
+      double v = y->GetComponent(j / c, j % c);
+      if (tolerance == 0.0 ? u != v :
+          fabs(u - v) > tolerance * (1.0 + fabs(u)))
+        {
+        cerr << what << ": array " << x->GetName() << " differs at " << j
+             << ": " << u << " vs. " << v << endl;
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+// The averages as the filters computed them one point or cell at a time.
+static void InterpolateSerially(vtkDataSet* input, vtkDataSetAttributes* in,
+                                vtkDataSetAttributes* out, int toCells)
+{
+  vtkIdType n = toCells ? input->GetNumberOfCells() : input->GetNumberOfPoints();
+  out->InterpolateAllocate(in, n);
+  vtkIdList* ids = vtkIdList::New();
+  double weights[4096];
+  for (vtkIdType id = 0; id < n; ++id)
+    {
+    if (toCells)
+      {
+      input->GetCellPoints(id, ids);
+      }
+    else
+      {
+      input->GetPointCells(id, ids);
+      }
+    vtkIdType m = ids->GetNumberOfIds();
+    for (vtkIdType j = 0; j < m; ++j)
+      {
+      weights[j] = 1.0 / m;
+      }
+    out->InterpolatePoint(in, id, ids, weights);
+    }
+  ids->Delete();
+}
+
+static int TestDataSet(vtkDataSet* input, const char* what)
+{
+  int ok = 1;
+  int unstructured = input->IsA("vtkUnstructuredGrid");
+
+  vsp(CellData, cellReference);
+  InterpolateSerially(input, input->GetPointData(), cellReference, 1);
+
+  for (int numThreads = 1; numThreads <= 4; numThreads += 3)
+    {
+    vsp(PointDataToCellData, p2c);
+      p2c->SetInput(input);
+      p2c->SetNumberOfThreads(numThreads);
+      p2c->Update();
+    vtkDataSet* withCellData = p2c->GetOutput();
+    ok &= CompareData(cellReference, withCellData->GetCellData(), 0.0, what);
+
+    // The unstructured grid algorithm averages in the type of the arrays,
+    // so its integer averages truncate, or wrap around, where
+    // InterpolatePoint() rounds; those are only compared across threads.
+    vsp(PointData, pointReference);
+    InterpolateSerially(withCellData, withCellData->GetCellData(),
+                        pointReference, 0);
+
+    vsp(CellDataToPointData, c2p);
+      c2p->SetInput(withCellData);
+      c2p->SetNumberOfThreads(numThreads);
+      c2p->Update();
+    ok &= CompareData(pointReference, c2p->GetOutput()->GetPointData(),
+                      unstructured ? 1e-5 : 0.0, what);
+
+    if (unstructured)
+      {
+      vsp(CellDataToPointData, serial);
+        serial->SetInput(withCellData);
+        serial->Update();
+      ok &= CompareData(serial->GetOutput()->GetPointData(),
+                        c2p->GetOutput()->GetPointData(), 0.0, what);
+      }
+    }
+  return ok;
+}
+
+// Adds point arrays of several types computed from RTData.
+static void AddArrays(vtkDataSet* data)
+{
+  vtkDataArray* rt = data->GetPointData()->GetArray("RTData");
+  vsp(DoubleArray, vectors);
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vsp(IntArray, ints);
+  ints->SetName("Ints");
+  vsp(UnsignedCharArray, chars);
+  chars->SetName("Chars");
+  chars->SetNumberOfComponents(2);
+  for (vtkIdType i = 0; i < data->GetNumberOfPoints(); ++i)
+    {
+    double v = rt->GetTuple1(i);
+    double* x = data->GetPoint(i);
+    vectors->InsertNextTuple3(x[0] * v, x[1] - v, 1.0 / (1.0 + v * v));
+    ints->InsertNextValue(static_cast<int>(v * 1000) - 150000);
+    chars->InsertNextTuple2(static_cast<int>(v) % 256, i % 7);
+    }
+  data->GetPointData()->AddArray(vectors);
+  data->GetPointData()->AddArray(ints);
+  data->GetPointData()->AddArray(chars);
+}
+
+int TestCellDataToPointDataThreads(int, char*[])
+{
+  int ok = 1;
+
+  vsp(RTAnalyticSource, wavelet);
+    wavelet->SetWholeExtent(-12, 12, -12, 12, -12, 12);
+    wavelet->SetCenter(0, 0, 0);
+    wavelet->Update();
+
+  vsp(ImageData, image);
+  image->DeepCopy(wavelet->GetOutput());
+  AddArrays(image);
+  ok &= TestDataSet(image, "vtkImageData");
+
+  vsp(StructuredGrid, sgrid);
+  vsp(Points, points);
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    points->InsertNextPoint(image->GetPoint(i));
+    }
+  sgrid->SetDimensions(image->GetDimensions());
+  sgrid->SetPoints(points);
+  sgrid->GetPointData()->ShallowCopy(image->GetPointData());
+  ok &= TestDataSet(sgrid, "vtkStructuredGrid");
+
+  vsp(DataSetSurfaceFilter, surface);
+    surface->SetInput(image);
+    surface->Update();
+  ok &= TestDataSet(surface->GetOutput(), "vtkPolyData");
+
+  vsp(DataSetTriangleFilter, tets);
+    tets->SetInput(image);
+    tets->Update();
+  ok &= TestDataSet(tets->GetOutput(), "vtkUnstructuredGrid");
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestContourGridThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the multithreaded contouring of an unstructured grid with
+// vtkContourGrid and vtkCutter produces exactly the same output as the
+// serial one.
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkContourGrid.h>
+#include <vtkCutter.h>
+#include <vtkDataArray.h>
+#include <vtkDataSetTriangleFilter.h>
+#include <vtkPlane.h>
+#include <vtkPointData.h>
+#include <vtkPointDataToCellData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkRTAnalyticSource.h>
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static int CompareArrays(vtkDataArray* a, vtkDataArray* b, const char* what)
+{
+  if (!a && !b)
+    {
+    return 1;
+    }
+  if (!a || !b)
+    {
+    cerr << "Missing " << what << " array." << endl;
+    return 0;
+    }
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    cerr << "Mismatched " << what << " sizes: " << a->GetNumberOfTuples()
+         << " vs. " << b->GetNumberOfTuples() << endl;
+    return 0;
+    }
+  vtkIdType nvalues = a->GetNumberOfTuples() * a->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < nvalues; ++i)
+    {
+    int c = a->GetNumberOfComponents();
+    if (a->GetComponent(i / c, i % c) != b->GetComponent(i / c, i % c))
+      {
+      cerr << "Mismatched " << what << " value at " << i << endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
+static int ComparePolyData(vtkPolyData* x, vtkPolyData* y, const char* what)
+{
+  if (x->GetNumberOfCells() == 0)
+    {
+    cerr << what << ": the serial output has no cells." << endl;
+    return 0;
+    }
+  if (x->GetNumberOfPoints() != y->GetNumberOfPoints() ||
+      x->GetNumberOfCells() != y->GetNumberOfCells())
+    {
+    cerr << what << ": serial output has " << x->GetNumberOfPoints()
+         << " points, " << x->GetNumberOfCells() << " cells; threaded output "
+         << y->GetNumberOfPoints() << " points, "
+         << y->GetNumberOfCells() << " cells." << endl;
+    return 0;
+    }
+  if (x->GetPointData()->GetNumberOfArrays() !=
+      y->GetPointData()->GetNumberOfArrays())
+    {
+    cerr << what << ": mismatched number of point data arrays." << endl;
+    return 0;
+    }
+
+  int ok = 1;
+  ok &= CompareArrays(x->GetPoints()->GetData(),
+                      y->GetPoints()->GetData(), "point coordinates");
+  ok &= CompareArrays(x->GetPolys()->GetData(),
+                      y->GetPolys()->GetData(), "connectivity");
+  ok &= CompareArrays(x->GetPointData()->GetScalars(),
+                      y->GetPointData()->GetScalars(), "point scalars");
+  ok &= CompareArrays(x->GetPointData()->GetArray("RTData"),
+                      y->GetPointData()->GetArray("RTData"), "point data");
+  ok &= CompareArrays(x->GetCellData()->GetArray("RTData"),
+                      y->GetCellData()->GetArray("RTData"), "cell data");
+  return ok;
+}
+
+int TestContourGridThreads(int, char*[])
+{
+  vsp(RTAnalyticSource, wavelet);
+    wavelet->SetWholeExtent(-24, 24, -24, 24, -24, 24);
+    wavelet->SetCenter(0, 0, 0);
+
+  vsp(PointDataToCellData, p2c);
+    p2c->SetInputConnection(wavelet->GetOutputPort());
+    p2c->PassPointDataOn();
+
+  vsp(DataSetTriangleFilter, tets);
+    tets->SetInputConnection(p2c->GetOutputPort());
+    tets->Update();
+
+  vtkUnstructuredGrid* input = tets->GetOutput();
+  input->GetPointData()->SetActiveScalars("RTData");
+
+  int ok = 1;
+
+  // isosurfaces for several values
+  vsp(ContourGrid, serial);
+    serial->SetInput(input);
+    serial->GenerateValues(5, 100.0, 250.0);
+    serial->Update();
+
+  vsp(ContourGrid, threaded);
+    threaded->SetInput(input);
+    threaded->GenerateValues(5, 100.0, 250.0);
+    threaded->SetNumberOfThreads(4);
+    threaded->Update();
+
+  ok &= ComparePolyData(serial->GetOutput(), threaded->GetOutput(),
+                        "vtkContourGrid");
+
+  // the same with the cells stored as offsets and connectivity, whose
+  // point ids the threads read at once
+  vsp(UnstructuredGrid, offsetsInput);
+    offsetsInput->DeepCopy(input);
+    offsetsInput->GetCells()->SetStorageToOffsets(32);
+
+  vsp(ContourGrid, threadedOffsets);
+    threadedOffsets->SetInput(offsetsInput);
+    threadedOffsets->GenerateValues(5, 100.0, 250.0);
+    threadedOffsets->SetNumberOfThreads(4);
+    threadedOffsets->Update();
+
+  ok &= ComparePolyData(serial->GetOutput(), threadedOffsets->GetOutput(),
+                        "vtkContourGrid with offsets storage");
+  if (!offsetsInput->GetCells()->IsStorageOffsets())
+    {
+    cerr << "vtkContourGrid converted the cells of its input." << endl;
+    ok = 0;
+    }
+
+  // cuts, with and without cut scalars
+  vsp(Plane, plane);
+    plane->SetOrigin(0.5, 0.5, 0.5);
+    plane->SetNormal(1, 1, 1);
+
+  for (int generate = 0; generate <= 1; ++generate)
+    {
+    vsp(Cutter, serialCut);
+      serialCut->SetInput(input);
+      serialCut->SetCutFunction(plane);
+      serialCut->GenerateValues(3, -10.0, 10.0);
+      serialCut->SetGenerateCutScalars(generate);
+      serialCut->Update();
+
+    vsp(Cutter, threadedCut);
+      threadedCut->SetInput(input);
+      threadedCut->SetCutFunction(plane);
+      threadedCut->GenerateValues(3, -10.0, 10.0);
+      threadedCut->SetGenerateCutScalars(generate);
+      threadedCut->SetNumberOfThreads(4);
+      threadedCut->Update();
+
+    ok &= ComparePolyData(serialCut->GetOutput(), threadedCut->GetOutput(),
+                          "vtkCutter");
+    }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,278 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetSurfaceFilterFaceTable.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkDataSetSurfaceFilter produces exactly the same surface of
+// an unstructured grid with the face table, serial and threaded, as with
+// the face hash, for a tetrahedral grid and for a grid mixing hexahedra,
+// voxels, wedges, pyramids and a few vertices and quads, and that a grid
+// of empty cells without points has an empty surface.
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkCellType.h>
+#include <vtkDataArray.h>
+#include <vtkDataSetSurfaceFilter.h>
+#include <vtkDataSetTriangleFilter.h>
+#include <vtkIdTypeArray.h>
+#include <vtkIntArray.h>
+#include <vtkPointData.h>
+#include <vtkPointDataToCellData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkRTAnalyticSource.h>
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static int CompareArrays(vtkDataArray* a, vtkDataArray* b, const char* what)
+{
+  if (!a && !b)
+    {
+    return 1;
+    }
+  if (!a || !b)
+    {
+    cerr << "Missing " << what << " array." << endl;
+    return 0;
+    }
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    cerr << "Mismatched " << what << " sizes: " << a->GetNumberOfTuples()
+         << " vs. " << b->GetNumberOfTuples() << endl;
+    return 0;
+    }
+  vtkIdType nvalues = a->GetNumberOfTuples() * a->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < nvalues; ++i)
+    {
+    int c = a->GetNumberOfComponents();
+    if (a->GetComponent(i / c, i % c) != b->GetComponent(i / c, i % c))
+      {
+      cerr << "Mismatched " << what << " value at " << i << endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
+static int ComparePolyData(vtkPolyData* x, vtkPolyData* y, const char* what)
+{
+  if (x->GetNumberOfPolys() == 0)
+    {
+    cerr << what << ": the hash output has no polygons." << endl;
+    return 0;
+    }
+  if (x->GetNumberOfPoints() != y->GetNumberOfPoints() ||
+      x->GetNumberOfCells() != y->GetNumberOfCells())
+    {
+    cerr << what << ": hash output has " << x->GetNumberOfPoints()
+         << " points, " << x->GetNumberOfCells() << " cells; face table output "
+         << y->GetNumberOfPoints() << " points, "
+         << y->GetNumberOfCells() << " cells." << endl;
+    return 0;
+    }
+
+  int ok = 1;
+  ok &= CompareArrays(x->GetPoints()->GetData(),
+                      y->GetPoints()->GetData(), "point coordinates");
+  ok &= CompareArrays(x->GetVerts()->GetData(),
+                      y->GetVerts()->GetData(), "vertices");
+  ok &= CompareArrays(x->GetPolys()->GetData(),
+                      y->GetPolys()->GetData(), "polygons");
+  ok &= CompareArrays(x->GetPointData()->GetArray("RTData"),
+                      y->GetPointData()->GetArray("RTData"), "point data");
+  ok &= CompareArrays(x->GetCellData()->GetArray("RTData"),
+                      y->GetCellData()->GetArray("RTData"), "cell data");
+  ok &= CompareArrays(x->GetCellData()->GetArray("vtkOriginalCellIds"),
+                      y->GetCellData()->GetArray("vtkOriginalCellIds"),
+                      "original cell ids");
+  return ok;
+}
+
+static int TestGrid(vtkUnstructuredGrid* input, const char* what)
+{
+  vsp(DataSetSurfaceFilter, hash);
+    hash->SetInput(input);
+    hash->UseFaceTableOff();
+    hash->PassThroughCellIdsOn();
+    hash->Update();
+
+  if (hash->GetPeakFaceHashMemorySize() == 0)
+    {
+    cerr << what << ": the memory of the hash was not reported." << endl;
+    return 0;
+    }
+
+  int ok = 1;
+  for (int numThreads = 1; numThreads <= 4; numThreads += 3)
+    {
+    vsp(DataSetSurfaceFilter, table);
+      table->SetInput(input);
+      table->SetNumberOfThreads(numThreads);
+      table->PassThroughCellIdsOn();
+      table->Update();
+
+    ok &= ComparePolyData(hash->GetOutput(), table->GetOutput(), what);
+    if (table->GetPeakFaceHashMemorySize() == 0)
+      {
+      cerr << what << ": the memory of the face table was not reported."
+           << endl;
+      ok = 0;
+      }
+    }
+  return ok;
+}
+
+// Builds a grid of n*n*n blocks, each made of a hexahedron, a voxel, two
+// wedges or six pyramids around a new center point, with a vertex on every
+// tenth point and a quad on some of the faces of the blocks.
+static void BuildMixedGrid(vtkUnstructuredGrid* grid, int n)
+{
+  vsp(Points, points);
+  vsp(IntArray, pointData);
+  pointData->SetName("RTData");
+  vsp(IntArray, cellData);
+  cellData->SetName("RTData");
+
+  int m = n + 1;
+  int i, j, k;
+  for (k = 0; k < m; ++k)
+    {
+    for (j = 0; j < m; ++j)
+      {
+      for (i = 0; i < m; ++i)
+        {
+        points->InsertNextPoint(i, j + 0.1 * i, k + 0.01 * j);
+        pointData->InsertNextValue(i + 2 * j + 3 * k);
+        }
+      }
+    }
+
+  grid->Allocate(8 * n * n * n);
+  vtkIdType pts[8];
+  for (k = 0; k < n; ++k)
+    {
+    for (j = 0; j < n; ++j)
+      {
+      for (i = 0; i < n; ++i)
+        {
+        vtkIdType p0 = i + m * (j + m * k);
+        vtkIdType v[8] = { p0, p0 + 1, p0 + m, p0 + m + 1,
+                           p0 + m * m, p0 + m * m + 1,
+                           p0 + m * m + m, p0 + m * m + m + 1 };
+        int block = (i + 2 * j + 3 * k) % 4;
+        if (block == 0)
+          {
+          vtkIdType hex[8] = { v[0], v[1], v[3], v[2],
+                               v[4], v[5], v[7], v[6] };
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+          cellData->InsertNextValue(0);
+          }
+        else if (block == 1)
+          {
+          grid->InsertNextCell(VTK_VOXEL, 8, v);
+          cellData->InsertNextValue(1);
+          }
+        else if (block == 2)
+          {
+          vtkIdType w0[6] = { v[0], v[1], v[2], v[4], v[5], v[6] };
+          vtkIdType w1[6] = { v[1], v[3], v[2], v[5], v[7], v[6] };
+          grid->InsertNextCell(VTK_WEDGE, 6, w0);
+          cellData->InsertNextValue(2);
+          grid->InsertNextCell(VTK_WEDGE, 6, w1);
+          cellData->InsertNextValue(3);
+          }
+        else
+          {
+          vtkIdType c = points->InsertNextPoint(i + 0.5, j + 0.5 + 0.1 * i,
+                                                k + 0.5 + 0.01 * j);
+          pointData->InsertNextValue(-1);
+          vtkIdType faces[6][4] = {
+            { v[0], v[1], v[3], v[2] }, { v[4], v[6], v[7], v[5] },
+            { v[0], v[4], v[5], v[1] }, { v[2], v[3], v[7], v[6] },
+            { v[0], v[2], v[6], v[4] }, { v[1], v[5], v[7], v[3] } };
+          for (int f = 0; f < 6; ++f)
+            {
+            pts[0] = faces[f][0];
+            pts[1] = faces[f][1];
+            pts[2] = faces[f][2];
+            pts[3] = faces[f][3];
+            pts[4] = c;
+            grid->InsertNextCell(VTK_PYRAMID, 5, pts);
+            cellData->InsertNextValue(4 + f);
+            }
+          }
+        if ((i + j + k) % 7 == 0)
+          {
+          vtkIdType quad[4] = { v[0], v[1], v[3], v[2] };
+          grid->InsertNextCell(VTK_QUAD, 4, quad);
+          cellData->InsertNextValue(10);
+          }
+        }
+      }
+    }
+  for (vtkIdType p = 0; p < m * m * m; p += 10)
+    {
+    grid->InsertNextCell(VTK_VERTEX, 1, &p);
+    cellData->InsertNextValue(11);
+    }
+
+  grid->SetPoints(points);
+  grid->GetPointData()->AddArray(pointData);
+  grid->GetCellData()->AddArray(cellData);
+}
+
+int TestDataSetSurfaceFilterFaceTable(int, char*[])
+{
+  int ok = 1;
+
+  vsp(RTAnalyticSource, wavelet);
+    wavelet->SetWholeExtent(-16, 16, -16, 16, -16, 16);
+    wavelet->SetCenter(0, 0, 0);
+
+  vsp(PointDataToCellData, p2c);
+    p2c->SetInputConnection(wavelet->GetOutputPort());
+    p2c->PassPointDataOn();
+
+  vsp(DataSetTriangleFilter, tets);
+    tets->SetInputConnection(p2c->GetOutputPort());
+    tets->Update();
+
+  ok &= TestGrid(tets->GetOutput(), "Tetrahedra");
+
+  vsp(UnstructuredGrid, mixed);
+  BuildMixedGrid(mixed, 14);
+  ok &= TestGrid(mixed, "Mixed cells");
+
+  vsp(UnstructuredGrid, empty);
+  vsp(Points, noPoints);
+  empty->SetPoints(noPoints);
+  empty->Allocate(4);
+  for (int i = 0; i < 4; ++i)
+    {
+    empty->InsertNextCell(VTK_EMPTY_CELL, 0, static_cast<vtkIdType*>(0));
+    }
+  vsp(DataSetSurfaceFilter, emptySurface);
+    emptySurface->SetInput(empty);
+    emptySurface->Update();
+  if (emptySurface->GetOutput()->GetNumberOfCells() != 0)
+    {
+    cerr << "Empty cells: the surface is not empty." << endl;
+    ok = 0;
+    }
+
+  return ok ? 0 : 1;
+}
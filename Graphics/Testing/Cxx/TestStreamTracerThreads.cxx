@@ -0,0 +1,205 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStreamTracerThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkStreamTracer integrating on several threads produces
+// exactly the streamlines, in the same order, as on one thread, on image
+// data and on an unstructured grid with both interpolator types.
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkDataSetTriangleFilter.h>
+#include <vtkDoubleArray.h>
+#include <vtkImageData.h>
+#include <vtkPointData.h>
+#include <vtkPointSource.h>
+#include <vtkPolyData.h>
+#include <vtkRTAnalyticSource.h>
+#include <vtkSmartPointer.h>
+#include <vtkStreamTracer.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <string.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+// Compares the arrays of a with those of the same name in b exactly.
+static int CompareData(vtkDataSetAttributes* a, vtkDataSetAttributes* b,
+                       const char* what)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+    {
+    cerr << what << ": " << b->GetNumberOfArrays() << " arrays instead of "
+         << a->GetNumberOfArrays() << endl;
+    return 0;
+    }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray* x = a->GetArray(i);
+    vtkDataArray* y = b->GetArray(x->GetName());
+    if (!y || x->GetDataType() != y->GetDataType() ||
+        x->GetNumberOfTuples() != y->GetNumberOfTuples() ||
+        x->GetNumberOfComponents() != y->GetNumberOfComponents())
+      {
+      cerr << what << ": array " << x->GetName() << " differs." << endl;
+      return 0;
+      }
+    int c = x->GetNumberOfComponents();
+    for (vtkIdType j = 0; j < x->GetNumberOfTuples() * c; ++j)
+      {
+      if (x->GetComponent(j / c, j % c) != y->GetComponent(j / c, j % c))
+        {
+        cerr << what << ": array " << x->GetName() << " differs at " << j
+             << endl;
+        return 0;
+        }
+      }
+    }
+  vtkDataArray* va = a->GetVectors();
+  vtkDataArray* vb = b->GetVectors();
+  if ((va == 0) != (vb == 0) || (va && strcmp(va->GetName(), vb->GetName())))
+    {
+    cerr << what << ": the active vectors differ." << endl;
+    return 0;
+    }
+  return 1;
+}
+
+static int ComparePolyData(vtkPolyData* a, vtkPolyData* b, const char* what)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfLines() != b->GetNumberOfLines())
+    {
+    cerr << what << ": " << b->GetNumberOfPoints() << " points and "
+         << b->GetNumberOfLines() << " lines instead of "
+         << a->GetNumberOfPoints() << " and " << a->GetNumberOfLines()
+         << endl;
+    return 0;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+    {
+    double x[3], y[3];
+    a->GetPoint(i, x);
+    b->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+      cerr << what << ": point " << i << " differs." << endl;
+      return 0;
+      }
+    }
+  vtkIdType npa, *pta, npb, *ptb;
+  vtkCellArray* la = a->GetLines();
+  vtkCellArray* lb = b->GetLines();
+  la->InitTraversal();
+  lb->InitTraversal();
+  while (la->GetNextCell(npa, pta))
+    {
+    lb->GetNextCell(npb, ptb);
+    if (npa != npb)
+      {
+      cerr << what << ": the lines differ." << endl;
+      return 0;
+      }
+    for (vtkIdType j = 0; j < npa; ++j)
+      {
+      if (pta[j] != ptb[j])
+        {
+        cerr << what << ": the lines differ." << endl;
+        return 0;
+        }
+      }
+    }
+  return CompareData(a->GetPointData(), b->GetPointData(), what) &&
+    CompareData(a->GetCellData(), b->GetCellData(), what);
+}
+
+static int TestDataSet(vtkDataSet* input, vtkDataSet* seeds,
+                       int interpolatorType, const char* what)
+{
+  int ok = 1;
+  vsp(PolyData, reference);
+  for (int numThreads = 1; numThreads <= 7; numThreads += 3)
+    {
+    vsp(StreamTracer, tracer);
+      tracer->SetInput(input);
+      tracer->SetSource(seeds);
+      tracer->SetInputArrayToProcess(
+        0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Velocity");
+      tracer->SetInterpolatorType(interpolatorType);
+      tracer->SetIntegratorTypeToRungeKutta45();
+      tracer->SetIntegrationDirectionToBoth();
+      tracer->SetMaximumPropagation(30);
+      tracer->SetNumberOfThreads(numThreads);
+      tracer->Update();
+    if (numThreads == 1)
+      {
+      reference->DeepCopy(tracer->GetOutput());
+      if (reference->GetNumberOfLines() < 100)
+        {
+        cerr << what << ": too few streamlines." << endl;
+        return 0;
+        }
+      }
+    else
+      {
+      ok &= ComparePolyData(reference, tracer->GetOutput(), what);
+      }
+    }
+  return ok;
+}
+
+int TestStreamTracerThreads(int, char*[])
+{
+  int ok = 1;
+
+  // A vortex around the z axis, with the wavelet values interpolated on
+  // the streamlines.
+  vsp(RTAnalyticSource, wavelet);
+    wavelet->SetWholeExtent(-10, 10, -10, 10, -5, 5);
+    wavelet->SetCenter(0, 0, 0);
+    wavelet->Update();
+  vsp(ImageData, image);
+  image->DeepCopy(wavelet->GetOutput());
+  vsp(DoubleArray, velocity);
+  velocity->SetName("Velocity");
+  velocity->SetNumberOfComponents(3);
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    double* x = image->GetPoint(i);
+    velocity->InsertNextTuple3(-x[1], x[0], 0.2 * x[0]);
+    }
+  image->GetPointData()->AddArray(velocity);
+
+  vsp(PointSource, seeds);
+    seeds->SetCenter(2, 0, 0);
+    seeds->SetRadius(4);
+    seeds->SetNumberOfPoints(150);
+    seeds->Update();
+
+  ok &= TestDataSet(image, seeds->GetOutput(),
+                    vtkStreamTracer::INTERPOLATOR_WITH_DATASET_POINT_LOCATOR,
+                    "vtkImageData");
+
+  vsp(DataSetTriangleFilter, tets);
+    tets->SetInput(image);
+    tets->Update();
+  ok &= TestDataSet(tets->GetOutput(), seeds->GetOutput(),
+                    vtkStreamTracer::INTERPOLATOR_WITH_DATASET_POINT_LOCATOR,
+                    "vtkUnstructuredGrid");
+  ok &= TestDataSet(tets->GetOutput(), seeds->GetOutput(),
+                    vtkStreamTracer::INTERPOLATOR_WITH_CELL_LOCATOR,
+                    "vtkUnstructuredGrid with a cell locator");
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTableBasedClipDataSetLargeIds.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Clips a synthetic hexahedral vtkUnstructuredGrid with a plane located
+// between two layers of points and checks the point ids of the output against
+// the exact counts. The grid dimensions may be given on the command line, e.g.
+//   TestTableBasedClipDataSetLargeIds -Dims 3 2 536870913
+// to exercise input and output point ids beyond 2^31 with VTK_USE_64BIT_IDS.
+// This needs about 150 GB of memory, so the corresponding test,
+// TestTableBasedClipDataSetLargeIds2G, is only added with VTK_TEST_LARGE_IDS.
+
+#include <vtkCellArray.h>
+#include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkSmartPointer.h>
+#include <vtkTableBasedClipDataSet.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+// Generates a grid of dims[0] x dims[1] x dims[2] points and hexahedra in
+// between, with the x coordinate as the point scalars.
+static void GenerateHexGrid(const vtkIdType dims[3], vtkUnstructuredGrid* grid)
+{
+  vtkIdType numPts = dims[0] * dims[1] * dims[2];
+  vtkIdType numCells = (dims[0] - 1) * (dims[1] - 1) * (dims[2] - 1);
+
+  vsp(Points, points);
+  points->SetNumberOfPoints(numPts);
+  vsp(FloatArray, scalars);
+  scalars->SetName("X");
+  scalars->SetNumberOfTuples(numPts);
+  float* x = scalars->GetPointer(0);
+
+  vtkIdType i, j, k, ptId = 0;
+  for (k = 0; k < dims[2]; ++k)
+    {
+    for (j = 0; j < dims[1]; ++j)
+      {
+      for (i = 0; i < dims[0]; ++i, ++ptId)
+        {
+        points->SetPoint(ptId, i, j, k);
+        x[ptId] = static_cast<float>(i);
+        }
+      }
+    }
+
+  vsp(IdTypeArray, conn);
+  conn->SetNumberOfValues(9 * numCells);
+  vtkIdType* c = conn->GetPointer(0);
+  vtkIdType sy = dims[0], sz = dims[0] * dims[1];
+  for (k = 0; k < dims[2] - 1; ++k)
+    {
+    for (j = 0; j < dims[1] - 1; ++j)
+      {
+      for (i = 0; i < dims[0] - 1; ++i)
+        {
+        vtkIdType p0 = i + j * sy + k * sz;
+        *c++ = 8;
+        *c++ = p0;
+        *c++ = p0 + 1;
+        *c++ = p0 + 1 + sy;
+        *c++ = p0 + sy;
+        *c++ = p0 + sz;
+        *c++ = p0 + 1 + sz;
+        *c++ = p0 + 1 + sy + sz;
+        *c++ = p0 + sy + sz;
+        }
+      }
+    }
+  vsp(CellArray, cells);
+  cells->SetCells(numCells, conn);
+
+  grid->SetPoints(points);
+  grid->SetCells(VTK_HEXAHEDRON, cells);
+  grid->GetPointData()->SetScalars(scalars);
+}
+
+int TestTableBasedClipDataSetLargeIds(int argc, char* argv[])
+{
+  vtkIdType dims[3] = { 40, 30, 20 };
+  for (int arg = 1; arg + 3 < argc; ++arg)
+    {
+    if (strcmp(argv[arg], "-Dims") == 0)
+      {
+      for (int i = 0; i < 3; ++i)
+        {
+        dims[i] = static_cast<vtkIdType>(atof(argv[arg + i + 1]));
+        }
+      }
+    }
+  if (dims[0] < 3 || dims[1] < 2 || dims[2] < 2 ||
+      static_cast<double>(dims[0]) * dims[1] * dims[2] >
+      static_cast<double>(VTK_LARGE_ID))
+    {
+    cerr << "The grid dimensions " << dims[0] << " x " << dims[1] << " x "
+         << dims[2] << " can not be used with this vtkIdType." << endl;
+    return 1;
+    }
+
+  vsp(UnstructuredGrid, grid);
+  GenerateHexGrid(dims, grid);
+
+  // Keep the points with x > cut; every x-edge of the layer of cells at the
+  // cut is split once, so the output has exactly the points with x > cut and
+  // one new point per such edge.
+  vtkIdType cut = dims[0] / 2;
+  vsp(TableBasedClipDataSet, clipper);
+  clipper->SetInput(grid);
+  clipper->SetValue(cut + 0.5);
+  clipper->Update();
+
+  vtkUnstructuredGrid* output = clipper->GetOutput();
+  vtkIdType expectedPts = (dims[0] - cut) * dims[1] * dims[2];
+  vtkIdType minCells = (dims[0] - cut - 1) * (dims[1] - 1) * (dims[2] - 1);
+  if (output->GetNumberOfPoints() != expectedPts)
+    {
+    cerr << "Expected " << expectedPts << " points, got "
+         << output->GetNumberOfPoints() << endl;
+    return 1;
+    }
+  if (output->GetNumberOfCells() < minCells)
+    {
+    cerr << "Expected at least " << minCells << " cells, got "
+         << output->GetNumberOfCells() << endl;
+    return 1;
+    }
+
+  // every point must be referenced by an in-range id
+  vtkIdType maxId = -1;
+  vtkIdType npts, *pts;
+  vtkCellArray* cells = output->GetCells();
+  for (cells->InitTraversal(); cells->GetNextCell(npts, pts); )
+    {
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      if (pts[i] < 0 || pts[i] >= expectedPts)
+        {
+        cerr << "Point id " << pts[i] << " out of range." << endl;
+        return 1;
+        }
+      maxId = (pts[i] > maxId ? pts[i] : maxId);
+      }
+    }
+  if (maxId != expectedPts - 1)
+    {
+    cerr << "Expected a largest point id of " << expectedPts - 1
+         << ", got " << maxId << endl;
+    return 1;
+    }
+
+  // the output points must lie on the kept side of the cut
+  double bounds[6];
+  output->GetBounds(bounds);
+  if (bounds[0] != cut + 0.5 || bounds[1] != dims[0] - 1)
+    {
+    cerr << "Unexpected x range: " << bounds[0] << ", " << bounds[1] << endl;
+    return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTableBasedClipDataSetThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the multithreaded clipping of an unstructured grid produces
+// exactly the same output as the serial one, with the cells of the input
+// stored in the legacy layout and as offsets.
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkDataArray.h>
+#include <vtkDataSetTriangleFilter.h>
+#include <vtkPointData.h>
+#include <vtkPointDataToCellData.h>
+#include <vtkPoints.h>
+#include <vtkRTAnalyticSource.h>
+#include <vtkSmartPointer.h>
+#include <vtkTableBasedClipDataSet.h>
+#include <vtkUnstructuredGrid.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static int CompareArrays(vtkDataArray* a, vtkDataArray* b, const char* what)
+{
+  if (!a || !b)
+    {
+    cerr << "Missing " << what << " array." << endl;
+    return 0;
+    }
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    cerr << "Mismatched " << what << " sizes: " << a->GetNumberOfTuples()
+         << " vs. " << b->GetNumberOfTuples() << endl;
+    return 0;
+    }
+  vtkIdType nvalues = a->GetNumberOfTuples() * a->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < nvalues; ++i)
+    {
+    int c = a->GetNumberOfComponents();
+    if (a->GetComponent(i / c, i % c) != b->GetComponent(i / c, i % c))
+      {
+      cerr << "Mismatched " << what << " value at " << i << endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
+int TestTableBasedClipDataSetThreads(int, char*[])
+{
+  vsp(RTAnalyticSource, wavelet);
+    wavelet->SetWholeExtent(-24, 24, -24, 24, -24, 24);
+    wavelet->SetCenter(0, 0, 0);
+
+  vsp(PointDataToCellData, p2c);
+    p2c->SetInputConnection(wavelet->GetOutputPort());
+    p2c->PassPointDataOn();
+
+  vsp(DataSetTriangleFilter, tets);
+    tets->SetInputConnection(p2c->GetOutputPort());
+    tets->Update();
+
+  vtkUnstructuredGrid* input = tets->GetOutput();
+  input->GetPointData()->SetActiveScalars("RTData");
+
+  vsp(TableBasedClipDataSet, serial);
+    serial->SetInput(input);
+    serial->SetValue(150.0);
+    serial->Update();
+
+  vsp(UnstructuredGrid, offsets);
+    offsets->DeepCopy(input);
+    offsets->GetCells()->SetStorageToOffsets(32);
+
+  vtkUnstructuredGrid* inputs[2] = { input, offsets };
+  vtkUnstructuredGrid* x = serial->GetOutput();
+  if (x->GetNumberOfCells() == 0)
+    {
+    cerr << "The serial clip produced no cells." << endl;
+    return 1;
+    }
+
+  int ok = 1;
+  for (int k = 0; k < 2; ++k)
+    {
+    vsp(TableBasedClipDataSet, threaded);
+      threaded->SetInput(inputs[k]);
+      threaded->SetValue(150.0);
+      threaded->SetNumberOfThreads(4);
+      threaded->Update();
+
+    vtkUnstructuredGrid* y = threaded->GetOutput();
+    if (x->GetNumberOfPoints() != y->GetNumberOfPoints() ||
+        x->GetNumberOfCells() != y->GetNumberOfCells())
+      {
+      cerr << "Serial clip: " << x->GetNumberOfPoints() << " points, "
+           << x->GetNumberOfCells() << " cells; threaded clip: "
+           << y->GetNumberOfPoints() << " points, "
+           << y->GetNumberOfCells() << " cells." << endl;
+      return 1;
+      }
+
+    ok &= CompareArrays(x->GetPoints()->GetData(),
+                        y->GetPoints()->GetData(), "point coordinates");
+    ok &= CompareArrays(x->GetCells()->GetData(),
+                        y->GetCells()->GetData(), "connectivity");
+    ok &= CompareArrays(x->GetPointData()->GetArray("RTData"),
+                        y->GetPointData()->GetArray("RTData"), "point data");
+    ok &= CompareArrays(x->GetCellData()->GetArray("RTData"),
+                        y->GetCellData()->GetArray("RTData"), "cell data");
+    }
+
+  if (!offsets->GetCells()->IsStorageOffsets())
+    {
+    cerr << "The clip converted the cells of its input." << endl;
+    ok = 0;
+    }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeDataSetSurfaceFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Times the surface extraction of an unstructured grid by
+// vtkDataSetSurfaceFilter with the face hash and with the face table, and
+// reports the memory used to match the faces.
+//
+// Usage: TimeDataSetSurfaceFilter [size [threads [tets]]]
+// The grid is made of size^3 hexahedra, or of tetrahedra if tets is 1.
+
+#include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <stdlib.h>
+
+static double TimeSurface(vtkUnstructuredGrid *input, int useFaceTable,
+                          int numThreads, vtkPolyData *output,
+                          unsigned long &memory)
+{
+  vtkDataSetSurfaceFilter *surface = vtkDataSetSurfaceFilter::New();
+  surface->SetInput(input);
+  surface->SetUseFaceTable(useFaceTable);
+  surface->SetNumberOfThreads(numThreads);
+
+  vtkTimerLog *timer = vtkTimerLog::New();
+  timer->StartTimer();
+  surface->Update();
+  timer->StopTimer();
+  double time = timer->GetElapsedTime();
+
+  memory = surface->GetPeakFaceHashMemorySize();
+  output->ShallowCopy(surface->GetOutput());
+  timer->Delete();
+  surface->Delete();
+  return time;
+}
+
+int main( int argc, char *argv[] )
+{
+  int size = 100;
+  int numThreads = 4;
+  int tets = 0;
+  if (argc > 1)
+    {
+    size = atoi(argv[1]);
+    }
+  if (argc > 2)
+    {
+    numThreads = atoi(argv[2]);
+    }
+  if (argc > 3)
+    {
+    tets = atoi(argv[3]);
+    }
+
+  vtkImageData *image = vtkImageData::New();
+  image->SetDimensions(size + 1, size + 1, size + 1);
+  vtkDataSetTriangleFilter *triangulate = vtkDataSetTriangleFilter::New();
+  triangulate->SetInput(image);
+  vtkUnstructuredGrid *input = vtkUnstructuredGrid::New();
+  if (tets)
+    {
+    triangulate->Update();
+    input->ShallowCopy(triangulate->GetOutput());
+    }
+  else
+    {
+    vtkIdType pts[8];
+    input->Allocate(size * size * size);
+    for (vtkIdType cellId = 0; cellId < image->GetNumberOfCells(); ++cellId)
+      {
+      vtkIdList *ids = image->GetCell(cellId)->GetPointIds();
+      static const int order[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
+      for (int i = 0; i < 8; ++i)
+        {
+        pts[i] = ids->GetId(order[i]);
+        }
+      input->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+      }
+    vtkPoints *points = vtkPoints::New();
+    points->SetNumberOfPoints(image->GetNumberOfPoints());
+    for (vtkIdType ptId = 0; ptId < image->GetNumberOfPoints(); ++ptId)
+      {
+      points->SetPoint(ptId, image->GetPoint(ptId));
+      }
+    input->SetPoints(points);
+    points->Delete();
+    }
+  triangulate->Delete();
+  image->Delete();
+
+  cout << input->GetNumberOfCells() << (tets ? " tetrahedra, " : " hexahedra, ")
+       << input->GetNumberOfPoints() << " points" << endl;
+
+  vtkPolyData *hashOutput = vtkPolyData::New();
+  vtkPolyData *serialOutput = vtkPolyData::New();
+  vtkPolyData *threadedOutput = vtkPolyData::New();
+  unsigned long hashMemory, serialMemory, threadedMemory;
+  double hashTime = TimeSurface(input, 0, 1, hashOutput, hashMemory);
+  double serialTime = TimeSurface(input, 1, 1, serialOutput, serialMemory);
+  double threadedTime =
+    TimeSurface(input, 1, numThreads, threadedOutput, threadedMemory);
+
+  cout << "face hash:               " << hashTime << " s, "
+       << hashMemory << " KB" << endl;
+  cout << "face table, 1 thread:    " << serialTime << " s, "
+       << serialMemory << " KB" << endl;
+  cout << "face table, " << numThreads << " threads:   " << threadedTime
+       << " s, " << threadedMemory << " KB" << endl;
+
+  // The surfaces must be identical.
+  int ok = 1;
+  vtkIdTypeArray *hashPolys = hashOutput->GetPolys()->GetData();
+  vtkPolyData *outputs[2] = { serialOutput, threadedOutput };
+  for (int o = 0; o < 2; ++o)
+    {
+    vtkIdTypeArray *polys = outputs[o]->GetPolys()->GetData();
+    if (outputs[o]->GetNumberOfPoints() != hashOutput->GetNumberOfPoints() ||
+        polys->GetNumberOfTuples() != hashPolys->GetNumberOfTuples())
+      {
+      ok = 0;
+      continue;
+      }
+    for (vtkIdType i = 0; i < polys->GetNumberOfTuples(); ++i)
+      {
+      if (polys->GetValue(i) != hashPolys->GetValue(i))
+        {
+        ok = 0;
+        break;
+        }
+      }
+    }
+  if (!ok)
+    {
+    cerr << "The face table and the face hash surfaces differ." << endl;
+    }
+
+  hashOutput->Delete();
+  serialOutput->Delete();
+  threadedOutput->Delete();
+  input->Delete();
+  return ok ? 0 : 1;
+}
@@ -18,16 +18,21 @@
 #include "vtkCell.h"
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
+#include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkStructuredData.h"
+#include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkSmartPointer.h"
-#include "vtkUnsignedIntArray.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 
-#include <algorithm>
-#include <functional>
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
 
 vtkStandardNewMacro(vtkCellDataToPointData);
 
@@ -36,10 +41,372 @@ vtkStandardNewMacro(vtkCellDataToPointData);
 vtkCellDataToPointData::vtkCellDataToPointData()
 {
   this->PassCellData = 0;
+  this->NumberOfThreads = 1;
+  this->Threader = vtkMultiThreader::New();
+}
+
+//----------------------------------------------------------------------------
+vtkCellDataToPointData::~vtkCellDataToPointData()
+{
+  this->Threader->Delete();
 }
 
 #define VTK_MAX_CELLS_PER_POINT 4096
 
+//----------------------------------------------------------------------------
+// The cells of each point. Image data, rectilinear and structured grids
+// compute them from their dimensions, other datasets store them in lists
+// built once from the points of the cells, in the order in which
+// vtkCellLinks lists them.
+struct vtkCellDataToPointDataLinks
+{
+  int Structured;
+  int Dimensions[3];
+  vtkstd::vector<vtkIdType> Offsets;
+  vtkstd::vector<vtkIdType> Cells;
+};
+
+//----------------------------------------------------------------------------
+// Returns 0 for the datasets whose cells are not known to be safely
+// accessed this way.
+static int vtkCellDataToPointDataBuildLinks(vtkDataSet *input,
+                                            vtkCellDataToPointDataLinks &links)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType cellId, i;
+
+  links.Structured = 1;
+  if (vtkImageData *image = vtkImageData::SafeDownCast(input))
+    {
+    image->GetDimensions(links.Dimensions);
+    return 1;
+    }
+  if (vtkRectilinearGrid *rgrid = vtkRectilinearGrid::SafeDownCast(input))
+    {
+    rgrid->GetDimensions(links.Dimensions);
+    return 1;
+    }
+  if (vtkStructuredGrid *sgrid = vtkStructuredGrid::SafeDownCast(input))
+    {
+    sgrid->GetDimensions(links.Dimensions);
+    return 1;
+    }
+  links.Structured = 0;
+
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (!grid && !vtkPolyData::SafeDownCast(input))
+    {
+    return 0;
+    }
+
+  // Count the uses of each point, turn the counts into offsets, and list
+  // the cells in increasing order.
+  vtkIdList *cellPts = vtkIdList::New();
+  vtkIdType npts, *pts;
+  links.Offsets.assign(numPts + 1, 0);
+  for (cellId = 0; cellId < numCells; cellId++)
+    {
+    if (grid)
+      {
+      grid->GetCellPoints(cellId, npts, pts);
+      }
+    else
+      {
+      input->GetCellPoints(cellId, cellPts);
+      npts = cellPts->GetNumberOfIds();
+      pts = cellPts->GetPointer(0);
+      }
+    for (i = 0; i < npts; i++)
+      {
+      links.Offsets[pts[i] + 1]++;
+      }
+    }
+  for (i = 0; i < numPts; i++)
+    {
+    links.Offsets[i + 1] += links.Offsets[i];
+    }
+  links.Cells.resize(links.Offsets[numPts]);
+  vtkstd::vector<vtkIdType> next(links.Offsets.begin(), links.Offsets.end() - 1);
+  for (cellId = 0; cellId < numCells; cellId++)
+    {
+    if (grid)
+      {
+      grid->GetCellPoints(cellId, npts, pts);
+      }
+    else
+      {
+      input->GetCellPoints(cellId, cellPts);
+      npts = cellPts->GetNumberOfIds();
+      pts = cellPts->GetPointer(0);
+      }
+    for (i = 0; i < npts; i++)
+      {
+      links.Cells[next[pts[i]]++] = cellId;
+      }
+    }
+  cellPts->Delete();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+static inline vtkIdType vtkCellDataToPointDataGetCells(
+  vtkCellDataToPointDataLinks *links, vtkIdType ptId, vtkIdList *cellIds,
+  const vtkIdType *&cells)
+{
+  if (links->Structured)
+    {
+    vtkStructuredData::GetPointCells(ptId, cellIds, links->Dimensions);
+    cells = cellIds->GetPointer(0);
+    return cellIds->GetNumberOfIds();
+    }
+  vtkIdType offset = links->Offsets[ptId];
+  cells = links->Cells.empty() ? 0 : &links->Cells[offset];
+  return links->Offsets[ptId + 1] - offset;
+}
+
+//----------------------------------------------------------------------------
+// Averages one tuple as vtkDataArray::InterpolateTuple() does with equal
+// weights, rounding the integer types.
+template <class T>
+inline void vtkCellDataToPointDataRound(double val, T *retVal)
+{
+  *retVal = static_cast<T>((val>=0.0)?(val + 0.5):(val - 0.5));
+}
+
+VTK_TEMPLATE_SPECIALIZE
+inline void vtkCellDataToPointDataRound(double val, double *retVal)
+{
+  *retVal = val;
+}
+
+VTK_TEMPLATE_SPECIALIZE
+inline void vtkCellDataToPointDataRound(double val, float *retVal)
+{
+  *retVal = static_cast<float>(val);
+}
+
+template <class T>
+static void vtkCellDataToPointDataInterpolate(const void *source, void *target,
+                                              int numComp, vtkIdType ptId,
+                                              const vtkIdType *cells,
+                                              vtkIdType numCells,
+                                              double weight)
+{
+  const T *from = static_cast<const T *>(source);
+  T *to = static_cast<T *>(target) + ptId*numComp;
+  for (int i = 0; i < numComp; ++i)
+    {
+    double c = 0;
+    for (vtkIdType j = 0; j < numCells; ++j)
+      {
+      c += weight*static_cast<double>(from[cells[j]*numComp+i]);
+      }
+    vtkCellDataToPointDataRound(c, to + i);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Averages one tuple in the type of the array, as the unstructured grid
+// algorithm always did.
+template <class T>
+static void vtkCellDataToPointDataAverage(const void *source, void *target,
+                                          int numComp, vtkIdType ptId,
+                                          const vtkIdType *cells,
+                                          vtkIdType numCells, double)
+{
+  const T *from = static_cast<const T *>(source);
+  T *to = static_cast<T *>(target) + ptId*numComp;
+  for (int i = 0; i < numComp; ++i)
+    {
+    T c = T(0);
+    for (vtkIdType j = 0; j < numCells; ++j)
+      {
+      c = static_cast<T>(c + from[cells[j]*numComp+i]);
+      }
+    // guard against divide by zero
+    if (numCells)
+      {
+      c = static_cast<T>(c / static_cast<T>(numCells));
+      }
+    to[i] = c;
+    }
+}
+
+typedef void (*vtkCellDataToPointDataFunction)(const void *, void *, int,
+                                               vtkIdType, const vtkIdType *,
+                                               vtkIdType, double);
+
+struct vtkCellDataToPointDataArray
+{
+  const void *Source;
+  void *Target;
+  int NumberOfComponents;
+  vtkCellDataToPointDataFunction Function;
+};
+
+struct vtkCellDataToPointDataThreadStruct
+{
+  vtkCellDataToPointData *Filter;
+  vtkCellDataToPointDataLinks *Links;
+  vtkstd::vector<vtkCellDataToPointDataArray> Arrays;
+  vtkIdType NumberOfPoints;
+  // When not NULL, the points with no cells, or too many, are flagged
+  // instead of being averaged.
+  unsigned char *NullPoints;
+};
+
+//----------------------------------------------------------------------------
+// Adds an array to be averaged by interpolation (as InterpolatePoint() does)
+// or in its own type.
+static void vtkCellDataToPointDataAddArray(
+  vtkCellDataToPointDataThreadStruct &data, vtkDataArray *source,
+  vtkDataArray *target, int interpolate)
+{
+  vtkCellDataToPointDataArray array;
+  array.Source = source->GetVoidPointer(0);
+  array.Target = target->GetVoidPointer(0);
+  array.NumberOfComponents = source->GetNumberOfComponents();
+  array.Function = 0;
+  switch (source->GetDataType())
+    {
+    vtkTemplateMacro(
+      array.Function = interpolate ?
+        vtkCellDataToPointDataInterpolate<VTK_TT> :
+        vtkCellDataToPointDataAverage<VTK_TT>);
+    }
+  // Bit arrays are left alone.
+  if (array.Function)
+    {
+    data.Arrays.push_back(array);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Each thread averages all the arrays over its own range of points.
+static VTK_THREAD_RETURN_TYPE vtkCellDataToPointDataThread(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkCellDataToPointDataThreadStruct *data =
+    static_cast<vtkCellDataToPointDataThreadStruct *>(info->UserData);
+
+  vtkIdType numPts = data->NumberOfPoints;
+  vtkIdType perThread = numPts / info->NumberOfThreads;
+  vtkIdType extra = numPts % info->NumberOfThreads;
+  vtkIdType id = info->ThreadID;
+  vtkIdType begin = id*perThread + (id < extra ? id : extra);
+  vtkIdType end = begin + perThread + (id < extra ? 1 : 0);
+
+  vtkIdList *cellIds = vtkIdList::New();
+  cellIds->Allocate(VTK_MAX_CELLS_PER_POINT);
+  const vtkIdType *cells;
+  size_t numArrays = data->Arrays.size();
+  vtkCellDataToPointDataArray *arrays =
+    numArrays ? &data->Arrays[0] : 0;
+  vtkIdType progressInterval = (end - begin)/20 + 1;
+
+  for (vtkIdType ptId = begin; ptId < end; ptId++)
+    {
+    if ( !((ptId - begin) % progressInterval) )
+      {
+      // Only the thread that called SingleMethodExecute reports progress.
+      if (id == 0)
+        {
+        data->Filter->UpdateProgress(
+          static_cast<double>(ptId - begin)/(end - begin));
+        }
+      if (data->Filter->GetAbortExecute())
+        {
+        break;
+        }
+      }
+
+    vtkIdType numCells =
+      vtkCellDataToPointDataGetCells(data->Links, ptId, cellIds, cells);
+    double weight = 0.0;
+    if (data->NullPoints)
+      {
+      if ( numCells <= 0 || numCells >= VTK_MAX_CELLS_PER_POINT )
+        {
+        data->NullPoints[ptId] = 1;
+        continue;
+        }
+      weight = 1.0 / numCells;
+      }
+    for (size_t i = 0; i < numArrays; i++)
+      {
+      arrays[i].Function(arrays[i].Source, arrays[i].Target,
+                         arrays[i].NumberOfComponents, ptId, cells, numCells,
+                         weight);
+      }
+    }
+
+  cellIds->Delete();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+static void vtkCellDataToPointDataExecute(
+  vtkMultiThreader *threader, int numThreads,
+  vtkCellDataToPointDataThreadStruct &data)
+{
+  // It is not worth splitting small datasets among threads.
+  if (numThreads > data.NumberOfPoints / 1024)
+    {
+    numThreads = (data.NumberOfPoints / 1024 > 1) ?
+      static_cast<int>(data.NumberOfPoints / 1024) : 1;
+    }
+  threader->SetNumberOfThreads(numThreads);
+  threader->SetSingleMethod(vtkCellDataToPointDataThread, &data);
+  threader->SingleMethodExecute();
+}
+
+//----------------------------------------------------------------------------
+// Pairs the arrays that InterpolateAllocate() added to the point data with
+// the cell data arrays of the same name, and sizes them. Returns 0, leaving
+// the arrays alone, unless all of them are named data arrays (but bit
+// arrays) of the same type as their source.
+static int vtkCellDataToPointDataPairArrays(
+  vtkCellData *inCD, vtkPointData *outPD,
+  const vtkstd::vector<vtkAbstractArray *> &passedArrays,
+  vtkCellDataToPointDataThreadStruct &data)
+{
+  vtkstd::vector<vtkDataArray *> sources, targets;
+  int i;
+  for (i = 0; i < outPD->GetNumberOfArrays(); i++)
+    {
+    vtkAbstractArray *target = outPD->GetAbstractArray(i);
+    if (vtkstd::find(passedArrays.begin(), passedArrays.end(), target) !=
+        passedArrays.end())
+      {
+      continue;
+      }
+    if (!target->GetName())
+      {
+      return 0;
+      }
+    vtkDataArray *source =
+      vtkDataArray::SafeDownCast(inCD->GetAbstractArray(target->GetName()));
+    if (!source || !vtkDataArray::SafeDownCast(target) ||
+        source->GetDataType() != target->GetDataType() ||
+        source->GetDataType() == VTK_BIT ||
+        source->GetNumberOfComponents() != target->GetNumberOfComponents())
+      {
+      return 0;
+      }
+    sources.push_back(source);
+    targets.push_back(static_cast<vtkDataArray *>(target));
+    }
+
+  for (size_t j = 0; j < targets.size(); j++)
+    {
+    targets[j]->SetNumberOfTuples(data.NumberOfPoints);
+    vtkCellDataToPointDataAddArray(data, sources[j], targets[j], 1);
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkCellDataToPointData::RequestData(
   vtkInformation*,
@@ -95,32 +462,61 @@ int vtkCellDataToPointData::RequestData(
 
   // notice that inPD and outPD are vtkCellData and vtkPointData; respectively.
   // It's weird, but it works.
+  vtkstd::vector<vtkAbstractArray *> passedArrays;
+  for (int i = 0; i < outPD->GetNumberOfArrays(); i++)
+    {
+    passedArrays.push_back(outPD->GetAbstractArray(i));
+    }
   outPD->InterpolateAllocate(inPD,numPts);
 
-  int abort=0;
-  vtkIdType progressInterval=numPts/20 + 1;
-  for (ptId=0; ptId < numPts && !abort; ptId++)
+  // Average all the arrays in one sweep over the points when they can be
+  // accessed directly.
+  vtkCellDataToPointDataLinks links;
+  vtkCellDataToPointDataThreadStruct data;
+  data.Filter = this;
+  data.Links = &links;
+  data.NumberOfPoints = numPts;
+  if ( vtkCellDataToPointDataPairArrays(inPD, outPD, passedArrays, data) &&
+       vtkCellDataToPointDataBuildLinks(input, links) )
     {
-    if ( !(ptId % progressInterval) )
+    vtkstd::vector<unsigned char> nullPoints(numPts, 0);
+    data.NullPoints = &nullPoints[0];
+    vtkCellDataToPointDataExecute(this->Threader, this->NumberOfThreads, data);
+    for (ptId=0; ptId < numPts; ptId++)
       {
-      this->UpdateProgress(static_cast<double>(ptId)/numPts);
-      abort = GetAbortExecute();
-      }
-
-    input->GetPointCells(ptId, cellIds);
-    numCells = cellIds->GetNumberOfIds();
-    if ( numCells > 0 && numCells < VTK_MAX_CELLS_PER_POINT )
-      {
-      weight = 1.0 / numCells;
-      for (cellId=0; cellId < numCells; cellId++)
+      if ( nullPoints[ptId] )
         {
-        weights[cellId] = weight;
+        outPD->NullPoint(ptId);
         }
-      outPD->InterpolatePoint(inPD, ptId, cellIds, weights);
       }
-    else
+    }
+  else
+    {
+    int abort=0;
+    vtkIdType progressInterval=numPts/20 + 1;
+    for (ptId=0; ptId < numPts && !abort; ptId++)
       {
-      outPD->NullPoint(ptId);
+      if ( !(ptId % progressInterval) )
+        {
+        this->UpdateProgress(static_cast<double>(ptId)/numPts);
+        abort = GetAbortExecute();
+        }
+
+      input->GetPointCells(ptId, cellIds);
+      numCells = cellIds->GetNumberOfIds();
+      if ( numCells > 0 && numCells < VTK_MAX_CELLS_PER_POINT )
+        {
+        weight = 1.0 / numCells;
+        for (cellId=0; cellId < numCells; cellId++)
+          {
+          weights[cellId] = weight;
+          }
+        outPD->InterpolatePoint(inPD, ptId, cellIds, weights);
+        }
+      else
+        {
+        outPD->NullPoint(ptId);
+        }
       }
     }
 
@@ -143,52 +539,7 @@ void vtkCellDataToPointData::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "Pass Cell Data: " << (this->PassCellData ? "On\n" : "Off\n");
-}
-
-//----------------------------------------------------------------------------
-// Helper template function that implement the major part of the algorighm
-// which will be expanded by the vtkTemplateMacro. The template function is
-// provided so that coverage test can cover this function.
-namespace
-{
-  template <typename T>
-  void __spread (vtkUnstructuredGrid* const src, vtkUnsignedIntArray* const num,
-             vtkDataArray* const srcarray, vtkDataArray* const dstarray,
-             vtkIdType ncells, vtkIdType npoints, vtkIdType ncomps)
-  {
-    T const* const srcptr = static_cast<T const*>(srcarray->GetVoidPointer(0));
-    T      * const dstptr = static_cast<T      *>(dstarray->GetVoidPointer(0));
-
-    // zero initialization
-    vtkstd::fill_n(dstptr, npoints*ncomps, T(0));
-
-    // accumulate
-    T const* srcbeg = srcptr;
-    for (vtkIdType cid = 0; cid < ncells; ++cid, srcbeg += ncomps)
-      {
-      vtkIdList* const pids = src->GetCell(cid)->GetPointIds();
-      for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
-        {
-        T* const dstbeg = dstptr + pids->GetId(i)*ncomps;
-        // accumulate cell data to point data <==> point_data += cell_data
-        vtkstd::transform(srcbeg,srcbeg+ncomps,dstbeg,dstbeg,vtkstd::plus<T>());
-        }
-      }
-
-    // average
-    T* dstbeg = dstptr;
-    for (vtkIdType pid = 0; pid < npoints; ++pid, dstbeg += ncomps)
-      {
-      // guard against divide by zero
-      if (unsigned int const denum = num->GetValue(pid))
-        { 
-        // divide point data by the number of cells using it <==>
-        // point_data /= denum
-        vtkstd::transform(dstbeg, dstbeg+ncomps, dstbeg,
-          vtkstd::bind2nd(vtkstd::divides<T>(), denum));
-        }
-      }
-  }
+  os << indent << "Number Of Threads: " << this->NumberOfThreads << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -210,21 +561,9 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
     return 1;
     }
 
-  // count the number of cells associated with each point
-  vtkSmartPointer<vtkUnsignedIntArray> num
-    = vtkSmartPointer<vtkUnsignedIntArray>::New();
-  num->SetNumberOfComponents(1);
-  num->SetNumberOfTuples(npoints);
-  vtkstd::fill_n(num->GetPointer(0), npoints, 0u);
-  for (vtkIdType cid = 0; cid < ncells; ++cid)
-    {
-    vtkIdList* const pids = src->GetCell(cid)->GetPointIds();
-    for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
-      {
-      vtkIdType const pid = pids->GetId(i);
-      num->SetValue(pid, num->GetValue(pid)+1);
-      }
-    }
+  // list the cells associated with each point, once for all the fields
+  vtkCellDataToPointDataLinks links;
+  vtkCellDataToPointDataBuildLinks(src, links);
 
   // First, copy the input to the output as a starting point
   dst->CopyStructure(src);
@@ -255,15 +594,13 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
   cfl.InitializeFieldList(clean);
   opd->InterpolateAllocate(cfl, npoints, npoints);
 
+  vtkCellDataToPointDataThreadStruct data;
+  data.Filter = this;
+  data.Links = &links;
+  data.NumberOfPoints = npoints;
+  data.NullPoints = 0;
   for (int fid = 0, nfields = cfl.GetNumberOfFields(); fid < nfields; ++fid)
     {
-    // update progress and check for an abort request.
-    this->UpdateProgress((fid+1.)/nfields);
-    if (this->GetAbortExecute())
-      {
-      break;
-      }
-
     // indices into the field arrays associated with the cell and the point
     // respectively
     int const dstid = cfl.GetFieldIndex(fid);
@@ -284,15 +621,12 @@ int vtkCellDataToPointData::RequestDataForUnstructuredGrid
     vtkDataArray* const srcarray = srccelldata ->GetArray(srcid);
     vtkDataArray* const dstarray = dstpointdata->GetArray(dstid);
     dstarray->SetNumberOfTuples(npoints);
-
-    vtkIdType const ncomps = srcarray->GetNumberOfComponents();
-    switch (srcarray->GetDataType())
-      {
-      vtkTemplateMacro
-        (__spread<VTK_TT>(src,num,srcarray,dstarray,ncells,npoints,ncomps));
-      }
+    vtkCellDataToPointDataAddArray(data, srcarray, dstarray, 0);
     }
 
+  // average all the fields in one sweep over the points
+  vtkCellDataToPointDataExecute(this->Threader, this->NumberOfThreads, data);
+
   if (!this->PassCellData)
     {
     dst->GetCellData()->CopyAllOff();
@@ -19,6 +19,10 @@
 // points). The method of transformation is based on averaging the data
 // values of all cells using a particular point. Optionally, the input cell
 // data can be passed through to the output as well.
+//
+// The averages can be computed by several threads (see NumberOfThreads).
+// The cells of each point are found once for all the arrays, and each
+// thread averages all the arrays over its own range of points.
 
 // .SECTION Caveats
 // This filter is an abstract filter, that is, the output is an abstract type
@@ -36,6 +40,7 @@
 #include "vtkDataSetAlgorithm.h"
 
 class vtkDataSet;
+class vtkMultiThreader;
 
 class VTK_GRAPHICS_EXPORT vtkCellDataToPointData : public vtkDataSetAlgorithm
 {
@@ -52,9 +57,19 @@ public:
   vtkGetMacro(PassCellData,int);
   vtkBooleanMacro(PassCellData,int);
 
+  // Description:
+  // Set/Get the number of threads used to average the cell data, with 1
+  // (serial execution) as the default value. Each thread handles a range
+  // of points, so the output is the same whatever the number of threads.
+  // Datasets other than image data, rectilinear and structured grids, poly
+  // data and unstructured grids, and point data that cannot be matched to
+  // cell data arrays by name, are always processed serially.
+  vtkSetClampMacro(NumberOfThreads,int,1,VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads,int);
+
 protected:
   vtkCellDataToPointData();
-  ~vtkCellDataToPointData() {};
+  ~vtkCellDataToPointData();
 
   virtual int RequestData(vtkInformation* request,
                           vtkInformationVector** inputVector,
@@ -65,6 +80,9 @@ protected:
     (vtkInformation*, vtkInformationVector**, vtkInformationVector*);
 
   int PassCellData;
+  int NumberOfThreads;
+  vtkMultiThreader *Threader;
+
 private:
   vtkCellDataToPointData(const vtkCellDataToPointData&);  // Not implemented.
   void operator=(const vtkCellDataToPointData&);  // Not implemented.
@@ -271,6 +271,33 @@ void vtkCellLocatorInterpolatedVelocityField::AddDataSet( vtkDataSet * dataset )
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkCellLocatorInterpolatedVelocityField::ShareCellLocators
+  ( vtkCellLocatorInterpolatedVelocityField * from )
+{
+  if ( !from || from->DataSets->size() != this->DataSets->size() )
+    {
+    vtkErrorMacro( <<"The cell locators can only be shared by interpolators "
+                   <<"of the same datasets." );
+    return;
+    }
+
+  for ( size_t i = 0; i < this->CellLocators->size(); i ++ )
+    {
+    vtkAbstractCellLocator * loc = ( *from->CellLocators )[i].GetPointer();
+    if ( loc )
+      {
+      // a lazily evaluated locator would be built by the first search
+      loc->LazyEvaluationOff();
+      loc->BuildLocator();
+      }
+    ( *this->CellLocators )[i] = loc;
+    }
+
+  this->LastCellLocator = this->LastDataSet ?
+    ( *this->CellLocators )[this->LastDataSetIndex].GetPointer() : 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkCellLocatorInterpolatedVelocityField::CopyParameters
   ( vtkAbstractInterpolatedVelocityField * from )
@@ -36,7 +36,8 @@
 
 // .SECTION Caveats
 //  vtkCellLocatorInterpolatedVelocityField is not thread safe. A new instance
-//  should be created by each thread.
+//  should be created by each thread. The instances can share their cell
+//  locators through ShareCellLocators().
 
 // .SECTION See Also
 //  vtkAbstractInterpolatedVelocityField vtkInterpolatedVelocityField
@@ -81,6 +82,13 @@ public:
   // Import parameters. Sub-classes can add more after chaining.
   virtual void CopyParameters( vtkAbstractInterpolatedVelocityField * from );
 
+  // Description:
+  // Use the cell locators of another instance, to which the same datasets
+  // have been added in the same order, instead of building new ones. The
+  // locators are built here, so that several instances can then search
+  // them at the same time from different threads.
+  void ShareCellLocators( vtkCellLocatorInterpolatedVelocityField * from );
+
   // Description:
   // Add a dataset coupled with a cell locator (of type vtkAbstractCellLocator)
   // for vector function evaluation. Note the use of a vtkAbstractCellLocator
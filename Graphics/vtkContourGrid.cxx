@@ -19,6 +19,7 @@
 #include "vtkCellData.h"
 #include "vtkContourValues.h"
 #include "vtkFloatArray.h"
+#include "vtkGenericCell.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -30,6 +31,9 @@
 #include "vtkMergePoints.h"
 #include "vtkPointLocator.h"
 #include "vtkIncrementalPointLocator.h"
+#include "vtkMultiThreader.h"
+
+#include <vtkstd/vector>
 
 #include <math.h>
 
@@ -50,6 +54,9 @@ vtkContourGrid::vtkContourGrid()
   this->UseScalarTree = 0;
   this->ScalarTree = NULL;
 
+  this->NumberOfThreads = 1;
+  this->Threader = vtkMultiThreader::New();
+
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
                                vtkDataSetAttributes::SCALARS);
@@ -67,6 +74,7 @@ vtkContourGrid::~vtkContourGrid()
     {
     this->ScalarTree->Delete();
     }
+  this->Threader->Delete();
 }
 
 // Overload standard modified time function. If contour values are modified,
@@ -112,9 +120,10 @@ void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
   vtkDataArray *cellScalars;
   vtkUnstructuredGrid *grid = static_cast<vtkUnstructuredGrid *>(input);
   //In this case, we know that the input is an unstructured grid.
-  vtkIdType numPoints, cellArrayIt = 0;
+  vtkIdType numPoints;
   int needCell = 0;
   vtkIdType *cellArrayPtr;
+  vtkCellArray *cells = grid->GetCells();
   T tempScalar;
 
   numCells = input->GetNumberOfCells();
@@ -182,35 +191,31 @@ void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
       // Loop over all cells; get scalar values for all cell points
       // and process each cell.
       //
-      cellArrayIt = 0;
-      cellArrayPtr = grid->GetCells()->GetPointer();
+      // The cells are traversed rather than read from their interleaved
+      // list, which would convert the offsets storage.
+      cells->InitTraversal();
       for (cellId=0; cellId < numCells && !abortExecute; cellId++)
         {
-        numPoints = cellArrayPtr[cellArrayIt];
+        cells->GetNextCell(numPoints, cellArrayPtr);
         // I assume that "GetCellType" is fast.
         cellType = input->GetCellType(cellId);
         if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
           { // Protect against new cell types added.
           vtkGenericWarningMacro("Unknown cell type " << cellType);
-          cellArrayIt += 1+numPoints;
           continue;
           }
         if (cellTypeDimensions[cellType] != dimensionality)
           {
-          cellArrayIt += 1+numPoints;
           continue;
           }
-        cellArrayIt++;
         
         //find min and max values in scalar data
-        range[0] = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-        range[1] = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-        cellArrayIt++;
+        range[0] = scalarArrayPtr[cellArrayPtr[0]];
+        range[1] = scalarArrayPtr[cellArrayPtr[0]];
         
         for (i = 1; i < numPoints; i++)
           {
-          tempScalar = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-          cellArrayIt++;
+          tempScalar = scalarArrayPtr[cellArrayPtr[i]];
           if (tempScalar <= range[0])
             {
             range[0] = tempScalar;
@@ -318,6 +323,418 @@ void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
   output->Squeeze();
 }
 
+//----------------------------------------------------------------------------
+// Threaded contouring.  The cells are split into contiguous chunks, each of
+// which is contoured by one thread into its own points, cells and attribute
+// data, merging the points created on shared edges with its own
+// vtkMergePoints.  The chunks are then stitched together in order through
+// the filter's locator, which gives the same output as the serial code.
+// As there, the 1D, 2D and 3D cells are processed in separate passes so
+// that verts, lines and polys (and their cell data) come out in order.
+
+// The output of one chunk of cells, along with its scratch objects.
+struct vtkContourGridChunk
+{
+  vtkPoints *Points;
+  vtkMergePoints *Locator;
+  vtkCellArray *Verts;
+  vtkCellArray *Lines;
+  vtkCellArray *Polys;
+  vtkPointData *PointData;
+  vtkCellData *CellData;
+  vtkGenericCell *Cell;
+  vtkDataArray *CellScalars;
+  vtkIdList *CellPointIds;
+  vtkstd::vector<int> UnknownCellTypes;
+};
+
+// Arguments shared by the threads.
+struct vtkContourGridThreadStruct
+{
+  vtkContourGrid *Filter;
+  vtkUnstructuredGrid *Input;
+  vtkDataArray *InScalars;
+  int NumberOfContours;
+  double *Values;
+  int Dimensionality;
+  unsigned char *CellTypeDimensions;
+  vtkIdType NumberOfCells;
+  int NumberOfChunks;
+  vtkContourGridChunk *Chunks;
+};
+
+template <class T>
+void vtkContourGridContourCells(vtkContourGridThreadStruct *data,
+                                vtkContourGridChunk *chunk,
+                                vtkIdType firstCell, vtkIdType lastCell,
+                                T *scalarArrayPtr, int reportProgress)
+{
+  vtkUnstructuredGrid *input = data->Input;
+  vtkCellArray *cells = input->GetCells();
+  int storageOffsets = cells->IsStorageOffsets();
+  vtkPointData *inPd = input->GetPointData();
+  vtkCellData *inCd = input->GetCellData();
+  int numContours = data->NumberOfContours;
+  double *values = data->Values;
+  vtkIdType cellId, i, numPoints, *pts;
+  int cellType, needCell;
+  double range[2];
+  T tempScalar;
+
+  for (cellId = firstCell; cellId < lastCell; cellId++)
+    {
+    // Unknown cell types are skipped and reported by the calling thread,
+    // as the serial code does.
+    cellType = input->GetCellType(cellId);
+    if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
+      {
+      chunk->UnknownCellTypes.push_back(cellType);
+      continue;
+      }
+    if (data->CellTypeDimensions[cellType] != data->Dimensionality)
+      {
+      continue;
+      }
+
+    //find min and max values in scalar data
+    if (storageOffsets)
+      {
+      // GetCellPoints() copies the ids of the offsets storage to the
+      // buffer of the cell array, so copy them to the chunk's own list.
+      cells->GetCellAtId(cellId, chunk->CellPointIds);
+      numPoints = chunk->CellPointIds->GetNumberOfIds();
+      pts = chunk->CellPointIds->GetPointer(0);
+      }
+    else
+      {
+      input->GetCellPoints(cellId, numPoints, pts);
+      }
+    range[0] = scalarArrayPtr[pts[0]];
+    range[1] = scalarArrayPtr[pts[0]];
+    for (i = 1; i < numPoints; i++)
+      {
+      tempScalar = scalarArrayPtr[pts[i]];
+      if (tempScalar <= range[0])
+        {
+        range[0] = tempScalar;
+        }
+      if (tempScalar >= range[1])
+        {
+        range[1] = tempScalar;
+        }
+      }
+
+    if (!((cellId - firstCell) % 5000))
+      {
+      // Only the thread that called SingleMethodExecute reports progress.
+      if (reportProgress && data->Dimensionality == 3)
+        {
+        data->Filter->UpdateProgress(
+          static_cast<double>(cellId - firstCell) / (lastCell - firstCell));
+        }
+      if (data->Filter->GetAbortExecute())
+        {
+        break;
+        }
+      }
+
+    needCell = 0;
+    for (i = 0; i < numContours; i++)
+      {
+      if ((values[i] >= range[0]) && (values[i] <= range[1]))
+        {
+        needCell = 1;
+        break;
+        }
+      }
+
+    if (needCell)
+      {
+      // vtkUnstructuredGrid::GetCell(vtkIdType) and
+      // vtkDataArray::GetTuples() use shared scratch space, so fill the
+      // chunk's own cell and scalars instead.
+      input->GetCell(cellId, chunk->Cell);
+      vtkIdList *cellPts = chunk->Cell->GetPointIds();
+      numPoints = cellPts->GetNumberOfIds();
+      chunk->CellScalars->SetNumberOfTuples(numPoints);
+      for (i = 0; i < numPoints; i++)
+        {
+        chunk->CellScalars->SetTuple(i, cellPts->GetId(i), data->InScalars);
+        }
+
+      for (i = 0; i < numContours; i++)
+        {
+        if ((values[i] >= range[0]) && (values[i] <= range[1]))
+          {
+          chunk->Cell->Contour(values[i], chunk->CellScalars, chunk->Locator,
+                               chunk->Verts, chunk->Lines, chunk->Polys,
+                               inPd, chunk->PointData, inCd, cellId,
+                               chunk->CellData);
+          }
+        }
+      }
+    }
+}
+
+static VTK_THREAD_RETURN_TYPE vtkContourGridThreadedContour(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkContourGridThreadStruct *data =
+    static_cast<vtkContourGridThreadStruct *>(info->UserData);
+  void *scalarArrayPtr = data->InScalars->GetVoidPointer(0);
+
+  // The threader may run fewer threads than requested (e.g., due to the
+  // global maximum number of threads), so each thread takes every n-th chunk.
+  vtkIdType chunkSize = data->NumberOfCells / data->NumberOfChunks;
+  for (int chunkIdx = info->ThreadID; chunkIdx < data->NumberOfChunks;
+       chunkIdx += info->NumberOfThreads)
+    {
+    vtkIdType firstCell = chunkSize * chunkIdx;
+    vtkIdType lastCell = (chunkIdx == data->NumberOfChunks - 1) ?
+      data->NumberOfCells : firstCell + chunkSize;
+    switch (data->InScalars->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkContourGridContourCells(data, &data->Chunks[chunkIdx],
+                                   firstCell, lastCell,
+                                   static_cast<VTK_TT *>(scalarArrayPtr),
+                                   info->ThreadID == 0));
+      }
+    }
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Appends the cells of one chunk to the output, renumbering their points
+// with ptMap.  The cell data of the n-th cell of the chunk's array is at
+// chunkOffset + n in the chunk and goes to outOffset + its new cell id.
+static void vtkContourGridAppendCells(vtkCellArray *chunkCells,
+                                      vtkCellData *chunkCd,
+                                      vtkIdType chunkOffset,
+                                      vtkCellArray *outCells,
+                                      vtkCellData *outCd, vtkIdType outOffset,
+                                      vtkstd::vector<vtkIdType> &ptMap,
+                                      vtkstd::vector<vtkIdType> &cellPts)
+{
+  vtkIdType npts, *pts, i, cellId = 0, newCellId;
+  for (chunkCells->InitTraversal(); chunkCells->GetNextCell(npts, pts);
+       cellId++)
+    {
+    cellPts.resize(npts);
+    for (i = 0; i < npts; i++)
+      {
+      cellPts[i] = ptMap[pts[i]];
+      }
+    newCellId = outCells->InsertNextCell(npts, &cellPts[0]);
+    outCd->CopyData(chunkCd, chunkOffset + cellId, outOffset + newCellId);
+    }
+}
+
+static void vtkContourGridThreadedExecute(vtkContourGrid *self,
+                                          vtkMultiThreader *threader,
+                                          int numThreads,
+                                          vtkUnstructuredGrid *input,
+                                          vtkPolyData *output,
+                                          vtkDataArray *inScalars,
+                                          int numContours, double *values,
+                                          int computeScalars)
+{
+  vtkIncrementalPointLocator *locator = self->GetLocator();
+  vtkPointData *inPd=input->GetPointData(), *outPd=output->GetPointData();
+  vtkCellData *inCd=input->GetCellData(), *outCd=output->GetCellData();
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType estimatedSize, chunkSize, i, ptId;
+  int c;
+
+  // Allocate the output as the serial code does, and each chunk with its
+  // share of it.
+  estimatedSize=static_cast<vtkIdType>(pow(static_cast<double>(numCells),.75));
+  estimatedSize *= numContours;
+  estimatedSize = estimatedSize / 1024 * 1024; //multiple of 1024
+  if (estimatedSize < 1024)
+    {
+    estimatedSize = 1024;
+    }
+  chunkSize = estimatedSize / numThreads;
+  if (chunkSize < 1024)
+    {
+    chunkSize = 1024;
+    }
+
+  vtkPoints *newPts = vtkPoints::New();
+  newPts->Allocate(estimatedSize,estimatedSize);
+  vtkCellArray *newVerts = vtkCellArray::New();
+  newVerts->Allocate(estimatedSize,estimatedSize);
+  vtkCellArray *newLines = vtkCellArray::New();
+  newLines->Allocate(estimatedSize,estimatedSize);
+  vtkCellArray *newPolys = vtkCellArray::New();
+  newPolys->Allocate(estimatedSize,estimatedSize);
+  locator->InitPointInsertion (newPts, input->GetBounds(),estimatedSize);
+
+  vtkContourGridChunk *chunks = new vtkContourGridChunk[numThreads];
+  for (c = 0; c < numThreads; c++)
+    {
+    vtkContourGridChunk &chunk = chunks[c];
+    chunk.Points = vtkPoints::New();
+    chunk.Points->Allocate(chunkSize,chunkSize);
+    chunk.Locator = vtkMergePoints::New();
+    chunk.Verts = vtkCellArray::New();
+    chunk.Verts->Allocate(chunkSize,chunkSize);
+    chunk.Lines = vtkCellArray::New();
+    chunk.Lines->Allocate(chunkSize,chunkSize);
+    chunk.Polys = vtkCellArray::New();
+    chunk.Polys->Allocate(chunkSize,chunkSize);
+    chunk.PointData = vtkPointData::New();
+    if (!computeScalars)
+      {
+      chunk.PointData->CopyScalarsOff();
+      }
+    chunk.PointData->InterpolateAllocate(inPd,chunkSize,chunkSize);
+    chunk.CellData = vtkCellData::New();
+    chunk.CellData->CopyAllocate(inCd,chunkSize,chunkSize);
+    chunk.Cell = vtkGenericCell::New();
+    chunk.CellScalars = inScalars->NewInstance();
+    chunk.CellScalars->SetNumberOfComponents(
+      inScalars->GetNumberOfComponents());
+    chunk.CellScalars->Allocate(
+      VTK_CELL_SIZE*inScalars->GetNumberOfComponents());
+    chunk.CellPointIds = vtkIdList::New();
+    chunk.CellPointIds->Allocate(VTK_CELL_SIZE);
+    }
+
+  // The chunks hold the arrays the serial code would create in the output.
+  if (!computeScalars)
+    {
+    outPd->CopyScalarsOff();
+    }
+  outPd->CopyAllocate(chunks[0].PointData,estimatedSize,estimatedSize);
+  outCd->CopyAllocate(chunks[0].CellData,estimatedSize,estimatedSize);
+
+  unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+  vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
+
+  vtkContourGridThreadStruct data;
+  data.Filter = self;
+  data.Input = input;
+  data.InScalars = inScalars;
+  data.NumberOfContours = numContours;
+  data.Values = values;
+  data.CellTypeDimensions = cellTypeDimensions;
+  data.NumberOfCells = numCells;
+  data.NumberOfChunks = numThreads;
+  data.Chunks = chunks;
+
+  threader->SetNumberOfThreads(numThreads);
+  threader->SetSingleMethod(vtkContourGridThreadedContour, &data);
+
+  vtkstd::vector<vtkIdType> ptMap;
+  vtkstd::vector<vtkIdType> cellPts;
+  double x[3];
+
+  // We skip 0d cells (points), because they cannot be cut (generate no data).
+  for (data.Dimensionality = 1; data.Dimensionality <= 3 &&
+         !self->GetAbortExecute(); ++data.Dimensionality)
+    {
+    for (c = 0; c < numThreads; c++)
+      {
+      vtkContourGridChunk &chunk = chunks[c];
+      chunk.Points->Reset();
+      chunk.Locator->InitPointInsertion(chunk.Points, input->GetBounds(),
+                                        chunkSize);
+      chunk.Verts->Reset();
+      chunk.Lines->Reset();
+      chunk.Polys->Reset();
+      chunk.PointData->Reset();
+      chunk.CellData->Reset();
+      chunk.UnknownCellTypes.clear();
+      }
+
+    threader->SingleMethodExecute();
+
+    // Stitch the chunks together.  Going through them in order, a point is
+    // inserted first by the same cell as in the serial code, so it gets the
+    // same id and interpolated data.
+    for (c = 0; c < numThreads; c++)
+      {
+      vtkContourGridChunk &chunk = chunks[c];
+      for (size_t j = 0; j < chunk.UnknownCellTypes.size(); j++)
+        { // Protect against new cell types added.
+        vtkGenericWarningMacro("Unknown cell type "
+                               << chunk.UnknownCellTypes[j]);
+        }
+      vtkIdType numPts = chunk.Points->GetNumberOfPoints();
+      ptMap.resize(numPts);
+      for (i = 0; i < numPts; i++)
+        {
+        chunk.Points->GetPoint(i, x);
+        if (locator->InsertUniquePoint(x, ptId))
+          {
+          outPd->CopyData(chunk.PointData, i, ptId);
+          }
+        ptMap[i] = ptId;
+        }
+
+      // Cells put their cell data after the cells of lower dimension, as
+      // in vtkTetra::Contour, in the chunk as well as in the output.
+      vtkIdType numChunkVerts = chunk.Verts->GetNumberOfCells();
+      vtkIdType numChunkLines = chunk.Lines->GetNumberOfCells();
+      vtkContourGridAppendCells(chunk.Verts, chunk.CellData, 0,
+                                newVerts, outCd, 0, ptMap, cellPts);
+      vtkContourGridAppendCells(chunk.Lines, chunk.CellData, numChunkVerts,
+                                newLines, outCd,
+                                newVerts->GetNumberOfCells(),
+                                ptMap, cellPts);
+      vtkContourGridAppendCells(chunk.Polys, chunk.CellData,
+                                numChunkVerts + numChunkLines,
+                                newPolys, outCd,
+                                newVerts->GetNumberOfCells() +
+                                newLines->GetNumberOfCells(),
+                                ptMap, cellPts);
+      }
+    }
+
+  for (c = 0; c < numThreads; c++)
+    {
+    vtkContourGridChunk &chunk = chunks[c];
+    chunk.Points->Delete();
+    chunk.Locator->Delete();
+    chunk.Verts->Delete();
+    chunk.Lines->Delete();
+    chunk.Polys->Delete();
+    chunk.PointData->Delete();
+    chunk.CellData->Delete();
+    chunk.Cell->Delete();
+    chunk.CellScalars->Delete();
+    chunk.CellPointIds->Delete();
+    }
+  delete [] chunks;
+
+  output->SetPoints(newPts);
+  newPts->Delete();
+
+  if (newVerts->GetNumberOfCells())
+    {
+    output->SetVerts(newVerts);
+    }
+  newVerts->Delete();
+
+  if (newLines->GetNumberOfCells())
+    {
+    output->SetLines(newLines);
+    }
+  newLines->Delete();
+
+  if (newPolys->GetNumberOfCells())
+    {
+    output->SetPolys(newPolys);
+    }
+  newPolys->Delete();
+
+  locator->Initialize();//releases leftover memory
+  output->Squeeze();
+}
+
 //
 // Contouring filter for unstructured grids.
 //
@@ -360,6 +777,20 @@ int vtkContourGrid::RequestData(
     return 1;
     }
 
+  // It is not worth splitting small grids among threads.
+  int numThreads = this->NumberOfThreads;
+  if ( numThreads > numCells / 1024 )
+    {
+    numThreads = ( numCells / 1024 > 1 ) ? static_cast<int>(numCells / 1024) : 1;
+    }
+  if ( numThreads > 1 && !useScalarTree )
+    {
+    vtkContourGridThreadedExecute(this, this->Threader, numThreads, input,
+                                  output, inScalars, numContours, values,
+                                  computeScalars);
+    return 1;
+    }
+
   scalarArrayPtr = inScalars->GetVoidPointer(0);
         
   switch (inScalars->GetDataType())
@@ -426,6 +857,7 @@ void vtkContourGrid::PrintSelf(ostream& os, vtkIndent indent)
      << (this->ComputeScalars ? "On\n" : "Off\n");
   os << indent << "Use Scalar Tree: " 
      << (this->UseScalarTree ? "On\n" : "Off\n");
+  os << indent << "Number Of Threads: " << this->NumberOfThreads << "\n";
 
   this->ContourValues->PrintSelf(os,indent.GetNextIndent());
 
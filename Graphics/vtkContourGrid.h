@@ -53,6 +53,7 @@
 class vtkEdgeTable;
 class vtkScalarTree;
 class vtkIncrementalPointLocator;
+class vtkMultiThreader;
 
 class VTK_GRAPHICS_EXPORT vtkContourGrid : public vtkPolyDataAlgorithm
 {
@@ -123,6 +124,17 @@ public:
   // specified. The locator is used to merge coincident points.
   void CreateDefaultLocator();
 
+  // Description:
+  // Set/Get the number of threads used to contour the cells, with 1 (serial
+  // execution) as the default value. With more than one thread, the cells
+  // are split into contiguous chunks that are contoured into separate
+  // points and cells, merging the points on shared edges with a
+  // vtkMergePoints per chunk. The chunks are then stitched together in
+  // order through the locator, so the output is the same as that of the
+  // serial mode. The scalar tree is only used in serial mode.
+  vtkSetClampMacro(NumberOfThreads,int,1,VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads,int);
+
 protected:
   vtkContourGrid();
   ~vtkContourGrid();
@@ -138,6 +150,8 @@ protected:
   int UseScalarTree;
   vtkScalarTree *ScalarTree;
   vtkEdgeTable *EdgeTable;
+  int NumberOfThreads;
+  vtkMultiThreader *Threader;
   
 private:
   vtkContourGrid(const vtkContourGrid&);  // Not implemented.
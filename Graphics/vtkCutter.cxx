@@ -21,6 +21,7 @@
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkGenericCell.h"
+#include "vtkContourGrid.h"
 #include "vtkGridSynchronizedTemplates3D.h"
 #include "vtkImageData.h"
 #include "vtkImplicitFunction.h"
@@ -57,11 +58,13 @@ vtkCutter::vtkCutter(vtkImplicitFunction *cf)
   this->CutFunction = cf;
   this->GenerateCutScalars = 0;
   this->Locator = NULL;
+  this->NumberOfThreads = 1;
 
   this->SynchronizedTemplates3D = vtkSynchronizedTemplates3D::New();
   this->SynchronizedTemplatesCutter3D = vtkSynchronizedTemplatesCutter3D::New();
   this->GridSynchronizedTemplates = vtkGridSynchronizedTemplates3D::New();
   this->RectilinearSynchronizedTemplates = vtkRectilinearSynchronizedTemplates::New();
+  this->ContourGrid = vtkContourGrid::New();
 
   this->GetInformation()->Set(vtkAlgorithm::PRESERVES_RANGES(), 1);
   this->GetInformation()->Set(vtkAlgorithm::PRESERVES_BOUNDS(), 1);
@@ -78,6 +81,7 @@ vtkCutter::~vtkCutter()
   this->SynchronizedTemplatesCutter3D->Delete();
   this->GridSynchronizedTemplates->Delete();
   this->RectilinearSynchronizedTemplates->Delete();
+  this->ContourGrid->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -304,6 +308,76 @@ void vtkCutter::RectilinearGridCutter(vtkDataSet *dataSetInput,
   contourData->Delete();
 }
 
+//----------------------------------------------------------------------------
+// Sorting by value, cutting an unstructured grid is the same as contouring
+// the values of the cut function, which vtkContourGrid does with threads.
+void vtkCutter::ThreadedUnstructuredGridCutter(vtkDataSet *dataSetInput,
+                                               vtkPolyData *thisOutput)
+{
+  vtkUnstructuredGrid *input = vtkUnstructuredGrid::SafeDownCast(dataSetInput);
+  vtkPolyData *output;
+  vtkIdType numPts = input->GetNumberOfPoints();
+
+  if (numPts < 1)
+    {
+    return;
+    }
+
+  vtkDoubleArray *cutScalars = vtkDoubleArray::New();
+  cutScalars->SetNumberOfTuples(numPts);
+  cutScalars->SetName("cutScalars");
+
+  vtkUnstructuredGrid *contourData = vtkUnstructuredGrid::New();
+  contourData->ShallowCopy(input);
+  if (this->GenerateCutScalars)
+    {
+    contourData->GetPointData()->SetScalars(cutScalars);
+    }
+  else
+    {
+    contourData->GetPointData()->AddArray(cutScalars);
+    }
+
+  vtkIdType i;
+  double scalar;
+  for (i = 0; i < numPts; i++)
+    {
+    scalar = this->CutFunction->FunctionValue(input->GetPoint(i));
+    cutScalars->SetComponent(i, 0, scalar);
+    }
+  int numContours = this->GetNumberOfContours();
+
+  if ( this->Locator == NULL )
+    {
+    this->CreateDefaultLocator();
+    }
+  this->ContourGrid->SetDebug(this->GetDebug());
+  this->ContourGrid->SetInput(contourData);
+  this->ContourGrid->
+    SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,"cutScalars");
+  this->ContourGrid->SetNumberOfContours(numContours);
+  for (i = 0; i < numContours; i++)
+    {
+    this->ContourGrid->SetValue(i, this->GetValue(i));
+    }
+  this->ContourGrid->SetLocator(this->Locator);
+  this->ContourGrid->SetNumberOfThreads(this->NumberOfThreads);
+  this->ContourGrid->ComputeScalarsOn();
+  output = this->ContourGrid->GetOutput();
+  this->ContourGrid->Update();
+  output->Register(this);
+
+  thisOutput->ShallowCopy(output);
+  output->UnRegister(this);
+  if (!this->GenerateCutScalars)
+    {
+    thisOutput->GetPointData()->RemoveArray("cutScalars");
+    }
+
+  cutScalars->Delete();
+  contourData->Delete();
+}
+
 //----------------------------------------------------------------------------
 // Cut through data generating surface.
 //
@@ -369,8 +443,16 @@ int vtkCutter::RequestData(
 
   if (input->GetDataObjectType() == VTK_UNSTRUCTURED_GRID)
     {
-    vtkDebugMacro(<< "Executing Unstructured Grid Cutter");
-    this->UnstructuredGridCutter(input, output);
+    if (this->NumberOfThreads > 1 && this->SortBy == VTK_SORT_BY_VALUE)
+      {
+      vtkDebugMacro(<< "Executing Threaded Unstructured Grid Cutter");
+      this->ThreadedUnstructuredGridCutter(input, output);
+      }
+    else
+      {
+      vtkDebugMacro(<< "Executing Unstructured Grid Cutter");
+      this->UnstructuredGridCutter(input, output);
+      }
     }
   else
     {
@@ -656,8 +738,7 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
   double value, s;
   vtkIdType estimatedSize, numCells=input->GetNumberOfCells();
   vtkIdType numPts=input->GetNumberOfPoints();
-  vtkIdType cellArrayIt = 0;
-  int numCellPts;
+  vtkIdType numCellPts;
   vtkPointData *inPD, *outPD;
   vtkCellData *inCD=input->GetCellData(), *outCD=output->GetCellData();
   vtkIdList *cellIds;
@@ -724,7 +805,10 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
   int cut=0;
 
   vtkUnstructuredGrid *grid = static_cast<vtkUnstructuredGrid *>(input);
-  vtkIdType *cellArrayPtr = grid->GetCells()->GetPointer();
+  // The cells are traversed rather than read from their interleaved list,
+  // which would convert the offsets storage.
+  vtkCellArray *cells = grid->GetCells();
+  vtkIdType *cellArrayPtr;
   double *scalarArrayPtr = cutScalars->GetPointer(0);
   double tempScalar;
   cellScalars = cutScalars->NewInstance();
@@ -741,6 +825,7 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
       // Loop over all cells; get scalar values for all cell points
       // and process each cell.
       //
+      cells->InitTraversal();
       for (cellId=0; cellId < numCells && !abortExecute; cellId++)
         {
         if ( !(++cut % progressInterval) )
@@ -750,18 +835,15 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
           abortExecute = this->GetAbortExecute();
           }
 
-        numCellPts = cellArrayPtr[cellArrayIt];
-        cellArrayIt++;
+        cells->GetNextCell(numCellPts, cellArrayPtr);
         
         //find min and max values in scalar data
-        range[0] = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-        range[1] = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-        cellArrayIt++;
+        range[0] = scalarArrayPtr[cellArrayPtr[0]];
+        range[1] = scalarArrayPtr[cellArrayPtr[0]];
         
         for (i = 1; i < numCellPts; i++)
           {
-          tempScalar = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-          cellArrayIt++;
+          tempScalar = scalarArrayPtr[cellArrayPtr[i]];
           if (tempScalar <= range[0])
             {
             range[0] = tempScalar;
@@ -830,34 +912,29 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
       // Loop over all cells; get scalar values for all cell points
       // and process each cell.
       //
-      cellArrayIt = 0;
+      cells->InitTraversal();
       for (cellId=0; cellId < numCells && !abortExecute; cellId++)
         {
-        numCellPts = cellArrayPtr[cellArrayIt];
+        cells->GetNextCell(numCellPts, cellArrayPtr);
         // I assume that "GetCellType" is fast.
         cellType = input->GetCellType(cellId);
         if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
           { // Protect against new cell types added.
           vtkErrorMacro("Unknown cell type " << cellType);
-          cellArrayIt += 1+numCellPts;
           continue;
           }
         if (cellTypeDimensions[cellType] != dimensionality)
           {
-          cellArrayIt += 1+numCellPts;
           continue;
           }
-        cellArrayIt++;
             
         //find min and max values in scalar data
-        range[0] = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-        range[1] = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-        cellArrayIt++;
+        range[0] = scalarArrayPtr[cellArrayPtr[0]];
+        range[1] = scalarArrayPtr[cellArrayPtr[0]];
             
         for (i = 1; i < numCellPts; i++)
           {
-          tempScalar = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-          cellArrayIt++;
+          tempScalar = scalarArrayPtr[cellArrayPtr[i]];
           if (tempScalar <= range[0])
             {
             range[0] = tempScalar;
@@ -993,6 +1070,7 @@ void vtkCutter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Generate Cut Scalars: "
      << (this->GenerateCutScalars ? "On\n" : "Off\n");
+  os << indent << "Number Of Threads: " << this->NumberOfThreads << "\n";
 }
 
 //-----------------------------------------------------------------------
@@ -55,6 +55,7 @@ class vtkSynchronizedTemplates3D;
 class vtkSynchronizedTemplatesCutter3D;
 class vtkGridSynchronizedTemplates3D;
 class vtkRectilinearSynchronizedTemplates;
+class vtkContourGrid;
 
 class VTK_GRAPHICS_EXPORT vtkCutter : public vtkPolyDataAlgorithm
 {
@@ -161,6 +162,15 @@ public:
     {this->SetSortBy(VTK_SORT_BY_CELL);}
   const char *GetSortByAsString();
 
+  // Description:
+  // Set/Get the number of threads used to cut a vtkUnstructuredGrid when
+  // sorting by value, with 1 (serial execution) as the default value. With
+  // more than one thread the values of the cut function are contoured with
+  // a threaded vtkContourGrid, which gives the same output as the serial
+  // cutter.
+  vtkSetClampMacro(NumberOfThreads,int,1,VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads,int);
+
   // Description:
   // Create default locator. Used to create one when none is specified. The 
   // locator is used to merge coincident points.
@@ -192,17 +202,20 @@ protected:
                               vtkInformationVector *);
   void StructuredGridCutter(vtkDataSet *, vtkPolyData *);
   void RectilinearGridCutter(vtkDataSet *, vtkPolyData *);
+  void ThreadedUnstructuredGridCutter(vtkDataSet *, vtkPolyData *);
   vtkImplicitFunction *CutFunction;
 
   vtkSynchronizedTemplates3D *SynchronizedTemplates3D;
   vtkSynchronizedTemplatesCutter3D *SynchronizedTemplatesCutter3D;
   vtkGridSynchronizedTemplates3D *GridSynchronizedTemplates;
   vtkRectilinearSynchronizedTemplates *RectilinearSynchronizedTemplates;
+  vtkContourGrid *ContourGrid;
 
   vtkIncrementalPointLocator *Locator;
   int SortBy;
   vtkContourValues *ContourValues;
   int GenerateCutScalars;
+  int NumberOfThreads;
 private:
   vtkCutter(const vtkCutter&);  // Not implemented.
   void operator=(const vtkCutter&);  // Not implemented.
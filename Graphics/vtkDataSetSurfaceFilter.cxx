@@ -23,6 +23,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -40,6 +41,7 @@
 #include "vtkWedge.h"
 
 #include <vtkstd/algorithm>
+#include <vtkstd/vector>
 #include <vtksys/hash_map.hxx>
 
 static int sizeofFastQuad(int numPts)
@@ -112,6 +114,11 @@ vtkDataSetSurfaceFilter::vtkDataSetSurfaceFilter()
 
   this->NonlinearSubdivisionLevel = 1;
 
+  this->UseFaceTable = 1;
+  this->NumberOfThreads = 1;
+  this->Threader = vtkMultiThreader::New();
+  this->PeakFaceHashMemorySize = 0;
+
   this->GetInformation()->Set(vtkAlgorithm::PRESERVES_BOUNDS(), 1);
   this->GetInformation()->Set(vtkAlgorithm::PRESERVES_RANGES(), 1);
 
@@ -131,6 +138,7 @@ vtkDataSetSurfaceFilter::~vtkDataSetSurfaceFilter()
     }
   this->SetOriginalCellIdsName(NULL);
   this->SetOriginalPointIdsName(NULL);
+  this->Threader->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -949,13 +957,577 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "NonlinearSubdivisionLevel: "
      << this->NonlinearSubdivisionLevel << endl;
+  os << indent << "UseFaceTable: " << (this->UseFaceTable ? "On\n" : "Off\n");
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+  os << indent << "PeakFaceHashMemorySize: "
+     << this->PeakFaceHashMemorySize << endl;
 }
 
 //========================================================================
 // Tris are now degenerate quads so we only need one hash table.
 // We might want to change the method names from QuadHash to just Hash.
 
+//----------------------------------------------------------------------------
+// Rotates a quad so that its smallest id comes first, keeping its
+// orientation.
+static inline void vtkDataSetSurfaceOrderQuad(vtkIdType &a, vtkIdType &b,
+                                              vtkIdType &c, vtkIdType &d)
+{
+  vtkIdType tmp;
+  if (b < a && b < c && b < d)
+    {
+    tmp = a;
+    a = b;
+    b = c;
+    c = d;
+    d = tmp;
+    }
+  else if (c < a && c < b && c < d)
+    {
+    tmp = a;
+    a = c;
+    c = tmp;
+    tmp = b;
+    b = d;
+    d = tmp;
+    }
+  else if (d < a && d < b && d < c)
+    {
+    tmp = a;
+    a = d;
+    d = c;
+    c = b;
+    b = tmp;
+    }
+}
+
+//----------------------------------------------------------------------------
+// Rotates a triangle so that its smallest id comes first. We can't put the
+// second smallest in b because it might change the order of the vertices in
+// the final triangle.
+static inline void vtkDataSetSurfaceOrderTri(vtkIdType &a, vtkIdType &b,
+                                             vtkIdType &c)
+{
+  vtkIdType tmp;
+  if (b < a && b < c)
+    {
+    tmp = a;
+    a = b;
+    b = c;
+    c = tmp;
+    }
+  else if (c < a && c < b)
+    {
+    tmp = a;
+    a = c;
+    c = b;
+    b = tmp;
+    }
+}
+
+//========================================================================
+// The face table handles grids whose 3D cells are hexahedra, voxels,
+// tetrahedra, wedges and pyramids. Each face of these cells is identified
+// by a record (cellId*8 + face index), and the records are sorted into
+// buckets of consecutive first point ids (after the rotations above) in
+// two passes over contiguous ranges of cells: one counts the faces of each
+// bucket, the other writes the records. Each bucket is then matched with a
+// small open-addressing table, and its unshared faces are sorted by first
+// point id and insertion order, which is the order in which the hash
+// returns them. The records take 4 or 8 bytes per face, and the point ids
+// of a face are read again from the cell array when they are needed.
+
+// The faces as given to the hash by UnstructuredGridExecute(); the faces
+// of wedges and pyramids come from vtkWedge and vtkPyramid.
+static int vtkDataSetSurfaceHexahedronFaces[6][4] = {
+  {0,1,5,4}, {0,3,2,1}, {0,4,7,3}, {1,2,6,5}, {2,3,7,6}, {4,5,6,7} };
+static int vtkDataSetSurfaceVoxelFaces[6][4] = {
+  {0,1,5,4}, {0,2,3,1}, {0,4,6,2}, {1,3,7,5}, {2,6,7,3}, {4,5,7,6} };
+static int vtkDataSetSurfaceTetraFaces[4][4] = {
+  {0,1,3,-1}, {0,2,1,-1}, {0,3,2,-1}, {1,2,3,-1} };
+
+//----------------------------------------------------------------------------
+// Returns the number of faces of the cell types handled by the face table,
+// and 0 for the other cell types.
+static inline int vtkFaceTableNumberOfFaces(int cellType)
+{
+  switch (cellType)
+    {
+    case VTK_HEXAHEDRON:
+    case VTK_VOXEL:
+      return 6;
+    case VTK_WEDGE:
+    case VTK_PYRAMID:
+      return 5;
+    case VTK_TETRA:
+      return 4;
+    }
+  return 0;
+}
+
+// A face rotated as in the hash, and a key that identifies it whatever its
+// orientation: (a,c,min(b,d),max(b,d)) for quads and (a,min(b,c),max(b,c),-1)
+// for triangles. Two faces match in the hash exactly when their keys are
+// equal.
+struct vtkFaceTableFace
+{
+  int NumberOfPoints;
+  vtkIdType Ids[4];
+  vtkIdType Key[4];
+};
+
+//----------------------------------------------------------------------------
+// Returns the local point ids of a face, the fourth one being -1 for
+// triangles.
+static inline const int *vtkFaceTableFaceArray(int cellType, int faceId)
+{
+  switch (cellType)
+    {
+    case VTK_HEXAHEDRON:
+      return vtkDataSetSurfaceHexahedronFaces[faceId];
+    case VTK_VOXEL:
+      return vtkDataSetSurfaceVoxelFaces[faceId];
+    case VTK_WEDGE:
+      return vtkWedge::GetFaceArray(faceId);
+    case VTK_PYRAMID:
+      return vtkPyramid::GetFaceArray(faceId);
+    }
+  return vtkDataSetSurfaceTetraFaces[faceId];
+}
+
+//----------------------------------------------------------------------------
+// Returns the smallest point id of a face, which comes first once the face
+// is rotated.
+static inline vtkIdType vtkFaceTableFirstId(const vtkIdType *cellPts,
+                                            const int *verts)
+{
+  vtkIdType a = cellPts[verts[0]];
+  if (cellPts[verts[1]] < a)
+    {
+    a = cellPts[verts[1]];
+    }
+  if (cellPts[verts[2]] < a)
+    {
+    a = cellPts[verts[2]];
+    }
+  if (verts[3] >= 0 && cellPts[verts[3]] < a)
+    {
+    a = cellPts[verts[3]];
+    }
+  return a;
+}
+
+//----------------------------------------------------------------------------
+static inline void vtkFaceTableGetFace(const vtkIdType *cellPts, int cellType,
+                                       int faceId, vtkFaceTableFace &face)
+{
+  const int *verts = vtkFaceTableFaceArray(cellType, faceId);
+  vtkIdType a = cellPts[verts[0]];
+  vtkIdType b = cellPts[verts[1]];
+  vtkIdType c = cellPts[verts[2]];
+  if (verts[3] >= 0)
+    {
+    vtkIdType d = cellPts[verts[3]];
+    vtkDataSetSurfaceOrderQuad(a, b, c, d);
+    face.NumberOfPoints = 4;
+    face.Ids[0] = face.Key[0] = a;
+    face.Ids[1] = b;
+    face.Ids[2] = face.Key[1] = c;
+    face.Ids[3] = d;
+    face.Key[2] = (b < d ? b : d);
+    face.Key[3] = (b < d ? d : b);
+    }
+  else
+    {
+    vtkDataSetSurfaceOrderTri(a, b, c);
+    face.NumberOfPoints = 3;
+    face.Ids[0] = face.Key[0] = a;
+    face.Ids[1] = b;
+    face.Ids[2] = c;
+    face.Key[1] = (b < c ? b : c);
+    face.Key[2] = (b < c ? c : b);
+    face.Key[3] = -1;
+    }
+}
+
+//----------------------------------------------------------------------------
+static inline size_t vtkFaceTableHash(const vtkIdType key[4])
+{
+  size_t h = static_cast<size_t>(key[0]);
+  h = h * 31 + static_cast<size_t>(key[1]);
+  h = h * 31 + static_cast<size_t>(key[2]);
+  h = h * 31 + static_cast<size_t>(key[3]);
+  h ^= h >> 15;
+  h *= 0x2c1b3c6dU;
+  h ^= h >> 12;
+  return h;
+}
+
+// An entry of the matching table of a bucket.
+struct vtkFaceTableSlot
+{
+  vtkIdType Key[4];
+  vtkIdType Position; // of the face in its bucket, -1 for an empty slot
+  int Shared;
+};
+
+// The unshared faces found by the face table, as cellId*8 + face index,
+// bucket after bucket, in the order in which the hash returns them.
+struct vtkFaceTableResult
+{
+  vtkstd::vector<vtkstd::vector<vtkIdType> > Visible;
+  unsigned long MemorySize; // peak, in bytes
+};
+
+template <class TRecord>
+struct vtkFaceTableData
+{
+  const vtkIdType *Cells;
+  const vtkIdType *Locations;
+  const unsigned char *Types;
+  vtkIdType NumberOfCells;
+  int NumberOfRanges;
+  vtkIdType PointsPerBucket;
+  vtkIdType NumberOfBuckets;
+  vtkIdType *Positions; // per range and bucket: count, then next position
+  vtkIdType *BucketStarts;
+  TRecord *Records;
+  vtkFaceTableResult *Result;
+  int Pass; // 0: count, 1: fill, 2: match
+  unsigned long TableSizes[VTK_MAX_THREADS];
+};
+
+//----------------------------------------------------------------------------
+// Counts (fill == 0) or writes the records of the faces of a range of cells.
+template <class TRecord>
+static void vtkFaceTableSortFaces(vtkFaceTableData<TRecord> *data, int range,
+                                  int fill)
+{
+  vtkIdType numCells = data->NumberOfCells;
+  vtkIdType perRange = numCells / data->NumberOfRanges;
+  vtkIdType extra = numCells % data->NumberOfRanges;
+  vtkIdType begin = range*perRange + (range < extra ? range : extra);
+  vtkIdType end = begin + perRange + (range < extra ? 1 : 0);
+  vtkIdType *positions = data->Positions + range*data->NumberOfBuckets;
+
+  for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+    int cellType = data->Types[cellId];
+    int numFaces = vtkFaceTableNumberOfFaces(cellType);
+    const vtkIdType *pts = data->Cells + data->Locations[cellId] + 1;
+    for (int j = 0; j < numFaces; ++j)
+      {
+      vtkIdType bucket =
+        vtkFaceTableFirstId(pts, vtkFaceTableFaceArray(cellType, j)) /
+        data->PointsPerBucket;
+      if (fill)
+        {
+        data->Records[positions[bucket]++] =
+          static_cast<TRecord>(cellId*8 + j);
+        }
+      else
+        {
+        ++positions[bucket];
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Matches the faces of every NumberOfRanges-th bucket, from the given one.
+template <class TRecord>
+static void vtkFaceTableMatchFaces(vtkFaceTableData<TRecord> *data,
+                                   int thread)
+{
+  vtkstd::vector<vtkFaceTableSlot> table;
+  vtkstd::vector<vtkstd::pair<vtkIdType, vtkIdType> > visible;
+  vtkFaceTableFace face;
+
+  for (vtkIdType bucket = thread; bucket < data->NumberOfBuckets;
+       bucket += data->NumberOfRanges)
+    {
+    const TRecord *records = data->Records + data->BucketStarts[bucket];
+    vtkIdType numFaces =
+      data->BucketStarts[bucket+1] - data->BucketStarts[bucket];
+    size_t size = 16;
+    while (size < static_cast<size_t>(2*numFaces))
+      {
+      size *= 2;
+      }
+    if (table.size() < size)
+      {
+      table.resize(size);
+      }
+    size_t mask = size - 1;
+    size_t h;
+    for (h = 0; h < size; ++h)
+      {
+      table[h].Position = -1;
+      }
+
+    for (vtkIdType i = 0; i < numFaces; ++i)
+      {
+      vtkIdType cellId = static_cast<vtkIdType>(records[i] >> 3);
+      int cellType = data->Types[cellId];
+      vtkFaceTableGetFace(data->Cells + data->Locations[cellId] + 1, cellType,
+                          static_cast<int>(records[i] & 7), face);
+      for (h = vtkFaceTableHash(face.Key) & mask; ; h = (h + 1) & mask)
+        {
+        vtkFaceTableSlot &slot = table[h];
+        if (slot.Position < 0)
+          {
+          slot.Key[0] = face.Key[0];
+          slot.Key[1] = face.Key[1];
+          slot.Key[2] = face.Key[2];
+          slot.Key[3] = face.Key[3];
+          slot.Position = i;
+          slot.Shared = 0;
+          break;
+          }
+        if (slot.Key[0] == face.Key[0] && slot.Key[1] == face.Key[1] &&
+            slot.Key[2] == face.Key[2] && slot.Key[3] == face.Key[3])
+          {
+          // Hide any face shared by two or more cells.
+          slot.Shared = 1;
+          break;
+          }
+        }
+      }
+
+    visible.clear();
+    for (h = 0; h < size; ++h)
+      {
+      if (table[h].Position >= 0 && !table[h].Shared)
+        {
+        visible.push_back(
+          vtkstd::make_pair(table[h].Key[0], table[h].Position));
+        }
+      }
+    vtkstd::sort(visible.begin(), visible.end());
+    vtkstd::vector<vtkIdType> &result = data->Result->Visible[bucket];
+    result.resize(visible.size());
+    for (size_t k = 0; k < visible.size(); ++k)
+      {
+      result[k] = static_cast<vtkIdType>(records[visible[k].second]);
+      }
+    }
+
+  data->TableSizes[thread] = static_cast<unsigned long>(
+    table.capacity()*sizeof(vtkFaceTableSlot) +
+    visible.capacity()*sizeof(vtkstd::pair<vtkIdType, vtkIdType>));
+}
+
+//----------------------------------------------------------------------------
+template <class TRecord>
+static VTK_THREAD_RETURN_TYPE vtkFaceTableThread(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkFaceTableData<TRecord> *data =
+    static_cast<vtkFaceTableData<TRecord> *>(info->UserData);
+
+  if (data->Pass < 2)
+    {
+    vtkFaceTableSortFaces(data, info->ThreadID, data->Pass);
+    }
+  else
+    {
+    vtkFaceTableMatchFaces(data, info->ThreadID);
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+// Finds the unshared faces of the cells of the input with numThreads
+// threads, using records of type TRecord.
+template <class TRecord>
+static void vtkFaceTableMatch(vtkMultiThreader *threader, int numThreads,
+                              vtkUnstructuredGrid *input,
+                              vtkFaceTableResult &result, TRecord *)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+  // Without points there is no bucket, and no face to match.
+  if (numPts < 1)
+    {
+    return;
+    }
+
+  threader->SetNumberOfThreads(numThreads);
+  numThreads = threader->GetNumberOfThreads();
+
+  // Buckets of about 1K faces (6 per cell at most), so that their tables
+  // stay in the cache, and enough of them to balance the threads.
+  vtkIdType numBuckets = 16*numThreads;
+  if (6*numCells / 1024 > numBuckets)
+    {
+    numBuckets = 6*numCells / 1024;
+    }
+  if (numBuckets > numPts)
+    {
+    numBuckets = numPts;
+    }
+  vtkFaceTableData<TRecord> data;
+  data.Cells = input->GetCells()->GetPointer();
+  data.Locations = input->GetCellLocationsArray()->GetPointer(0);
+  data.Types = input->GetCellTypesArray()->GetPointer(0);
+  data.NumberOfCells = numCells;
+  data.NumberOfRanges = numThreads;
+  data.PointsPerBucket = (numPts + numBuckets - 1) / numBuckets;
+  data.NumberOfBuckets =
+    (numPts + data.PointsPerBucket - 1) / data.PointsPerBucket;
+  data.Result = &result;
+  for (int i = 0; i < numThreads; ++i)
+    {
+    data.TableSizes[i] = 0;
+    }
+
+  vtkIdType numPositions = numThreads*data.NumberOfBuckets;
+  data.Positions = new vtkIdType[numPositions];
+  data.BucketStarts = new vtkIdType[data.NumberOfBuckets + 1];
+  vtkIdType i, bucket;
+  for (i = 0; i < numPositions; ++i)
+    {
+    data.Positions[i] = 0;
+    }
+  threader->SetSingleMethod(vtkFaceTableThread<TRecord>, &data);
+
+  // Count the faces of each bucket and range of cells, and turn the counts
+  // into the positions of the records: bucket after bucket, and range after
+  // range within a bucket, so that the records keep the order of the cells.
+  data.Pass = 0;
+  threader->SingleMethodExecute();
+  vtkIdType numFaces = 0;
+  for (bucket = 0; bucket < data.NumberOfBuckets; ++bucket)
+    {
+    data.BucketStarts[bucket] = numFaces;
+    for (int range = 0; range < numThreads; ++range)
+      {
+      vtkIdType &position = data.Positions[range*data.NumberOfBuckets + bucket];
+      vtkIdType count = position;
+      position = numFaces;
+      numFaces += count;
+      }
+    }
+  data.BucketStarts[data.NumberOfBuckets] = numFaces;
+
+  data.Records = new TRecord[numFaces];
+  data.Pass = 1;
+  threader->SingleMethodExecute();
 
+  result.Visible.resize(data.NumberOfBuckets);
+  data.Pass = 2;
+  threader->SingleMethodExecute();
+
+  unsigned long size = static_cast<unsigned long>(
+    numPositions*sizeof(vtkIdType) +
+    data.NumberOfBuckets*(sizeof(vtkIdType) + sizeof(vtkstd::vector<vtkIdType>)) +
+    numFaces*sizeof(TRecord));
+  for (int t = 0; t < numThreads; ++t)
+    {
+    size += data.TableSizes[t];
+    }
+  for (bucket = 0; bucket < data.NumberOfBuckets; ++bucket)
+    {
+    size += static_cast<unsigned long>(
+      result.Visible[bucket].capacity()*sizeof(vtkIdType));
+    }
+  result.MemorySize = size;
+
+  delete [] data.Records;
+  delete [] data.BucketStarts;
+  delete [] data.Positions;
+}
+
+//----------------------------------------------------------------------------
+// The face table needs the legacy cell array (with the cell locations) and
+// cannot be mixed with the hash, so it is used only when no cell has faces
+// other than those of the cell types it handles.
+int vtkDataSetSurfaceFilter::CanUseFaceTable(vtkUnstructuredGrid *input)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+  if (!this->UseFaceTable || numCells == 0 ||
+      input->GetCells()->IsStorageOffsets() ||
+      !input->GetCellLocationsArray())
+    {
+    return 0;
+    }
+
+  unsigned char *cellTypes = input->GetCellTypesArray()->GetPointer(0);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    switch (cellTypes[cellId])
+      {
+      case VTK_EMPTY_CELL:
+      case VTK_VERTEX:
+      case VTK_POLY_VERTEX:
+      case VTK_LINE:
+      case VTK_POLY_LINE:
+      case VTK_TRIANGLE:
+      case VTK_TRIANGLE_STRIP:
+      case VTK_POLYGON:
+      case VTK_PIXEL:
+      case VTK_QUAD:
+      case VTK_QUADRATIC_TRIANGLE:
+      case VTK_BIQUADRATIC_TRIANGLE:
+      case VTK_QUADRATIC_QUAD:
+      case VTK_QUADRATIC_LINEAR_QUAD:
+      case VTK_BIQUADRATIC_QUAD:
+      case VTK_TETRA:
+      case VTK_VOXEL:
+      case VTK_HEXAHEDRON:
+      case VTK_WEDGE:
+      case VTK_PYRAMID:
+        break;
+      default:
+        return 0;
+      }
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Memory, in bytes, of the hash and of the point map.
+unsigned long vtkDataSetSurfaceFilter::GetQuadHashMemorySize()
+{
+  unsigned long size = static_cast<unsigned long>(
+    this->QuadHashLength*(sizeof(vtkFastGeomQuad *) + sizeof(vtkIdType)) +
+    this->NumberOfFastGeomQuadArrays*sizeof(unsigned char *));
+  for (vtkIdType idx = 0; idx < this->NumberOfFastGeomQuadArrays; ++idx)
+    {
+    if (this->FastGeomQuadArrays[idx])
+      {
+      size += static_cast<unsigned long>(this->FastGeomQuadArrayLength);
+      }
+    }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+// The cells of the legacy storage are walked through their interleaved list,
+// and those of the offsets storage, which that list would convert, are read
+// by id: the cell pointer is NULL for them.
+static vtkIdType *vtkDataSetSurfaceFilterGetCellPointer(vtkCellArray *cells)
+{
+  return cells->IsStorageOffsets() ? 0 : cells->GetPointer();
+}
+
+static inline void vtkDataSetSurfaceFilterGetCell(vtkCellArray *cells,
+                                                  vtkIdType cellId,
+                                                  vtkIdType *&cellPointer,
+                                                  vtkIdType &npts,
+                                                  vtkIdType *&pts)
+{
+  if (!cellPointer)
+    {
+    cells->GetCellAtId(cellId, npts, pts);
+    return;
+    }
+  npts = cellPointer[0];
+  pts = cellPointer + 1;
+  // Move to the next cell.
+  cellPointer += 1 + npts;
+}
 
 //----------------------------------------------------------------------------
 int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
@@ -972,10 +1544,12 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   vtkIdType *cellPointer;
   int cellType;
   vtkUnstructuredGrid *input = vtkUnstructuredGrid::SafeDownCast(dataSetInput);
+  vtkCellArray *cells = input->GetCells();
   vtkIdType numPts=input->GetNumberOfPoints();
   vtkIdType numCells=input->GetNumberOfCells();
   vtkGenericCell *cell;
-  int numFacePts, numCellPts;
+  int numFacePts;
+  vtkIdType numCellPts;
   vtkIdType inPtId, outPtId;
   vtkPointData *inputPD = input->GetPointData();
   vtkCellData *inputCD = input->GetCellData();
@@ -1009,7 +1583,23 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   cell = vtkGenericCell::New();
 
   this->NumberOfNewCells = 0;
-  this->InitializeQuadHash(numPts);
+
+  // Grids made only of the cell types handled by the face table do not
+  // need the hash, only the point map and the edge map of the hash.
+  int useFaceTable = this->CanUseFaceTable(input);
+  if (useFaceTable)
+    {
+    this->PointMap = new vtkIdType[numPts];
+    for (i = 0; i < numPts; ++i)
+      {
+      this->PointMap[i] = -1;
+      }
+    this->EdgeMap = new vtkEdgeInterpolationMap;
+    }
+  else
+    {
+    this->InitializeQuadHash(numPts);
+    }
 
   // Allocate
   //
@@ -1047,15 +1637,13 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
     }
 
   // First insert all points.  Points have to come first in poly data.
-  cellPointer = input->GetCells()->GetPointer();
+  cellPointer = vtkDataSetSurfaceFilterGetCellPointer(cells);
   for(cellId=0; cellId < numCells; cellId++)
     {
     // Direct access to cells.
     cellType = cellTypes[cellId];
-    numCellPts = cellPointer[0];
-    ids = cellPointer+1;
-    // Move to the next cell.
-    cellPointer += (1 + *cellPointer);
+    vtkDataSetSurfaceFilterGetCell(cells, cellId, cellPointer,
+                                   numCellPts, ids);
 
     // A couple of common cases to see if things go faster.
     if (cellType == VTK_VERTEX || cellType == VTK_POLY_VERTEX)
@@ -1081,7 +1669,7 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   // First insert all points lines in output and 3D geometry in hash.
   // Save 2D geometry for second pass.
   // initialize the pointer to the cells for fast traversal.
-  cellPointer = input->GetCells()->GetPointer();
+  cellPointer = vtkDataSetSurfaceFilterGetCellPointer(cells);
   for(cellId=0; cellId < numCells && !abort; cellId++)
     {
     //Progress and abort method support
@@ -1096,10 +1684,8 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
 
     // Direct access to cells.
     cellType = cellTypes[cellId];
-    numCellPts = cellPointer[0];
-    ids = cellPointer+1;
-    // Move to the next cell.
-    cellPointer += (1 + *cellPointer);
+    vtkDataSetSurfaceFilterGetCell(cells, cellId, cellPointer,
+                                   numCellPts, ids);
 
     // A couple of common cases to see if things go faster.
     if (cellType == VTK_VERTEX || cellType == VTK_POLY_VERTEX)
@@ -1118,6 +1704,10 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
       this->RecordOrigCellId(this->NumberOfNewCells, cellId);
       outputCD->CopyData(cd, cellId, this->NumberOfNewCells++);
       }
+    else if (useFaceTable && vtkFaceTableNumberOfFaces(cellType))
+      {
+      // The faces of these cells are matched after this loop.
+      }
     else if (cellType == VTK_HEXAHEDRON)
       {
       this->InsertQuadInHash(ids[0], ids[1], ids[5], ids[4], cellId);
@@ -1298,15 +1888,13 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   // Now insert 2DCells.  Because of poly datas (cell data) ordering,
   // the 2D cells have to come after points and lines.
   // initialize the pointer to the cells for fast traversal.
-  cellPointer = input->GetCells()->GetPointer();
+  cellPointer = vtkDataSetSurfaceFilterGetCellPointer(cells);
   for(cellId=0; cellId < numCells && !abort && flag2D; cellId++)
     {  
     // Direct acces to cells.
     cellType = input->GetCellType(cellId);
-    numCellPts = cellPointer[0];
-    ids = cellPointer+1;
-    // Move to the next cell.
-    cellPointer += (1 + *cellPointer);
+    vtkDataSetSurfaceFilterGetCell(cells, cellId, cellPointer,
+                                   numCellPts, ids);
 
     // If we have a quadratic face and our subdivision level is zero, just treat
     // it as a linear cell.  This should work so long as the first points of the
@@ -1481,19 +2069,82 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
     } // for all cells.
 
 
-  // Now transfer geometry from hash to output (only triangles and quads).
-  this->InitQuadHashTraversal();
-  while ( (q = this->GetNextVisibleQuadFromHash()) )
+  unsigned long memorySize;
+  if (useFaceTable)
+    {
+    // Match the faces with the face table, and transfer them to the output
+    // in the order in which the hash would have.
+    vtkFaceTableResult result;
+    result.MemorySize = 0;
+    int numThreads = this->NumberOfThreads;
+    if (numThreads > numCells / 1024)
+      {
+      numThreads = static_cast<int>(numCells / 1024);
+      }
+    if (numThreads < 1)
+      {
+      numThreads = 1;
+      }
+    if (!abort)
+      {
+      // Records of 32 bits are enough for up to 2^29 cells.
+      if (numCells < (static_cast<vtkIdType>(1) << 29))
+        {
+        vtkFaceTableMatch(this->Threader, numThreads, input, result,
+                          static_cast<vtkTypeUInt32 *>(0));
+        }
+      else
+        {
+        vtkFaceTableMatch(this->Threader, numThreads, input, result,
+                          static_cast<vtkTypeUInt64 *>(0));
+        }
+      }
+
+    vtkIdType *locations = input->GetCellLocationsArray()->GetPointer(0);
+    cellPointer = input->GetCells()->GetPointer();
+    vtkFaceTableFace tableFace;
+    for (size_t bucket = 0; bucket < result.Visible.size(); ++bucket)
+      {
+      vtkstd::vector<vtkIdType> &visible = result.Visible[bucket];
+      for (size_t k = 0; k < visible.size(); ++k)
+        {
+        cellId = visible[k] >> 3;
+        vtkFaceTableGetFace(cellPointer + locations[cellId] + 1,
+                            cellTypes[cellId],
+                            static_cast<int>(visible[k] & 7), tableFace);
+        for (i = 0; i < tableFace.NumberOfPoints; i++)
+          {
+          tableFace.Ids[i] = this->GetOutputPointId(tableFace.Ids[i], input,
+                                                    newPts, outputPD);
+          }
+        newPolys->InsertNextCell(tableFace.NumberOfPoints, tableFace.Ids);
+        this->RecordOrigCellId(this->NumberOfNewCells, cellId);
+        outputCD->CopyData(inputCD, cellId, this->NumberOfNewCells++);
+        }
+      }
+    memorySize = static_cast<unsigned long>(numPts*sizeof(vtkIdType)) +
+      result.MemorySize;
+    }
+  else
     {
-    // handle all polys
-    for (i = 0; i < q->numPts; i++)
+    // Now transfer geometry from hash to output (only triangles and quads).
+    this->InitQuadHashTraversal();
+    while ( (q = this->GetNextVisibleQuadFromHash()) )
       {
-      q->ptArray[i] = this->GetOutputPointId(q->ptArray[i], input, newPts, outputPD);
+      // handle all polys
+      for (i = 0; i < q->numPts; i++)
+        {
+        q->ptArray[i] = this->GetOutputPointId(q->ptArray[i], input, newPts, outputPD);
+        }
+      newPolys->InsertNextCell(q->numPts, q->ptArray);
+      this->RecordOrigCellId(this->NumberOfNewCells, q);
+      outputCD->CopyData(inputCD, q->SourceId, this->NumberOfNewCells++);
       }
-    newPolys->InsertNextCell(q->numPts, q->ptArray);
-    this->RecordOrigCellId(this->NumberOfNewCells, q);
-    outputCD->CopyData(inputCD, q->SourceId, this->NumberOfNewCells++);
+    memorySize = this->GetQuadHashMemorySize();
     }
+  this->PeakFaceHashMemorySize = memorySize / 1024;
+  vtkDebugMacro(<< "Face matching used " << this->PeakFaceHashMemorySize
+                << " kilobytes.");
 
   if (this->PassThroughCellIds)
     {
@@ -1603,35 +2254,10 @@ void vtkDataSetSurfaceFilter::InsertQuadInHash(vtkIdType a, vtkIdType b,
                                                vtkIdType c, vtkIdType d, 
                                                vtkIdType sourceId)
 {
-  vtkIdType tmp;
   vtkFastGeomQuad *quad, **end;
 
   // Reorder to get smallest id in a.
-  if (b < a && b < c && b < d)
-    {
-    tmp = a;
-    a = b;
-    b = c;
-    c = d;
-    d = tmp;
-    }
-  else if (c < a && c < b && c < d)
-    {
-    tmp = a;
-    a = c;
-    c = tmp;
-    tmp = b;
-    b = d;
-    d = tmp;
-    }
-  else if (d < a && d < b && d < c)
-    {
-    tmp = a;
-    a = d;
-    d = c;
-    c = b;
-    b = tmp;
-    }
+  vtkDataSetSurfaceOrderQuad(a, b, c, d);
 
   // Look for existing quad in the hash;
   end = this->QuadHash + a;
@@ -1671,26 +2297,10 @@ void vtkDataSetSurfaceFilter::InsertTriInHash(vtkIdType a, vtkIdType b,
                                               vtkIdType c, vtkIdType sourceId,
                                               vtkIdType vtkNotUsed(faceId)/*= -1*/)
 {
-  vtkIdType tmp;
   vtkFastGeomQuad *quad, **end;
 
   // Reorder to get smallest id in a.
-  if (b < a && b < c)
-    {
-    tmp = a;
-    a = b;
-    b = c;
-    c = tmp;
-    }
-  else if (c < a && c < b)
-    {
-    tmp = a;
-    a = c;
-    c = b;
-    b = tmp;
-    }
-  // We can't put the second smnallest in b because it might change the order
-  // of the vertices in the final triangle.
+  vtkDataSetSurfaceOrderTri(a, b, c);
 
   // Look for existing tri in the hash;
   end = this->QuadHash + a;
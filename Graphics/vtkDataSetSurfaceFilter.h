@@ -31,6 +31,8 @@
 class vtkPointData;
 class vtkPoints;
 class vtkIdTypeArray;
+class vtkMultiThreader;
+class vtkUnstructuredGrid;
 
 //BTX
 // Helper structure for hashing faces.
@@ -109,6 +111,30 @@ public:
   vtkSetMacro(NonlinearSubdivisionLevel, int);
   vtkGetMacro(NonlinearSubdivisionLevel, int);
 
+  // Description:
+  // If on (the default), the faces of the hexahedra, voxels, tetrahedra,
+  // wedges and pyramids of an unstructured grid are matched with a compact
+  // open-addressing face table rather than with the linked-list hash. The
+  // faces are sorted into buckets of point ids in two passes over the
+  // cells, and each bucket is then matched with a small table, so both
+  // steps run on NumberOfThreads threads. The output is the same either
+  // way. Grids with other 3D cells always use the hash.
+  vtkSetMacro(UseFaceTable, int);
+  vtkGetMacro(UseFaceTable, int);
+  vtkBooleanMacro(UseFaceTable, int);
+
+  // Description:
+  // Set/Get the number of threads used to build the face table, with 1
+  // (serial execution) as the default value.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // Return the peak memory, in kilobytes, used to match the faces of an
+  // unstructured grid (face hash or face table, and point map) during the
+  // last execution.
+  vtkGetMacro(PeakFaceHashMemorySize, unsigned long);
+
   // Description:
   // Direct access methods that can be used to use the this class as an
   // algorithm without using it as a filter.
@@ -209,6 +235,13 @@ protected:
 
   int NonlinearSubdivisionLevel;
 
+  int UseFaceTable;
+  int NumberOfThreads;
+  vtkMultiThreader *Threader;
+  unsigned long PeakFaceHashMemorySize;
+  int CanUseFaceTable(vtkUnstructuredGrid *input);
+  unsigned long GetQuadHashMemorySize();
+
 private:
   vtkDataSetSurfaceFilter(const vtkDataSetSurfaceFilter&);  // Not implemented.
   void operator=(const vtkDataSetSurfaceFilter&);  // Not implemented.
@@ -204,9 +204,8 @@ int vtkExtractCells::RequestData(
     vtkIdType oldId = ptIdMap->GetId(newId);
 
     pts->SetPoint(newId, input->GetPoint(oldId));
-
-    newPD->CopyData(PD, oldId, newId);
     }
+  newPD->CopyConsecutiveData(PD, ptIdMap, 0);
 
   output->SetPoints(pts);
   pts->Delete();
@@ -456,9 +455,8 @@ vtkIdList *vtkExtractCells::reMapPointIds(vtkDataSet *grid)
   
     this->SubSetUGridCellArraySize = 0;
   
-    vtkIdType *cellArray = ugrid->GetCells()->GetPointer();
-    vtkIdType *locs = ugrid->GetCellLocationsArray()->GetPointer(0);
-
+    // The cells are read through the grid so that a cell array with the
+    // offsets storage is not converted to an interleaved list.
     this->SubSetUGridCellArraySize = 0;
     vtkIdType maxid = ugrid->GetCellLocationsArray()->GetMaxId();
          
@@ -468,15 +466,14 @@ vtkIdList *vtkExtractCells::reMapPointIds(vtkDataSet *grid)
       {
       if (*cellPtr > maxid) continue;
         
-      int loc = locs[*cellPtr];
-
-      vtkIdType nIds = cellArray[loc++];
+      vtkIdType nIds, *cellPts;
+      ugrid->GetCellPoints(*cellPtr, nIds, cellPts);
 
       this->SubSetUGridCellArraySize += (1 + nIds);
         
       for (i=0; i<nIds; i++)  
         {
-        id = cellArray[loc++];
+        id = cellPts[i];
           
         if (temp[id] == 0)  
           {
@@ -523,6 +520,7 @@ void vtkExtractCells::CopyCellsDataSet(vtkIdList *ptMap, vtkDataSet *input,
     }
 
   vtkIdList *cellPoints = vtkIdList::New();
+  vtkIdList *oldCellIds = vtkIdList::New();
 
   vtkstd::set<vtkIdType>::iterator cellPtr;
 
@@ -542,16 +540,19 @@ void vtkExtractCells::CopyCellsDataSet(vtkIdList *ptMap, vtkDataSet *input,
 
       cellPoints->SetId(i, newId);
       }
-    int newId = output->InsertNextCell(input->GetCellType(cellId), cellPoints);
+    output->InsertNextCell(input->GetCellType(cellId), cellPoints);
 
-    newCD->CopyData(oldCD, cellId, newId);
+    oldCellIds->InsertNextId(cellId);
     if(origMap)
       {
       origMap->InsertNextValue(cellId);
       }
     }
 
+  newCD->CopyConsecutiveData(oldCD, oldCellIds, 0);
+
   cellPoints->Delete();
+  oldCellIds->Delete();
 
   return;
 }
@@ -599,11 +600,11 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkIdList *ptMap,
   typeArray->SetNumberOfValues(numCells);
 
   int nextCellId = 0;
+  vtkIdList *oldCellIds = vtkIdList::New();
+  oldCellIds->Allocate(numCells);
 
   vtkstd::set<vtkIdType>::iterator cellPtr;                           // input
-  vtkIdType *cells = ugrid->GetCells()->GetPointer();
   vtkIdType maxid = ugrid->GetCellLocationsArray()->GetMaxId();
-  vtkIdType *locs = ugrid->GetCellLocationsArray()->GetPointer(0);
   vtkUnsignedCharArray *types = ugrid->GetCellTypesArray();
 
   for (cellPtr = this->CellList->IdTypeSet.begin();
@@ -614,9 +615,9 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkIdList *ptMap,
       
     int oldCellId = *cellPtr;
 
-    int loc = locs[oldCellId];
-    int size = static_cast<int>(cells[loc]);
-    vtkIdType *pts = cells + loc + 1;
+    vtkIdType npts, *pts;
+    ugrid->GetCellPoints(oldCellId, npts, pts);
+    int size = static_cast<int>(npts);
     unsigned char type = types->GetValue(oldCellId);
 
     locationArray->SetValue(nextCellId, cellArrayIdx);
@@ -632,7 +633,7 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkIdList *ptMap,
       newcells->SetValue(cellArrayIdx++, newId);
       }
 
-    newCD->CopyData(oldCD, oldCellId, nextCellId);
+    oldCellIds->InsertNextId(oldCellId);
     if(origMap)
       {
       origMap->InsertNextValue(oldCellId);
@@ -640,6 +641,9 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkIdList *ptMap,
     nextCellId++;
     }
 
+  newCD->CopyConsecutiveData(oldCD, oldCellIds, 0);
+  oldCellIds->Delete();
+
   output->SetCells(typeArray, locationArray, cellArray);
 
   typeArray->Delete();
@@ -358,15 +358,15 @@ vtkIdType vtkMergeCells::AddNewCellsUnstructuredGrid(vtkDataSet *set,
   vtkUnstructuredGrid *newUgrid = vtkUnstructuredGrid::SafeDownCast(set);
   vtkUnstructuredGrid *Ugrid = this->UnstructuredGrid;
 
-  // connectivity information for the new data set
+  // connectivity information for the new data set, which is traversed
+  // rather than accessed through its pointer so that a cell array with the
+  // offsets storage is not converted to an interleaved list
       
   vtkCellArray *newCellArray = newUgrid->GetCells();
-  vtkIdType *newCells = newCellArray->GetPointer();
-  vtkIdType *newLocs = newUgrid->GetCellLocationsArray()->GetPointer(0);
   unsigned char *newTypes = newUgrid->GetCellTypesArray()->GetPointer(0);
     
   int newNumCells = newUgrid->GetNumberOfCells();
-  int newNumConnections = newCellArray->GetData()->GetNumberOfTuples();
+  int newNumConnections = newCellArray->GetNumberOfConnectivityEntries();
 
   // If we are checking for duplicate cells, create a list now of
   // any cells in the new data set that we already have.
@@ -403,7 +403,8 @@ vtkIdType vtkMergeCells::AddNewCellsUnstructuredGrid(vtkDataSet *set,
           duplicateCellIds->InsertNextId(id);
           numDuplicateCells++;
 
-          int npoints = newCells[newLocs[id]];
+          vtkIdType npoints, *pts;
+          newUgrid->GetCellPoints(id, npoints, pts);
 
           numDuplicateConnections += (npoints + 1);
           }
@@ -491,10 +492,12 @@ vtkIdType vtkMergeCells::AddNewCellsUnstructuredGrid(vtkDataSet *set,
   vtkIdType oldPtId, finalPtId;
 
   int nextDuplicateCellId = 0;
-  
+  vtkIdType size, *newCells;
+
+  newCellArray->InitTraversal();
   for (vtkIdType oldCellId=0; oldCellId < newNumCells; oldCellId++)
     {
-    vtkIdType size = *newCells++;
+    newCellArray->GetNextCell(size, newCells);
 
     if (duplicateCellIds)
       {
@@ -502,7 +505,6 @@ vtkIdType vtkMergeCells::AddNewCellsUnstructuredGrid(vtkDataSet *set,
     
       if (skipId == oldCellId)
         {
-        newCells += size;
         nextDuplicateCellId++;
         continue;
         }
@@ -14,13 +14,25 @@
 =========================================================================*/
 #include "vtkPointDataToCellData.h"
 
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkStructuredData.h"
+#include "vtkStructuredGrid.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
 
 vtkStandardNewMacro(vtkPointDataToCellData);
 
@@ -29,6 +41,305 @@ vtkStandardNewMacro(vtkPointDataToCellData);
 vtkPointDataToCellData::vtkPointDataToCellData()
 {
   this->PassPointData = 0;
+  this->NumberOfThreads = 1;
+  this->Threader = vtkMultiThreader::New();
+}
+
+//----------------------------------------------------------------------------
+vtkPointDataToCellData::~vtkPointDataToCellData()
+{
+  this->Threader->Delete();
+}
+
+//----------------------------------------------------------------------------
+// The points of each cell, for the datasets that can give them to several
+// threads at once: image data, rectilinear and structured grids from their
+// dimensions, poly data and unstructured grids from their cell arrays.
+struct vtkPointDataToCellDataCells
+{
+  int Structured;
+  int PixelOrder; // 0 for structured grids, which order points as quads
+  int DataDescription;
+  int Dimensions[3];
+  vtkPolyData *PolyData;
+  vtkCellArray *OffsetsCells;
+  const vtkIdType *Connectivity;
+  const vtkIdType *Locations;
+};
+
+//----------------------------------------------------------------------------
+static int vtkPointDataToCellDataInitializeCells(
+  vtkDataSet *input, vtkPointDataToCellDataCells &cells)
+{
+  cells.Structured = 1;
+  cells.PixelOrder = 1;
+  cells.PolyData = 0;
+  cells.OffsetsCells = 0;
+  cells.Connectivity = 0;
+  cells.Locations = 0;
+  if (vtkImageData *image = vtkImageData::SafeDownCast(input))
+    {
+    image->GetDimensions(cells.Dimensions);
+    }
+  else if (vtkRectilinearGrid *rgrid = vtkRectilinearGrid::SafeDownCast(input))
+    {
+    rgrid->GetDimensions(cells.Dimensions);
+    }
+  else if (vtkStructuredGrid *sgrid = vtkStructuredGrid::SafeDownCast(input))
+    {
+    sgrid->GetDimensions(cells.Dimensions);
+    cells.PixelOrder = 0;
+    }
+  else
+    {
+    cells.Structured = 0;
+    }
+  if (cells.Structured)
+    {
+    cells.DataDescription =
+      vtkStructuredData::GetDataDescription(cells.Dimensions);
+    return 1;
+    }
+
+  // The cells of a grid stored with offsets are copied to the list of each
+  // thread, as they may be read through a shared buffer otherwise, and the
+  // offsets storage is kept.
+  if (vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(input))
+    {
+    if (grid->GetCells() && grid->GetCells()->IsStorageOffsets())
+      {
+      cells.OffsetsCells = grid->GetCells();
+      return 1;
+      }
+    if (!grid->GetCells() || !grid->GetCellLocationsArray())
+      {
+      return 0;
+      }
+    cells.Connectivity = grid->GetCells()->GetPointer();
+    cells.Locations = grid->GetCellLocationsArray()->GetPointer(0);
+    return 1;
+    }
+  if (vtkPolyData *polys = vtkPolyData::SafeDownCast(input))
+    {
+    if (polys->GetVerts()->IsStorageOffsets() ||
+        polys->GetLines()->IsStorageOffsets() ||
+        polys->GetPolys()->IsStorageOffsets() ||
+        polys->GetStrips()->IsStorageOffsets())
+      {
+      return 0;
+      }
+    polys->BuildCells();
+    cells.PolyData = polys;
+    return 1;
+    }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+static inline vtkIdType vtkPointDataToCellDataGetPoints(
+  vtkPointDataToCellDataCells *cells, vtkIdType cellId, vtkIdList *ptIds,
+  vtkIdType *&pts)
+{
+  vtkIdType npts;
+  if (cells->Structured)
+    {
+    vtkStructuredData::GetCellPoints(cellId, ptIds, cells->DataDescription,
+                                     cells->Dimensions);
+    pts = ptIds->GetPointer(0);
+    npts = ptIds->GetNumberOfIds();
+    if (!cells->PixelOrder && npts >= 4)
+      {
+      vtkstd::swap(pts[2], pts[3]);
+      if (npts == 8)
+        {
+        vtkstd::swap(pts[6], pts[7]);
+        }
+      }
+    return npts;
+    }
+  if (cells->PolyData)
+    {
+    cells->PolyData->GetCellPoints(cellId, npts, pts);
+    return npts;
+    }
+  if (cells->OffsetsCells)
+    {
+    cells->OffsetsCells->GetCellAtId(cellId, ptIds);
+    pts = ptIds->GetPointer(0);
+    return ptIds->GetNumberOfIds();
+    }
+  const vtkIdType *cell = cells->Connectivity + cells->Locations[cellId];
+  pts = const_cast<vtkIdType *>(cell + 1);
+  return cell[0];
+}
+
+//----------------------------------------------------------------------------
+// Averages one tuple as vtkDataArray::InterpolateTuple() does with equal
+// weights, rounding the integer types.
+template <class T>
+inline void vtkPointDataToCellDataRound(double val, T *retVal)
+{
+  *retVal = static_cast<T>((val>=0.0)?(val + 0.5):(val - 0.5));
+}
+
+VTK_TEMPLATE_SPECIALIZE
+inline void vtkPointDataToCellDataRound(double val, double *retVal)
+{
+  *retVal = val;
+}
+
+VTK_TEMPLATE_SPECIALIZE
+inline void vtkPointDataToCellDataRound(double val, float *retVal)
+{
+  *retVal = static_cast<float>(val);
+}
+
+template <class T>
+static void vtkPointDataToCellDataInterpolate(const void *source, void *target,
+                                              int numComp, vtkIdType cellId,
+                                              const vtkIdType *pts,
+                                              vtkIdType numPts, double weight)
+{
+  const T *from = static_cast<const T *>(source);
+  T *to = static_cast<T *>(target) + cellId*numComp;
+  for (int i = 0; i < numComp; ++i)
+    {
+    double c = 0;
+    for (vtkIdType j = 0; j < numPts; ++j)
+      {
+      c += weight*static_cast<double>(from[pts[j]*numComp+i]);
+      }
+    vtkPointDataToCellDataRound(c, to + i);
+    }
+}
+
+typedef void (*vtkPointDataToCellDataFunction)(const void *, void *, int,
+                                               vtkIdType, const vtkIdType *,
+                                               vtkIdType, double);
+
+struct vtkPointDataToCellDataArray
+{
+  const void *Source;
+  void *Target;
+  int NumberOfComponents;
+  vtkPointDataToCellDataFunction Function;
+};
+
+struct vtkPointDataToCellDataThreadStruct
+{
+  vtkPointDataToCellData *Filter;
+  vtkPointDataToCellDataCells *Cells;
+  vtkstd::vector<vtkPointDataToCellDataArray> Arrays;
+  vtkIdType NumberOfCells;
+};
+
+//----------------------------------------------------------------------------
+// Each thread averages all the arrays over its own range of cells.
+static VTK_THREAD_RETURN_TYPE vtkPointDataToCellDataThread(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkPointDataToCellDataThreadStruct *data =
+    static_cast<vtkPointDataToCellDataThreadStruct *>(info->UserData);
+
+  vtkIdType numCells = data->NumberOfCells;
+  vtkIdType perThread = numCells / info->NumberOfThreads;
+  vtkIdType extra = numCells % info->NumberOfThreads;
+  vtkIdType id = info->ThreadID;
+  vtkIdType begin = id*perThread + (id < extra ? id : extra);
+  vtkIdType end = begin + perThread + (id < extra ? 1 : 0);
+
+  vtkIdList *ptIds = vtkIdList::New();
+  ptIds->Allocate(8);
+  vtkIdType *pts;
+  size_t numArrays = data->Arrays.size();
+  vtkPointDataToCellDataArray *arrays = numArrays ? &data->Arrays[0] : 0;
+  vtkIdType progressInterval = (end - begin)/20 + 1;
+
+  for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+    if ( !((cellId - begin) % progressInterval) )
+      {
+      // Only the thread that called SingleMethodExecute reports progress.
+      if (id == 0)
+        {
+        data->Filter->UpdateProgress(
+          static_cast<double>(cellId - begin)/(end - begin));
+        }
+      if (data->Filter->GetAbortExecute())
+        {
+        break;
+        }
+      }
+
+    vtkIdType numPts =
+      vtkPointDataToCellDataGetPoints(data->Cells, cellId, ptIds, pts);
+    double weight = ( numPts > 0 ) ? 1.0 / numPts : 0.0;
+    for (size_t i = 0; i < numArrays; i++)
+      {
+      arrays[i].Function(arrays[i].Source, arrays[i].Target,
+                         arrays[i].NumberOfComponents, cellId, pts, numPts,
+                         weight);
+      }
+    }
+
+  ptIds->Delete();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+// Pairs the arrays that InterpolateAllocate() added to the cell data with
+// the point data arrays of the same name, and sizes them. Returns 0, leaving
+// the arrays alone, unless all of them are named data arrays (but bit
+// arrays) of the same type as their source.
+static int vtkPointDataToCellDataPairArrays(
+  vtkPointData *inPD, vtkCellData *outCD,
+  const vtkstd::vector<vtkAbstractArray *> &passedArrays,
+  vtkPointDataToCellDataThreadStruct &data)
+{
+  vtkstd::vector<vtkDataArray *> sources, targets;
+  int i;
+  for (i = 0; i < outCD->GetNumberOfArrays(); i++)
+    {
+    vtkAbstractArray *target = outCD->GetAbstractArray(i);
+    if (vtkstd::find(passedArrays.begin(), passedArrays.end(), target) !=
+        passedArrays.end())
+      {
+      continue;
+      }
+    if (!target->GetName())
+      {
+      return 0;
+      }
+    vtkDataArray *source =
+      vtkDataArray::SafeDownCast(inPD->GetAbstractArray(target->GetName()));
+    if (!source || !vtkDataArray::SafeDownCast(target) ||
+        source->GetDataType() != target->GetDataType() ||
+        source->GetDataType() == VTK_BIT ||
+        source->GetNumberOfComponents() != target->GetNumberOfComponents())
+      {
+      return 0;
+      }
+    sources.push_back(source);
+    targets.push_back(static_cast<vtkDataArray *>(target));
+    }
+
+  for (size_t j = 0; j < targets.size(); j++)
+    {
+    targets[j]->SetNumberOfTuples(data.NumberOfCells);
+    vtkPointDataToCellDataArray array;
+    array.Source = sources[j]->GetVoidPointer(0);
+    array.Target = targets[j]->GetVoidPointer(0);
+    array.NumberOfComponents = sources[j]->GetNumberOfComponents();
+    array.Function = 0;
+    switch (sources[j]->GetDataType())
+      {
+      vtkTemplateMacro(
+        array.Function = vtkPointDataToCellDataInterpolate<VTK_TT>);
+      }
+    data.Arrays.push_back(array);
+    }
+  return 1;
 }
 
 //----------------------------------------------------------------------------
@@ -78,28 +389,57 @@ int vtkPointDataToCellData::RequestData(
 
   // notice that inPD and outCD are vtkPointData and vtkCellData; respectively.
   // It's weird, but it works.
+  vtkstd::vector<vtkAbstractArray *> passedArrays;
+  for (int i = 0; i < outCD->GetNumberOfArrays(); i++)
+    {
+    passedArrays.push_back(outCD->GetAbstractArray(i));
+    }
   outCD->InterpolateAllocate(inPD,numCells);
 
-  int abort=0;
-  vtkIdType progressInterval=numCells/20 + 1;
-  for (cellId=0; cellId < numCells && !abort; cellId++)
+  // Average all the arrays in one sweep over the cells when they can be
+  // accessed directly.
+  vtkPointDataToCellDataCells cells;
+  vtkPointDataToCellDataThreadStruct data;
+  data.Filter = this;
+  data.Cells = &cells;
+  data.NumberOfCells = numCells;
+  if ( vtkPointDataToCellDataInitializeCells(input, cells) &&
+       vtkPointDataToCellDataPairArrays(inPD, outCD, passedArrays, data) )
     {
-    if ( !(cellId % progressInterval) )
+    // It is not worth splitting small datasets among threads.
+    int numThreads = this->NumberOfThreads;
+    if ( numThreads > numCells / 1024 )
       {
-      this->UpdateProgress((double)cellId/numCells);
-      abort = GetAbortExecute();
+      numThreads = ( numCells / 1024 > 1 ) ?
+        static_cast<int>(numCells / 1024) : 1;
       }
-
-    input->GetCellPoints(cellId, cellPts);
-    numPts = cellPts->GetNumberOfIds();
-    if ( numPts > 0 )
+    this->Threader->SetNumberOfThreads(numThreads);
+    this->Threader->SetSingleMethod(vtkPointDataToCellDataThread, &data);
+    this->Threader->SingleMethodExecute();
+    }
+  else
+    {
+    int abort=0;
+    vtkIdType progressInterval=numCells/20 + 1;
+    for (cellId=0; cellId < numCells && !abort; cellId++)
       {
-      weight = 1.0 / numPts;
-      for (ptId=0; ptId < numPts; ptId++)
+      if ( !(cellId % progressInterval) )
+        {
+        this->UpdateProgress((double)cellId/numCells);
+        abort = GetAbortExecute();
+        }
+
+      input->GetCellPoints(cellId, cellPts);
+      numPts = cellPts->GetNumberOfIds();
+      if ( numPts > 0 )
         {
-        weights[ptId] = weight;
+        weight = 1.0 / numPts;
+        for (ptId=0; ptId < numPts; ptId++)
+          {
+          weights[ptId] = weight;
+          }
+        outCD->InterpolatePoint(inPD, cellId, cellPts, weights);
         }
-      outCD->InterpolatePoint(inPD, cellId, cellPts, weights);
       }
     }
 
@@ -122,4 +462,5 @@ void vtkPointDataToCellData::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "Pass Point Data: " << (this->PassPointData ? "On\n" : "Off\n");
+  os << indent << "Number Of Threads: " << this->NumberOfThreads << "\n";
 }
@@ -19,6 +19,9 @@
 // The method of transformation is based on averaging the data
 // values of all points defining a particular cell. Optionally, the input point
 // data can be passed through to the output as well.
+//
+// The averages can be computed by several threads (see NumberOfThreads),
+// each of which averages all the arrays over its own range of cells.
 
 // .SECTION Caveats
 // This filter is an abstract filter, that is, the output is an abstract type
@@ -35,6 +38,8 @@
 
 #include "vtkDataSetAlgorithm.h"
 
+class vtkMultiThreader;
+
 class VTK_GRAPHICS_EXPORT vtkPointDataToCellData : public vtkDataSetAlgorithm
 {
 public:
@@ -50,15 +55,29 @@ public:
   vtkGetMacro(PassPointData,int);
   vtkBooleanMacro(PassPointData,int);
 
+  // Description:
+  // Set/Get the number of threads used to average the point data, with 1
+  // (serial execution) as the default value. Each thread handles a range
+  // of cells, so the output is the same whatever the number of threads.
+  // Datasets other than image data, rectilinear and structured grids, and
+  // poly data and unstructured grids with the legacy cell storage, and
+  // point data that cannot be matched to cell data arrays by name, are
+  // always processed serially.
+  vtkSetClampMacro(NumberOfThreads,int,1,VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads,int);
+
 protected:
   vtkPointDataToCellData();
-  ~vtkPointDataToCellData() {};
+  ~vtkPointDataToCellData();
 
   virtual int RequestData(vtkInformation* request,
                           vtkInformationVector** inputVector,
                           vtkInformationVector* outputVector);
 
   int PassPointData;
+  int NumberOfThreads;
+  vtkMultiThreader *Threader;
+
 private:
   vtkPointDataToCellData(const vtkPointDataToCellData&);  // Not implemented.
   void operator=(const vtkPointDataToCellData&);  // Not implemented.
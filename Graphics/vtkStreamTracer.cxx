@@ -34,6 +34,8 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkCellLocatorInterpolatedVelocityField.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
@@ -44,6 +46,8 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkRungeKutta45.h"
 #include "vtkSmartPointer.h"
 
+#include <vtkstd/vector>
+
 vtkStandardNewMacro(vtkStreamTracer);
 vtkCxxSetObjectMacro(vtkStreamTracer,Integrator,vtkInitialValueProblemSolver);
 vtkCxxSetObjectMacro(vtkStreamTracer,InterpolatorPrototype,vtkAbstractInterpolatedVelocityField);
@@ -75,6 +79,9 @@ vtkStreamTracer::vtkStreamTracer()
   this->LastUsedStepSize = 0.0;
 
   this->GenerateNormalsInIntegrate = true;
+  this->UpdateProgressInIntegrate = true;
+
+  this->NumberOfThreads = 1;
 
   this->InterpolatorPrototype = 0;
 
@@ -458,14 +465,24 @@ int vtkStreamTracer::RequestData(
     if (vectors)
       {
       const char *vecName = vectors->GetName();
-      double propagation = 0;
-      vtkIdType numSteps = 0;
-      this->Integrate(input0, output,
-                      seeds, seedIds,
-                      integrationDirections,
-                      lastPoint, func,
-                      maxCellSize, vecName,
-                      propagation, numSteps);
+      if (this->NumberOfThreads > 1 && seedIds->GetNumberOfIds() > 1)
+        {
+        this->ThreadedIntegrate(input0, output,
+                                seeds, seedIds,
+                                integrationDirections,
+                                maxCellSize, vecName);
+        }
+      else
+        {
+        double propagation = 0;
+        vtkIdType numSteps = 0;
+        this->Integrate(input0, output,
+                        seeds, seedIds,
+                        integrationDirections,
+                        lastPoint, func,
+                        maxCellSize, vecName,
+                        propagation, numSteps);
+        }
       }
     func->Delete();
     seeds->Delete();
@@ -670,7 +687,10 @@ void vtkStreamTracer::Integrate(vtkDataSet *input0,
     {
 
     double progress = static_cast<double>(currentLine)/numLines;
-    this->UpdateProgress(progress);
+    if (this->UpdateProgressInIntegrate)
+      {
+      this->UpdateProgress(progress);
+      }
 
     switch (integrationDirections->GetValue(currentLine))
       {
@@ -780,7 +800,7 @@ void vtkStreamTracer::Integrate(vtkDataSet *input0,
         break;
         }
 
-      if ( numSteps++ % 1000 == 1 )
+      if ( numSteps++ % 1000 == 1 && this->UpdateProgressInIntegrate )
         {
         progress =
           ( currentLine + propagation / this->MaximumPropagation ) / numLines;
@@ -817,7 +837,11 @@ void vtkStreamTracer::Integrate(vtkDataSet *input0,
           }
         maxStep = stepSize.Interval;
         }
-      this->LastUsedStepSize = stepSize.Interval;
+      // Only one thread may keep the step size of the filter.
+      if ( this->UpdateProgressInIntegrate )
+        {
+        this->LastUsedStepSize = stepSize.Interval;
+        }
 
       // Calculate the next step using the integrator provided
       // Break if the next point is out of bounds.
@@ -1020,6 +1044,317 @@ void vtkStreamTracer::Integrate(vtkDataSet *input0,
   return;
 }
 
+//----------------------------------------------------------------------------
+// Integrates blocks of consecutive seeds on several threads. Each thread
+// takes the next block from a shared counter and integrates it with its
+// own interpolator into the polydata of the block, so that the blocks can
+// be appended to the output in the order of the seeds.
+class vtkStreamTracerThreads
+{
+public:
+  vtkStreamTracer* Self;
+  vtkDataSet* Input0;
+  vtkDataArray* Seeds;
+  vtkIdList* SeedIds;
+  vtkIntArray* IntegrationDirections;
+  int MaxCellSize;
+  const char* VecName;
+  vtkstd::vector<vtkAbstractInterpolatedVelocityField*> Funcs;
+  vtkstd::vector<vtkPolyData*> Blocks;
+  vtkIdType BlockSize;
+  vtkIdType NextBlock;
+  vtkIdType FinishedBlocks;
+  int Abort;
+  vtkSimpleMutexLock Lock;
+
+  static VTK_THREAD_RETURN_TYPE Execute(void* arg)
+    {
+    vtkMultiThreader::ThreadInfo* info =
+      static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    static_cast<vtkStreamTracerThreads*>(info->UserData)->IntegrateBlocks(
+      info->ThreadID);
+    return VTK_THREAD_RETURN_VALUE;
+    }
+
+  void IntegrateBlocks(int threadId)
+    {
+    vtkIdType numLines = this->SeedIds->GetNumberOfIds();
+    vtkIdType numBlocks = static_cast<vtkIdType>(this->Blocks.size());
+    vtkIdList* seedIds = vtkIdList::New();
+    vtkIntArray* integrationDirections = vtkIntArray::New();
+    double lastPoint[3];
+    for (;;)
+      {
+      this->Lock.Lock();
+      vtkIdType block = this->Abort ? numBlocks : this->NextBlock++;
+      this->Lock.Unlock();
+      if (block >= numBlocks)
+        {
+        break;
+        }
+
+      vtkIdType first = block*this->BlockSize;
+      vtkIdType last = first + this->BlockSize;
+      if (last > numLines)
+        {
+        last = numLines;
+        }
+      seedIds->SetNumberOfIds(last - first);
+      integrationDirections->SetNumberOfTuples(last - first);
+      for (vtkIdType i = first; i < last; i++)
+        {
+        seedIds->SetId(i - first, this->SeedIds->GetId(i));
+        integrationDirections->SetValue(
+          i - first, this->IntegrationDirections->GetValue(i));
+        }
+
+      double propagation = 0;
+      vtkIdType numSteps = 0;
+      this->Self->Integrate(this->Input0, this->Blocks[block],
+                            this->Seeds, seedIds,
+                            integrationDirections,
+                            lastPoint, this->Funcs[threadId],
+                            this->MaxCellSize, this->VecName,
+                            propagation, numSteps);
+
+      this->Lock.Lock();
+      vtkIdType finished = ++this->FinishedBlocks;
+      this->Lock.Unlock();
+
+      // Only the calling thread reports progress and checks for abort.
+      if (threadId == 0)
+        {
+        this->Self->UpdateProgress(static_cast<double>(finished)/numBlocks);
+        if (this->Self->GetAbortExecute())
+          {
+          this->Lock.Lock();
+          this->Abort = 1;
+          this->Lock.Unlock();
+          }
+        }
+      }
+    seedIds->Delete();
+    integrationDirections->Delete();
+    }
+};
+
+//----------------------------------------------------------------------------
+// The datasets build their point locators, cell links and bounds when they
+// are first searched. Build them before the threads share the dataset.
+static void vtkStreamTracerPrepareSearch(vtkDataSet* ds, int maxCellSize)
+{
+  if (ds->GetNumberOfPoints() < 1 || ds->GetNumberOfCells() < 1 ||
+      maxCellSize < 1)
+    {
+    return;
+    }
+  ds->GetLength();
+
+  vtkIdList* cellIds = vtkIdList::New();
+  ds->GetPointCells(0, cellIds);
+  cellIds->Delete();
+
+  double x[3], pcoords[3];
+  int subId;
+  double* weights = new double[maxCellSize];
+  vtkGenericCell* cell = vtkGenericCell::New();
+  ds->GetPoint(0, x);
+  ds->FindCell(x, 0, cell, -1, 0.0, subId, pcoords, weights);
+  cell->Delete();
+  delete[] weights;
+}
+
+void vtkStreamTracer::ThreadedIntegrate(vtkDataSet *input0,
+                                        vtkPolyData* output,
+                                        vtkDataArray* seedSource,
+                                        vtkIdList* seedIds,
+                                        vtkIntArray* integrationDirections,
+                                        int maxCellSize,
+                                        const char *vecName)
+{
+  vtkIdType numLines = seedIds->GetNumberOfIds();
+  int numThreads = this->NumberOfThreads;
+  if (numThreads > numLines)
+    {
+    numThreads = static_cast<int>(numLines);
+    }
+
+  if (this->GetIntegrator() == 0)
+    {
+    vtkErrorMacro("No integrator is specified.");
+    return;
+    }
+
+  vtkStreamTracerThreads threads;
+  threads.Self = this;
+  threads.Input0 = input0;
+  threads.Seeds = seedSource;
+  threads.SeedIds = seedIds;
+  threads.IntegrationDirections = integrationDirections;
+  threads.MaxCellSize = maxCellSize;
+  threads.VecName = vecName;
+
+  // Each thread interpolates with its own copy of the velocity field,
+  // as the interpolators cache the last cell found.
+  int i;
+  for (i = 0; i < numThreads; i++)
+    {
+    vtkAbstractInterpolatedVelocityField* func = 0;
+    int cellSize = 0;
+    if (this->CheckInputs(func, &cellSize) != VTK_OK)
+      {
+      if (func)
+        {
+        func->Delete();
+        }
+      break;
+      }
+    threads.Funcs.push_back(func);
+    }
+  numThreads = static_cast<int>(threads.Funcs.size());
+  if (numThreads == 0)
+    {
+    return;
+    }
+
+  // Locate cells in shared search structures built up front.
+  vtkCellLocatorInterpolatedVelocityField* cellLocFunc =
+    vtkCellLocatorInterpolatedVelocityField::SafeDownCast(threads.Funcs[0]);
+  for (i = 1; cellLocFunc && i < numThreads; i++)
+    {
+    vtkCellLocatorInterpolatedVelocityField::SafeDownCast(threads.Funcs[i])
+      ->ShareCellLocators(cellLocFunc);
+    }
+  vtkCompositeDataIterator* iter = this->InputData->NewIterator();
+  for (iter->GoToFirstItem(); !iter->IsDoneWithTraversal();
+       iter->GoToNextItem())
+    {
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    if (ds)
+      {
+      vtkStreamTracerPrepareSearch(ds, maxCellSize);
+      }
+    }
+  iter->Delete();
+
+  // Small blocks keep the threads busy when some streamlines take much
+  // longer than others.
+  vtkIdType numBlocks = 8*numThreads;
+  threads.BlockSize = (numLines + numBlocks - 1)/numBlocks;
+  numBlocks = (numLines + threads.BlockSize - 1)/threads.BlockSize;
+  threads.Blocks.resize(numBlocks);
+  vtkIdType block;
+  for (block = 0; block < numBlocks; block++)
+    {
+    threads.Blocks[block] = vtkPolyData::New();
+    }
+  threads.NextBlock = 0;
+  threads.FinishedBlocks = 0;
+  threads.Abort = 0;
+
+  // The normals are generated once the streamlines have been appended.
+  bool generateNormals = this->GenerateNormalsInIntegrate;
+  bool updateProgress = this->UpdateProgressInIntegrate;
+  this->GenerateNormalsInIntegrate = false;
+  this->UpdateProgressInIntegrate = false;
+
+  vtkMultiThreader* threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(numThreads);
+  threader->SetSingleMethod(vtkStreamTracerThreads::Execute, &threads);
+  threader->SingleMethodExecute();
+  threader->Delete();
+
+  this->GenerateNormalsInIntegrate = generateNormals;
+  this->UpdateProgressInIntegrate = updateProgress;
+
+  if (!threads.Abort)
+    {
+    // Append the blocks in the order of the seeds.
+    vtkIdType numPts = 0;
+    vtkDataSetAttributes::FieldList ptList(static_cast<int>(numBlocks));
+    for (block = 0; block < numBlocks; block++)
+      {
+      vtkPointData* blockPD = threads.Blocks[block]->GetPointData();
+      if (block == 0)
+        {
+        ptList.InitializeFieldList(blockPD);
+        }
+      else
+        {
+        ptList.IntersectFieldList(blockPD);
+        }
+      numPts += threads.Blocks[block]->GetNumberOfPoints();
+      }
+
+    vtkPoints* outputPoints = vtkPoints::New();
+    outputPoints->SetNumberOfPoints(numPts);
+    vtkCellArray* outputLines = vtkCellArray::New();
+    vtkIntArray* retVals = vtkIntArray::New();
+    retVals->SetName("ReasonForTermination");
+    vtkPointData* outputPD = output->GetPointData();
+    outputPD->CopyAllocate(ptList, numPts);
+
+    vtkIdType offset = 0;
+    for (block = 0; block < numBlocks; block++)
+      {
+      vtkPolyData* blockOutput = threads.Blocks[block];
+      vtkPointData* blockPD = blockOutput->GetPointData();
+      vtkIdType blockPts = blockOutput->GetNumberOfPoints();
+      for (vtkIdType ptId = 0; ptId < blockPts; ptId++)
+        {
+        outputPoints->SetPoint(offset + ptId, blockOutput->GetPoint(ptId));
+        outputPD->CopyData(ptList, blockPD, static_cast<int>(block),
+                           ptId, offset + ptId);
+        }
+
+      vtkCellArray* blockLines = blockOutput->GetLines();
+      vtkIdType npts, *pts;
+      for (blockLines->InitTraversal(); blockLines->GetNextCell(npts, pts); )
+        {
+        outputLines->InsertNextCell(static_cast<int>(npts));
+        for (vtkIdType j = 0; j < npts; j++)
+          {
+          outputLines->InsertCellPoint(offset + pts[j]);
+          }
+        }
+
+      vtkDataArray* blockRetVals =
+        blockOutput->GetCellData()->GetArray("ReasonForTermination");
+      for (vtkIdType j = 0; blockRetVals && j < blockRetVals->GetNumberOfTuples();
+           j++)
+        {
+        retVals->InsertNextValue(static_cast<int>(blockRetVals->GetTuple1(j)));
+        }
+      offset += blockPts;
+      }
+
+    output->SetPoints(outputPoints);
+    if (numPts > 1)
+      {
+      output->SetLines(outputLines);
+      if (this->GenerateNormalsInIntegrate)
+        {
+        this->GenerateNormals(output, 0, vecName);
+        }
+      output->GetCellData()->AddArray(retVals);
+      }
+    outputPoints->Delete();
+    outputLines->Delete();
+    retVals->Delete();
+    }
+
+  for (block = 0; block < numBlocks; block++)
+    {
+    threads.Blocks[block]->Delete();
+    }
+  for (i = 0; i < numThreads; i++)
+    {
+    threads.Funcs[i]->Delete();
+    }
+
+  output->Squeeze();
+}
+
 void vtkStreamTracer::GenerateNormals(vtkPolyData* output, double* firstNormal,
                                       const char *vecName)
 {
@@ -1230,6 +1565,7 @@ void vtkStreamTracer::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Vorticity computation: "
      << (this->ComputeVorticity ? " On" : " Off") << endl;
   os << indent << "Rotation scale: " << this->RotationScale << endl;
+  os << indent << "Number of threads: " << this->NumberOfThreads << endl;
 }
 
 vtkExecutive* vtkStreamTracer::CreateDefaultExecutive()
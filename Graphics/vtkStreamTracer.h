@@ -296,6 +296,15 @@ public:
   // vtkPointSet::FindCell() coupled with vtkPointLocator).
   void SetInterpolatorType( int interpType );
 
+  // Description:
+  // Set/get the number of threads used to integrate the streamlines.
+  // With more than one thread, blocks of seeds are integrated
+  // concurrently, each thread with its own copy of the velocity field
+  // interpolator, and the streamlines are appended to the output in the
+  // order of the seeds as with one thread. The default is 1.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
 protected:
 
   vtkStreamTracer();
@@ -324,6 +333,13 @@ protected:
                  const char *vecFieldName,
                  double& propagation,
                  vtkIdType& numSteps);
+  void ThreadedIntegrate(vtkDataSet *input,
+                         vtkPolyData* output,
+                         vtkDataArray* seedSource,
+                         vtkIdList* seedIds,
+                         vtkIntArray* integrationDirections,
+                         int maxCellSize,
+                         const char *vecName);
   void SimpleIntegrate(double seed[3],
                        double lastPoint[3],
                        double stepSize,
@@ -334,6 +350,10 @@ protected:
 
   bool GenerateNormalsInIntegrate;
 
+  // Integrate() reports progress, checks for abort and keeps
+  // LastUsedStepSize unless it runs on several threads at once.
+  bool UpdateProgressInIntegrate;
+
   // starting from global x-y-z position
   double StartPosition[3];
 
@@ -384,6 +404,12 @@ protected:
 
   vtkCompositeDataSet* InputData;
 
+  int NumberOfThreads;
+
+//BTX
+  friend class vtkStreamTracerThreads;
+//ETX
+
 private:
   vtkStreamTracer(const vtkStreamTracer&);  // Not implemented.
   void operator=(const vtkStreamTracer&);  // Not implemented.
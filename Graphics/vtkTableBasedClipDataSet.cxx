@@ -57,6 +57,8 @@
 #include "vtkRectilinearGrid.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkGenericCell.h"
+#include "vtkMultiThreader.h"
+#include "vtkIdList.h"
 
 #include "vtkTableBasedClipCases.h"
 
@@ -71,7 +73,7 @@ vtkCxxSetObjectMacro( vtkTableBasedClipDataSet, ClipFunction, vtkImplicitFunctio
 
 struct TableBasedClipperPointEntry
 {
-  int      ptIds[2];
+  vtkIdType ptIds[2];
   double   percent;
 };
 
@@ -83,10 +85,10 @@ public:
   vtkTableBasedClipperPointList();
   virtual ~vtkTableBasedClipperPointList();
 
-  int      AddPoint( int, int, double );
-  int      GetTotalNumberOfPoints() const;
-  int      GetNumberOfLists() const;
-  int      GetList( int, const TableBasedClipperPointEntry *& ) const;
+  vtkIdType AddPoint( vtkIdType, vtkIdType, double );
+  vtkIdType GetTotalNumberOfPoints() const;
+  int       GetNumberOfLists() const;
+  int       GetList( int, const TableBasedClipperPointEntry *& ) const;
 
 protected:
   int      currentList;
@@ -105,17 +107,17 @@ public:
   vtkTableBasedClipperEdgeHashEntry();
   virtual ~vtkTableBasedClipperEdgeHashEntry() { }
 
-  int      GetPointId(void) { return ptId; };
-  void     SetInfo( int, int, int );
+  vtkIdType GetPointId(void) { return ptId; };
+  void     SetInfo( vtkIdType, vtkIdType, vtkIdType );
   void     SetNext( vtkTableBasedClipperEdgeHashEntry * n ) { next = n; };
-  bool     IsMatch( int i1, int i2 )
+  bool     IsMatch( vtkIdType i1, vtkIdType i2 )
            { return ( i1 == id1 && i2 == id2 ? true : false ); };
   
   vtkTableBasedClipperEdgeHashEntry * GetNext() { return next; }
 
 protected:
-  int             id1, id2;
-  int             ptId;
+  vtkIdType       id1, id2;
+  vtkIdType       ptId;
   vtkTableBasedClipperEdgeHashEntry * next;
 
 };
@@ -169,7 +171,7 @@ public:
   vtkTableBasedClipperEdgeHashTable( int, vtkTableBasedClipperPointList & );
   virtual ~vtkTableBasedClipperEdgeHashTable();
 
-  int         AddPoint( int, int, double );
+  vtkIdType   AddPoint( vtkIdType, vtkIdType, double );
   vtkTableBasedClipperPointList & GetPointList( );
 
 protected:
@@ -178,7 +180,7 @@ protected:
   vtkTableBasedClipperEdgeHashEntry  ** hashes;
   vtkTableBasedClipperEdgeHashEntryMemoryManager  emm;
   
-  int GetKey( int, int );
+  int GetKey( vtkIdType, vtkIdType );
   
   private:
   vtkTableBasedClipperEdgeHashTable
@@ -192,14 +194,14 @@ class  vtkTableBasedClipperDataSetFromVolume
 {
   public:
     vtkTableBasedClipperDataSetFromVolume( int ptSizeGuess );
-    vtkTableBasedClipperDataSetFromVolume( int nPts, int ptSizeGuess );
+    vtkTableBasedClipperDataSetFromVolume( vtkIdType nPts, int ptSizeGuess );
     virtual ~vtkTableBasedClipperDataSetFromVolume() { }
     
-    int  AddPoint( int p1, int p2, double percent )
-         { return numPrevPts + edges.AddPoint( p1, p2, percent ); }
+    vtkIdType AddPoint( vtkIdType p1, vtkIdType p2, double percent )
+              { return numPrevPts + edges.AddPoint( p1, p2, percent ); }
 
   protected:
-    int           numPrevPts;
+    vtkIdType     numPrevPts;
     vtkTableBasedClipperPointList      pt_list;
     vtkTableBasedClipperEdgeHashTable  edges;
     
@@ -261,15 +263,16 @@ int vtkTableBasedClipperPointList::GetNumberOfLists() const
   return currentList + 1;
 }
  
-int vtkTableBasedClipperPointList::GetTotalNumberOfPoints() const
+vtkIdType vtkTableBasedClipperPointList::GetTotalNumberOfPoints() const
 {
-  int numFullLists = currentList;   // actually currentList-1+1
-  int numExtra     = currentPoint;  // again, currentPoint-1+1
+  vtkIdType numFullLists = currentList;   // actually currentList-1+1
+  vtkIdType numExtra     = currentPoint;  // again, currentPoint-1+1
  
   return numFullLists * pointsPerList + numExtra;
 }
 
-int vtkTableBasedClipperPointList::AddPoint( int pt0, int pt1, double percent )
+vtkIdType vtkTableBasedClipperPointList::AddPoint
+  ( vtkIdType pt0, vtkIdType pt1, double percent )
 {
   if ( currentPoint >= pointsPerList )
     {
@@ -313,7 +316,8 @@ vtkTableBasedClipperEdgeHashEntry::vtkTableBasedClipperEdgeHashEntry()
     next = NULL;
 }
   
-void vtkTableBasedClipperEdgeHashEntry::SetInfo( int i1, int i2, int pId )
+void vtkTableBasedClipperEdgeHashEntry::SetInfo
+  ( vtkIdType i1, vtkIdType i2, vtkIdType pId )
 {
     id1  = i1;
     id2  = i2;
@@ -372,24 +376,21 @@ vtkTableBasedClipperEdgeHashTable::~vtkTableBasedClipperEdgeHashTable()
     delete [] hashes;
 }
  
-int vtkTableBasedClipperEdgeHashTable::GetKey( int p1, int p2 )
+int vtkTableBasedClipperEdgeHashTable::GetKey( vtkIdType p1, vtkIdType p2 )
 {
-  int rv = (  ( p1 * 18457 + p2 * 234749 ) % nHashes  );
+  // Hash in unsigned arithmetic, which wraps around instead of overflowing
+  // with large point ids (and avoids modulo with negative numbers).
+  vtkTypeUInt64 key = static_cast< vtkTypeUInt64 > ( p1 ) * 18457 + 
+                      static_cast< vtkTypeUInt64 > ( p2 ) * 234749;
  
-  // In case of overflows and modulo with negative numbers.
-  if ( rv < 0 )
-    {
-    rv += nHashes;
-    }
- 
-  return rv;
+  return static_cast< int > (  key % static_cast< vtkTypeUInt64 > ( nHashes )  );
 }
 
-int vtkTableBasedClipperEdgeHashTable::AddPoint
-  ( int ap1, int ap2, double apercent )
+vtkIdType vtkTableBasedClipperEdgeHashTable::AddPoint
+  ( vtkIdType ap1, vtkIdType ap2, double apercent )
 {
-  int    p1, p2;
-  double percent;
+  vtkIdType p1, p2;
+  double    percent;
   
   if ( ap2 < ap1 )
     {
@@ -428,7 +429,7 @@ int vtkTableBasedClipperEdgeHashTable::AddPoint
   //
   vtkTableBasedClipperEdgeHashEntry * new_one = emm.GetFreeEdgeHashEntry();
  
-  int newPt = pointlist.AddPoint( p1, p2, percent );
+  vtkIdType newPt = pointlist.AddPoint( p1, p2, percent );
   new_one->SetInfo( p1, p2, newPt );
   new_one->SetNext(  hashes[ key ]  );
   hashes[key] = new_one;
@@ -443,7 +444,7 @@ vtkTableBasedClipperDataSetFromVolume( int ptSizeGuess )
 }
       
 vtkTableBasedClipperDataSetFromVolume::
-vtkTableBasedClipperDataSetFromVolume( int nPts, int ptSizeGuess )
+vtkTableBasedClipperDataSetFromVolume( vtkIdType nPts, int ptSizeGuess )
    : numPrevPts( nPts ), pt_list(), edges( ptSizeGuess, pt_list )
 {
 }
@@ -464,11 +465,12 @@ class vtkTableBasedClipperShapeList
     virtual       ~vtkTableBasedClipperShapeList();
     virtual int    GetVTKType() const = 0;
     int            GetShapeSize() const { return shapeSize; }
-    int            GetTotalNumberOfShapes() const;
+    vtkIdType      GetTotalNumberOfShapes() const;
     int            GetNumberOfLists() const;
-    int            GetList(int, const int *& ) const;
+    int            GetList( int, const vtkIdType *& ) const;
+    void           AddShape( const vtkIdType * );
   protected:
-    int         ** list;
+    vtkIdType   ** list;
     int            currentList;
     int            currentShape;
     int            listSize;
@@ -483,7 +485,8 @@ class vtkTableBasedClipperHexList : public vtkTableBasedClipperShapeList
                    vtkTableBasedClipperHexList();
     virtual       ~vtkTableBasedClipperHexList();
     virtual int    GetVTKType() const { return VTK_HEXAHEDRON; }
-    void           AddHex( int, int, int, int, int, int, int, int, int );
+    void           AddHex( vtkIdType, vtkIdType, vtkIdType, vtkIdType, vtkIdType,
+                           vtkIdType, vtkIdType, vtkIdType, vtkIdType );
 };
 
 
@@ -493,7 +496,8 @@ class vtkTableBasedClipperWedgeList : public vtkTableBasedClipperShapeList
                    vtkTableBasedClipperWedgeList();
     virtual       ~vtkTableBasedClipperWedgeList();
     virtual int    GetVTKType() const { return VTK_WEDGE; }
-    void           AddWedge( int, int, int, int, int, int, int );
+    void           AddWedge( vtkIdType, vtkIdType, vtkIdType, vtkIdType,
+                             vtkIdType, vtkIdType, vtkIdType );
 };
 
 
@@ -503,7 +507,8 @@ class vtkTableBasedClipperPyramidList : public vtkTableBasedClipperShapeList
                    vtkTableBasedClipperPyramidList();
     virtual       ~vtkTableBasedClipperPyramidList();
     virtual int    GetVTKType() const { return VTK_PYRAMID; }
-    void           AddPyramid( int, int, int, int, int, int );
+    void           AddPyramid( vtkIdType, vtkIdType, vtkIdType, 
+                               vtkIdType, vtkIdType, vtkIdType );
 };
 
 
@@ -513,7 +518,8 @@ class vtkTableBasedClipperTetList : public vtkTableBasedClipperShapeList
                    vtkTableBasedClipperTetList();
     virtual       ~vtkTableBasedClipperTetList();
     virtual int    GetVTKType() const { return VTK_TETRA; }
-    void           AddTet( int, int, int, int, int );
+    void           AddTet( vtkIdType, vtkIdType, vtkIdType, 
+                           vtkIdType, vtkIdType );
 };
 
 
@@ -523,7 +529,8 @@ class vtkTableBasedClipperQuadList : public vtkTableBasedClipperShapeList
                    vtkTableBasedClipperQuadList();
     virtual       ~vtkTableBasedClipperQuadList();
     virtual int    GetVTKType() const { return VTK_QUAD; }
-    void           AddQuad( int, int, int, int, int );
+    void           AddQuad( vtkIdType, vtkIdType, vtkIdType, 
+                            vtkIdType, vtkIdType );
 };
 
 
@@ -533,7 +540,7 @@ class vtkTableBasedClipperTriList : public vtkTableBasedClipperShapeList
                    vtkTableBasedClipperTriList();
     virtual       ~vtkTableBasedClipperTriList();
     virtual int    GetVTKType() const { return VTK_TRIANGLE; }
-    void           AddTri( int, int, int, int );
+    void           AddTri( vtkIdType, vtkIdType, vtkIdType, vtkIdType );
 };
 
 
@@ -543,7 +550,7 @@ class vtkTableBasedClipperLineList : public vtkTableBasedClipperShapeList
                    vtkTableBasedClipperLineList();
     virtual       ~vtkTableBasedClipperLineList();
     virtual int    GetVTKType() const { return VTK_LINE; }
-    void           AddLine( int, int, int );
+    void           AddLine( vtkIdType, vtkIdType, vtkIdType );
 };
 
 
@@ -553,14 +560,14 @@ class vtkTableBasedClipperVertexList : public vtkTableBasedClipperShapeList
                    vtkTableBasedClipperVertexList();
     virtual       ~vtkTableBasedClipperVertexList();
     virtual int    GetVTKType() const { return VTK_VERTEX; }
-    void           AddVertex( int, int );
+    void           AddVertex( vtkIdType, vtkIdType );
 };
 
 
 struct TableBasedClipperCentroidPointEntry
 {
-  int  nPts;
-  int  ptIds[8];
+  int        nPts;
+  vtkIdType  ptIds[8];
 };
 
 
@@ -570,9 +577,9 @@ class vtkTableBasedClipperCentroidPointList
                    vtkTableBasedClipperCentroidPointList();
     virtual       ~vtkTableBasedClipperCentroidPointList();
  
-    int            AddPoint(int, int*);
+    vtkIdType      AddPoint( int, vtkIdType * );
  
-    int            GetTotalNumberOfPoints() const;
+    vtkIdType      GetTotalNumberOfPoints() const;
     int            GetNumberOfLists() const;
     int            GetList( int, 
                    const TableBasedClipperCentroidPointEntry *& ) const;
@@ -602,7 +609,7 @@ class  vtkTableBasedClipperVolumeFromVolume :
 {
   public:
               vtkTableBasedClipperVolumeFromVolume
-              ( int nPts, int ptSizeGuess );
+              ( vtkIdType nPts, int ptSizeGuess );
     virtual  ~vtkTableBasedClipperVolumeFromVolume() { }
 
     void      ConstructDataSet( vtkPointData *, vtkCellData *,
@@ -611,28 +618,38 @@ class  vtkTableBasedClipperVolumeFromVolume :
                                 vtkUnstructuredGrid *, int *, double *,
                                 double *, double * );
 
-    int      AddCentroidPoint( int n, int * p )
-             { return -1 - centroid_list.AddPoint( n, p ); }
+    vtkIdType AddCentroidPoint( int n, vtkIdType * p )
+              { return -1 - centroid_list.AddPoint( n, p ); }
 
-    void     AddHex( int z,  int v0, int v1, int v2, int v3,
-                     int v4, int v5, int v6, int v7 )
+    void     AddHex( vtkIdType z,  vtkIdType v0, vtkIdType v1, vtkIdType v2,
+                     vtkIdType v3, vtkIdType v4, vtkIdType v5, vtkIdType v6,
+                     vtkIdType v7 )
              { this->hexes.AddHex( z, v0, v1, v2, v3, v4, v5, v6, v7 ); }
         
-    void     AddWedge( int z,int v0,int v1,int v2,int v3,int v4,int v5 )
+    void     AddWedge( vtkIdType z,  vtkIdType v0, vtkIdType v1, vtkIdType v2,
+                       vtkIdType v3, vtkIdType v4, vtkIdType v5 )
              { this->wedges.AddWedge( z, v0, v1, v2, v3, v4, v5 ); }
-    void     AddPyramid( int z, int v0, int v1, int v2, int v3, int v4 )
+    void     AddPyramid( vtkIdType z,  vtkIdType v0, vtkIdType v1, 
+                         vtkIdType v2, vtkIdType v3, vtkIdType v4 )
              { this->pyramids.AddPyramid( z, v0, v1, v2, v3, v4 ); }
-    void     AddTet( int z, int v0, int v1, int v2, int v3 )
+    void     AddTet( vtkIdType z,  vtkIdType v0, vtkIdType v1, 
+                     vtkIdType v2, vtkIdType v3 )
              { this->tets.AddTet( z, v0, v1, v2, v3 ); }
-    void     AddQuad( int z, int v0, int v1, int v2, int v3 )
+    void     AddQuad( vtkIdType z,  vtkIdType v0, vtkIdType v1, 
+                      vtkIdType v2, vtkIdType v3 )
              { this->quads.AddQuad( z, v0, v1, v2, v3 ); }
-    void     AddTri( int z, int v0, int v1, int v2 )
+    void     AddTri( vtkIdType z, vtkIdType v0, vtkIdType v1, vtkIdType v2 )
              { this->tris.AddTri( z, v0, v1, v2 ); }
-    void     AddLine( int z, int v0, int v1 )
+    void     AddLine( vtkIdType z, vtkIdType v0, vtkIdType v1 )
              { this->lines.AddLine( z, v0, v1 ); }
-    void     AddVertex(int z, int v0)
+    void     AddVertex( vtkIdType z, vtkIdType v0 )
              { this->vertices.AddVertex( z, v0 ); }
 
+    // Append the points and shapes of another container, which must have been
+    // built for the same input points, to this one. Edge points shared by both
+    // are merged via the edge hash table of this container.
+    void     Merge( const vtkTableBasedClipperVolumeFromVolume & );
+
   protected:
     vtkTableBasedClipperCentroidPointList centroid_list;
     vtkTableBasedClipperHexList     hexes;
@@ -647,6 +664,14 @@ class  vtkTableBasedClipperVolumeFromVolume :
     vtkTableBasedClipperShapeList * shapes[8];
     const int    nshapes;
 
+    // Input points keep their ids upon Merge(), whereas edge points and
+    // centroid points are re-mapped to those of this container.
+    vtkIdType    MergedPointId( vtkIdType id, const vtkIdType * edgeMaps, 
+                                vtkIdType centroidOffset ) const
+                 { return (  id < 0  ?  id - centroidOffset  :
+                          (  id >= numPrevPts  ?  
+                             numPrevPts + edgeMaps[ id - numPrevPts ]  :  id  )  ); }
+
     void         ConstructDataSet
                  ( vtkPointData *, vtkCellData *, vtkUnstructuredGrid *, 
                    TableBasedClipperCommonPointsStructure & );
@@ -654,7 +679,7 @@ class  vtkTableBasedClipperVolumeFromVolume :
 
 
 vtkTableBasedClipperVolumeFromVolume::
-vtkTableBasedClipperVolumeFromVolume( int nPts, int ptSizeGuess )
+vtkTableBasedClipperVolumeFromVolume( vtkIdType nPts, int ptSizeGuess )
     : vtkTableBasedClipperDataSetFromVolume( nPts, ptSizeGuess ), nshapes( 8 )
 {
   shapes[0] = &tets;
@@ -718,15 +743,16 @@ int  vtkTableBasedClipperCentroidPointList::GetNumberOfLists() const
     return currentList + 1;
 }
  
-int  vtkTableBasedClipperCentroidPointList::GetTotalNumberOfPoints() const
+vtkIdType vtkTableBasedClipperCentroidPointList::GetTotalNumberOfPoints() const
 {
-  int numFullLists = currentList;  // actually currentList-1+1
-  int numExtra     = currentPoint; // again, currentPoint-1+1
+  vtkIdType numFullLists = currentList;  // actually currentList-1+1
+  vtkIdType numExtra     = currentPoint; // again, currentPoint-1+1
  
   return numFullLists * pointsPerList + numExtra;
 }
 
-int  vtkTableBasedClipperCentroidPointList::AddPoint( int npts, int * pts )
+vtkIdType vtkTableBasedClipperCentroidPointList::AddPoint
+  ( int npts, vtkIdType * pts )
 {
   if ( currentPoint >= pointsPerList )
     {
@@ -772,8 +798,8 @@ vtkTableBasedClipperShapeList::vtkTableBasedClipperShapeList( int size )
   listSize      = 4096;
   shapesPerList = 1024;
  
-  list    = new int * [ listSize ];
-  list[0] = new int[  ( shapeSize + 1 ) * shapesPerList  ];
+  list    = new vtkIdType * [ listSize ];
+  list[0] = new vtkIdType[  ( shapeSize + 1 ) * shapesPerList  ];
   
   for ( int i = 1; i < listSize; i ++ )
     {
@@ -802,7 +828,7 @@ vtkTableBasedClipperShapeList::~vtkTableBasedClipperShapeList()
 }
  
 int  vtkTableBasedClipperShapeList::GetList
-   ( int listId, const int *& outlist ) const
+   ( int listId, const vtkIdType *& outlist ) const
 {
   if ( listId < 0 || listId > currentList )
     {
@@ -819,14 +845,50 @@ int  vtkTableBasedClipperShapeList::GetNumberOfLists() const
     return currentList + 1;
 }
 
-int  vtkTableBasedClipperShapeList::GetTotalNumberOfShapes() const
+vtkIdType vtkTableBasedClipperShapeList::GetTotalNumberOfShapes() const
 {
-  int numFullLists = currentList;  // actually currentList-1+1
-  int numExtra     = currentShape; // again, currentShape-1+1
+  vtkIdType numFullLists = currentList;  // actually currentList-1+1
+  vtkIdType numExtra     = currentShape; // again, currentShape-1+1
  
   return numFullLists * shapesPerList + numExtra;
 }
 
+void vtkTableBasedClipperShapeList::AddShape( const vtkIdType * shape )
+{
+  if ( currentShape >= shapesPerList )
+    {
+    if (  ( currentList + 1 )  >=  listSize  )
+      {
+      vtkIdType ** tmpList = new vtkIdType * [ 2 * listSize ];
+      for ( int i = 0; i < listSize; i ++ )
+        {
+        tmpList[i] = list[i];
+        }
+          
+      for ( int i = listSize; i < listSize * 2; i ++ )
+        {
+        tmpList[i] = NULL;
+        }
+          
+      listSize *= 2;
+      delete [] list;
+      list = tmpList;
+      }
+ 
+    currentList ++;
+    list[ currentList ] = new vtkIdType[  ( shapeSize + 1 ) * shapesPerList  ];
+    currentShape = 0;
+    }
+ 
+  // the cell id followed by the point ids
+  int idx = ( shapeSize + 1 ) * currentShape;
+  for ( int i = 0; i <= shapeSize; i ++ )
+    {
+    list[ currentList ][ idx + i ] = shape[i];
+    }
+  currentShape ++;
+}
+
 vtkTableBasedClipperHexList::vtkTableBasedClipperHexList()
     : vtkTableBasedClipperShapeList( 8 )
 {
@@ -836,14 +898,15 @@ vtkTableBasedClipperHexList::~vtkTableBasedClipperHexList()
 {
 }
 
-void vtkTableBasedClipperHexList::AddHex( int cellId, 
-     int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8 )
+void vtkTableBasedClipperHexList::AddHex( vtkIdType cellId, 
+     vtkIdType v1, vtkIdType v2, vtkIdType v3, vtkIdType v4, 
+     vtkIdType v5, vtkIdType v6, vtkIdType v7, vtkIdType v8 )
 {
   if ( currentShape >= shapesPerList )
     {
     if (  ( currentList + 1) >= listSize  )
       {
-      int ** tmpList = new int * [ 2 * listSize ];
+      vtkIdType ** tmpList = new vtkIdType * [ 2 * listSize ];
       
       for ( int i = 0; i < listSize; i ++ )
         {
@@ -861,7 +924,7 @@ void vtkTableBasedClipperHexList::AddHex( int cellId,
       }
  
     currentList ++;
-    list[ currentList ] = new int[  ( shapeSize + 1 ) * shapesPerList  ];
+    list[ currentList ] = new vtkIdType[  ( shapeSize + 1 ) * shapesPerList  ];
     currentShape = 0;
     }
  
@@ -888,13 +951,14 @@ vtkTableBasedClipperWedgeList::~vtkTableBasedClipperWedgeList()
 }
 
 void vtkTableBasedClipperWedgeList::AddWedge
-   ( int cellId, int v1, int v2, int v3, int v4, int v5, int v6 )
+   ( vtkIdType cellId, vtkIdType v1, vtkIdType v2, vtkIdType v3, 
+                       vtkIdType v4, vtkIdType v5, vtkIdType v6 )
 {
   if (currentShape >= shapesPerList)
     {
     if ((currentList+1) >= listSize)
       {
-      int ** tmpList = new int * [ 2 * listSize ];
+      vtkIdType ** tmpList = new vtkIdType * [ 2 * listSize ];
       for ( int i = 0; i < listSize; i ++ )
         {
         tmpList[i] = list[i];
@@ -911,7 +975,7 @@ void vtkTableBasedClipperWedgeList::AddWedge
       }
  
     currentList ++;
-    list[ currentList ] = new int[  ( shapeSize + 1 ) * shapesPerList  ];
+    list[ currentList ] = new vtkIdType[  ( shapeSize + 1 ) * shapesPerList  ];
     currentShape = 0;
     }
  
@@ -936,13 +1000,14 @@ vtkTableBasedClipperPyramidList::~vtkTableBasedClipperPyramidList()
 }
 
 void vtkTableBasedClipperPyramidList::AddPyramid
-   ( int cellId, int v1, int v2, int v3, int v4, int v5 )
+   ( vtkIdType cellId, vtkIdType v1, vtkIdType v2, 
+                       vtkIdType v3, vtkIdType v4, vtkIdType v5 )
 {
   if (currentShape >= shapesPerList)
     {
     if (  ( currentList + 1 ) >= listSize  )
       {
-      int ** tmpList = new int * [ 2 * listSize ];
+      vtkIdType ** tmpList = new vtkIdType * [ 2 * listSize ];
       
       for ( int i = 0; i < listSize; i ++ )
         {
@@ -960,7 +1025,7 @@ void vtkTableBasedClipperPyramidList::AddPyramid
       }
  
     currentList ++;
-    list[ currentList ] = new int[  ( shapeSize + 1 ) * shapesPerList  ];
+    list[ currentList ] = new vtkIdType[  ( shapeSize + 1 ) * shapesPerList  ];
     currentShape = 0;
     }
  
@@ -984,13 +1049,13 @@ vtkTableBasedClipperTetList::~vtkTableBasedClipperTetList()
 }
 
 void vtkTableBasedClipperTetList::AddTet
-   ( int cellId, int v1,int v2,int v3,int v4 )
+   ( vtkIdType cellId, vtkIdType v1, vtkIdType v2, vtkIdType v3, vtkIdType v4 )
 {
   if ( currentShape >= shapesPerList )
     {
     if (  ( currentList + 1 )  >=  listSize  )
       {
-      int ** tmpList = new int * [ 2 * listSize ];
+      vtkIdType ** tmpList = new vtkIdType * [ 2 * listSize ];
       
       for ( int i = 0; i < listSize; i ++ )
         {
@@ -1008,7 +1073,7 @@ void vtkTableBasedClipperTetList::AddTet
       }
  
     currentList ++;
-    list[ currentList ] = new int[  ( shapeSize + 1 ) * shapesPerList  ];
+    list[ currentList ] = new vtkIdType[  ( shapeSize + 1 ) * shapesPerList  ];
     currentShape = 0;
     }
  
@@ -1031,13 +1096,13 @@ vtkTableBasedClipperQuadList::~vtkTableBasedClipperQuadList()
 }
 
 void vtkTableBasedClipperQuadList::AddQuad
-   ( int cellId, int v1,int v2,int v3,int v4 )
+   ( vtkIdType cellId, vtkIdType v1, vtkIdType v2, vtkIdType v3, vtkIdType v4 )
 {
   if ( currentShape >= shapesPerList )
     {
     if (  ( currentList + 1 ) >= listSize  )
       {
-      int ** tmpList = new int * [ 2 * listSize ];
+      vtkIdType ** tmpList = new vtkIdType * [ 2 * listSize ];
       for ( int i = 0; i < listSize; i ++ )
         {
         tmpList[i] = list[i];
@@ -1054,7 +1119,7 @@ void vtkTableBasedClipperQuadList::AddQuad
       }
  
     currentList ++;
-    list[ currentList ] = new int[  ( shapeSize + 1 ) * shapesPerList  ];
+    list[ currentList ] = new vtkIdType[  ( shapeSize + 1 ) * shapesPerList  ];
     currentShape = 0;
     }
  
@@ -1077,13 +1142,13 @@ vtkTableBasedClipperTriList::~vtkTableBasedClipperTriList()
 }
 
 void vtkTableBasedClipperTriList::AddTri
-   ( int cellId, int v1,int v2,int v3 )
+   ( vtkIdType cellId, vtkIdType v1, vtkIdType v2, vtkIdType v3 )
 {
   if ( currentShape >= shapesPerList )
     {
     if (  ( currentList + 1 ) >= listSize  )
       {
-      int ** tmpList = new int * [ 2 * listSize ];
+      vtkIdType ** tmpList = new vtkIdType * [ 2 * listSize ];
       for ( int i = 0; i < listSize; i ++ )
         {
         tmpList[i] = list[i];
@@ -1100,7 +1165,7 @@ void vtkTableBasedClipperTriList::AddTri
       }
  
     currentList ++;
-    list[ currentList ] = new int[  ( shapeSize + 1 ) * shapesPerList  ];
+    list[ currentList ] = new vtkIdType[  ( shapeSize + 1 ) * shapesPerList  ];
     currentShape = 0;
     }
  
@@ -1121,13 +1186,14 @@ vtkTableBasedClipperLineList::~vtkTableBasedClipperLineList()
 {
 }
  
-void vtkTableBasedClipperLineList::AddLine( int cellId, int v1,int v2 )
+void vtkTableBasedClipperLineList::AddLine
+   ( vtkIdType cellId, vtkIdType v1, vtkIdType v2 )
 {
   if ( currentShape >= shapesPerList )
     {
     if (  ( currentList + 1 )  >=  listSize  )
       {
-      int ** tmpList = new int * [ 2 * listSize ];
+      vtkIdType ** tmpList = new vtkIdType * [ 2 * listSize ];
       for ( int i = 0; i < listSize; i ++ )
         {
         tmpList[i] = list[i];
@@ -1144,7 +1210,7 @@ void vtkTableBasedClipperLineList::AddLine( int cellId, int v1,int v2 )
       }
  
     currentList ++;
-    list[ currentList ] = new int[  ( shapeSize + 1 ) * shapesPerList  ];
+    list[ currentList ] = new vtkIdType[  ( shapeSize + 1 ) * shapesPerList  ];
     currentShape = 0;
     }
  
@@ -1164,13 +1230,13 @@ vtkTableBasedClipperVertexList::~vtkTableBasedClipperVertexList()
 {
 }
  
-void vtkTableBasedClipperVertexList::AddVertex( int cellId, int v1 )
+void vtkTableBasedClipperVertexList::AddVertex( vtkIdType cellId, vtkIdType v1 )
 {
   if ( currentShape >= shapesPerList )
     {
     if (  ( currentList + 1 ) >= listSize  )
       {
-      int ** tmpList = new int * [ 2 * listSize ];
+      vtkIdType ** tmpList = new vtkIdType * [ 2 * listSize ];
       for ( int i = 0; i < listSize; i ++ )
         {
         tmpList[i] = list[i];
@@ -1187,7 +1253,7 @@ void vtkTableBasedClipperVertexList::AddVertex( int cellId, int v1 )
       }
  
     currentList ++;
-    list[ currentList ] = new int[  ( shapeSize + 1 ) * shapesPerList  ];
+    list[ currentList ] = new vtkIdType[  ( shapeSize + 1 ) * shapesPerList  ];
     currentShape = 0;
     }
  
@@ -1197,6 +1263,80 @@ void vtkTableBasedClipperVertexList::AddVertex( int cellId, int v1 )
   currentShape ++;
 }
 
+void vtkTableBasedClipperVolumeFromVolume::
+     Merge( const vtkTableBasedClipperVolumeFromVolume & other )
+{
+  int   i, j, k, l;
+  
+  //
+  // Re-insert the edge points of the other container into our own hash table
+  // and record where each of them ends up. Since the lists are traversed in
+  // the order of insertion, merging the containers of consecutive cell ranges
+  // one after another yields exactly the points of a serial traversal.
+  //
+  vtkIdType   numEdges = other.pt_list.GetTotalNumberOfPoints();
+  vtkIdType * edgeMaps = new vtkIdType[ numEdges + 1 ];
+  vtkIdType   edgeIndx = 0;
+  int         nLists   = other.pt_list.GetNumberOfLists();
+  for ( i = 0; i < nLists; i ++ )
+    {
+    const TableBasedClipperPointEntry * pe_list = NULL;
+    int nPts = other.pt_list.GetList( i, pe_list );
+    for ( j = 0; j < nPts; j ++ )
+      {
+      edgeMaps[ edgeIndx ++ ] = edges.AddPoint( pe_list[j].ptIds[0], 
+                                    pe_list[j].ptIds[1], pe_list[j].percent );
+      }
+    }
+  
+  // centroid points are never shared between cells and are simply appended
+  vtkIdType centroidOffset = centroid_list.GetTotalNumberOfPoints();
+  
+  vtkIdType mergedIds[9];
+  nLists = other.centroid_list.GetNumberOfLists();
+  for ( i = 0; i < nLists; i ++ )
+    {
+    const TableBasedClipperCentroidPointEntry * ce_list = NULL;
+    int nPts = other.centroid_list.GetList( i, ce_list );
+    for ( j = 0; j < nPts; j ++ )
+      {
+      for ( k = 0; k < ce_list[j].nPts; k ++ )
+        {
+        mergedIds[k] = MergedPointId
+                       ( ce_list[j].ptIds[k], edgeMaps, centroidOffset );
+        }
+      centroid_list.AddPoint( ce_list[j].nPts, mergedIds );
+      }
+    }
+    
+  for ( i = 0; i < nshapes; i ++ )
+    {
+    nLists = other.shapes[i]->GetNumberOfLists();
+    int npts_per_shape = other.shapes[i]->GetShapeSize();
+    
+    for ( j = 0; j < nLists; j ++ )
+      {
+      const vtkIdType * list;
+      int listSize = other.shapes[i]->GetList( j, list );
+      
+      for ( k = 0; k < listSize; k ++ )
+        {
+        mergedIds[0] = *list ++; // the cell id entry
+        
+        for ( l = 1; l <= npts_per_shape; l ++ )
+          {
+          mergedIds[l] = MergedPointId( *list, edgeMaps, centroidOffset );
+          list ++;
+          }
+          
+        shapes[i]->AddShape( mergedIds );
+        }
+      }
+    }
+
+  delete [] edgeMaps;
+}
+
 void vtkTableBasedClipperVolumeFromVolume::
      ConstructDataSet( vtkPointData * inPD, vtkCellData * inCD, 
                        vtkUnstructuredGrid * output, double * pts_ptr )
@@ -1226,7 +1366,7 @@ void vtkTableBasedClipperVolumeFromVolume::
                        vtkUnstructuredGrid * output,
                        TableBasedClipperCommonPointsStructure & cps )
 {
-  int   i, j, k, l;
+  vtkIdType i, j, k, l;
 
   vtkPointData * outPD = output->GetPointData();
   vtkCellData  * outCD = output->GetCellData();
@@ -1239,13 +1379,13 @@ void vtkTableBasedClipperVolumeFromVolume::
   // on memory by only bringing over the points from the original dataset
   // that are used with the output.  Determine which points those are here.
   //
-  int * ptLookup = new int[ numPrevPts ];
+  vtkIdType * ptLookup = new vtkIdType[ numPrevPts ];
   for ( i = 0; i < numPrevPts; i ++ )
     {
     ptLookup[i] = -1;
     }
     
-  int numUsed = 0;
+  vtkIdType numUsed = 0;
   for ( i = 0; i < nshapes; i ++ )
     {
     int nlists = shapes[i]->GetNumberOfLists();
@@ -1253,7 +1393,7 @@ void vtkTableBasedClipperVolumeFromVolume::
     
     for ( j = 0; j < nlists; j ++ )
       {
-      const int * list;
+      const vtkIdType * list;
       int listSize = shapes[i]->GetList( j, list );
       
       for ( k = 0; k < listSize; k ++ )
@@ -1262,7 +1402,7 @@ void vtkTableBasedClipperVolumeFromVolume::
         
         for ( l = 0; l < npts_per_shape; l ++ )
           {
-          int pt = *list;
+          vtkIdType pt = *list;
           list ++;
           
           if ( pt >= 0 && pt < numPrevPts )
@@ -1281,8 +1421,9 @@ void vtkTableBasedClipperVolumeFromVolume::
   // Set up the output points and its point data.
   //
   vtkPoints * outPts = vtkPoints::New();
-  int centroidStart  = numUsed + pt_list.GetTotalNumberOfPoints();
-  int nOutPts        = centroidStart + centroid_list.GetTotalNumberOfPoints();
+  vtkIdType centroidStart = numUsed + pt_list.GetTotalNumberOfPoints();
+  vtkIdType nOutPts       = centroidStart + 
+                            centroid_list.GetTotalNumberOfPoints();
   outPts->SetNumberOfPoints( nOutPts );
   outPD->CopyAllocate( inPD, nOutPts );
   
@@ -1296,8 +1437,13 @@ void vtkTableBasedClipperVolumeFromVolume::
 
   //
   // Copy over all the points from the input that are actually used in the
-  // output.
+  // output. Their attributes are copied at once after the loop.
   //
+  vtkIdList * fromIds = vtkIdList::New();
+  vtkIdList * toIds   = vtkIdList::New();
+  fromIds->SetNumberOfIds( numUsed );
+  toIds->SetNumberOfIds( numUsed );
+  vtkIdType numCopied = 0;
   for ( i = 0; i < numPrevPts; i ++ )
     {
     if ( ptLookup[i] == -1 )
@@ -1311,25 +1457,34 @@ void vtkTableBasedClipperVolumeFromVolume::
       }
     else
       {
-      int I = i % cps.dims[0];
-      int J = (i / cps.dims[0]) % cps.dims[1];
-      int K = i / ( cps.dims[0] * cps.dims[1] );
+      vtkIdType I = i % cps.dims[0];
+      vtkIdType J = ( i / cps.dims[0] ) % cps.dims[1];
+      vtkIdType K = i / ( static_cast< vtkIdType > ( cps.dims[0] ) * cps.dims[1] );
       outPts->SetPoint( ptLookup[i], cps.X[I], cps.Y[J], cps.Z[K] );
       }
 
-    outPD->CopyData( inPD, i, ptLookup[i] );
+    fromIds->SetId( numCopied, i );
+    toIds->SetId( numCopied, ptLookup[i] );
+    numCopied ++;
     if ( newOrigNodes )
       {
       newOrigNodes->SetTuple(  ptLookup[i], origNodes->GetTuple( i )  );
       }
     }
+  outPD->CopyData( inPD, fromIds, toIds );
+  fromIds->Delete();
+  toIds->Delete();
     
-  int ptIdx = numUsed;
+  vtkIdType ptIdx = numUsed;
 
   //
   // Now construct all the points that are along edges and new and add 
-  // them to the points list.
+  // them to the points list. Their attributes are interpolated at once
+  // after the loop.
   //
+  vtkIdType nEdgePts = pt_list.GetTotalNumberOfPoints();
+  vtkstd::vector< vtkIdType > edgeIds( 2 * nEdgePts + 1 );
+  vtkstd::vector< double >    edgeFactors( nEdgePts + 1 );
   int nLists = pt_list.GetNumberOfLists();
   for ( i = 0; i < nLists; i ++ )
     {
@@ -1339,8 +1494,8 @@ void vtkTableBasedClipperVolumeFromVolume::
       {
       const TableBasedClipperPointEntry & pe = pe_list[j];
       double pt[3];
-      int idx1 = pe.ptIds[0];
-      int idx2 = pe.ptIds[1];
+      vtkIdType idx1 = pe.ptIds[0];
+      vtkIdType idx2 = pe.ptIds[1];
 
       // Construct the original points -- this will depend on whether
       // or not we started with a rectilinear grid or a point set.
@@ -1357,15 +1512,16 @@ void vtkTableBasedClipperVolumeFromVolume::
         {
         pt1 = pt1_storage;
         pt2 = pt2_storage;
-        int I = idx1 % cps.dims[0];
-        int J = ( idx1 / cps.dims[0] ) % cps.dims[1];
-        int K = idx1 / ( cps.dims[0] * cps.dims[1] );
+        vtkIdType I = idx1 % cps.dims[0];
+        vtkIdType J = ( idx1 / cps.dims[0] ) % cps.dims[1];
+        vtkIdType K = idx1 / 
+                      ( static_cast< vtkIdType > ( cps.dims[0] ) * cps.dims[1] );
         pt1[0] = cps.X[I];
         pt1[1] = cps.Y[J];
         pt1[2] = cps.Z[K];
         I = idx2 % cps.dims[0];
         J = ( idx2 / cps.dims[0] ) % cps.dims[1];
-        K = idx2 / ( cps.dims[0] * cps.dims[1] );
+        K = idx2 / ( static_cast< vtkIdType > ( cps.dims[0] ) * cps.dims[1] );
         pt2[0] = cps.X[I];
         pt2[1] = cps.Y[J];
         pt2[2] = cps.Z[K];
@@ -1378,22 +1534,34 @@ void vtkTableBasedClipperVolumeFromVolume::
       pt[1] = pt1[1] * p + pt2[1] * bp;
       pt[2] = pt1[2] * p + pt2[2] * bp;
       outPts->SetPoint( ptIdx, pt );
-      outPD->InterpolateEdge( inPD, ptIdx, pe.ptIds[0], pe.ptIds[1], bp );
+      edgeIds[ 2 * ( ptIdx - numUsed )     ] = pe.ptIds[0];
+      edgeIds[ 2 * ( ptIdx - numUsed ) + 1 ] = pe.ptIds[1];
+      edgeFactors[ ptIdx - numUsed ] = bp;
       
       if ( newOrigNodes )
         {
-        int id = ( bp <= 0.5 ? pe.ptIds[0] : pe.ptIds[1] );
+        vtkIdType id = ( bp <= 0.5 ? pe.ptIds[0] : pe.ptIds[1] );
         newOrigNodes->SetTuple(  ptIdx, origNodes->GetTuple( id )  );
         }
       ptIdx ++;
       }
     }
 
+  outPD->InterpolateEdges( inPD, numUsed, nEdgePts, &edgeIds[0],
+                           &edgeFactors[0] );
+
   // 
   // Now construct the new "centroid" points and add them to the points list.
+  // Their attributes are interpolated at once after the loop, from the
+  // output points, in order since a centroid may be built from the
+  // centroids before it.
   //
+  vtkIdType nCentroidPts = centroid_list.GetTotalNumberOfPoints();
+  vtkstd::vector< vtkIdType > centroidOffsets( nCentroidPts + 1 );
+  vtkstd::vector< vtkIdType > centroidIds( 8 * nCentroidPts + 1 );
+  vtkstd::vector< double >    centroidWeights( 8 * nCentroidPts + 1 );
+  vtkIdType centroidLoc = 0;
   nLists = centroid_list.GetNumberOfLists();
-  vtkIdList * idList = vtkIdList::New();
   for ( i = 0; i < nLists; i ++ )
     {
     const TableBasedClipperCentroidPointEntry * ce_list = NULL;
@@ -1401,15 +1569,14 @@ void vtkTableBasedClipperVolumeFromVolume::
     for ( j = 0; j < nPts; j ++ )
       {
       const TableBasedClipperCentroidPointEntry & ce = ce_list[j];
-      idList->SetNumberOfIds( ce.nPts );
       double pts[8][3];
-      double weights[8];
       double pt[3] = { 0.0, 0.0, 0.0 };
       double weight_factor = 1.0 / ce.nPts;
+      centroidOffsets[ ptIdx - centroidStart ] = centroidLoc;
       for ( k = 0; k < ce.nPts; k ++ )
         {
-        weights[k] = 1.0 * weight_factor;
-        int id = 0;
+        centroidWeights[ centroidLoc + k ] = 1.0 * weight_factor;
+        vtkIdType id = 0;
         
         if ( ce.ptIds[k] < 0 )
           {
@@ -1425,7 +1592,7 @@ void vtkTableBasedClipperVolumeFromVolume::
           id = ptLookup[ ce.ptIds[k] ];
           }
           
-        idList->SetId( k, id );
+        centroidIds[ centroidLoc + k ] = id;
         outPts->GetPoint( id, pts[k] );
         pt[0] += pts[k][0];
         pt[1] += pts[k][1];
@@ -1436,7 +1603,7 @@ void vtkTableBasedClipperVolumeFromVolume::
       pt[2] *= weight_factor;
 
       outPts->SetPoint( ptIdx, pt );
-      outPD->InterpolatePoint( outPD, ptIdx, idList, weights );
+      centroidLoc += ce.nPts;
       if ( newOrigNodes )
         {
         // these 'created' nodes have no original designation
@@ -1448,7 +1615,10 @@ void vtkTableBasedClipperVolumeFromVolume::
       ptIdx ++;
       }
     }
-  idList->Delete();
+  centroidOffsets[ nCentroidPts ] = centroidLoc;
+  outPD->InterpolatePoints( outPD, centroidStart, nCentroidPts,
+                            &centroidOffsets[0], &centroidIds[0],
+                            &centroidWeights[0] );
 
   //
   // We are finally done constructing the points list.  Set it with our
@@ -1468,20 +1638,24 @@ void vtkTableBasedClipperVolumeFromVolume::
   //
   // Now set up the shapes and the cell data.
   //
-  int cellId = 0;
-  int nlists;
+  vtkIdType cellId = 0;
+  int       nlists;
 
-  int ncells    = 0;
-  int conn_size = 0;
+  vtkIdType ncells    = 0;
+  vtkIdType conn_size = 0;
   for ( i = 0; i < nshapes; i ++ )
     {
-    int ns     = shapes[i]->GetTotalNumberOfShapes();
+    vtkIdType ns = shapes[i]->GetTotalNumberOfShapes();
     ncells    += ns;
     conn_size += ( shapes[i]->GetShapeSize() + 1 ) * ns;
     }
 
   outCD->CopyAllocate( inCD, ncells );
 
+  // the input cell of each output cell, for copying the cell data at once
+  vtkIdList * cellSources = vtkIdList::New();
+  cellSources->SetNumberOfIds( ncells );
+
   vtkIdTypeArray * nlist = vtkIdTypeArray::New();
   nlist->SetNumberOfValues( conn_size );
   vtkIdType * nl = nlist->GetPointer( 0 );
@@ -1495,10 +1669,10 @@ void vtkTableBasedClipperVolumeFromVolume::
   vtkIdType * cl = cellLocations->GetPointer( 0 );
 
   vtkIdType ids[1024]; // 8 (for hex) should be max, but...
-  int current_index = 0;
+  vtkIdType current_index = 0;
   for ( i = 0; i < nshapes; i ++ )
     {
-    const int * list;
+    const vtkIdType * list;
     nlists = shapes[i]->GetNumberOfLists();
     int shapesize = shapes[i]->GetShapeSize();
     int vtk_type = shapes[i]->GetVTKType();
@@ -1509,7 +1683,7 @@ void vtkTableBasedClipperVolumeFromVolume::
       
       for ( k = 0; k < listSize; k ++ )
         {
-        outCD->CopyData( inCD, list[0], cellId );
+        cellSources->SetId( cellId, list[0] );
         
         for ( l = 0; l < shapesize; l ++ )
           {
@@ -1542,6 +1716,9 @@ void vtkTableBasedClipperVolumeFromVolume::
       }
     }
 
+  outCD->CopyConsecutiveData( inCD, cellSources, 0 );
+  cellSources->Delete();
+
   vtkCellArray * cells = vtkCellArray::New();
   cells->SetCells( ncells, nlist );
   nlist->Delete();
@@ -1555,11 +1732,11 @@ void vtkTableBasedClipperVolumeFromVolume::
 }
 
 inline void GetPoint( double * pt, const double * X, const double * Y,
-                      const double * Z, const int * dims, const int & index )
+                      const double * Z, const int * dims, const vtkIdType & index )
 {
-  int cellI = index % dims[0];
-  int cellJ = ( index / dims[0] ) % dims[1];
-  int cellK = index / ( dims[0] * dims[1] );
+  vtkIdType cellI = index % dims[0];
+  vtkIdType cellJ = ( index / dims[0] ) % dims[1];
+  vtkIdType cellK = index / ( static_cast< vtkIdType > ( dims[0] ) * dims[1] );
   pt[0] = X[ cellI ];
   pt[1] = Y[ cellJ ];
   pt[2] = Z[ cellK ];
@@ -1589,6 +1766,8 @@ vtkTableBasedClipDataSet::vtkTableBasedClipDataSet( vtkImplicitFunction * cf )
   this->UseValueAsOffset      = true;
   this->GenerateClipScalars   = 0;
   this->GenerateClippedOutput = 0;
+  this->NumberOfThreads       = 1;
+  this->Threader              = vtkMultiThreader::New();
 
   this->SetNumberOfOutputPorts( 2 );
   vtkUnstructuredGrid * output2 = vtkUnstructuredGrid::New();
@@ -1616,6 +1795,8 @@ vtkTableBasedClipDataSet::~vtkTableBasedClipDataSet()
   this->SetClipFunction( NULL );
   this->InternalProgressObserver->Delete();
   this->InternalProgressObserver = NULL;
+  this->Threader->Delete();
+  this->Threader = NULL;
 }
 
 //-----------------------------------------------------------------------------
@@ -2079,7 +2260,7 @@ void vtkTableBasedClipDataSet::ClipPolyData( vtkDataSet * inputGrd,
      vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
 {
   vtkPolyData * polyData = vtkPolyData::SafeDownCast( inputGrd );
-  int           numCells = polyData->GetNumberOfCells();
+  vtkIdType     numCells = polyData->GetNumberOfCells();
 
   vtkTableBasedClipperVolumeFromVolume   * visItVFV = new
   vtkTableBasedClipperVolumeFromVolume(    polyData->GetNumberOfPoints(),
@@ -2092,7 +2273,7 @@ void vtkTableBasedClipDataSet::ClipPolyData( vtkDataSet * inputGrd,
 
   vtkIdType   i, j;
   vtkIdType   numbPnts = 0;
-  int         numCants = 0;  // number of cells not clipped by this filter
+  vtkIdType   numCants = 0;  // number of cells not clipped by this filter
   
   for ( i = 0; i < numCells; i ++ )
     {
@@ -2203,7 +2384,7 @@ void vtkTableBasedClipDataSet::ClipPolyData( vtkDataSet * inputGrd,
           break;
         }
 
-      int  intrpIds[4];
+      vtkIdType intrpIds[4];
       for ( j = 0; j < nOutputs; j ++ )
         {
         int      nCellPts = 0;
@@ -2272,7 +2453,7 @@ void vtkTableBasedClipDataSet::ClipPolyData( vtkDataSet * inputGrd,
           continue;
           }
 
-        int   shapeIds[8];
+        vtkIdType shapeIds[8];
         for ( int p = 0; p < nCellPts; p ++ )
           {
           unsigned char pntIndex = *thisCase ++;
@@ -2296,8 +2477,8 @@ void vtkTableBasedClipDataSet::ClipPolyData( vtkDataSet * inputGrd,
             double pt1ToIso = 0.0 - grdDiffs[ pt1Index ];
             double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
 
-            int    pntIndx1 = pntIndxs[ pt1Index ];
-            int    pntIndx2 = pntIndxs[ pt2Index ];
+            vtkIdType pntIndx1 = pntIndxs[ pt1Index ];
+            vtkIdType pntIndx2 = pntIndxs[ pt2Index ];
             
             shapeIds[p] = visItVFV->AddPoint( pntIndx1, pntIndx2, p1Weight );
             }
@@ -2448,9 +2629,10 @@ void vtkTableBasedClipDataSet::ClipRectilinearGridData( vtkDataSet * inputGrd,
 {
   vtkRectilinearGrid * rectGrid = vtkRectilinearGrid::SafeDownCast( inputGrd );
   
-  int   i, j;
-  int   numCells = 0;
-  int   isTwoDim = 0;
+  vtkIdType   i;
+  int         j;
+  vtkIdType   numCells = 0;
+  int         isTwoDim = 0;
   int   rectDims[3];
   rectGrid->GetDimensions( rectDims );
   isTwoDim = int( rectDims[2] <= 1 );
@@ -2466,18 +2648,18 @@ void vtkTableBasedClipDataSet::ClipRectilinearGridData( vtkDataSet * inputGrd,
                            { 0, 0, 0, 0, 1, 1, 1, 1 }
                          };
   int   cellDims[3] = { rectDims[0] - 1, rectDims[1] - 1, rectDims[2] - 1 };
-  int   cyStride    = cellDims[0];
-  int   czStride    = cellDims[0] * cellDims[1];
-  int   pyStride    = rectDims[0];
-  int   pzStride    = rectDims[0] * rectDims[1];
+  vtkIdType cyStride = cellDims[0];
+  vtkIdType czStride = static_cast< vtkIdType > ( cellDims[0] ) * cellDims[1];
+  vtkIdType pyStride = rectDims[0];
+  vtkIdType pzStride = static_cast< vtkIdType > ( rectDims[0] ) * rectDims[1];
   
   for ( i = 0; i < numCells; i ++ )
     {     
     int    caseIndx = 0;   
     int    nCellPts = isTwoDim ? 4 : 8;
-    int    theCellI =   i % cellDims[0];
-    int    theCellJ = ( i / cyStride ) % cellDims[1];
-    int    theCellK = ( i / czStride );
+    vtkIdType theCellI =   i % cellDims[0];
+    vtkIdType theCellJ = ( i / cyStride ) % cellDims[1];
+    vtkIdType theCellK = ( i / czStride );
     double grdDiffs[8];
     
     for ( j = nCellPts - 1; j >= 0; j -- )
@@ -2492,7 +2674,7 @@ void vtkTableBasedClipDataSet::ClipRectilinearGridData( vtkDataSet * inputGrd,
       }
 
     int             nOutputs;
-    int             intrpIds[4];
+    vtkIdType       intrpIds[4];
     unsigned char * thisCase = NULL;
     
     if ( isTwoDim )
@@ -2577,7 +2759,7 @@ void vtkTableBasedClipDataSet::ClipRectilinearGridData( vtkDataSet * inputGrd,
         continue;
         }
 
-      int   shapeIds[8];
+      vtkIdType shapeIds[8];
       for ( int p = 0; p < nCellPts; p ++ )
         {
         unsigned char pntIndex = *thisCase ++;
@@ -2612,12 +2794,12 @@ void vtkTableBasedClipDataSet::ClipRectilinearGridData( vtkDataSet * inputGrd,
           double pt1ToIso = 0.0 - grdDiffs[ pt1Index ];
           double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
 
-          int    pntIndx1 = 
+          vtkIdType pntIndx1 = 
                  (   (  theCellI + shiftLUT[0][ pt1Index ]  ) +
                      (  theCellJ + shiftLUT[1][ pt1Index ]  ) * pyStride +
                      (  theCellK + shiftLUT[2][ pt1Index ]  ) * pzStride
                  );
-          int    pntIndx2 = 
+          vtkIdType pntIndx2 = 
                  (   (  theCellI + shiftLUT[0][ pt2Index ]  ) +
                      (  theCellJ + shiftLUT[1][ pt2Index ]  ) * pyStride +
                      (  theCellK + shiftLUT[2][ pt2Index ]  ) * pzStride
@@ -2770,9 +2952,10 @@ void vtkTableBasedClipDataSet::ClipStructuredGridData( vtkDataSet * inputGrd,
 {
   vtkStructuredGrid * strcGrid = vtkStructuredGrid::SafeDownCast( inputGrd );
   
-  int   i, j;
+  vtkIdType i;
+  int   j;
   int   isTwoDim    = 0;
-  int   numCells    = 0;
+  vtkIdType numCells = 0;
   int   gridDims[3] = { 0, 0, 0 };
   strcGrid->GetDimensions( gridDims );
   isTwoDim = int( gridDims[2] <= 1 );
@@ -2790,24 +2973,24 @@ void vtkTableBasedClipDataSet::ClipStructuredGridData( vtkDataSet * inputGrd,
                          };
   int   numbPnts    = 0;
   int   cellDims[3] = { gridDims[0] - 1, gridDims[1] - 1, gridDims[2] - 1 };
-  int   cyStride    = cellDims[0];
-  int   czStride    = cellDims[0] * cellDims[1];
-  int   pyStride    = gridDims[0];
-  int   pzStride    = gridDims[0] * gridDims[1];
+  vtkIdType cyStride = cellDims[0];
+  vtkIdType czStride = static_cast< vtkIdType > ( cellDims[0] ) * cellDims[1];
+  vtkIdType pyStride = gridDims[0];
+  vtkIdType pzStride = static_cast< vtkIdType > ( gridDims[0] ) * gridDims[1];
   
   for ( i = 0; i < numCells; i ++ )
     {
     int    caseIndx = 0;
-    int    theCellI = i % cellDims[0];
-    int    theCellJ = ( i / cyStride ) % cellDims[1];
-    int    theCellK = ( i / czStride );
+    vtkIdType theCellI = i % cellDims[0];
+    vtkIdType theCellJ = ( i / cyStride ) % cellDims[1];
+    vtkIdType theCellK = ( i / czStride );
     double grdDiffs[8];
        
     numbPnts = isTwoDim ? 4 : 8;
     
     for ( j = numbPnts - 1; j >= 0; j -- )
       {
-      int pntIndex = ( theCellI + shiftLUT[0][j] ) + 
+      vtkIdType pntIndex = ( theCellI + shiftLUT[0][j] ) + 
                      ( theCellJ + shiftLUT[1][j] ) * pyStride +
                      ( theCellK + shiftLUT[2][j] ) * pzStride;
                  
@@ -2817,7 +3000,7 @@ void vtkTableBasedClipDataSet::ClipStructuredGridData( vtkDataSet * inputGrd,
       }
 
     int             nOutputs;
-    int             intrpIds[4];
+    vtkIdType       intrpIds[4];
     unsigned char * thisCase = NULL;
     
     if ( isTwoDim )
@@ -2902,7 +3085,7 @@ void vtkTableBasedClipDataSet::ClipStructuredGridData( vtkDataSet * inputGrd,
         continue;
         }
 
-      int   shapeIds[8];
+      vtkIdType shapeIds[8];
       for ( int p = 0; p < nCellPts; p ++ )
         {
         unsigned char pntIndex = *thisCase ++;
@@ -2937,12 +3120,12 @@ void vtkTableBasedClipDataSet::ClipStructuredGridData( vtkDataSet * inputGrd,
           double pt1ToIso = 0.0 - grdDiffs[ pt1Index ];
           double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
                                   
-          int    pntIndx1 = 
+          vtkIdType pntIndx1 = 
                  (   (  theCellI + shiftLUT[0][ pt1Index ] ) +
                      (  theCellJ + shiftLUT[1][ pt1Index ]  ) * pyStride +
                      (  theCellK + shiftLUT[2][ pt1Index ]  ) * pzStride
                  );
-          int    pntIndx2 = 
+          vtkIdType pntIndx2 = 
                  (   (  theCellI + shiftLUT[0][ pt2Index ]  ) +
                      (  theCellJ + shiftLUT[1][ pt2Index ]  ) * pyStride +
                      (  theCellK + shiftLUT[2][ pt2Index ]  ) * pzStride
@@ -3046,32 +3229,38 @@ void vtkTableBasedClipDataSet::ClipStructuredGridData( vtkDataSet * inputGrd,
 }
 
 //-----------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd, 
-     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
-{ 
-  vtkUnstructuredGrid * unstruct = vtkUnstructuredGrid::SafeDownCast( inputGrd );
-  
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipUnstructuredGridCells
+   ( vtkUnstructuredGrid * unstruct, vtkDataArray * clipAray, double isoValue,
+     vtkIdType firstCell, vtkIdType lastCell, 
+     vtkTableBasedClipperVolumeFromVolume * visItVFV, vtkIdList * specials )
+{
   vtkIdType   i, j;
   vtkIdType   numbPnts = 0;
-  int         numCants = 0; // number of cells not clipped by this filter
-  int         numCells = unstruct->GetNumberOfCells();
   
-  // volume from volume
-  vtkTableBasedClipperVolumeFromVolume   * visItVFV = new
-  vtkTableBasedClipperVolumeFromVolume(    unstruct->GetNumberOfPoints(), 
-      int(   pow(  double( numCells ), double( 0.6667f )  )   ) * 5 + 100    );
-
-  // the stuffs that can not be clipped by this filter
-  vtkUnstructuredGrid * specials = vtkUnstructuredGrid::New();
-  specials->SetPoints( unstruct->GetPoints() );
-  specials->GetPointData()->ShallowCopy( unstruct->GetPointData() );
-  specials->Allocate( numCells );
+  // the point ids of cells stored as offsets are read into a list owned by
+  // this call, as the buffer of the cell array can not be shared by threads
+  vtkCellArray * cellAray = unstruct->GetCells();
+  vtkIdList    * cellPnts = NULL;
+  if ( cellAray && cellAray->IsStorageOffsets() )
+    {
+    cellPnts = vtkIdList::New();
+    }
 
-  for ( i = 0; i < numCells; i ++ )
+  for ( i = firstCell; i < lastCell; i ++ )
     {
     int         cellType = unstruct->GetCellType( i );
     vtkIdType * pntIndxs = NULL;
-    unstruct->GetCellPoints( i, numbPnts, pntIndxs );
+    if ( cellPnts )
+      {
+      cellAray->GetCellAtId( i, cellPnts );
+      numbPnts = cellPnts->GetNumberOfIds();
+      pntIndxs = cellPnts->GetPointer( 0 );
+      }
+    else
+      {
+      unstruct->GetCellPoints( i, numbPnts, pntIndxs );
+      }
     
     bool     bCanClip = false;
     switch ( cellType )
@@ -3195,7 +3384,7 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
           break;
         }
       
-      int   intrpIds[4];
+      vtkIdType intrpIds[4];
       for ( j = 0; j < nOutputs; j ++ )
         {   
         int      nCellPts = 0;
@@ -3266,7 +3455,7 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
           continue; 
           }
         
-        int   shapeIds[8];
+        vtkIdType shapeIds[8];
         for ( int p = 0; p < nCellPts; p ++ )
           {
           unsigned char pntIndex = *thisCase ++;
@@ -3293,8 +3482,8 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
             double pt1ToIso = 0.0 - grdDiffs[ pt1Index ];
             double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
 
-            int    pntIndx1 = pntIndxs[ pt1Index ];
-            int    pntIndx2 = pntIndxs[ pt2Index ];
+            vtkIdType pntIndx1 = pntIndxs[ pt1Index ];
+            vtkIdType pntIndx2 = pntIndxs[ pt2Index ];
             
             shapeIds[p] = visItVFV->AddPoint( pntIndx1, pntIndx2, p1Weight );
             }
@@ -3360,35 +3549,185 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
       edgeVtxs = NULL;
       thisCase = NULL;
       }
-    else if (cellType == VTK_POLYHEDRON)
+    else
       {
-      if ( numCants == 0 )
+      specials->InsertNextId( i );
+      }
+      
+    pntIndxs = NULL;
+    }
+    
+  if ( cellPnts )
+    {
+    cellPnts->Delete();
+    cellPnts = NULL;
+    }
+  cellAray = NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Arguments shared by the threads clipping an unstructured grid. Cell chunk i
+// is clipped into VolumesFromVolume[i] and its special cells are recorded in
+// Specials[i].
+struct vtkTableBasedClipperThreadStruct
+{
+  vtkTableBasedClipDataSet              * Filter;
+  vtkUnstructuredGrid                   * Input;
+  vtkDataArray                          * ClipArray;
+  double                                  IsoValue;
+  vtkIdType                               NumberOfCells;
+  int                                     NumberOfChunks;
+  vtkTableBasedClipperVolumeFromVolume ** VolumesFromVolume;
+  vtkIdList                            ** Specials;
+};
+
+//-----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkTableBasedClipDataSet::ThreadedClipUnstructuredGrid
+   ( void * arg )
+{
+  vtkMultiThreader::ThreadInfo     * thrdInfo = 
+    static_cast< vtkMultiThreader::ThreadInfo * > ( arg );
+  vtkTableBasedClipperThreadStruct * thrdData = 
+    static_cast< vtkTableBasedClipperThreadStruct * > ( thrdInfo->UserData );
+
+  // The threader may run fewer threads than requested (e.g., due to the global
+  // maximum number of threads), so each thread takes every n-th chunk.
+  vtkIdType chunkSiz = thrdData->NumberOfCells / thrdData->NumberOfChunks;
+  for ( int chunkIdx  = thrdInfo->ThreadID; 
+            chunkIdx  < thrdData->NumberOfChunks; 
+            chunkIdx += thrdInfo->NumberOfThreads )
+    {
+    vtkIdType firstCel = chunkSiz * chunkIdx;
+    vtkIdType lastCell = ( chunkIdx == thrdData->NumberOfChunks - 1 )
+                         ? thrdData->NumberOfCells : firstCel + chunkSiz;
+    thrdData->Filter->ClipUnstructuredGridCells( thrdData->Input, 
+              thrdData->ClipArray, thrdData->IsoValue, firstCel, lastCell, 
+              thrdData->VolumesFromVolume[ chunkIdx ], 
+              thrdData->Specials[ chunkIdx ] );
+    }
+
+  thrdInfo = NULL;
+  thrdData = NULL;
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd, 
+     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
+{ 
+  vtkUnstructuredGrid * unstruct = vtkUnstructuredGrid::SafeDownCast( inputGrd );
+  
+  vtkIdType   i;
+  vtkIdType   numbPnts = 0;
+  vtkIdType   numCants = 0; // number of cells not clipped by this filter
+  vtkIdType   numCells = unstruct->GetNumberOfCells();
+  int         numThrds = this->NumberOfThreads;
+  
+  // it is not worth splitting small grids among threads
+  if ( numThrds > numCells / 1024 )
+    {
+    numThrds = ( numCells / 1024 > 1 ) ? static_cast< int > ( numCells / 1024 ) : 1;
+    }
+
+  // volume from volume
+  vtkTableBasedClipperVolumeFromVolume   * visItVFV = new
+  vtkTableBasedClipperVolumeFromVolume(    unstruct->GetNumberOfPoints(), 
+      int(   pow(  double( numCells ), double( 0.6667f )  )   ) * 5 + 100    );
+
+  // the ids of the cells that can not be clipped by this filter
+  vtkIdList * specIdxs = vtkIdList::New();
+  
+  if ( numThrds == 1 )
+    {
+    this->ClipUnstructuredGridCells( unstruct, clipAray, isoValue, 
+                                     0, numCells, visItVFV, specIdxs );
+    }
+  else
+    {
+    vtkTableBasedClipperThreadStruct thrdData;
+    thrdData.Filter         = this;
+    thrdData.Input          = unstruct;
+    thrdData.ClipArray      = clipAray;
+    thrdData.IsoValue       = isoValue;
+    thrdData.NumberOfCells  = numCells;
+    thrdData.NumberOfChunks = numThrds;
+    thrdData.VolumesFromVolume = new 
+    vtkTableBasedClipperVolumeFromVolume * [ numThrds ];
+    thrdData.Specials       = new vtkIdList * [ numThrds ];
+    
+    int   hashSize = int(  pow( double( numCells / numThrds ), 
+                                double( 0.6667f ) )  ) * 5 + 100;
+    for ( i = 0; i < numThrds; i ++ )
+      {
+      thrdData.VolumesFromVolume[i] = new 
+      vtkTableBasedClipperVolumeFromVolume( unstruct->GetNumberOfPoints(), 
+                                            hashSize );
+      thrdData.Specials[i] = vtkIdList::New();
+      }
+      
+    this->Threader->SetNumberOfThreads( numThrds );
+    this->Threader->SetSingleMethod
+          ( vtkTableBasedClipDataSet::ThreadedClipUnstructuredGrid, &thrdData );
+    this->Threader->SingleMethodExecute();
+    
+    // Merge the chunks in order such that the points and cells come out the
+    // same as if all the cells had been clipped by a single thread.
+    for ( i = 0; i < numThrds; i ++ )
+      {
+      visItVFV->Merge( *thrdData.VolumesFromVolume[i] );
+      delete thrdData.VolumesFromVolume[i];
+      thrdData.VolumesFromVolume[i] = NULL;
+      
+      vtkIdType numSpecs = thrdData.Specials[i]->GetNumberOfIds();
+      for ( vtkIdType j = 0; j < numSpecs; j ++ )
         {
-          specials->GetCellData()
-                  ->CopyAllocate( unstruct->GetCellData(), numCells );
+        specIdxs->InsertNextId( thrdData.Specials[i]->GetId( j ) );
         }
-      vtkIdType nfaces, *facePtIds;
-      unstruct->GetFaceStream(i, nfaces, facePtIds);
-      specials->InsertNextCell(cellType, nfaces, facePtIds);
-      specials->GetCellData()
-              ->CopyData( unstruct->GetCellData(), i, numCants );
-      numCants ++;
+      thrdData.Specials[i]->Delete();
+      thrdData.Specials[i] = NULL;
+      }
+      
+    delete [] thrdData.VolumesFromVolume;
+    delete [] thrdData.Specials;
+    thrdData.VolumesFromVolume = NULL;
+    thrdData.Specials          = NULL;
+    }
+
+  // the stuffs that can not be clipped by this filter
+  vtkUnstructuredGrid * specials = vtkUnstructuredGrid::New();
+  specials->SetPoints( unstruct->GetPoints() );
+  specials->GetPointData()->ShallowCopy( unstruct->GetPointData() );
+  specials->Allocate( numCells );
+  
+  numCants = specIdxs->GetNumberOfIds();
+  if ( numCants > 0 )
+    {
+    specials->GetCellData()
+            ->CopyAllocate( unstruct->GetCellData(), numCells );
+    }
+    
+  for ( i = 0; i < numCants; i ++ )
+    {
+    vtkIdType   cellIndx = specIdxs->GetId( i );
+    int         cellType = unstruct->GetCellType( cellIndx );
+    vtkIdType * pntIndxs = NULL;
+    
+    if ( cellType == VTK_POLYHEDRON )
+      {
+      unstruct->GetFaceStream( cellIndx, numbPnts, pntIndxs );
       }
     else
       {
-      if ( numCants == 0 )
-        {
-          specials->GetCellData()
-                  ->CopyAllocate( unstruct->GetCellData(), numCells );
-        }
-      specials->InsertNextCell( cellType, numbPnts, pntIndxs );
-      specials->GetCellData()
-              ->CopyData( unstruct->GetCellData(), i, numCants );
-      numCants ++;
+      unstruct->GetCellPoints( cellIndx, numbPnts, pntIndxs );
       }
       
+    specials->InsertNextCell( cellType, numbPnts, pntIndxs );
+    specials->GetCellData()
+            ->CopyData( unstruct->GetCellData(), cellIndx, i );
     pntIndxs = NULL;
     }
+  specIdxs->Delete();
+  specIdxs = NULL;
   
   int         toDelete = 0;
   double    * theCords = NULL;
@@ -3485,4 +3824,6 @@ void vtkTableBasedClipDataSet::PrintSelf( ostream & os, vtkIndent indent )
 
   os << indent << "UseValueAsOffset: " 
      << (this->UseValueAsOffset ? "On\n" : "Off\n");
+
+  os << indent << "Number Of Threads: " << this->NumberOfThreads << "\n";
 }
@@ -94,8 +94,11 @@
 #include "vtkUnstructuredGridAlgorithm.h"
 
 class vtkCallbackCommand;
+class vtkIdList;
 class vtkImplicitFunction;
 class vtkIncrementalPointLocator;
+class vtkMultiThreader;
+class vtkTableBasedClipperVolumeFromVolume;
 
 class VTK_GRAPHICS_EXPORT vtkTableBasedClipDataSet : public vtkUnstructuredGridAlgorithm
 {
@@ -187,6 +190,16 @@ public:
   // Return the clipped output.
   vtkUnstructuredGrid * GetClippedOutput();
 
+  // Description:
+  // Set/Get the number of threads used to clip a vtkUnstructuredGrid, with 1
+  // (serial execution) as the default value. With more than one thread, the
+  // cells are split into contiguous chunks, each of which is clipped with its
+  // own edge hash table and shape lists. The per-thread results are then merged
+  // in chunk order, so the output is identical to that of the serial mode.
+  // Other types of input are always clipped serially.
+  vtkSetClampMacro( NumberOfThreads, int, 1, VTK_MAX_THREADS );
+  vtkGetMacro( NumberOfThreads, int );
+
   // Description:
   // Overridden to process REQUEST_UPDATE_EXTENT_INFORMATION.
   virtual int ProcessRequest( vtkInformation *,
@@ -244,6 +257,23 @@ protected:
   // (provided via SetClipFunction()). The clipping result is exported to outputUG.
   void ClipUnstructuredGridData( vtkDataSet * inputGrd, vtkDataArray * clipAray, 
                                  double isoValue, vtkUnstructuredGrid * outputUG );
+
+  // Description:
+  // This function clips the cells [firstCell, lastCell) of a vtkUnstructuredGrid
+  // into the given volume-from-volume container. The ids of the cells that can
+  // not be clipped via the tables are appended to specials (in increasing order)
+  // to be processed by vtkClipDataSet afterwards. It only reads the input and
+  // hence may be invoked concurrently on disjoint cell ranges.
+  void ClipUnstructuredGridCells( vtkUnstructuredGrid * unstruct, 
+                                  vtkDataArray * clipAray, double isoValue,
+                                  vtkIdType firstCell, vtkIdType lastCell,
+                                  vtkTableBasedClipperVolumeFromVolume * visItVFV,
+                                  vtkIdList * specials );
+
+  // Description:
+  // The thread entry point that clips one chunk of the unstructured grid cells
+  // via ClipUnstructuredGridCells(......).
+  static VTK_THREAD_RETURN_TYPE ThreadedClipUnstructuredGrid( void * arg );
        
   
   // Description:
@@ -262,9 +292,11 @@ protected:
   bool   UseValueAsOffset;
   double Value;
   double MergeTolerance;
+  int    NumberOfThreads;
   vtkCallbackCommand         * InternalProgressObserver;
   vtkImplicitFunction        * ClipFunction;
   vtkIncrementalPointLocator * Locator;
+  vtkMultiThreader           * Threader;
 
 private:
   vtkTableBasedClipDataSet( const vtkTableBasedClipDataSet &); // Not implemented.
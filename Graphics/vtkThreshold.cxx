@@ -103,9 +103,9 @@ int vtkThreshold::RequestData(
   vtkUnstructuredGrid *output = vtkUnstructuredGrid::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType cellId, newCellId;
+  vtkIdType cellId;
   vtkIdList *cellPts, *pointMap;
-  vtkIdList *newCellPts;
+  vtkIdList *newCellPts, *keptPoints, *keptCells;
   vtkCell *cell;
   vtkPoints *newPoints;
   int i, ptId, newId, numPts;
@@ -152,6 +152,11 @@ int vtkThreshold::RequestData(
 
   newCellPts = vtkIdList::New();     
 
+  // The attributes of the kept points and cells are copied at the end, in
+  // the order of their new ids.
+  keptPoints = vtkIdList::New();
+  keptCells = vtkIdList::New();
+
   // are we using pointScalars?
   usePointScalars = (inScalars->GetNumberOfTuples() == numPts);
   
@@ -199,7 +204,7 @@ int vtkThreshold::RequestData(
           input->GetPoint(ptId, x);
           newId = newPoints->InsertNextPoint(x);
           pointMap->SetId(ptId,newId);
-          outPD->CopyData(pd,ptId,newId);
+          keptPoints->InsertNextId(ptId);
           }
         newCellPts->InsertId(i,newId);
         }
@@ -213,18 +218,23 @@ int vtkThreshold::RequestData(
         vtkUnstructuredGrid::ConvertFaceStreamPointIds(
           newCellPts, pointMap->GetPointer(0));
         }
-      newCellId = output->InsertNextCell(cell->GetCellType(),newCellPts);
-      outCD->CopyData(cd,cellId,newCellId);
+      output->InsertNextCell(cell->GetCellType(),newCellPts);
+      keptCells->InsertNextId(cellId);
       newCellPts->Reset();
       } // satisfied thresholding
     } // for all cells
 
+  outPD->CopyConsecutiveData(pd,keptPoints,0);
+  outCD->CopyConsecutiveData(cd,keptCells,0);
+
   vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells() 
                 << " number of cells.");
 
   // now clean up / update ourselves
   pointMap->Delete();
   newCellPts->Delete();
+  keptPoints->Delete();
+  keptCells->Delete();
   
   output->SetPoints(newPoints);
   newPoints->Delete();
@@ -0,0 +1,208 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusIIReaderKeepFileOpen.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a small Exodus file, two hexahedra with a nodal variable over a few
+// time steps, and checks that vtkExodusIIReader with KeepFileOpen reads every
+// time step as a reader that opens the file for each update does, and that
+// it opens the file again once the file has been rewritten with one more
+// time step.
+
+#include "vtkDataArray.h"
+#include "vtkExodusIIReader.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "vtk_exodusII.h"
+
+static const char *FileName = "TestExodusIIReaderKeepFileOpen.exo";
+
+static const int NumberOfNodes = 12;
+
+static double Temperature(int step, int node)
+{
+  return 10. * step + node;
+}
+
+static int WriteFile(int numSteps)
+{
+  int compWordSize = 8;
+  int ioWordSize = 8;
+  int exoid = ex_create(FileName, EX_CLOBBER, &compWordSize, &ioWordSize);
+  if (exoid < 0)
+    {
+    cerr << "Can not write " << FileName << endl;
+    return 0;
+    }
+
+  double x[NumberOfNodes], y[NumberOfNodes], z[NumberOfNodes];
+  int i;
+  for (i = 0; i < NumberOfNodes; ++i)
+    {
+    x[i] = i % 3;
+    y[i] = (i / 3) % 2;
+    z[i] = i / 6;
+    }
+  int connect[16];
+  for (i = 0; i < 2; ++i)
+    {
+    int base = i + 1;
+    int *c = connect + 8 * i;
+    c[0] = base;
+    c[1] = base + 1;
+    c[2] = base + 4;
+    c[3] = base + 3;
+    c[4] = base + 6;
+    c[5] = base + 7;
+    c[6] = base + 10;
+    c[7] = base + 9;
+    }
+  char name[] = "T";
+  char *names[] = { name };
+  int rc = ex_put_init(exoid, "keep file open", 3, NumberOfNodes, 2, 1, 0, 0);
+  rc |= ex_put_coord(exoid, x, y, z);
+  rc |= ex_put_elem_block(exoid, 1, "HEX8", 2, 8, 0);
+  rc |= ex_put_elem_conn(exoid, 1, connect);
+  rc |= ex_put_var_param(exoid, "n", 1);
+  rc |= ex_put_var_names(exoid, "n", 1, names);
+  for (int step = 0; step < numSteps; ++step)
+    {
+    double time = step;
+    double values[NumberOfNodes];
+    for (i = 0; i < NumberOfNodes; ++i)
+      {
+      values[i] = Temperature(step, i);
+      }
+    rc |= ex_put_time(exoid, step + 1, &time);
+    rc |= ex_put_nodal_var(exoid, step + 1, 1, NumberOfNodes, values);
+    }
+  rc |= ex_close(exoid);
+  if (rc < 0)
+    {
+    cerr << "Could not write " << FileName << endl;
+    return 0;
+    }
+  return 1;
+}
+
+// Returns the block read for the given time step.
+static vtkUnstructuredGrid *ReadStep(vtkExodusIIReader *reader, int step)
+{
+  reader->SetTimeStep(step);
+  reader->Update();
+  vtkMultiBlockDataSet *blocks =
+    vtkMultiBlockDataSet::SafeDownCast(reader->GetOutput()->GetBlock(0));
+  vtkUnstructuredGrid *grid = blocks ?
+    vtkUnstructuredGrid::SafeDownCast(blocks->GetBlock(0)) : 0;
+  if (!grid || grid->GetNumberOfCells() != 2 ||
+      grid->GetNumberOfPoints() != NumberOfNodes)
+    {
+    cerr << "Time step " << step << ": unexpected mesh." << endl;
+    return 0;
+    }
+  return grid;
+}
+
+static int CheckStep(vtkExodusIIReader *reader, int step, const char *what)
+{
+  vtkUnstructuredGrid *grid = ReadStep(reader, step);
+  if (!grid)
+    {
+    return 0;
+    }
+  // the reader renumbers the points, the global ids are the node numbers
+  vtkDataArray *values = grid->GetPointData()->GetArray("T");
+  vtkDataArray *ids = grid->GetPointData()->GetGlobalIds();
+  if (!values || values->GetNumberOfTuples() != NumberOfNodes || !ids)
+    {
+    cerr << what << ": time step " << step << " has no variable." << endl;
+    return 0;
+    }
+  for (int i = 0; i < NumberOfNodes; ++i)
+    {
+    int node = static_cast<int>(ids->GetComponent(i, 0)) - 1;
+    if (values->GetComponent(i, 0) != Temperature(step, node))
+      {
+      cerr << what << ": time step " << step << " differs at node " << node
+           << "." << endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
+static void SetUp(vtkExodusIIReader *reader, int keepFileOpen)
+{
+  reader->SetFileName(FileName);
+  reader->SetKeepFileOpen(keepFileOpen);
+  reader->GenerateGlobalNodeIdArrayOn();
+  reader->UpdateInformation();
+  reader->SetPointResultArrayStatus("T", 1);
+}
+
+int TestExodusIIReaderKeepFileOpen(int, char *[])
+{
+  if (!WriteFile(3))
+    {
+    return 1;
+    }
+
+  vtkSmartPointer<vtkExodusIIReader> reopened =
+    vtkSmartPointer<vtkExodusIIReader>::New();
+  SetUp(reopened, 0);
+  vtkSmartPointer<vtkExodusIIReader> kept =
+    vtkSmartPointer<vtkExodusIIReader>::New();
+  SetUp(kept, 1);
+  if (reopened->GetNumberOfTimeSteps() != 3 ||
+      kept->GetNumberOfTimeSteps() != 3)
+    {
+    cerr << "Expected 3 time steps." << endl;
+    return 1;
+    }
+
+  // both readers see every time step, in any order
+  int ok = 1;
+  int steps[] = { 0, 2, 1, 2 };
+  for (int s = 0; ok && s < 4; ++s)
+    {
+    ok = CheckStep(reopened, steps[s], "KeepFileOpen off") &&
+      CheckStep(kept, steps[s], "KeepFileOpen on");
+    }
+  if (!ok)
+    {
+    return 1;
+    }
+
+  // a rewritten file is opened again, so the new time step is found
+  if (!WriteFile(4))
+    {
+    return 1;
+    }
+  kept->UpdateTimeInformation();
+  if (kept->GetNumberOfTimeSteps() != 4)
+    {
+    cerr << "The rewritten file was not opened again." << endl;
+    return 1;
+    }
+  kept->Modified();
+  ok = CheckStep(kept, 3, "KeepFileOpen on, rewritten file");
+
+  // and the file is closed when KeepFileOpen is turned off
+  kept->KeepFileOpenOff();
+  ok = ok && !kept->GetKeepFileOpen() &&
+    CheckStep(kept, 1, "KeepFileOpen turned off");
+
+  return !ok;
+}
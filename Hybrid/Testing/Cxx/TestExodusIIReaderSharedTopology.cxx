@@ -0,0 +1,191 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusIIReaderSharedTopology.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a small Exodus file, two hexahedra with a nodal variable over two
+// time steps, and checks that vtkExodusIIReader gives the output of the
+// second time step the very cell array of the first one, unmodified, along
+// with the values of the second time step.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkExodusIIReader.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "vtk_exodusII.h"
+
+static const char *FileName = "TestExodusIIReaderSharedTopology.exo";
+
+static const int NumberOfNodes = 12;
+
+static double Temperature(int step, int node)
+{
+  return 10. * step + node;
+}
+
+static int WriteFile(int numSteps)
+{
+  int compWordSize = 8;
+  int ioWordSize = 8;
+  int exoid = ex_create(FileName, EX_CLOBBER, &compWordSize, &ioWordSize);
+  if (exoid < 0)
+    {
+    cerr << "Can not write " << FileName << endl;
+    return 0;
+    }
+
+  double x[NumberOfNodes], y[NumberOfNodes], z[NumberOfNodes];
+  int i;
+  for (i = 0; i < NumberOfNodes; ++i)
+    {
+    x[i] = i % 3;
+    y[i] = (i / 3) % 2;
+    z[i] = i / 6;
+    }
+  int connect[16];
+  for (i = 0; i < 2; ++i)
+    {
+    int base = i + 1;
+    int *c = connect + 8 * i;
+    c[0] = base;
+    c[1] = base + 1;
+    c[2] = base + 4;
+    c[3] = base + 3;
+    c[4] = base + 6;
+    c[5] = base + 7;
+    c[6] = base + 10;
+    c[7] = base + 9;
+    }
+  char name[] = "T";
+  char *names[] = { name };
+  int rc = ex_put_init(exoid, "shared topology", 3, NumberOfNodes, 2, 1, 0, 0);
+  rc |= ex_put_coord(exoid, x, y, z);
+  rc |= ex_put_elem_block(exoid, 1, "HEX8", 2, 8, 0);
+  rc |= ex_put_elem_conn(exoid, 1, connect);
+  rc |= ex_put_var_param(exoid, "n", 1);
+  rc |= ex_put_var_names(exoid, "n", 1, names);
+  for (int step = 0; step < numSteps; ++step)
+    {
+    double time = step;
+    double values[NumberOfNodes];
+    for (i = 0; i < NumberOfNodes; ++i)
+      {
+      values[i] = Temperature(step, i);
+      }
+    rc |= ex_put_time(exoid, step + 1, &time);
+    rc |= ex_put_nodal_var(exoid, step + 1, 1, NumberOfNodes, values);
+    }
+  rc |= ex_close(exoid);
+  if (rc < 0)
+    {
+    cerr << "Could not write " << FileName << endl;
+    return 0;
+    }
+  return 1;
+}
+
+// Returns the block read for the given time step after checking its values.
+static vtkUnstructuredGrid *ReadStep(vtkExodusIIReader *reader, int step)
+{
+  reader->SetTimeStep(step);
+  reader->Update();
+  vtkMultiBlockDataSet *blocks =
+    vtkMultiBlockDataSet::SafeDownCast(reader->GetOutput()->GetBlock(0));
+  vtkUnstructuredGrid *grid = blocks ?
+    vtkUnstructuredGrid::SafeDownCast(blocks->GetBlock(0)) : 0;
+  if (!grid || !grid->GetCells() || grid->GetNumberOfCells() != 2 ||
+      grid->GetNumberOfPoints() != NumberOfNodes)
+    {
+    cerr << "Time step " << step << ": unexpected mesh." << endl;
+    return 0;
+    }
+  // the reader renumbers the points, the global ids are the node numbers
+  vtkDataArray *values = grid->GetPointData()->GetArray("T");
+  vtkDataArray *ids = grid->GetPointData()->GetGlobalIds();
+  if (!values || values->GetNumberOfTuples() != NumberOfNodes || !ids)
+    {
+    cerr << "Time step " << step << " has no variable." << endl;
+    return 0;
+    }
+  for (int i = 0; i < NumberOfNodes; ++i)
+    {
+    int node = static_cast<int>(ids->GetComponent(i, 0)) - 1;
+    if (values->GetComponent(i, 0) != Temperature(step, node))
+      {
+      cerr << "Time step " << step << " differs at node " << node << "."
+           << endl;
+      return 0;
+      }
+    }
+  return grid;
+}
+
+int TestExodusIIReaderSharedTopology(int, char *[])
+{
+  if (!WriteFile(2))
+    {
+    return 1;
+    }
+
+  vtkSmartPointer<vtkExodusIIReader> reader =
+    vtkSmartPointer<vtkExodusIIReader>::New();
+  reader->SetFileName(FileName);
+  reader->GenerateGlobalNodeIdArrayOn();
+  reader->UpdateInformation();
+  reader->SetPointResultArrayStatus("T", 1);
+  if (reader->GetNumberOfTimeSteps() != 2)
+    {
+    cerr << "Expected 2 time steps." << endl;
+    return 1;
+    }
+
+  vtkUnstructuredGrid *grid = ReadStep(reader, 0);
+  if (!grid)
+    {
+    return 1;
+    }
+  // hold on to the cells, so that a new cell array can not take their place
+  vtkSmartPointer<vtkCellArray> cells = grid->GetCells();
+  unsigned long mtime = cells->GetMTime();
+  vtkIdType numEntries = cells->GetNumberOfConnectivityEntries();
+
+  grid = ReadStep(reader, 1);
+  if (!grid)
+    {
+    return 1;
+    }
+  int ok = 1;
+  if (grid->GetCells() != cells.GetPointer())
+    {
+    cerr << "Time step 1 does not share the cell array of time step 0."
+         << endl;
+    ok = 0;
+    }
+  else if (cells->GetMTime() != mtime)
+    {
+    cerr << "The shared cell array was modified: its MTime went from "
+         << mtime << " to " << cells->GetMTime() << "." << endl;
+    ok = 0;
+    }
+  if (cells->GetNumberOfCells() != 2 ||
+      cells->GetNumberOfConnectivityEntries() != numEntries)
+    {
+    cerr << "The cells of time step 0 changed." << endl;
+    ok = 0;
+    }
+
+  return !ok;
+}
@@ -0,0 +1,244 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLSDynaReaderSharedTopology.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a small LS-DYNA database, two hexahedra with two time steps and a
+// mesh adaptation with one more time step, and checks that vtkLSDynaReader
+// shares the cell types, locations and connectivity of the first time step
+// with the second one, and reads them again after the adaptation and after
+// the status of the material ids changed.
+
+#include "vtkCellArray.h"
+#include "vtkDirectory.h"
+#include "vtkLSDynaReader.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtkstd/string>
+
+#include <stdio.h>
+#include <string.h>
+
+static const char *Directory = "TestLSDynaReaderSharedTopology";
+
+static const int NumberOfNodes = 12;
+static const int NumberOfSolids = 2;
+
+static void WriteInt(FILE *fp, int value)
+{
+  fwrite(&value, sizeof(int), 1, fp);
+}
+
+static void WriteFloat(FILE *fp, float value)
+{
+  fwrite(&value, sizeof(float), 1, fp);
+}
+
+// Writes the control words and the geometry of a database with 4 byte words
+// in the native byte order, followed by the given time steps.
+static int WriteFile(const char *name, const float *times, int numSteps)
+{
+  vtkstd::string path = vtkstd::string(Directory) + "/" + name;
+  FILE *fp = fopen(path.c_str(), "wb");
+  if (!fp)
+    {
+    cerr << "Can not write " << path.c_str() << endl;
+    return 0;
+    }
+
+  // control section: title, run time, date, machine, code and version
+  char title[40];
+  memset(title, ' ', 40);
+  memcpy(title, "shared topology", 15);
+  fwrite(title, 1, 40, fp);
+  WriteInt(fp, 0);
+  WriteInt(fp, 0);
+  WriteInt(fp, 0);
+  WriteInt(fp, 6);
+  WriteFloat(fp, 960.f);
+  int control[49];
+  memset(control, 0, sizeof(control));
+  control[0] = 4;               // NDIM, unpacked connectivity
+  control[1] = NumberOfNodes;   // NUMNP
+  control[2] = 6;               // ICODE
+  control[5] = 1;               // IU, nodal displacements in each state
+  control[8] = NumberOfSolids;  // NEL8
+  control[9] = 1;               // NUMMAT8
+  control[12] = 7;              // NV3D
+  for (int w = 0; w < 49; ++w)
+    {
+    WriteInt(fp, control[w]);
+    }
+
+  // geometry: a row of two unit cubes along x, one material
+  int i, j;
+  for (i = 0; i < NumberOfNodes; ++i)
+    {
+    WriteFloat(fp, static_cast<float>(i % 3));
+    WriteFloat(fp, static_cast<float>((i / 3) % 2));
+    WriteFloat(fp, static_cast<float>(i / 6));
+    }
+  for (i = 0; i < NumberOfSolids; ++i)
+    {
+    int base = i + 1;
+    WriteInt(fp, base);
+    WriteInt(fp, base + 1);
+    WriteInt(fp, base + 4);
+    WriteInt(fp, base + 3);
+    WriteInt(fp, base + 6);
+    WriteInt(fp, base + 7);
+    WriteInt(fp, base + 10);
+    WriteInt(fp, base + 9);
+    WriteInt(fp, 1);
+    }
+
+  // states: the time, the displaced nodes and the solid variables
+  for (int s = 0; s < numSteps; ++s)
+    {
+    WriteFloat(fp, times[s]);
+    for (i = 0; i < NumberOfNodes; ++i)
+      {
+      WriteFloat(fp, static_cast<float>(i % 3) + times[s]);
+      WriteFloat(fp, static_cast<float>((i / 3) % 2));
+      WriteFloat(fp, static_cast<float>(i / 6));
+      }
+    for (i = 0; i < NumberOfSolids; ++i)
+      {
+      for (j = 0; j < 7; ++j)
+        {
+        WriteFloat(fp, times[s] * j);
+        }
+      }
+    }
+  WriteFloat(fp, -999999.f);
+  fclose(fp);
+  return 1;
+}
+
+struct Topology
+{
+  vtkSmartPointer<vtkUnsignedCharArray> Types;
+  vtkSmartPointer<vtkIdTypeArray> Locations;
+  vtkSmartPointer<vtkCellArray> Connectivity;
+};
+
+// Reads a time step and keeps references to the topology of the solids, so
+// that new arrays can not be allocated where the old ones were.
+static int ReadStep(vtkLSDynaReader *reader, vtkIdType step, Topology &topo)
+{
+  reader->SetTimeStep(step);
+  reader->Update();
+  vtkUnstructuredGrid *solids =
+    vtkUnstructuredGrid::SafeDownCast(reader->GetOutput()->GetBlock(0));
+  if (!solids || solids->GetNumberOfCells() != NumberOfSolids ||
+      solids->GetNumberOfPoints() != NumberOfNodes)
+    {
+    cerr << "Time step " << step << ": unexpected solid mesh." << endl;
+    return 0;
+    }
+  double bounds[6];
+  solids->GetBounds(bounds);
+  if (bounds[1] != 2 + reader->GetTimeValue(step))
+    {
+    cerr << "Time step " << step << ": the points were not read." << endl;
+    return 0;
+    }
+  topo.Types = solids->GetCellTypesArray();
+  topo.Locations = solids->GetCellLocationsArray();
+  topo.Connectivity = solids->GetCells();
+  return 1;
+}
+
+static int IsShared(const Topology &a, const Topology &b)
+{
+  return a.Types == b.Types && a.Locations == b.Locations &&
+    a.Connectivity == b.Connectivity;
+}
+
+static int IsDistinct(const Topology &a, const Topology &b)
+{
+  return a.Types != b.Types && a.Locations != b.Locations &&
+    a.Connectivity != b.Connectivity;
+}
+
+int TestLSDynaReaderSharedTopology(int, char *[])
+{
+  vtkDirectory::MakeDirectory(Directory);
+  const float times[] = { 0.f, 0.5f, 1.f };
+  if (!WriteFile("d3plot", times, 2) || !WriteFile("d3plotaa", times + 2, 1))
+    {
+    return 1;
+    }
+
+  vtkSmartPointer<vtkLSDynaReader> reader =
+    vtkSmartPointer<vtkLSDynaReader>::New();
+  reader->SetFileName((vtkstd::string(Directory) + "/d3plot").c_str());
+  reader->RemoveDeletedCellsOff();
+  reader->UpdateInformation();
+  if (reader->GetNumberOfTimeSteps() != 3)
+    {
+    cerr << "Expected 3 time steps, got " << reader->GetNumberOfTimeSteps()
+         << endl;
+    return 1;
+    }
+
+  // the second time step shares the topology of the first one
+  Topology step0, step1, step2, step1Again, step1Status;
+  if (!ReadStep(reader, 0, step0) || !ReadStep(reader, 1, step1))
+    {
+    return 1;
+    }
+  int ok = 1;
+  if (!IsShared(step0, step1))
+    {
+    cerr << "The topology of time step 0 is not shared with time step 1."
+         << endl;
+    ok = 0;
+    }
+
+  // the adaptation changes the topology
+  if (!ReadStep(reader, 2, step2) || !ReadStep(reader, 1, step1Again))
+    {
+    return 1;
+    }
+  if (!IsDistinct(step1, step2) || !IsDistinct(step2, step1Again))
+    {
+    cerr << "The topology was shared across a mesh adaptation." << endl;
+    ok = 0;
+    }
+  if (step1Again.Connectivity->GetNumberOfCells() != NumberOfSolids ||
+      step1Again.Connectivity->GetNumberOfConnectivityEntries() !=
+      step0.Connectivity->GetNumberOfConnectivityEntries())
+    {
+    cerr << "The topology read again differs." << endl;
+    ok = 0;
+    }
+
+  // so does the status of the material ids
+  reader->SetCellArrayStatus(vtkLSDynaReader::SOLID, "Material",
+    !reader->GetCellArrayStatus(vtkLSDynaReader::SOLID, "Material"));
+  if (!ReadStep(reader, 1, step1Status))
+    {
+    return 1;
+    }
+  if (!IsDistinct(step1Again, step1Status))
+    {
+    cerr << "The topology was shared after a cell array status changed."
+         << endl;
+    ok = 0;
+    }
+
+  return !ok;
+}
@@ -2,119 +2,28 @@
 #define __vtkExodusIICache_h
 
 // ============================================================================
-// The following classes define an LRU cache for data arrays
-// loaded by the Exodus reader. Here's how they work:
-// 
-// The actual cache consists of two STL containers: a set of
-// cache entries (vtkExodusIICacheEntry) and a list of
-// cache references (vtkExodusIICacheRef). The entries in
-// these containers are sorted for fast retrieval:
-// 1. The cache entries are indexed by the timestep, the
-//    object type (edge block, face set, ...), and the
-//    object ID (if one exists). When you call Find() to
-//    retrieve a cache entry, you provide a key containing
-//    this information and the array is returned if it exists.
-// 2. The list of cache references are stored in "least-recently-used"
-//    order. The least recently referenced array is the first in
-//    the list. Whenever you request an entry with Find(), it is
-//    moved to the back of the list if it exists.
-// This makes retrieving arrays O(n log n) and popping LRU
-// entries O(1). Each cache entry stores an iterator into
-// the list of references so that it can be located quickly for
-// removal.
+// vtkExodusIICache is the Exodus reader's view of the process-wide
+// vtkDataArrayCache: each cache is a client of the global cache, so the
+// arrays of all Exodus readers (and of other readers using the global
+// cache) share one memory budget and are evicted in least-recently-used
+// order across all of them.
+//
+// Cache entries are indexed by the timestep, the object type (edge
+// block, face set, ...), the object ID (if one exists) and the array ID.
+// When you call Find() to retrieve a cache entry, you provide a key
+// containing this information and the array is returned if it exists,
+// with a reference that you must release.
+// Whenever you request an entry with Find(), it is marked as the most
+// recently used one.
 
 #include "vtkObject.h"
 
-#include <vtkstd/map> // used for cache storage
-#include <vtkstd/list> // use for LRU ordering
+#include "vtkDataArrayCache.h" // for vtkDataArrayCacheKey
 
 //BTX
-class VTK_HYBRID_EXPORT vtkExodusIICacheKey
-{
-public:
-  int Time;
-  int ObjectType;
-  int ObjectId;
-  int ArrayId;
-  vtkExodusIICacheKey()
-    {
-    Time = -1;
-    ObjectType = -1;
-    ObjectId = -1;
-    ArrayId = -1;
-    }
-  vtkExodusIICacheKey( int time, int objType, int objId, int arrId )
-    {
-    Time = time;
-    ObjectType = objType;
-    ObjectId = objId;
-    ArrayId = arrId;
-    }
-  vtkExodusIICacheKey( const vtkExodusIICacheKey& src )
-    {
-    Time = src.Time;
-    ObjectType = src.ObjectType;
-    ObjectId = src.ObjectId;
-    ArrayId = src.ArrayId;
-    }
-  bool match( const vtkExodusIICacheKey&other, const vtkExodusIICacheKey& pattern ) const
-    {
-    if ( pattern.Time && this->Time != other.Time )
-      return false;
-    if ( pattern.ObjectType && this->ObjectType != other.ObjectType )
-      return false;
-    if ( pattern.ObjectId && this->ObjectId != other.ObjectId )
-      return false;
-    if ( pattern.ArrayId && this->ArrayId != other.ArrayId )
-      return false;
-    return true;
-    }
-  bool operator < ( const vtkExodusIICacheKey& other ) const
-    {
-    if ( this->Time < other.Time )
-      return true;
-    else if ( this->Time > other.Time )
-      return false;
-    if ( this->ObjectType < other.ObjectType )
-      return true;
-    else if ( this->ObjectType > other.ObjectType )
-      return false;
-    if ( this->ObjectId < other.ObjectId )
-      return true;
-    else if ( this->ObjectId > other.ObjectId )
-      return false;
-    if ( this->ArrayId < other.ArrayId )
-      return true;
-    return false;
-    }
-};
+typedef vtkDataArrayCacheKey vtkExodusIICacheKey;
 
-class vtkExodusIICacheEntry;
-class vtkExodusIICache;
 class vtkDataArray;
-
-typedef vtkstd::map<vtkExodusIICacheKey,vtkExodusIICacheEntry*> vtkExodusIICacheSet;
-typedef vtkstd::map<vtkExodusIICacheKey,vtkExodusIICacheEntry*>::iterator vtkExodusIICacheRef;
-typedef vtkstd::list<vtkExodusIICacheRef> vtkExodusIICacheLRU;
-typedef vtkstd::list<vtkExodusIICacheRef>::iterator vtkExodusIICacheLRURef;
-
-class VTK_HYBRID_EXPORT vtkExodusIICacheEntry
-{
-public:
-  vtkExodusIICacheEntry();
-  vtkExodusIICacheEntry( vtkDataArray* arr );
-  vtkExodusIICacheEntry( const vtkExodusIICacheEntry& other );
-
-  ~vtkExodusIICacheEntry();
-
-  vtkDataArray* GetValue() { return this->Value; }
-
-protected:
-  vtkDataArray* Value;
-  vtkExodusIICacheLRURef LRUEntry;
-
-  friend class vtkExodusIICache;
-};
 //ETX
 
 class VTK_HYBRID_EXPORT vtkExodusIICache : public vtkObject
@@ -127,15 +36,21 @@ public:
   /// Empty the cache
   void Clear();
 
-  /// Set the maximum allowable cache size. This will remove cache entries if the capacity is reduced below the current size.
+  /** Set the maximum allowable cache size. This will remove cache entries if the capacity is reduced below the current size.
+    * Until it is set, the cache is only bounded by the capacity of the global vtkDataArrayCache, which
+    * also bounds the arrays of all caches together.
+    */
   void SetCacheCapacity( double sizeInMiB );
 
   /** See how much cache space is left.
-    * This is the difference between the capacity and the size of the cache.
+    * This is the difference between the capacity and the size of the cache,
+    * or the space left in the global cache if that is less.
     * The result is in MiB.
     */
-  double GetSpaceLeft()
-    { return this->Capacity - this->Size; }
+  double GetSpaceLeft();
+
+  /// The current size of the cache (i.e., the size of the all the arrays it currently contains) in MiB.
+  double GetSize();
 
   /** Remove cache entries until the size of the cache is at or below the given size.
     * Returns a nonzero value if deletions were required.
@@ -148,8 +63,10 @@ public:
 
   /** Determine whether a cache entry exists. If it does, return it -- otherwise return NULL.
     * If a cache entry exists, it is marked as most recently used.
+    * The caller owns a reference to the array returned and must Delete() it, since the
+    * global cache can drop the array at any time on behalf of another reader.
     */
-  vtkDataArray*& Find( vtkExodusIICacheKey );
+  vtkDataArray* Find( vtkExodusIICacheKey );
 
   /** Invalidate a cache entry (drop it from the cache) if the key exists.
     * This does nothing if the cache entry does not exist.
@@ -176,28 +93,11 @@ protected:
   /// Destructor.
   ~vtkExodusIICache();
 
-
-  /// Avoid (some) FP problems
-  void RecomputeSize();
-
-  /// The capacity of the cache (i.e., the maximum size of all arrays it contains) in MiB.
+  /// The capacity of the cache (i.e., the maximum size of all arrays it contains) in MiB, negative if unset.
   double Capacity;
 
-  /// The current size of the cache (i.e., the size of the all the arrays it currently contains) in MiB.
-  double Size;
-
-  //BTX
-  /** A least-recently-used (LRU) cache to hold arrays.
-    * During RequestData the cache may contain more than its maximum size since
-    * the user may request more data than the cache can hold. However, the cache
-    * is expunged whenever a new array is loaded. Never count on the cache holding
-    * what you request for very long.
-    */
-  vtkExodusIICacheSet Cache;
-
-  /// The actual LRU list (indices into the cache ordered least to most recently used).
-  vtkExodusIICacheLRU LRU;
-  //ETX
+  /// The client id of this cache in the global vtkDataArrayCache, which holds the arrays.
+  int Client;
 
 private:
   vtkExodusIICache( const vtkExodusIICache& ); // Not implemented
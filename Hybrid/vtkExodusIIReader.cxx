@@ -357,6 +357,9 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 {
   this->Exoid = -1;
   this->ExodusVersion = -1.;
+  this->OpenFileModifiedTime = 0;
+  this->OpenFileLength = 0;
+  this->KeepFileOpen = 0;
 
   this->AppWordSize = 8;
   this->DiskWordSize = 8;
@@ -1525,7 +1528,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
 
   if ( arr )
     {
-    //
+    // Find() gave us a reference of our own.
+    this->HeldArrays.push_back( arr );
+    arr->Delete();
     return arr;
     }
 
@@ -2677,12 +2682,12 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     }
 
   // Even if the array is larger than the allowable cache size, it will keep the most recent insertion.
-  // So, we delete our reference knowing that the Cache will keep the object "alive" until whatever
-  // called GetCacheOrRead() references the array. But, once you get an array from GetCacheOrRead(),
-  // you better start running!
+  // Other readers share the cache and may drop the array at any time, though, so our reference is
+  // moved to HeldArrays, which keeps the array alive until the end of RequestData().
   if ( arr )
     {
     this->Cache->Insert( key, arr );
+    this->HeldArrays.push_back( arr );
     arr->FastDelete();
     }
   return arr;
@@ -3487,6 +3492,7 @@ void vtkExodusIIReaderPrivate::PrintData( ostream& os, vtkIndent indent )
   os << indent << "GenerateObjectIdArray: " << this->GenerateObjectIdArray << "\n";
   os << indent << "GenerateFileIdArray: " << this->GenerateFileIdArray << "\n";
   os << indent << "FileId: " << this->FileId << "\n";
+  os << indent << "KeepFileOpen: " << this->KeepFileOpen << "\n";
 }
 
 int vtkExodusIIReaderPrivate::OpenFile( const char* filename )
@@ -3497,8 +3503,22 @@ int vtkExodusIIReaderPrivate::OpenFile( const char* filename )
     return 0;
     }
 
+  // The file is only checked for changes when it may be kept open.
+  long modifiedTime = 0;
+  unsigned long length = 0;
+  if ( this->KeepFileOpen )
+    {
+    modifiedTime = vtksys::SystemTools::ModifiedTime( filename );
+    length = vtksys::SystemTools::FileLength( filename );
+    }
   if ( this->Exoid >= 0 )
     {
+    if ( this->KeepFileOpen && this->OpenFileName == filename &&
+      this->OpenFileModifiedTime == modifiedTime &&
+      this->OpenFileLength == length )
+      {
+      return 1;
+      }
     this->CloseFile();
     }
 
@@ -3510,6 +3530,9 @@ int vtkExodusIIReaderPrivate::OpenFile( const char* filename )
     vtkErrorMacro( "Unable to open \"" << filename << "\" for reading" );
     return 0;
     }
+  this->OpenFileName = filename;
+  this->OpenFileModifiedTime = modifiedTime;
+  this->OpenFileLength = length;
 
   int numNodesInFile;
   char dummyChar;
@@ -3529,6 +3552,28 @@ int vtkExodusIIReaderPrivate::CloseFile()
   return 0;
 }
 
+int vtkExodusIIReaderPrivate::ReleaseFile()
+{
+  if ( this->KeepFileOpen )
+    {
+    return 0;
+    }
+  return this->CloseFile();
+}
+
+void vtkExodusIIReaderPrivate::SetKeepFileOpen( int k )
+{
+  if ( this->KeepFileOpen == k )
+    return;
+
+  this->KeepFileOpen = k;
+  this->Modified();
+  if ( ! k )
+    {
+    this->CloseFile();
+    }
+}
+
 
 
 int vtkExodusIIReaderPrivate::UpdateTimeInformation()
@@ -4663,7 +4708,10 @@ int vtkExodusIIReaderPrivate::RequestData( vtkIdType timeStep, vtkMultiBlockData
   this->AssembleOutputEdgeDecorations();
   this->AssembleOutputFaceDecorations();
 
-  this->CloseFile();
+  this->ReleaseFile();
+
+  // The output references the arrays it uses by now.
+  this->HeldArrays.clear();
 
   return 0;
 }
@@ -4857,7 +4905,6 @@ void vtkExodusIIReaderPrivate::ResetSettings()
 void vtkExodusIIReaderPrivate::ResetCache()
 {
   this->Cache->Clear();
-  this->Cache->SetCacheCapacity( 0.0 ); // FIXME: Perhaps Cache should have a Reset and a Clear method?  
   this->ClearConnectivityCaches();
 }
 
@@ -5546,7 +5593,7 @@ int vtkExodusIIReader::RequestInformation(
       this->Metadata->BuildSIL();
       this->SILUpdateStamp++; // update the timestamp.
 
-      this->Metadata->CloseFile();
+      this->Metadata->ReleaseFile();
       newMetadata = 1;
       }
     else
@@ -5721,6 +5768,15 @@ int vtkExodusIIReader::GetGlobalNodeID( vtkDataSet* data, int localID )
 int vtkExodusIIReader::GetGlobalNodeID( vtkDataSet* data, int localID, int searchType )
 { (void)data; (void)localID; (void)searchType; return ID_NOT_FOUND; }
 
+void vtkExodusIIReader::SetKeepFileOpen( int k )
+{
+  this->Metadata->SetKeepFileOpen( k );
+}
+int vtkExodusIIReader::GetKeepFileOpen()
+{
+  return this->Metadata->GetKeepFileOpen();
+}
+
 void vtkExodusIIReader::SetApplyDisplacements( int d )
 {
   this->Metadata->SetApplyDisplacements( d );
@@ -6662,7 +6718,7 @@ void vtkExodusIIReader::UpdateTimeInformation()
         this->TimeStepRange[1] = nTimes - 1;
         }
       }
-    this->Metadata->CloseFile();
+    this->Metadata->ReleaseFile();
     }
 }
 
@@ -29,6 +29,11 @@
 // default cell and point arrays are not loaded.  However, the user can flag 
 // arrays to load with the methods "SetPointArrayStatus" and
 // "SetCellArrayStatus".  The reader DOES NOT respond to piece requests
+//
+// The connectivity of each block and set is read once and shared by
+// reference with the outputs of all time steps until the cache is reset, so
+// filters can tell that the topology did not change from the identity and
+// modification time of the cell arrays.
 // 
 
 
@@ -244,6 +249,15 @@ public:
       int searchType );
   static const char* GetImplicitNodeIdArrayName() { return "ImplicitNodeId"; }  
 
+  // Description:
+  // Keep the Exodus file open between updates instead of opening it for
+  // each one, so that changing time step does not read the file header
+  // again.  The file is opened again if its modification time or length
+  // changes.  By default, this is OFF.
+  virtual void SetKeepFileOpen( int k );
+  int GetKeepFileOpen();
+  vtkBooleanMacro(KeepFileOpen, int);
+
   // Description:
   // Geometric locations can include displacements.  By default, 
   // this is ON.  The nodal positions are 'displaced' by the
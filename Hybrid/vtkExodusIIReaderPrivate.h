@@ -12,6 +12,7 @@
 class vtkMultiProcessController;
 #endif // VTK_USE_PARALLEL
 
+#include "vtkSmartPointer.h" // for HeldArrays
 #include "vtksys/RegularExpression.hxx"
 
 #include <vtkstd/map>
@@ -39,6 +40,18 @@ public:
   /// Close any ExodusII file currently open for reading. Returns 0 on success.
   int CloseFile();
 
+  /** Close the file currently open for reading unless KeepFileOpen is set,
+    * in which case OpenFile() reuses it as long as the file keeps its
+    * modification time and length. Returns 0 on success.
+    */
+  int ReleaseFile();
+
+  /** Keep the file open between requests so that changing time step does
+    * not have ex_open() read the file header again.
+    */
+  virtual void SetKeepFileOpen( int k );
+  vtkGetMacro(KeepFileOpen,int);
+
   /// Get metadata for an open file with handle \a exoid.
   int RequestInformation();
 
@@ -614,6 +627,8 @@ protected:
     * read it from the file.
     * This function can still return 0 if you are foolish enough to request an 
     * array not present in the file, grasshopper.
+    * The array is held by HeldArrays until the end of RequestData(), so it stays
+    * valid even if another reader drops it from the global cache meanwhile.
     */
   vtkDataArray* GetCacheOrRead( vtkExodusIICacheKey );
 
@@ -772,6 +787,13 @@ protected:
   /// The handle of the currently open file.
   int Exoid;
 
+  /// The name, modification time and length of the currently open file.
+  vtkStdString OpenFileName;
+  long OpenFileModifiedTime;
+  unsigned long OpenFileLength;
+
+  int KeepFileOpen;
+
   /// Parameters describing the currently open Exodus file.
   struct ex_init_params ModelParameters;
 
@@ -802,6 +824,9 @@ protected:
   /// A least-recently-used cache to hold raw arrays.
   vtkExodusIICache* Cache;
 
+  /// References to the arrays returned by GetCacheOrRead(), released at the end of RequestData().
+  vtkstd::vector<vtkSmartPointer<vtkDataArray> > HeldArrays;
+
   int ApplyDisplacements;
   float DisplacementMagnitude;
   int HasModeShapes;
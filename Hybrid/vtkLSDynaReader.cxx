@@ -1158,6 +1158,14 @@ public:
   // Number of bytes required to store a single timestep
   vtkIdType StateSize;
 
+  /// Cell topology and material ids of each cell type, read for an earlier time step.
+  /// The outputs of later time steps at the same adaptation level share these arrays by reference.
+  vtkUnstructuredGrid* CachedTopology[vtkLSDynaReader::NUM_CELL_TYPES];
+  /// Adaptation level of the cached topology, or -1 when no topology is cached.
+  int CachedTopologyAdaptLevel;
+  /// Status of the material and segment id arrays when the topology was cached.
+  vtkstd::vector<int> CachedTopologyStatus;
+
   vtkLSDynaReaderPrivate()
     {
     this->FileIsValid = 0;
@@ -1180,7 +1188,28 @@ public:
       this->CellArrayNames[cellType] = blankNames;
       this->CellArrayComponents[cellType] = blankNumbers;
       this->CellArrayStatus[cellType] = blankNumbers;
+      this->CachedTopology[cellType] = 0;
       }
+    this->CachedTopologyAdaptLevel = -1;
+    }
+
+  ~vtkLSDynaReaderPrivate()
+    {
+    this->ClearTopology();
+    }
+
+  void ClearTopology()
+    {
+    for ( int cellType = 0; cellType < vtkLSDynaReader::NUM_CELL_TYPES; ++cellType )
+      {
+      if ( this->CachedTopology[cellType] )
+        {
+        this->CachedTopology[cellType]->Delete();
+        this->CachedTopology[cellType] = 0;
+        }
+      }
+    this->CachedTopologyAdaptLevel = -1;
+    this->CachedTopologyStatus.clear();
     }
 
   bool AddPointArray( vtkstd::string name, int numComponents, int status )
@@ -1273,6 +1302,8 @@ public:
 
     this->RigidSurfaceSegmentSizes.clear();
     this->TimeValues.clear();
+
+    this->ClearTopology();
     }
 
   /// Dump the dictionary of Dyna keywords and their values.
@@ -3486,6 +3517,102 @@ int vtkLSDynaReader::ReadNodes()
   return 0;
 }
 
+// Status of the cell arrays that ReadConnectivityAndMaterial() creates.
+// The cached topology may only be shared while it stays the same.
+static void vtkLSDynaGetTopologyStatus( vtkLSDynaReader* reader, int readRigidRoadMvmt, vtkstd::vector<int>& status )
+{
+  status.clear();
+  status.push_back( readRigidRoadMvmt );
+  for ( int cellType = 0; cellType < vtkLSDynaReader::NUM_CELL_TYPES; ++cellType )
+    {
+    status.push_back( reader->GetCellArrayStatus( cellType, LS_ARRAYNAME_MATERIAL ) );
+    }
+  status.push_back( reader->GetCellArrayStatus( vtkLSDynaReader::ROAD_SURFACE, LS_ARRAYNAME_SEGMENTID ) );
+}
+
+int vtkLSDynaReader::ShareCachedTopology()
+{
+  vtkLSDynaReaderPrivate* p = this->P;
+  if ( p->CachedTopologyAdaptLevel < 0 || p->CachedTopologyAdaptLevel != p->Fam.GetCurrentAdaptLevel() )
+    {
+    return 0;
+    }
+
+  vtkstd::vector<int> status;
+  vtkLSDynaGetTopologyStatus( this, p->ReadRigidRoadMvmt, status );
+  if ( status != p->CachedTopologyStatus )
+    {
+    p->ClearTopology();
+    return 0;
+    }
+
+  vtkUnstructuredGrid* outputs[vtkLSDynaReader::NUM_CELL_TYPES];
+  outputs[vtkLSDynaReader::PARTICLE] = this->OutputParticles;
+  outputs[vtkLSDynaReader::BEAM] = this->OutputBeams;
+  outputs[vtkLSDynaReader::SHELL] = this->OutputShell;
+  outputs[vtkLSDynaReader::THICK_SHELL] = this->OutputThickShell;
+  outputs[vtkLSDynaReader::SOLID] = this->OutputSolid;
+  outputs[vtkLSDynaReader::RIGID_BODY] = this->OutputRigidBody;
+  outputs[vtkLSDynaReader::ROAD_SURFACE] = this->OutputRoadSurface;
+  for ( int cellType = 0; cellType < vtkLSDynaReader::NUM_CELL_TYPES; ++cellType )
+    {
+    // Share the arrays by reference so that their modification times tell
+    // downstream filters that the topology did not change.
+    vtkUnstructuredGrid* cached = p->CachedTopology[cellType];
+    outputs[cellType]->SetCells( cached->GetCellTypesArray(), cached->GetCellLocationsArray(), cached->GetCells(), 0, 0 );
+    vtkDataArray* arr = cached->GetCellData()->GetArray( LS_ARRAYNAME_MATERIAL );
+    if ( arr )
+      {
+      outputs[cellType]->GetCellData()->AddArray( arr );
+      }
+    arr = cached->GetCellData()->GetArray( LS_ARRAYNAME_SEGMENTID );
+    if ( arr )
+      {
+      outputs[cellType]->GetCellData()->AddArray( arr );
+      }
+    }
+  return 1;
+}
+
+void vtkLSDynaReader::CacheTopology()
+{
+  vtkLSDynaReaderPrivate* p = this->P;
+  p->ClearTopology();
+
+  vtkUnstructuredGrid* outputs[vtkLSDynaReader::NUM_CELL_TYPES];
+  outputs[vtkLSDynaReader::PARTICLE] = this->OutputParticles;
+  outputs[vtkLSDynaReader::BEAM] = this->OutputBeams;
+  outputs[vtkLSDynaReader::SHELL] = this->OutputShell;
+  outputs[vtkLSDynaReader::THICK_SHELL] = this->OutputThickShell;
+  outputs[vtkLSDynaReader::SOLID] = this->OutputSolid;
+  outputs[vtkLSDynaReader::RIGID_BODY] = this->OutputRigidBody;
+  outputs[vtkLSDynaReader::ROAD_SURFACE] = this->OutputRoadSurface;
+  for ( int cellType = 0; cellType < vtkLSDynaReader::NUM_CELL_TYPES; ++cellType )
+    {
+    if ( ! outputs[cellType]->GetCells() || ! outputs[cellType]->GetCellTypesArray() || ! outputs[cellType]->GetCellLocationsArray() )
+      {
+      // Nothing to share; read the connectivity again next time.
+      p->ClearTopology();
+      return;
+      }
+    vtkUnstructuredGrid* cached = vtkUnstructuredGrid::New();
+    cached->SetCells( outputs[cellType]->GetCellTypesArray(), outputs[cellType]->GetCellLocationsArray(), outputs[cellType]->GetCells(), 0, 0 );
+    vtkDataArray* arr = outputs[cellType]->GetCellData()->GetArray( LS_ARRAYNAME_MATERIAL );
+    if ( arr )
+      {
+      cached->GetCellData()->AddArray( arr );
+      }
+    arr = outputs[cellType]->GetCellData()->GetArray( LS_ARRAYNAME_SEGMENTID );
+    if ( arr )
+      {
+      cached->GetCellData()->AddArray( arr );
+      }
+    p->CachedTopology[cellType] = cached;
+    }
+  p->CachedTopologyAdaptLevel = p->Fam.GetCurrentAdaptLevel();
+  vtkLSDynaGetTopologyStatus( this, p->ReadRigidRoadMvmt, p->CachedTopologyStatus );
+}
+
 int vtkLSDynaReader::ReadConnectivityAndMaterial()
 {
   vtkLSDynaReaderPrivate* p = this->P;
@@ -4925,11 +5052,16 @@ int vtkLSDynaReader::RequestData(
     return 1;
     }
 
-  // Always read connectivity info
-  if ( this->ReadConnectivityAndMaterial() )
+  // Always read connectivity info, unless an earlier time step at the same
+  // adaptation level has read it already
+  if ( ! this->ShareCachedTopology() )
     {
-    vtkErrorMacro( "Could not read connectivity." );
-    return 1;
+    if ( this->ReadConnectivityAndMaterial() )
+      {
+      vtkErrorMacro( "Could not read connectivity." );
+      return 1;
+      }
+    this->CacheTopology();
     }
   this->UpdateProgress( 0.5 );
 
@@ -48,6 +48,12 @@
 // meshes.  If you want the number of cells in a specific mesh, there are
 // separate routines for each mesh type.
 //
+// The connectivity, cell types and material ids of each mesh are read once
+// per mesh adaptation and shared by reference with the meshes of later time
+// steps, which only get new points and attributes.  Filters can tell that
+// the topology did not change from the identity and modification time of
+// the cell arrays.
+//
 // .SECTION "Developer Notes"
 
 // LSDyna files contain 3 different types of sections: control, data, and
@@ -546,6 +552,14 @@ protected:
   virtual int ReadDeletion();
   virtual int ReadSPHState( vtkIdType );
 
+  // Description:
+  // Share the connectivity and material ids read for an earlier time step
+  // with the current output meshes.  Returns 1 if they were shared and 0 if
+  // ReadConnectivityAndMaterial() must be called, after which
+  // CacheTopology() keeps them for later time steps.
+  int ShareCachedTopology();
+  void CacheTopology();
+
   // Description:
   // Called from within ReadHeaderInformation() to read part names
   // associated with material IDs.
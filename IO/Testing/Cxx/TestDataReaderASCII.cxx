@@ -0,0 +1,277 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataReaderASCII.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkDataReader parses ascii values exactly as operator>> in
+// the classic locale does, one at a time and many at once, that it
+// rejects what operator>> rejects, and that legacy ascii files read back
+// what was written.
+
+#include "vtkCellArray.h"
+#include "vtkDataReader.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkPolyDataWriter.h"
+#include "vtkSmartPointer.h"
+
+#include <vtksys/ios/sstream>
+#include <vtkstd/string>
+#include <vtkstd/vector>
+
+#include <locale>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static void Open(vtkDataReader *reader, const vtkstd::string &input)
+{
+  reader->CloseVTKFile();
+  reader->SetInputString(input.c_str(), static_cast<int>(input.size()));
+  reader->ReadFromInputStringOn();
+  reader->OpenVTKFile();
+}
+
+// Parses each token with operator>>, reads them all at once and then one
+// at a time, and checks that all three agree.
+template <class T>
+int TestTokens(vtkDataReader *reader, const vtkstd::vector<vtkstd::string> &tokens,
+               const char *what)
+{
+  vtkstd::string input;
+  vtkstd::vector<T> expected(tokens.size());
+  for (size_t i = 0; i < tokens.size(); ++i)
+    {
+    vtksys_ios::istringstream is(tokens[i]);
+    is.imbue(vtkstd::locale::classic());
+    is >> expected[i];
+    if (is.fail())
+      {
+      cerr << what << ": bad test token " << tokens[i] << endl;
+      return 0;
+      }
+    input += tokens[i];
+    input += (i % 7 == 3) ? "\n" : (i % 5 == 1 ? " \t " : " ");
+    }
+
+  vtkstd::vector<T> bulk(tokens.size() + 1);
+  Open(reader, input);
+  if (!reader->Read(&bulk[0], static_cast<vtkIdType>(tokens.size())) ||
+      reader->Read(&bulk[tokens.size()]))
+    {
+    cerr << what << ": the values were not read at once." << endl;
+    return 0;
+    }
+  Open(reader, input);
+  for (size_t i = 0; i < tokens.size(); ++i)
+    {
+    T value;
+    if (!reader->Read(&value) ||
+        memcmp(&value, &expected[i], sizeof(T)) ||
+        memcmp(&bulk[i], &expected[i], sizeof(T)))
+      {
+      cerr << what << ": " << tokens[i] << " was not read as "
+           << expected[i] << endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
+template <class T>
+int TestRejected(vtkDataReader *reader, const char *input, const char *what)
+{
+  T values[2];
+  Open(reader, input);
+  if (reader->Read(values, 2))
+    {
+    cerr << what << ": \"" << input << "\" was read." << endl;
+    return 0;
+    }
+  return 1;
+}
+
+static vtkstd::string Format(const char *format, double value)
+{
+  char buffer[64];
+  sprintf(buffer, format, value);
+  return buffer;
+}
+
+static int TestValues()
+{
+  int ok = 1;
+  vsp(DataReader, reader);
+
+  const char *integers[] = { "0", "-0", "+17", "-1", "32767", "-32768",
+                             "0012", "127", "-128", 0 };
+  vtkstd::vector<vtkstd::string> tokens;
+  for (int i = 0; integers[i]; ++i)
+    {
+    tokens.push_back(integers[i]);
+    }
+  ok &= TestTokens<short>(reader, tokens, "short");
+  ok &= TestTokens<int>(reader, tokens, "int");
+  ok &= TestTokens<long>(reader, tokens, "long");
+  ok &= TestTokens<float>(reader, tokens, "float");
+  ok &= TestTokens<double>(reader, tokens, "double");
+  tokens.push_back("2147483647");
+  tokens.push_back("-2147483648");
+  ok &= TestTokens<int>(reader, tokens, "int limits");
+  tokens.push_back("9223372036854775807");
+  tokens.push_back("-9223372036854775808");
+  ok &= TestTokens<vtkTypeInt64>(reader, tokens, "vtkTypeInt64");
+  tokens.clear();
+  tokens.push_back("65535");
+  tokens.push_back("4294967295");
+  tokens.push_back("12");
+  ok &= TestTokens<unsigned int>(reader, tokens, "unsigned int");
+
+  // Numbers converted here and numbers left to the stream.
+  const char *reals[] = { "0.5", ".5", "5.", "-1.25e-3", "1E+10", "3.4e38",
+                          "1e-30", "1.7976931348623157e308", "4.9e-324",
+                          "0.1", "123456789012345678901234567890",
+                          "0.000000000000000000000000000001", "-0.0",
+                          "0.30000000000000004", "2.2250738585072014e-308",
+                          0 };
+  tokens.clear();
+  for (int i = 0; reals[i]; ++i)
+    {
+    tokens.push_back(reals[i]);
+    }
+  vtkMath::RandomSeed(4321);
+  const char *formats[] = { "%g", "%.9g", "%.17g", "%.3e", "%.12f" };
+  for (int i = 0; i < 2000; ++i)
+    {
+    double v = vtkMath::Random(-1, 1) * pow(10.0, vtkMath::Random(-30, 30));
+    tokens.push_back(Format(formats[i % 5], v));
+    }
+  ok &= TestTokens<double>(reader, tokens, "double");
+  tokens.erase(tokens.begin() + 5, tokens.begin() + 9);
+  ok &= TestTokens<float>(reader, tokens, "float");
+
+  // Numbers halfway between two floats.
+  tokens.clear();
+  tokens.push_back("16777217");
+  tokens.push_back("1.00000005960464477539062500");
+  tokens.push_back("0.50000002980232238769531250");
+  ok &= TestTokens<float>(reader, tokens, "float ties");
+
+  ok &= TestRejected<int>(reader, "1 1.5", "int");
+  ok &= TestRejected<int>(reader, "1 2147483648", "int");
+  ok &= TestRejected<short>(reader, "1 40000", "short");
+  ok &= TestRejected<int>(reader, "1 abc", "int");
+  ok &= TestRejected<double>(reader, "1 -", "double");
+  ok &= TestRejected<double>(reader, "1 1e400", "double");
+  ok &= TestRejected<double>(reader, "1 2,5", "double");
+  ok &= TestRejected<double>(reader, "1", "double");
+  ok &= TestRejected<float>(reader, "1 1e39", "float");
+  return ok;
+}
+
+// Writes a polygonal mesh to a legacy ascii file and reads it back.
+static int TestFile()
+{
+  vsp(Points, points);
+  vsp(CellArray, polys);
+  vsp(DoubleArray, scalars);
+  vsp(IntArray, ids);
+  scalars->SetName("Scalars");
+  ids->SetName("Ids");
+  const int n = 60;
+  for (int j = 0; j < n; ++j)
+    {
+    for (int i = 0; i < n; ++i)
+      {
+      points->InsertNextPoint(i * 0.1, j * 0.25, sin(i * 0.3) * j);
+      scalars->InsertNextValue(cos(i * 0.01) * j * 1000);
+      ids->InsertNextValue(i - j * n);
+      if (i && j)
+        {
+        vtkIdType quad[4] = { (j-1)*n + i-1, (j-1)*n + i, j*n + i, j*n + i-1 };
+        polys->InsertNextCell(4, quad);
+        }
+      }
+    }
+  vsp(PolyData, mesh);
+  mesh->SetPoints(points);
+  mesh->SetPolys(polys);
+  mesh->GetPointData()->SetScalars(scalars);
+  mesh->GetPointData()->AddArray(ids);
+
+  vsp(PolyDataWriter, writer);
+  writer->SetInput(mesh);
+  writer->SetFileTypeToASCII();
+  writer->WriteToOutputStringOn();
+  writer->Write();
+
+  vsp(PolyDataReader, reader);
+  reader->SetInputString(writer->GetOutputString(),
+                         writer->GetOutputStringLength());
+  reader->ReadFromInputStringOn();
+  reader->Update();
+  vtkPolyData *output = reader->GetOutput();
+
+  vtkDataArray *s = output->GetPointData()->GetScalars();
+  vtkDataArray *d = output->GetPointData()->GetArray("Ids");
+  if (output->GetNumberOfPoints() != mesh->GetNumberOfPoints() ||
+      output->GetNumberOfCells() != mesh->GetNumberOfCells() || !s || !d)
+    {
+    cerr << "The file was not read." << endl;
+    return 0;
+    }
+  for (vtkIdType i = 0; i < mesh->GetNumberOfPoints(); ++i)
+    {
+    double *p = output->GetPoint(i);
+    double *q = mesh->GetPoint(i);
+    for (int k = 0; k < 3; ++k)
+      {
+      if (fabs(p[k] - q[k]) > 1e-5 * (1 + fabs(q[k])))
+        {
+        cerr << "Point " << i << " differs." << endl;
+        return 0;
+        }
+      }
+    if (fabs(s->GetTuple1(i) - scalars->GetValue(i)) >
+        1e-5 * (1 + fabs(scalars->GetValue(i))) ||
+        d->GetTuple1(i) != ids->GetValue(i))
+      {
+      cerr << "The values of point " << i << " differ." << endl;
+      return 0;
+      }
+    }
+  vtkIdTypeArray *a = output->GetPolys()->GetData();
+  vtkIdTypeArray *b = polys->GetData();
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      memcmp(a->GetPointer(0), b->GetPointer(0),
+             a->GetNumberOfTuples() * sizeof(vtkIdType)))
+    {
+    cerr << "The polygons differ." << endl;
+    return 0;
+    }
+  return 1;
+}
+
+int TestDataReaderASCII(int, char *[])
+{
+  int ok = TestValues();
+  ok &= TestFile();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,345 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestEnSightGoldBinaryReaderIndexFiles.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a binary EnSight Gold case whose geometry and variables are
+// single files holding every time step, and checks that reading it with
+// index files gives what scanning the files gives: with the index files
+// being made, with the index files left by another reader, and after a
+// file changed under its index file.  Reports how long each read takes.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkGenericEnSightReader.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtkstd/string>
+#include <vtkstd/vector>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static const char *Prefix = "TestEnSightGoldBinaryReaderIndexFiles";
+
+// The sizes of the parts; each is a block of n*n*n hexahedra.
+static const int Sizes[] = { 12, 3, 7, 0 };
+static const int NumberOfSteps = 4;
+
+static void WriteLine(FILE *fp, const char *text)
+{
+  char line[80];
+  memset(line, 0, 80);
+  strncpy(line, text, 79);
+  fwrite(line, 1, 80, fp);
+}
+
+static void WriteInt(FILE *fp, int value)
+{
+  fwrite(&value, sizeof(int), 1, fp);
+}
+
+static void WriteInts(FILE *fp, const vtkstd::vector<int> &values)
+{
+  if (!values.empty())
+    {
+    fwrite(&values[0], sizeof(int), values.size(), fp);
+    }
+}
+
+static void WriteFloats(FILE *fp, const vtkstd::vector<float> &values)
+{
+  if (!values.empty())
+    {
+    fwrite(&values[0], sizeof(float), values.size(), fp);
+    }
+}
+
+static vtkstd::string Path(const char *name)
+{
+  return vtkstd::string(Prefix) + name;
+}
+
+// The geometry moves at each time step; the variable files are skipped
+// through with the sizes of the current step, so the sizes stay the same.
+static void WriteGeometry()
+{
+  FILE *fp = fopen(Path(".geo").c_str(), "wb");
+  WriteLine(fp, "C Binary");
+  for (int step = 0; step < NumberOfSteps; ++step)
+    {
+    WriteLine(fp, "BEGIN TIME STEP");
+    WriteLine(fp, "Generated case");
+    WriteLine(fp, "");
+    WriteLine(fp, "node id off");
+    WriteLine(fp, "element id off");
+    int part = 1;
+    char name[80];
+    for (int s = 0; Sizes[s]; ++s, ++part)
+      {
+      int size = Sizes[s];
+      int n = size + 1;
+      int numPts = n * n * n;
+      int numCells = size * size * size;
+      WriteLine(fp, "part");
+      WriteInt(fp, part);
+      sprintf(name, "Hexahedra %d", part);
+      WriteLine(fp, name);
+      WriteLine(fp, "coordinates");
+      WriteInt(fp, numPts);
+      vtkstd::vector<float> x(numPts), y(numPts), z(numPts);
+      for (int p = 0; p < numPts; ++p)
+        {
+        x[p] = static_cast<float>(p % n + 20 * part + step);
+        y[p] = static_cast<float>(p / n % n) * 0.5f;
+        z[p] = static_cast<float>(p / n / n) + 0.125f * part;
+        }
+      WriteFloats(fp, x);
+      WriteFloats(fp, y);
+      WriteFloats(fp, z);
+      WriteLine(fp, "hexa8");
+      WriteInt(fp, numCells);
+      vtkstd::vector<int> nodes;
+      for (int c = 0; c < numCells; ++c)
+        {
+        int i = c % size, j = c / size % size, k = c / size / size;
+        int p = (k * n + j) * n + i + 1;
+        int hex[8] = { p, p + 1, p + n + 1, p + n,
+                       p + n * n, p + n * n + 1, p + n * n + n + 1,
+                       p + n * n + n };
+        nodes.insert(nodes.end(), hex, hex + 8);
+        }
+      WriteInts(fp, nodes);
+      }
+    WriteLine(fp, "END TIME STEP");
+    }
+  fclose(fp);
+}
+
+// Writes the scalars per node and per element of every time step, after
+// a given number of leading lines that the reader skips.
+static void WriteVariables(int offset, int leadingLines)
+{
+  FILE *node = fopen(Path(".scl").c_str(), "wb");
+  FILE *element = fopen(Path(".esc").c_str(), "wb");
+  for (int l = 0; l < leadingLines; ++l)
+    {
+    WriteLine(node, "C Binary");
+    WriteLine(element, "C Binary");
+    }
+  vtkstd::vector<float> values;
+  for (int step = 0; step < NumberOfSteps; ++step)
+    {
+    WriteLine(node, "BEGIN TIME STEP");
+    WriteLine(element, "BEGIN TIME STEP");
+    WriteLine(node, "Scalars");
+    WriteLine(element, "CellScalars");
+    int part = 1;
+    for (int s = 0; Sizes[s]; ++s, ++part)
+      {
+      int size = Sizes[s];
+      int n = size + 1;
+      WriteLine(node, "part");
+      WriteInt(node, part);
+      WriteLine(node, "coordinates");
+      values.resize(n * n * n);
+      for (size_t p = 0; p < values.size(); ++p)
+        {
+        values[p] = static_cast<float>(cos(p * 0.01 * part) + step + offset);
+        }
+      WriteFloats(node, values);
+
+      WriteLine(element, "part");
+      WriteInt(element, part);
+      WriteLine(element, "hexa8");
+      values.resize(size * size * size);
+      for (size_t c = 0; c < values.size(); ++c)
+        {
+        values[c] = static_cast<float>(c * part + step + offset);
+        }
+      WriteFloats(element, values);
+      }
+    WriteLine(node, "END TIME STEP");
+    WriteLine(element, "END TIME STEP");
+    }
+  fclose(node);
+  fclose(element);
+}
+
+static void WriteCase()
+{
+  FILE *fp = fopen(Path(".case").c_str(), "w");
+  fprintf(fp, "FORMAT\ntype: ensight gold\n\nGEOMETRY\nmodel: 1 1 %s.geo\n\n"
+          "VARIABLE\nscalar per node: 1 1 Scalars %s.scl\n"
+          "scalar per element: 1 1 CellScalars %s.esc\n\n"
+          "TIME\ntime set: 1\nnumber of steps: %d\ntime values:",
+          Prefix, Prefix, Prefix, NumberOfSteps);
+  for (int step = 0; step < NumberOfSteps; ++step)
+    {
+    fprintf(fp, " %d.0", step);
+    }
+  fprintf(fp, "\n\nFILE\nfile set: 1\nnumber of steps: %d\n", NumberOfSteps);
+  fclose(fp);
+  WriteGeometry();
+  WriteVariables(0, 0);
+
+  const char *suffixes[] = { ".geo", ".scl", ".esc", 0 };
+  for (int i = 0; suffixes[i]; ++i)
+    {
+    remove((Path(suffixes[i]) + ".vtkidx").c_str());
+    }
+}
+
+static int IndexFileExists(const char *suffix)
+{
+  FILE *fp = fopen((Path(suffix) + ".vtkidx").c_str(), "r");
+  if (!fp)
+    {
+    cerr << "No index file for " << Path(suffix).c_str() << endl;
+    return 0;
+    }
+  fclose(fp);
+  return 1;
+}
+
+static int SameArray(vtkDataArray *a, vtkDataArray *b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+      a->GetDataType() != b->GetDataType())
+    {
+    return 0;
+    }
+  return memcmp(a->GetVoidPointer(0), b->GetVoidPointer(0),
+                a->GetNumberOfTuples() * a->GetNumberOfComponents() *
+                a->GetDataTypeSize()) == 0;
+}
+
+static int SameDataSet(vtkDataSet *a, vtkDataSet *b)
+{
+  vtkUnstructuredGrid *ua = vtkUnstructuredGrid::SafeDownCast(a);
+  vtkUnstructuredGrid *ub = vtkUnstructuredGrid::SafeDownCast(b);
+  if (!ua || !ub ||
+      !SameArray(ua->GetPoints()->GetData(), ub->GetPoints()->GetData()) ||
+      !SameArray(ua->GetCells()->GetData(), ub->GetCells()->GetData()) ||
+      !SameArray(a->GetPointData()->GetArray("Scalars"),
+                 b->GetPointData()->GetArray("Scalars")) ||
+      !SameArray(a->GetCellData()->GetArray("CellScalars"),
+                 b->GetCellData()->GetArray("CellScalars")))
+    {
+    return 0;
+    }
+  return 1;
+}
+
+// Reads the case at a time and keeps a copy of the output.
+static vtkMultiBlockDataSet *Read(vtkGenericEnSightReader *reader,
+                                  double time, const char *what)
+{
+  vsp(TimerLog, timer);
+  reader->SetTimeValue(time);
+  timer->StartTimer();
+  reader->Update();
+  timer->StopTimer();
+  cout << what << " at time " << time << ": "
+       << timer->GetElapsedTime() << "s" << endl;
+  vtkMultiBlockDataSet *copy = vtkMultiBlockDataSet::New();
+  copy->ShallowCopy(reader->GetOutput());
+  return copy;
+}
+
+// Reads every time step, in the given order, with a reader that scans the
+// files and with one that uses index files, and compares them.
+static int Compare(vtkGenericEnSightReader *indexed, const int *order,
+                   const char *what)
+{
+  vtkstd::string caseName = Path(".case");
+  vsp(GenericEnSightReader, scanning);
+  scanning->SetCaseFileName(caseName.c_str());
+
+  int ok = 1;
+  for (int i = 0; i < NumberOfSteps; ++i)
+    {
+    int step = order[i];
+    vtkMultiBlockDataSet *a = Read(scanning, step, "Scanning");
+    vtkMultiBlockDataSet *b = Read(indexed, step, what);
+    unsigned int numBlocks = a->GetNumberOfBlocks();
+    if (numBlocks != 3 || b->GetNumberOfBlocks() != numBlocks)
+      {
+      cerr << "Read " << numBlocks << " and " << b->GetNumberOfBlocks()
+           << " blocks." << endl;
+      ok = 0;
+      }
+    for (unsigned int j = 0; ok && j < numBlocks; ++j)
+      {
+      const char *nameA = a->GetMetaData(j)->Get(vtkCompositeDataSet::NAME());
+      const char *nameB = b->GetMetaData(j)->Get(vtkCompositeDataSet::NAME());
+      if (!nameA || !nameB || strcmp(nameA, nameB) ||
+          !SameDataSet(vtkDataSet::SafeDownCast(a->GetBlock(j)),
+                       vtkDataSet::SafeDownCast(b->GetBlock(j))))
+        {
+        cerr << what << ": block " << j << " differs at time " << step
+             << endl;
+        ok = 0;
+        }
+      }
+    a->Delete();
+    b->Delete();
+    }
+  return ok;
+}
+
+int TestEnSightGoldBinaryReaderIndexFiles(int, char *[])
+{
+  WriteCase();
+  vtkstd::string caseName = Path(".case");
+  int order[NumberOfSteps] = { 3, 1, 0, 2 };
+  int reversed[NumberOfSteps] = { 2, 0, 1, 3 };
+
+  // The first reader makes the index files.
+  vsp(GenericEnSightReader, first);
+  first->SetCaseFileName(caseName.c_str());
+  first->UseIndexFilesOn();
+  int ok = Compare(first, order, "Making the index files");
+  ok = ok && IndexFileExists(".geo") && IndexFileExists(".scl") &&
+    IndexFileExists(".esc");
+
+  // Another reader starts with them, with several threads as well.
+  vsp(GenericEnSightReader, second);
+  second->SetCaseFileName(caseName.c_str());
+  second->UseIndexFilesOn();
+  second->SetNumberOfThreads(2);
+  ok = ok && Compare(second, reversed, "With the index files");
+
+  // The variables move within their files, so their index files are out
+  // of date and must not be used.
+  WriteVariables(10, 3);
+  vsp(GenericEnSightReader, third);
+  third->SetCaseFileName(caseName.c_str());
+  third->UseIndexFilesOn();
+  ok = ok && Compare(third, order, "With changed files");
+  ok = ok && Compare(first, order, "Again with changed files");
+
+  return ok ? 0 : 1;
+}
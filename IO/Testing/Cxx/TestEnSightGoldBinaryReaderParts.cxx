@@ -0,0 +1,431 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestEnSightGoldBinaryReaderParts.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a binary EnSight Gold case with several unstructured parts and
+// curvilinear, rectilinear and uniform parts, two time steps and
+// variables per node and per element, and checks that reading its parts
+// with several threads gives what reading them in sequence gives, at
+// both time steps.  Reports how long each read takes.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkGenericEnSightReader.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkPointData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtkstd/string>
+#include <vtkstd/vector>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static const char *Prefix = "TestEnSightGoldBinaryReaderParts";
+
+// The sizes of the unstructured parts; each is a block of n*n*n hexahedra.
+static const int Sizes[] = { 14, 3, 22, 1, 9, 17, 5, 0 };
+
+static void WriteLine(FILE *fp, const char *text)
+{
+  char line[80];
+  memset(line, 0, 80);
+  strncpy(line, text, 79);
+  fwrite(line, 1, 80, fp);
+}
+
+static void WriteInt(FILE *fp, int value)
+{
+  fwrite(&value, sizeof(int), 1, fp);
+}
+
+static void WriteInts(FILE *fp, const vtkstd::vector<int> &values)
+{
+  if (!values.empty())
+    {
+    fwrite(&values[0], sizeof(int), values.size(), fp);
+    }
+}
+
+static void WriteFloats(FILE *fp, const vtkstd::vector<float> &values)
+{
+  if (!values.empty())
+    {
+    fwrite(&values[0], sizeof(float), values.size(), fp);
+    }
+}
+
+static FILE *Open(const char *name)
+{
+  vtkstd::string path = vtkstd::string(Prefix) + name;
+  return fopen(path.c_str(), "wb");
+}
+
+static void WriteGeometry()
+{
+  FILE *fp = Open(".geo");
+  WriteLine(fp, "C Binary");
+  WriteLine(fp, "Generated case");
+  WriteLine(fp, "");
+  WriteLine(fp, "node id given");
+  WriteLine(fp, "element id given");
+
+  int part = 1;
+  char name[80];
+  for (int s = 0; Sizes[s]; ++s, ++part)
+    {
+    int n = Sizes[s] + 1;
+    int numPts = n * n * n;
+    int numCells = Sizes[s] * Sizes[s] * Sizes[s];
+    WriteLine(fp, "part");
+    WriteInt(fp, part);
+    sprintf(name, "Hexahedra %d", part);
+    WriteLine(fp, name);
+    WriteLine(fp, "coordinates");
+    WriteInt(fp, numPts);
+    vtkstd::vector<int> ids(numPts);
+    vtkstd::vector<float> x(numPts), y(numPts), z(numPts);
+    for (int p = 0; p < numPts; ++p)
+      {
+      ids[p] = 3 * p + 1;
+      x[p] = static_cast<float>(p % n + 20 * part);
+      y[p] = static_cast<float>(p / n % n) * 0.5f;
+      z[p] = static_cast<float>(p / n / n) + 0.125f * part;
+      }
+    WriteInts(fp, ids);
+    WriteFloats(fp, x);
+    WriteFloats(fp, y);
+    WriteFloats(fp, z);
+
+    // The hexahedra, then the bottom faces of the first row as triangles.
+    WriteLine(fp, "hexa8");
+    WriteInt(fp, numCells);
+    ids.resize(numCells);
+    vtkstd::vector<int> nodes;
+    for (int c = 0; c < numCells; ++c)
+      {
+      ids[c] = c + 1;
+      int i = c % Sizes[s], j = c / Sizes[s] % Sizes[s];
+      int k = c / Sizes[s] / Sizes[s];
+      int p = (k * n + j) * n + i + 1;
+      int hex[8] = { p, p + 1, p + n + 1, p + n,
+                     p + n * n, p + n * n + 1, p + n * n + n + 1,
+                     p + n * n + n };
+      nodes.insert(nodes.end(), hex, hex + 8);
+      }
+    WriteInts(fp, ids);
+    WriteInts(fp, nodes);
+    WriteLine(fp, "tria3");
+    WriteInt(fp, Sizes[s]);
+    ids.resize(Sizes[s]);
+    nodes.clear();
+    for (int c = 0; c < Sizes[s]; ++c)
+      {
+      ids[c] = c + 1;
+      int tri[3] = { c + 1, c + 2, c + n + 2 };
+      nodes.insert(nodes.end(), tri, tri + 3);
+      }
+    WriteInts(fp, ids);
+    WriteInts(fp, nodes);
+    }
+
+  // A curvilinear part with blanking and listed ids.
+  int dims[3] = { 6, 5, 4 };
+  int numPts = dims[0] * dims[1] * dims[2];
+  int numCells = (dims[0] - 1) * (dims[1] - 1) * (dims[2] - 1);
+  WriteLine(fp, "part");
+  WriteInt(fp, part++);
+  WriteLine(fp, "Curvilinear");
+  WriteLine(fp, "block iblanked");
+  fwrite(dims, sizeof(int), 3, fp);
+  vtkstd::vector<float> coords(numPts);
+  for (int c = 0; c < 3; ++c)
+    {
+    for (int p = 0; p < numPts; ++p)
+      {
+      coords[p] = static_cast<float>(sin(p * 0.1 + c) * 10.0);
+      }
+    WriteFloats(fp, coords);
+    }
+  vtkstd::vector<int> ids(numPts);
+  for (int p = 0; p < numPts; ++p)
+    {
+    ids[p] = (p % 7) ? 1 : 0;
+    }
+  WriteInts(fp, ids);
+  WriteLine(fp, "node_ids");
+  for (int p = 0; p < numPts; ++p)
+    {
+    ids[p] = p + 1;
+    }
+  WriteInts(fp, ids);
+  WriteLine(fp, "element_ids");
+  ids.resize(numCells);
+  WriteInts(fp, ids);
+
+  // A rectilinear part and a uniform part.
+  WriteLine(fp, "part");
+  WriteInt(fp, part++);
+  WriteLine(fp, "Rectilinear");
+  WriteLine(fp, "block rectilinear");
+  fwrite(dims, sizeof(int), 3, fp);
+  for (int c = 0; c < 3; ++c)
+    {
+    coords.resize(dims[c]);
+    for (int i = 0; i < dims[c]; ++i)
+      {
+      coords[i] = static_cast<float>(i * i + c);
+      }
+    WriteFloats(fp, coords);
+    }
+  WriteLine(fp, "part");
+  WriteInt(fp, part++);
+  WriteLine(fp, "Uniform");
+  WriteLine(fp, "block uniform");
+  fwrite(dims, sizeof(int), 3, fp);
+  float origin[3] = { 1.0f, 2.0f, 3.0f }, spacing[3] = { 0.5f, 0.25f, 2.0f };
+  fwrite(origin, sizeof(float), 3, fp);
+  fwrite(spacing, sizeof(float), 3, fp);
+  fclose(fp);
+}
+
+// Writes the scalars per node and per element of a time step.
+static void WriteVariables(int step)
+{
+  char name[32];
+  sprintf(name, ".scl%d", step);
+  FILE *node = Open(name);
+  sprintf(name, ".esc%d", step);
+  FILE *element = Open(name);
+  WriteLine(node, "Scalars");
+  WriteLine(element, "CellScalars");
+  int part = 1;
+  vtkstd::vector<float> values;
+  for (int s = 0; Sizes[s]; ++s, ++part)
+    {
+    int n = Sizes[s] + 1;
+    WriteLine(node, "part");
+    WriteInt(node, part);
+    WriteLine(node, "coordinates");
+    values.resize(n * n * n);
+    for (size_t p = 0; p < values.size(); ++p)
+      {
+      values[p] = static_cast<float>(cos(p * 0.01 * part) + step);
+      }
+    WriteFloats(node, values);
+
+    WriteLine(element, "part");
+    WriteInt(element, part);
+    WriteLine(element, "hexa8");
+    values.resize(Sizes[s] * Sizes[s] * Sizes[s]);
+    for (size_t c = 0; c < values.size(); ++c)
+      {
+      values[c] = static_cast<float>(c * part + step);
+      }
+    WriteFloats(element, values);
+    WriteLine(element, "tria3");
+    values.resize(Sizes[s]);
+    for (size_t c = 0; c < values.size(); ++c)
+      {
+      values[c] = -static_cast<float>(c * part + step);
+      }
+    WriteFloats(element, values);
+    }
+  int numPts[3] = { 120, 120, 120 };
+  int numCells[3] = { 60, 60, 60 };
+  for (int b = 0; b < 3; ++b, ++part)
+    {
+    WriteLine(node, "part");
+    WriteInt(node, part);
+    WriteLine(node, "block");
+    values.resize(numPts[b]);
+    for (size_t p = 0; p < values.size(); ++p)
+      {
+      values[p] = static_cast<float>(p * 0.5 + step);
+      }
+    WriteFloats(node, values);
+    WriteLine(element, "part");
+    WriteInt(element, part);
+    WriteLine(element, "block");
+    values.resize(numCells[b]);
+    for (size_t c = 0; c < values.size(); ++c)
+      {
+      values[c] = static_cast<float>(c * 2.0 - step);
+      }
+    WriteFloats(element, values);
+    }
+  fclose(node);
+  fclose(element);
+}
+
+static void WriteCase()
+{
+  FILE *fp = Open(".case");
+  fprintf(fp, "FORMAT\ntype: ensight gold\n\nGEOMETRY\nmodel: %s.geo\n\n"
+          "VARIABLE\nscalar per node: 1 Scalars %s.scl*\n"
+          "scalar per element: 1 CellScalars %s.esc*\n\n"
+          "TIME\ntime set: 1\nnumber of steps: 2\n"
+          "filename start number: 0\nfilename increment: 1\n"
+          "time values: 0.0 1.0\n", Prefix, Prefix, Prefix);
+  fclose(fp);
+  WriteGeometry();
+  WriteVariables(0);
+  WriteVariables(1);
+}
+
+static int SameArray(vtkDataArray *a, vtkDataArray *b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+      a->GetDataType() != b->GetDataType())
+    {
+    return 0;
+    }
+  return memcmp(a->GetVoidPointer(0), b->GetVoidPointer(0),
+                a->GetNumberOfTuples() * a->GetNumberOfComponents() *
+                a->GetDataTypeSize()) == 0;
+}
+
+static int SameAttributes(vtkDataSetAttributes *a, vtkDataSetAttributes *b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+    {
+    return 0;
+    }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+    {
+    const char *name = a->GetArrayName(i);
+    if (!name || !SameArray(a->GetArray(i), b->GetArray(name)))
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+static int SameDataSet(vtkDataSet *a, vtkDataSet *b)
+{
+  if (!a || !b || strcmp(a->GetClassName(), b->GetClassName()) ||
+      a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfCells() != b->GetNumberOfCells() ||
+      !SameAttributes(a->GetPointData(), b->GetPointData()) ||
+      !SameAttributes(a->GetCellData(), b->GetCellData()))
+    {
+    return 0;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+    {
+    double p[3], q[3];
+    a->GetPoint(i, p);
+    b->GetPoint(i, q);
+    if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+      {
+      return 0;
+      }
+    }
+  vtkUnstructuredGrid *ua = vtkUnstructuredGrid::SafeDownCast(a);
+  vtkUnstructuredGrid *ub = vtkUnstructuredGrid::SafeDownCast(b);
+  if (ua && (!SameArray(ua->GetCells()->GetData(), ub->GetCells()->GetData()) ||
+             !SameArray(ua->GetCellTypesArray(), ub->GetCellTypesArray())))
+    {
+    return 0;
+    }
+  vtkStructuredGrid *sa = vtkStructuredGrid::SafeDownCast(a);
+  vtkStructuredGrid *sb = vtkStructuredGrid::SafeDownCast(b);
+  if (sa)
+    {
+    for (vtkIdType i = 0; i < sa->GetNumberOfPoints(); ++i)
+      {
+      if (sa->IsPointVisible(i) != sb->IsPointVisible(i))
+        {
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+// Reads the case at a time and keeps a copy of the output.
+static vtkMultiBlockDataSet *Read(vtkGenericEnSightReader *reader,
+                                  double time, const char *what)
+{
+  vsp(TimerLog, timer);
+  reader->SetTimeValue(time);
+  timer->StartTimer();
+  reader->Update();
+  timer->StopTimer();
+  cout << what << " at time " << time << ": "
+       << timer->GetElapsedTime() << "s" << endl;
+  vtkMultiBlockDataSet *copy = vtkMultiBlockDataSet::New();
+  copy->ShallowCopy(reader->GetOutput());
+  return copy;
+}
+
+int TestEnSightGoldBinaryReaderParts(int, char *[])
+{
+  WriteCase();
+  vtkstd::string caseName = vtkstd::string(Prefix) + ".case";
+
+  vsp(GenericEnSightReader, serial);
+  serial->SetCaseFileName(caseName.c_str());
+  vsp(GenericEnSightReader, threaded);
+  threaded->SetCaseFileName(caseName.c_str());
+  threaded->SetNumberOfThreads(4);
+
+  int ok = 1;
+  for (int pass = 0; pass < 2; ++pass)
+    {
+    for (int step = 0; step < 2; ++step)
+      {
+      vtkMultiBlockDataSet *a = Read(serial, step, "In sequence");
+      vtkMultiBlockDataSet *b = Read(threaded, step, "With 4 threads");
+      unsigned int numBlocks = a->GetNumberOfBlocks();
+      if (numBlocks != 10 || b->GetNumberOfBlocks() != numBlocks)
+        {
+        cerr << "Read " << numBlocks << " and " << b->GetNumberOfBlocks()
+             << " blocks." << endl;
+        ok = 0;
+        }
+      for (unsigned int i = 0; ok && i < numBlocks; ++i)
+        {
+        const char *nameA = a->GetMetaData(i)->Get(vtkCompositeDataSet::NAME());
+        const char *nameB = b->GetMetaData(i)->Get(vtkCompositeDataSet::NAME());
+        vtkDataSet *dsA = vtkDataSet::SafeDownCast(a->GetBlock(i));
+        vtkDataSet *dsB = vtkDataSet::SafeDownCast(b->GetBlock(i));
+        if (!nameA || !nameB || strcmp(nameA, nameB) ||
+            !SameDataSet(dsA, dsB) ||
+            !dsA->GetPointData()->GetArray("Scalars") ||
+            !dsA->GetCellData()->GetArray("CellScalars"))
+          {
+          cerr << "Block " << i << " differs at time " << step << endl;
+          ok = 0;
+          }
+        }
+      a->Delete();
+      b->Delete();
+      }
+    }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,660 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestEnSightGoldReaderASCII.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes an ascii EnSight Gold case with unstructured, curvilinear and
+// rectilinear parts, listed node and element ids, comment lines and
+// variables per node and per element, checks what vtkGenericEnSightReader
+// reads from it, and reports how long reading a larger case takes.  A
+// case with a node id too large for a vtkIdType must not be read.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkGenericEnSightReader.h"
+#include "vtkIdList.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkPointData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtkstd/string>
+#include <vtkstd/vector>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static const char *Prefix = "TestEnSightGoldReaderASCII";
+static const char *Extensions[] =
+  { ".case", ".geo", ".scl", ".vec", ".esc", ".ten", 0 };
+
+// The values written, as they read back.
+static float Real(double value)
+{
+  char buffer[32];
+  sprintf(buffer, "%12.5e", value);
+  return static_cast<float>(atof(buffer));
+}
+
+static void WriteReal(FILE *fp, double value)
+{
+  fprintf(fp, "%12.5e\n", value);
+}
+
+static float Coordinate(int i, int j, int k, int c)
+{
+  double x[3] = { i * 0.5, j * 0.25 + 0.01 * i, k * 1.5 - 0.001 * j };
+  return Real(x[c]);
+}
+
+static float NodeValue(vtkIdType p, int c)
+{
+  return Real(sin(p * 0.1 + c) * 100.0);
+}
+
+static float CellValue(vtkIdType e, int c)
+{
+  return Real(cos(e * 0.3 - c) * 10.0 - c);
+}
+
+// The unstructured part of n*n*n points has these sections, in order.
+struct Sections
+{
+  int N;
+  vtkIdType NumPoints;
+  vtkIdType Counts[6];
+  const char *Names[6];
+
+  Sections(int n) : N(n)
+    {
+    this->NumPoints = static_cast<vtkIdType>(n) * n * n;
+    const char *names[6] =
+      { "point", "bar3", "tria3", "hexa8", "nsided", "nfaced" };
+    vtkIdType counts[6] =
+      { n, n / 2, 2 * (n - 1) * (n - 1), static_cast<vtkIdType>(n - 1) *
+        (n - 1) * (n - 1), (n - 1) * (n - 1), 1 };
+    for (int s = 0; s < 6; ++s)
+      {
+      this->Names[s] = names[s];
+      this->Counts[s] = counts[s];
+      }
+    }
+
+  vtkIdType Id(int i, int j, int k) const
+    {
+    return (static_cast<vtkIdType>(k) * this->N + j) * this->N + i;
+    }
+
+  // The one based EnSight nodes of element e of section s.
+  void Nodes(int s, vtkIdType e, vtkstd::vector<vtkIdType> &nodes) const
+    {
+    int n = this->N - 1;
+    int i = static_cast<int>(e % n);
+    int j = static_cast<int>(e / n % n);
+    int k = static_cast<int>(e / n / n);
+    nodes.clear();
+    switch (s)
+      {
+      case 0:
+        nodes.push_back(this->Id(static_cast<int>(e), 0, 0));
+        break;
+      case 1:
+        nodes.push_back(this->Id(2 * static_cast<int>(e), 0, 0));
+        nodes.push_back(this->Id(2 * static_cast<int>(e) + 2, 0, 0));
+        nodes.push_back(this->Id(2 * static_cast<int>(e) + 1, 0, 0));
+        break;
+      case 2:
+        i = static_cast<int>(e / 2 % n);
+        j = static_cast<int>(e / 2 / n);
+        nodes.push_back(this->Id(i, j, 0));
+        nodes.push_back(this->Id(i + 1, j + (e % 2), 0));
+        nodes.push_back(this->Id(i + 1 - (e % 2), j + 1, 0));
+        break;
+      case 3:
+        nodes.push_back(this->Id(i, j, k));
+        nodes.push_back(this->Id(i + 1, j, k));
+        nodes.push_back(this->Id(i + 1, j + 1, k));
+        nodes.push_back(this->Id(i, j + 1, k));
+        nodes.push_back(this->Id(i, j, k + 1));
+        nodes.push_back(this->Id(i + 1, j, k + 1));
+        nodes.push_back(this->Id(i + 1, j + 1, k + 1));
+        nodes.push_back(this->Id(i, j + 1, k + 1));
+        break;
+      case 4:
+        // A pentagon on the top face.
+        nodes.push_back(this->Id(i, j, n));
+        nodes.push_back(this->Id(i + 1, j, n));
+        nodes.push_back(this->Id(i + 1, j + 1, n));
+        nodes.push_back(this->Id(i, j + 1, n));
+        nodes.push_back(this->Id(i, j + 1, n));
+        break;
+      default:
+        {
+        // The faces of the first cube, each its size then its nodes.
+        static const int faces[6][4] = { { 0, 3, 2, 1 }, { 4, 5, 6, 7 },
+          { 0, 1, 5, 4 }, { 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 3, 0, 4, 7 } };
+        vtkstd::vector<vtkIdType> cube;
+        this->Nodes(3, 0, cube);
+        for (int f = 0; f < 6; ++f)
+          {
+          nodes.push_back(4);
+          for (int v = 0; v < 4; ++v)
+            {
+            nodes.push_back(cube[faces[f][v]] - 1);
+            }
+          }
+        for (size_t v = 0; v < nodes.size(); ++v)
+          {
+          nodes[v] += (v % 5 ? 1 : 0);
+          }
+        }
+      }
+    for (size_t v = 0; s != 5 && v < nodes.size(); ++v)
+      {
+      ++nodes[v];
+      }
+    }
+};
+
+static FILE *Open(const char *extension)
+{
+  vtkstd::string name = vtkstd::string(Prefix) + extension;
+  return fopen(name.c_str(), "w");
+}
+
+static void WriteCase(int n, int small)
+{
+  FILE *fp = Open(".case");
+  fprintf(fp, "FORMAT\ntype: ensight gold\n\nGEOMETRY\nmodel: %s.geo\n\n"
+          "VARIABLE\nscalar per node: Scalars %s.scl\n"
+          "vector per node: Vectors %s.vec\n"
+          "scalar per element: CellScalars %s.esc\n"
+          "tensor symm per element: Tensors %s.ten\n",
+          Prefix, Prefix, Prefix, Prefix, Prefix);
+  fclose(fp);
+
+  Sections sections(n);
+  vtkstd::vector<vtkIdType> nodes;
+  fp = Open(".geo");
+  fprintf(fp, "Generated case\n\nnode id given\nelement id given\n");
+  fprintf(fp, "part\n%10d\nunstructured\ncoordinates\n%10d\n", 1,
+          static_cast<int>(sections.NumPoints));
+  for (vtkIdType p = 0; p < sections.NumPoints; ++p)
+    {
+    fprintf(fp, "%10d\n", static_cast<int>(p * 3 + 7));
+    }
+  for (int c = 0; c < 3; ++c)
+    {
+    fprintf(fp, "# component %d\n\n", c);
+    for (int k = 0; k < n; ++k)
+      {
+      for (int j = 0; j < n; ++j)
+        {
+        for (int i = 0; i < n; ++i)
+          {
+          WriteReal(fp, Coordinate(i, j, k, c));
+          }
+        }
+      }
+    }
+  for (int s = 0; s < 6; ++s)
+    {
+    vtkIdType count = sections.Counts[s];
+    fprintf(fp, "%s\n%10d\n", sections.Names[s], static_cast<int>(count));
+    for (vtkIdType e = 0; e < count; ++e)
+      {
+      fprintf(fp, "%10d\n", static_cast<int>(e + 100));
+      }
+    if (s == 4)
+      {
+      for (vtkIdType e = 0; e < count; ++e)
+        {
+        fprintf(fp, "%10d\n", 5);
+        }
+      }
+    else if (s == 5)
+      {
+      fprintf(fp, "%10d\n", 6);
+      for (int f = 0; f < 6; ++f)
+        {
+        fprintf(fp, "%10d\n", 4);
+        }
+      }
+    for (vtkIdType e = 0; e < count; ++e)
+      {
+      sections.Nodes(s, e, nodes);
+      for (size_t v = 0; v < nodes.size(); ++v)
+        {
+        // The faces of an nfaced element are on lines of their own.
+        if (s == 5 && v % 5 == 0)
+          {
+          if (v)
+            {
+            fprintf(fp, "\n");
+            }
+          continue;
+          }
+        fprintf(fp, "%10d", static_cast<int>(nodes[v]));
+        }
+      fprintf(fp, "\n");
+      }
+    }
+  if (small)
+    {
+    // An iblanked curvilinear part and a rectilinear part.
+    fprintf(fp, "part\n%10d\ncurvilinear\nblock iblanked\n%10d%10d%10d\n",
+            2, n, n, 1);
+    for (int c = 0; c < 3; ++c)
+      {
+      for (int p = 0; p < n * n; ++p)
+        {
+        WriteReal(fp, Coordinate(p % n, p / n, c, c));
+        }
+      }
+    for (int p = 0; p < n * n; ++p)
+      {
+      fprintf(fp, "%10d\n", p % 3 ? 1 : 0);
+      }
+    fprintf(fp, "part\n%10d\nrectilinear\nblock rectilinear\n"
+            "%10d%10d%10d\n", 3, n, n + 1, 2);
+    int dims[3] = { n, n + 1, 2 };
+    for (int c = 0; c < 3; ++c)
+      {
+      for (int i = 0; i < dims[c]; ++i)
+        {
+        WriteReal(fp, Coordinate(i, i, i, c));
+        }
+      }
+    }
+  fclose(fp);
+
+  int numParts = small ? 3 : 1;
+  vtkIdType structuredCells[3] = { 0, (n - 1) * (n - 1), (n - 1) * n };
+  vtkIdType structuredPoints[3] = { 0, n * n, n * (n + 1) * 2 };
+
+  FILE *scl = Open(".scl");
+  FILE *vec = Open(".vec");
+  FILE *esc = Open(".esc");
+  FILE *ten = Open(".ten");
+  fprintf(scl, "Scalars\n");
+  fprintf(vec, "Vectors\n");
+  fprintf(esc, "CellScalars\n");
+  fprintf(ten, "Tensors\n");
+  for (int part = 0; part < numParts; ++part)
+    {
+    const char *section = part ? "block" : "coordinates";
+    vtkIdType numPoints = part ? structuredPoints[part] : sections.NumPoints;
+    fprintf(scl, "part\n%10d\n%s\n", part + 1, section);
+    fprintf(vec, "part\n%10d\n%s\n", part + 1, section);
+    for (vtkIdType p = 0; p < numPoints; ++p)
+      {
+      WriteReal(scl, NodeValue(p, 0));
+      }
+    for (int c = 0; c < 3; ++c)
+      {
+      for (vtkIdType p = 0; p < numPoints; ++p)
+        {
+        WriteReal(vec, NodeValue(p, c + 1));
+        }
+      }
+
+    fprintf(esc, "part\n%10d\n", part + 1);
+    fprintf(ten, "part\n%10d\n", part + 1);
+    vtkIdType first = 0;
+    for (int s = 0; s < 6; ++s)
+      {
+      vtkIdType count = part ? structuredCells[part] : sections.Counts[s];
+      fprintf(esc, "%s\n", part ? "block" : sections.Names[s]);
+      fprintf(ten, "%s\n", part ? "block" : sections.Names[s]);
+      for (vtkIdType e = first; e < first + count; ++e)
+        {
+        WriteReal(esc, CellValue(e, 0));
+        }
+      for (int c = 0; c < 6; ++c)
+        {
+        for (vtkIdType e = first; e < first + count; ++e)
+          {
+          WriteReal(ten, CellValue(e, c + 1));
+          }
+        }
+      first += count;
+      if (part)
+        {
+        break;
+        }
+      }
+    }
+  fclose(scl);
+  fclose(vec);
+  fclose(esc);
+  fclose(ten);
+}
+
+// A triangle whose last node does not fit in a vtkIdType.
+static void WriteOverflowCase()
+{
+  FILE *fp = Open(".case");
+  fprintf(fp, "FORMAT\ntype: ensight gold\n\nGEOMETRY\nmodel: %s.geo\n",
+          Prefix);
+  fclose(fp);
+  fp = Open(".geo");
+  fprintf(fp, "Overflowing case\n\nnode id off\nelement id off\n");
+  fprintf(fp, "part\n%10d\nunstructured\ncoordinates\n%10d\n", 1, 3);
+  for (int c = 0; c < 3; ++c)
+    {
+    for (int p = 0; p < 3; ++p)
+      {
+      WriteReal(fp, p == c ? 1.0 : 0.0);
+      }
+    }
+  fprintf(fp, "tria3\n%10d\n%10d%10d 99999999999999999999\n", 1, 1, 2);
+  fclose(fp);
+}
+
+static void RemoveCase()
+{
+  for (int i = 0; Extensions[i]; ++i)
+    {
+    remove((vtkstd::string(Prefix) + Extensions[i]).c_str());
+    }
+}
+
+static int CompareValues(vtkDataArray *array, vtkIdType numTuples,
+                         int numComponents, float (*value)(vtkIdType, int),
+                         int firstComponent, const char *what)
+{
+  if (!array || array->GetNumberOfTuples() != numTuples ||
+      array->GetNumberOfComponents() != numComponents)
+    {
+    cerr << what << " were not read." << endl;
+    return 0;
+    }
+  for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+    for (int c = 0; c < numComponents; ++c)
+      {
+      if (array->GetComponent(t, c) != value(t, firstComponent + c))
+        {
+        cerr << what << " differ at " << t << ", " << c << endl;
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+static int CheckVariables(vtkDataSet *ds, const char *what)
+{
+  vtkIdType numPoints = ds->GetNumberOfPoints();
+  vtkIdType numCells = ds->GetNumberOfCells();
+  int ok = 1;
+  ok &= CompareValues(ds->GetPointData()->GetArray("Scalars"), numPoints, 1,
+                      NodeValue, 0, what);
+  ok &= CompareValues(ds->GetPointData()->GetArray("Vectors"), numPoints, 3,
+                      NodeValue, 1, what);
+  ok &= CompareValues(ds->GetCellData()->GetArray("CellScalars"), numCells, 1,
+                      CellValue, 0, what);
+  ok &= CompareValues(ds->GetCellData()->GetArray("Tensors"), numCells, 6,
+                      CellValue, 1, what);
+  return ok;
+}
+
+static int CheckUnstructured(vtkUnstructuredGrid *grid, int n)
+{
+  Sections sections(n);
+  if (!grid || grid->GetNumberOfPoints() != sections.NumPoints)
+    {
+    cerr << "The unstructured part was not read." << endl;
+    return 0;
+    }
+  for (int k = 0; k < n; ++k)
+    {
+    for (int j = 0; j < n; ++j)
+      {
+      for (int i = 0; i < n; ++i)
+        {
+        double *x = grid->GetPoint(sections.Id(i, j, k));
+        for (int c = 0; c < 3; ++c)
+          {
+          if (static_cast<float>(x[c]) != Coordinate(i, j, k, c))
+            {
+            cerr << "Point " << sections.Id(i, j, k) << " differs." << endl;
+            return 0;
+            }
+          }
+        }
+      }
+    }
+
+  static const int types[6] = { VTK_VERTEX, VTK_QUADRATIC_EDGE, VTK_TRIANGLE,
+                                VTK_HEXAHEDRON, VTK_POLYGON, VTK_POLYHEDRON };
+  vtkstd::vector<vtkIdType> nodes;
+  vsp(IdList, ids);
+  vtkIdType cellId = 0;
+  for (int s = 0; s < 6; ++s)
+    {
+    for (vtkIdType e = 0; e < sections.Counts[s]; ++e, ++cellId)
+      {
+      sections.Nodes(s, e, nodes);
+      // The reader reorders the nodes of bar3 and nsided elements.
+      vtkstd::vector<vtkIdType> expected;
+      if (s == 1)
+        {
+        expected.push_back(nodes[0] - 1);
+        expected.push_back(nodes[2] - 1);
+        expected.push_back(nodes[1] - 1);
+        }
+      else if (s == 4)
+        {
+        for (size_t v = nodes.size(); v > 0; --v)
+          {
+          expected.push_back(nodes[v - 1] - 1);
+          }
+        }
+      else if (s == 5)
+        {
+        for (size_t v = 0; v < nodes.size(); ++v)
+          {
+          expected.push_back(nodes[v] - (v % 5 ? 1 : 0));
+          }
+        }
+      else
+        {
+        for (size_t v = 0; v < nodes.size(); ++v)
+          {
+          expected.push_back(nodes[v] - 1);
+          }
+        }
+      if (s == 5)
+        {
+        grid->GetFaceStream(cellId, ids);
+        expected.insert(expected.begin(), 6);
+        }
+      else
+        {
+        grid->GetCellPoints(cellId, ids);
+        }
+      int same = grid->GetCellType(cellId) == types[s] &&
+        ids->GetNumberOfIds() == static_cast<vtkIdType>(expected.size());
+      for (vtkIdType v = 0; same && v < ids->GetNumberOfIds(); ++v)
+        {
+        same = ids->GetId(v) == expected[v];
+        }
+      if (!same)
+        {
+        cerr << sections.Names[s] << " element " << e << " differs." << endl;
+        return 0;
+        }
+      }
+    }
+  if (grid->GetNumberOfCells() != cellId)
+    {
+    cerr << "The unstructured part has " << grid->GetNumberOfCells()
+         << " cells instead of " << cellId << endl;
+    return 0;
+    }
+  return CheckVariables(grid, "Unstructured variables");
+}
+
+static int CheckStructured(vtkStructuredGrid *grid, int n)
+{
+  if (!grid || grid->GetNumberOfPoints() != n * n)
+    {
+    cerr << "The curvilinear part was not read." << endl;
+    return 0;
+    }
+  for (int p = 0; p < n * n; ++p)
+    {
+    double *x = grid->GetPoint(p);
+    for (int c = 0; c < 3; ++c)
+      {
+      if (static_cast<float>(x[c]) != Coordinate(p % n, p / n, c, c))
+        {
+        cerr << "Curvilinear point " << p << " differs." << endl;
+        return 0;
+        }
+      }
+    if (grid->IsPointVisible(p) != (p % 3 ? 1 : 0))
+      {
+      cerr << "Curvilinear point " << p << " is not blanked as given."
+           << endl;
+      return 0;
+      }
+    }
+  return CheckVariables(grid, "Curvilinear variables");
+}
+
+static int CheckRectilinear(vtkRectilinearGrid *grid, int n)
+{
+  int dims[3] = { n, n + 1, 2 };
+  if (!grid)
+    {
+    cerr << "The rectilinear part was not read." << endl;
+    return 0;
+    }
+  vtkDataArray *coordinates[3] = { grid->GetXCoordinates(),
+                                   grid->GetYCoordinates(),
+                                   grid->GetZCoordinates() };
+  for (int c = 0; c < 3; ++c)
+    {
+    if (coordinates[c]->GetNumberOfTuples() != dims[c])
+      {
+      cerr << "The rectilinear coordinates were not read." << endl;
+      return 0;
+      }
+    for (int i = 0; i < dims[c]; ++i)
+      {
+      if (coordinates[c]->GetComponent(i, 0) != Coordinate(i, i, i, c))
+        {
+        cerr << "Rectilinear coordinate " << i << " differs." << endl;
+        return 0;
+        }
+      }
+    }
+  return CheckVariables(grid, "Rectilinear variables");
+}
+
+static vtkMultiBlockDataSet *Read(vtkGenericEnSightReader *reader,
+                                  double &seconds)
+{
+  vsp(TimerLog, timer);
+  vtkstd::string name = vtkstd::string(Prefix) + ".case";
+  reader->SetCaseFileName(name.c_str());
+  timer->StartTimer();
+  reader->Update();
+  timer->StopTimer();
+  seconds = timer->GetElapsedTime();
+  return reader->GetOutput();
+}
+
+int TestEnSightGoldReaderASCII(int, char *[])
+{
+  int ok = 1;
+  const int n = 7;
+  WriteCase(n, 1);
+    {
+    vsp(GenericEnSightReader, reader);
+    double seconds;
+    vtkMultiBlockDataSet *output = Read(reader, seconds);
+    if (output->GetNumberOfBlocks() != 3)
+      {
+      cerr << "The case has " << output->GetNumberOfBlocks()
+           << " parts instead of 3." << endl;
+      ok = 0;
+      }
+    else
+      {
+      ok &= CheckUnstructured(
+        vtkUnstructuredGrid::SafeDownCast(output->GetBlock(0)), n);
+      ok &= CheckStructured(
+        vtkStructuredGrid::SafeDownCast(output->GetBlock(1)), n);
+      ok &= CheckRectilinear(
+        vtkRectilinearGrid::SafeDownCast(output->GetBlock(2)), n);
+      }
+    }
+  RemoveCase();
+
+  WriteOverflowCase();
+    {
+    vsp(GenericEnSightReader, reader);
+    double seconds;
+    vtkMultiBlockDataSet *output = Read(reader, seconds);
+    vtkUnstructuredGrid *grid = output->GetNumberOfBlocks() ?
+      vtkUnstructuredGrid::SafeDownCast(output->GetBlock(0)) : 0;
+    if (grid && grid->GetNumberOfCells() != 0)
+      {
+      cerr << "A node id too large for a vtkIdType was read." << endl;
+      ok = 0;
+      }
+    }
+  RemoveCase();
+
+  // A larger case to time.
+  const int large = 41;
+  WriteCase(large, 0);
+    {
+    vsp(GenericEnSightReader, reader);
+    double seconds;
+    vtkMultiBlockDataSet *output = Read(reader, seconds);
+    vtkUnstructuredGrid *grid =
+      vtkUnstructuredGrid::SafeDownCast(output->GetBlock(0));
+    Sections sections(large);
+    vtkIdType numCells = 0;
+    for (int s = 0; s < 6; ++s)
+      {
+      numCells += sections.Counts[s];
+      }
+    if (!grid || grid->GetNumberOfCells() != numCells ||
+        !CheckVariables(grid, "Large case"))
+      {
+      cerr << "The large case was not read." << endl;
+      ok = 0;
+      }
+    else
+      {
+      cout << "Read " << grid->GetNumberOfPoints() << " points and "
+           << grid->GetNumberOfCells() << " cells with their variables in "
+           << seconds << "s" << endl;
+      }
+    }
+  RemoveCase();
+
+  return ok ? 0 : 1;
+}
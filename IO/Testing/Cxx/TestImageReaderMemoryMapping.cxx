@@ -0,0 +1,238 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageReaderMemoryMapping.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkImageReader2 and vtkImageReader give the same images with
+// the file mapped into memory as when reading it, that the scalars point
+// into the mapping when the extent is stored as is and outlive the reader,
+// and that sub-extents, flipped rows, swapped bytes and masks are copied
+// out of the mapping instead.
+
+#include "vtkImageData.h"
+#include "vtkImageReader.h"
+#include "vtkImageReader2.h"
+#include "vtkMemoryMappedFile.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static const char *FileName = "TestImageReaderMemoryMapping.raw";
+static const int HeaderSize = 48;
+static const int Dims[3] = { 21, 15, 10 };
+
+static short Value(int i, int j, int k)
+{
+  return static_cast<short>(i * 37 - j * 1001 + k * 4111);
+}
+
+static int WriteFile()
+{
+  FILE *fp = fopen(FileName, "wb");
+  if (!fp)
+    {
+    return 0;
+    }
+  char header[HeaderSize];
+  memset(header, 'h', HeaderSize);
+  fwrite(header, 1, HeaderSize, fp);
+  for (int k = 0; k < Dims[2]; ++k)
+    {
+    for (int j = 0; j < Dims[1]; ++j)
+      {
+      for (int i = 0; i < Dims[0]; ++i)
+        {
+        short v = Value(i, j, k);
+        fwrite(&v, sizeof(short), 1, fp);
+        }
+      }
+    }
+  fclose(fp);
+  return 1;
+}
+
+static void SetUp(vtkImageReader2 *reader, int mapped)
+{
+  reader->SetFileName(FileName);
+  reader->SetDataScalarTypeToShort();
+  reader->SetFileDimensionality(3);
+  reader->SetDataExtent(0, Dims[0] - 1, 0, Dims[1] - 1, 0, Dims[2] - 1);
+  reader->SetHeaderSize(HeaderSize);
+  reader->FileLowerLeftOn();
+  reader->SetMemoryMapping(mapped);
+}
+
+static vtkImageData *Read(vtkImageReader2 *reader, const int *extent)
+{
+  // Always execute, even when the last output holds the extent.
+  reader->Modified();
+  vtkImageData *output = reader->GetOutput();
+  output->UpdateInformation();
+  if (extent)
+    {
+    output->SetUpdateExtent(const_cast<int *>(extent));
+    }
+  else
+    {
+    output->SetUpdateExtentToWholeExtent();
+    }
+  output->Update();
+  return output;
+}
+
+static int IsMapped(vtkImageData *image)
+{
+  return vtkMemoryMappedFile::IsAttachedTo(image->GetPointData()->GetScalars());
+}
+
+static int Compare(vtkImageData *a, vtkImageData *b, const char *what)
+{
+  int *e = a->GetExtent();
+  int *f = b->GetExtent();
+  for (int i = 0; i < 6; ++i)
+    {
+    if (e[i] != f[i])
+      {
+      cerr << what << ": the extents differ." << endl;
+      return 0;
+      }
+    }
+  vtkDataArray *x = a->GetPointData()->GetScalars();
+  vtkDataArray *y = b->GetPointData()->GetScalars();
+  if (!x || !y || x->GetDataType() != y->GetDataType() ||
+      x->GetNumberOfTuples() != y->GetNumberOfTuples() ||
+      strcmp(x->GetName(), y->GetName()) ||
+      memcmp(x->GetVoidPointer(0), y->GetVoidPointer(0),
+             x->GetNumberOfTuples() * x->GetDataTypeSize()))
+    {
+    cerr << what << ": the scalars differ." << endl;
+    return 0;
+    }
+  return 1;
+}
+
+static int CheckValues(vtkImageData *image, const char *what)
+{
+  int *e = image->GetExtent();
+  for (int k = e[4]; k <= e[5]; ++k)
+    {
+    for (int j = e[2]; j <= e[3]; ++j)
+      {
+      for (int i = e[0]; i <= e[1]; ++i)
+        {
+        short *v = static_cast<short *>(image->GetScalarPointer(i, j, k));
+        if (*v != Value(i, j, k))
+          {
+          cerr << what << ": wrong value at " << i << ", " << j << ", " << k
+               << endl;
+          return 0;
+          }
+        }
+      }
+    }
+  return 1;
+}
+
+// Reads the file with and without mapping it, in the given way.
+static int TestReader(vtkImageReader2 *streamed, vtkImageReader2 *mapped,
+                      const int *extent, int expectMapped, const char *what)
+{
+  vtkImageData *a = Read(streamed, extent);
+  vtkImageData *b = Read(mapped, extent);
+  int ok = Compare(a, b, what);
+  if (IsMapped(a) || IsMapped(b) != expectMapped)
+    {
+    cerr << what << ": the scalars " << (expectMapped ? "do not " : "")
+         << "point into the mapped file." << endl;
+    ok = 0;
+    }
+  return ok;
+}
+
+int TestImageReaderMemoryMapping(int, char *[])
+{
+  if (!vtkMemoryMappedFile::IsSupported())
+    {
+    return 0;
+    }
+  if (!WriteFile())
+    {
+    cerr << "Could not write " << FileName << endl;
+    return 1;
+    }
+
+  int ok = 1;
+  int slab[6] = { 0, Dims[0] - 1, 0, Dims[1] - 1, 3, 6 };
+  int row[6] = { 0, Dims[0] - 1, 7, 7, 2, 2 };
+  int box[6] = { 2, 11, 3, 9, 1, 8 };
+
+  vtkImageData *image;
+  vtkSmartPointer<vtkImageData> kept = vtkSmartPointer<vtkImageData>::New();
+    {
+    vsp(ImageReader2, streamed);
+    vsp(ImageReader2, mapped);
+    SetUp(streamed, 0);
+    SetUp(mapped, 1);
+
+    ok &= TestReader(streamed, mapped, NULL, 1, "Whole extent");
+    image = mapped->GetOutput();
+    ok &= CheckValues(image, "Whole extent");
+    kept->ShallowCopy(image);
+
+    ok &= TestReader(streamed, mapped, slab, 1, "Slab");
+    ok &= CheckValues(mapped->GetOutput(), "Slab");
+    ok &= TestReader(streamed, mapped, row, 1, "Row");
+    ok &= TestReader(streamed, mapped, box, 0, "Box");
+    ok &= CheckValues(mapped->GetOutput(), "Box");
+
+    streamed->FileLowerLeftOff();
+    mapped->FileLowerLeftOff();
+    ok &= TestReader(streamed, mapped, NULL, 0, "Upper left");
+    ok &= TestReader(streamed, mapped, box, 0, "Upper left box");
+
+    streamed->FileLowerLeftOn();
+    mapped->FileLowerLeftOn();
+    streamed->SwapBytesOn();
+    mapped->SwapBytesOn();
+    ok &= TestReader(streamed, mapped, NULL, 0, "Swapped");
+    ok &= TestReader(streamed, mapped, box, 0, "Swapped box");
+    }
+
+  // The mapping outlives the readers.
+  ok &= CheckValues(kept, "After deleting the reader");
+
+  vsp(ImageReader, streamed);
+  vsp(ImageReader, mapped);
+  SetUp(streamed, 0);
+  SetUp(mapped, 1);
+  streamed->SetScalarArrayName("Values");
+  mapped->SetScalarArrayName("Values");
+  ok &= TestReader(streamed, mapped, NULL, 1, "vtkImageReader");
+  ok &= TestReader(streamed, mapped, slab, 1, "vtkImageReader slab");
+  ok &= TestReader(streamed, mapped, box, 0, "vtkImageReader box");
+  streamed->FileLowerLeftOff();
+  mapped->FileLowerLeftOff();
+  ok &= TestReader(streamed, mapped, box, 0, "vtkImageReader upper left");
+  streamed->FileLowerLeftOn();
+  mapped->FileLowerLeftOn();
+  streamed->SetDataMask(0x0ff0);
+  mapped->SetDataMask(0x0ff0);
+  ok &= TestReader(streamed, mapped, NULL, 0, "vtkImageReader mask");
+
+  remove(FileName);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,438 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOpenFOAMReaderThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a small ascii OpenFOAM case, a block of hexahedra with one wall
+// patch and two time steps of a scalar and a vector field, and checks that
+// reading it with several threads gives exactly what reading it with one
+// thread gives, for the internal mesh and the patch at both time steps.
+
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDirectory.h"
+#include "vtkIdList.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkOpenFOAMReader.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vtkstd/string>
+#include <vtkstd/vector>
+
+#include <stdio.h>
+#include <string.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static const char *Root = "TestOpenFOAMReaderThreads";
+
+// The number of hexahedra along each axis.
+static const int N = 6;
+
+static int PointId(int i, int j, int k)
+{
+  return i + (N + 1) * (j + (N + 1) * k);
+}
+
+static int CellId(int i, int j, int k)
+{
+  return i + N * (j + N * k);
+}
+
+static FILE *OpenFoamFile(const char *dir, const char *name,
+                          const char *className)
+{
+  vtkstd::string path = vtkstd::string(Root) + "/" + dir;
+  vtkDirectory::MakeDirectory(path.c_str());
+  path += vtkstd::string("/") + name;
+  FILE *fp = fopen(path.c_str(), "w");
+  if (fp)
+    {
+    fprintf(fp, "FoamFile\n{\n    version     2.0;\n    format      ascii;\n"
+            "    class       %s;\n    location    \"%s\";\n"
+            "    object      %s;\n}\n\n", className, dir, name);
+    }
+  return fp;
+}
+
+struct Face
+{
+  int Owner;
+  int Neighbour;
+  int Points[4];
+};
+
+static void AddFace(vtkstd::vector<Face> &faces, int owner, int neighbour,
+                    int p0, int p1, int p2, int p3)
+{
+  Face face;
+  face.Owner = owner;
+  face.Neighbour = neighbour;
+  face.Points[0] = p0;
+  face.Points[1] = p1;
+  face.Points[2] = p2;
+  face.Points[3] = p3;
+  faces.push_back(face);
+}
+
+// Returns the number of internal faces; they are first in faces, ordered by
+// owner and then by neighbour as OpenFOAM requires.
+static int MakeFaces(vtkstd::vector<Face> &faces)
+{
+  int i, j, k;
+  for (k = 0; k < N; ++k)
+    {
+    for (j = 0; j < N; ++j)
+      {
+      for (i = 0; i < N; ++i)
+        {
+        int c = CellId(i, j, k);
+        if (i < N - 1)
+          {
+          AddFace(faces, c, CellId(i + 1, j, k), PointId(i + 1, j, k),
+                  PointId(i + 1, j + 1, k), PointId(i + 1, j + 1, k + 1),
+                  PointId(i + 1, j, k + 1));
+          }
+        if (j < N - 1)
+          {
+          AddFace(faces, c, CellId(i, j + 1, k), PointId(i, j + 1, k),
+                  PointId(i, j + 1, k + 1), PointId(i + 1, j + 1, k + 1),
+                  PointId(i + 1, j + 1, k));
+          }
+        if (k < N - 1)
+          {
+          AddFace(faces, c, CellId(i, j, k + 1), PointId(i, j, k + 1),
+                  PointId(i + 1, j, k + 1), PointId(i + 1, j + 1, k + 1),
+                  PointId(i, j + 1, k + 1));
+          }
+        }
+      }
+    }
+  int numInternal = static_cast<int>(faces.size());
+  for (k = 0; k < N; ++k)
+    {
+    for (j = 0; j < N; ++j)
+      {
+      for (i = 0; i < N; ++i)
+        {
+        int c = CellId(i, j, k);
+        if (i == 0)
+          {
+          AddFace(faces, c, -1, PointId(0, j, k), PointId(0, j, k + 1),
+                  PointId(0, j + 1, k + 1), PointId(0, j + 1, k));
+          }
+        if (i == N - 1)
+          {
+          AddFace(faces, c, -1, PointId(N, j, k), PointId(N, j + 1, k),
+                  PointId(N, j + 1, k + 1), PointId(N, j, k + 1));
+          }
+        if (j == 0)
+          {
+          AddFace(faces, c, -1, PointId(i, 0, k), PointId(i + 1, 0, k),
+                  PointId(i + 1, 0, k + 1), PointId(i, 0, k + 1));
+          }
+        if (j == N - 1)
+          {
+          AddFace(faces, c, -1, PointId(i, N, k), PointId(i, N, k + 1),
+                  PointId(i + 1, N, k + 1), PointId(i + 1, N, k));
+          }
+        if (k == 0)
+          {
+          AddFace(faces, c, -1, PointId(i, j, 0), PointId(i, j + 1, 0),
+                  PointId(i + 1, j + 1, 0), PointId(i + 1, j, 0));
+          }
+        if (k == N - 1)
+          {
+          AddFace(faces, c, -1, PointId(i, j, N), PointId(i + 1, j, N),
+                  PointId(i + 1, j + 1, N), PointId(i, j + 1, N));
+          }
+        }
+      }
+    }
+  return numInternal;
+}
+
+static int WriteCase()
+{
+  vtkDirectory::MakeDirectory(Root);
+  FILE *fp = fopen((vtkstd::string(Root) + "/case.foam").c_str(), "w");
+  if (!fp)
+    {
+    cerr << "Can not write the case in " << Root << endl;
+    return 0;
+    }
+  fclose(fp);
+
+  fp = OpenFoamFile("system", "controlDict", "dictionary");
+  fprintf(fp, "application icoFoam;\nstartFrom startTime;\nstartTime 0;\n"
+          "stopAt endTime;\nendTime 1;\ndeltaT 1;\nwriteControl timeStep;\n"
+          "writeInterval 1;\n");
+  fclose(fp);
+
+  // the points are written in several formats, with a comment in the list
+  // so that the parser has to fall back to the token reader
+  const char *mesh = "constant/polyMesh";
+  int numPts = (N + 1) * (N + 1) * (N + 1);
+  fp = OpenFoamFile(mesh, "points", "vectorField");
+  fprintf(fp, "\n%d\n(\n", numPts);
+  for (int p = 0; p < numPts; ++p)
+    {
+    double x = p % (N + 1);
+    double y = 0.5 * ((p / (N + 1)) % (N + 1));
+    double z = 0.25 * (p / ((N + 1) * (N + 1)));
+    if (p == 5)
+      {
+      fprintf(fp, "// a comment in the list\n");
+      }
+    fprintf(fp, p % 2 ? "(%g %g %g)\n" : "( %.6e\t%.3E %.17g )\n", x, y, z);
+    }
+  fprintf(fp, ")\n");
+  fclose(fp);
+
+  vtkstd::vector<Face> faces;
+  int numInternal = MakeFaces(faces);
+  int numFaces = static_cast<int>(faces.size());
+  int f;
+  fp = OpenFoamFile(mesh, "faces", "faceList");
+  fprintf(fp, "\n%d\n(\n", numFaces);
+  for (f = 0; f < numFaces; ++f)
+    {
+    fprintf(fp, "4(%d %d %d %d)\n", faces[f].Points[0], faces[f].Points[1],
+            faces[f].Points[2], faces[f].Points[3]);
+    }
+  fprintf(fp, ")\n");
+  fclose(fp);
+  fp = OpenFoamFile(mesh, "owner", "labelList");
+  fprintf(fp, "\n%d\n(\n", numFaces);
+  for (f = 0; f < numFaces; ++f)
+    {
+    fprintf(fp, "%d\n", faces[f].Owner);
+    }
+  fprintf(fp, ")\n");
+  fclose(fp);
+  fp = OpenFoamFile(mesh, "neighbour", "labelList");
+  fprintf(fp, "\n%d\n(", numInternal);
+  for (f = 0; f < numInternal; ++f)
+    {
+    fprintf(fp, f ? " %d" : "%d", faces[f].Neighbour);
+    }
+  fprintf(fp, ")\n");
+  fclose(fp);
+  fp = OpenFoamFile(mesh, "boundary", "polyBoundaryMesh");
+  fprintf(fp, "\n1\n(\n    walls\n    {\n        type wall;\n"
+          "        nFaces %d;\n        startFace %d;\n    }\n)\n",
+          numFaces - numInternal, numInternal);
+  fclose(fp);
+
+  int numCells = N * N * N;
+  const char *times[2] = { "0", "1" };
+  for (int t = 0; t < 2; ++t)
+    {
+    double scale = t + 1.0;
+    fp = OpenFoamFile(times[t], "p", "volScalarField");
+    fprintf(fp, "dimensions [0 2 -2 0 0 0 0];\n"
+            "internalField nonuniform List<scalar>\n%d\n(\n", numCells);
+    for (int c = 0; c < numCells; ++c)
+      {
+      fprintf(fp, c % 2 ? "%.17g\n" : "%.4e\n", (c * 0.5 - 3.25) * scale);
+      }
+    fprintf(fp, ")\n;\nboundaryField\n{\n    walls\n    {\n"
+            "        type zeroGradient;\n    }\n}\n");
+    fclose(fp);
+
+    fp = OpenFoamFile(times[t], "U", "volVectorField");
+    fprintf(fp, "dimensions [0 1 -1 0 0 0 0];\n"
+            "internalField nonuniform List<vector>\n%d\n(\n", numCells);
+    for (int c = 0; c < numCells; ++c)
+      {
+      fprintf(fp, "(%.17g %g -%g)\n", c * scale, c + 0.25, c * 2.0);
+      }
+    fprintf(fp, ")\n;\nboundaryField\n{\n    walls\n    {\n"
+            "        type fixedValue;\n        value uniform (0 0 0);\n"
+            "    }\n}\n");
+    fclose(fp);
+
+    fp = OpenFoamFile(times[t], "T", "volScalarField");
+    fprintf(fp, "dimensions [0 0 0 1 0 0 0];\ninternalField uniform %g;\n"
+            "boundaryField\n{\n    walls\n    {\n        type fixedValue;\n"
+            "        value uniform 1;\n    }\n}\n", 300 * scale);
+    fclose(fp);
+    }
+  return 1;
+}
+
+static int CompareArrays(vtkDataArray *a, vtkDataArray *b, const char *what)
+{
+  if (!b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    cerr << what << ": array " << a->GetName() << " differs." << endl;
+    return 0;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+      {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+        {
+        cerr << what << ": array " << a->GetName() << " differs at tuple "
+             << i << "." << endl;
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+static int CompareDataSets(vtkDataSet *a, vtkDataSet *b, const char *what)
+{
+  if (!b || a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfCells() != b->GetNumberOfCells() ||
+      a->GetPointData()->GetNumberOfArrays() !=
+      b->GetPointData()->GetNumberOfArrays() ||
+      a->GetCellData()->GetNumberOfArrays() !=
+      b->GetCellData()->GetNumberOfArrays())
+    {
+    cerr << what << ": the sizes differ." << endl;
+    return 0;
+    }
+  vtkIdType i;
+  for (i = 0; i < a->GetNumberOfPoints(); ++i)
+    {
+    double pa[3], pb[3];
+    a->GetPoint(i, pa);
+    b->GetPoint(i, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+      {
+      cerr << what << ": point " << i << " differs." << endl;
+      return 0;
+      }
+    }
+  vsp(IdList, ida);
+  vsp(IdList, idb);
+  for (i = 0; i < a->GetNumberOfCells(); ++i)
+    {
+    a->GetCellPoints(i, ida);
+    b->GetCellPoints(i, idb);
+    int same = a->GetCellType(i) == b->GetCellType(i) &&
+      ida->GetNumberOfIds() == idb->GetNumberOfIds();
+    for (vtkIdType j = 0; same && j < ida->GetNumberOfIds(); ++j)
+      {
+      same = ida->GetId(j) == idb->GetId(j);
+      }
+    if (!same)
+      {
+      cerr << what << ": cell " << i << " differs." << endl;
+      return 0;
+      }
+    }
+  int k;
+  for (k = 0; k < a->GetPointData()->GetNumberOfArrays(); ++k)
+    {
+    vtkDataArray *array = a->GetPointData()->GetArray(k);
+    if (!CompareArrays(array,
+          b->GetPointData()->GetArray(array->GetName()), what))
+      {
+      return 0;
+      }
+    }
+  for (k = 0; k < a->GetCellData()->GetNumberOfArrays(); ++k)
+    {
+    vtkDataArray *array = a->GetCellData()->GetArray(k);
+    if (!CompareArrays(array,
+          b->GetCellData()->GetArray(array->GetName()), what))
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+static void Read(vtkOpenFOAMReader *reader, int numberOfThreads, double time)
+{
+  reader->SetFileName((vtkstd::string(Root) + "/case.foam").c_str());
+  reader->SetNumberOfThreads(numberOfThreads);
+  reader->CreateCellToPointOn();
+  reader->UpdateInformation();
+  for (int i = 0; i < reader->GetNumberOfPatchArrays(); ++i)
+    {
+    reader->SetPatchArrayStatus(reader->GetPatchArrayName(i), 1);
+    }
+  vtkStreamingDemandDrivenPipeline::SafeDownCast(reader->GetExecutive())
+    ->SetUpdateTimeStep(0, time);
+  reader->Update();
+}
+
+int TestOpenFOAMReaderThreads(int, char *[])
+{
+  if (!WriteCase())
+    {
+    return 1;
+    }
+
+  int ok = 1;
+  for (int t = 0; ok && t < 2; ++t)
+    {
+    vsp(OpenFOAMReader, serial);
+    Read(serial, 1, t);
+    vsp(OpenFOAMReader, threaded);
+    Read(threaded, 4, t);
+
+    vtkMultiBlockDataSet *a = serial->GetOutput();
+    vtkMultiBlockDataSet *b = threaded->GetOutput();
+    vtkCompositeDataIterator *ia = a->NewIterator();
+    vtkCompositeDataIterator *ib = b->NewIterator();
+    int numBlocks = 0;
+    for (ia->InitTraversal(), ib->InitTraversal();
+         ok && !ia->IsDoneWithTraversal();
+         ia->GoToNextItem(), ib->GoToNextItem(), ++numBlocks)
+      {
+      char what[64];
+      sprintf(what, "Time %d, block %d", t, numBlocks);
+      if (ib->IsDoneWithTraversal())
+        {
+        cerr << what << " is missing." << endl;
+        ok = 0;
+        break;
+        }
+      ok = CompareDataSets(
+        vtkDataSet::SafeDownCast(ia->GetCurrentDataObject()),
+        vtkDataSet::SafeDownCast(ib->GetCurrentDataObject()), what);
+      }
+    if (ok && (numBlocks != 2 || !ib->IsDoneWithTraversal()))
+      {
+      cerr << "Time " << t << ": expected the internal mesh and one patch."
+           << endl;
+      ok = 0;
+      }
+    ia->Delete();
+    ib->Delete();
+
+    // check the values against the case too
+    vtkDataSet *internalMesh = vtkDataSet::SafeDownCast(a->GetBlock(0));
+    vtkDataArray *p = internalMesh ?
+      internalMesh->GetCellData()->GetArray("p") : 0;
+    if (ok && (!internalMesh || internalMesh->GetNumberOfCells() != N*N*N ||
+               !p || p->GetComponent(7, 0) != (7 * 0.5 - 3.25) * (t + 1)))
+      {
+      cerr << "Time " << t << ": unexpected internal mesh." << endl;
+      ok = 0;
+      }
+    }
+
+  return !ok;
+}
@@ -0,0 +1,173 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLReaderDecompressionThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkXMLImageDataReader reads the same arrays with several
+// decompression threads as with one, from zlib and LZ4 files, appended
+// raw or encoded and inline, for whole and partial extents, and reports
+// how long the reads took.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkZLibDataCompressor.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static const char *FileName = "TestXMLReaderDecompressionThreads.vti";
+
+static int Write(vtkImageData *image, vtkDataCompressor *compressor,
+                 int mode, int encode)
+{
+  vsp(XMLImageDataWriter, writer);
+  writer->SetInput(image);
+  writer->SetFileName(FileName);
+  writer->SetCompressor(compressor);
+  writer->SetBlockSize(4096);
+  writer->SetDataMode(mode);
+  writer->SetEncodeAppendedData(encode);
+  return writer->Write();
+}
+
+static vtkImageData *Read(vtkXMLImageDataReader *reader, const int *extent,
+                          double &seconds)
+{
+  vsp(TimerLog, timer);
+  timer->StartTimer();
+  reader->Modified();
+  vtkImageData *output = reader->GetOutput();
+  output->UpdateInformation();
+  if (extent)
+    {
+    output->SetUpdateExtent(const_cast<int *>(extent));
+    }
+  else
+    {
+    output->SetUpdateExtentToWholeExtent();
+    }
+  output->Update();
+  timer->StopTimer();
+  seconds += timer->GetElapsedTime();
+  return output;
+}
+
+static int Compare(vtkImageData *a, vtkImageData *b, const char *what)
+{
+  vtkPointData *pa = a->GetPointData();
+  vtkPointData *pb = b->GetPointData();
+  if (pa->GetNumberOfArrays() != pb->GetNumberOfArrays() ||
+      pa->GetNumberOfArrays() == 0)
+    {
+    cerr << what << ": the arrays were not read." << endl;
+    return 0;
+    }
+  for (int i = 0; i < pa->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *x = pa->GetArray(i);
+    vtkDataArray *y = pb->GetArray(x->GetName());
+    if (!y || x->GetDataType() != y->GetDataType() ||
+        x->GetNumberOfTuples() != y->GetNumberOfTuples() ||
+        x->GetNumberOfComponents() != y->GetNumberOfComponents() ||
+        memcmp(x->GetVoidPointer(0), y->GetVoidPointer(0),
+               x->GetNumberOfTuples() * x->GetNumberOfComponents() *
+               x->GetDataTypeSize()))
+      {
+      cerr << what << ": array " << x->GetName() << " differs." << endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
+static int TestReader(vtkImageData *image, vtkDataCompressor *compressor,
+                      const char *what)
+{
+  int ok = 1;
+  int box[6] = { -17, 3, -20, 20, 5, 9 };
+  int row[6] = { -20, 20, 4, 4, 0, 0 };
+  const char *modes[3] = { "inline", "appended", "encoded" };
+  for (int m = 0; m < 3; ++m)
+    {
+    int mode = m == 0? vtkXMLWriter::Binary : vtkXMLWriter::Appended;
+    if (!Write(image, compressor, mode, m == 2))
+      {
+      cerr << what << ": writing failed." << endl;
+      return 0;
+      }
+
+    double serialTime = 0;
+    double threadedTime = 0;
+    vsp(XMLImageDataReader, serial);
+    vsp(XMLImageDataReader, threaded);
+    serial->SetFileName(FileName);
+    threaded->SetFileName(FileName);
+    threaded->SetNumberOfThreads(4);
+
+    vtkImageData *a = Read(serial, NULL, serialTime);
+    ok &= Compare(image, a, what);
+    vtkImageData *b = Read(threaded, NULL, threadedTime);
+    ok &= Compare(a, b, what);
+
+    a = Read(serial, box, serialTime);
+    b = Read(threaded, box, threadedTime);
+    ok &= Compare(a, b, what);
+    a = Read(serial, row, serialTime);
+    b = Read(threaded, row, threadedTime);
+    ok &= Compare(a, b, what);
+
+    cout << what << " " << modes[m] << ": " << serialTime << "s with 1 thread, "
+         << threadedTime << "s with 4 threads" << endl;
+    remove(FileName);
+    }
+  return ok;
+}
+
+int TestXMLReaderDecompressionThreads(int, char *[])
+{
+  vsp(RTAnalyticSource, wavelet);
+  wavelet->SetWholeExtent(-20, 20, -20, 20, -20, 20);
+  wavelet->Update();
+  vsp(ImageData, image);
+  image->ShallowCopy(wavelet->GetOutput());
+
+  // Add an array with words of another size.
+  vtkIdType numPoints = image->GetNumberOfPoints();
+  vtkDataArray *rt = image->GetPointData()->GetScalars();
+  vsp(DoubleArray, vectors);
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    double v = rt->GetTuple1(i);
+    vectors->InsertNextTuple3(v, v * v, i);
+    }
+  image->GetPointData()->AddArray(vectors);
+
+  int ok = 1;
+  vsp(ZLibDataCompressor, zlib);
+  ok &= TestReader(image, zlib, "zlib");
+  vsp(LZ4DataCompressor, lz4);
+  ok &= TestReader(image, lz4, "LZ4");
+
+  return ok ? 0 : 1;
+}
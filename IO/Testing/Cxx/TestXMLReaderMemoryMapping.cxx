@@ -0,0 +1,203 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLReaderMemoryMapping.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkXMLImageDataReader reads the same arrays with the file
+// mapped into memory as without, that the raw appended arrays, which the
+// writer aligns, point into the mapping and outlive the reader, and that
+// encoded, compressed and partially read arrays are read as usual.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkMemoryMappedFile.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkZLibDataCompressor.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static const char *FileName = "TestXMLReaderMemoryMapping.vti";
+
+static int Write(vtkImageData *image, int encode, int compress)
+{
+  vsp(XMLImageDataWriter, writer);
+  writer->SetInput(image);
+  writer->SetFileName(FileName);
+  writer->SetDataModeToAppended();
+  writer->SetEncodeAppendedData(encode);
+  if (compress)
+    {
+    vsp(ZLibDataCompressor, zlib);
+    writer->SetCompressor(zlib);
+    }
+  else
+    {
+    writer->SetCompressor(0);
+    }
+  return writer->Write();
+}
+
+static vtkImageData *Read(vtkXMLImageDataReader *reader, const int *extent)
+{
+  reader->Modified();
+  vtkImageData *output = reader->GetOutput();
+  output->UpdateInformation();
+  if (extent)
+    {
+    output->SetUpdateExtent(const_cast<int *>(extent));
+    }
+  else
+    {
+    output->SetUpdateExtentToWholeExtent();
+    }
+  output->Update();
+  return output;
+}
+
+// Compares the arrays of two images and counts those of the second that
+// point into a mapped file.
+static int Compare(vtkImageData *a, vtkImageData *b, int &numMapped,
+                   const char *what)
+{
+  vtkPointData *pa = a->GetPointData();
+  vtkPointData *pb = b->GetPointData();
+  numMapped = 0;
+  if (pa->GetNumberOfArrays() != 3 ||
+      pa->GetNumberOfArrays() != pb->GetNumberOfArrays())
+    {
+    cerr << what << ": the arrays were not read." << endl;
+    return 0;
+    }
+  for (int i = 0; i < pa->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray *x = pa->GetArray(i);
+    vtkDataArray *y = pb->GetArray(x->GetName());
+    if (!y || x->GetDataType() != y->GetDataType() ||
+        x->GetNumberOfTuples() != y->GetNumberOfTuples() ||
+        x->GetNumberOfComponents() != y->GetNumberOfComponents() ||
+        memcmp(x->GetVoidPointer(0), y->GetVoidPointer(0),
+               x->GetNumberOfTuples() * x->GetNumberOfComponents() *
+               x->GetDataTypeSize()))
+      {
+      cerr << what << ": array " << x->GetName() << " differs." << endl;
+      return 0;
+      }
+    numMapped += vtkMemoryMappedFile::IsAttachedTo(y);
+    }
+  return 1;
+}
+
+int TestXMLReaderMemoryMapping(int, char *[])
+{
+  if (!vtkMemoryMappedFile::IsSupported())
+    {
+    return 0;
+    }
+
+  vsp(RTAnalyticSource, wavelet);
+  wavelet->SetWholeExtent(-20, 20, -20, 20, -20, 20);
+  wavelet->Update();
+  vsp(ImageData, image);
+  image->ShallowCopy(wavelet->GetOutput());
+
+  // Add arrays with words of other sizes.
+  vtkIdType numPoints = image->GetNumberOfPoints();
+  vtkDataArray *rt = image->GetPointData()->GetScalars();
+  vsp(DoubleArray, vectors);
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vsp(UnsignedCharArray, bytes);
+  bytes->SetName("Bytes");
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    double v = rt->GetTuple1(i);
+    vectors->InsertNextTuple3(v, v * v, i);
+    bytes->InsertNextValue(static_cast<unsigned char>(i * 7));
+    }
+  image->GetPointData()->AddArray(vectors);
+  image->GetPointData()->AddArray(bytes);
+
+  int ok = 1;
+  int numMapped;
+  int box[6] = { -17, 3, -20, 20, 5, 9 };
+
+  // Raw appended data are mapped.
+  if (!Write(image, 0, 0))
+    {
+    cerr << "Could not write " << FileName << endl;
+    return 1;
+    }
+  vtkSmartPointer<vtkImageData> kept = vtkSmartPointer<vtkImageData>::New();
+    {
+    vsp(XMLImageDataReader, streamed);
+    vsp(XMLImageDataReader, mapped);
+    streamed->SetFileName(FileName);
+    mapped->SetFileName(FileName);
+    mapped->MemoryMappingOn();
+
+    ok &= Compare(image, Read(streamed, NULL), numMapped, "Streamed");
+    if (numMapped)
+      {
+      cerr << "Streamed arrays point into a mapped file." << endl;
+      ok = 0;
+      }
+    ok &= Compare(image, Read(mapped, NULL), numMapped, "Mapped");
+    if (numMapped != 3)
+      {
+      cerr << "Only " << numMapped << " raw appended arrays point into the "
+           << "mapped file." << endl;
+      ok = 0;
+      }
+    kept->ShallowCopy(mapped->GetOutput());
+
+    // Only parts of the arrays are read for a sub-extent.
+    ok &= Compare(Read(streamed, box), Read(mapped, box), numMapped,
+                  "Sub-extent");
+    if (numMapped)
+      {
+      cerr << "Sub-extent arrays point into the mapped file." << endl;
+      ok = 0;
+      }
+    }
+
+  // The mapping outlives the reader and the file.
+  remove(FileName);
+  ok &= Compare(image, kept, numMapped, "After deleting the reader");
+
+  // Encoded and compressed data are read as usual.
+  for (int i = 0; i < 2; ++i)
+    {
+    const char *what = i ? "Compressed" : "Encoded";
+    Write(image, i == 0, i == 1);
+    vsp(XMLImageDataReader, mapped);
+    mapped->SetFileName(FileName);
+    mapped->MemoryMappingOn();
+    ok &= Compare(image, Read(mapped, NULL), numMapped, what);
+    if (numMapped)
+      {
+      cerr << what << " arrays point into the mapped file." << endl;
+      ok = 0;
+      }
+    remove(FileName);
+    }
+
+  return ok ? 0 : 1;
+}
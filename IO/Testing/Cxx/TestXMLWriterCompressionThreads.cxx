@@ -0,0 +1,266 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLWriterCompressionThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkLZ4DataCompressor restores what it compresses, for data
+// from incompressible to constant, and that vtkXMLWriter writes the same
+// file with several compression threads as with one, for both zlib and
+// LZ4, which vtkXMLImageDataReader then reads back.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkMath.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkZLibDataCompressor.h"
+
+#include <vtkstd/string>
+#include <vtkstd/vector>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define vsp(type, name) \
+        vtkSmartPointer<vtk##type> name = vtkSmartPointer<vtk##type>::New()
+
+static int RoundTrip(vtkDataCompressor *compressor,
+                     const vtkstd::vector<unsigned char> &data,
+                     const char *what)
+{
+  unsigned long size = static_cast<unsigned long>(data.size());
+  const unsigned char *in = size ? &data[0] : 0;
+  vtkUnsignedCharArray *compressed = compressor->Compress(in, size);
+  if (!compressed)
+    {
+    cerr << what << ": compression of " << size << " bytes failed." << endl;
+    return 0;
+    }
+  int ok = 1;
+  if (static_cast<unsigned long>(compressed->GetNumberOfTuples()) >
+      compressor->GetMaximumCompressionSpace(size))
+    {
+    cerr << what << ": " << size << " bytes compressed beyond the maximum."
+         << endl;
+    ok = 0;
+    }
+  if (size)
+    {
+    vtkUnsignedCharArray *restored = compressor->Uncompress(
+      compressed->GetPointer(0), compressed->GetNumberOfTuples(), size);
+    if (!restored || memcmp(restored->GetPointer(0), in, size))
+      {
+      cerr << what << ": " << size << " bytes not restored." << endl;
+      ok = 0;
+      }
+    if (restored)
+      {
+      restored->Delete();
+      }
+    }
+  compressed->Delete();
+  return ok;
+}
+
+static int TestLZ4()
+{
+  int ok = 1;
+  vsp(LZ4DataCompressor, lz4);
+  vtkMath::RandomSeed(1234);
+
+  vtkstd::vector<unsigned char> data;
+  for (int size = 0; size < 300; ++size)
+    {
+    data.resize(size);
+    for (int i = 0; i < size; ++i)
+      {
+      data[i] = static_cast<unsigned char>(vtkMath::Random(0, 256));
+      }
+    ok &= RoundTrip(lz4, data, "Random");
+    for (int i = 0; i < size; ++i)
+      {
+      data[i] = static_cast<unsigned char>(i % (1 + size % 7));
+      }
+    ok &= RoundTrip(lz4, data, "Periodic");
+    }
+
+  // Long runs and literals, matches farther apart than a match can reach,
+  // and smooth floating point values.
+  data.assign(300000, 0);
+  ok &= RoundTrip(lz4, data, "Zeros");
+  for (size_t i = 0; i < data.size(); ++i)
+    {
+    data[i] = static_cast<unsigned char>(
+      i % 100000 < 70000 ? vtkMath::Random(0, 256) : i % 3);
+    }
+  ok &= RoundTrip(lz4, data, "Far matches");
+  vtkstd::vector<float> values(100000);
+  for (size_t i = 0; i < values.size(); ++i)
+    {
+    values[i] = static_cast<float>(sin(i * 0.001) * 100.0);
+    }
+  data.assign(reinterpret_cast<unsigned char *>(&values[0]),
+              reinterpret_cast<unsigned char *>(&values[0] + values.size()));
+  for (int level = 1; level <= 64; level *= 8)
+    {
+    lz4->SetAccelerationLevel(level);
+    ok &= RoundTrip(lz4, data, "Floats");
+    }
+
+  // Corrupted blocks are rejected.
+  data.assign(1000, 'a');
+  vtkUnsignedCharArray *compressed = lz4->Compress(&data[0], 1000);
+  unsigned char *block = compressed->GetPointer(0);
+  unsigned long blockSize = compressed->GetNumberOfTuples();
+  vtkstd::vector<unsigned char> restored(1000);
+  vtkObject::GlobalWarningDisplayOff();
+  if (lz4->Uncompress(block, blockSize - 1, &restored[0], 1000) ||
+      lz4->Uncompress(block, blockSize, &restored[0], 999))
+    {
+    cerr << "A truncated block was uncompressed." << endl;
+    ok = 0;
+    }
+  vtkObject::GlobalWarningDisplayOn();
+  compressed->Delete();
+  return ok;
+}
+
+static vtkstd::string ReadFile(const char *name)
+{
+  vtkstd::string contents;
+  FILE *fp = fopen(name, "rb");
+  if (fp)
+    {
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0)
+      {
+      contents.append(buffer, n);
+      }
+    fclose(fp);
+    }
+  return contents;
+}
+
+static int Write(vtkImageData *image, vtkDataCompressor *compressor,
+                 int numThreads, int encode, const char *name)
+{
+  vsp(XMLImageDataWriter, writer);
+  writer->SetInput(image);
+  writer->SetFileName(name);
+  writer->SetCompressor(compressor);
+  writer->SetBlockSize(4096);
+  writer->SetNumberOfThreads(numThreads);
+  writer->SetEncodeAppendedData(encode);
+  return writer->Write();
+}
+
+static int CompareArrays(vtkImageData *a, vtkImageData *b, const char *what)
+{
+  vtkPointData *pa = a->GetPointData();
+  vtkPointData *pb = b->GetPointData();
+  for (int i = 0; i < pa->GetNumberOfArrays(); ++i)
+    {
+    vtkAbstractArray *x = pa->GetAbstractArray(i);
+    vtkAbstractArray *y = pb->GetAbstractArray(x->GetName());
+    vtkIdType n = x->GetNumberOfTuples() * x->GetNumberOfComponents();
+    if (!y || y->GetNumberOfTuples() * y->GetNumberOfComponents() != n)
+      {
+      cerr << what << ": array " << x->GetName() << " was not read." << endl;
+      return 0;
+      }
+    for (vtkIdType j = 0; j < n; ++j)
+      {
+      if (x->GetVariantValue(j) != y->GetVariantValue(j))
+        {
+        cerr << what << ": array " << x->GetName() << " differs at " << j
+             << endl;
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+static int TestWriter(vtkImageData *image, vtkDataCompressor *compressor,
+                      const char *what)
+{
+  int ok = 1;
+  for (int encode = 0; encode <= 1; ++encode)
+    {
+    const char *serialName = "TestXMLWriterCompressionThreads1.vti";
+    const char *threadedName = "TestXMLWriterCompressionThreads4.vti";
+    if (!Write(image, compressor, 1, encode, serialName) ||
+        !Write(image, compressor, 4, encode, threadedName))
+      {
+      cerr << what << ": writing failed." << endl;
+      return 0;
+      }
+    vtkstd::string serial = ReadFile(serialName);
+    if (serial.empty() || serial != ReadFile(threadedName))
+      {
+      cerr << what << ": the threads wrote a different file." << endl;
+      ok = 0;
+      }
+
+    vsp(XMLImageDataReader, reader);
+    reader->SetFileName(threadedName);
+    reader->Update();
+    ok &= CompareArrays(image, reader->GetOutput(), what);
+
+    remove(serialName);
+    remove(threadedName);
+    }
+  return ok;
+}
+
+int TestXMLWriterCompressionThreads(int, char *[])
+{
+  int ok = TestLZ4();
+
+  vsp(RTAnalyticSource, wavelet);
+  wavelet->SetWholeExtent(-20, 20, -20, 20, -20, 20);
+  wavelet->Update();
+  vsp(ImageData, image);
+  image->ShallowCopy(wavelet->GetOutput());
+
+  // Arrays of other sizes and ids split across the blocks.
+  vtkIdType numPoints = image->GetNumberOfPoints();
+  vtkDataArray *rt = image->GetPointData()->GetScalars();
+  vsp(DoubleArray, vectors);
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vsp(IdTypeArray, ids);
+  ids->SetName("Ids");
+  for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+    double v = rt->GetTuple1(i);
+    vectors->InsertNextTuple3(v, v * v, i);
+    ids->InsertNextValue(i * 7 % 1001);
+    }
+  image->GetPointData()->AddArray(vectors);
+  image->GetPointData()->AddArray(ids);
+
+  vsp(ZLibDataCompressor, zlib);
+  ok &= TestWriter(image, zlib, "zlib");
+  vsp(LZ4DataCompressor, lz4);
+  ok &= TestWriter(image, lz4, "LZ4");
+
+  return ok ? 0 : 1;
+}
@@ -52,7 +52,11 @@
 #include "vtkTypeUInt64Array.h"
 #endif
 
+#include "vtkTypeTraits.h"
+
 #include <ctype.h>
+#include <locale>
+#include <math.h>
 #include <sys/stat.h>
 
 // I need a safe way to read a line of arbitrary length.  It exists on
@@ -268,158 +272,266 @@ int vtkDataReader::ReadString(char result[256])
   return 1;
 }
 
-// Internal function to read in an integer value.
-// Returns zero if there was an error.
-int vtkDataReader::Read(char *result)
+// Ascii values are parsed straight from the stream buffer instead of
+// with operator>>, whose sentry and locale lookups dominate the time
+// taken to read large files.  Plain decimal numbers are converted here,
+// exactly; other tokens are given to a stream in the classic locale so
+// that they are accepted or rejected just as before.
+static inline int vtkDataReaderIsSpace(int c)
 {
-  int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-
-  *result = (char) intData;
-  return 1;
+  return (c == ' ' || c == '\n' || c == '\r' || c == '\t' ||
+          c == '\v' || c == '\f');
 }
 
-int vtkDataReader::Read(unsigned char *result)
+// Read the next whitespace separated token.  Returns its length, or 0
+// at the end of the input or if it does not fit in the buffer.
+static int vtkDataReaderReadToken(istream *is, char *token, int size)
 {
-  int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
+  typedef vtkstd::char_traits<char> traits;
+  vtkstd::streambuf *sb = is->rdbuf();
+  traits::int_type c = sb->sgetc();
+  while (!traits::eq_int_type(c, traits::eof()) && vtkDataReaderIsSpace(c))
     {
-    return 0;
+    c = sb->snextc();
     }
-
-  *result = (unsigned char) intData;
-  return 1;
-}
-
-int vtkDataReader::Read(short *result)
-{
-  *this->IS >> *result;
-  if (this->IS->fail())
+  int length = 0;
+  while (!traits::eq_int_type(c, traits::eof()) && !vtkDataReaderIsSpace(c))
     {
-    return 0;
+    if (length == size - 1)
+      {
+      return 0;
+      }
+    token[length++] = traits::to_char_type(c);
+    c = sb->snextc();
     }
-  return 1;
+  token[length] = 0;
+  if (traits::eq_int_type(c, traits::eof()))
+    {
+    is->setstate(ios::eofbit);
+    }
+  return length;
 }
 
-int vtkDataReader::Read(unsigned short *result)
+template <class T>
+int vtkDataReaderParseWithStream(const char *token, T &value)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  vtksys_ios::istringstream is(token);
+  is.imbue(vtkstd::locale::classic());
+  is >> value;
+  return !is.fail() && is.eof();
 }
 
-int vtkDataReader::Read(int *result)
+// Convert an optionally signed decimal integer that fits in T.
+template <class T>
+int vtkDataReaderParseInteger(const char *p, T &value)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  int negative = (*p == '-');
+  if (*p == '-' || *p == '+')
+    {
+    ++p;
+    }
+  if (*p < '0' || *p > '9' || (negative && vtkTypeTraits<T>::Min() == 0))
     {
     return 0;
     }
-  return 1;
-}
-
-int vtkDataReader::Read(unsigned int *result)
-{
-  *this->IS >> *result;
-  if (this->IS->fail())
+  vtkTypeUInt64 limit = static_cast<vtkTypeUInt64>(vtkTypeTraits<T>::Max()) +
+    (negative ? 1 : 0);
+  vtkTypeUInt64 v = 0;
+  for (; *p >= '0' && *p <= '9'; ++p)
+    {
+    unsigned int digit = *p - '0';
+    if (v > (limit - digit) / 10)
+      {
+      return 0;
+      }
+    v = v * 10 + digit;
+    }
+  if (*p)
     {
     return 0;
     }
+  value = static_cast<T>(negative ? 0 - v : v);
   return 1;
 }
 
-int vtkDataReader::Read(long *result)
+// Convert a decimal number whose digits, as an integer, are below 2^53
+// and whose power of ten is within 22 of them.  Both are then exact
+// doubles, so one division or multiplication rounds correctly.
+static int vtkDataReaderParseReal(const char *p, double &value)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  static const double powers[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+  int negative = (*p == '-');
+  if (*p == '-' || *p == '+')
+    {
+    ++p;
+    }
+  vtkTypeUInt64 m = 0;
+  int digits = 0;
+  int numDigits = 0;
+  int exponent = 0;
+  for (; *p >= '0' && *p <= '9'; ++p, ++numDigits)
+    {
+    if (digits == 19)
+      {
+      return 0;
+      }
+    m = m * 10 + (*p - '0');
+    digits += (m != 0);
+    }
+  if (*p == '.')
+    {
+    for (++p; *p >= '0' && *p <= '9'; ++p, ++numDigits)
+      {
+      if (digits == 19)
+        {
+        return 0;
+        }
+      m = m * 10 + (*p - '0');
+      digits += (m != 0);
+      --exponent;
+      }
+    }
+  if (numDigits == 0)
     {
     return 0;
     }
-  return 1;
-}
-
-int vtkDataReader::Read(unsigned long *result)
-{
-  *this->IS >> *result;
-  if (this->IS->fail())
+  if (*p == 'e' || *p == 'E')
+    {
+    ++p;
+    int negativeExponent = (*p == '-');
+    if (*p == '-' || *p == '+')
+      {
+      ++p;
+      }
+    if (*p < '0' || *p > '9')
+      {
+      return 0;
+      }
+    int e = 0;
+    for (; *p >= '0' && *p <= '9' && e < 10000; ++p)
+      {
+      e = e * 10 + (*p - '0');
+      }
+    exponent += negativeExponent ? -e : e;
+    }
+  if (*p || m >> 53 || exponent < -22 || exponent > 22)
     {
     return 0;
     }
+  double v = static_cast<double>(static_cast<vtkTypeInt64>(m));
+  v = exponent < 0 ? v / powers[-exponent] : v * powers[exponent];
+  value = negative ? -v : v;
   return 1;
 }
 
-#if defined(VTK_TYPE_USE___INT64)
-int vtkDataReader::Read(__int64 *result)
+template <class T>
+int vtkDataReaderParseValue(const char *token, T &value)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return (vtkDataReaderParseInteger(token, value) ||
+          vtkDataReaderParseWithStream(token, value));
 }
 
-int vtkDataReader::Read(unsigned __int64 *result)
+static int vtkDataReaderParseValue(const char *token, double &value)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return (vtkDataReaderParseReal(token, value) ||
+          vtkDataReaderParseWithStream(token, value));
 }
-#endif
 
-#if defined(VTK_TYPE_USE_LONG_LONG)
-int vtkDataReader::Read(long long *result)
+static int vtkDataReaderParseValue(const char *token, float &value)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  // Rounding the double to a float gives the nearest float unless the
+  // double lies halfway between two floats.
+  double v;
+  if (vtkDataReaderParseReal(token, v))
     {
-    return 0;
+    vtkTypeUInt64 bits;
+    memcpy(&bits, &v, sizeof(bits));
+    if ((bits & 0x1fffffff) != 0x10000000 && fabs(v) <= VTK_FLOAT_MAX)
+      {
+      value = static_cast<float>(v);
+      return 1;
+      }
     }
-  return 1;
+  return vtkDataReaderParseWithStream(token, value);
 }
 
-int vtkDataReader::Read(unsigned long long *result)
+// Characters are read as integers.
+static int vtkDataReaderParseValue(const char *token, char &value)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  int intData;
+  if (!vtkDataReaderParseValue(token, intData))
     {
     return 0;
     }
+  value = static_cast<char>(intData);
   return 1;
 }
-#endif
 
-int vtkDataReader::Read(float *result)
+static int vtkDataReaderParseValue(const char *token, unsigned char &value)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  int intData;
+  if (!vtkDataReaderParseValue(token, intData))
     {
     return 0;
     }
+  value = static_cast<unsigned char>(intData);
   return 1;
 }
 
-int vtkDataReader::Read(double *result)
+template <class T>
+int vtkDataReaderReadValues(istream *is, T *data, vtkIdType numValues)
 {
-  *this->IS >> *result;
-  if (this->IS->fail()) 
+  if (is->fail())
     {
     return 0;
     }
+  char token[256];
+  for (vtkIdType i = 0; i < numValues; ++i)
+    {
+    if (!vtkDataReaderReadToken(is, token, sizeof(token)) ||
+        !vtkDataReaderParseValue(token, data[i]))
+      {
+      is->setstate(ios::failbit);
+      return 0;
+      }
+    }
   return 1;
 }
 
+// Internal functions to read in one value, or many values at once.
+// Return zero if there was an error.
+#define VTK_DATA_READER_READ(type)                                      \
+  int vtkDataReader::Read(type *result)                                 \
+  {                                                                     \
+    return vtkDataReaderReadValues(this->IS, result, 1);                \
+  }                                                                     \
+  int vtkDataReader::Read(type *data, vtkIdType numValues)              \
+  {                                                                     \
+    return vtkDataReaderReadValues(this->IS, data, numValues);          \
+  }
+
+VTK_DATA_READER_READ(char)
+VTK_DATA_READER_READ(unsigned char)
+VTK_DATA_READER_READ(short)
+VTK_DATA_READER_READ(unsigned short)
+VTK_DATA_READER_READ(int)
+VTK_DATA_READER_READ(unsigned int)
+VTK_DATA_READER_READ(long)
+VTK_DATA_READER_READ(unsigned long)
+#if defined(VTK_TYPE_USE___INT64)
+VTK_DATA_READER_READ(__int64)
+VTK_DATA_READER_READ(unsigned __int64)
+#endif
+#if defined(VTK_TYPE_USE_LONG_LONG)
+VTK_DATA_READER_READ(long long)
+VTK_DATA_READER_READ(unsigned long long)
+#endif
+VTK_DATA_READER_READ(float)
+VTK_DATA_READER_READ(double)
+
+#undef VTK_DATA_READER_READ
 
 // Open a vtk data file. Returns zero if error.
 int vtkDataReader::OpenVTKFile()
@@ -1370,19 +1482,11 @@ int vtkReadBinaryData(istream *IS, T *data, int numTuples, int numComp)
 template <class T>
 int vtkReadASCIIData(vtkDataReader *self, T *data, int numTuples, int numComp)
 {
-  int i, j;
-
-  for (i=0; i<numTuples; i++)
+  if ( !self->Read(data, static_cast<vtkIdType>(numTuples)*numComp) )
     {
-    for (j=0; j<numComp; j++)
-      {
-      if ( !self->Read(data++) )
-        {
-        vtkGenericWarningMacro(<<"Error reading ascii data. Possible mismatch of "
-          "datasize with declaration.");
-        return 0;
-        }
-      }
+    vtkGenericWarningMacro(<<"Error reading ascii data. Possible mismatch of "
+      "datasize with declaration.");
+    return 0;
     }
   return 1;
 }
@@ -2581,7 +2685,6 @@ int vtkDataReader::ReadLutData(vtkDataSetAttributes *a)
 int vtkDataReader::ReadCells(int size, int *data)
 {
   char line[256];
-  int i;
 
   if ( this->FileType == VTK_BINARY)
     {
@@ -2598,14 +2701,11 @@ int vtkDataReader::ReadCells(int size, int *data)
     }
   else // ascii
     {
-    for (i=0; i<size; i++)
+    if (!this->Read(data, size))
       {
-      if (!this->Read(data+i))
-        {
-        vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: " 
-                      << (this->FileName?this->FileName:"(Null FileName)"));
-        return 0;
-        }
+      vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: " 
+                    << (this->FileName?this->FileName:"(Null FileName)"));
+      return 0;
       }
     }
 
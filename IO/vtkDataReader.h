@@ -303,6 +303,29 @@ public:
 #endif
   int Read(float *);
   int Read(double *);  
+
+  // Description:
+  // Internal function to read in numValues values at once, much faster
+  // than reading them one at a time with operator>>.  Returns zero if
+  // there was an error.
+  int Read(char *data, vtkIdType numValues);
+  int Read(unsigned char *data, vtkIdType numValues);
+  int Read(short *data, vtkIdType numValues);
+  int Read(unsigned short *data, vtkIdType numValues);
+  int Read(int *data, vtkIdType numValues);
+  int Read(unsigned int *data, vtkIdType numValues);
+  int Read(long *data, vtkIdType numValues);
+  int Read(unsigned long *data, vtkIdType numValues);
+#if defined(VTK_TYPE_USE___INT64)
+  int Read(__int64 *data, vtkIdType numValues);
+  int Read(unsigned __int64 *data, vtkIdType numValues);
+#endif
+#if defined(VTK_TYPE_USE_LONG_LONG)
+  int Read(long long *data, vtkIdType numValues);
+  int Read(unsigned long long *data, vtkIdType numValues);
+#endif
+  int Read(float *data, vtkIdType numValues);
+  int Read(double *data, vtkIdType numValues);
 //ETX
 
   // Description:
@@ -1874,14 +1874,20 @@ int vtkDataWriter::WriteCells(ostream *fp, vtkCellArray *cells, const char *labe
     {
     // swap the bytes if necc
     // currently writing vtkIdType as int
-    vtkIdType *tempArray = cells->GetPointer();
+    // The interleaved list is assembled by traversing the cells, which
+    // keeps the offsets storage.
     int arraySize = cells->GetNumberOfConnectivityEntries();
     int *intArray = new int[arraySize];
-    int i;
+    int i = 0;
+    vtkIdType npts, j, *pts;
     
-    for (i = 0; i < arraySize; i++)
+    for (cells->InitTraversal(); cells->GetNextCell(npts,pts); )
       {
-      intArray[i] = tempArray[i];
+      intArray[i++] = static_cast<int>(npts);
+      for (j=0; j<npts; j++)
+        {
+        intArray[i++] = static_cast<int>(pts[j]);
+        }
       }
     
     vtkByteSwap::SwapWrite4BERange(intArray,size,fp);
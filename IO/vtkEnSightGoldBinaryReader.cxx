@@ -21,6 +21,8 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -30,13 +32,376 @@
 
 #include <sys/stat.h>
 #include <ctype.h>
+#include <stdio.h>
+#include <vtkstd/algorithm>
+#include <vtkstd/map>
 #include <vtkstd/string>
+#include <vtkstd/vector>
 
 vtkStandardNewMacro(vtkEnSightGoldBinaryReader);
 
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
+//----------------------------------------------------------------------------
+// A part of a geometry file: its id, its description, the line that
+// follows the description and where the part continues after that line.
+struct vtkEnSightGoldBinaryReaderPart
+{
+  int PartId;
+  vtkstd::string Name;
+  char Line[80];
+  vtkTypeInt64 Offset;
+  vtkTypeInt64 Length;
+};
+
+// One time step of a file: where it begins, after its "BEGIN TIME STEP"
+// line, and for a geometry file its parts.
+struct vtkEnSightGoldBinaryReaderStepIndex
+{
+  vtkEnSightGoldBinaryReaderStepIndex()
+    : Offset(0), NodeIdsListed(0), ElementIdsListed(0) {}
+
+  vtkTypeInt64 Offset;
+  int NodeIdsListed;
+  int ElementIdsListed;
+  vtkstd::vector<vtkEnSightGoldBinaryReaderPart> Parts;
+};
+
+// The time steps of a file that have been indexed, valid as long as the
+// file keeps its size and modification time.
+struct vtkEnSightGoldBinaryReaderFileIndex
+{
+  vtkEnSightGoldBinaryReaderFileIndex()
+    : ModifiedTime(0), Size(-1),
+      ByteOrder(vtkEnSightGoldBinaryReader::FILE_UNKNOWN_ENDIAN),
+      IndexFileRead(0), IndexFileCurrent(0) {}
+
+  long ModifiedTime;
+  vtkTypeInt64 Size;
+  int ByteOrder;
+  int IndexFileRead;
+  // Whether the index file holds this index, so that new time step offsets
+  // can be appended to it.
+  int IndexFileCurrent;
+  vtkstd::map<int, vtkEnSightGoldBinaryReaderStepIndex> Steps;
+};
+
+// The index of every file read so far.  It can be kept in an index file
+// next to each file, so that other readers and later sessions start with
+// the time steps and parts already found.
+class vtkEnSightGoldBinaryReaderPartIndex
+{
+public:
+  vtkEnSightGoldBinaryReaderFileIndex* GetFile(const vtkstd::string& fileName,
+                                               int byteOrder,
+                                               int useIndexFile);
+  int ReadIndexFile(const vtkstd::string& fileName,
+                    vtkEnSightGoldBinaryReaderFileIndex& file);
+  int WriteIndexFile(const vtkstd::string& fileName,
+                     vtkEnSightGoldBinaryReaderFileIndex& file);
+  int AppendTimeStep(const vtkstd::string& fileName,
+                     vtkEnSightGoldBinaryReaderFileIndex& file,
+                     int timeStep);
+
+  vtkstd::map<vtkstd::string, vtkEnSightGoldBinaryReaderFileIndex> Files;
+};
+
+//----------------------------------------------------------------------------
+static vtkstd::string vtkEnSightGoldBinaryReaderIndexFileName(
+  const vtkstd::string& fileName)
+{
+  return fileName + ".vtkidx";
+}
+
+//----------------------------------------------------------------------------
+// Returns the index of a file, emptied if the file or the byte order
+// changed since it was made, or NULL if the file cannot be found.
+vtkEnSightGoldBinaryReaderFileIndex*
+vtkEnSightGoldBinaryReaderPartIndex::GetFile(const vtkstd::string& fileName,
+                                             int byteOrder, int useIndexFile)
+{
+  struct stat fs;
+  if (stat(fileName.c_str(), &fs) != 0)
+    {
+    return NULL;
+    }
+  vtkEnSightGoldBinaryReaderFileIndex& file = this->Files[fileName];
+  if (file.ModifiedTime != static_cast<long>(fs.st_mtime) ||
+    file.Size != static_cast<vtkTypeInt64>(fs.st_size) ||
+    (byteOrder != vtkEnSightGoldBinaryReader::FILE_UNKNOWN_ENDIAN &&
+     file.ByteOrder != vtkEnSightGoldBinaryReader::FILE_UNKNOWN_ENDIAN &&
+     byteOrder != file.ByteOrder))
+    {
+    file = vtkEnSightGoldBinaryReaderFileIndex();
+    file.ModifiedTime = static_cast<long>(fs.st_mtime);
+    file.Size = static_cast<vtkTypeInt64>(fs.st_size);
+    file.ByteOrder = byteOrder;
+    }
+  if (useIndexFile && !file.IndexFileRead)
+    {
+    file.IndexFileRead = 1;
+    this->ReadIndexFile(fileName, file);
+    }
+  return &file;
+}
+
+//----------------------------------------------------------------------------
+// The index file is text: a header, the size, modification time and byte
+// order of the file it indexes, then a line for each time step followed
+// by three lines for each of its parts, then any number of lines giving
+// the offset of a time step, appended as they are found.  An index file
+// that does not match the file is ignored.
+int vtkEnSightGoldBinaryReaderPartIndex::ReadIndexFile(
+  const vtkstd::string& fileName, vtkEnSightGoldBinaryReaderFileIndex& file)
+{
+  ifstream is(vtkEnSightGoldBinaryReaderIndexFileName(fileName).c_str());
+  if (!is)
+    {
+    return 0;
+    }
+  vtkstd::string magic, keyword;
+  int version = 0, byteOrder, numSteps, numParts, timeStep, i, j;
+  long modifiedTime;
+  vtkTypeInt64 size;
+  is >> magic >> version >> size >> modifiedTime >> byteOrder >> numSteps;
+  if (!is || magic != "vtkEnSightGoldBinaryReaderIndex" || version != 1 ||
+    size != file.Size || modifiedTime != file.ModifiedTime ||
+    (file.ByteOrder != vtkEnSightGoldBinaryReader::FILE_UNKNOWN_ENDIAN &&
+     byteOrder != file.ByteOrder))
+    {
+    return 0;
+    }
+
+  vtkstd::map<int, vtkEnSightGoldBinaryReaderStepIndex> steps;
+  for (i = 0; i < numSteps && is; i++)
+    {
+    vtkEnSightGoldBinaryReaderStepIndex step;
+    is >> keyword >> timeStep >> step.Offset >> step.NodeIdsListed
+       >> step.ElementIdsListed >> numParts;
+    if (!is || keyword != "step" || numParts < 0)
+      {
+      return 0;
+      }
+    step.Parts.resize(numParts);
+    for (j = 0; j < numParts && is; j++)
+      {
+      vtkEnSightGoldBinaryReaderPart& part = step.Parts[j];
+      vtkstd::string line;
+      is >> keyword >> part.PartId >> part.Offset >> part.Length;
+      is.ignore(VTK_INT_MAX, '\n');
+      vtkstd::getline(is, part.Name);
+      vtkstd::getline(is, line);
+      if (keyword != "part" || line.size() >= 80)
+        {
+        return 0;
+        }
+      memset(part.Line, 0, 80);
+      memcpy(part.Line, line.c_str(), line.size());
+      }
+    steps[timeStep] = step;
+    }
+  if (!is)
+    {
+    return 0;
+    }
+  vtkTypeInt64 offset;
+  while (is >> keyword >> timeStep >> offset && keyword == "offset")
+    {
+    steps[timeStep].Offset = offset;
+    }
+  file.ByteOrder = byteOrder;
+  file.Steps.swap(steps);
+  file.IndexFileCurrent = 1;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// The index file is written to a temporary file first so that a reader
+// never sees half of it.
+int vtkEnSightGoldBinaryReaderPartIndex::WriteIndexFile(
+  const vtkstd::string& fileName,
+  vtkEnSightGoldBinaryReaderFileIndex& file)
+{
+  file.IndexFileCurrent = 0;
+  vtkstd::string indexFileName =
+    vtkEnSightGoldBinaryReaderIndexFileName(fileName);
+  vtkstd::string tmpFileName = indexFileName + ".tmp";
+  ofstream os(tmpFileName.c_str());
+  if (!os)
+    {
+    return 0;
+    }
+  os << "vtkEnSightGoldBinaryReaderIndex 1\n"
+     << file.Size << " " << file.ModifiedTime << " " << file.ByteOrder
+     << " " << file.Steps.size() << "\n";
+  vtkstd::map<int, vtkEnSightGoldBinaryReaderStepIndex>::const_iterator it;
+  for (it = file.Steps.begin(); it != file.Steps.end(); ++it)
+    {
+    const vtkEnSightGoldBinaryReaderStepIndex& step = it->second;
+    os << "step " << it->first << " " << step.Offset << " "
+       << step.NodeIdsListed << " " << step.ElementIdsListed << " "
+       << step.Parts.size() << "\n";
+    for (size_t j = 0; j < step.Parts.size(); j++)
+      {
+      const vtkEnSightGoldBinaryReaderPart& part = step.Parts[j];
+      // Names and lines are read back one per line.
+      vtkstd::string name = part.Name;
+      vtkstd::string line(part.Line, 79);
+      line.resize(strlen(line.c_str()));
+      vtkstd::replace(name.begin(), name.end(), '\n', ' ');
+      vtkstd::replace(line.begin(), line.end(), '\n', ' ');
+      os << "part " << part.PartId << " " << part.Offset << " "
+         << part.Length << "\n" << name << "\n" << line << "\n";
+      }
+    }
+  os.close();
+  if (!os)
+    {
+    remove(tmpFileName.c_str());
+    return 0;
+    }
+#ifdef _WIN32
+  remove(indexFileName.c_str());
+#endif
+  if (rename(tmpFileName.c_str(), indexFileName.c_str()) != 0)
+    {
+    remove(tmpFileName.c_str());
+    return 0;
+    }
+  file.IndexFileCurrent = 1;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Appends the offset of a time step to the index file if it holds the rest
+// of the index, so that recording the time steps of a file set one by one
+// does not rewrite the whole index each time, or writes the index file.
+int vtkEnSightGoldBinaryReaderPartIndex::AppendTimeStep(
+  const vtkstd::string& fileName, vtkEnSightGoldBinaryReaderFileIndex& file,
+  int timeStep)
+{
+  if (!file.IndexFileCurrent)
+    {
+    return this->WriteIndexFile(fileName, file);
+    }
+  ofstream os(vtkEnSightGoldBinaryReaderIndexFileName(fileName).c_str(),
+              ios::out | ios::app);
+  if (!os)
+    {
+    return this->WriteIndexFile(fileName, file);
+    }
+  os << "offset " << timeStep << " " << file.Steps[timeStep].Offset << "\n";
+  os.close();
+  if (!os)
+    {
+    return this->WriteIndexFile(fileName, file);
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Hands out the parts of a time step to the threads, largest first.  Each
+// thread reads its parts with a reader and an output of its own, so the
+// threads share no stream, no cell id lists and no output.
+class vtkEnSightGoldBinaryReaderPartQueue
+{
+public:
+  vtkEnSightGoldBinaryReaderPartQueue()
+    {
+    this->Step = 0;
+    this->NextPart = 0;
+    this->Failed = 0;
+    }
+
+  void ReadParts(int thread);
+
+  vtkSimpleMutexLock Lock;
+  const vtkEnSightGoldBinaryReaderStepIndex* Step;
+  vtkstd::vector<int> RealIds;
+  vtkstd::vector<int> Order;
+  vtkstd::vector<int> ReaderOfPart;
+  vtkstd::vector<vtkEnSightGoldBinaryReader*> Readers;
+  vtkstd::vector<vtkMultiBlockDataSet*> Outputs;
+  size_t NextPart;
+  int Failed;
+};
+
+//----------------------------------------------------------------------------
+void vtkEnSightGoldBinaryReaderPartQueue::ReadParts(int thread)
+{
+  vtkEnSightGoldBinaryReader* reader = this->Readers[thread];
+  char line[80];
+  while (!this->Failed)
+    {
+    this->Lock.Lock();
+    size_t next = this->NextPart++;
+    this->Lock.Unlock();
+    if (next >= this->Order.size())
+      {
+      break;
+      }
+    int i = this->Order[next];
+    const vtkEnSightGoldBinaryReaderPart& part = this->Step->Parts[i];
+    this->ReaderOfPart[i] = thread;
+    reader->IFile->clear();
+    reader->IFile->seekg(static_cast<ifstream::off_type>(part.Offset),
+                         ios::beg);
+    memcpy(line, part.Line, 80);
+    if (reader->ReadPart(this->RealIds[i], line, part.Name.c_str(),
+                         this->Outputs[thread]) < 0)
+      {
+      this->Failed = 1;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkEnSightGoldBinaryReaderReadParts(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  static_cast<vtkEnSightGoldBinaryReaderPartQueue*>(info->UserData)->
+    ReadParts(info->ThreadID);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+// Orders parts by decreasing length so that the largest start first.
+class vtkEnSightGoldBinaryReaderLongerPart
+{
+public:
+  vtkEnSightGoldBinaryReaderLongerPart(
+    const vtkstd::vector<vtkEnSightGoldBinaryReaderPart>& parts)
+    : Parts(parts) {}
+  bool operator()(int a, int b) const
+    {
+    return this->Parts[a].Length > this->Parts[b].Length;
+    }
+  const vtkstd::vector<vtkEnSightGoldBinaryReaderPart>& Parts;
+};
+
+//----------------------------------------------------------------------------
+static vtkstd::string vtkEnSightGoldBinaryReaderFullPath(const char* filePath,
+                                                        const char* fileName)
+{
+  vtkstd::string sfilename;
+  if (filePath)
+    {
+    sfilename = filePath;
+    if (sfilename.at(sfilename.length()-1) != '/')
+      {
+      sfilename += "/";
+      }
+    sfilename += fileName;
+    }
+  else
+    {
+    sfilename = fileName;
+    }
+  return sfilename;
+}
+
 //----------------------------------------------------------------------------
 vtkEnSightGoldBinaryReader::vtkEnSightGoldBinaryReader()
 {
@@ -46,6 +411,7 @@ vtkEnSightGoldBinaryReader::vtkEnSightGoldBinaryReader()
   this->Fortran = 0;
   this->NodeIdsListed = 0;
   this->ElementIdsListed = 0;
+  this->PartIndex = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -57,6 +423,7 @@ vtkEnSightGoldBinaryReader::~vtkEnSightGoldBinaryReader()
     delete this->IFile;
     this->IFile = NULL;
     }
+  delete this->PartIndex;
 }
 
 //----------------------------------------------------------------------------
@@ -180,21 +547,9 @@ int vtkEnSightGoldBinaryReader::InitializeFile(const char* fileName)
     vtkErrorMacro("A GeometryFileName must be specified in the case file.");
     return 0;
     }
-  vtkstd::string sfilename;
-  if (this->FilePath)
-    {
-    sfilename = this->FilePath;
-    if (sfilename.at(sfilename.length()-1) != '/')
-      {
-      sfilename += "/";
-      }
-    sfilename += fileName;
-    vtkDebugMacro("full path to geometry file: " << sfilename.c_str());
-    }
-  else
-    {
-    sfilename = fileName;
-    }
+  vtkstd::string sfilename =
+    vtkEnSightGoldBinaryReaderFullPath(this->FilePath, fileName);
+  vtkDebugMacro("full path to geometry file: " << sfilename.c_str());
 
   if (this->OpenFile(sfilename.c_str()) == 0)
     {
@@ -230,10 +585,19 @@ int vtkEnSightGoldBinaryReader::InitializeFile(const char* fileName)
 int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeStep,
   vtkMultiBlockDataSet *output)
 {
-  char line[80], subLine[80], nameline[80];
+  char line[80], nameline[80];
   int partId, realId;
   int lineRead, i;
 
+  if (this->NumberOfThreads > 1 || this->UseIndexFiles)
+    {
+    int result = this->ReadGeometryFileParts(fileName, timeStep, output);
+    if (result >= 0)
+      {
+      return result;
+      }
+    }
+
   if (!this->InitializeFile(fileName))
     {
     return 0;
@@ -270,6 +634,66 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
     while ( strncmp(line, "BEGIN TIME STEP", 15) != 0 );
     }
 
+  lineRead = this->ReadGeometryHeader(line); // "part"
+
+  while (lineRead > 0 && strncmp(line, "part", 4) == 0)
+    {
+    this->ReadPartId(&partId);
+    partId--; // EnSight starts #ing at 1.
+    if (partId < 0 || partId >= MAXIMUM_PART_ID)
+      {
+      vtkErrorMacro("Invalid part id; check that ByteOrder is set correctly.");
+      return 0;
+      }
+    realId = this->InsertNewPartId(partId);
+
+    // Increment the number of geoemtry parts such that the measured geomtry,
+    // if any, can be properly combined into a vtkMultiBlockDataSet object.
+    // --- fix to bug #7453
+    this->NumberOfGeometryParts ++;
+
+    this->ReadLine(line); // part description line
+
+    strncpy(nameline, line, 80); // 80 characters in line are allowed
+    nameline[79] = '\0'; // Ensure NULL character at end of part name
+    char *name = strdup(nameline);
+
+    // fix to bug #0008237
+    // The original "return 1" operation upon "strncmp(line, "interface", 9) == 0"
+    // was removed here as 'interface' is NOT a keyword of an EnSight Gold file.
+
+    this->ReadLine(line);
+
+    lineRead = this->ReadPart(realId, line, name, output);
+    free(name);
+    if (lineRead < 0)
+      {
+      if (this->IFile)
+        {
+        this->IFile->close();
+        delete this->IFile;
+        this->IFile = NULL;
+        }
+      return 0;
+      }
+    }
+
+  if (this->IFile)
+    {
+    this->IFile->close();
+    delete this->IFile;
+    this->IFile = NULL;
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::ReadGeometryHeader(char line[80])
+{
+  char subLine[80];
+  int lineRead;
+
   // Skip the 2 description lines.
   this->ReadLine(line);
   this->ReadLine(line);
@@ -312,82 +736,150 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
     this->IFile->seekg(6*sizeof(float), ios::cur);
     lineRead = this->ReadLine(line); // "part"
     }
+  return lineRead;
+}
 
-  while (lineRead > 0 && strncmp(line, "part", 4) == 0)
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::ReadPart(int partId, char line[80],
+  const char* name, vtkMultiBlockDataSet *output)
+{
+  char subLine[80];
+
+  if (strncmp(line, "block", 5) == 0)
     {
-    this->ReadPartId(&partId);
-    partId--; // EnSight starts #ing at 1.
-    if (partId < 0 || partId >= MAXIMUM_PART_ID)
+    if (sscanf(line, " %*s %s", subLine) == 1)
       {
-      vtkErrorMacro("Invalid part id; check that ByteOrder is set correctly.");
-      return 0;
+      if (strncmp(subLine, "rectilinear", 11) == 0)
+        {
+        // block rectilinear
+        return this->CreateRectilinearGridOutput(partId, line, name, output);
+        }
+      else if (strncmp(subLine, "uniform", 7) == 0)
+        {
+        // block uniform
+        return this->CreateImageDataOutput(partId, line, name, output);
+        }
       }
-    realId = this->InsertNewPartId(partId);
-
-    // Increment the number of geoemtry parts such that the measured geomtry,
-    // if any, can be properly combined into a vtkMultiBlockDataSet object.
-    // --- fix to bug #7453
-    this->NumberOfGeometryParts ++;
-
-    this->ReadLine(line); // part description line
-
-    strncpy(nameline, line, 80); // 80 characters in line are allowed
-    nameline[79] = '\0'; // Ensure NULL character at end of part name
-    char *name = strdup(nameline);
-
-    // fix to bug #0008237
-    // The original "return 1" operation upon "strncmp(line, "interface", 9) == 0"
-    // was removed here as 'interface' is NOT a keyword of an EnSight Gold file.
+    // block or block iblanked
+    return this->CreateStructuredGridOutput(partId, line, name, output);
+    }
+  return this->CreateUnstructuredGridOutput(partId, line, name, output);
+}
 
-    this->ReadLine(line);
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::SkipPart(char line[80])
+{
+  char subLine[80];
 
-    if (strncmp(line, "block", 5) == 0)
+  if (strncmp(line, "block", 5) == 0)
+    {
+    if (sscanf(line, " %*s %s", subLine) == 1)
       {
-      if (sscanf(line, " %*s %s", subLine) == 1)
+      if (strncmp(subLine, "rectilinear", 11) == 0)
         {
-        if (strncmp(subLine, "rectilinear", 11) == 0)
-          {
-          // block rectilinear
-          lineRead = this->CreateRectilinearGridOutput(realId, line, name,
-            output);
-          }
-        else if (strncmp(subLine, "uniform", 7) == 0)
-          {
-          // block uniform
-          lineRead = this->CreateImageDataOutput(realId, line, name,
-            output);
-          }
-        else
-          {
-          // block iblanked
-          lineRead = this->CreateStructuredGridOutput(realId, line, name,
-            output);
-          }
+        // block rectilinear
+        return this->SkipRectilinearGrid(line);
         }
-      else
+      else if (strncmp(subLine, "uniform", 7) == 0)
         {
-        // block
-        lineRead = this->CreateStructuredGridOutput(realId, line, name,
-          output);
+        // block uniform
+        return this->SkipImageData(line);
         }
       }
-    else
+    // block or block iblanked
+    return this->SkipStructuredGrid(line);
+    }
+  return this->SkipUnstructuredGrid(line);
+}
+
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::IndexGeometryFile(const char* fileName,
+  int timeStep)
+{
+  char line[80];
+  int lineRead, i;
+
+  vtkstd::string sfilename =
+    vtkEnSightGoldBinaryReaderFullPath(this->FilePath, fileName);
+
+  // Use the parts found before if the file has not changed.
+  if (!this->PartIndex)
+    {
+    this->PartIndex = new vtkEnSightGoldBinaryReaderPartIndex;
+    }
+  vtkEnSightGoldBinaryReaderFileIndex* file = this->PartIndex->GetFile(
+    sfilename, this->ByteOrder, this->UseIndexFiles);
+  if (!file)
+    {
+    vtkErrorMacro("Unable to open file: " << sfilename.c_str());
+    return 0;
+    }
+  vtkstd::map<int, vtkEnSightGoldBinaryReaderStepIndex>::const_iterator it =
+    file->Steps.find(timeStep);
+  if (it != file->Steps.end() && !it->second.Parts.empty())
+    {
+    this->ByteOrder = file->ByteOrder;
+    return 1;
+    }
+
+  if (!this->InitializeFile(fileName))
+    {
+    return 0;
+    }
+  if (this->Fortran)
+    {
+    // The records around each array would have to be skipped as well.
+    this->IFile->close();
+    delete this->IFile;
+    this->IFile = NULL;
+    return -1;
+    }
+
+  lineRead = 1;
+  if (this->UseFileSets)
+    {
+    for (i = 0; i < timeStep - 1 && lineRead; i++)
       {
-      lineRead = this->CreateUnstructuredGridOutput(realId, line, name,
-        output);
-      if (lineRead < 0)
-        {
-        free(name);
-        if (this->IFile)
-          {
-          this->IFile->close();
-          delete this->IFile;
-          this->IFile = NULL;
-          }
-        return 0;
-        }
+      lineRead = this->SkipTimeStep();
       }
-    free(name);
+    line[0] = '\0';
+    while (lineRead && strncmp(line, "BEGIN TIME STEP", 15) != 0)
+      {
+      lineRead = this->ReadLine(line);
+      }
+    }
+  vtkEnSightGoldBinaryReaderStepIndex step;
+  step.Offset = static_cast<vtkTypeInt64>(this->IFile->tellg());
+  if (lineRead)
+    {
+    lineRead = this->ReadGeometryHeader(line); // "part"
+    }
+
+  step.NodeIdsListed = this->NodeIdsListed;
+  step.ElementIdsListed = this->ElementIdsListed;
+  while (lineRead > 0 && strncmp(line, "part", 4) == 0)
+    {
+    vtkEnSightGoldBinaryReaderPart part;
+    this->ReadPartId(&part.PartId);
+    part.PartId--; // EnSight starts #ing at 1.
+    if (part.PartId < 0 || part.PartId >= MAXIMUM_PART_ID)
+      {
+      vtkErrorMacro("Invalid part id; check that ByteOrder is set correctly.");
+      lineRead = -1;
+      break;
+      }
+    this->ReadLine(line); // part description line
+    line[79] = '\0';
+    part.Name = line;
+    this->ReadLine(line);
+    memcpy(part.Line, line, 80);
+    part.Offset = static_cast<vtkTypeInt64>(this->IFile->tellg());
+
+    lineRead = this->SkipPart(line);
+    part.Length = (lineRead > 0 ?
+                   static_cast<vtkTypeInt64>(this->IFile->tellg()) :
+                   file->Size) - part.Offset;
+    step.Parts.push_back(part);
     }
 
   if (this->IFile)
@@ -396,14 +888,189 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
     delete this->IFile;
     this->IFile = NULL;
     }
-  if (lineRead < 0)
+  if (lineRead < 0 || (lineRead == 0 && step.Parts.empty()))
     {
+    vtkErrorMacro("Could not index the parts of " << sfilename.c_str());
     return 0;
     }
+  file->ByteOrder = this->ByteOrder;
+  file->Steps[timeStep] = step;
+  if (this->UseIndexFiles &&
+    !this->PartIndex->WriteIndexFile(sfilename, *file))
+    {
+    vtkDebugMacro("Could not write the index file of " << sfilename.c_str());
+    }
+  return 1;
+}
 
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::SeekTimeStep(const char* fileName,
+                                             int timeStep)
+{
+  if (!this->UseIndexFiles || !this->IFile)
+    {
+    return 0;
+    }
+  if (!this->PartIndex)
+    {
+    this->PartIndex = new vtkEnSightGoldBinaryReaderPartIndex;
+    }
+  vtkEnSightGoldBinaryReaderFileIndex* file =
+    this->PartIndex->GetFile(fileName, this->ByteOrder, 1);
+  if (!file)
+    {
+    return 0;
+    }
+  vtkstd::map<int, vtkEnSightGoldBinaryReaderStepIndex>::const_iterator it =
+    file->Steps.find(timeStep);
+  if (it == file->Steps.end() || it->second.Offset <= 0 ||
+    it->second.Offset > file->Size)
+    {
+    return 0;
+    }
+  this->IFile->clear();
+  this->IFile->seekg(static_cast<ifstream::off_type>(it->second.Offset),
+                     ios::beg);
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkEnSightGoldBinaryReader::RecordTimeStep(const char* fileName,
+                                                int timeStep)
+{
+  if (!this->UseIndexFiles || !this->IFile || !this->IFile->good())
+    {
+    return;
+    }
+  if (!this->PartIndex)
+    {
+    this->PartIndex = new vtkEnSightGoldBinaryReaderPartIndex;
+    }
+  vtkEnSightGoldBinaryReaderFileIndex* file =
+    this->PartIndex->GetFile(fileName, this->ByteOrder, 1);
+  if (!file)
+    {
+    return;
+    }
+  if (file->ByteOrder != this->ByteOrder)
+    {
+    // The header of the index file has to change.
+    file->ByteOrder = this->ByteOrder;
+    file->IndexFileCurrent = 0;
+    }
+  file->Steps[timeStep].Offset =
+    static_cast<vtkTypeInt64>(this->IFile->tellg());
+  if (!this->PartIndex->AppendTimeStep(fileName, *file, timeStep))
+    {
+    vtkDebugMacro("Could not write the index file of " << fileName);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::ReadGeometryFileParts(const char* fileName,
+  int timeStep, vtkMultiBlockDataSet *output)
+{
+  int i, j;
+
+  if (!fileName)
+    {
+    vtkErrorMacro("A GeometryFileName must be specified in the case file.");
+    return 0;
+    }
+  if (!this->UseFileSets)
+    {
+    timeStep = 1;
+    }
+  int result = this->IndexGeometryFile(fileName, timeStep);
+  if (result <= 0)
+    {
+    return result;
+    }
+  vtkstd::string sfilename =
+    vtkEnSightGoldBinaryReaderFullPath(this->FilePath, fileName);
+  const vtkEnSightGoldBinaryReaderStepIndex& step =
+    this->PartIndex->Files[sfilename].Steps[timeStep];
+  this->NodeIdsListed = step.NodeIdsListed;
+  this->ElementIdsListed = step.ElementIdsListed;
+
+  int numParts = static_cast<int>(step.Parts.size());
+  vtkEnSightGoldBinaryReaderPartQueue queue;
+  queue.Step = &step;
+  queue.RealIds.resize(numParts);
+  queue.Order.resize(numParts);
+  queue.ReaderOfPart.resize(numParts);
+  for (i = 0; i < numParts; i++)
+    {
+    queue.RealIds[i] = this->InsertNewPartId(step.Parts[i].PartId);
+    queue.Order[i] = i;
+    this->NumberOfGeometryParts ++;
+    }
+  vtkstd::stable_sort(queue.Order.begin(), queue.Order.end(),
+    vtkEnSightGoldBinaryReaderLongerPart(step.Parts));
+
+  // Every thread opens the file again.
+  int numThreads = vtkstd::min(this->NumberOfThreads, numParts);
+  for (i = 0; i < numThreads; i++)
+    {
+    vtkEnSightGoldBinaryReader* reader = vtkEnSightGoldBinaryReader::New();
+    reader->SetDebug(this->GetDebug());
+    reader->ByteOrder = this->ByteOrder;
+    reader->NodeIdsListed = step.NodeIdsListed;
+    reader->ElementIdsListed = step.ElementIdsListed;
+    queue.Readers.push_back(reader);
+    queue.Outputs.push_back(vtkMultiBlockDataSet::New());
+    if (!reader->OpenFile(sfilename.c_str()))
+      {
+      queue.Failed = 1;
+      }
+    }
+
+  if (!queue.Failed)
+    {
+    vtkMultiThreader* threader = vtkMultiThreader::New();
+    threader->SetNumberOfThreads(numThreads);
+    threader->SetSingleMethod(vtkEnSightGoldBinaryReaderReadParts, &queue);
+    threader->SingleMethodExecute();
+    threader->Delete();
+    }
+
+  // Move the parts to the output in file order, with their cell ids.
+  for (i = 0; i < numParts && !queue.Failed; i++)
+    {
+    vtkEnSightGoldBinaryReader* reader = queue.Readers[queue.ReaderOfPart[i]];
+    int realId = queue.RealIds[i];
+    vtkDataSet* ds = reader->GetDataSetFromBlock(
+      queue.Outputs[queue.ReaderOfPart[i]], realId);
+    this->NumberOfNewOutputs++;
+    output->SetBlock(realId, ds);
+    this->SetBlockName(output, realId, step.Parts[i].Name.c_str());
+    if (ds && ds->IsA("vtkUnstructuredGrid"))
+      {
+      if (this->UnstructuredPartIds->IsId(realId) < 0)
+        {
+        this->UnstructuredPartIds->InsertNextId(realId);
+        }
+      int idx = this->UnstructuredPartIds->IsId(realId);
+      int readerIdx = reader->UnstructuredPartIds->IsId(realId);
+      for (j = 0; j < vtkEnSightReader::NUMBER_OF_ELEMENT_TYPES; j++)
+        {
+        this->GetCellIds(idx, j)->DeepCopy(reader->GetCellIds(readerIdx, j));
+        }
+      }
+    }
+
+  for (i = 0; i < numThreads; i++)
+    {
+    queue.Readers[i]->Delete();
+    queue.Outputs[i]->Delete();
+    }
+  if (queue.Failed)
+    {
+    vtkErrorMacro("Could not read the parts of " << sfilename.c_str());
+    return 0;
+    }
+  return 1;
+}
 
 //----------------------------------------------------------------------------
 int vtkEnSightGoldBinaryReader::CountTimeSteps()
@@ -579,6 +1246,19 @@ int vtkEnSightGoldBinaryReader::SkipStructuredGrid(char line[256])
 
   // reading next line to check for EOF
   lineRead = this->ReadLine(line);
+
+  if (lineRead && strncmp(line, "node_ids", 8) == 0)
+    {
+    this->IFile->seekg(sizeof(int)*numPts, ios::cur);
+    lineRead = this->ReadLine(line);
+    }
+  if (lineRead && strncmp(line, "element_ids", 11) == 0)
+    {
+    int numElements = (dimensions[0] - 1) * (dimensions[1] - 1) *
+      (dimensions[2] - 1);
+    this->IFile->seekg(sizeof(int)*numElements, ios::cur);
+    lineRead = this->ReadLine(line);
+    }
   return lineRead;
 }
 
@@ -1156,7 +1836,8 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
     return 0;
     }
 
-  if (this->UseFileSets)
+  if (this->UseFileSets &&
+    !this->SeekTimeStep(sfilename.c_str(), timeStep))
     {
     for (i = 0; i < timeStep - 1; i++)
       {
@@ -1188,6 +1869,7 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
       {
       this->ReadLine(line);
       }
+    this->RecordTimeStep(sfilename.c_str(), timeStep);
     }
 
   // Skip the description line.
@@ -1306,7 +1988,8 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
     return 0;
     }
 
-  if (this->UseFileSets)
+  if (this->UseFileSets &&
+    !this->SeekTimeStep(sfilename.c_str(), timeStep))
     {
     for (i = 0; i < timeStep - 1; i++)
       {
@@ -1352,6 +2035,7 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
       {
       this->ReadLine(line);
       }
+    this->RecordTimeStep(sfilename.c_str(), timeStep);
     }
 
   this->ReadLine(line); // skip the description line
@@ -1507,7 +2191,8 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
     return 0;
     }
 
-  if (this->UseFileSets)
+  if (this->UseFileSets &&
+    !this->SeekTimeStep(sfilename.c_str(), timeStep))
     {
     for (i = 0; i < timeStep - 1; i++)
       {
@@ -1553,6 +2238,7 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
       {
       this->ReadLine(line);
       }
+    this->RecordTimeStep(sfilename.c_str(), timeStep);
     }
 
   this->ReadLine(line); // skip the description line
@@ -1688,7 +2374,8 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
     return 0;
     }
 
-  if (this->UseFileSets)
+  if (this->UseFileSets &&
+    !this->SeekTimeStep(sfilename.c_str(), timeStep))
     {
     for (i = 0; i < timeStep - 1; i++)
       {
@@ -1720,6 +2407,7 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
       {
       this->ReadLine(line);
       }
+    this->RecordTimeStep(sfilename.c_str(), timeStep);
     }
 
   this->ReadLine(line); // skip the description line
@@ -1833,7 +2521,8 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
     return 0;
     }
 
-  if (this->UseFileSets)
+  if (this->UseFileSets &&
+    !this->SeekTimeStep(sfilename.c_str(), timeStep))
     {
     for (i = 0; i < timeStep - 1; i++)
       {
@@ -1901,6 +2590,7 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
       {
       this->ReadLine(line);
       }
+    this->RecordTimeStep(sfilename.c_str(), timeStep);
     }
 
   this->ReadLine(line); // skip the description line
@@ -2071,7 +2761,8 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
     return 0;
     }
 
-  if (this->UseFileSets)
+  if (this->UseFileSets &&
+    !this->SeekTimeStep(sfilename.c_str(), timeStep))
     {
     for (i = 0; i < timeStep - 1; i++)
       {
@@ -2136,6 +2827,7 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
       {
       this->ReadLine(line);
       }
+    this->RecordTimeStep(sfilename.c_str(), timeStep);
     }
 
   this->ReadLine(line); // skip the description line
@@ -2303,7 +2995,8 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
     return 0;
     }
 
-  if (this->UseFileSets)
+  if (this->UseFileSets &&
+    !this->SeekTimeStep(sfilename.c_str(), timeStep))
     {
     for (i = 0; i < timeStep - 1; i++)
       {
@@ -2368,6 +3061,7 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
       {
       this->ReadLine(line);
       }
+    this->RecordTimeStep(sfilename.c_str(), timeStep);
     }
 
   this->ReadLine(line); // skip the description line
@@ -24,6 +24,21 @@
 // array of real values) and _i (for the array if imaginary values).  Complex
 // scalar variables are stored as a single array with 2 components, real and
 // imaginary, listed in that order.
+//
+// With NumberOfThreads greater than one, the parts of a geometry file are
+// read concurrently.  The offsets of the parts are found in one pass over
+// the file that only reads the section headers and counts, and are kept
+// until the file changes, so that geometry shared by several time steps
+// is indexed only once.  Fortran binary files are always read in sequence.
+//
+// With UseIndexFiles on, the geometry is read through the same index, and
+// the index is also kept on disk next to each geometry and variable file,
+// in a file named after it with a ".vtkidx" extension.  Each index file
+// records the size and modification time of the file it describes, where
+// its time steps begin and where the parts of each geometry time step
+// are, so that changing time step seeks to the data directly, also in a
+// later session.  An index file that does not match its file is ignored
+// and written again.
 // .SECTION Caveats
 // You must manually call Update on this reader and then connect the rest
 // of the pipeline because (due to the nature of the file format) it is
@@ -40,6 +55,8 @@
 #include "vtkEnSightReader.h"
 
 class vtkMultiBlockDataSet;
+class vtkEnSightGoldBinaryReaderPartIndex;
+class vtkEnSightGoldBinaryReaderPartQueue;
 
 class VTK_IO_EXPORT vtkEnSightGoldBinaryReader : public vtkEnSightReader
 {
@@ -65,6 +82,42 @@ protected:
   virtual int ReadGeometryFile(const char* fileName, int timeStep,
     vtkMultiBlockDataSet *output);
 
+  // Description:
+  // Read the geometry file with NumberOfThreads threads, one part per
+  // thread at a time.  Return 1 if successful, 0 if an error occurred and
+  // -1 if the file can only be read in sequence.
+  int ReadGeometryFileParts(const char* fileName, int timeStep,
+    vtkMultiBlockDataSet *output);
+
+  // Description:
+  // Find the offsets of the parts of a time step of the geometry file, or
+  // use those found before if the file has not changed.  Return 1 if
+  // successful, 0 if an error occurred and -1 if the file can only be
+  // read in sequence.
+  int IndexGeometryFile(const char* fileName, int timeStep);
+
+  // Description:
+  // With UseIndexFiles, seek the open file to the start of a time step of
+  // a file set if its offset is known.  Return 1 if it was, 0 otherwise.
+  int SeekTimeStep(const char* fileName, int timeStep);
+
+  // Description:
+  // With UseIndexFiles, remember that a time step of a file set starts at
+  // the current position of the open file.
+  void RecordTimeStep(const char* fileName, int timeStep);
+
+  // Description:
+  // Read the description, node id, element id and extents lines at the
+  // start of a geometry file or time step.  Returns the result of
+  // reading the line that follows, which is left in line.
+  int ReadGeometryHeader(char line[80]);
+
+  // Description:
+  // Read the part that starts with the given line, after its part id and
+  // description, and create its output.  Returns as the Create methods do.
+  int ReadPart(int partId, char line[80], const char* name,
+    vtkMultiBlockDataSet *output);
+
   // Description:
   // Read the measured geometry file.  If an error occurred, 0 is returned;
   // otherwise 1.
@@ -174,6 +227,7 @@ protected:
   // Description:
   // Read to the next time step in the geometry file.
   int SkipTimeStep();
+  int SkipPart(char line[80]);
   int SkipStructuredGrid(char line[256]);
   int SkipUnstructuredGrid(char line[256]);
   int SkipRectilinearGrid(char line[256]);
@@ -187,6 +241,13 @@ protected:
   // The size of the file could be used to choose byte order.
   vtkIdType FileSize;
 
+  // The part and time step offsets of the files read so far.
+  vtkEnSightGoldBinaryReaderPartIndex* PartIndex;
+
+  //BTX
+  friend class vtkEnSightGoldBinaryReaderPartQueue;
+  //ETX
+
 private:
   int SizeOfInt;
   vtkEnSightGoldBinaryReader(const vtkEnSightGoldBinaryReader&);  // Not implemented.
@@ -19,6 +19,7 @@
 #include "vtkFloatArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
@@ -28,7 +29,7 @@
 #include "vtkUnstructuredGrid.h"
 
 #include <ctype.h>
-#include <vtksys/ios/sstream>
+#include <vtkstd/algorithm>
 #include <vtkstd/string>
 #include <vtkstd/vector>
 #include <vtkstd/map>
@@ -265,15 +266,14 @@ int vtkEnSightGoldReader::ReadGeometryFile(const char* fileName, int timeStep,
     else
       {
       lineRead = this->CreateUnstructuredGridOutput(realId, line, name, output);
-      if (lineRead < 0)
-        {
-        free(name);
-        delete this->IS;
-        this->IS = NULL;
-        return 0;
-        }
       }
     free(name);
+    if (lineRead < 0)
+      {
+      delete this->IS;
+      this->IS = NULL;
+      return 0;
+      }
     }
 
   delete this->IS;
@@ -578,9 +578,8 @@ int vtkEnSightGoldReader::ReadScalarsPerNode(const char* fileName, const char* d
       if (component == 0)
         {
         scalars = vtkFloatArray::New();
-        scalars->SetNumberOfTuples(numPts);
         scalars->SetNumberOfComponents(numberOfComponents);
-        scalars->Allocate(numPts * numberOfComponents);
+        scalars->SetNumberOfTuples(numPts);
         }
       else
         {
@@ -609,13 +608,17 @@ int vtkEnSightGoldReader::ReadScalarsPerNode(const char* fileName, const char* d
           scalars->InsertComponent(i, component, val);
           }
         }
-      else
+      else if (!this->ReadNextDataValues(scalars->GetPointer(component),
+                                         numPts, numberOfComponents))
         {
-        for (i = 0; i < numPts; i++)
+        vtkErrorMacro("Could not read the scalars of part " << partId + 1);
+        if (component == 0)
           {
-          this->ReadNextDataLine(line);
-          scalars->InsertComponent(i, component, atof(line));
+          scalars->Delete();
           }
+        delete this->IS;
+        this->IS = NULL;
+        return 0;
         }
 
       if (component == 0)
@@ -784,15 +787,17 @@ int vtkEnSightGoldReader::ReadVectorsPerNode(const char* fileName, const char* d
       {
       vectors = vtkFloatArray::New();
       this->ReadNextDataLine(line); // "coordinates" or "block"
-      vectors->SetNumberOfTuples(numPts);
       vectors->SetNumberOfComponents(3);
-      vectors->Allocate(numPts*3);
+      vectors->SetNumberOfTuples(numPts);
       for (i = 0; i < 3; i++)
         {
-        for (j = 0; j < numPts; j++)
+        if (!this->ReadNextDataValues(vectors->GetPointer(i), numPts, 3))
           {
-          this->ReadNextDataLine(line);
-          vectors->InsertComponent(j, i, atof(line));
+          vtkErrorMacro("Could not read the vectors of part " << partId + 1);
+          vectors->Delete();
+          delete this->IS;
+          this->IS = NULL;
+          return 0;
           }
         }
       vectors->SetName(description);
@@ -905,15 +910,17 @@ int vtkEnSightGoldReader::ReadTensorsPerNode(const char* fileName, const char* d
       {
       tensors = vtkFloatArray::New();
       this->ReadNextDataLine(line); // "coordinates" or "block"
-      tensors->SetNumberOfTuples(numPts);
       tensors->SetNumberOfComponents(6);
-      tensors->Allocate(numPts*6);
+      tensors->SetNumberOfTuples(numPts);
       for (i = 0; i < 6; i++)
         {
-        for (j = 0; j < numPts; j++)
+        if (!this->ReadNextDataValues(tensors->GetPointer(i), numPts, 6))
           {
-          this->ReadNextDataLine(line);
-          tensors->InsertComponent(j, i, atof(line));
+          vtkErrorMacro("Could not read the tensors of part " << partId + 1);
+          tensors->Delete();
+          delete this->IS;
+          this->IS = NULL;
+          return 0;
           }
         }
       tensors->SetName(description);
@@ -1041,15 +1048,12 @@ int vtkEnSightGoldReader::ReadScalarsPerElement(const char* fileName,
 
       // need to find out from CellIds how many cells we have of this element
       // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
+      int valid = 1;
       if (strncmp(line, "block",5) == 0)
         {
-        for (i = 0; i < numCells; i++)
-          {
-          this->ReadNextDataLine(line);
-          scalar = atof(line);
-          scalars->InsertComponent(i, component, scalar);
-          }
-        lineRead = this->ReadNextDataLine(line);
+        valid = this->ReadNextDataValues(scalars->GetPointer(component),
+                                         numCells, numberOfComponents);
+        lineRead = valid && this->ReadNextDataLine(line);
         }
       else
         {
@@ -1094,19 +1098,26 @@ int vtkEnSightGoldReader::ReadScalarsPerElement(const char* fileName,
                   elementType)->GetId(i), component, scalar);
               }
             }
-          else
+          else if (!this->ReadElementTypeValues(scalars, idx, elementType,
+                                                component, 1))
             {
-            for (i = 0; i < numCellsPerElement; i++)
-              {
-              this->ReadNextDataLine(line);
-              scalar = atof(line);
-              scalars->InsertComponent( this->GetCellIds(idx,
-                  elementType)->GetId(i), component, scalar);
-              }
+            valid = 0;
+            break;
             }
           lineRead = this->ReadNextDataLine(line);
           } // end while
         } // end else
+      if (!valid)
+        {
+        vtkErrorMacro("Could not read the scalars of part " << partId + 1);
+        delete this->IS;
+        this->IS = NULL;
+        if (component == 0)
+          {
+          scalars->Delete();
+          }
+        return 0;
+        }
       if (component == 0)
         {
         scalars->SetName(description);
@@ -1140,10 +1151,9 @@ int vtkEnSightGoldReader::ReadVectorsPerElement(const char* fileName,
   vtkMultiBlockDataSet *compositeOutput)
 {
   char line[256];
-  int partId, realId, numCells, numCellsPerElement, i, j, idx;
+  int partId, realId, numCells, i, j, idx;
   vtkFloatArray *vectors;
   int lineRead, elementType;
-  float value;
   vtkDataSet *output;
 
   // Initialize
@@ -1232,24 +1242,19 @@ int vtkEnSightGoldReader::ReadVectorsPerElement(const char* fileName,
       {
       vectors = vtkFloatArray::New();
       this->ReadNextDataLine(line); // element type or "block"
-      vectors->SetNumberOfTuples(numCells);
       vectors->SetNumberOfComponents(3);
-      vectors->Allocate(numCells*3);
+      vectors->SetNumberOfTuples(numCells);
 
       // need to find out from CellIds how many cells we have of this element
       // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
+      int valid = 1;
       if (strncmp(line, "block",5) == 0)
         {
-        for (i = 0; i < 3; i++)
+        for (i = 0; valid && i < 3; i++)
           {
-          for (j = 0; j < numCells; j++)
-            {
-            this->ReadNextDataLine(line);
-            value = atof(line);
-            vectors->InsertComponent(j, i, value);
-            }
+          valid = this->ReadNextDataValues(vectors->GetPointer(i), numCells, 3);
           }
-        lineRead = this->ReadNextDataLine(line);
+        lineRead = valid && this->ReadNextDataLine(line);
         }
       else
         {
@@ -1266,21 +1271,22 @@ int vtkEnSightGoldReader::ReadVectorsPerElement(const char* fileName,
             return 0;
             }
           idx = this->UnstructuredPartIds->IsId(realId);
-          numCellsPerElement =
-            this->GetCellIds(idx, elementType)->GetNumberOfIds();
-          for (i = 0; i < 3; i++)
+          if (!this->ReadElementTypeValues(vectors, idx, elementType, 0, 3))
             {
-            for (j = 0; j < numCellsPerElement; j++)
-              {
-              this->ReadNextDataLine(line);
-              value = atof(line);
-              vectors->InsertComponent(this->GetCellIds(idx, elementType)->GetId(j),
-                i, value);
-              }
+            valid = 0;
+            break;
             }
           lineRead = this->ReadNextDataLine(line);
           } // end while
         } // end else
+      if (!valid)
+        {
+        vtkErrorMacro("Could not read the vectors of part " << partId + 1);
+        delete this->IS;
+        this->IS = NULL;
+        vectors->Delete();
+        return 0;
+        }
       vectors->SetName(description);
       output->GetCellData()->AddArray(vectors);
       if (!output->GetCellData()->GetVectors())
@@ -1307,10 +1313,9 @@ int vtkEnSightGoldReader::ReadTensorsPerElement(const char* fileName,
   vtkMultiBlockDataSet *compositeOutput)
 {
   char line[256];
-  int partId, realId, numCells, numCellsPerElement, i, j, idx;
+  int partId, realId, numCells, i, j, idx;
   vtkFloatArray *tensors;
   int lineRead, elementType;
-  float value;
   vtkDataSet *output;
 
   // Initialize
@@ -1399,24 +1404,19 @@ int vtkEnSightGoldReader::ReadTensorsPerElement(const char* fileName,
       {
       tensors = vtkFloatArray::New();
       this->ReadNextDataLine(line); // element type or "block"
-      tensors->SetNumberOfTuples(numCells);
       tensors->SetNumberOfComponents(6);
-      tensors->Allocate(numCells*6);
+      tensors->SetNumberOfTuples(numCells);
 
       // need to find out from CellIds how many cells we have of this element
       // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
+      int valid = 1;
       if (strncmp(line, "block",5) == 0)
         {
-        for (i = 0; i < 6; i++)
+        for (i = 0; valid && i < 6; i++)
           {
-          for (j = 0; j < numCells; j++)
-            {
-            this->ReadNextDataLine(line);
-            value = atof(line);
-            tensors->InsertComponent(j, i, value);
-            }
+          valid = this->ReadNextDataValues(tensors->GetPointer(i), numCells, 6);
           }
-        lineRead = this->ReadNextDataLine(line);
+        lineRead = valid && this->ReadNextDataLine(line);
         }
       else
         {
@@ -1433,21 +1433,22 @@ int vtkEnSightGoldReader::ReadTensorsPerElement(const char* fileName,
             return 0;
             }
           idx = this->UnstructuredPartIds->IsId(realId);
-          numCellsPerElement =
-            this->GetCellIds(idx, elementType)->GetNumberOfIds();
-          for (i = 0; i < 6; i++)
+          if (!this->ReadElementTypeValues(tensors, idx, elementType, 0, 6))
             {
-            for (j = 0; j < numCellsPerElement; j++)
-              {
-              this->ReadNextDataLine(line);
-              value = atof(line);
-              tensors->InsertComponent(this->GetCellIds(idx, elementType)->GetId(j),
-                i, value);
-              }
+            valid = 0;
+            break;
             }
           lineRead = this->ReadNextDataLine(line);
           } // end while
         } // end else
+      if (!valid)
+        {
+        vtkErrorMacro("Could not read the tensors of part " << partId + 1);
+        delete this->IS;
+        this->IS = NULL;
+        tensors->Delete();
+        return 0;
+        }
       tensors->SetName(description);
       output->GetCellData()->AddArray(tensors);
       tensors->Delete();
@@ -1475,7 +1476,7 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
   vtkIdType *nodeIds;
   int *intIds;
   int numElements;
-  int idx, cellType;
+  int idx;
   vtkIdType cellId;
 
   this->NumberOfNewOutputs++;
@@ -1512,88 +1513,29 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
       vtkDebugMacro("coordinates");
       int numPts;
       vtkPoints *points = vtkPoints::New();
-      double point[3];
 
       this->ReadNextDataLine(line);
       numPts = atoi(line);
       vtkDebugMacro("num. points: " << numPts);
 
-      points->Allocate(numPts);
-
-      for (i = 0; i < numPts; i++)
-        {
-        this->ReadNextDataLine(line);
-        points->InsertNextPoint(atof(line), 0, 0);
-        }
-      for (i = 0; i < numPts; i++)
-        {
-        this->ReadNextDataLine(line);
-        points->GetPoint(i, point);
-        points->SetPoint(i, point[0], atof(line), 0);
-        }
-      for (i = 0; i < numPts; i++)
+      if (!this->ReadCoordinates(points, numPts, this->NodeIdsListed))
         {
-        this->ReadNextDataLine(line);
-        points->GetPoint(i, point);
-        points->SetPoint(i, point[0], point[1], atof(line));
+        points->Delete();
+        return -1;
         }
-
       lineRead = this->ReadNextDataLine(line);
-      sscanf(line, " %s", subLine);
-
-      char *endptr;
-      strtod(subLine, &endptr); // Testing if we can convert this string to double
-      if ( subLine != endptr )
-        { // necessary if node ids were listed
-        for (i = 0; i < numPts; i++)
-          {
-          points->GetPoint(i, point);
-          points->SetPoint(i, point[1], point[2], atof(line));
-          lineRead = this->ReadNextDataLine(line);
-          }
-        }
       output->SetPoints(points);
       points->Delete();
       }
     else if (strncmp(line, "point", 5) == 0)
       {
-      int *elementIds;
       vtkDebugMacro("point");
-
-      nodeIds = new vtkIdType[1];
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      elementIds = new int[numElements];
-
-      for (i = 0; i < numElements; i++)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::POINT,
+                              VTK_VERTEX, 1))
         {
-        this->ReadNextDataLine(line);
-        elementIds[i] = atoi(line);
+        return -1;
         }
       lineRead = this->ReadNextDataLine(line);
-      sscanf(line, " %s", subLine);
-      if (isdigit(subLine[0]))
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          nodeIds[0] = atoi(line) - 1; // because EnSight ids start at 1
-          cellId = output->InsertNextCell(VTK_VERTEX, 1, nodeIds);
-          this->GetCellIds(idx, vtkEnSightReader::POINT)->InsertNextId(cellId);
-          lineRead = this->ReadNextDataLine(line);
-          }
-        }
-      else
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          nodeIds[0] = elementIds[i] - 1;
-          cellId = output->InsertNextCell(VTK_VERTEX, 1, nodeIds);
-          this->GetCellIds(idx, vtkEnSightReader::POINT)->InsertNextId(cellId);
-          }
-        }
-
-      delete [] nodeIds;
-      delete [] elementIds;
       }
     else if (strncmp(line, "g_point", 7) == 0)
       {
@@ -1620,35 +1562,12 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
     else if (strncmp(line, "bar2", 4) == 0)
       {
       vtkDebugMacro("bar2");
-
-      nodeIds = new vtkIdType[2];
-      intIds = new int[2];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d", &intIds[0], &intIds[1]) != 2)
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
-        }
-      for (i = 0; i < numElements; i++)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::BAR2,
+                              VTK_LINE, 2))
         {
-        sscanf(line, " %d %d", &intIds[0], &intIds[1]);
-        for (j = 0; j < 2; j++)
-          {
-          intIds[j]--;
-          nodeIds[j] = intIds[j];
-          }
-        cellId = output->InsertNextCell(VTK_LINE, 2, nodeIds);
-        this->GetCellIds(idx, vtkEnSightReader::BAR2)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
+        return -1;
         }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "g_bar2", 6) == 0)
       {
@@ -1677,37 +1596,13 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
     else if (strncmp(line, "bar3", 4) == 0)
       {
       vtkDebugMacro("bar3");
-      nodeIds = new vtkIdType[3];
-      intIds = new int[3];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d %d", &intIds[0], &intIds[1], &intIds[2]) != 3)
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
-        }
-      for (i = 0; i < numElements; i++)
+      static const int order[3] = { 0, 2, 1 };
+      if (!this->ReadElements(output, idx, vtkEnSightReader::BAR3,
+                              VTK_QUADRATIC_EDGE, 3, order))
         {
-        sscanf(line, " %d %d %d", &intIds[0], &intIds[1], &intIds[2]);
-        for (j = 0; j < 3; j++)
-          {
-          intIds[j]--;
-          }
-        nodeIds[0] = intIds[0];
-        nodeIds[1] = intIds[2];
-        nodeIds[2] = intIds[1];
-
-        cellId = output->InsertNextCell(VTK_QUADRATIC_EDGE, 3, nodeIds);
-        this->GetCellIds(idx, vtkEnSightReader::BAR3)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
+        return -1;
         }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "g_bar3", 6) == 0)
       {
@@ -1734,69 +1629,47 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
       }
     else if (strncmp(line, "nsided", 6) == 0)
       {
-      int *numNodesPerElement;
-      int numNodes;
-      vtksys_ios::stringstream* lineStream = new vtksys_ios::stringstream(vtksys_ios::stringstream::out);
-      vtksys_ios::stringstream* formatStream = new vtksys_ios::stringstream(vtksys_ios::stringstream::out);
-      vtksys_ios::stringstream* tempStream = new vtksys_ios::stringstream(vtksys_ios::stringstream::out);
+      vtkDebugMacro("nsided");
+      vtkIdTypeArray *numNodesPerElement = vtkIdTypeArray::New();
+      vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+      vtkIdType numNodes = 0;
 
       this->ReadNextDataLine(line);
       numElements = atoi(line);
-      if (this->ElementIdsListed)
+      int valid = this->ReadElementValues(numElements, numElements,
+                                          numNodesPerElement);
+      for (i = 0; i < numElements; i++)
         {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
+        numNodes += numNodesPerElement->GetValue(i);
         }
-
-      numNodesPerElement = new int[numElements];
-      for (i = 0; i < numElements; i++)
+      connectivity->SetNumberOfValues(numNodes);
+      valid = valid &&
+        this->ReadNextDataValues(connectivity->GetPointer(0), numNodes);
+      if (!valid)
         {
-        this->ReadNextDataLine(line);
-        numNodesPerElement[i] = atoi(line);
+        vtkErrorMacro("Could not read the nodes of the nsided elements.");
+        numNodesPerElement->Delete();
+        connectivity->Delete();
+        return -1;
         }
 
-      lineRead = this->ReadNextDataLine(line);
+      // The nodes are inserted in the reverse order.
+      nodeIds = connectivity->GetPointer(0);
       for (i = 0; i < numElements; i++)
         {
-        numNodes = numNodesPerElement[i];
-        nodeIds = new vtkIdType[numNodes];
-        intIds = new int[numNodesPerElement[i]];
-
-        formatStream->str("");
-        tempStream->str("");
-        lineStream->str(line);
-        lineStream->seekp(0, vtksys_ios::stringstream::end);
-        while (! lineRead)
-          {
-          lineRead = this->ReadNextDataLine(line);
-          lineStream->write(line, strlen(line));
-          lineStream->seekp(0, vtksys_ios::stringstream::end);
-          }
+        numNodes = numNodesPerElement->GetValue(i);
         for (j = 0; j < numNodes; j++)
           {
-          formatStream->write(" %d", 3);
-          formatStream->seekp(0, vtksys_ios::stringstream::end);
-          sscanf(lineStream->str().c_str(), formatStream->str().c_str(), &intIds[numNodes-j-1]);
-          tempStream->write(" %*d", 4);
-          tempStream->seekp(0, vtksys_ios::stringstream::end);
-          formatStream->str(tempStream->str());
-          formatStream->seekp(0, vtksys_ios::stringstream::end);
-          intIds[numNodes-j-1]--;
-          nodeIds[numNodes-j-1] = intIds[numNodes-j-1];
+          nodeIds[j]--;
           }
+        vtkstd::reverse(nodeIds, nodeIds + numNodes);
         cellId = output->InsertNextCell(VTK_POLYGON, numNodes, nodeIds);
         this->GetCellIds(idx, vtkEnSightReader::NSIDED)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
-        delete [] nodeIds;
-        delete [] intIds;
+        nodeIds += numNodes;
         }
-      delete lineStream;
-      delete formatStream;
-      delete tempStream;
-      delete [] numNodesPerElement;
+      numNodesPerElement->Delete();
+      connectivity->Delete();
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "g_nsided", 8) == 0)
       {
@@ -1824,73 +1697,22 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
     else if (strncmp(line, "tria3", 5) == 0)
       {
       vtkDebugMacro("tria3");
-      cellType = vtkEnSightReader::TRIA3;
-
-      nodeIds = new vtkIdType[3];
-      intIds = new int[3];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d %d", &intIds[0], &intIds[1],
-          &intIds[2]) != 3)
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
-        }
-      for (i = 0; i < numElements; i++)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::TRIA3,
+                              VTK_TRIANGLE, 3))
         {
-        sscanf(line, " %d %d %d", &intIds[0], &intIds[1], &intIds[2]);
-        for (j = 0; j < 3; j++)
-          {
-          intIds[j]--;
-          nodeIds[j] = intIds[j];
-          }
-        cellId = output->InsertNextCell(VTK_TRIANGLE, 3, nodeIds);
-        this->GetCellIds(idx, cellType)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
+        return -1;
         }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "tria6", 5) == 0)
       {
       vtkDebugMacro("tria6");
-      cellType = vtkEnSightReader::TRIA6;
-
-      nodeIds = new vtkIdType[6];
-      intIds = new int[6];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d %d %d %d %d", &intIds[0], &intIds[1],
-          &intIds[2], &intIds[3], &intIds[4], &intIds[5]) != 6)
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
-        }
-      for (i = 0; i < numElements; i++)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::TRIA6,
+                              VTK_QUADRATIC_TRIANGLE, 6))
         {
-        sscanf(line, " %d %d %d %d %d %d", &intIds[0], &intIds[1], &intIds[2],
-          &intIds[3], &intIds[4], &intIds[5]);
-        for (j = 0; j < 6; j++)
-          {
-          intIds[j]--;
-          nodeIds[j] = intIds[j];
-          }
-        cellId = output->InsertNextCell(VTK_QUADRATIC_TRIANGLE, 6, nodeIds);
-        this->GetCellIds(idx, cellType)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
+        return -1;
         }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "g_tria3", 7) == 0 ||
       strncmp(line, "g_tria6", 7) == 0)
@@ -1899,12 +1721,10 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
       if (strncmp(line, "g_tria6", 7) == 0)
         {
         vtkDebugMacro("g_tria6");
-        cellType = vtkEnSightReader::TRIA6;
         }
       else
         {
         vtkDebugMacro("g_tria3");
-        cellType = vtkEnSightReader::TRIA3;
         }
 
       intIds = new int[3];
@@ -1930,76 +1750,22 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
     else if (strncmp(line, "quad4", 5) == 0)
       {
       vtkDebugMacro("quad4");
-      cellType = vtkEnSightReader::QUAD4;
-
-      nodeIds = new vtkIdType[4];
-      intIds = new int[4];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d %d %d", &intIds[0], &intIds[1], &intIds[2],
-          &intIds[3]) != 4)
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
-        }
-      for (i = 0; i < numElements; i++)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::QUAD4,
+                              VTK_QUAD, 4))
         {
-        sscanf(line, " %d %d %d %d", &intIds[0], &intIds[1], &intIds[2],
-          &intIds[3]);
-        for (j = 0; j < 4; j++)
-          {
-          intIds[j]--;
-          nodeIds[j] = intIds[j];
-          }
-        cellId = output->InsertNextCell(VTK_QUAD, 4, nodeIds);
-        this->GetCellIds(idx, cellType)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
+        return -1;
         }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "quad8", 5) == 0)
       {
       vtkDebugMacro("quad8");
-      cellType = vtkEnSightReader::QUAD8;
-
-      nodeIds = new vtkIdType[8];
-      intIds = new int[8];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d %d %d %d %d %d %d",
-          &intIds[0], &intIds[1], &intIds[2], &intIds[3],
-          &intIds[4], &intIds[5], &intIds[6], &intIds[7]) != 8)
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
-        }
-      for (i = 0; i < numElements; i++)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::QUAD8,
+                              VTK_QUADRATIC_QUAD, 8))
         {
-        sscanf(line, " %d %d %d %d %d %d %d %d",
-          &intIds[0], &intIds[1], &intIds[2], &intIds[3],
-          &intIds[4], &intIds[5], &intIds[6], &intIds[7]);
-        for (j = 0; j < 8; j++)
-          {
-          intIds[j]--;
-          nodeIds[j] = intIds[j];
-          }
-        cellId = output->InsertNextCell(VTK_QUADRATIC_QUAD, 8, nodeIds);
-        this->GetCellIds(idx, cellType)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
+        return -1;
         }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "g_quad4", 7) == 0 ||
       strncmp(line, "g_quad8", 7) == 0)
@@ -2008,12 +1774,10 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
       if (strncmp(line, "g_quad8", 7) == 0)
         {
         vtkDebugMacro("g_quad8");
-        cellType = vtkEnSightReader::QUAD8;
         }
       else
         {
         vtkDebugMacro("g_quad4");
-        cellType = vtkEnSightReader::QUAD4;
         }
 
       intIds = new int[4];
@@ -2038,222 +1802,107 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
       }
     else if (strncmp(line, "nfaced", 6) == 0)
       {
-      int *numFacesPerElement;
-      int *numNodesPerFace;
-      int *nodeMarker;
-      int numPts = 0;
-      int numFaces = 0;
-      int numNodes = 0;
-      int faceCount = 0;
-      int elementNodeCount = 0;
-      vtksys_ios::stringstream* lineStream = new vtksys_ios::stringstream(vtksys_ios::stringstream::out);
-      vtksys_ios::stringstream* formatStream = new vtksys_ios::stringstream(vtksys_ios::stringstream::out);
-      vtksys_ios::stringstream* tempStream = new vtksys_ios::stringstream(vtksys_ios::stringstream::out);
+      vtkDebugMacro("nfaced");
+      vtkIdTypeArray *numFacesPerElement = vtkIdTypeArray::New();
+      vtkIdTypeArray *numNodesPerFace = vtkIdTypeArray::New();
+      vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+      vtkIdType numFaces = 0;
+      vtkIdType numNodes = 0;
 
       this->ReadNextDataLine(line);
       numElements = atoi(line);
-      if (this->ElementIdsListed)
+      int valid = this->ReadElementValues(numElements, numElements,
+                                          numFacesPerElement);
+      for (i = 0; i < numElements; i++)
         {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
+        numFaces += numFacesPerElement->GetValue(i);
         }
-
-      numFacesPerElement = new int[numElements];
-      for (i = 0; i < numElements; i++)
+      numNodesPerFace->SetNumberOfValues(numFaces);
+      valid = valid &&
+        this->ReadNextDataValues(numNodesPerFace->GetPointer(0), numFaces);
+      for (i = 0; valid && i < numFaces; i++)
         {
-        this->ReadNextDataLine(line);
-        numFacesPerElement[i] = atoi(line);
-        numFaces += numFacesPerElement[i];
+        numNodes += numNodesPerFace->GetValue(i);
         }
-
-      numNodesPerFace = new int[numFaces];
-      for (i = 0; i < numFaces; i++)
+      connectivity->SetNumberOfValues(numNodes);
+      valid = valid &&
+        this->ReadNextDataValues(connectivity->GetPointer(0), numNodes);
+      if (!valid)
         {
-        this->ReadNextDataLine(line);
-        numNodesPerFace[i] = atoi(line);
+        vtkErrorMacro("Could not read the faces of the nfaced elements.");
+        numFacesPerElement->Delete();
+        numNodesPerFace->Delete();
+        connectivity->Delete();
+        return -1;
         }
 
-      numPts = output->GetNumberOfPoints();
-      nodeMarker = new int[numPts];
+      vtkIdType numPts = output->GetNumberOfPoints();
+      int *nodeMarker = new int[numPts];
       for (i = 0; i < numPts; i++)
         {
         nodeMarker[i] = -1;
         }
-
-      lineRead = this->ReadNextDataLine(line);
+      vtkIdList *faces = vtkIdList::New();
+      vtkIdList *points = vtkIdList::New();
+      vtkIdType *nodes = connectivity->GetPointer(0);
+      vtkIdType *faceSizes = numNodesPerFace->GetPointer(0);
       for (i = 0; i < numElements; i++)
         {
-        numNodes = 0;
-        for (j = 0; j < numFacesPerElement[i]; j++)
-          {
-          numNodes += numNodesPerFace[faceCount + j];
-          }
-        intIds = new int[numNodes];
-
-        // Read element node ids
-        elementNodeCount = 0;
-        for (j = 0; j < numFacesPerElement[i]; j++)
-          {
-          formatStream->str("");
-          tempStream->str("");
-          lineStream->str(line);
-          lineStream->seekp(0, vtksys_ios::stringstream::end);
-          while (! lineRead)
-            {
-            lineRead = this->ReadNextDataLine(line);
-            lineStream->write(line, strlen(line));
-            lineStream->seekp(0, vtksys_ios::stringstream::end);
-            }
-          for (k = 0; k < numNodesPerFace[faceCount + j]; k++)
-            {
-            formatStream->write(" %d", 3);
-            formatStream->seekp(0, vtksys_ios::stringstream::end);
-            sscanf(lineStream->str().c_str(), formatStream->str().c_str(), &intIds[elementNodeCount]);
-            tempStream->write(" %*d", 4);
-            tempStream->seekp(0, vtksys_ios::stringstream::end);
-            formatStream->str(tempStream->str());
-            formatStream->seekp(0, vtksys_ios::stringstream::end);
-            elementNodeCount += 1;
-            }
-          lineRead = this->ReadNextDataLine(line);
-          }
-
-        // prepare an array of Ids describing the vtkPolyhedron object yyy begin
-        int         nodeIndx = 0; // indexing the raw array of point Ids
-        int         arrayIdx = 0; // indexing the new array of Ids
-        vtkIdType * theFaces = new vtkIdType // vtkPolyhedron's info of faces
-                               [ elementNodeCount + numFacesPerElement[i] ];
-        for ( j = 0; j < numFacesPerElement[i]; j ++ )
+        // The faces of a vtkPolyhedron are each their number of points
+        // followed by their zero based point ids.
+        faces->Reset();
+        points->Reset();
+        numFaces = numFacesPerElement->GetValue(i);
+        for (j = 0; j < numFaces; j++)
           {
-          // number of points constituting this face
-          theFaces[ arrayIdx ++ ] = numNodesPerFace[ faceCount + j ];
-
-          for (  k = 0;  k < numNodesPerFace[ faceCount + j ];  k ++  )
-            {
-            // convert EnSight 1-based indexing to VTK 0-based indexing
-            theFaces[ arrayIdx ++ ] = intIds[ nodeIndx ++ ] - 1;
-            }
-          }
-        //*//// yyy end
-
-        faceCount += numFacesPerElement[i];
-
-        // Build element
-        nodeIds = new vtkIdType[numNodes];
-        elementNodeCount = 0;
-        for (j = 0; j < numNodes; j++)
-          {
-          if (nodeMarker[intIds[j] - 1] < i)
+          faces->InsertNextId(faceSizes[j]);
+          for (k = 0; k < faceSizes[j]; k++)
             {
-            nodeIds[elementNodeCount] = intIds[j] - 1;
-            nodeMarker[intIds[j] - 1] = i;
-            elementNodeCount += 1;
+            vtkIdType nodeId = *nodes++ - 1;
+            faces->InsertNextId(nodeId);
+            if (nodeMarker[nodeId] < i)
+              {
+              points->InsertNextId(nodeId);
+              nodeMarker[nodeId] = i;
+              }
             }
           }
-        /*/ xxx begin
-        cellId = output->InsertNextCell( VTK_CONVEX_POINT_SET,
-                                         elementNodeCount, nodeIds );
-        //*//// xxx end
-
-        // insert the cell as a vtkPolyhedron object yyy begin
-        cellId = output->InsertNextCell( VTK_POLYHEDRON, elementNodeCount,
-                                         nodeIds, numFacesPerElement[i],
-                                         theFaces );
-        delete [] theFaces;
-        theFaces = NULL;
-        //*//// yyy end
+        faceSizes += numFaces;
 
+        cellId = output->InsertNextCell(VTK_POLYHEDRON,
+                                        points->GetNumberOfIds(),
+                                        points->GetPointer(0), numFaces,
+                                        faces->GetPointer(0));
         this->GetCellIds(idx, vtkEnSightReader::NFACED)->InsertNextId(cellId);
-        delete [] nodeIds;
-        delete [] intIds;
         }
 
-      delete lineStream;
-      delete formatStream;
-      delete tempStream;
-
+      faces->Delete();
+      points->Delete();
       delete [] nodeMarker;
-      delete [] numNodesPerFace;
-      delete [] numFacesPerElement;
-
+      numFacesPerElement->Delete();
+      numNodesPerFace->Delete();
+      connectivity->Delete();
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "tetra4", 6) == 0)
       {
       vtkDebugMacro("tetra4");
-      cellType = vtkEnSightReader::TETRA4;
-
-      nodeIds = new vtkIdType[4];
-      intIds = new int[4];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d %d %d", &intIds[0], &intIds[1],
-          &intIds[2], &intIds[3]) != 4)
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
-        }
-      for (i = 0; i < numElements; i++)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::TETRA4,
+                              VTK_TETRA, 4))
         {
-        sscanf(line, " %d %d %d %d", &intIds[0], &intIds[1], &intIds[2],
-          &intIds[3]);
-        for (j = 0; j < 4; j++)
-          {
-          intIds[j]--;
-          nodeIds[j] = intIds[j];
-          }
-        cellId = output->InsertNextCell(VTK_TETRA, 4, nodeIds);
-        this->GetCellIds(idx, cellType)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
+        return -1;
         }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "tetra10", 7) == 0)
       {
       vtkDebugMacro("tetra10");
-      cellType = vtkEnSightReader::TETRA10;
-
-      nodeIds = new vtkIdType[10];
-      intIds = new int[10];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d %d %d %d %d %d %d %d %d", &intIds[0],
-          &intIds[1], &intIds[2], &intIds[3], &intIds[4],
-          &intIds[5], &intIds[6], &intIds[7], &intIds[8],
-          &intIds[9]) != 10)
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
-        }
-      for (i = 0; i < numElements; i++)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::TETRA10,
+                              VTK_QUADRATIC_TETRA, 10))
         {
-        sscanf(line, " %d %d %d %d %d %d %d %d %d %d",
-          &intIds[0], &intIds[1], &intIds[2], &intIds[3], &intIds[4],
-          &intIds[5], &intIds[6], &intIds[7], &intIds[8], &intIds[9]);
-        for (j = 0; j < 10; j++)
-          {
-          intIds[j]--;
-          nodeIds[j] = intIds[j];
-          }
-        cellId = output->InsertNextCell(VTK_QUADRATIC_TETRA, 10, nodeIds);
-        this->GetCellIds(idx, cellType)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
+        return -1;
         }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "g_tetra4", 8) == 0 ||
       strncmp(line, "g_tetra10", 9) == 0)
@@ -2262,12 +1911,10 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
       if (strncmp(line, "g_tetra10", 9) == 0)
         {
         vtkDebugMacro("g_tetra10");
-        cellType = vtkEnSightReader::TETRA10;
         }
       else
         {
         vtkDebugMacro("g_tetra4");
-        cellType = vtkEnSightReader::TETRA4;
         }
 
       intIds = new int[4];
@@ -2293,78 +1940,22 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
     else if (strncmp(line, "pyramid5", 8) == 0)
       {
       vtkDebugMacro("pyramid5");
-      cellType = vtkEnSightReader::PYRAMID5;
-
-      nodeIds = new vtkIdType[5];
-      intIds = new int[5];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d %d %d %d", &intIds[0], &intIds[1], &intIds[2],
-          &intIds[3], &intIds[4]) != 5)
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
-        }
-      for (i = 0; i < numElements; i++)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::PYRAMID5,
+                              VTK_PYRAMID, 5))
         {
-        sscanf(line, " %d %d %d %d %d", &intIds[0], &intIds[1], &intIds[2],
-          &intIds[3], &intIds[4]);
-        for (j = 0; j < 5; j++)
-          {
-          intIds[j]--;
-          nodeIds[j] = intIds[j];
-          }
-        cellId = output->InsertNextCell(VTK_PYRAMID, 5, nodeIds);
-        this->GetCellIds(idx, cellType)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
+        return -1;
         }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "pyramid13", 9) == 0)
       {
       vtkDebugMacro("pyramid13");
-      cellType = vtkEnSightReader::PYRAMID13;
-
-      nodeIds = new vtkIdType[13];
-      intIds = new int[13];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d %d %d %d %d %d %d %d %d %d %d %d", &intIds[0],
-          &intIds[1], &intIds[2], &intIds[3], &intIds[4],
-          &intIds[5], &intIds[6], &intIds[7], &intIds[8],
-          &intIds[9], &intIds[10], &intIds[11], &intIds[12]) != 13)
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
-        }
-      for (i = 0; i < numElements; i++)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::PYRAMID13,
+                              VTK_QUADRATIC_PYRAMID, 13))
         {
-        sscanf(line, " %d %d %d %d %d %d %d %d %d %d %d %d %d", &intIds[0],
-          &intIds[1], &intIds[2], &intIds[3], &intIds[4],
-          &intIds[5], &intIds[6], &intIds[7], &intIds[8],
-          &intIds[9], &intIds[10], &intIds[11], &intIds[12]);
-        for (j = 0; j < 13; j++)
-          {
-          intIds[j]--;
-          nodeIds[j] = intIds[j];
-          }
-        cellId = output->InsertNextCell(VTK_QUADRATIC_PYRAMID, 13, nodeIds);
-        this->GetCellIds(idx, cellType)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
+        return -1;
         }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "g_pyramid5", 10) == 0 ||
       strncmp(line, "g_pyramid13", 11) == 0)
@@ -2373,12 +1964,10 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
       if (strncmp(line, "g_pyramid13", 11) == 0)
         {
         vtkDebugMacro("g_pyramid13");
-        cellType = vtkEnSightReader::PYRAMID13;
         }
       else
         {
         vtkDebugMacro("g_pyramid5");
-        cellType = vtkEnSightReader::PYRAMID5;
         }
 
       intIds = new int[5];
@@ -2404,83 +1993,22 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
     else if (strncmp(line, "hexa8", 5) == 0)
       {
       vtkDebugMacro("hexa8");
-      cellType = vtkEnSightReader::HEXA8;
-
-      nodeIds = new vtkIdType[8];
-      intIds = new int[8];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d %d %d %d %d %d %d", &intIds[0], &intIds[1],
-          &intIds[2], &intIds[3], &intIds[4], &intIds[5], &intIds[6],
-          &intIds[7]) != 8)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::HEXA8,
+                              VTK_HEXAHEDRON, 8))
         {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
+        return -1;
         }
-      for (i = 0; i < numElements; i++)
-        {
-        sscanf(line, " %d %d %d %d %d %d %d %d", &intIds[0], &intIds[1],
-          &intIds[2], &intIds[3], &intIds[4], &intIds[5], &intIds[6],
-          &intIds[7]);
-        for (j = 0; j < 8; j++)
-          {
-          intIds[j]--;
-          nodeIds[j] = intIds[j];
-          }
-        cellId = output->InsertNextCell(VTK_HEXAHEDRON, 8, nodeIds);
-        this->GetCellIds(idx, cellType)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
-        }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "hexa20", 6) == 0)
       {
       vtkDebugMacro("hexa20");
-      cellType = vtkEnSightReader::HEXA20;
-
-      nodeIds = new vtkIdType[20];
-      intIds = new int[20];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
-          &intIds[0], &intIds[1], &intIds[2], &intIds[3], &intIds[4],
-          &intIds[5], &intIds[6], &intIds[7], &intIds[8], &intIds[9],
-          &intIds[10], &intIds[11], &intIds[12], &intIds[13],
-          &intIds[14], &intIds[15], &intIds[16], &intIds[17],
-          &intIds[18], &intIds[19]) != 20)
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
-        }
-      for (i = 0; i < numElements; i++)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::HEXA20,
+                              VTK_QUADRATIC_HEXAHEDRON, 20))
         {
-        sscanf(line, " %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
-          &intIds[0], &intIds[1], &intIds[2], &intIds[3], &intIds[4],
-          &intIds[5], &intIds[6], &intIds[7], &intIds[8], &intIds[9],
-          &intIds[10], &intIds[11], &intIds[12], &intIds[13], &intIds[14],
-          &intIds[15], &intIds[16], &intIds[17], &intIds[18], &intIds[19]);
-        for (j = 0; j < 20; j++)
-          {
-          intIds[j]--;
-          nodeIds[j] = intIds[j];
-          }
-        cellId = output->InsertNextCell(VTK_QUADRATIC_HEXAHEDRON, 20, nodeIds);
-        this->GetCellIds(idx, cellType)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
+        return -1;
         }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "g_hexa8", 7) == 0 ||
       strncmp(line, "g_hexa20", 8) == 0)
@@ -2489,12 +2017,10 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
       if (strncmp(line, "g_hexa20", 8) == 0)
         {
         vtkDebugMacro("g_hexa20");
-        cellType = vtkEnSightReader::HEXA20;
         }
       else
         {
         vtkDebugMacro("g_hexa8");
-        cellType = vtkEnSightReader::HEXA8;
         }
 
       intIds = new int[8];
@@ -2521,79 +2047,22 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
     else if (strncmp(line, "penta6", 6) == 0)
       {
       vtkDebugMacro("penta6");
-      cellType = vtkEnSightReader::PENTA6;
-
-      nodeIds = new vtkIdType[6];
-      intIds = new int[6];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d %d %d %d %d", &intIds[0], &intIds[1],
-          &intIds[2], &intIds[3], &intIds[4], &intIds[5]) != 6)
-        {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
-        }
-      for (i = 0; i < numElements; i++)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::PENTA6,
+                              VTK_WEDGE, 6))
         {
-        sscanf(line, " %d %d %d %d %d %d", &intIds[0], &intIds[1], &intIds[2],
-          &intIds[3], &intIds[4], &intIds[5]);
-        for (j = 0; j < 6; j++)
-          {
-          intIds[j]--;
-          nodeIds[j] = intIds[j];
-          }
-        cellId = output->InsertNextCell(VTK_WEDGE, 6, nodeIds);
-        this->GetCellIds(idx, cellType)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
+        return -1;
         }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "penta15", 7) == 0)
       {
       vtkDebugMacro("penta15");
-      cellType = vtkEnSightReader::PENTA15;
-
-      nodeIds = new vtkIdType[15];
-      intIds = new int[15];
-
-      this->ReadNextDataLine(line);
-      numElements = atoi(line);
-      this->ReadNextDataLine(line);
-      if (sscanf(line, " %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
-          &intIds[0], &intIds[1], &intIds[2], &intIds[3], &intIds[4],
-          &intIds[5], &intIds[6], &intIds[7], &intIds[8], &intIds[9],
-          &intIds[10], &intIds[11], &intIds[12], &intIds[13],
-          &intIds[14]) != 15)
+      if (!this->ReadElements(output, idx, vtkEnSightReader::PENTA15,
+                              VTK_QUADRATIC_WEDGE, 15))
         {
-        for (i = 0; i < numElements; i++)
-          {
-          // Skip the element ids since they are just labels.
-          this->ReadNextDataLine(line);
-          }
-        }
-      for (i = 0; i < numElements; i++)
-        {
-        sscanf(line, " %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
-          &intIds[0], &intIds[1], &intIds[2], &intIds[3], &intIds[4],
-          &intIds[5], &intIds[6], &intIds[7], &intIds[8], &intIds[9],
-          &intIds[10], &intIds[11], &intIds[12], &intIds[13], &intIds[14]);
-        for (j = 0; j < 15; j++)
-          {
-          intIds[j]--;
-          nodeIds[j] = intIds[j];
-          }
-        cellId = output->InsertNextCell(VTK_QUADRATIC_WEDGE, 15, nodeIds);
-        this->GetCellIds(idx, cellType)->InsertNextId(cellId);
-        lineRead = this->ReadNextDataLine(line);
+        return -1;
         }
-      delete [] nodeIds;
-      delete [] intIds;
+      lineRead = this->ReadNextDataLine(line);
       }
     else if (strncmp(line, "g_penta6", 8) == 0 ||
       strncmp(line, "g_penta15", 9) == 0)
@@ -2602,12 +2071,10 @@ int vtkEnSightGoldReader::CreateUnstructuredGridOutput(int partId,
       if (strncmp(line, "g_penta15", 9) == 0)
         {
         vtkDebugMacro("g_penta15");
-        cellType = vtkEnSightReader::PENTA15;
         }
       else
         {
         vtkDebugMacro("g_penta6");
-        cellType = vtkEnSightReader::PENTA6;
         }
 
       intIds = new int[6];
@@ -2661,7 +2128,6 @@ int vtkEnSightGoldReader::CreateStructuredGridOutput(int partId,
   int dimensions[3];
   int i;
   vtkPoints *points = vtkPoints::New();
-  double point[3];
   int numPts;
 
   this->NumberOfNewOutputs++;
@@ -2694,36 +2160,32 @@ int vtkEnSightGoldReader::CreateStructuredGridOutput(int partId,
   output->SetWholeExtent(
     0, dimensions[0]-1, 0, dimensions[1]-1, 0, dimensions[2]-1);
   numPts = dimensions[0] * dimensions[1] * dimensions[2];
-  points->Allocate(numPts);
 
-  for (i = 0; i < numPts; i++)
+  if (!this->ReadCoordinates(points, numPts, 0))
     {
-    this->ReadNextDataLine(line);
-    points->InsertNextPoint(atof(line), 0.0, 0.0);
-    }
-  for (i = 0; i < numPts; i++)
-    {
-    this->ReadNextDataLine(line);
-    points->GetPoint(i, point);
-    points->SetPoint(i, point[0], atof(line), point[2]);
-    }
-  for (i = 0; i < numPts; i++)
-    {
-    this->ReadNextDataLine(line);
-    points->GetPoint(i, point);
-    points->SetPoint(i, point[0], point[1], atof(line));
+    points->Delete();
+    return -1;
     }
   output->SetPoints(points);
   if (iblanked)
     {
+    vtkIdTypeArray *iblanks = vtkIdTypeArray::New();
+    iblanks->SetNumberOfValues(numPts);
+    if (!this->ReadNextDataValues(iblanks->GetPointer(0), numPts))
+      {
+      vtkErrorMacro("Could not read the iblanking of a structured part.");
+      iblanks->Delete();
+      points->Delete();
+      return -1;
+      }
     for (i = 0; i < numPts; i++)
       {
-      this->ReadNextDataLine(line);
-      if (!atoi(line))
+      if (!iblanks->GetValue(i))
         {
         output->BlankPoint(i);
         }
       }
+    iblanks->Delete();
     }
 
   points->Delete();
@@ -2742,7 +2204,6 @@ int vtkEnSightGoldReader::CreateRectilinearGridOutput(int partId,
   int lineRead;
   int iblanked = 0;
   int dimensions[3];
-  int i;
   vtkFloatArray *xCoords = vtkFloatArray::New();
   vtkFloatArray *yCoords = vtkFloatArray::New();
   vtkFloatArray *zCoords = vtkFloatArray::New();
@@ -2778,38 +2239,30 @@ int vtkEnSightGoldReader::CreateRectilinearGridOutput(int partId,
   output->SetDimensions(dimensions);
   output->SetWholeExtent(
     0, dimensions[0]-1, 0, dimensions[1]-1, 0, dimensions[2]-1);
-  xCoords->Allocate(dimensions[0]);
-  yCoords->Allocate(dimensions[1]);
-  zCoords->Allocate(dimensions[2]);
   numPts = dimensions[0] * dimensions[1] * dimensions[2];
+  xCoords->SetNumberOfValues(dimensions[0]);
+  yCoords->SetNumberOfValues(dimensions[1]);
+  zCoords->SetNumberOfValues(dimensions[2]);
 
-  float val;
-
-  for (i = 0; i < dimensions[0]; i++)
-    {
-    this->ReadNextDataLine(line);
-    val = atof(line);
-    xCoords->InsertNextTuple(&val);
-    }
-  for (i = 0; i < dimensions[1]; i++)
-    {
-    this->ReadNextDataLine(line);
-    val = atof(line);
-    yCoords->InsertNextTuple(&val);
-    }
-  for (i = 0; i < dimensions[2]; i++)
+  int valid =
+    this->ReadNextDataValues(xCoords->GetPointer(0), dimensions[0]) &&
+    this->ReadNextDataValues(yCoords->GetPointer(0), dimensions[1]) &&
+    this->ReadNextDataValues(zCoords->GetPointer(0), dimensions[2]);
+  if (valid && iblanked)
     {
-    this->ReadNextDataLine(line);
-    val = atof(line);
-    zCoords->InsertNextTuple(&val);
+    vtkDebugMacro("VTK does not handle blanking for rectilinear grids.");
+    vtkIdTypeArray *iblanks = vtkIdTypeArray::New();
+    iblanks->SetNumberOfValues(numPts);
+    valid = this->ReadNextDataValues(iblanks->GetPointer(0), numPts);
+    iblanks->Delete();
     }
-  if (iblanked)
+  if (!valid)
     {
-    vtkDebugMacro("VTK does not handle blanking for rectilinear grids.");
-    for (i = 0; i < numPts; i++)
-      {
-      this->ReadNextDataLine(line);
-      }
+    vtkErrorMacro("Could not read the coordinates of a rectilinear part.");
+    xCoords->Delete();
+    yCoords->Delete();
+    zCoords->Delete();
+    return -1;
     }
 
   output->SetXCoordinates(xCoords);
@@ -2900,6 +2353,104 @@ int vtkEnSightGoldReader::CreateImageDataOutput(int partId,
   return lineRead;
 }
 
+//----------------------------------------------------------------------------
+int vtkEnSightGoldReader::ReadCoordinates(vtkPoints* points, int numPts,
+  int nodeIdsListed)
+{
+  vtkFloatArray *coordinates = vtkFloatArray::New();
+  coordinates->SetNumberOfComponents(3);
+  coordinates->SetNumberOfTuples(numPts);
+  float *xyz = coordinates->GetPointer(0);
+
+  // The node ids, if any, are read where the x coordinates go next.
+  int valid =
+    (!nodeIdsListed || this->ReadNextDataValues(xyz, numPts, 3)) &&
+    this->ReadNextDataValues(xyz, numPts, 3) &&
+    this->ReadNextDataValues(xyz + 1, numPts, 3) &&
+    this->ReadNextDataValues(xyz + 2, numPts, 3);
+  if (valid)
+    {
+    points->SetData(coordinates);
+    }
+  else
+    {
+    vtkErrorMacro("Could not read the coordinates of " << numPts
+                  << " points.");
+    }
+  coordinates->Delete();
+  return valid;
+}
+
+//----------------------------------------------------------------------------
+int vtkEnSightGoldReader::ReadElementValues(int numElements,
+  vtkIdType numValues, vtkIdTypeArray* values)
+{
+  // The element ids, if any, are read where the values go next.
+  values->SetNumberOfValues(numValues > numElements ? numValues : numElements);
+  int valid =
+    (!this->ElementIdsListed ||
+     this->ReadNextDataValues(values->GetPointer(0), numElements)) &&
+    this->ReadNextDataValues(values->GetPointer(0), numValues);
+  values->SetNumberOfValues(numValues);
+  return valid;
+}
+
+//----------------------------------------------------------------------------
+int vtkEnSightGoldReader::ReadElements(vtkUnstructuredGrid* output, int idx,
+  int elementType, int cellType, int numNodes, const int* order)
+{
+  char line[256];
+  this->ReadNextDataLine(line);
+  int numElements = atoi(line);
+
+  vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+  if (!this->ReadElementValues(numElements,
+        static_cast<vtkIdType>(numElements) * numNodes, connectivity))
+    {
+    vtkErrorMacro("Could not read the nodes of " << numElements
+                  << " elements.");
+    connectivity->Delete();
+    return 0;
+    }
+
+  vtkIdList *cellIds = this->GetCellIds(idx, elementType);
+  vtkIdType *nodes = connectivity->GetPointer(0);
+  vtkIdType nodeIds[20];
+  for (int i = 0; i < numElements; i++, nodes += numNodes)
+    {
+    // EnSight ids start at 1.
+    for (int j = 0; j < numNodes; j++)
+      {
+      nodeIds[j] = nodes[order ? order[j] : j] - 1;
+      }
+    cellIds->InsertNextId(output->InsertNextCell(cellType, numNodes, nodeIds));
+    }
+  connectivity->Delete();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkEnSightGoldReader::ReadElementTypeValues(vtkFloatArray* array, int idx,
+  int elementType, int firstComponent, int numComponents)
+{
+  vtkIdList *cellIds = this->GetCellIds(idx, elementType);
+  vtkIdType numCells = cellIds->GetNumberOfIds();
+  vtkFloatArray *values = vtkFloatArray::New();
+  values->SetNumberOfValues(numCells);
+  float *v = values->GetPointer(0);
+  int valid = 1;
+  for (int i = 0; valid && i < numComponents; i++)
+    {
+    valid = this->ReadNextDataValues(v, numCells);
+    for (vtkIdType j = 0; valid && j < numCells; j++)
+      {
+      array->SetComponent(cellIds->GetId(j), firstComponent + i, v[j]);
+      }
+    }
+  values->Delete();
+  return valid;
+}
+
 //----------------------------------------------------------------------------
 int vtkEnSightGoldReader::CheckForUndefOrPartial(const char *line)
 {
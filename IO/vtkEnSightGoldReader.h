@@ -40,7 +40,11 @@
 #include "vtkEnSightReader.h"
 
 
+class vtkFloatArray;
+class vtkIdTypeArray;
 class vtkMultiBlockDataSet;
+class vtkPoints;
+class vtkUnstructuredGrid;
 
 class VTK_IO_EXPORT vtkEnSightGoldReader : public vtkEnSightReader
 {
@@ -119,7 +123,8 @@ protected:
 
   // Description:
   // Read a structured part from the geometry file and create a
-  // vtkStructuredGrid output.  Return 0 if EOF reached.
+  // vtkStructuredGrid output.  Return 0 if EOF reached. Return -1 if
+  // an error occurred.
   virtual int CreateStructuredGridOutput(int partId,
     char line[256],
     const char* name,
@@ -127,7 +132,8 @@ protected:
 
   // Description:
   // Read a structured part from the geometry file and create a
-  // vtkRectilinearGrid output.  Return 0 if EOF reached.
+  // vtkRectilinearGrid output.  Return 0 if EOF reached. Return -1 if
+  // an error occurred.
   int CreateRectilinearGridOutput(int partId, char line[256], const char* name,
     vtkMultiBlockDataSet *output);
 
@@ -137,6 +143,36 @@ protected:
   int CreateImageDataOutput(int partId, char line[256], const char* name,
     vtkMultiBlockDataSet *output);
 
+  // Description:
+  // Read the coordinates of numPts points, all x, then all y and all z,
+  // after the node ids if they are listed, into points.  Returns zero if
+  // the file ends or holds something else first.
+  int ReadCoordinates(vtkPoints* points, int numPts, int nodeIdsListed);
+
+  // Description:
+  // Read numValues numbers of a section of numElements elements into
+  // values, after the element ids if they are listed.  Returns zero if the
+  // file ends or holds something else first.
+  int ReadElementValues(int numElements, vtkIdType numValues,
+    vtkIdTypeArray* values);
+
+  // Description:
+  // Read a section of elements of numNodes nodes each, whose number is on
+  // the next data line, into output as cells of type cellType, and add
+  // their ids to those of elementType.  order, if given, lists for each
+  // node of a cell the EnSight node it is.  Returns zero if the file ends
+  // or holds something else first.
+  int ReadElements(vtkUnstructuredGrid* output, int idx, int elementType,
+    int cellType, int numNodes, const int* order = 0);
+
+  // Description:
+  // Read numComponents components, one after the other, of the values of
+  // the cells of elementType in the unstructured part idx into array,
+  // starting at component firstComponent.  Returns zero if the file ends
+  // or holds something else first.
+  int ReadElementTypeValues(vtkFloatArray* array, int idx, int elementType,
+    int firstComponent, int numComponents);
+
   // Description:
   // Set/Get the Model file name.
   vtkSetStringMacro(GeometryFileName);
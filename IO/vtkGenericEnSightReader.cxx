@@ -32,6 +32,7 @@
 #include <vtkstd/map>
 #include <assert.h>
 #include <ctype.h> /* isspace */
+#include <stdlib.h> /* strtod */
 
 vtkStandardNewMacro(vtkGenericEnSightReader);
 
@@ -93,6 +94,9 @@ vtkGenericEnSightReader::vtkGenericEnSightReader()
 
   this->ParticleCoordinatesByIndex = 0;
 
+  this->NumberOfThreads = 1;
+  this->UseIndexFiles = 0;
+
   this->EnSightVersion = -1;
 
   this->PointDataArraySelection = vtkDataArraySelection::New();
@@ -730,6 +734,185 @@ int vtkGenericEnSightReader::ReadNextDataLine(char result[256])
   return value;
 }
 
+//----------------------------------------------------------------------------
+static inline int vtkGenericEnSightReaderIsEnd(char c)
+{
+  return c == 0 || isspace(static_cast<unsigned char>(c));
+}
+
+// Convert the number at p and move p past it.  Numbers with at most 15
+// significant digits and a power of ten within 22 of them are exactly
+// m * 10^e or m / 10^e in double precision, which is what strtod and
+// atof return; strtod converts the others.
+static int vtkGenericEnSightReaderConvert(const char*& p, float& value)
+{
+  static const double powers[23] =
+    { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+  const char* start = p;
+  const char* q = p;
+  int negative = (*q == '-');
+  if (*q == '-' || *q == '+')
+    {
+    ++q;
+    }
+  vtkTypeUInt64 mantissa = 0;
+  int numDigits = 0;
+  int numSignificant = 0;
+  int exponent = 0;
+  for (; *q >= '0' && *q <= '9'; ++q, ++numDigits)
+    {
+    if (numSignificant < 16)
+      {
+      mantissa = mantissa * 10 + (*q - '0');
+      numSignificant += (mantissa != 0);
+      }
+    else
+      {
+      ++exponent;
+      }
+    }
+  if (*q == '.')
+    {
+    for (++q; *q >= '0' && *q <= '9'; ++q, ++numDigits)
+      {
+      if (numSignificant < 16)
+        {
+        mantissa = mantissa * 10 + (*q - '0');
+        numSignificant += (mantissa != 0);
+        --exponent;
+        }
+      }
+    }
+  if (numDigits && (*q == 'e' || *q == 'E'))
+    {
+    const char* e = q + 1;
+    int negativeExponent = (*e == '-');
+    if (*e == '-' || *e == '+')
+      {
+      ++e;
+      }
+    if (*e >= '0' && *e <= '9')
+      {
+      int power = 0;
+      for (; *e >= '0' && *e <= '9'; ++e)
+        {
+        power = power < 10000 ? power * 10 + (*e - '0') : power;
+        }
+      exponent += negativeExponent ? -power : power;
+      q = e;
+      }
+    }
+  if (numDigits && numSignificant <= 15 && exponent >= -22 &&
+      exponent <= 22 && vtkGenericEnSightReaderIsEnd(*q))
+    {
+    double v = static_cast<double>(mantissa);
+    v = exponent < 0 ? v / powers[-exponent] : v * powers[exponent];
+    value = static_cast<float>(negative ? -v : v);
+    p = q;
+    return 1;
+    }
+
+  char* end;
+  value = static_cast<float>(strtod(start, &end));
+  p = end;
+  return end != start && vtkGenericEnSightReaderIsEnd(*end);
+}
+
+// Convert the id at p and move p past it.  The first digits can not
+// overflow a vtkIdType, the following ones are checked so that an id too
+// large for it is a read error rather than a wrapped value.
+static int vtkGenericEnSightReaderConvert(const char*& p, vtkIdType& value)
+{
+  const int safeDigits = VTK_SIZEOF_ID_TYPE == 8 ? 18 : 9;
+  const char* q = p;
+  int negative = (*q == '-');
+  if (*q == '-' || *q == '+')
+    {
+    ++q;
+    }
+  const char* digits = q;
+  vtkIdType v = 0;
+  for (; *q >= '0' && *q <= '9' && q - digits < safeDigits; ++q)
+    {
+    v = v * 10 + (*q - '0');
+    }
+  for (; *q >= '0' && *q <= '9'; ++q)
+    {
+    vtkIdType digit = *q - '0';
+    if (v > (VTK_LARGE_ID - digit) / 10)
+      {
+      return 0;
+      }
+    v = v * 10 + digit;
+    }
+  if (q == digits || !vtkGenericEnSightReaderIsEnd(*q))
+    {
+    return 0;
+    }
+  value = negative ? -v : v;
+  p = q;
+  return 1;
+}
+
+// Read lines, skipping those that start with '#', until numValues
+// numbers have been converted.
+template <class T>
+int vtkGenericEnSightReaderReadValues(istream* is, T* values,
+                                      vtkIdType numValues, int stride)
+{
+  char line[256];
+  vtkIdType i = 0;
+  while (i < numValues)
+    {
+    is->getline(line, 256);
+    if (is->fail())
+      {
+      is->clear();
+      return 0;
+      }
+    if (line[0] == '#')
+      {
+      continue;
+      }
+    const char* p = line;
+    for (; i < numValues; ++i, values += stride)
+      {
+      while (isspace(static_cast<unsigned char>(*p)))
+        {
+        ++p;
+        }
+      if (!*p)
+        {
+        break;
+        }
+      if (!vtkGenericEnSightReaderConvert(p, *values))
+        {
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkGenericEnSightReader::ReadNextDataValues(float* values,
+                                                vtkIdType numValues,
+                                                int stride)
+{
+  return vtkGenericEnSightReaderReadValues(this->IS, values, numValues,
+                                           stride);
+}
+
+//----------------------------------------------------------------------------
+int vtkGenericEnSightReader::ReadNextDataValues(vtkIdType* values,
+                                                vtkIdType numValues,
+                                                int stride)
+{
+  return vtkGenericEnSightReaderReadValues(this->IS, values, numValues,
+                                           stride);
+}
+
 //----------------------------------------------------------------------------
 int vtkGenericEnSightReader::RequestInformation(
   vtkInformation *request,
@@ -850,6 +1033,8 @@ int vtkGenericEnSightReader::RequestInformation(
   this->Reader->SetByteOrder(this->ByteOrder);
   this->Reader->RequestInformation(request, inputVector, outputVector);
   this->Reader->SetParticleCoordinatesByIndex(this->ParticleCoordinatesByIndex);
+  this->Reader->SetNumberOfThreads(this->NumberOfThreads);
+  this->Reader->SetUseIndexFiles(this->UseIndexFiles);
 
   this->SetTimeSets(this->Reader->GetTimeSets());
   if(!this->TimeValueInitialized)
@@ -1460,6 +1645,8 @@ void vtkGenericEnSightReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ReadAllVariables: " << this->ReadAllVariables << endl;
   os << indent << "ByteOrder: " << this->ByteOrder << endl;
   os << indent << "ParticleCoordinatesByIndex: " << this->ParticleCoordinatesByIndex << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+  os << indent << "UseIndexFiles: " << this->UseIndexFiles << endl;
   os << indent << "CellDataArraySelection: " << this->CellDataArraySelection
      << endl;
   os << indent << "PointDataArraySelection: " << this->PointDataArraySelection
@@ -214,6 +214,24 @@ public:
   vtkGetMacro(ParticleCoordinatesByIndex, int);
   vtkBooleanMacro(ParticleCoordinatesByIndex, int);
 
+  // Description:
+  // Get/Set the number of threads used to read the parts of EnSight Gold
+  // binary geometry files.  With more than one thread, the parts are
+  // indexed once per file and read concurrently.  Other files are read
+  // with one thread.  The default is 1.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // Keep the offsets of the time steps and parts of EnSight Gold binary
+  // files in index files next to them, so that changing time step seeks
+  // to the data instead of scanning the files again, also in later
+  // sessions.  The index files must be writable to be created; they are
+  // ignored once the files they describe change.  Off by default.
+  vtkSetMacro(UseIndexFiles, int);
+  vtkGetMacro(UseIndexFiles, int);
+  vtkBooleanMacro(UseIndexFiles, int);
+
   // Description:
   // Returns true if the file pointed to by casefilename appears to be a
   // valid EnSight case file.
@@ -250,6 +268,17 @@ protected:
   // Returns 0 is there was an error.
   int ReadNextDataLine(char result[256]);
 
+  // Description:
+  // Internal functions that read numValues whitespace separated numbers
+  // from an ascii file, skipping comment lines, and store them stride
+  // values apart.  They convert all the numbers of each line they read,
+  // as atof and atol would, so the values must end a line.  Returns zero
+  // if the file ends or holds anything but a number first, or an id too
+  // large for a vtkIdType.
+  int ReadNextDataValues(float* values, vtkIdType numValues, int stride = 1);
+  int ReadNextDataValues(vtkIdType* values, vtkIdType numValues,
+                         int stride = 1);
+
   // Description:
   // Set the geometry file name.
   vtkSetStringMacro(GeometryFileName);
@@ -338,6 +367,8 @@ protected:
 
   int ByteOrder;
   int ParticleCoordinatesByIndex;
+  int NumberOfThreads;
+  int UseIndexFiles;
 
   // The EnSight file version being read.  Valid after
   // UpdateInformation.  Value is -1 for unknown version.
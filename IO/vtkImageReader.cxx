@@ -19,6 +19,7 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -273,6 +274,20 @@ void vtkImageReaderUpdate2(vtkImageReader *self, vtkImageData *data,
       return;
       }
     }
+  // with the file mapped, the rows are copied from where the file was
+  // opened and sought to, without moving the stream
+  vtkTypeUInt64 fileStart = 0;
+  long rowStep = static_cast<long>(self->GetDataIncrements()[1]);
+  if (!self->GetFileLowerLeft())
+    {
+    rowStep = -rowStep;
+    }
+  int mapped = 0;
+  if (self->GetFileDimensionality() == 3 && self->GetMappedData(0, 0))
+    {
+    mapped = 1;
+    fileStart = static_cast<vtkTypeUInt64>(self->GetFile()->tellg());
+    }
   for (idx2 = dataExtent[4]; idx2 <= dataExtent[5]; ++idx2)
     {
     if (self->GetFileDimensionality() == 2)
@@ -282,6 +297,17 @@ void vtkImageReaderUpdate2(vtkImageReader *self, vtkImageData *data,
         delete [] buf;
         return;
         }
+      mapped = (self->GetMappedData(0, 0) != NULL);
+      if (mapped)
+        {
+        fileStart = static_cast<vtkTypeUInt64>(self->GetFile()->tellg());
+        }
+      }
+    vtkTypeUInt64 sliceStart = fileStart;
+    if (self->GetFileDimensionality() == 3)
+      {
+      sliceStart += static_cast<vtkTypeUInt64>(idx2 - dataExtent[4]) *
+        self->GetDataIncrements()[2];
       }
     outPtr1 = outPtr2;
     for (idx1 = dataExtent[2]; 
@@ -294,14 +320,33 @@ void vtkImageReaderUpdate2(vtkImageReader *self, vtkImageData *data,
       count++;
       outPtr0 = outPtr1;
 
-      // read the row.
-      self->GetFile()->read((char *)buf, streamRead);
+      if (mapped)
+        {
+        // copy the row.
+        const char *row = self->GetMappedData(
+          sliceStart + (idx1 - dataExtent[2])*rowStep, streamRead);
+        if (!row)
+          {
+          vtkGenericWarningMacro("Mapped file too short. row = " << idx1
+                                 << ", Tried to Read = " << streamRead);
+          delete [] buf;
+          return;
+          }
+        memcpy(buf, row, streamRead);
+        }
+      else
+        {
+        // read the row.
+        self->GetFile()->read((char *)buf, streamRead);
+        }
 #ifdef __APPLE_CC__
-      if (static_cast<unsigned long>(self->GetFile()->gcount()) != streamRead)
+      if (!mapped &&
+          static_cast<unsigned long>(self->GetFile()->gcount()) != streamRead)
       // Apple's gcc3 returns fail when reading _to_ eof
 #else
-      if ( static_cast<unsigned long>(self->GetFile()->gcount()) != 
-           streamRead || self->GetFile()->fail())
+      if ( !mapped &&
+           (static_cast<unsigned long>(self->GetFile()->gcount()) != 
+            streamRead || self->GetFile()->fail()))
 #endif
         {
         vtkGenericWarningMacro("File operation failed. row = " << idx1
@@ -344,6 +389,12 @@ void vtkImageReaderUpdate2(vtkImageReader *self, vtkImageData *data,
         outPtr0 += outIncr[0];
         }
 
+      outPtr1 += outIncr[1];
+      if (mapped)
+        {
+        continue;
+        }
+
       // move to the next row in the file and data
       filePos = self->GetFile()->tellg();
 
@@ -381,11 +432,13 @@ void vtkImageReaderUpdate2(vtkImageReader *self, vtkImageData *data,
         {
         correction = streamSkip0;
         }
-      outPtr1 += outIncr[1];
       }
     // move to the next image in the file and data
-    self->GetFile()->seekg(static_cast<long>(self->GetFile()->tellg()) + streamSkip1 + correction, 
-                      ios::beg);
+    if (!mapped)
+      {
+      self->GetFile()->seekg(static_cast<long>(self->GetFile()->tellg()) + streamSkip1 + correction, 
+                        ios::beg);
+      }
     outPtr2 += outIncr[2];
     }
 
@@ -417,7 +470,8 @@ void vtkImageReaderUpdate1(vtkImageReader *self, vtkImageData *data, T *inPtr)
 // are assumed to be the same as the file extent/order.
 void vtkImageReader::ExecuteData(vtkDataObject *output)
 {
-  vtkImageData *data = this->AllocateOutputData(output);
+  this->ReleaseMappedData(output);
+  vtkImageData *data = vtkImageData::SafeDownCast(output);
   
   void *ptr = NULL;
   int *ext;
@@ -428,17 +482,42 @@ void vtkImageReader::ExecuteData(vtkDataObject *output)
     return;
     }
 
+  // The scalars are only allocated if they can not point into the mapped
+  // file.
+  data->SetExtent(data->GetUpdateExtent());
   ext = data->GetExtent();
-  if (!data->GetPointData()->GetScalars())
-    {
-    return;
-    }
-  data->GetPointData()->GetScalars()->SetName(this->ScalarArrayName);
 
   vtkDebugMacro("Reading extent: " << ext[0] << ", " << ext[1] << ", " 
         << ext[2] << ", " << ext[3] << ", " << ext[4] << ", " << ext[5]);
   
   this->ComputeDataIncrements();
+
+  // point the scalars into the mapped file instead of reading it when
+  // the extent lies there as is
+  if (this->MemoryMapping && !this->Transform &&
+      this->DataMask == static_cast<vtkTypeUInt64>(~0UL))
+    {
+    int inExtent[6], dataExtent[6];
+    data->GetExtent(inExtent);
+    this->ComputeInverseTransformedExtent(inExtent, dataExtent);
+    if ((this->FileDimensionality == 3 || dataExtent[4] == dataExtent[5]) &&
+        this->OpenAndSeekFile(dataExtent,
+          this->FileDimensionality == 3 ? 0 : dataExtent[4]) &&
+        this->GetMappedData(0, 0) &&
+        this->AliasMappedData(data, dataExtent,
+          static_cast<vtkTypeUInt64>(this->File->tellg())))
+      {
+      data->GetPointData()->GetScalars()->SetName(this->ScalarArrayName);
+      return;
+      }
+    }
+
+  data->AllocateScalars();
+  if (!data->GetPointData()->GetScalars())
+    {
+    return;
+    }
+  data->GetPointData()->GetScalars()->SetName(this->ScalarArrayName);
   
   // Call the correct templated function for the output
   switch (this->GetDataScalarType())
@@ -447,6 +526,11 @@ void vtkImageReader::ExecuteData(vtkDataObject *output)
     default:
       vtkErrorMacro(<< "UpdateFromFile: Unknown data type");
     }   
+
+  if (this->MappedFile)
+    {
+    this->MappedFile->Close();
+    }
 }
 
 
@@ -19,6 +19,7 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -68,6 +69,9 @@ vtkImageReader2::vtkImageReader2()
   this->FileNameSliceOffset = 0;
   this->FileNameSliceSpacing = 1;
 
+  this->MemoryMapping = 0;
+  this->MappedFile = NULL;
+
   // Left over from short reader
   this->SwapBytes = 0;
   this->FileLowerLeft = 0;
@@ -84,6 +88,11 @@ vtkImageReader2::~vtkImageReader2()
     delete this->File;
     this->File = NULL;
     }
+  if (this->MappedFile)
+    {
+    this->MappedFile->Delete();
+    this->MappedFile = NULL;
+    }
   
   if (this->FileNames)
     {
@@ -452,6 +461,9 @@ void vtkImageReader2::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Swap Bytes: " << (this->SwapBytes ? "On\n" : "Off\n");
 
+  os << indent << "Memory Mapping: "
+     << (this->MemoryMapping ? "On\n" : "Off\n");
+
   os << indent << "DataIncrements: (" << this->DataIncrements[0];
   for (idx = 1; idx < 2; ++idx)
     {
@@ -618,9 +630,101 @@ int vtkImageReader2::OpenFile()
                   << this->InternalFileName);
     return 0;
     }
+
+  // Map the file as well; the stream is used when that fails.
+  if (this->MemoryMapping && vtkMemoryMappedFile::IsSupported())
+    {
+    if (!this->MappedFile)
+      {
+      this->MappedFile = vtkMemoryMappedFile::New();
+      }
+    if (!this->MappedFile->Open(this->InternalFileName))
+      {
+      vtkDebugMacro(<< "Could not map file " << this->InternalFileName
+                    << ", reading it instead.");
+      }
+    }
+  else if (this->MappedFile)
+    {
+    this->MappedFile->Close();
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+const char *vtkImageReader2::GetMappedData(vtkTypeUInt64 offset,
+                                           vtkTypeUInt64 length)
+{
+  if (!this->MappedFile || !this->MappedFile->GetData() ||
+      offset > this->MappedFile->GetSize() ||
+      length > this->MappedFile->GetSize() - offset)
+    {
+    return NULL;
+    }
+  return this->MappedFile->GetData() + offset;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageReader2::AliasMappedData(vtkImageData *data, int dataExtent[6],
+                                     vtkTypeUInt64 offset)
+{
+  int numComponents = data->GetNumberOfScalarComponents();
+  int typeSize = vtkDataArray::GetDataTypeSize(this->DataScalarType);
+  if (data->GetScalarType() != this->DataScalarType ||
+      (this->SwapBytes && typeSize > 1))
+    {
+    return 0;
+    }
+
+  // The extent must be a single block of the file, with its rows in the
+  // order of the output.
+  int oneRow = (dataExtent[2] == dataExtent[3]);
+  int oneSlice = (dataExtent[4] == dataExtent[5]);
+  int fullRows = (dataExtent[0] == this->DataExtent[0] &&
+                  dataExtent[1] == this->DataExtent[1]);
+  int fullSlices = (fullRows && dataExtent[2] == this->DataExtent[2] &&
+                    dataExtent[3] == this->DataExtent[3]);
+  if (!(fullRows || (oneRow && oneSlice)) || !(fullSlices || oneSlice) ||
+      !(this->FileLowerLeft || oneRow) ||
+      !(this->FileDimensionality >= 3 || oneSlice))
+    {
+    return 0;
+    }
+
+  // The scalars may only point at aligned values.
+  vtkTypeUInt64 length = static_cast<vtkTypeUInt64>(data->GetNumberOfPoints())
+    * numComponents * typeSize;
+  const char *ptr = this->GetMappedData(offset, length);
+  if (!ptr || offset % typeSize)
+    {
+    return 0;
+    }
+
+  vtkDataArray *mapped = vtkDataArray::CreateDataArray(this->DataScalarType);
+  mapped->SetNumberOfComponents(numComponents);
+  mapped->SetVoidArray(const_cast<char *>(ptr),
+    data->GetNumberOfPoints() * numComponents, 1);
+  this->MappedFile->AttachToArray(mapped);
+  data->GetPointData()->SetScalars(mapped);
+  mapped->Delete();
+
+  // The array owns the mapping now; the next file gets a new one.
+  this->MappedFile->Delete();
+  this->MappedFile = NULL;
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkImageReader2::ReleaseMappedData(vtkDataObject *output)
+{
+  vtkImageData *data = vtkImageData::SafeDownCast(output);
+  if (data &&
+      vtkMemoryMappedFile::IsAttachedTo(data->GetPointData()->GetScalars()))
+    {
+    data->GetPointData()->Initialize();
+    }
+}
+
 
 //----------------------------------------------------------------------------
 unsigned long vtkImageReader2::GetHeaderSize()
@@ -760,6 +864,20 @@ void vtkImageReader2Update(vtkImageReader2 *self, vtkImageData *data, OT *outPtr
         return;
         }
       }
+    // with the file mapped, find where the slice starts and copy the rows
+    // from there
+    vtkTypeUInt64 sliceStart = 0;
+    long rowStep = static_cast<long>(self->GetDataIncrements()[1]);
+    int mapped = (self->GetMappedData(0, 0) != NULL);
+    if (mapped)
+      {
+      self->SeekFile(outExtent[0],outExtent[2],idx2);
+      sliceStart = static_cast<vtkTypeUInt64>(self->GetFile()->tellg());
+      if (!self->GetFileLowerLeft())
+        {
+        rowStep = -rowStep;
+        }
+      }
     outPtr1 = outPtr2;
     for (idx1 = outExtent[2]; 
          !self->AbortExecute && idx1 <= outExtent[3]; ++idx1)
@@ -769,11 +887,24 @@ void vtkImageReader2Update(vtkImageReader2 *self, vtkImageData *data, OT *outPtr
         self->UpdateProgress(count/(50.0*target));
         }
       count++;
-      
-      // seek to the correct row
-      self->SeekFile(outExtent[0],idx1,idx2);
+
+      const char *row = NULL;
+      if (mapped)
+        {
+        row = self->GetMappedData(sliceStart + (idx1 - outExtent[2])*rowStep,
+                                  streamRead);
+        }
+      if (row)
+        {
+        memcpy(outPtr1, row, streamRead);
+        }
+      else
+        {
+        // seek to the correct row
+        self->SeekFile(outExtent[0],idx1,idx2);
+        }
       // read the row.
-      if ( !self->GetFile()->read((char *)outPtr1, streamRead))
+      if ( !row && !self->GetFile()->read((char *)outPtr1, streamRead))
         {
         vtkGenericWarningMacro("File operation failed. row = " << idx1
                                << ", Read = " << streamRead
@@ -797,7 +928,8 @@ void vtkImageReader2Update(vtkImageReader2 *self, vtkImageData *data, OT *outPtr
 // are assumed to be the same as the file extent/order.
 void vtkImageReader2::ExecuteData(vtkDataObject *output)
 {
-  vtkImageData *data = this->AllocateOutputData(output);
+  this->ReleaseMappedData(output);
+  vtkImageData *data = vtkImageData::SafeDownCast(output);
   
   void *ptr;
   int *ext;
@@ -808,14 +940,37 @@ void vtkImageReader2::ExecuteData(vtkDataObject *output)
     return;
     }
 
+  // The scalars are only allocated if they can not point into the mapped
+  // file.
+  data->SetExtent(data->GetUpdateExtent());
   ext = data->GetExtent();
 
-  data->GetPointData()->GetScalars()->SetName("ImageFile");
-
   vtkDebugMacro("Reading extent: " << ext[0] << ", " << ext[1] << ", " 
         << ext[2] << ", " << ext[3] << ", " << ext[4] << ", " << ext[5]);
   
   this->ComputeDataIncrements();
+
+  // point the scalars into the mapped file instead of reading it when
+  // the extent lies there as is
+  if (this->MemoryMapping &&
+      (this->FileDimensionality == 3 || ext[4] == ext[5]))
+    {
+    this->ComputeInternalFileName(
+      this->FileDimensionality == 3 ? 0 : ext[4]);
+    if (this->OpenFile() && this->GetMappedData(0, 0))
+      {
+      this->SeekFile(ext[0], ext[2], ext[4]);
+      if (this->File->good() && this->AliasMappedData(data, ext,
+            static_cast<vtkTypeUInt64>(this->File->tellg())))
+        {
+        data->GetPointData()->GetScalars()->SetName("ImageFile");
+        return;
+        }
+      }
+    }
+
+  data->AllocateScalars();
+  data->GetPointData()->GetScalars()->SetName("ImageFile");
   
   // Call the correct templated function for the output
   ptr = data->GetScalarPointer();
@@ -825,6 +980,11 @@ void vtkImageReader2::ExecuteData(vtkDataObject *output)
     default:
       vtkErrorMacro(<< "UpdateFromFile: Unknown data type");
     }   
+
+  if (this->MappedFile)
+    {
+    this->MappedFile->Close();
+    }
 }
 
 
@@ -28,6 +28,8 @@
 
 #include "vtkImageAlgorithm.h"
 
+class vtkImageData;
+class vtkMemoryMappedFile;
 class vtkStringArray;
 
 #define VTK_FILE_BYTE_ORDER_BIG_ENDIAN 0
@@ -174,6 +176,24 @@ public:
   virtual int OpenFile();
   virtual void SeekFile(int i, int j, int k);
 
+  // Description:
+  // Set/Get whether the file is mapped into memory when it is opened.
+  // The rows are then copied straight out of the mapping, and when the
+  // requested extent is stored contiguously in a single file, in the
+  // output scalar type and byte order, the output scalars point into the
+  // mapping and nothing is read at all.  Falls back to reading the file
+  // when it cannot be mapped.  Off by default.
+  vtkSetMacro(MemoryMapping,int);
+  vtkGetMacro(MemoryMapping,int);
+  vtkBooleanMacro(MemoryMapping,int);
+
+//BTX
+  // Description:
+  // Return the length bytes at the given offset of the file mapped by
+  // OpenFile(), or NULL when the file is not mapped or is too short.
+  const char *GetMappedData(vtkTypeUInt64 offset, vtkTypeUInt64 length);
+//ETX
+
   // Description:
   // Set/Get whether the data comes from the file starting in the lower left
   // corner or upper left corner.
@@ -242,6 +262,23 @@ protected:
 
   int FileNameSliceOffset;
   int FileNameSliceSpacing;
+
+  int MemoryMapping;
+  vtkMemoryMappedFile *MappedFile;
+
+  // Description:
+  // Give data, which has its extent but no scalars yet, scalars that
+  // point into the mapped file, where dataExtent of the file starts at
+  // offset, if they are stored there contiguously with the scalar type of
+  // data and in its byte order.  Returns 0, leaving data unchanged,
+  // otherwise.
+  int AliasMappedData(vtkImageData *data, int dataExtent[6],
+                      vtkTypeUInt64 offset);
+
+  // Description:
+  // Remove scalars that point into a mapped file from the output, so
+  // that the update about to run does not read into them.
+  void ReleaseMappedData(vtkDataObject *output);
   
   virtual int RequestInformation(vtkInformation* request,
                                  vtkInformationVector** inputVector,
@@ -0,0 +1,317 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLZ4DataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLZ4DataCompressor.h"
+#include "vtkObjectFactory.h"
+
+#include <string.h>
+
+vtkStandardNewMacro(vtkLZ4DataCompressor);
+
+// A block is a list of sequences, each made of a token byte holding the
+// number of literals and the length of the match in its high and low
+// nibbles (15 meaning that more length bytes follow), the literals, and
+// the little endian distance back to the match.  The last sequence has
+// literals only.  Matches are at least 4 bytes long, the last 5 bytes of
+// a block are always literals, and no match starts in its last 12 bytes.
+#define VTK_LZ4_MIN_MATCH 4
+#define VTK_LZ4_LAST_LITERALS 5
+#define VTK_LZ4_MATCH_FIND_LIMIT 12
+#define VTK_LZ4_MAX_DISTANCE 65535
+#define VTK_LZ4_HASH_LOG 12
+#define VTK_LZ4_SKIP_TRIGGER 6
+
+//----------------------------------------------------------------------------
+static inline vtkTypeUInt32 vtkLZ4Read32(const unsigned char* p)
+{
+  vtkTypeUInt32 value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+//----------------------------------------------------------------------------
+static inline unsigned int vtkLZ4Hash(const unsigned char* p)
+{
+  return static_cast<vtkTypeUInt32>(vtkLZ4Read32(p) * 2654435761U) >>
+    (32 - VTK_LZ4_HASH_LOG);
+}
+
+//----------------------------------------------------------------------------
+// Write the part of a length above the 15 held by a token.
+static inline unsigned char* vtkLZ4WriteLength(unsigned char* op,
+                                               unsigned long length)
+{
+  for(; length >= 255; length -= 255)
+    {
+    *op++ = 255;
+    }
+  *op++ = static_cast<unsigned char>(length);
+  return op;
+}
+
+//----------------------------------------------------------------------------
+// Read the part of a length above the 15 held by a token.  Returns 0 if
+// the length runs past the end of the input.
+static inline int vtkLZ4ReadLength(const unsigned char*& ip,
+                                   const unsigned char* iend,
+                                   unsigned long& length)
+{
+  unsigned char s;
+  do
+    {
+    if(ip >= iend)
+      {
+      return 0;
+      }
+    s = *ip++;
+    length += s;
+    }
+  while(s == 255);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkLZ4DataCompressor::vtkLZ4DataCompressor()
+{
+  this->AccelerationLevel = 1;
+}
+
+//----------------------------------------------------------------------------
+vtkLZ4DataCompressor::~vtkLZ4DataCompressor()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkLZ4DataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "AccelerationLevel: " << this->AccelerationLevel << endl;
+}
+
+//----------------------------------------------------------------------------
+unsigned long
+vtkLZ4DataCompressor::CompressBuffer(const unsigned char* uncompressedData,
+                                     unsigned long uncompressedSize,
+                                     unsigned char* compressedData,
+                                     unsigned long compressionSpace)
+{
+  if(compressionSpace < this->GetMaximumCompressionSpace(uncompressedSize))
+    {
+    vtkErrorMacro("LZ4 compression needs " <<
+                  this->GetMaximumCompressionSpace(uncompressedSize) <<
+                  " bytes of output space, only " << compressionSpace <<
+                  " given.");
+    return 0;
+    }
+
+  const unsigned char* const src = uncompressedData;
+  const unsigned char* const iend = src + uncompressedSize;
+  const unsigned char* ip = src;
+  const unsigned char* anchor = src;
+  unsigned char* op = compressedData;
+
+  if(uncompressedSize > VTK_LZ4_MATCH_FIND_LIMIT)
+    {
+    const unsigned char* const mflimit = iend - VTK_LZ4_MATCH_FIND_LIMIT;
+    const unsigned char* const matchlimit = iend - VTK_LZ4_LAST_LITERALS;
+
+    // The last position seen with each hash of its first 4 bytes.
+    vtkTypeUInt32 table[1 << VTK_LZ4_HASH_LOG];
+    memset(table, 0, sizeof(table));
+    ++ip;
+
+    while(ip <= mflimit)
+      {
+      // Look for a match, stepping faster over data that does not match.
+      const unsigned char* match = 0;
+      unsigned int search = this->AccelerationLevel << VTK_LZ4_SKIP_TRIGGER;
+      while(ip <= mflimit)
+        {
+        unsigned int h = vtkLZ4Hash(ip);
+        const unsigned char* candidate = src + table[h];
+        table[h] = static_cast<vtkTypeUInt32>(ip - src);
+        if(ip - candidate <= VTK_LZ4_MAX_DISTANCE &&
+           vtkLZ4Read32(candidate) == vtkLZ4Read32(ip))
+          {
+          match = candidate;
+          break;
+          }
+        ip += search++ >> VTK_LZ4_SKIP_TRIGGER;
+        }
+      if(!match)
+        {
+        break;
+        }
+
+      // Extend the match backward over the pending literals and forward.
+      while(ip > anchor && match > src && ip[-1] == match[-1])
+        {
+        --ip;
+        --match;
+        }
+      const unsigned char* end = ip + VTK_LZ4_MIN_MATCH;
+      const unsigned char* ref = match + VTK_LZ4_MIN_MATCH;
+      while(end < matchlimit && *end == *ref)
+        {
+        ++end;
+        ++ref;
+        }
+
+      // Write the sequence.
+      unsigned long literals = static_cast<unsigned long>(ip - anchor);
+      unsigned long matchLength =
+        static_cast<unsigned long>(end - ip) - VTK_LZ4_MIN_MATCH;
+      unsigned long distance = static_cast<unsigned long>(ip - match);
+      unsigned char* token = op++;
+      *token = static_cast<unsigned char>(
+        ((literals < 15 ? literals : 15) << 4) |
+        (matchLength < 15 ? matchLength : 15));
+      if(literals >= 15)
+        {
+        op = vtkLZ4WriteLength(op, literals - 15);
+        }
+      memcpy(op, anchor, literals);
+      op += literals;
+      *op++ = static_cast<unsigned char>(distance & 0xff);
+      *op++ = static_cast<unsigned char>(distance >> 8);
+      if(matchLength >= 15)
+        {
+        op = vtkLZ4WriteLength(op, matchLength - 15);
+        }
+
+      ip = anchor = end;
+      if(ip <= mflimit)
+        {
+        table[vtkLZ4Hash(ip - 2)] = static_cast<vtkTypeUInt32>(ip - 2 - src);
+        }
+      }
+    }
+
+  // Write the last literals.
+  unsigned long literals = static_cast<unsigned long>(iend - anchor);
+  *op++ = static_cast<unsigned char>((literals < 15 ? literals : 15) << 4);
+  if(literals >= 15)
+    {
+    op = vtkLZ4WriteLength(op, literals - 15);
+    }
+  memcpy(op, anchor, literals);
+  op += literals;
+
+  return static_cast<unsigned long>(op - compressedData);
+}
+
+//----------------------------------------------------------------------------
+unsigned long
+vtkLZ4DataCompressor::UncompressBuffer(const unsigned char* compressedData,
+                                       unsigned long compressedSize,
+                                       unsigned char* uncompressedData,
+                                       unsigned long uncompressedSize)
+{
+  const unsigned char* ip = compressedData;
+  const unsigned char* const iend = ip + compressedSize;
+  unsigned char* op = uncompressedData;
+  unsigned char* const oend = op + uncompressedSize;
+  int valid = 1;
+
+  while(valid && ip < iend)
+    {
+    unsigned char token = *ip++;
+
+    // Copy the literals.
+    unsigned long literals = token >> 4;
+    if(literals == 15 && !vtkLZ4ReadLength(ip, iend, literals))
+      {
+      valid = 0;
+      break;
+      }
+    if(literals > static_cast<unsigned long>(iend - ip) ||
+       literals > static_cast<unsigned long>(oend - op))
+      {
+      valid = 0;
+      break;
+      }
+    memcpy(op, ip, literals);
+    op += literals;
+    ip += literals;
+
+    // The last sequence has no match.
+    if(ip == iend)
+      {
+      break;
+      }
+
+    // Copy the match, which may overlap the bytes it produces.
+    if(iend - ip < 2)
+      {
+      valid = 0;
+      break;
+      }
+    unsigned long distance = ip[0] | (static_cast<unsigned long>(ip[1]) << 8);
+    ip += 2;
+    unsigned long matchLength = token & 15;
+    if(matchLength == 15 && !vtkLZ4ReadLength(ip, iend, matchLength))
+      {
+      valid = 0;
+      break;
+      }
+    matchLength += VTK_LZ4_MIN_MATCH;
+    if(distance == 0 ||
+       distance > static_cast<unsigned long>(op - uncompressedData) ||
+       matchLength > static_cast<unsigned long>(oend - op))
+      {
+      valid = 0;
+      break;
+      }
+    const unsigned char* ref = op - distance;
+    if(distance >= matchLength)
+      {
+      memcpy(op, ref, matchLength);
+      op += matchLength;
+      }
+    else
+      {
+      for(unsigned long i = 0; i < matchLength; ++i)
+        {
+        *op++ = *ref++;
+        }
+      }
+    }
+
+  if(!valid)
+    {
+    vtkErrorMacro("LZ4 error while uncompressing data.");
+    return 0;
+    }
+
+  // Make sure the output size matched that expected.
+  unsigned long decSize = static_cast<unsigned long>(op - uncompressedData);
+  if(decSize != uncompressedSize)
+    {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected " << uncompressedSize << " and got " << decSize);
+    return 0;
+    }
+
+  return decSize;
+}
+
+//----------------------------------------------------------------------------
+unsigned long
+vtkLZ4DataCompressor::GetMaximumCompressionSpace(unsigned long size)
+{
+  // Incompressible data grows by one length byte per 255 literals, plus
+  // the token.
+  return size + size/255 + 16;
+}
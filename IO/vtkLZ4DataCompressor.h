@@ -0,0 +1,72 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLZ4DataCompressor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkLZ4DataCompressor - Fast data compression in the LZ4 format.
+// .SECTION Description
+// vtkLZ4DataCompressor provides a concrete vtkDataCompressor class
+// that writes and reads LZ4 blocks.  LZ4 compresses much less than zlib
+// but many times faster, and uncompresses faster still, which suits
+// large checkpoint-style files that would otherwise be written at the
+// speed of the compressor rather than that of the disk.  The blocks are
+// produced by the built in implementation of the block format, so no
+// LZ4 library is needed; any LZ4 implementation can read them.
+
+#ifndef __vtkLZ4DataCompressor_h
+#define __vtkLZ4DataCompressor_h
+
+#include "vtkDataCompressor.h"
+
+class VTK_IO_EXPORT vtkLZ4DataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkLZ4DataCompressor,vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent);
+  static vtkLZ4DataCompressor* New();
+
+  // Description:
+  // Get the maximum space that may be needed to store data of the
+  // given uncompressed size after compression.  This is the minimum
+  // size of the output buffer that can be passed to the four-argument
+  // Compress method.
+  unsigned long GetMaximumCompressionSpace(unsigned long size);
+
+  // Description:
+  // Get/Set the acceleration level.  Higher levels search fewer
+  // positions for matches, trading compression ratio for speed.  The
+  // default, 1, searches the most.
+  vtkSetClampMacro(AccelerationLevel, int, 1, 64);
+  vtkGetMacro(AccelerationLevel, int);
+
+protected:
+  vtkLZ4DataCompressor();
+  ~vtkLZ4DataCompressor();
+
+  int AccelerationLevel;
+
+  // Compression method required by vtkDataCompressor.
+  unsigned long CompressBuffer(const unsigned char* uncompressedData,
+                               unsigned long uncompressedSize,
+                               unsigned char* compressedData,
+                               unsigned long compressionSpace);
+  // Decompression method required by vtkDataCompressor.
+  unsigned long UncompressBuffer(const unsigned char* compressedData,
+                                 unsigned long compressedSize,
+                                 unsigned char* uncompressedData,
+                                 unsigned long uncompressedSize);
+private:
+  vtkLZ4DataCompressor(const vtkLZ4DataCompressor&);  // Not implemented.
+  void operator=(const vtkLZ4DataCompressor&);  // Not implemented.
+};
+
+#endif
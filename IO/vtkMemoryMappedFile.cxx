@@ -0,0 +1,170 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMappedFile.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryMappedFile.h"
+
+#include "vtkAbstractArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationObjectBaseKey.h"
+#include "vtkObjectFactory.h"
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+# define VTK_MEMORY_MAPPED_FILE_WIN32
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+vtkStandardNewMacro(vtkMemoryMappedFile);
+
+vtkInformationKeyMacro(vtkMemoryMappedFile, MAPPED_FILE, ObjectBase);
+
+//----------------------------------------------------------------------------
+vtkMemoryMappedFile::vtkMemoryMappedFile()
+{
+  this->FileName = NULL;
+  this->Data = NULL;
+  this->Size = 0;
+  this->FileHandle = NULL;
+  this->MappingHandle = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryMappedFile::~vtkMemoryMappedFile()
+{
+  this->Close();
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryMappedFile::IsSupported()
+{
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryMappedFile::Open(const char *fileName)
+{
+  this->Close();
+  if (!fileName)
+    {
+    return 0;
+    }
+
+#ifdef VTK_MEMORY_MAPPED_FILE_WIN32
+  HANDLE file = CreateFile(fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    {
+    return 0;
+    }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+    CloseHandle(file);
+    return 0;
+    }
+  // A copy on write view may be written without a writable file.
+  HANDLE mapping = CreateFileMapping(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+  if (!mapping)
+    {
+    CloseHandle(file);
+    return 0;
+    }
+  void *data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+  if (!data)
+    {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return 0;
+    }
+  this->FileHandle = file;
+  this->MappingHandle = mapping;
+  this->Size = static_cast<vtkTypeUInt64>(size.QuadPart);
+#else
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+    {
+    return 0;
+    }
+  struct stat fs;
+  if (fstat(fd, &fs) || fs.st_size <= 0)
+    {
+    close(fd);
+    return 0;
+    }
+  size_t size = static_cast<size_t>(fs.st_size);
+  void *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  // The mapping holds its own reference to the file.
+  close(fd);
+  if (data == MAP_FAILED)
+    {
+    return 0;
+    }
+  this->Size = static_cast<vtkTypeUInt64>(size);
+#endif
+
+  this->Data = static_cast<char *>(data);
+  this->SetFileName(fileName);
+  vtkDebugMacro("Mapped " << this->Size << " bytes of " << fileName);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryMappedFile::Close()
+{
+  if (this->Data)
+    {
+#ifdef VTK_MEMORY_MAPPED_FILE_WIN32
+    UnmapViewOfFile(this->Data);
+    CloseHandle(static_cast<HANDLE>(this->MappingHandle));
+    CloseHandle(static_cast<HANDLE>(this->FileHandle));
+#else
+    munmap(this->Data, static_cast<size_t>(this->Size));
+#endif
+    }
+  this->Data = NULL;
+  this->Size = 0;
+  this->FileHandle = NULL;
+  this->MappingHandle = NULL;
+  this->SetFileName(NULL);
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryMappedFile::AttachToArray(vtkAbstractArray *array)
+{
+  if (array)
+    {
+    array->GetInformation()->Set(vtkMemoryMappedFile::MAPPED_FILE(), this);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryMappedFile::IsAttachedTo(vtkAbstractArray *array)
+{
+  return array && array->HasInformation() &&
+    array->GetInformation()->Has(vtkMemoryMappedFile::MAPPED_FILE());
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryMappedFile::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "FileName: "
+     << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "Size: " << this->Size << "\n";
+}
@@ -0,0 +1,101 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMappedFile.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMemoryMappedFile - Maps a whole file into memory.
+// .SECTION Description
+// vtkMemoryMappedFile maps the contents of a file into the address space
+// of the process so that readers can take the bytes of the file straight
+// out of memory instead of reading them through a stream.  The mapping is
+// private: its pages may be written, which byte swapping in place
+// requires, but the changes never reach the file.
+//
+// A data array can point into the mapping through SetVoidArray(), with
+// its save argument set to 1 so that the array never frees the memory.
+// AttachToArray() then keeps the mapping alive for as long as the array
+// exists, by storing it in the information of the array.
+
+#ifndef __vtkMemoryMappedFile_h
+#define __vtkMemoryMappedFile_h
+
+#include "vtkObject.h"
+
+class vtkAbstractArray;
+class vtkInformationObjectBaseKey;
+
+class VTK_IO_EXPORT vtkMemoryMappedFile : public vtkObject
+{
+public:
+  static vtkMemoryMappedFile *New();
+  vtkTypeMacro(vtkMemoryMappedFile,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Map the named file, unmapping any file mapped before.  Returns 1 for
+  // success, 0 when the file cannot be opened or mapped.  Empty files
+  // cannot be mapped.
+  int Open(const char *fileName);
+
+  // Description:
+  // Unmap the file.
+  void Close();
+
+  // Description:
+  // Get the name of the mapped file, NULL when no file is mapped.
+  vtkGetStringMacro(FileName);
+
+  // Description:
+  // Return 1 when files can be mapped on this platform.
+  static int IsSupported();
+
+  //BTX
+  // Description:
+  // Get the first byte of the mapped file, NULL when no file is mapped,
+  // and the size of the mapped file in bytes.
+  char *GetData() { return this->Data; }
+  vtkTypeUInt64 GetSize() { return this->Size; }
+
+  // Description:
+  // Keep this mapping alive for as long as the array exists.  The array
+  // is expected to point into the mapping.
+  void AttachToArray(vtkAbstractArray *array);
+
+  // Description:
+  // Return 1 when a mapping is attached to the array.
+  static int IsAttachedTo(vtkAbstractArray *array);
+
+  // Description:
+  // The key under which AttachToArray() stores the mapping.
+  static vtkInformationObjectBaseKey *MAPPED_FILE();
+  //ETX
+
+protected:
+  vtkMemoryMappedFile();
+  ~vtkMemoryMappedFile();
+
+  vtkSetStringMacro(FileName);
+
+  char *FileName;
+  char *Data;
+  vtkTypeUInt64 Size;
+
+  // The handles of the file and of its mapping on Windows.
+  void *FileHandle;
+  void *MappingHandle;
+
+private:
+  vtkMemoryMappedFile(const vtkMemoryMappedFile&);  // Not implemented.
+  void operator=(const vtkMemoryMappedFile&);  // Not implemented.
+};
+
+#endif
@@ -74,6 +74,8 @@
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
@@ -143,6 +145,8 @@ template <typename T> struct vtkFoamReadValue;
 struct vtkFoamEntryValue;
 struct vtkFoamEntry;
 struct vtkFoamDict;
+struct vtkFoamParsedFile;
+struct vtkFoamParsedFiles;
 
 //-----------------------------------------------------------------------------
 // class vtkOpenFOAMReaderPrivate
@@ -286,10 +290,10 @@ private:
   bool ListTimeDirectoriesByInstances();
 
   // read mesh files
-  vtkFloatArray* ReadPointsFile();
-  vtkFoamIntVectorVector* ReadFacesFile (const vtkStdString &);
+  vtkFloatArray* ReadPointsFile(vtkFoamParsedFile *);
+  vtkFoamIntVectorVector* ReadFacesFile (vtkFoamParsedFile *);
   vtkFoamIntVectorVector* ReadOwnerNeighborFiles(const vtkStdString &,
-      vtkFoamIntVectorVector *);
+      vtkFoamIntVectorVector *, vtkFoamParsedFile *, vtkFoamParsedFile *);
   bool CheckFacePoints(vtkFoamIntVectorVector *);
 
   // create mesh
@@ -316,14 +320,13 @@ private:
 
   // read and create cell/point fields
   void ConstructDimensions(vtkStdString *, vtkFoamDict *);
-  bool ReadFieldFile(vtkFoamIOobject *, vtkFoamDict *, const vtkStdString &,
-      vtkDataArraySelection *);
+  bool ReadFieldFile(vtkFoamParsedFile *);
   vtkFloatArray *FillField(vtkFoamEntry *, int, vtkFoamIOobject *,
       const vtkStdString &);
   void GetVolFieldAtTimeStep(vtkUnstructuredGrid *, vtkMultiBlockDataSet *,
-      const vtkStdString &);
+      const vtkStdString &, vtkFoamParsedFile *);
   void GetPointFieldAtTimeStep(vtkUnstructuredGrid *, vtkMultiBlockDataSet *,
-      const vtkStdString &);
+      const vtkStdString &, vtkFoamParsedFile *);
   void AddArrayToFieldData(vtkDataSetAttributes *, vtkDataArray *,
       const vtkStdString &);
 
@@ -769,6 +772,130 @@ public:
   }
 };
 
+//-----------------------------------------------------------------------------
+// multiply or divide a number by a power of ten the way
+// vtkFoamFile::ReadFloatValue() always has.
+static inline double vtkFoamScaleByExponent(double num, const int esign,
+    int eval)
+{
+  double scale = 1.0;
+
+  // fast exponent multiplication!
+  while (eval >= 64)
+    {
+    scale *= 1.0e+64;
+    eval -= 64;
+    }
+  while (eval >= 16)
+    {
+    scale *= 1.0e+16;
+    eval -= 16;
+    }
+  while (eval >= 4)
+    {
+    scale *= 1.0e+4;
+    eval -= 4;
+    }
+  while (eval >= 1)
+    {
+    scale *= 1.0e+1;
+    eval -= 1;
+    }
+
+  return esign < 0 ? num / scale : num * scale;
+}
+
+// parsers for the buffered fast path of vtkFoamFile::ReadValues(). they
+// give the same values as vtkFoamFile::ReadIntValue() / ReadFloatValue()
+// and return the position after the number, or NULL if there is no plain
+// number at ptr or if it may go on past endPtr.
+static inline const unsigned char *vtkFoamParseValue(const unsigned char *ptr,
+    const unsigned char *endPtr, int &value)
+{
+  const bool negative = (*ptr == 45); // '-' == 45
+  if (negative || *ptr == 43) // '+' == 43
+    {
+    ptr++;
+    }
+  if (ptr == endPtr || !isdigit(*ptr))
+    {
+    return NULL;
+    }
+  int num = *ptr++ - 48; // '0' == 48
+  while (ptr != endPtr && isdigit(*ptr))
+    {
+    num = 10 * num + *ptr++ - 48;
+    }
+  if (ptr == endPtr)
+    {
+    return NULL;
+    }
+  value = negative ? -num : num;
+  return ptr;
+}
+
+static inline const unsigned char *vtkFoamParseValue(const unsigned char *ptr,
+    const unsigned char *endPtr, float &value)
+{
+  const bool negative = (*ptr == 45); // '-' == 45
+  if (negative || *ptr == 43) // '+' == 43
+    {
+    ptr++;
+    }
+  // numbers starting with '.' are left to ReadFloatValue()
+  if (ptr == endPtr || !isdigit(*ptr))
+    {
+    return NULL;
+    }
+
+  // read integer part
+  double num = *ptr++ - 48; // '0' == 48
+  while (ptr != endPtr && isdigit(*ptr))
+    {
+    num = num * 10.0 + (*ptr++ - 48);
+    }
+
+  // read decimal part
+  if (ptr != endPtr && *ptr == 46) // '.'
+    {
+    double divisor = 1.0;
+    while (++ptr != endPtr && isdigit(*ptr))
+      {
+      num = num * 10.0 + (*ptr - 48);
+      divisor *= 10.0;
+      }
+    num /= divisor;
+    }
+
+  // read exponent part
+  if (ptr != endPtr && (*ptr == 69 || *ptr == 101)) // 'E' == 69, 'e' == 101
+    {
+    int esign = 1;
+    int eval = 0;
+    if (++ptr != endPtr && *ptr == 45) // '-'
+      {
+      esign = -1;
+      ptr++;
+      }
+    else if (ptr != endPtr && *ptr == 43) // '+'
+      {
+      ptr++;
+      }
+    while (ptr != endPtr && isdigit(*ptr))
+      {
+      eval = eval * 10 + (*ptr++ - 48);
+      }
+    num = vtkFoamScaleByExponent(num, esign, eval);
+    }
+
+  if (ptr == endPtr)
+    {
+    return NULL;
+    }
+  value = static_cast<float>(negative ? -num : num);
+  return ptr;
+}
+
 //-----------------------------------------------------------------------------
 // class vtkFoamFile
 // read and tokenize the input.
@@ -1545,6 +1672,89 @@ public:
 
   int ReadIntValue();
   float ReadFloatValue();
+
+  // read nTuples tuples of nComponents numbers, each tuple enclosed in
+  // parentheses if inParentheses is true. numbers are parsed straight out
+  // of the buffer while it holds them whole; comments, numbers across the
+  // end of the buffer and anything unexpected go through the Read*()
+  // methods above so that they are handled and reported as before.
+  template <typename T> void ReadValues(T *values, const int nTuples,
+      const int nComponents, const bool inParentheses)
+  {
+    for (int i = 0; i < nTuples; i++)
+      {
+      if (inParentheses && !this->ReadBufferedExpecting('('))
+        {
+        this->ReadExpecting('(');
+        }
+      for (int j = 0; j < nComponents; j++, values++)
+        {
+        if (!this->ReadBufferedValue(*values))
+          {
+          this->ReadValue(*values);
+          }
+        }
+      if (inParentheses && !this->ReadBufferedExpecting(')'))
+        {
+        this->ReadExpecting(')');
+        }
+      }
+  }
+
+private:
+  void ReadValue(int &value)
+  {
+    value = this->ReadIntValue();
+  }
+  void ReadValue(float &value)
+  {
+    value = this->ReadFloatValue();
+  }
+
+  // skip whitespace in the buffer. returns false if the buffer ran out.
+  bool SkipBufferedSpaces()
+  {
+    unsigned char *ptr = this->Superclass::BufPtr;
+    while (ptr != this->Superclass::BufEndPtr && isspace(*ptr))
+      {
+      if (*ptr == '\n')
+        {
+        ++this->Superclass::LineNumber;
+#if VTK_FOAMFILE_RECOGNIZE_LINEHEAD
+        this->Superclass::WasNewline = true;
+#endif
+        }
+      ptr++;
+      }
+    this->Superclass::BufPtr = ptr;
+    return ptr != this->Superclass::BufEndPtr;
+  }
+
+  template <typename T> bool ReadBufferedValue(T &value)
+  {
+    if (!this->SkipBufferedSpaces())
+      {
+      return false;
+      }
+    const unsigned char *ptr = vtkFoamParseValue(this->Superclass::BufPtr,
+        this->Superclass::BufEndPtr, value);
+    if (ptr == NULL)
+      {
+      return false;
+      }
+    this->Superclass::BufPtr = const_cast<unsigned char *>(ptr);
+    return true;
+  }
+
+  bool ReadBufferedExpecting(const char expected)
+  {
+    if (!this->SkipBufferedSpaces() || *this->Superclass::BufPtr != expected)
+      {
+      return false;
+      }
+    this->Superclass::BufPtr++;
+    return true;
+  }
 };
 
 int vtkFoamFile::ReadNext()
@@ -1687,7 +1897,6 @@ float vtkFoamFile::ReadFloatValue()
     {
     int esign = 1;
     int eval = 0;
-    double scale = 1.0;
 
     c = this->Getc();
     if (c == 45) // '-'
@@ -1706,36 +1915,7 @@ float vtkFoamFile::ReadFloatValue()
       c = this->Getc();
       }
 
-    // fast exponent multiplication!
-    while (eval >= 64)
-      {
-      scale *= 1.0e+64;
-      eval -= 64;
-      }
-    while (eval >= 16)
-      {
-      scale *= 1.0e+16;
-      eval -= 16;
-      }
-    while (eval >= 4)
-      {
-      scale *= 1.0e+4;
-      eval -= 4;
-      }
-    while (eval >= 1)
-      {
-      scale *= 1.0e+1;
-      eval -= 1;
-      }
-
-    if (esign < 0)
-      {
-      num /= scale;
-      }
-    else
-      {
-      num *= scale;
-      }
+    num = vtkFoamScaleByExponent(num, esign, eval);
     }
 
   if (c == EOF)
@@ -2064,10 +2244,7 @@ public:
     }
     void ReadAsciiList(vtkFoamIOobject& io, const int size)
     {
-      for (int i = 0; i < size; i++)
-        {
-        this->Ptr->SetValue(i, vtkFoamReadValue<primitiveT>::ReadValue(io));
-        }
+      io.ReadValues(this->Ptr->GetPointer(0), size, 1, false);
     }
     void ReadBinaryList(vtkFoamIOobject& io, const int size)
     {
@@ -2125,6 +2302,11 @@ public:
     }
     void ReadAsciiList(vtkFoamIOobject& io, const int size)
     {
+      if (!isPositions)
+        {
+        io.ReadValues(this->Ptr->GetPointer(0), size, nComponents, true);
+        return;
+        }
       for (int i = 0; i < size; i++)
         {
         io.ReadExpecting('(');
@@ -2356,12 +2538,7 @@ public:
 
           if (io.GetFormat() == vtkFoamIOobject::ASCII)
             {
-            io.ReadExpecting('(');
-            for (int j = 0; j < sizeJ; j++)
-              {
-              listI[j] = vtkFoamReadValue<int>::ReadValue(io);
-              }
-            io.ReadExpecting(')');
+            io.ReadValues(listI, 1, sizeJ, true);
             }
           else
             {
@@ -3642,6 +3819,223 @@ void vtkFoamEntry::Read(vtkFoamIOobject& io)
     }
 }
 
+//-----------------------------------------------------------------------------
+// struct vtkFoamParsedFile
+// a mesh or field file opened and parsed ahead of its use, possibly by
+// another thread. the io object stays open so that errors are reported
+// with the file name and line number afterwards as if the file had been
+// parsed where it is used.
+struct vtkFoamParsedFile
+{
+  enum fileType
+    {
+    POINTS, // vectorField of points
+    FACES, // faceList or faceCompactList
+    LABELS, // labelList such as owner and neighbour
+    FIELD // volField or pointField dictionary
+    };
+
+  fileType Type;
+  vtkStdString Path;
+  vtkDataArraySelection *Selection;
+  vtkFoamIOobject Io;
+  vtkFoamEntryValue Value;
+  vtkFoamDict Dict;
+  bool Done;
+  bool Opened;
+  bool Skipped;
+  bool Parsed;
+
+  vtkFoamParsedFile(const fileType type, const vtkStdString &casePath,
+      const vtkStdString &path, vtkDataArraySelection *selection) :
+    Type(type), Path(path), Selection(selection), Io(casePath), Value(NULL),
+    Dict(), Done(false), Opened(false), Skipped(false), Parsed(false)
+  {
+  }
+
+  // parse the file unless done already
+  void Parse()
+  {
+    if (this->Done)
+      {
+      return;
+      }
+    this->Done = true;
+
+    if (this->Type == FIELD)
+      {
+      this->Opened = this->Io.Open(this->Path);
+      if (!this->Opened)
+        {
+        return;
+        }
+      // if the variable is disabled on selection panel then skip it
+      const char *name = this->Io.GetObjectName().c_str();
+      if (this->Selection->ArrayExists(name)
+          && !this->Selection->ArrayIsEnabled(name))
+        {
+        this->Skipped = true;
+        return;
+        }
+      // sets the error of io on failure
+      this->Parsed = this->Dict.Read(this->Io);
+      return;
+      }
+
+    this->Opened = this->Io.Open(this->Path)
+        || this->Io.Open(this->Path + ".gz");
+    if (!this->Opened)
+      {
+      return;
+      }
+    try
+      {
+      if (this->Type == POINTS)
+        {
+        this->Value.ReadNonuniformList<vtkFoamToken::VECTORLIST,
+        vtkFoamEntryValue::vectorListTraits<vtkFloatArray, float, 3, false> >(
+            this->Io);
+        }
+      else if (this->Type == FACES)
+        {
+        if (this->Io.GetClassName() == "faceCompactList")
+          {
+          this->Value.ReadCompactIOLabelList(this->Io);
+          }
+        else
+          {
+          this->Value.ReadLabelListList(this->Io);
+          }
+        }
+      else
+        {
+        this->Value.ReadNonuniformList<vtkFoamToken::LABELLIST,
+        vtkFoamEntryValue::listTraits<vtkIntArray, int> >(this->Io);
+        }
+      this->Parsed = true;
+      }
+    catch(vtkFoamError& e)
+      {
+      this->Io.SetError(e);
+      }
+  }
+
+private:
+  vtkFoamParsedFile(const vtkFoamParsedFile &);
+  void operator=(const vtkFoamParsedFile &);
+};
+
+//-----------------------------------------------------------------------------
+// struct vtkFoamParsedFiles
+// files to be parsed concurrently. threads take the files from the
+// largest one down so that a large points file does not start last.
+struct vtkFoamParsedFiles : public vtkstd::vector<vtkFoamParsedFile *>
+{
+private:
+  typedef vtkstd::vector<vtkFoamParsedFile *> Superclass;
+
+  vtkstd::vector<size_t> Order;
+  size_t NextFile;
+  vtkSimpleMutexLock Lock;
+
+  vtkFoamParsedFiles(const vtkFoamParsedFiles &);
+  void operator=(const vtkFoamParsedFiles &);
+
+  static VTK_THREAD_RETURN_TYPE ParseThread(void *arg)
+  {
+    vtkMultiThreader::ThreadInfo *info =
+        static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+    vtkFoamParsedFiles *files =
+        static_cast<vtkFoamParsedFiles *>(info->UserData);
+    for (;;)
+      {
+      files->Lock.Lock();
+      const size_t orderI = files->NextFile++;
+      files->Lock.Unlock();
+      if (orderI >= files->Order.size())
+        {
+        break;
+        }
+      files->operator[](files->Order[orderI])->Parse();
+      }
+    return VTK_THREAD_RETURN_VALUE;
+  }
+
+public:
+  vtkFoamParsedFiles() : Superclass(), NextFile(0)
+  {
+  }
+  ~vtkFoamParsedFiles()
+  {
+    for (size_t fileI = 0; fileI < this->Superclass::size(); fileI++)
+      {
+      delete this->Superclass::operator[](fileI);
+      }
+  }
+
+  vtkFoamParsedFile *Add(const vtkFoamParsedFile::fileType type,
+      const vtkStdString &casePath, const vtkStdString &path,
+      vtkDataArraySelection *selection = NULL)
+  {
+    this->Superclass::push_back(new vtkFoamParsedFile(type, casePath, path,
+        selection));
+    return this->Superclass::back();
+  }
+
+  // free a file as soon as it has been used
+  void Release(vtkFoamParsedFile *file)
+  {
+    for (size_t fileI = 0; fileI < this->Superclass::size(); fileI++)
+      {
+      if (this->Superclass::operator[](fileI) == file)
+        {
+        delete file;
+        this->Superclass::operator[](fileI) = NULL;
+        break;
+        }
+      }
+  }
+
+  // parse the files with up to the given number of threads. with one
+  // thread nothing is done here and each file is parsed where it is
+  // used, one at a time as without the queue.
+  void Parse(const int numberOfThreads)
+  {
+    const int nFiles = static_cast<int>(this->Superclass::size());
+    const int nThreads = numberOfThreads < nFiles ? numberOfThreads : nFiles;
+    if (nThreads <= 1)
+      {
+      return;
+      }
+
+    vtkstd::vector<vtkTypeInt64> lengths(nFiles);
+    this->Order.clear();
+    for (int fileI = 0; fileI < nFiles; fileI++)
+      {
+      const vtkStdString &path = this->Superclass::operator[](fileI)->Path;
+      lengths[fileI] = vtksys::SystemTools::FileExists(path.c_str(), true)
+          ? vtksys::SystemTools::FileLength(path.c_str())
+          : vtksys::SystemTools::FileLength((path + ".gz").c_str());
+      // insertion sort into descending order of lengths
+      size_t orderI = this->Order.size();
+      this->Order.push_back(fileI);
+      for (; orderI > 0 && lengths[this->Order[orderI - 1]] < lengths[fileI];
+          orderI--)
+        {
+        this->Order[orderI] = this->Order[orderI - 1];
+        }
+      this->Order[orderI] = fileI;
+      }
+
+    this->NextFile = 0;
+    vtkMultiThreader *threader = vtkMultiThreader::New();
+    threader->SetNumberOfThreads(nThreads);
+    threader->SetSingleMethod(ParseThread, this);
+    threader->SingleMethodExecute();
+    threader->Delete();
+  }
+};
+
 //-----------------------------------------------------------------------------
 // vtkOpenFOAMReaderPrivate constructor and destructor
 vtkOpenFOAMReaderPrivate::vtkOpenFOAMReaderPrivate()
@@ -4573,34 +4967,26 @@ void vtkOpenFOAMReaderPrivate::PopulatePolyMeshDirArrays()
 
 //-----------------------------------------------------------------------------
 // read the points file into a vtkFloatArray
-vtkFloatArray* vtkOpenFOAMReaderPrivate::ReadPointsFile()
+vtkFloatArray* vtkOpenFOAMReaderPrivate::ReadPointsFile(
+    vtkFoamParsedFile *pointsFile)
 {
-  // path to points file
-  const vtkStdString pointPath =
-      this->CurrentTimeRegionMeshPath(this->PolyMeshPointsDir) + "points";
-
-  vtkFoamIOobject io(this->CasePath);
-  if (!(io.Open(pointPath) || io.Open(pointPath + ".gz")))
+  pointsFile->Parse();
+  vtkFoamIOobject &io = pointsFile->Io;
+  if (!pointsFile->Opened)
     {
     vtkErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
         << io.GetError().c_str());
     return NULL;
     }
-
-  vtkFoamEntryValue dict(NULL);
-  try
-    {
-    dict.ReadNonuniformList<vtkFoamToken::VECTORLIST,
-    vtkFoamEntryValue::vectorListTraits<vtkFloatArray, float, 3, false> >(io);
-    }
-  catch(vtkFoamError& e)
+  if (!pointsFile->Parsed)
     {
     vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
-        << " of " << io.GetFileName().c_str() << ": " << e.c_str());
+        << " of " << io.GetFileName().c_str() << ": " << io.GetError().c_str());
     return NULL;
     }
 
-  vtkFloatArray *pointArray = static_cast<vtkFloatArray *>(dict.Ptr());
+  vtkFloatArray *pointArray =
+      static_cast<vtkFloatArray *>(pointsFile->Value.Ptr());
 
   // set the number of points
   this->NumPoints = pointArray->GetNumberOfTuples();
@@ -4611,88 +4997,63 @@ vtkFloatArray* vtkOpenFOAMReaderPrivate::ReadPointsFile()
 //-----------------------------------------------------------------------------
 // read the faces into a vtkFoamIntVectorVector
 vtkFoamIntVectorVector * vtkOpenFOAMReaderPrivate::ReadFacesFile(
-    const vtkStdString &facePathIn)
+    vtkFoamParsedFile *facesFile)
 {
-  const vtkStdString facePath(facePathIn + "faces");
-
-  vtkFoamIOobject io(this->CasePath);
-  if (!(io.Open(facePath) || io.Open(facePath + ".gz")))
+  facesFile->Parse();
+  vtkFoamIOobject &io = facesFile->Io;
+  if (!facesFile->Opened)
     {
     vtkErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
         << io.GetError().c_str() << ". If you are trying to read a parallel "
         "decomposed case, set Case Type to Decomposed Case.");
     return NULL;
     }
-
-  vtkFoamEntryValue dict(NULL);
-  try
-    {
-    if (io.GetClassName() == "faceCompactList")
-      {
-      dict.ReadCompactIOLabelList(io);
-      }
-    else
-      {
-      dict.ReadLabelListList(io);
-      }
-    }
-  catch(vtkFoamError& e)
+  if (!facesFile->Parsed)
     {
     vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
-        << " of " << io.GetFileName().c_str() << ": " << e.c_str());
+        << " of " << io.GetFileName().c_str() << ": " << io.GetError().c_str());
     return NULL;
     }
-  return static_cast<vtkFoamIntVectorVector *>(dict.Ptr());
+  return static_cast<vtkFoamIntVectorVector *>(facesFile->Value.Ptr());
 }
 
 //-----------------------------------------------------------------------------
 // read the owner and neighbor file and create cellFaces
 vtkFoamIntVectorVector * vtkOpenFOAMReaderPrivate::ReadOwnerNeighborFiles(
-    const vtkStdString &ownerNeighborPath, vtkFoamIntVectorVector *facePoints)
+    const vtkStdString &ownerNeighborPath, vtkFoamIntVectorVector *facePoints,
+    vtkFoamParsedFile *ownerFile, vtkFoamParsedFile *neighborFile)
 {
-  vtkFoamIOobject io(this->CasePath);
-  vtkStdString ownerPath(ownerNeighborPath + "owner");
-  if (io.Open(ownerPath) || io.Open(ownerPath + ".gz"))
+  ownerFile->Parse();
+  if (ownerFile->Opened)
     {
-    vtkFoamEntryValue ownerDict(NULL);
-    try
-      {
-      ownerDict.ReadNonuniformList<vtkFoamToken::LABELLIST,
-      vtkFoamEntryValue::listTraits<vtkIntArray, int> >(io);
-      }
-    catch(vtkFoamError& e)
+    if (!ownerFile->Parsed)
       {
+      vtkFoamIOobject &io = ownerFile->Io;
       vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
-          << " of " << io.GetFileName().c_str() << ": " << e.c_str());
+          << " of " << io.GetFileName().c_str() << ": "
+          << io.GetError().c_str());
       return NULL;
       }
 
-    io.Close();
-
-    const vtkStdString neighborPath(ownerNeighborPath + "neighbour");
-    if (!(io.Open(neighborPath) || io.Open(neighborPath + ".gz")))
+    neighborFile->Parse();
+    vtkFoamIOobject &io = neighborFile->Io;
+    if (!neighborFile->Opened)
       {
       vtkErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
           << io.GetError().c_str());
       return NULL;
       }
-
-    vtkFoamEntryValue neighborDict(NULL);
-    try
-      {
-      neighborDict.ReadNonuniformList<vtkFoamToken::LABELLIST,
-      vtkFoamEntryValue::listTraits<vtkIntArray, int> >(io);
-      }
-    catch(vtkFoamError& e)
+    if (!neighborFile->Parsed)
       {
       vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
-          << " of " << io.GetFileName().c_str() << ": " << e.c_str());
+          << " of " << io.GetFileName().c_str() << ": "
+          << io.GetError().c_str());
       return NULL;
       }
 
-    this->FaceOwner = static_cast<vtkIntArray *>(ownerDict.Ptr());
+    this->FaceOwner = static_cast<vtkIntArray *>(ownerFile->Value.Ptr());
     vtkIntArray &faceOwner = *this->FaceOwner;
-    vtkIntArray &faceNeighbor = neighborDict.LabelList();
+    vtkIntArray &faceNeighbor = neighborFile->Value.LabelList();
 
     const int nFaces = faceOwner.GetNumberOfTuples();
     const int nNeiFaces = faceNeighbor.GetNumberOfTuples();
@@ -4834,6 +5195,7 @@ vtkFoamIntVectorVector * vtkOpenFOAMReaderPrivate::ReadOwnerNeighborFiles(
     }
   else // if owner does not exist look for cells
     {
+    vtkFoamIOobject io(this->CasePath);
     vtkStdString cellsPath(ownerNeighborPath + "cells");
     if (!(io.Open(cellsPath) || io.Open(cellsPath + ".gz")))
       {
@@ -6437,15 +6799,13 @@ void vtkOpenFOAMReaderPrivate::InterpolateCellToPoint(vtkFloatArray *pData,
 }
 
 //-----------------------------------------------------------------------------
-bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject *ioPtr,
-    vtkFoamDict *dictPtr, const vtkStdString &varName,
-    vtkDataArraySelection *selection)
+bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamParsedFile *fieldFile)
 {
-  const vtkStdString varPath(this->CurrentTimeRegionPath() + "/" + varName);
-
-  // open the file
-  vtkFoamIOobject &io = *ioPtr;
-  if (!io.Open(varPath))
+  // open the file and read it into the dictionary unless the variable
+  // is disabled on selection panel
+  fieldFile->Parse();
+  vtkFoamIOobject &io = fieldFile->Io;
+  if (!fieldFile->Opened)
     {
     vtkErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
         << io.GetError().c_str());
@@ -6453,14 +6813,13 @@ bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject *ioPtr,
     }
 
   // if the variable is disabled on selection panel then skip it
-  if (selection->ArrayExists(io.GetObjectName().c_str()) && !selection->ArrayIsEnabled(io.GetObjectName().c_str()))
+  if (fieldFile->Skipped)
     {
     return false;
     }
 
-  // read the field file into dictionary
-  vtkFoamDict &dict = *dictPtr;
-  if (!dict.Read(io))
+  vtkFoamDict &dict = fieldFile->Dict;
+  if (!fieldFile->Parsed)
     {
     vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
         << " of " << io.GetFileName().c_str() << ": " << io.GetError().c_str());
@@ -6714,15 +7073,14 @@ void vtkOpenFOAMReaderPrivate::ConstructDimensions(vtkStdString *dimString,
 //-----------------------------------------------------------------------------
 void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(
     vtkUnstructuredGrid *internalMesh, vtkMultiBlockDataSet *boundaryMesh,
-    const vtkStdString &varName)
+    const vtkStdString &varName, vtkFoamParsedFile *fieldFile)
 {
-  vtkFoamIOobject io(this->CasePath);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(&io, &dict, varName,
-      this->Parent->CellDataArraySelection))
+  if (!this->ReadFieldFile(fieldFile))
     {
     return;
     }
+  vtkFoamIOobject &io = fieldFile->Io;
+  vtkFoamDict &dict = fieldFile->Dict;
 
   if (io.GetClassName().substr(0, 3) != "vol")
     {
@@ -7067,15 +7425,14 @@ void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(
 // read point field at a timestep
 void vtkOpenFOAMReaderPrivate::GetPointFieldAtTimeStep(
     vtkUnstructuredGrid *internalMesh, vtkMultiBlockDataSet *boundaryMesh,
-    const vtkStdString &varName)
+    const vtkStdString &varName, vtkFoamParsedFile *fieldFile)
 {
-  vtkFoamIOobject io(this->CasePath);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(&io, &dict, varName,
-      this->Parent->PointDataArraySelection))
+  if (!this->ReadFieldFile(fieldFile))
     {
     return;
     }
+  vtkFoamIOobject &io = fieldFile->Io;
+  vtkFoamDict &dict = fieldFile->Dict;
 
   if (io.GetClassName().substr(0, 5) != "point")
     {
@@ -7715,15 +8072,45 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet *output,
     this->ClearBoundaryMeshes();
     }
 
-  vtkFoamIntVectorVector *facePoints = NULL;
+  const bool readFaces = createEulerians
+      && (recreateInternalMesh || recreateBoundaryMesh);
+  const bool readOwnerNeighbor = createEulerians && recreateInternalMesh;
+  const bool readPoints = createEulerians && (recreateInternalMesh
+      || (recreateBoundaryMesh && !recreateInternalMesh
+      && this->InternalMesh == NULL) || moveInternalPoints
+      || moveBoundaryPoints);
+
+  // parse the polyMesh files concurrently if more than one thread is used
+  vtkFoamParsedFiles meshFiles;
+  vtkFoamParsedFile *facesFile = NULL, *ownerFile = NULL, *neighborFile = NULL,
+      *pointsFile = NULL;
   vtkStdString meshDir;
-  if (createEulerians && (recreateInternalMesh || recreateBoundaryMesh))
+  if (readFaces)
     {
     // create paths to polyMesh files
     meshDir = this->CurrentTimeRegionMeshPath(this->PolyMeshFacesDir);
+    facesFile = meshFiles.Add(vtkFoamParsedFile::FACES, this->CasePath,
+        meshDir + "faces");
+    }
+  if (readOwnerNeighbor)
+    {
+    ownerFile = meshFiles.Add(vtkFoamParsedFile::LABELS, this->CasePath,
+        meshDir + "owner");
+    neighborFile = meshFiles.Add(vtkFoamParsedFile::LABELS, this->CasePath,
+        meshDir + "neighbour");
+    }
+  if (readPoints)
+    {
+    pointsFile = meshFiles.Add(vtkFoamParsedFile::POINTS, this->CasePath,
+        this->CurrentTimeRegionMeshPath(this->PolyMeshPointsDir) + "points");
+    }
+  meshFiles.Parse(this->Parent->GetNumberOfThreads());
 
+  vtkFoamIntVectorVector *facePoints = NULL;
+  if (readFaces)
+    {
     // create the faces vector
-    facePoints = this->ReadFacesFile(meshDir);
+    facePoints = this->ReadFacesFile(facesFile);
     if (facePoints == NULL)
       {
       return 0;
@@ -7732,10 +8119,12 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet *output,
     }
 
   vtkFoamIntVectorVector *cellFaces = NULL;
-  if (createEulerians && recreateInternalMesh)
+  if (readOwnerNeighbor)
     {
     // read owner/neighbor and create the FaceOwner and cellFaces vectors
-    cellFaces = this->ReadOwnerNeighborFiles(meshDir, facePoints);
+    cellFaces = this->ReadOwnerNeighborFiles(meshDir, facePoints, ownerFile,
+        neighborFile);
+    meshFiles.Release(neighborFile);
     if (cellFaces == NULL)
       {
       delete facePoints;
@@ -7745,12 +8134,10 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet *output,
     }
 
   vtkFloatArray *pointArray = NULL;
-  if (createEulerians && (recreateInternalMesh || (recreateBoundaryMesh
-      && !recreateInternalMesh && this->InternalMesh == NULL)
-      || moveInternalPoints || moveBoundaryPoints))
+  if (readPoints)
     {
     // get the points
-    pointArray = this->ReadPointsFile();
+    pointArray = this->ReadPointsFile(pointsFile);
     if ((pointArray == NULL && recreateInternalMesh) || (facePoints != NULL
         && !this->CheckFacePoints(facePoints)))
       {
@@ -7981,20 +8368,43 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet *output,
           bm->GetPointData()->Initialize();
           }
         }
+      // parse the field files concurrently if more than one thread is
+      // used, the volFields followed by the pointFields
+      const int nVolFields = (int)this->VolFieldFiles->GetNumberOfValues();
+      const int nPointFields
+          = (int)this->PointFieldFiles->GetNumberOfValues();
+      const vtkStdString timeRegionPath(this->CurrentTimeRegionPath() + "/");
+      vtkFoamParsedFiles fieldFiles;
+      for (int i = 0; i < nVolFields; i++)
+        {
+        fieldFiles.Add(vtkFoamParsedFile::FIELD, this->CasePath,
+            timeRegionPath + this->VolFieldFiles->GetValue(i),
+            this->Parent->CellDataArraySelection);
+        }
+      for (int i = 0; i < nPointFields; i++)
+        {
+        fieldFiles.Add(vtkFoamParsedFile::FIELD, this->CasePath,
+            timeRegionPath + this->PointFieldFiles->GetValue(i),
+            this->Parent->PointDataArraySelection);
+        }
+      fieldFiles.Parse(this->Parent->GetNumberOfThreads());
+
       // read field data variables into Internal/Boundary meshes
-      for (int i = 0; i < (int)this->VolFieldFiles->GetNumberOfValues(); i++)
+      for (int i = 0; i < nVolFields; i++)
         {
         this->GetVolFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh,
-            this->VolFieldFiles->GetValue(i));
+            this->VolFieldFiles->GetValue(i), fieldFiles[i]);
+        fieldFiles.Release(fieldFiles[i]);
         this->Parent->UpdateProgress(0.5 + 0.25 * ((float)(i + 1)
-            / ((float)this->VolFieldFiles->GetNumberOfValues() + 0.0001)));
+            / ((float)nVolFields + 0.0001)));
         }
-      for (int i = 0; i < (int)this->PointFieldFiles->GetNumberOfValues(); i++)
+      for (int i = 0; i < nPointFields; i++)
         {
         this->GetPointFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh,
-            this->PointFieldFiles->GetValue(i));
+            this->PointFieldFiles->GetValue(i), fieldFiles[nVolFields + i]);
+        fieldFiles.Release(fieldFiles[nVolFields + i]);
         this->Parent->UpdateProgress(0.75 + 0.125 * ((float)(i + 1)
-            / ((float)this->PointFieldFiles->GetNumberOfValues() + 0.0001)));
+            / ((float)nPointFields + 0.0001)));
         }
       }
     // read lagrangian mesh and fields
@@ -8142,6 +8552,9 @@ vtkOpenFOAMReader::vtkOpenFOAMReader()
   this->AddDimensionsToArrayNames = 0;
   this->AddDimensionsToArrayNamesOld = 0;
 
+  // for parsing mesh and field files
+  this->NumberOfThreads = 1;
+
   // Lagrangian paths
   this->LagrangianPaths = vtkStringArray::New();
 
@@ -8192,6 +8605,7 @@ void vtkOpenFOAMReader::PrintSelf(ostream& os, vtkIndent indent)
       << this->ListTimeStepsByControlDict << endl;
   os << indent << "AddDimensionsToArrayNames: "
       << this->AddDimensionsToArrayNames << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
 
   this->Readers->InitTraversal();
   vtkObject *reader;
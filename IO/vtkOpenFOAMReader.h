@@ -218,6 +218,15 @@ public:
   vtkGetMacro(ReadZones, int);
   vtkBooleanMacro(ReadZones, int);
 
+  // Description:
+  // Get/Set the number of threads used to parse the mesh files of a
+  // time step and its volume and point fields.  With more than one
+  // thread, the points, faces, owner and neighbour files are parsed
+  // concurrently, and so are the selected field files.  The default
+  // is 1.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
   void SetRefresh() { this->Refresh = true; this->Modified(); }
 
   void SetParent(vtkOpenFOAMReader *parent) { this->Parent = parent; }
@@ -255,6 +264,9 @@ protected:
   // add dimensions to array names
   int AddDimensionsToArrayNames;
 
+  // number of threads for parsing mesh and field files
+  int NumberOfThreads;
+
   char *FileName;
   vtkCharArray *CasePath;
   vtkCollection *Readers;
@@ -362,6 +362,8 @@ vtkDataSet* vtkXMLCompositeDataReader::ReadDataset(vtkXMLDataElement* xmlElem,
     return 0;
     }
   reader->SetFileName(fileName.c_str());
+  reader->SetNumberOfThreads(this->GetNumberOfThreads());
+  reader->SetMemoryMapping(this->GetMemoryMapping());
   // initialize array selection so we don't have any residual array selections
   // from previous use of the reader.
   reader->GetPointDataArraySelection()->RemoveAllArrays();
@@ -483,6 +483,7 @@ void vtkXMLCompositeDataWriter::CreateWriters(vtkCompositeDataSet* hdInput)
         w->SetByteOrder(this->GetByteOrder());
         w->SetCompressor(this->GetCompressor());
         w->SetBlockSize(this->GetBlockSize());
+        w->SetNumberOfThreads(this->GetNumberOfThreads());
         w->SetDataMode(this->GetDataMode());
         w->SetEncodeAppendedData(this->GetEncodeAppendedData());
         }
@@ -19,16 +19,172 @@
 #include "vtkCommand.h"
 #include "vtkDataCompressor.h"
 #include "vtkInputStream.h"
+#include "vtkMemoryMappedFile.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkXMLDataElement.h"
 
 #include <vtksys/ios/sstream>
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
 
 #include "vtkXMLUtilities.h"
 
 
 vtkStandardNewMacro(vtkXMLDataParser);
 vtkCxxSetObjectMacro(vtkXMLDataParser, Compressor, vtkDataCompressor);
+vtkCxxSetObjectMacro(vtkXMLDataParser, MappedFile, vtkMemoryMappedFile);
+
+//----------------------------------------------------------------------------
+// Reads the compressed blocks of an array in batches and uncompresses
+// each batch with several threads while the first thread reads the next
+// batch from the stream.
+class vtkXMLDataParserBlockQueue
+{
+public:
+  vtkXMLDataParserBlockQueue()
+    {
+    this->Threader = vtkMultiThreader::New();
+    this->Parser = 0;
+    this->Data = 0;
+    this->BeginOffset = 0;
+    this->EndOffset = 0;
+    this->WordSize = 1;
+    this->Current = 0;
+    this->NextBlock = 0;
+    this->Failed = 0;
+    }
+  ~vtkXMLDataParserBlockQueue()
+    {
+    this->Threader->Delete();
+    }
+
+  // A run of consecutive compressed blocks read with one stream read.
+  struct Batch
+  {
+    unsigned int FirstBlock;
+    unsigned int EndBlock;
+    vtkstd::vector<unsigned char> Buffer;
+  };
+
+  int ReadBatch(Batch& batch);
+  int UncompressBlock(const Batch& batch, unsigned int block);
+
+  vtkMultiThreader* Threader;
+  vtkSimpleMutexLock Lock;
+  vtkXMLDataParser* Parser;
+  unsigned char* Data;
+  vtkXMLDataParser::OffsetType BeginOffset;
+  vtkXMLDataParser::OffsetType EndOffset;
+  int WordSize;
+
+  // The batch being uncompressed and the one being read ahead.
+  Batch Batches[2];
+  int Current;
+  unsigned int NextBlock;
+  int Failed;
+};
+
+//----------------------------------------------------------------------------
+int vtkXMLDataParserBlockQueue::ReadBatch(Batch& batch)
+{
+  if(batch.FirstBlock == batch.EndBlock)
+    {
+    return 1;
+    }
+  vtkXMLDataParser* parser = this->Parser;
+  vtkXMLDataParser::OffsetType begin =
+    parser->BlockStartOffsets[batch.FirstBlock];
+  unsigned long length = static_cast<unsigned long>(
+    parser->BlockStartOffsets[batch.EndBlock-1] +
+    parser->BlockCompressedSizes[batch.EndBlock-1] - begin);
+  batch.Buffer.resize(length);
+  return (length == 0 ||
+          (parser->DataStream->Seek(begin) &&
+           parser->DataStream->Read(&batch.Buffer[0], length) == length));
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLDataParserBlockQueue::UncompressBlock(const Batch& batch,
+                                                unsigned int block)
+{
+  vtkXMLDataParser* parser = this->Parser;
+  vtkXMLDataParser::OffsetType blockSize = parser->FindBlockSize(block);
+  vtkXMLDataParser::OffsetType blockBegin =
+    static_cast<vtkXMLDataParser::OffsetType>(block) *
+    parser->BlockUncompressedSize;
+  vtkXMLDataParser::OffsetType blockEnd = blockBegin + blockSize;
+  const unsigned char* compressed = batch.Buffer.empty()? 0 :
+    &batch.Buffer[0] + (parser->BlockStartOffsets[block] -
+                        parser->BlockStartOffsets[batch.FirstBlock]);
+  unsigned long compressedSize = parser->BlockCompressedSizes[block];
+
+  // Blocks wholly inside the requested range are uncompressed in place.
+  // The first and last may need only part of their data.
+  vtkXMLDataParser::OffsetType begin =
+    vtkstd::max(blockBegin, this->BeginOffset);
+  vtkXMLDataParser::OffsetType end = vtkstd::min(blockEnd, this->EndOffset);
+  unsigned char* output = this->Data + (begin - this->BeginOffset);
+  if(begin == blockBegin && end == blockEnd)
+    {
+    if(!parser->Compressor->Uncompress(compressed, compressedSize, output,
+                                       blockSize))
+      {
+      return 0;
+      }
+    }
+  else
+    {
+    vtkstd::vector<unsigned char> blockBuffer(blockSize);
+    if(!parser->Compressor->Uncompress(compressed, compressedSize,
+                                       &blockBuffer[0], blockSize))
+      {
+      return 0;
+      }
+    memcpy(output, &blockBuffer[begin - blockBegin], end - begin);
+    }
+
+  // Note that the range will always be an integer multiple of the word
+  // size.
+  parser->PerformByteSwap(output, (end - begin) / this->WordSize,
+                          this->WordSize);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkXMLDataParserUncompressBlocks(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkXMLDataParserBlockQueue* queue =
+    static_cast<vtkXMLDataParserBlockQueue*>(info->UserData);
+  const vtkXMLDataParserBlockQueue::Batch& batch =
+    queue->Batches[queue->Current];
+
+  // The first thread reads the next batch before it joins the others.
+  if(info->ThreadID == 0 && !queue->ReadBatch(queue->Batches[1-queue->Current]))
+    {
+    queue->Failed = 1;
+    }
+
+  // Every thread takes the next block of this batch as it becomes free.
+  while(!queue->Failed)
+    {
+    queue->Lock.Lock();
+    unsigned int block = queue->NextBlock++;
+    queue->Lock.Unlock();
+    if(block >= batch.EndBlock)
+      {
+      break;
+      }
+    if(!queue->UncompressBlock(batch, block))
+      {
+      queue->Failed = 1;
+      }
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
 
 //----------------------------------------------------------------------------
 vtkXMLDataParser::vtkXMLDataParser()
@@ -46,6 +202,9 @@ vtkXMLDataParser::vtkXMLDataParser()
   this->BlockCompressedSizes = 0;
   this->BlockStartOffsets = 0;
   this->Compressor = 0;
+  this->MappedFile = 0;
+  this->NumberOfThreads = 1;
+  this->BlockQueue = 0;
 
   this->AsciiDataBuffer = 0;
   this->AsciiDataBufferLength = 0;
@@ -79,6 +238,8 @@ vtkXMLDataParser::~vtkXMLDataParser()
   if(this->BlockCompressedSizes) { delete [] this->BlockCompressedSizes; }
   if(this->BlockStartOffsets) { delete [] this->BlockStartOffsets; }
   this->SetCompressor(0);
+  this->SetMappedFile(0);
+  delete this->BlockQueue;
   if(this->AsciiDataBuffer) { this->FreeAsciiBuffer(); }
 }
 
@@ -100,6 +261,8 @@ void vtkXMLDataParser::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "Compressor: (none)\n";
     }
+  os << indent << "MappedFile: " << this->MappedFile << "\n";
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
   os << indent << "Progress: " << this->Progress << "\n";
   os << indent << "Abort: " << this->Abort << "\n";
   os << indent << "AttributesEncoding: " << this->AttributesEncoding << "\n";
@@ -711,7 +874,15 @@ vtkXMLDataParser::ReadCompressedData(unsigned char* data,
     endOffset - lastBlock*this->BlockUncompressedSize;
 
   this->UpdateProgress(0);
-  if(firstBlock == lastBlock)
+  if(this->NumberOfThreads > 1 && firstBlock != lastBlock)
+    {
+    // Several blocks are uncompressed at once.
+    if(!this->ReadCompressedBlocks(data, beginOffset, endOffset, wordSize))
+      {
+      return 0;
+      }
+    }
+  else if(firstBlock == lastBlock)
     {
     // Everything fits in one block.
     unsigned char* blockBuffer = this->ReadBlock(firstBlock);
@@ -790,6 +961,66 @@ vtkXMLDataParser::ReadCompressedData(unsigned char* data,
   return (endOffset - beginOffset)/wordSize;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::ReadCompressedBlocks(unsigned char* data,
+                                           OffsetType beginOffset,
+                                           OffsetType endOffset,
+                                           int wordSize)
+{
+  if(!this->BlockQueue)
+    {
+    this->BlockQueue = new vtkXMLDataParserBlockQueue;
+    }
+  vtkXMLDataParserBlockQueue* queue = this->BlockQueue;
+  queue->Parser = this;
+  queue->Data = data;
+  queue->BeginOffset = beginOffset;
+  queue->EndOffset = endOffset;
+  queue->WordSize = wordSize;
+  queue->Failed = 0;
+  queue->Threader->SetNumberOfThreads(this->NumberOfThreads);
+  queue->Threader->SetSingleMethod(vtkXMLDataParserUncompressBlocks, queue);
+
+  // Read a few blocks per thread at a time so that the threads stay busy
+  // while the first one reads.
+  unsigned int firstBlock = beginOffset / this->BlockUncompressedSize;
+  unsigned int endBlock =
+    (endOffset + this->BlockUncompressedSize - 1) / this->BlockUncompressedSize;
+  unsigned int batchSize = 4*this->NumberOfThreads;
+
+  // Read the first batch, then uncompress each one while reading the next.
+  vtkXMLDataParserBlockQueue::Batch* next = &queue->Batches[0];
+  next->FirstBlock = firstBlock;
+  next->EndBlock = vtkstd::min(endBlock, firstBlock + batchSize);
+  queue->Current = 1;
+  if(!queue->ReadBatch(*next))
+    {
+    return 0;
+    }
+  OffsetType length = endOffset - beginOffset;
+  while(next->FirstBlock != endBlock && !this->Abort)
+    {
+    queue->Current = 1 - queue->Current;
+    vtkXMLDataParserBlockQueue::Batch* current = next;
+    next = &queue->Batches[1 - queue->Current];
+    next->FirstBlock = current->EndBlock;
+    next->EndBlock = vtkstd::min(endBlock, next->FirstBlock + batchSize);
+    queue->NextBlock = current->FirstBlock;
+
+    queue->Threader->SingleMethodExecute();
+    if(queue->Failed)
+      {
+      return 0;
+      }
+
+    // Report progress.
+    OffsetType end =
+      static_cast<OffsetType>(current->EndBlock)*this->BlockUncompressedSize;
+    this->UpdateProgress(float(vtkstd::min(end, endOffset)-beginOffset)/length);
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 vtkXMLDataElement* vtkXMLDataParser::GetRootElement()
 {
@@ -911,6 +1142,55 @@ vtkXMLDataParser::ReadAppendedData(OffsetType offset,
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//----------------------------------------------------------------------------
+void* vtkXMLDataParser::GetMappedAppendedData(OffsetType offset,
+                                              OffsetType startWord,
+                                              OffsetType numWords,
+                                              int wordType)
+{
+  if(!this->MappedFile || !this->MappedFile->GetData() || this->Compressor ||
+     vtkBase64InputStream::SafeDownCast(this->AppendedDataStream))
+    {
+    return 0;
+    }
+
+  // The words must not need swapping.
+  OffsetType wordSize = this->GetWordTypeSize(wordType);
+#ifdef VTK_WORDS_BIGENDIAN
+  int byteOrder = vtkXMLDataParser::BigEndian;
+#else
+  int byteOrder = vtkXMLDataParser::LittleEndian;
+#endif
+  if(wordSize == 0 || (wordSize > 1 && this->ByteOrder != byteOrder))
+    {
+    return 0;
+    }
+
+  // Read the length of the data from the mapping.
+  vtkTypeUInt64 fileSize = this->MappedFile->GetSize();
+  vtkTypeUInt64 position =
+    static_cast<vtkTypeUInt64>(this->AppendedDataPosition + offset);
+  if(this->AppendedDataPosition + offset < 0 ||
+     position + sizeof(HeaderType) > fileSize)
+    {
+    return 0;
+    }
+  HeaderType rsize;
+  memcpy(&rsize, this->MappedFile->GetData() + position, sizeof(HeaderType));
+  this->PerformByteSwap(&rsize, 1, sizeof(HeaderType));
+
+  // All the words must be there, and aligned.
+  vtkTypeUInt64 begin = position + sizeof(HeaderType) + startWord*wordSize;
+  vtkTypeUInt64 length = static_cast<vtkTypeUInt64>(numWords*wordSize);
+  if(startWord < 0 || numWords < 0 ||
+     static_cast<vtkTypeUInt64>((startWord + numWords)*wordSize) > rsize ||
+     begin + length > fileSize || begin % wordSize)
+    {
+    return 0;
+    }
+  return this->MappedFile->GetData() + begin;
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
@@ -31,6 +31,8 @@
 
 class vtkInputStream;
 class vtkDataCompressor;
+class vtkMemoryMappedFile;
+class vtkXMLDataParserBlockQueue;
 
 class VTK_IO_EXPORT vtkXMLDataParser : public vtkXMLParser
 {
@@ -79,6 +81,15 @@ public:
     { return this->ReadAppendedData(offset, buffer, startWord, numWords,
                                     VTK_CHAR); }
 
+  // Description:
+  // Get a pointer to the words of a raw appended data section stored
+  // in the mapped file, for use in place of reading them.  Returns NULL
+  // unless the section is neither encoded nor compressed, has the byte
+  // order of this machine, holds all the words asked for and has them
+  // aligned in memory.
+  void* GetMappedAppendedData(OffsetType offset, OffsetType startWord,
+                              OffsetType numWords, int wordType);
+
   // Description:
   // Read from an ascii data section starting at the current position in
   // the stream.  Returns the number of words read.
@@ -98,6 +109,21 @@ public:
   virtual void SetCompressor(vtkDataCompressor*);
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
 
+  // Description:
+  // Get/Set the number of threads used to uncompress binary and
+  // appended data.  With more than one thread, the compressed blocks of
+  // an array are read ahead in batches and uncompressed concurrently
+  // straight into the destination buffer while the next batch is read.
+  // The default is 1, which reads and uncompresses one block at a time.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // Get/Set the memory mapping of the file being parsed, from which
+  // GetMappedAppendedData returns data.  The default is NULL.
+  virtual void SetMappedFile(vtkMemoryMappedFile*);
+  vtkGetObjectMacro(MappedFile, vtkMemoryMappedFile);
+
   // Description:
   // Get the size of a word of the given type.
   unsigned long GetWordTypeSize(int wordType);
@@ -173,6 +199,8 @@ protected:
                                 OffsetType startWord,
                                 OffsetType numWords,
                                 int wordSize);
+  int ReadCompressedBlocks(unsigned char* data, OffsetType beginOffset,
+                           OffsetType endOffset, int wordSize);
 
   // Go to the start of the inline data
   void SeekInlineDataPosition(vtkXMLDataElement *element);
@@ -234,6 +262,16 @@ protected:
   HeaderType* BlockCompressedSizes;
   OffsetType* BlockStartOffsets;
 
+  // The mapping of the file being parsed, if any.
+  vtkMemoryMappedFile* MappedFile;
+
+  // Threaded decompression.
+  int NumberOfThreads;
+  vtkXMLDataParserBlockQueue* BlockQueue;
+  //BTX
+  friend class vtkXMLDataParserBlockQueue;
+  //ETX
+
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;
   OffsetType AsciiDataBufferLength;
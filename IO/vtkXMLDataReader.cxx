@@ -20,6 +20,7 @@
 #include "vtkDataArray.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDataSet.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkPointData.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataParser.h"
@@ -758,6 +759,10 @@ int vtkXMLDataReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayInde
     {
     return 0;
     }
+  if (this->MapArrayValues(da, arrayIndex, array, startIndex, numValues))
+    {
+    return 1;
+    }
   this->InReadData = 1;
   int result;
   // All arrays types except vtkBitArray.
@@ -778,6 +783,34 @@ int vtkXMLDataReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayInde
   return result;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLDataReader::MapArrayValues(vtkXMLDataElement* da,
+                                     vtkIdType arrayIndex,
+                                     vtkAbstractArray* array,
+                                     vtkIdType startIndex,
+                                     vtkIdType numValues)
+{
+  vtkMemoryMappedFile* mappedFile = this->XMLParser->GetMappedFile();
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  unsigned long offset = 0;
+  if (!mappedFile || !dataArray || dataArray->GetDataType() == VTK_BIT ||
+      arrayIndex != 0 || numValues == 0 ||
+      numValues != array->GetNumberOfTuples()*array->GetNumberOfComponents() ||
+      !da->GetScalarAttribute("offset", offset))
+    {
+    return 0;
+    }
+  void* data = this->XMLParser->GetMappedAppendedData(
+    offset, startIndex, numValues, array->GetDataType());
+  if (!data)
+    {
+    return 0;
+    }
+  dataArray->SetVoidArray(data, numValues, 1);
+  mappedFile->AttachToArray(dataArray);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLDataReader::DataProgressCallbackFunction(vtkObject*, unsigned long,
                                                     void* clientdata, void*)
@@ -87,6 +87,13 @@ protected:
   // values will be put in the array.
   int ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
     vtkIdType startIndex, vtkIdType numValues);
+
+  // Point an array at its values in the mapped file instead of reading
+  // them.  This is possible only when the values fill the whole array.
+  // Returns 1 if the array now points into the mapping.
+  int MapArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
+                     vtkAbstractArray* array, vtkIdType startIndex,
+                     vtkIdType numValues);
     
 
   
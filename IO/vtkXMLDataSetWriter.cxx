@@ -122,6 +122,7 @@ int vtkXMLDataSetWriter::WriteInternal()
   writer->SetByteOrder(this->GetByteOrder());
   writer->SetCompressor(this->GetCompressor());
   writer->SetBlockSize(this->GetBlockSize());
+  writer->SetNumberOfThreads(this->GetNumberOfThreads());
   writer->SetDataMode(this->GetDataMode());
   writer->SetEncodeAppendedData(this->GetEncodeAppendedData());
   writer->AddObserver(vtkCommand::ProgressEvent, this->ProgressObserver);
@@ -347,6 +347,8 @@ int vtkXMLPDataReader::ReadPiece(vtkXMLDataElement* ePiece)
   this->PieceReaders[this->Piece]->AddObserver(vtkCommand::ProgressEvent,
                                                this->PieceProgressObserver);
   reader->SetFileName(pieceFileName);
+  reader->SetNumberOfThreads(this->NumberOfThreads);
+  reader->SetMemoryMapping(this->MemoryMapping);
   
   delete [] pieceFileName;
   
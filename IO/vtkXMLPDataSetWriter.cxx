@@ -109,6 +109,7 @@ int vtkXMLPDataSetWriter::WriteInternal()
   writer->SetByteOrder(this->GetByteOrder());
   writer->SetCompressor(this->GetCompressor());
   writer->SetBlockSize(this->GetBlockSize());
+  writer->SetNumberOfThreads(this->GetNumberOfThreads());
   writer->SetDataMode(this->GetDataMode());
   writer->SetEncodeAppendedData(this->GetEncodeAppendedData());
   writer->SetNumberOfPieces(this->GetNumberOfPieces());
@@ -330,6 +330,7 @@ int vtkXMLPDataWriter::WritePiece(int index)
   
   // Copy the writer settings.
   pWriter->SetCompressor(this->Compressor);
+  pWriter->SetNumberOfThreads(this->NumberOfThreads);
   pWriter->SetDataMode(this->DataMode);
   pWriter->SetByteOrder(this->ByteOrder);
   pWriter->SetEncodeAppendedData(this->EncodeAppendedData);
@@ -375,13 +375,13 @@ void vtkXMLPolyDataWriter::CalculateSuperclassFraction(float* fractions)
   vtkIdType pointsSize = this->GetNumberOfInputPoints();
   
   // This class will write cell specifications.
-  vtkIdType connectSizeV = (input->GetVerts()->GetData()->GetNumberOfTuples() -
+  vtkIdType connectSizeV = (input->GetVerts()->GetNumberOfConnectivityEntries() -
                             input->GetVerts()->GetNumberOfCells());
-  vtkIdType connectSizeL = (input->GetLines()->GetData()->GetNumberOfTuples() -
+  vtkIdType connectSizeL = (input->GetLines()->GetNumberOfConnectivityEntries() -
                             input->GetLines()->GetNumberOfCells());
-  vtkIdType connectSizeS = (input->GetStrips()->GetData()->GetNumberOfTuples() -
+  vtkIdType connectSizeS = (input->GetStrips()->GetNumberOfConnectivityEntries() -
                             input->GetStrips()->GetNumberOfCells());
-  vtkIdType connectSizeP = (input->GetPolys()->GetData()->GetNumberOfTuples() -
+  vtkIdType connectSizeP = (input->GetPolys()->GetNumberOfConnectivityEntries() -
                             input->GetPolys()->GetNumberOfCells());
   vtkIdType offsetSizeV = input->GetVerts()->GetNumberOfCells();
   vtkIdType offsetSizeL = input->GetLines()->GetNumberOfCells();
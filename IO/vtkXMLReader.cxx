@@ -20,6 +20,8 @@
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkInstantiator.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataParser.h"
@@ -118,6 +120,8 @@ vtkXMLReader::vtkXMLReader()
   this->TimeSteps = 0;
   this->CurrentTimeStep = 0;
   this->TimeStepWasReadOnce = 0;
+  this->NumberOfThreads = 1;
+  this->MemoryMapping = 0;
 
   this->FileMinorVersion = -1;
   this->FileMajorVersion = -1;
@@ -163,6 +167,8 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << "," 
                                     << this->TimeStepRange[1] << ")\n";
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "MemoryMapping: " << this->MemoryMapping << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -296,12 +302,17 @@ void vtkXMLReader::SetupCompressor(const char* type)
   vtkObject* object = vtkInstantiator::CreateInstance(type);
   vtkDataCompressor* compressor = vtkDataCompressor::SafeDownCast(object);
   
-  // In static builds, the vtkZLibDataCompressor may not have been
-  // registered with the vtkInstantiator.  Check for it here.
+  // In static builds, the vtkZLibDataCompressor and vtkLZ4DataCompressor
+  // may not have been registered with the vtkInstantiator.  Check for
+  // them here.
   if(!compressor && (strcmp(type, "vtkZLibDataCompressor") == 0))
     {
     compressor = vtkZLibDataCompressor::New();
     }
+  if(!compressor && (strcmp(type, "vtkLZ4DataCompressor") == 0))
+    {
+    compressor = vtkLZ4DataCompressor::New();
+    }
   
   if(!compressor)
     {
@@ -505,6 +516,20 @@ int vtkXMLReader::RequestData(vtkInformation *vtkNotUsed(request),
   
   (*this->Stream).imbue(vtkstd::locale::classic());
   this->XMLParser->SetStream(this->Stream);
+  this->XMLParser->SetNumberOfThreads(this->NumberOfThreads);
+
+  // Map the file we opened so that arrays may point into it.  Arrays
+  // that do keep their own reference to the mapping.
+  if(this->MemoryMapping && this->Stream == this->FileStream &&
+     vtkMemoryMappedFile::IsSupported())
+    {
+    vtkMemoryMappedFile* mappedFile = vtkMemoryMappedFile::New();
+    if(mappedFile->Open(this->FileName))
+      {
+      this->XMLParser->SetMappedFile(mappedFile);
+      }
+    mappedFile->Delete();
+    }
   
   // We are just starting to read.  Do not call UpdateProgressDiscrete
   // because we want a 0 progress callback the first time.
@@ -539,6 +564,7 @@ int vtkXMLReader::RequestData(vtkInformation *vtkNotUsed(request),
   this->UpdateProgressDiscrete(1);
   
   // Close the file to prevent resource leaks.
+  this->XMLParser->SetMappedFile(0);
   this->CloseVTKFile();
   if( this->TimeSteps )
     {
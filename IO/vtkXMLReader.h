@@ -95,6 +95,23 @@ public:
   vtkGetVector2Macro(TimeStepRange, int);
   vtkSetVector2Macro(TimeStepRange, int);
 
+  // Description:
+  // Get/Set the number of threads used to uncompress the data of
+  // compressed files.  The default is 1.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // Get/Set whether the file is mapped into memory while reading.  When
+  // on, arrays stored as raw appended data, neither encoded nor
+  // compressed, in the byte order of this machine and aligned in the
+  // file, point into the mapping instead of being read, so that only the
+  // pages actually used are loaded.  The mapping lives as long as such
+  // arrays do.  Other arrays are read as usual.  The default is off.
+  vtkSetMacro(MemoryMapping, int);
+  vtkGetMacro(MemoryMapping, int);
+  vtkBooleanMacro(MemoryMapping, int);
+
   virtual int ProcessRequest(vtkInformation *request,
                              vtkInformationVector **inputVector,
                              vtkInformationVector *outputVector);
@@ -259,6 +276,12 @@ protected:
   // Store the range of time steps
   int TimeStepRange[2];
 
+  // The number of threads given to the parser.
+  int NumberOfThreads;
+
+  // Whether to map the file into memory.
+  int MemoryMapping;
+
   // Now we need to save what was the last time read for each kind of 
   // data to avoid rereading it that is to say we need a var for 
   // e.g. PointData/CellData/Points/Cells...
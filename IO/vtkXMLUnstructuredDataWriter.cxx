@@ -769,11 +769,55 @@ vtkXMLUnstructuredDataWriter::WriteCellsAppendedData(vtkCellArray* cells,
     }
 }
 
+//----------------------------------------------------------------------------
+// Copies cells of the offsets storage to the connectivity of the file and
+// its offsets, which are those of the ends of the cells.
+template <class T>
+static void vtkXMLUnstructuredDataWriterCopyCells(const T* offsets,
+                                                  const T* connectivity,
+                                                  vtkIdType numberOfCells,
+                                                  vtkIdType* outCellPoints,
+                                                  vtkIdType* outCellOffset)
+{
+  vtkIdType begin = static_cast<vtkIdType>(offsets[0]);
+  vtkIdType end = static_cast<vtkIdType>(offsets[numberOfCells]);
+  vtkIdType i;
+  for(i=begin; i < end; ++i)
+    {
+    *outCellPoints++ = static_cast<vtkIdType>(connectivity[i]);
+    }
+  for(i=1; i <= numberOfCells; ++i)
+    {
+    *outCellOffset++ = static_cast<vtkIdType>(offsets[i]) - begin;
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLUnstructuredDataWriter::ConvertCells(vtkCellArray* cells)
 {
-  vtkIdTypeArray* connectivity = cells->GetData();
   vtkIdType numberOfCells = cells->GetNumberOfCells();
+  if(cells->IsStorageOffsets())
+    {
+    // Read the offsets storage in place rather than through GetData(),
+    // which would convert it.
+    vtkDataArray* offsets = cells->GetOffsetsArray();
+    this->CellPoints->SetNumberOfTuples(
+      cells->GetNumberOfConnectivityEntries() - numberOfCells);
+    this->CellOffsets->SetNumberOfTuples(numberOfCells);
+    switch(offsets->GetDataType())
+      {
+      vtkTemplateMacro(
+        vtkXMLUnstructuredDataWriterCopyCells(
+          static_cast<VTK_TT*>(offsets->GetVoidPointer(0)),
+          static_cast<VTK_TT*>(
+            cells->GetConnectivityArray()->GetVoidPointer(0)),
+          numberOfCells, this->CellPoints->GetPointer(0),
+          this->CellOffsets->GetPointer(0)));
+      }
+    return;
+    }
+
+  vtkIdTypeArray* connectivity = cells->GetData();
   vtkIdType numberOfTuples = connectivity->GetNumberOfTuples();
   
   this->CellPoints->SetNumberOfTuples(numberOfTuples - numberOfCells);
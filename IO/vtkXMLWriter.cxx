@@ -24,6 +24,8 @@
 #include "vtkErrorCode.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkMultiThreader.h"
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
@@ -42,6 +44,7 @@
 
 #include <assert.h>
 #include <vtkstd/string>
+#include <vtkstd/vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 # include <unistd.h> /* unlink */
@@ -81,6 +84,58 @@ public:
    }
 };
 
+//----------------------------------------------------------------------------
+// The blocks of an array queued to be compressed by several threads.
+// Block i is copied to Input at i*BlockSize and compressed to Output at
+// i*CompressionSpace.
+class vtkXMLWriterCompressionQueue
+{
+public:
+  vtkXMLWriterCompressionQueue()
+    {
+    this->Threader = vtkMultiThreader::New();
+    this->Compressor = 0;
+    this->BlockSize = 0;
+    this->CompressionSpace = 0;
+    this->Capacity = 0;
+    this->NumberOfBlocks = 0;
+    }
+  ~vtkXMLWriterCompressionQueue()
+    {
+    this->Threader->Delete();
+    }
+
+  vtkMultiThreader* Threader;
+  vtkDataCompressor* Compressor;
+  unsigned long BlockSize;
+  unsigned long CompressionSpace;
+  int Capacity;
+  int NumberOfBlocks;
+  vtkstd::vector<unsigned char> Input;
+  vtkstd::vector<unsigned char> Output;
+  vtkstd::vector<unsigned long> InputSizes;
+  vtkstd::vector<unsigned long> OutputSizes;
+};
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkXMLWriterCompressBlocks(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkXMLWriterCompressionQueue* queue =
+    static_cast<vtkXMLWriterCompressionQueue*>(info->UserData);
+
+  // Each thread takes every n-th block.
+  for(int i = info->ThreadID; i < queue->NumberOfBlocks;
+      i += info->NumberOfThreads)
+    {
+    queue->OutputSizes[i] = queue->Compressor->Compress(
+      &queue->Input[i*queue->BlockSize], queue->InputSizes[i],
+      &queue->Output[i*queue->CompressionSpace], queue->CompressionSpace);
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 //----------------------------------------------------------------------------
 template <class iterT>
 int vtkXMLWriterWriteBinaryDataBlocks(vtkXMLWriter* writer,
@@ -242,6 +297,8 @@ vtkXMLWriter::vtkXMLWriter()
   this->BlockSize = 32768; //2^15
   this->Compressor = vtkZLibDataCompressor::New();
   this->CompressionHeader = 0;
+  this->NumberOfThreads = 1;
+  this->CompressionQueue = 0;
   this->Int32IdTypeBuffer = 0;
   this->ByteSwapBuffer = 0;
 
@@ -273,6 +330,7 @@ vtkXMLWriter::~vtkXMLWriter()
   this->SetFileName(0);
   this->DataStream->Delete();
   this->SetCompressor(0);
+  delete this->CompressionQueue;
   delete this->OutFile;
 
   delete this->FieldDataOM;
@@ -295,7 +353,11 @@ void vtkXMLWriter::SetCompressorType(int compressorType)
 
   if (compressorType == ZLIB)
     {
-    if (this->Compressor && !this->Compressor->IsTypeOf("vtkZLibDataCompressor"))
+    if (this->Compressor && this->Compressor->IsTypeOf("vtkZLibDataCompressor"))
+      {
+      return;
+      }
+    if (this->Compressor)
       {
       this->Compressor->Delete();
       }
@@ -304,6 +366,22 @@ void vtkXMLWriter::SetCompressorType(int compressorType)
     this->Modified();
     return;
     }
+
+  if (compressorType == LZ4)
+    {
+    if (this->Compressor && this->Compressor->IsTypeOf("vtkLZ4DataCompressor"))
+      {
+      return;
+      }
+    if (this->Compressor)
+      {
+      this->Compressor->Delete();
+      }
+
+    this->Compressor = vtkLZ4DataCompressor::New();
+    this->Modified();
+    return;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -350,6 +428,7 @@ void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
     }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
   if(this->Stream)
     {
     os << indent << "Stream: " << this->Stream << "\n";
@@ -959,6 +1038,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       {
       result = 0;
       }
+
+    // Compress and write the blocks still queued for the threads.
+    if (!this->FlushCompressionBlocks())
+      {
+      result = 0;
+      }
     
     // Finish writing the data.
     if(result && !this->DataStream->EndWriting())
@@ -1277,6 +1362,36 @@ int vtkXMLWriter::CreateCompressionHeader(OffsetType size)
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data,
                                         OffsetType size)
 {
+  // With several threads, queue the block to be compressed with others.
+  if(this->NumberOfThreads > 1)
+    {
+    if(!this->CompressionQueue)
+      {
+      this->CompressionQueue = new vtkXMLWriterCompressionQueue;
+      }
+    vtkXMLWriterCompressionQueue* queue = this->CompressionQueue;
+    if(queue->NumberOfBlocks == 0)
+      {
+      queue->Compressor = this->Compressor;
+      queue->BlockSize = this->BlockSize;
+      queue->CompressionSpace =
+        this->Compressor->GetMaximumCompressionSpace(this->BlockSize);
+      queue->Capacity = 8*this->NumberOfThreads;
+      queue->Input.resize(queue->Capacity*queue->BlockSize);
+      queue->Output.resize(queue->Capacity*queue->CompressionSpace);
+      queue->InputSizes.resize(queue->Capacity);
+      queue->OutputSizes.resize(queue->Capacity);
+      }
+    int i = queue->NumberOfBlocks++;
+    memcpy(&queue->Input[i*queue->BlockSize], data, size);
+    queue->InputSizes[i] = static_cast<unsigned long>(size);
+    if(queue->NumberOfBlocks == queue->Capacity)
+      {
+      return this->FlushCompressionBlocks();
+      }
+    return 1;
+    }
+
   // Compress the data.
   vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
 
@@ -1300,6 +1415,49 @@ int vtkXMLWriter::WriteCompressionBlock(unsigned char* data,
   return result;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  vtkXMLWriterCompressionQueue* queue = this->CompressionQueue;
+  if(!queue || queue->NumberOfBlocks == 0)
+    {
+    return 1;
+    }
+
+  // Compress the queued blocks concurrently.
+  int numThreads = this->NumberOfThreads;
+  if(numThreads > queue->NumberOfBlocks)
+    {
+    numThreads = queue->NumberOfBlocks;
+    }
+  queue->Threader->SetNumberOfThreads(numThreads);
+  queue->Threader->SetSingleMethod(vtkXMLWriterCompressBlocks, queue);
+  queue->Threader->SingleMethodExecute();
+
+  // Write them in order, storing their compressed sizes in the header.
+  int result = 1;
+  for(int i = 0; result && i < queue->NumberOfBlocks; ++i)
+    {
+    HeaderType outputSize = queue->OutputSizes[i];
+    if(!outputSize ||
+       !this->DataStream->Write(&queue->Output[i*queue->CompressionSpace],
+                                outputSize))
+      {
+      result = 0;
+      }
+    this->CompressionHeader[3+this->CompressionBlockNumber++] = outputSize;
+    }
+  queue->NumberOfBlocks = 0;
+
+  this->Stream->flush();
+  if (this->Stream->fail())
+    {
+    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 0;
+    }
+  return result;
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionHeader()
 {
@@ -1763,6 +1921,20 @@ void vtkXMLWriter::WriteArrayAppended(
 void vtkXMLWriter::WriteArrayAppendedData(vtkAbstractArray* a,
   OffsetType pos, OffsetType& lastoffset)
 {
+  // Pad raw data so that the values after the size header are aligned
+  // in the file.  The offset written skips the padding.
+  if(!this->EncodeAppendedData && !this->Compressor &&
+     vtkDataArray::SafeDownCast(a))
+    {
+    ostream& os = *(this->Stream);
+    OffsetType wordSize = this->GetOutputWordTypeSize(a->GetDataType());
+    OffsetType start = static_cast<OffsetType>(os.tellp()) +
+      static_cast<OffsetType>(sizeof(HeaderType));
+    for(OffsetType i = 0; wordSize > 1 && (start + i) % wordSize; ++i)
+      {
+      os.put(0);
+      }
+    }
   this->WriteAppendedDataOffset(pos, lastoffset, "offset");
   this->WriteBinaryData(a); 
 }
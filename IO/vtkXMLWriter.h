@@ -40,6 +40,7 @@ class vtkPoints;
 class vtkFieldData;
 //BTX
 class vtkStdString;
+class vtkXMLWriterCompressionQueue;
 class OffsetsManager;      // one per piece/per time
 class OffsetsManagerGroup; // array of OffsetsManager
 class OffsetsManagerArray; // array of OffsetsManagerGroup
@@ -114,7 +115,8 @@ public:
   enum CompressorType
     {
     NONE,
-    ZLIB
+    ZLIB,
+    LZ4
     };
 //ETX
 
@@ -129,6 +131,10 @@ public:
     {
     this->SetCompressorType(ZLIB);
     }
+  void SetCompressorTypeToLZ4()
+    {
+    this->SetCompressorType(LZ4);
+    }
 
   // Description:
   // Get/Set the block size used in compression.  When reading, this
@@ -137,6 +143,17 @@ public:
   // be a multiple of the largest scalar data type.
   virtual void SetBlockSize(unsigned int blockSize);
   vtkGetMacro(BlockSize, unsigned int);
+
+  // Description:
+  // Set/Get the number of threads used to compress the data, with 1
+  // (serial compression) as the default value.  With more than one
+  // thread, batches of blocks are compressed concurrently and then
+  // written in order, so the file does not depend on the number of
+  // threads.  The compressor must support being called from several
+  // threads at once, which vtkZLibDataCompressor and
+  // vtkLZ4DataCompressor do.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
   
   // Description:
   // Get/Set the data mode used for the file's data.  The options are
@@ -153,7 +170,10 @@ public:
   // encoded, reading and writing will be slower, but the file will be
   // fully valid XML and text-only.  If not encoded, the XML
   // specification will be violated, but reading and writing will be
-  // fast.  The default is to do the encoding.
+  // fast.  Raw data that are not compressed are padded so that each
+  // array starts aligned in the file, which lets readers map the file
+  // into memory and use the arrays in place.  The default is to do the
+  // encoding.
   vtkSetMacro(EncodeAppendedData, int);
   vtkGetMacro(EncodeAppendedData, int);
   vtkBooleanMacro(EncodeAppendedData, int);
@@ -280,6 +300,10 @@ protected:
   HeaderType*    CompressionHeader;
   unsigned int   CompressionHeaderLength;
   OffsetType  CompressionHeaderPosition;
+
+  // The blocks waiting to be compressed by the threads.
+  int NumberOfThreads;
+  vtkXMLWriterCompressionQueue* CompressionQueue;
   
   // The output stream used to write binary and appended data.  May
   // transparently encode the data.
@@ -416,6 +440,7 @@ protected:
   void PerformByteSwap(void* data, OffsetType numWords, int wordSize);
   int CreateCompressionHeader(OffsetType size);
   int WriteCompressionBlock(unsigned char* data, OffsetType size);
+  int FlushCompressionBlocks();
   int WriteCompressionHeader();
   OffsetType GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
@@ -0,0 +1,35 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    DummyCompositers.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkDummyController.h"
+
+#include "ExerciseCompositers.h"
+
+#include "vtkSmartPointer.h"
+#define VTK_CREATE(type, name) \
+  vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
+
+int DummyCompositers(int argc, char* argv[])
+{
+  VTK_CREATE(vtkDummyController, controller);
+
+  controller->Initialize(&argc, &argv, 1);
+
+  int retval = ExerciseCompositers(controller, 300, 200, 1);
+
+  controller->Finalize();
+
+  return retval;
+}
@@ -0,0 +1,202 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    ExerciseCompositers.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "ExerciseCompositers.h"
+
+#include "vtkCompressCompositer.h"
+#include "vtkFloatArray.h"
+#include "vtkMultiProcessController.h"
+#include "vtkRadixKCompositer.h"
+#include "vtkTimerLog.h"
+#include "vtkTreeCompositer.h"
+#include "vtkUnsignedCharArray.h"
+
+#include "vtkSmartPointer.h"
+#define VTK_CREATE(type, name) \
+  vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
+
+// Fills p and z with the image of process id: a disc over the
+// background, placed differently on every process.  Depths are quantized
+// so that pairs of processes tie on many pixels.
+static void FillImage(int id, int numProcs, int width, int height,
+                      vtkDataArray *p, vtkFloatArray *z)
+{
+  int numComps = p->GetNumberOfComponents();
+  double cx = width * (0.25 + 0.5 * (id + 0.5) / numProcs);
+  double cy = height * 0.5;
+  double r = 0.35 * (width < height ? width : height);
+  for (int y = 0; y < height; y++)
+    {
+    for (int x = 0; x < width; x++)
+      {
+      vtkIdType i = static_cast<vtkIdType>(y) * width + x;
+      double dx = x - cx;
+      double dy = y - cy;
+      if (dx * dx + dy * dy < r * r)
+        {
+        z->SetValue(i, 0.1f + 0.1f * ((x / 4 + y / 4 + id / 2) % 8));
+        }
+      else
+        {
+        z->SetValue(i, 1.0f);
+        }
+      for (int c = 0; c < numComps; c++)
+        {
+        p->SetComponent(i, c, (id * 37 + c * 71 + x + y) % 256);
+        }
+      }
+    }
+}
+
+// The expected image on process 0: the nearest pixel of all processes,
+// the one of the lowest process on a tie.
+static void CompositeSerially(int numProcs, int width, int height,
+                              vtkDataArray *p, vtkFloatArray *z,
+                              vtkDataArray *tmpP, vtkFloatArray *tmpZ)
+{
+  FillImage(0, numProcs, width, height, p, z);
+  for (int id = 1; id < numProcs; id++)
+    {
+    FillImage(id, numProcs, width, height, tmpP, tmpZ);
+    for (vtkIdType i = 0; i < z->GetNumberOfTuples(); i++)
+      {
+      if (tmpZ->GetValue(i) < z->GetValue(i))
+        {
+        z->SetValue(i, tmpZ->GetValue(i));
+        p->SetTuple(i, i, tmpP);
+        }
+      }
+    }
+}
+
+static int CompareImages(vtkDataArray *p1, vtkFloatArray *z1,
+                         vtkDataArray *p2, vtkFloatArray *z2)
+{
+  int numComps = p1->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < z1->GetNumberOfTuples(); i++)
+    {
+    if (z1->GetValue(i) != z2->GetValue(i))
+      {
+      return 0;
+      }
+    for (int c = 0; c < numComps; c++)
+      {
+      if (p1->GetComponent(i, c) != p2->GetComponent(i, c))
+        {
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+static vtkDataArray *NewColors(int dataType, int numComps, vtkIdType size)
+{
+  vtkDataArray *p;
+  if (dataType == VTK_FLOAT)
+    {
+    p = vtkFloatArray::New();
+    }
+  else
+    {
+    p = vtkUnsignedCharArray::New();
+    }
+  p->SetNumberOfComponents(numComps);
+  p->SetNumberOfTuples(size);
+  return p;
+}
+
+int ExerciseCompositers(vtkMultiProcessController *controller,
+                        int width, int height, int iterations)
+{
+  int myId = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+  vtkIdType size = static_cast<vtkIdType>(width) * height;
+  int retVal = 0;
+
+  const int numCompositers = 5;
+  const char *names[numCompositers] = {
+    "vtkTreeCompositer", "vtkCompressCompositer",
+    "vtkRadixKCompositer (radix 2)", "vtkRadixKCompositer (radix 4)",
+    "vtkRadixKCompositer (radix 8)" };
+  vtkSmartPointer<vtkCompositer> compositers[numCompositers];
+  compositers[0] = vtkSmartPointer<vtkTreeCompositer>::New();
+  compositers[1] = vtkSmartPointer<vtkCompressCompositer>::New();
+  for (int k = 0; k < 3; k++)
+    {
+    VTK_CREATE(vtkRadixKCompositer, radixK);
+    radixK->SetRadix(2 << k);
+    compositers[2 + k] = radixK;
+    }
+
+  // The pixel types of vtkCompositeRenderManager.
+  const int numTypes = 3;
+  int dataTypes[numTypes] = { VTK_UNSIGNED_CHAR, VTK_UNSIGNED_CHAR,
+                              VTK_FLOAT };
+  int numComps[numTypes] = { 4, 3, 4 };
+  for (int t = 0; t < numTypes; t++)
+    {
+    vtkSmartPointer<vtkDataArray> p, tmpP, expectedP;
+    p.TakeReference(NewColors(dataTypes[t], numComps[t], size));
+    tmpP.TakeReference(NewColors(dataTypes[t], numComps[t], size));
+    expectedP.TakeReference(NewColors(dataTypes[t], numComps[t], size));
+    VTK_CREATE(vtkFloatArray, z);
+    VTK_CREATE(vtkFloatArray, tmpZ);
+    VTK_CREATE(vtkFloatArray, expectedZ);
+    z->SetNumberOfTuples(size);
+    tmpZ->SetNumberOfTuples(size);
+    expectedZ->SetNumberOfTuples(size);
+    if (myId == 0)
+      {
+      CompositeSerially(numProcs, width, height, expectedP, expectedZ,
+                        tmpP, tmpZ);
+      }
+
+    for (int c = 0; c < numCompositers; c++)
+      {
+      compositers[c]->SetController(controller);
+      double best = VTK_DOUBLE_MAX;
+      for (int i = 0; i < iterations; i++)
+        {
+        FillImage(myId, numProcs, width, height, p, z);
+        controller->Barrier();
+        double start = vtkTimerLog::GetUniversalTime();
+        compositers[c]->CompositeBuffer(p, z, tmpP, tmpZ);
+        double elapsed = vtkTimerLog::GetUniversalTime() - start;
+        best = (elapsed < best) ? elapsed : best;
+        }
+      double slowest = best;
+      controller->Reduce(&best, &slowest, 1, vtkCommunicator::MAX_OP, 0);
+
+      // The compress compositer does not keep the pixel of the lowest
+      // process on a tie, so only its time is of interest.
+      if (myId == 0 && c != 1 && !CompareImages(expectedP, expectedZ, p, z))
+        {
+        cerr << names[c] << " produced a wrong image with "
+             << numComps[t] << " components of type " << dataTypes[t]
+             << "." << endl;
+        retVal = 1;
+        }
+      if (myId == 0 && t == 0)
+        {
+        cout << names[c] << ": " << slowest << " s for " << width << "x"
+             << height << " pixels on " << numProcs << " processes" << endl;
+        }
+      }
+    }
+
+  controller->Broadcast(&retVal, 1, 0);
+  return retVal;
+}
@@ -0,0 +1,24 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    ExerciseCompositers.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+class vtkMultiProcessController;
+
+// Composites synthetic images of width by height pixels with the image
+// compositers, checks the results on process 0 against compositing the
+// images in one process and prints the best time of the given number of
+// iterations of each compositer.  Returns 0 on success (so that it may be
+// passed back from the main application).
+int ExerciseCompositers(vtkMultiProcessController *controller,
+                        int width, int height, int iterations);
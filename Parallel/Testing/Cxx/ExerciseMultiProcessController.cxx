@@ -18,9 +18,12 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
+#include "vtkCommunicator.h"
+#include "vtkCommunicatorRequest.h"
 #include "vtkDataArray.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkImageGaussianSource.h"
@@ -31,10 +34,13 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkProcessGroup.h"
+#include "vtkShrinkFilter.h"
 #include "vtkSphereSource.h"
+#include "vtkStructuredGrid.h"
 #include "vtkTypeTraits.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedLongArray.h"
+#include "vtkUnstructuredGrid.h"
 
 #include <string.h>
 #include <time.h>
@@ -235,8 +241,38 @@ static int CompareDataSetAttributes(vtkDataSetAttributes *dsa1,
   return CompareFieldData(dsa1, dsa2);
 }
 
+// Compares cells point id by point id, so that cells stored as offsets and
+// connectivity are not converted to the legacy storage, and checks that the
+// cells are stored the same way.
+static int CompareCells(vtkCellArray *cells1, vtkCellArray *cells2)
+{
+  if (   (cells1->GetNumberOfCells() != cells2->GetNumberOfCells())
+      || (cells1->IsStorageOffsets() != cells2->IsStorageOffsets())
+      || (cells1->GetIdWidth() != cells2->GetIdWidth()) )
+    {
+    vtkGenericWarningMacro("Cells are not stored alike.");
+    return 0;
+    }
+  VTK_CREATE(vtkIdList, ptIds1);
+  VTK_CREATE(vtkIdList, ptIds2);
+  for (vtkIdType cellId = 0; cellId < cells1->GetNumberOfCells(); cellId++)
+    {
+    cells1->GetCellAtId(cellId, ptIds1);
+    cells2->GetCellAtId(cellId, ptIds2);
+    if (   (ptIds1->GetNumberOfIds() != ptIds2->GetNumberOfIds())
+        || !CompareArrays(ptIds1->GetPointer(0), ptIds2->GetPointer(0),
+                          ptIds1->GetNumberOfIds()) )
+      {
+      vtkGenericWarningMacro("Cell " << cellId << " does not agree.");
+      return 0;
+      }
+    }
+  return 1;
+}
+
 // This is not a complete comparison.  There are plenty of things not actually
-// checked.  It only checks vtkImageData and vtkPolyData in detail.
+// checked.  It only checks vtkImageData, vtkPolyData and vtkUnstructuredGrid
+// in detail.
 static int CompareDataObjects(vtkDataObject *obj1, vtkDataObject *obj2)
 {
   if (obj1->GetDataObjectType() != obj2->GetDataObjectType())
@@ -308,6 +344,17 @@ static int CompareDataObjects(vtkDataObject *obj1, vtkDataObject *obj2)
       if (!CompareDataArrays(pd1->GetStrips()->GetData(),
                              pd2->GetStrips()->GetData())) return 0;
       }
+
+    vtkUnstructuredGrid *ug1 = vtkUnstructuredGrid::SafeDownCast(ps1);
+    vtkUnstructuredGrid *ug2 = vtkUnstructuredGrid::SafeDownCast(ps2);
+    if (ug1 && ug2)
+      {
+      if (!CompareCells(ug1->GetCells(), ug2->GetCells())) return 0;
+      if (!CompareDataArrays(ug1->GetCellTypesArray(),
+                             ug2->GetCellTypesArray())) return 0;
+      if (!CompareDataArrays(ug1->GetCellLocationsArray(),
+                             ug2->GetCellLocationsArray())) return 0;
+      }
     }
 
   return 1;
@@ -1073,6 +1120,202 @@ static void ExerciseDataObject(vtkMultiProcessController *controller,
   controller->Broadcast(buffer, srcProcessId);
   result = CompareDataObjects(source, buffer);
   CheckSuccess(controller, result);
+
+  COUT("Broadcast vtkDataObject into one of another type");
+  VTK_CREATE(vtkStructuredGrid, wrongType);
+  result = controller->Broadcast(rank == srcProcessId ? source : wrongType,
+                                 srcProcessId);
+  // The legacy format only warns about the mismatch.
+  if (rank != srcProcessId)
+    {
+    result = !result || !vtkCommunicator::GetUseNativeMarshaling();
+    }
+  // The failed broadcast must not have left values for the next one.
+  buffer->Initialize();
+  if (rank == srcProcessId)
+    {
+    buffer->DeepCopy(source);
+    }
+  controller->Broadcast(buffer, srcProcessId);
+  result &= CompareDataObjects(source, buffer);
+  CheckSuccess(controller, result);
+}
+
+//-----------------------------------------------------------------------------
+// Check the nonblocking functions.
+static void ExerciseNoBlock(vtkMultiProcessController *controller,
+                            vtkDataObject *source)
+{
+  COUT("---- Exercising nonblocking requests");
+
+  int rank = controller->GetLocalProcessId();
+  int numProc = controller->GetNumberOfProcesses();
+  int result;
+  int i, j;
+  vtkCommunicatorRequest *requests[4];
+
+  const int arraySize = 8;
+  VTK_CREATE(vtkDoubleArray, sourceArray);
+  sourceArray->SetNumberOfTuples(arraySize);
+  for (j = 0; j < arraySize; j++)
+    {
+    sourceArray->SetValue(j, vtkMath::Random(-16.0, 16.0));
+    }
+  VTK_CREATE(vtkDoubleArray, arrayBuffer);
+  vtkSmartPointer<vtkDataObject> objectBuffer;
+  objectBuffer.TakeReference(source->NewInstance());
+
+  COUT("Nonblocking send and receive.");
+  result = 1;
+  for (i = 0; i < numProc; i++)
+    {
+    if (i == rank) continue;
+    objectBuffer->Initialize();
+    if (i < rank)
+      {
+      requests[0] = controller->NoBlockReceive(arrayBuffer, i, 9876);
+      requests[1] = controller->NoBlockReceive(objectBuffer, i, 9877);
+      requests[2] = controller->NoBlockSend(sourceArray, i, 5432);
+      requests[3] = controller->NoBlockSend(source, i, 5433);
+      }
+    else
+      {
+      requests[0] = controller->NoBlockSend(sourceArray, i, 9876);
+      requests[1] = controller->NoBlockSend(source, i, 9877);
+      requests[2] = controller->NoBlockReceive(arrayBuffer, i, 5432);
+      requests[3] = controller->NoBlockReceive(objectBuffer, i, 5433);
+      }
+    result &= vtkCommunicatorRequest::WaitAll(4, requests);
+    for (j = 0; j < 4; j++)
+      {
+      result &= requests[j]->GetCompleted();
+      requests[j]->Delete();
+      }
+    result &= CompareDataArrays(sourceArray, arrayBuffer);
+    result &= CompareDataObjects(source, objectBuffer);
+    }
+  CheckSuccess(controller, result);
+
+  COUT("Symmetric nonblocking exchange.");
+  // Every process posts its receives before its sends, so a send must not
+  // wait for the receives issued before it.
+  result = 1;
+  vtkstd::vector<vtkSmartPointer<vtkDoubleArray> > arrayBuffers(numProc);
+  vtkstd::vector<vtkSmartPointer<vtkDataObject> > objectBuffers(numProc);
+  vtkstd::vector<vtkCommunicatorRequest *> exchange;
+  for (i = 0; i < numProc; i++)
+    {
+    if (i == rank) continue;
+    arrayBuffers[i] = vtkSmartPointer<vtkDoubleArray>::New();
+    objectBuffers[i].TakeReference(source->NewInstance());
+    exchange.push_back(controller->NoBlockReceive(arrayBuffers[i], i, 6543));
+    exchange.push_back(controller->NoBlockReceive(objectBuffers[i], i, 6544));
+    }
+  for (i = 0; i < numProc; i++)
+    {
+    if (i == rank) continue;
+    exchange.push_back(controller->NoBlockSend(sourceArray, i, 6543));
+    exchange.push_back(controller->NoBlockSend(source, i, 6544));
+    }
+  if (!exchange.empty())
+    {
+    result &= vtkCommunicatorRequest::WaitAll(
+      static_cast<int>(exchange.size()), &exchange[0]);
+    }
+  for (j = 0; j < static_cast<int>(exchange.size()); j++)
+    {
+    result &= exchange[j]->GetCompleted();
+    exchange[j]->Delete();
+    }
+  for (i = 0; i < numProc; i++)
+    {
+    if (i == rank) continue;
+    result &= CompareDataArrays(sourceArray, arrayBuffers[i]);
+    result &= CompareDataObjects(source, objectBuffers[i]);
+    }
+  CheckSuccess(controller, result);
+
+  COUT("Symmetric nonblocking exchange of large arrays.");
+  // Messages of 2 MB are beyond what transports buffer, so blocking sends
+  // in both directions would deadlock.
+  result = 1;
+  const vtkIdType largeSize = 1 << 18;
+  VTK_CREATE(vtkDoubleArray, largeArray);
+  largeArray->SetNumberOfTuples(largeSize);
+  for (j = 0; j < largeSize; j++)
+    {
+    largeArray->SetValue(j, rank + j);
+    }
+  exchange.clear();
+  for (i = 0; i < numProc; i++)
+    {
+    if (i == rank) continue;
+    arrayBuffers[i] = vtkSmartPointer<vtkDoubleArray>::New();
+    arrayBuffers[i]->SetNumberOfTuples(largeSize);
+    exchange.push_back(controller->GetCommunicator()->NoBlockReceiveVoidArray(
+      arrayBuffers[i]->GetPointer(0), largeSize, VTK_DOUBLE, i, 6545));
+    }
+  for (i = 0; i < numProc; i++)
+    {
+    if (i == rank) continue;
+    exchange.push_back(controller->GetCommunicator()->NoBlockSendVoidArray(
+      largeArray->GetPointer(0), largeSize, VTK_DOUBLE, i, 6545));
+    }
+  if (!exchange.empty())
+    {
+    result &= vtkCommunicatorRequest::WaitAll(
+      static_cast<int>(exchange.size()), &exchange[0]);
+    }
+  for (j = 0; j < static_cast<int>(exchange.size()); j++)
+    {
+    exchange[j]->Delete();
+    }
+  for (i = 0; i < numProc; i++)
+    {
+    if (i == rank) continue;
+    for (j = 0; j < largeSize; j += 4099)
+      {
+      result &= (arrayBuffers[i]->GetValue(j) == i + j);
+      }
+    result &= (arrayBuffers[i]->GetValue(largeSize - 1) == i + largeSize - 1);
+    }
+  CheckSuccess(controller, result);
+
+  COUT("Cancel a receive that is never matched.");
+  requests[0] = controller->NoBlockReceive(
+    arrayBuffer, vtkMultiProcessController::ANY_SOURCE, 7654);
+  requests[0]->Cancel();
+  result = requests[0]->GetCompleted() && !requests[0]->GetStatus() &&
+    !requests[0]->GetQueued();
+  requests[0]->Delete();
+  CheckSuccess(controller, result);
+
+  COUT("Nonblocking broadcast and all reduce.");
+  objectBuffer->Initialize();
+  int srcProcessId = static_cast<int>(vtkMath::Random(0.0, numProc - 0.01));
+  if (rank == srcProcessId)
+    {
+    objectBuffer->DeepCopy(source);
+    }
+  VTK_CREATE(vtkIntArray, reduceSource);
+  reduceSource->SetNumberOfTuples(1);
+  reduceSource->SetValue(0, rank + 1);
+  VTK_CREATE(vtkIntArray, reduceBuffer);
+  reduceBuffer->SetNumberOfTuples(1);
+  requests[0] = controller->NoBlockBroadcast(objectBuffer, srcProcessId);
+  requests[1] = controller->NoBlockAllReduce(reduceSource, reduceBuffer,
+                                             vtkCommunicator::SUM_OP);
+  requests[2] = controller->NoBlockBarrier();
+  // Waiting on the last request completes the ones issued before it.
+  result = requests[2]->Wait();
+  for (j = 0; j < 3; j++)
+    {
+    result &= requests[j]->GetCompleted() && requests[j]->GetStatus();
+    requests[j]->Delete();
+    }
+  result &= CompareDataObjects(source, objectBuffer);
+  result &= (reduceBuffer->GetValue(0) == numProc*(numProc+1)/2);
+  CheckSuccess(controller, result);
 }
 
 //-----------------------------------------------------------------------------
@@ -1105,6 +1348,31 @@ static void Run(vtkMultiProcessController *controller, void *_args)
     polySource->Update();
     ExerciseDataObject(controller, polySource->GetOutput(),
                        vtkSmartPointer<vtkPolyData>::New());
+
+    VTK_CREATE(vtkShrinkFilter, gridSource);
+    gridSource->SetInputConnection(imageSource->GetOutputPort());
+    gridSource->Update();
+    ExerciseDataObject(controller, gridSource->GetOutput(),
+                       vtkSmartPointer<vtkUnstructuredGrid>::New());
+
+    COUT("---- Cells stored as offsets and connectivity");
+    VTK_CREATE(vtkUnstructuredGrid, offsetsGrid);
+    offsetsGrid->DeepCopy(gridSource->GetOutput());
+    offsetsGrid->GetCells()->SetStorageToOffsets(32);
+    ExerciseDataObject(controller, offsetsGrid,
+                       vtkSmartPointer<vtkUnstructuredGrid>::New());
+    ExerciseNoBlock(controller, offsetsGrid);
+    // Sending the cells must not have converted them.
+    CheckSuccess(controller, offsetsGrid->GetCells()->IsStorageOffsets());
+
+    ExerciseNoBlock(controller, polySource->GetOutput());
+
+    COUT("---- Marshaling data objects in the legacy format");
+    vtkCommunicator::SetUseNativeMarshaling(0);
+    ExerciseDataObject(controller, polySource->GetOutput(),
+                       vtkSmartPointer<vtkPolyData>::New());
+    ExerciseNoBlock(controller, polySource->GetOutput());
+    vtkCommunicator::SetUseNativeMarshaling(1);
     }
   catch (ExerciseMultiProcessControllerError)
     {
@@ -0,0 +1,63 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    MPICompositers.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks and times the image compositers over MPI.  The optional
+// arguments are the width and height of the images and the number of
+// iterations to time, for instance
+//   mpirun -np 8 TestMPICompositers 1920 1080 10
+
+#include <mpi.h>
+
+#include "vtkMPIController.h"
+#include "vtkProcessGroup.h"
+
+#include "ExerciseCompositers.h"
+
+#include <stdlib.h>
+
+#include "vtkSmartPointer.h"
+#define VTK_CREATE(type, name) \
+  vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
+
+int main(int argc, char** argv)
+{
+  MPI_Init(&argc, &argv);
+
+  VTK_CREATE(vtkMPIController, controller);
+
+  controller->Initialize(&argc, &argv, 1);
+
+  int width = (argc > 2) ? atoi(argv[1]) : 300;
+  int height = (argc > 2) ? atoi(argv[2]) : 200;
+  int iterations = (argc > 3) ? atoi(argv[3]) : 1;
+
+  int retval = ExerciseCompositers(controller, width, height, iterations);
+
+  // Run again over the generic vtkCommunicator implementation, whose
+  // nonblocking requests are carried out one after the other.
+  VTK_CREATE(vtkProcessGroup, group);
+  group->Initialize(controller);
+  vtkSmartPointer<vtkMultiProcessController> genericController;
+  genericController.TakeReference(
+             controller->vtkMultiProcessController::CreateSubController(group));
+  if (!retval)
+    {
+    retval = ExerciseCompositers(genericController, width, height,
+                                 iterations);
+    }
+
+  controller->Finalize();
+
+  return retval;
+}
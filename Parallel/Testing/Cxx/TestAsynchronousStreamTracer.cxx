@@ -0,0 +1,169 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAsynchronousStreamTracer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Integrates the same streamlines on a distributed vortex with
+// vtkDistributedStreamTracer and vtkAsynchronousStreamTracer and checks
+// that both produce the same points.
+
+#include <mpi.h>
+
+#include "vtkAsynchronousStreamTracer.h"
+#include "vtkDistributedStreamTracer.h"
+#include "vtkDoubleArray.h"
+#include "vtkExtentTranslator.h"
+#include "vtkImageData.h"
+#include "vtkLineSource.h"
+#include "vtkMPIController.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+
+#include "vtkSmartPointer.h"
+#define VTK_CREATE(type, name) \
+  vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
+
+// Sum up the number of points and cells, the coordinates of the points and
+// their integration time over all processes.
+static void GlobalSums(vtkMultiProcessController *controller,
+                       vtkPolyData *output, double sums[6])
+{
+  double local[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  local[0] = output->GetNumberOfPoints();
+  local[1] = output->GetNumberOfCells();
+  vtkDataArray *time = output->GetPointData()->GetArray("IntegrationTime");
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); i++)
+    {
+    double *pt = output->GetPoint(i);
+    local[2] += pt[0];
+    local[3] += pt[1];
+    local[4] += pt[2];
+    local[5] += time ? time->GetTuple1(i) : 0.0;
+    }
+  controller->AllReduce(local, sums, 6, vtkCommunicator::SUM_OP);
+}
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  VTK_CREATE(vtkMPIController, controller);
+  controller->Initialize(&argc, &argv, 1);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int myId = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+
+  // A vortex around the z axis, cut in slabs along x.
+  int wholeExtent[6] = { 0, 40, 0, 40, 0, 10 };
+  VTK_CREATE(vtkExtentTranslator, translator);
+  translator->SetWholeExtent(wholeExtent);
+  translator->SetNumberOfPieces(numProcs);
+  translator->SetPiece(myId);
+  translator->SetGhostLevel(0);
+  translator->SetSplitModeToXSlab();
+  translator->PieceToExtent();
+
+  VTK_CREATE(vtkImageData, image);
+  image->SetExtent(translator->GetExtent());
+  image->SetSpacing(0.25, 0.25, 0.25);
+  image->SetOrigin(-5.0, -5.0, 0.0);
+  VTK_CREATE(vtkDoubleArray, velocity);
+  velocity->SetName("Velocity");
+  velocity->SetNumberOfComponents(3);
+  velocity->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); i++)
+    {
+    double *pt = image->GetPoint(i);
+    velocity->SetTuple3(i, -pt[1], pt[0], 0.1);
+    }
+  image->GetPointData()->SetVectors(velocity);
+
+  VTK_CREATE(vtkLineSource, seeds);
+  seeds->SetPoint1(0.5, 0.1, 0.5);
+  seeds->SetPoint2(4.5, 0.1, 0.5);
+  seeds->SetResolution(12);
+  seeds->Update();
+
+  VTK_CREATE(vtkDistributedStreamTracer, distributed);
+  VTK_CREATE(vtkAsynchronousStreamTracer, asynchronous);
+  asynchronous->SetParticleBatchSize(2);
+  vtkPStreamTracer *tracers[2] = { distributed, asynchronous };
+  double sums[2][6];
+  for (int t = 0; t < 2; t++)
+    {
+    tracers[t]->SetController(controller);
+    tracers[t]->SetInput(image);
+    tracers[t]->SetSource(seeds->GetOutput());
+    tracers[t]->SetInputArrayToProcess(
+      0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Velocity");
+    tracers[t]->SetIntegratorTypeToRungeKutta45();
+    tracers[t]->SetIntegrationDirectionToBoth();
+    tracers[t]->SetMaximumPropagation(40);
+    tracers[t]->SetMaximumNumberOfSteps(2000);
+    tracers[t]->SetComputeVorticity(true);
+    tracers[t]->Update();
+    GlobalSums(controller, tracers[t]->GetOutput(), sums[t]);
+    }
+
+  // Integrate again: no receive of the first update may be left to take
+  // the messages of the second one.
+  double again[6];
+  asynchronous->Modified();
+  asynchronous->Update();
+  GlobalSums(controller, asynchronous->GetOutput(), again);
+
+  int retVal = 0;
+  for (int i = 0; i < 6; i++)
+    {
+    if (again[i] != sums[1][i])
+      {
+      cerr << "Process " << myId << ": sum " << i << " differs on the "
+           << "second update, " << again[i] << " != " << sums[1][i] << endl;
+      retVal = 1;
+      }
+    }
+  if (sums[0][0] < 100 || sums[0][1] <= numProcs)
+    {
+    cerr << "Process " << myId << ": too few streamlines were integrated."
+         << endl;
+    retVal = 1;
+    }
+  // The coordinates may differ by round off, as the interpolator
+  // searches cells from different places.
+  for (int i = 0; i < 6; i++)
+    {
+    double tol = 1.0e-6 * (fabs(sums[0][i]) + sums[0][0]);
+    if (fabs(sums[0][i] - sums[1][i]) > tol)
+      {
+      cerr << "Process " << myId << ": sum " << i << " differs, "
+           << sums[0][i] << " != " << sums[1][i] << endl;
+      retVal = 1;
+      }
+    }
+  if (asynchronous->GetIdleTime() < 0.0)
+    {
+    cerr << "Process " << myId << ": negative idle time." << endl;
+    retVal = 1;
+    }
+  if (myId == 0)
+    {
+    cout << "Points: " << sums[1][0] << " Lines: " << sums[1][1] << endl;
+    }
+  cout << "Process " << myId << " idle time: "
+       << asynchronous->GetIdleTime() << " s" << endl;
+
+  vtkMultiProcessController::SetGlobalController(0);
+  controller->Finalize();
+
+  return retVal;
+}
@@ -0,0 +1,872 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsynchronousStreamTracer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAsynchronousStreamTracer.h"
+
+#include "vtkAbstractInterpolatedVelocityField.h"
+#include "vtkCellData.h"
+#include "vtkCommunicator.h"
+#include "vtkCommunicatorRequest.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRungeKutta2.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <vtkstd/deque>
+#include <vtkstd/list>
+#include <vtkstd/vector>
+
+vtkStandardNewMacro(vtkAsynchronousStreamTracer);
+
+//----------------------------------------------------------------------------
+// Every message is a header of HEADER_SIZE doubles, {type, sender, count,
+// payload length}, followed by a payload of doubles on PAYLOAD_TAG when the
+// payload length is not zero.
+enum
+{
+  HEADER_TAG = 381,
+  PAYLOAD_TAG = 382,
+  HEADER_SIZE = 4
+};
+
+enum
+{
+  PARTICLES = 1, // count particles of PARTICLE_SIZE doubles
+  REPLIES,       // count replies, the payload holds the ones with a point
+  TERMINATED,    // count particles terminated, sent to process 0
+  DONE,          // all particles terminated, sent by process 0
+  DONE_ACK       // answer to DONE
+};
+
+//----------------------------------------------------------------------------
+// A streamline to integrate from Position.  ExitId is the process it left
+// and StreamId the piece that ends at Position there, or -1 for a seed.
+struct vtkAsynchronousStreamTracerParticle
+{
+  double Position[3];
+  int Direction;
+  double Propagation;
+  vtkIdType NumberOfSteps;
+  int HasNormal;
+  double Normal[3];
+  int ExitId;
+  int StreamId;
+};
+
+static const int PARTICLE_SIZE = 12;
+
+static void vtkAsynchronousStreamTracerPack(
+  const vtkAsynchronousStreamTracerParticle &p, vtkstd::vector<double> &buf)
+{
+  buf.push_back(p.Position[0]);
+  buf.push_back(p.Position[1]);
+  buf.push_back(p.Position[2]);
+  buf.push_back(p.Direction);
+  buf.push_back(p.Propagation);
+  buf.push_back(static_cast<double>(p.NumberOfSteps));
+  buf.push_back(p.HasNormal);
+  buf.push_back(p.Normal[0]);
+  buf.push_back(p.Normal[1]);
+  buf.push_back(p.Normal[2]);
+  buf.push_back(p.ExitId);
+  buf.push_back(p.StreamId);
+}
+
+static void vtkAsynchronousStreamTracerUnpack(
+  const double *buf, vtkAsynchronousStreamTracerParticle &p)
+{
+  p.Position[0] = buf[0];
+  p.Position[1] = buf[1];
+  p.Position[2] = buf[2];
+  p.Direction = static_cast<int>(buf[3]);
+  p.Propagation = buf[4];
+  p.NumberOfSteps = static_cast<vtkIdType>(buf[5]);
+  p.HasNormal = static_cast<int>(buf[6]);
+  p.Normal[0] = buf[7];
+  p.Normal[1] = buf[8];
+  p.Normal[2] = buf[9];
+  p.ExitId = static_cast<int>(buf[10]);
+  p.StreamId = static_cast<int>(buf[11]);
+}
+
+//----------------------------------------------------------------------------
+// A message sent with nonblocking requests, kept until they complete.
+struct vtkAsynchronousStreamTracerSend
+{
+  double Header[HEADER_SIZE];
+  vtkstd::vector<double> Payload;
+  vtkCommunicatorRequest *Requests[2];
+};
+
+//----------------------------------------------------------------------------
+class vtkAsynchronousStreamTracerInternals
+{
+public:
+  vtkAsynchronousStreamTracerInternals(vtkAsynchronousStreamTracer *self);
+  ~vtkAsynchronousStreamTracerInternals();
+
+  void Initialize();
+  void Run();
+
+protected:
+  int Contains(double pos[3]);
+  int NextCandidate(const double pos[3], int exitId, int after);
+  void Integrate(vtkAsynchronousStreamTracerParticle &p);
+  void Forward(vtkAsynchronousStreamTracerParticle &p, int candidate);
+  void AddReply(int destination, int streamId, vtkPolyData *piece);
+  void ApplyReplies(const double *payload, vtkIdType length);
+  void ReceiveParticles(const double *payload, int count);
+
+  int ReceiveMessage(int block);
+  void CancelHeaderRequest();
+  void SendMessage(int destination, int type, int count,
+                   vtkstd::vector<double> *payload);
+  void ReapSends(int block);
+  void Flush(int all);
+
+  vtkAsynchronousStreamTracer *Self;
+  vtkMultiProcessController *Controller;
+  int LocalProcessId;
+  int NumberOfProcesses;
+
+  vtkAbstractInterpolatedVelocityField *Func;
+  int MaxCellSize;
+  vtkDataSet *Input0;
+  const char *VecName;
+  vtkRungeKutta2 *StepOutSolver;
+
+  vtkstd::vector<double> Bounds;
+  vtkstd::deque<vtkAsynchronousStreamTracerParticle> Work;
+  vtkstd::vector<vtkstd::vector<double> > OutParticles;
+  vtkstd::vector<vtkstd::vector<double> > OutReplies;
+  vtkstd::vector<int> OutReplyCounts;
+  vtkstd::list<vtkAsynchronousStreamTracerSend*> Sends;
+
+  double Header[HEADER_SIZE];
+  vtkCommunicatorRequest *HeaderRequest;
+  int Overlap;
+
+  vtkIdType TotalParticles;
+  vtkIdType Terminated;
+  vtkIdType TotalTerminated;
+  vtkIdType PendingReplies;
+  int Done;
+  int DoneAcks;
+};
+
+//----------------------------------------------------------------------------
+vtkAsynchronousStreamTracerInternals::vtkAsynchronousStreamTracerInternals(
+  vtkAsynchronousStreamTracer *self)
+{
+  this->Self = self;
+  this->Controller = self->Controller;
+  this->LocalProcessId = this->Controller->GetLocalProcessId();
+  this->NumberOfProcesses = this->Controller->GetNumberOfProcesses();
+  this->Func = 0;
+  this->MaxCellSize = 0;
+  this->Input0 = 0;
+  this->VecName = 0;
+  this->StepOutSolver = vtkRungeKutta2::New();
+  this->OutParticles.resize(this->NumberOfProcesses);
+  this->OutReplies.resize(this->NumberOfProcesses);
+  this->OutReplyCounts.resize(this->NumberOfProcesses, 0);
+  this->HeaderRequest = 0;
+  this->Overlap = 0;
+  this->TotalParticles = 0;
+  this->Terminated = 0;
+  this->TotalTerminated = 0;
+  this->PendingReplies = 0;
+  this->Done = 0;
+  this->DoneAcks = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkAsynchronousStreamTracerInternals::~vtkAsynchronousStreamTracerInternals()
+{
+  this->ReapSends(1);
+  this->CancelHeaderRequest();
+  if (this->Func)
+    {
+    this->Func->Delete();
+    }
+  this->StepOutSolver->Delete();
+}
+
+//----------------------------------------------------------------------------
+// Share the bounds of all processes and hand each seed to the lowest
+// process that contains it.
+void vtkAsynchronousStreamTracerInternals::Initialize()
+{
+  vtkAsynchronousStreamTracer *self = this->Self;
+  int numProcs = this->NumberOfProcesses;
+  int myid = this->LocalProcessId;
+
+  double bounds[6] = { 1.0, -1.0, 1.0, -1.0, 1.0, -1.0 };
+  if (!self->EmptyData &&
+      self->CheckInputs(this->Func, &this->MaxCellSize) == VTK_OK)
+    {
+    vtkCompositeDataIterator *iter = self->InputData->NewIterator();
+    for (iter->GoToFirstItem(); !iter->IsDoneWithTraversal();
+         iter->GoToNextItem())
+      {
+      vtkDataSet *ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+      if (!ds || ds->GetNumberOfPoints() == 0)
+        {
+        continue;
+        }
+      if (!this->Input0)
+        {
+        this->Input0 = ds;
+        }
+      double b[6];
+      ds->GetBounds(b);
+      for (int i = 0; i < 3; i++)
+        {
+        if (bounds[2*i] > bounds[2*i+1])
+          {
+          bounds[2*i] = b[2*i];
+          bounds[2*i+1] = b[2*i+1];
+          }
+        else
+          {
+          bounds[2*i] = (b[2*i] < bounds[2*i]) ? b[2*i] : bounds[2*i];
+          bounds[2*i+1] = (b[2*i+1] > bounds[2*i+1]) ? b[2*i+1]
+                                                      : bounds[2*i+1];
+          }
+        }
+      }
+    iter->Delete();
+    vtkDataArray *vectors = this->Input0 ?
+      self->GetInputArrayToProcess(0, this->Input0) : 0;
+    if (vectors)
+      {
+      this->VecName = vectors->GetName();
+      }
+    else
+      {
+      this->Input0 = 0;
+      }
+    }
+  else if (this->Func)
+    {
+    this->Func->Delete();
+    this->Func = 0;
+    }
+  if (!this->Input0)
+    {
+    bounds[0] = bounds[2] = bounds[4] = 1.0;
+    bounds[1] = bounds[3] = bounds[5] = -1.0;
+    }
+  this->Bounds.resize(6*numProcs);
+  this->Controller->AllGather(bounds, &this->Bounds[0], 6);
+
+  vtkIdType numLines = self->Seeds ? self->SeedIds->GetNumberOfIds() : 0;
+  if (numLines == 0)
+    {
+    return;
+    }
+  vtkstd::vector<int> mine(numLines);
+  vtkstd::vector<int> owners(numLines);
+  vtkIdType i;
+  for (i = 0; i < numLines; i++)
+    {
+    double seed[3];
+    self->Seeds->GetTuple(self->SeedIds->GetId(i), seed);
+    mine[i] = this->Contains(seed) ? myid : numProcs;
+    }
+  this->Controller->AllReduce(&mine[0], &owners[0], numLines,
+                              vtkCommunicator::MIN_OP);
+  for (i = 0; i < numLines; i++)
+    {
+    if (owners[i] == numProcs)
+      {
+      continue;
+      }
+    this->TotalParticles++;
+    if (owners[i] == myid)
+      {
+      vtkAsynchronousStreamTracerParticle p;
+      self->Seeds->GetTuple(self->SeedIds->GetId(i), p.Position);
+      p.Direction = self->IntegrationDirections->GetValue(i);
+      p.Propagation = 0.0;
+      p.NumberOfSteps = 0;
+      p.HasNormal = 0;
+      p.Normal[0] = p.Normal[1] = p.Normal[2] = 0.0;
+      p.ExitId = myid;
+      p.StreamId = -1;
+      this->Work.push_back(p);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkAsynchronousStreamTracerInternals::Contains(double pos[3])
+{
+  vtkAbstractInterpolatedVelocityField *func = this->Self->Interpolator;
+  if (!func || !this->Input0)
+    {
+    return 0;
+    }
+  const double *b = &this->Bounds[6*this->LocalProcessId];
+  if (pos[0] < b[0] || pos[0] > b[1] || pos[1] < b[2] || pos[1] > b[3] ||
+      pos[2] < b[4] || pos[2] > b[5])
+    {
+    return 0;
+    }
+  double velocity[3];
+  func->ClearLastCellId();
+  return func->FunctionValues(pos, velocity);
+}
+
+//----------------------------------------------------------------------------
+// The next process after \c after, counting from the process the particle
+// left as vtkDistributedStreamTracer does, whose bounds contain the point.
+// All processes find the same candidates, so a process that does not have
+// the point passes it on to the next one.  Pass -1 for the first one.
+int vtkAsynchronousStreamTracerInternals::NextCandidate(const double pos[3],
+                                                        int exitId, int after)
+{
+  int numProcs = this->NumberOfProcesses;
+  int offset = (after < 0) ? 1 : (after - exitId + numProcs) % numProcs + 1;
+  for (; offset < numProcs; offset++)
+    {
+    int i = (exitId + offset) % numProcs;
+    const double *b = &this->Bounds[6*i];
+    double tol = 1.0e-6 * sqrt((b[1]-b[0])*(b[1]-b[0]) +
+                               (b[3]-b[2])*(b[3]-b[2]) +
+                               (b[5]-b[4])*(b[5]-b[4]));
+    if (b[0] <= b[1] &&
+        pos[0] >= b[0]-tol && pos[0] <= b[1]+tol &&
+        pos[1] >= b[2]-tol && pos[1] <= b[3]+tol &&
+        pos[2] >= b[4]-tol && pos[2] <= b[5]+tol)
+      {
+      return i;
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+// Integrate a streamline while it stays in the data of this process, as
+// vtkDistributedStreamTracer::ProcessTask() does.
+void vtkAsynchronousStreamTracerInternals::Integrate(
+  vtkAsynchronousStreamTracerParticle &p)
+{
+  vtkAsynchronousStreamTracer *self = this->Self;
+  int myid = this->LocalProcessId;
+
+  vtkSmartPointer<vtkDoubleArray> seeds =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  seeds->SetNumberOfComponents(3);
+  seeds->InsertNextTuple(p.Position);
+  vtkSmartPointer<vtkIdList> seedIds = vtkSmartPointer<vtkIdList>::New();
+  seedIds->InsertNextId(0);
+  vtkSmartPointer<vtkIntArray> integrationDirections =
+    vtkSmartPointer<vtkIntArray>::New();
+  integrationDirections->InsertNextValue(p.Direction);
+
+  // Keep track of all streamlines by adding them to TmpOutputs.
+  // They will be appended together after all the integration is done.
+  vtkSmartPointer<vtkPolyData> tmpOutput = vtkSmartPointer<vtkPolyData>::New();
+  self->TmpOutputs.push_back(tmpOutput);
+  int streamId = static_cast<int>(self->TmpOutputs.size()) - 1;
+
+  double lastPoint[3];
+  self->Integrate(this->Input0, tmpOutput, seeds, seedIds,
+                  integrationDirections, lastPoint, this->Func,
+                  this->MaxCellSize, this->VecName,
+                  p.Propagation, p.NumberOfSteps);
+  self->GenerateNormals(tmpOutput, p.HasNormal ? p.Normal : 0, this->VecName);
+
+  // These are used to keep track of where the seed came from, as in
+  // vtkDistributedStreamTracer.
+  vtkIntArray* strOrigin = vtkIntArray::New();
+  strOrigin->SetNumberOfComponents(2);
+  strOrigin->SetNumberOfTuples(1);
+  strOrigin->SetName("Streamline Origin");
+  strOrigin->SetValue(0, p.ExitId);
+  strOrigin->SetValue(1, p.StreamId);
+  tmpOutput->GetCellData()->AddArray(strOrigin);
+  strOrigin->Delete();
+
+  vtkIntArray* streamIds = vtkIntArray::New();
+  streamIds->SetNumberOfTuples(1);
+  streamIds->SetName("Streamline Ids");
+  streamIds->SetComponent(0, 0, streamId);
+  tmpOutput->GetCellData()->AddArray(streamIds);
+  streamIds->Delete();
+
+  // Close the gap with the previous piece.
+  if (p.StreamId >= 0)
+    {
+    this->AddReply(p.ExitId, p.StreamId, tmpOutput);
+    }
+
+  vtkIntArray* resTermArray = vtkIntArray::SafeDownCast(
+    tmpOutput->GetCellData()->GetArray("ReasonForTermination"));
+  int resTerm = vtkStreamTracer::OUT_OF_DOMAIN;
+  if (resTermArray)
+    {
+    resTerm = resTermArray->GetValue(0);
+    }
+  vtkIdType numPoints = tmpOutput->GetNumberOfPoints();
+  if (numPoints == 0 || resTerm != vtkStreamTracer::OUT_OF_DOMAIN)
+    {
+    this->Terminated++;
+    return;
+    }
+
+  // Continue the integration a bit further to obtain a point
+  // outside. The main integration step can not always be used
+  // for this, specially if the integration is not 2nd order.
+  tmpOutput->GetPoint(numPoints-1, lastPoint);
+  vtkInitialValueProblemSolver* ivp = self->Integrator;
+  self->Integrator = this->StepOutSolver;
+  double tmpseed[3];
+  memcpy(tmpseed, lastPoint, 3*sizeof(double));
+  self->SimpleIntegrate(tmpseed, lastPoint, self->LastUsedStepSize,
+                        this->Func);
+  self->Integrator = ivp;
+  tmpOutput->GetPoints()->SetPoint(numPoints-1, lastPoint);
+
+  vtkAsynchronousStreamTracerParticle next = p;
+  memcpy(next.Position, lastPoint, 3*sizeof(double));
+  next.HasNormal = 0;
+  vtkDataArray* normals = tmpOutput->GetPointData()->GetArray("Normals");
+  if (normals)
+    {
+    next.HasNormal = 1;
+    normals->GetTuple(normals->GetNumberOfTuples()-1, next.Normal);
+    }
+  next.ExitId = myid;
+  next.StreamId = streamId;
+  this->Forward(next, this->NextCandidate(lastPoint, myid, -1));
+}
+
+//----------------------------------------------------------------------------
+// Queue a particle for the given candidate.  A particle without candidate
+// left the whole domain; its process of origin is told so it stops waiting
+// for the first point of the next piece.
+void vtkAsynchronousStreamTracerInternals::Forward(
+  vtkAsynchronousStreamTracerParticle &p, int candidate)
+{
+  if (candidate < 0)
+    {
+    if (p.ExitId == this->LocalProcessId)
+      {
+      this->PendingReplies++;
+      }
+    this->AddReply(p.ExitId, p.StreamId, 0);
+    this->Terminated++;
+    return;
+    }
+  if (p.ExitId == this->LocalProcessId)
+    {
+    this->PendingReplies++;
+    }
+  vtkAsynchronousStreamTracerPack(p, this->OutParticles[candidate]);
+  if (static_cast<int>(this->OutParticles[candidate].size()) >=
+      this->Self->ParticleBatchSize*PARTICLE_SIZE)
+    {
+    this->SendMessage(candidate, PARTICLES,
+      static_cast<int>(this->OutParticles[candidate].size()/PARTICLE_SIZE),
+      &this->OutParticles[candidate]);
+    }
+}
+
+//----------------------------------------------------------------------------
+// A reply is the stream id of the previous piece followed by, for each
+// point data array of the new piece, its number of components and its
+// first tuple.  A piece without a line, which is left out of the output,
+// only acknowledges the particle.
+void vtkAsynchronousStreamTracerInternals::AddReply(int destination,
+                                                    int streamId,
+                                                    vtkPolyData *piece)
+{
+  if (destination == this->LocalProcessId)
+    {
+    // The particle never left.
+    this->PendingReplies--;
+    return;
+    }
+  this->OutReplyCounts[destination]++;
+  if (piece && piece->GetNumberOfCells() > 0)
+    {
+    vtkstd::vector<double> &buf = this->OutReplies[destination];
+    vtkPointData *pd = piece->GetPointData();
+    int numArrays = pd->GetNumberOfArrays();
+    buf.push_back(streamId);
+    buf.push_back(numArrays);
+    for (int i = 0; i < numArrays; i++)
+      {
+      vtkDataArray *da = pd->GetArray(i);
+      int numComps = da ? da->GetNumberOfComponents() : 0;
+      buf.push_back(numComps);
+      for (int j = 0; j < numComps; j++)
+        {
+        buf.push_back(da->GetComponent(0, j));
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Replace the attributes of the last point of our pieces with the ones of
+// the first point of the next piece.  All processes produce the same point
+// data arrays in the same order, except for the normals that are only
+// added, last, to pieces of more than one point.
+void vtkAsynchronousStreamTracerInternals::ApplyReplies(const double *payload,
+                                                        vtkIdType length)
+{
+  vtkIdType pos = 0;
+  while (pos < length)
+    {
+    int streamId = static_cast<int>(payload[pos++]);
+    int numArrays = static_cast<int>(payload[pos++]);
+    vtkPolyData *piece = 0;
+    if (streamId >= 0 &&
+        streamId < static_cast<int>(this->Self->TmpOutputs.size()))
+      {
+      piece = this->Self->TmpOutputs[streamId];
+      }
+    vtkIdType ptId = piece ? piece->GetNumberOfPoints() - 1 : -1;
+    vtkPointData *pd = piece ? piece->GetPointData() : 0;
+    for (int i = 0; i < numArrays; i++)
+      {
+      int numComps = static_cast<int>(payload[pos++]);
+      vtkDataArray *da = (pd && i < pd->GetNumberOfArrays()) ?
+        pd->GetArray(i) : 0;
+      if (ptId >= 0 && da && da->GetNumberOfComponents() == numComps)
+        {
+        for (int j = 0; j < numComps; j++)
+          {
+          da->SetComponent(ptId, j, payload[pos+j]);
+          }
+        }
+      pos += numComps;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousStreamTracerInternals::ReceiveParticles(
+  const double *payload, int count)
+{
+  for (int i = 0; i < count; i++)
+    {
+    vtkAsynchronousStreamTracerParticle p;
+    vtkAsynchronousStreamTracerUnpack(payload + i*PARTICLE_SIZE, p);
+    if (this->Contains(p.Position))
+      {
+      this->Work.push_back(p);
+      }
+    else
+      {
+      this->Forward(p, this->NextCandidate(p.Position, p.ExitId,
+                                           this->LocalProcessId));
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Receive and handle one message.  Unless \c block is set, only do so if
+// one has arrived.  Returns 1 if a message was handled.
+int vtkAsynchronousStreamTracerInternals::ReceiveMessage(int block)
+{
+  if (!this->HeaderRequest)
+    {
+    this->HeaderRequest =
+      this->Controller->GetCommunicator()->NoBlockReceiveVoidArray(
+        this->Header, HEADER_SIZE, VTK_DOUBLE,
+        vtkMultiProcessController::ANY_SOURCE, HEADER_TAG);
+    }
+  if (block)
+    {
+    double start = vtkTimerLog::GetUniversalTime();
+    this->HeaderRequest->Wait();
+    this->Self->IdleTime += vtkTimerLog::GetUniversalTime() - start;
+    }
+  else if (!this->HeaderRequest->Test())
+    {
+    return 0;
+    }
+  int status = this->HeaderRequest->GetStatus();
+  this->HeaderRequest->Delete();
+  this->HeaderRequest = 0;
+  if (!status)
+    {
+    vtkErrorWithObjectMacro(this->Self, "Could not receive a message.");
+    this->Done = 1;
+    this->PendingReplies = 0;
+    this->DoneAcks = this->NumberOfProcesses - 1;
+    return 0;
+    }
+
+  int type = static_cast<int>(this->Header[0]);
+  int sender = static_cast<int>(this->Header[1]);
+  int count = static_cast<int>(this->Header[2]);
+  vtkIdType length = static_cast<vtkIdType>(this->Header[3]);
+  vtkstd::vector<double> payload(length > 0 ? length : 1);
+  if (length > 0)
+    {
+    this->Controller->Receive(&payload[0], length, sender, PAYLOAD_TAG);
+    }
+
+  switch (type)
+    {
+    case PARTICLES:
+      this->ReceiveParticles(&payload[0], count);
+      break;
+    case REPLIES:
+      this->PendingReplies -= count;
+      this->ApplyReplies(&payload[0], length);
+      break;
+    case TERMINATED:
+      this->TotalTerminated += count;
+      break;
+    case DONE:
+      this->Done = 1;
+      this->SendMessage(0, DONE_ACK, 0, 0);
+      break;
+    case DONE_ACK:
+      this->DoneAcks++;
+      break;
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Send a message and clear the payload.  Sends do not wait for the
+// receiver when the communicator can overlap them with computation.
+void vtkAsynchronousStreamTracerInternals::SendMessage(
+  int destination, int type, int count, vtkstd::vector<double> *payload)
+{
+  vtkAsynchronousStreamTracerSend *msg = new vtkAsynchronousStreamTracerSend;
+  msg->Header[0] = type;
+  msg->Header[1] = this->LocalProcessId;
+  msg->Header[2] = count;
+  msg->Header[3] = payload ? static_cast<double>(payload->size()) : 0.0;
+  if (payload)
+    {
+    msg->Payload.swap(*payload);
+    }
+  vtkIdType length = static_cast<vtkIdType>(msg->Payload.size());
+  if (!this->Overlap)
+    {
+    this->Controller->Send(msg->Header, HEADER_SIZE, destination, HEADER_TAG);
+    if (length > 0)
+      {
+      this->Controller->Send(&msg->Payload[0], length, destination,
+                             PAYLOAD_TAG);
+      }
+    delete msg;
+    return;
+    }
+  vtkCommunicator *comm = this->Controller->GetCommunicator();
+  msg->Requests[0] = comm->NoBlockSendVoidArray(
+    msg->Header, HEADER_SIZE, VTK_DOUBLE, destination, HEADER_TAG);
+  msg->Requests[1] = 0;
+  if (length > 0)
+    {
+    msg->Requests[1] = comm->NoBlockSendVoidArray(
+      &msg->Payload[0], length, VTK_DOUBLE, destination, PAYLOAD_TAG);
+    }
+  this->Sends.push_back(msg);
+}
+
+//----------------------------------------------------------------------------
+// Release the messages whose sends completed, or all of them if \c block.
+void vtkAsynchronousStreamTracerInternals::ReapSends(int block)
+{
+  vtkstd::list<vtkAsynchronousStreamTracerSend*>::iterator it =
+    this->Sends.begin();
+  while (it != this->Sends.end())
+    {
+    vtkAsynchronousStreamTracerSend *msg = *it;
+    if (block)
+      {
+      vtkCommunicatorRequest::WaitAll(2, msg->Requests);
+      }
+    else if (!msg->Requests[0]->Test() ||
+             (msg->Requests[1] && !msg->Requests[1]->Test()))
+      {
+      ++it;
+      continue;
+      }
+    msg->Requests[0]->Delete();
+    if (msg->Requests[1])
+      {
+      msg->Requests[1]->Delete();
+      }
+    delete msg;
+    it = this->Sends.erase(it);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Send the pending particles and replies, then report the terminated
+// particles to process 0.  The replies go out before the report, so
+// everyone has sent all replies once process 0 counts all particles.
+void vtkAsynchronousStreamTracerInternals::Flush(int all)
+{
+  int i;
+  for (i = 0; i < this->NumberOfProcesses; i++)
+    {
+    if (!this->OutParticles[i].empty())
+      {
+      this->SendMessage(i, PARTICLES,
+        static_cast<int>(this->OutParticles[i].size()/PARTICLE_SIZE),
+        &this->OutParticles[i]);
+      }
+    }
+  if (!all)
+    {
+    return;
+    }
+  for (i = 0; i < this->NumberOfProcesses; i++)
+    {
+    if (this->OutReplyCounts[i] > 0)
+      {
+      this->SendMessage(i, REPLIES, this->OutReplyCounts[i],
+                        &this->OutReplies[i]);
+      this->OutReplyCounts[i] = 0;
+      }
+    }
+  if (this->Terminated > 0)
+    {
+    if (this->LocalProcessId == 0)
+      {
+      this->TotalTerminated += this->Terminated;
+      }
+    else
+      {
+      this->SendMessage(0, TERMINATED, static_cast<int>(this->Terminated), 0);
+      }
+    this->Terminated = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousStreamTracerInternals::Run()
+{
+  if (this->TotalParticles == 0)
+    {
+    return;
+    }
+
+  // Find out whether messages can be received while integrating.  A
+  // queued request only completes once we wait for it.
+  this->HeaderRequest =
+    this->Controller->GetCommunicator()->NoBlockReceiveVoidArray(
+      this->Header, HEADER_SIZE, VTK_DOUBLE,
+      vtkMultiProcessController::ANY_SOURCE, HEADER_TAG);
+  this->Overlap = !this->HeaderRequest->GetQueued();
+
+  int myid = this->LocalProcessId;
+  while (1)
+    {
+    if (!this->Work.empty())
+      {
+      vtkAsynchronousStreamTracerParticle p = this->Work.front();
+      this->Work.pop_front();
+      this->Integrate(p);
+      if (this->Overlap)
+        {
+        while (this->ReceiveMessage(0))
+          {
+          }
+        this->ReapSends(0);
+        }
+      continue;
+      }
+
+    // Out of work.
+    this->Flush(1);
+    if (myid == 0 && !this->Done &&
+        this->TotalTerminated == this->TotalParticles)
+      {
+      this->Done = 1;
+      for (int i = 1; i < this->NumberOfProcesses; i++)
+        {
+        this->SendMessage(i, DONE, 0, 0);
+        }
+      }
+    if (this->Done && this->PendingReplies <= 0 &&
+        (myid != 0 || this->DoneAcks == this->NumberOfProcesses - 1))
+      {
+      break;
+      }
+    this->ReceiveMessage(1);
+    }
+  this->ReapSends(1);
+  this->CancelHeaderRequest();
+}
+
+//----------------------------------------------------------------------------
+// The header receive posted last is never matched.  Cancel it, so that it
+// does not receive into this object once it is gone, nor take a message
+// meant for a later update.
+void vtkAsynchronousStreamTracerInternals::CancelHeaderRequest()
+{
+  if (this->HeaderRequest)
+    {
+    this->HeaderRequest->Cancel();
+    this->HeaderRequest->Delete();
+    this->HeaderRequest = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkAsynchronousStreamTracer::vtkAsynchronousStreamTracer()
+{
+  this->ParticleBatchSize = 16;
+  this->IdleTime = 0.0;
+}
+
+//----------------------------------------------------------------------------
+vtkAsynchronousStreamTracer::~vtkAsynchronousStreamTracer()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousStreamTracer::ParallelIntegrate()
+{
+  this->IdleTime = 0.0;
+  vtkAsynchronousStreamTracerInternals internals(this);
+  internals.Initialize();
+  internals.Run();
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousStreamTracer::FillGaps(vtkPolyData *vtkNotUsed(output))
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousStreamTracer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "ParticleBatchSize: " << this->ParticleBatchSize << endl;
+  os << indent << "IdleTime: " << this->IdleTime << endl;
+}
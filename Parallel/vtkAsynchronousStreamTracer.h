@@ -0,0 +1,92 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsynchronousStreamTracer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkAsynchronousStreamTracer - Concurrent distributed streamline generator
+// .SECTION Description
+// This filter integrates streamlines on a distributed dataset like
+// vtkDistributedStreamTracer, but all processes integrate at the same
+// time.  Each seed is integrated by the lowest process whose data
+// contains it.  When a streamline leaves the data of a process, the
+// particle is passed to a process whose bounds contain the exit point,
+// together with others leaving for the same process (see
+// ParticleBatchSize).  Processes exchange particles while they
+// integrate, and process 0 counts terminated particles to tell the
+// others when all streamlines are done.  The first point of a piece of
+// streamline is sent back to the process that integrated the previous
+// piece to close the gap between them, so the output matches the one of
+// vtkDistributedStreamTracer.
+//
+// A particle is only integrated by a process whose data contains it;
+// the filter does not move particles to balance the load beyond that.
+// Messages are only received between particles when the communicator
+// can overlap communication with computation (as vtkMPICommunicator
+// does); otherwise processes receive particles once they run out of
+// work.  GetIdleTime() reports how long this process waited for
+// particles during the last execution.
+// .SECTION See Also
+// vtkStreamTracer vtkPStreamTracer vtkDistributedStreamTracer
+
+#ifndef __vtkAsynchronousStreamTracer_h
+#define __vtkAsynchronousStreamTracer_h
+
+#include "vtkPStreamTracer.h"
+
+class vtkAsynchronousStreamTracerInternals;
+
+class VTK_PARALLEL_EXPORT vtkAsynchronousStreamTracer : public vtkPStreamTracer
+{
+public:
+  vtkTypeMacro(vtkAsynchronousStreamTracer,vtkPStreamTracer);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  static vtkAsynchronousStreamTracer *New();
+
+  // Description:
+  // The number of particles leaving for the same process that are
+  // gathered into one message.  Pending particles are also sent when
+  // this process runs out of work.  The default is 16.
+  vtkSetClampMacro(ParticleBatchSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(ParticleBatchSize, int);
+
+  // Description:
+  // The wall clock time, in seconds, this process spent waiting for
+  // particles or for the other processes to finish during the last
+  // execution.
+  vtkGetMacro(IdleTime, double);
+
+protected:
+
+  vtkAsynchronousStreamTracer();
+  ~vtkAsynchronousStreamTracer();
+
+  virtual void ParallelIntegrate();
+
+  // Description:
+  // The gaps are closed while integrating, so this does nothing.
+  virtual void FillGaps(vtkPolyData *output);
+
+  int ParticleBatchSize;
+  double IdleTime;
+
+//BTX
+  friend class vtkAsynchronousStreamTracerInternals;
+//ETX
+
+private:
+  vtkAsynchronousStreamTracer(const vtkAsynchronousStreamTracer&);  // Not implemented.
+  void operator=(const vtkAsynchronousStreamTracer&);  // Not implemented.
+};
+
+
+#endif
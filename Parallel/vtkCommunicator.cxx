@@ -16,6 +16,9 @@
 
 #include "vtkBoundingBox.h"
 #include "vtkCharArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCommunicatorRequest.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSetReader.h"
@@ -31,6 +34,9 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredGrid.h"
@@ -41,16 +47,22 @@
 #include "vtkTypeTraits.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedLongArray.h"
+#include "vtkUnstructuredGrid.h"
 
 #define VTK_CREATE(type, name) \
   vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 #include <vtkstd/algorithm>
+#include <vtkstd/deque>
 #include <vtkstd/vector>
 
 
 #define EXTENT_HEADER_SIZE      128
 
+// Formats in which SendElementalDataObject() sends a data object.
+#define VTK_COMMUNICATOR_LEGACY_FORMAT  0
+#define VTK_COMMUNICATOR_NATIVE_FORMAT  1
+
 //=============================================================================
 // Functions and classes that perform the default reduction operations.
 #define STANDARD_OPERATION_DEFINITION(name, op) \
@@ -104,6 +116,814 @@ STANDARD_OPERATION_DEFINITION(LogicalXor, (!A[i] && B[i]) || (A[i] && !B[i]));
 STANDARD_OPERATION_FLOAT_OVERRIDE(BitwiseXor);
 STANDARD_OPERATION_DEFINITION(BitwiseXor, A[i] ^ B[i]);
 
+//=============================================================================
+// Native marshaling of data sets.  The structure of a data set (its type,
+// extent and the type, size, name and attribute of each array) is written
+// to a vtkMultiProcessStream header, and the arrays themselves are listed
+// as segments that are sent straight from, and received straight into, the
+// memory of the arrays.  The header starts with the type and number of
+// values of each segment, so that a receiver that can not build the data
+// set still takes all of them off the channel, followed by the size of
+// vtkIdType, which the receiver checks, since id arrays are sent as they
+// are.  The Describe functions return 0 for data objects the native format
+// does not cover, which are then marshaled.
+typedef vtkstd::vector<vtkDataArray*> vtkCommunicatorSegments;
+
+struct vtkCommunicatorSegmentSize
+{
+  int Type;
+  vtkTypeInt64 Length;
+};
+typedef vtkstd::vector<vtkCommunicatorSegmentSize> vtkCommunicatorSegmentSizes;
+
+static void vtkCommunicatorGetSegmentSizes(vtkCommunicatorSegments &segments,
+                                           vtkCommunicatorSegmentSizes &sizes)
+{
+  sizes.resize(segments.size());
+  for (size_t i = 0; i < segments.size(); i++)
+    {
+    sizes[i].Type = segments[i]->GetDataType();
+    sizes[i].Length = static_cast<vtkTypeInt64>(
+      segments[i]->GetNumberOfTuples())*segments[i]->GetNumberOfComponents();
+    }
+}
+
+// Allocate an array to take a segment of a data set that could not be built
+// off the channel.  Returns NULL if the type is not that of a data array.
+static vtkDataArray *vtkCommunicatorNewScratchSegment(
+  const vtkCommunicatorSegmentSize &size)
+{
+  vtkDataArray *array = vtkDataArray::CreateDataArray(size.Type);
+  if (array && (array->GetDataType() != size.Type || size.Length < 0))
+    {
+    array->Delete();
+    array = NULL;
+    }
+  if (array)
+    {
+    array->SetNumberOfTuples(static_cast<vtkIdType>(size.Length));
+    }
+  return array;
+}
+
+static int vtkCommunicatorDescribeArray(vtkAbstractArray *array,
+                                        vtkMultiProcessStream &header,
+                                        vtkCommunicatorSegments &segments)
+{
+  vtkDataArray *da = vtkDataArray::SafeDownCast(array);
+  if (array == NULL)
+    {
+    header << 0;
+    return 1;
+    }
+  if (da == NULL || da->GetDataType() == VTK_BIT)
+    {
+    // String, variant and bit arrays go through the legacy writer.
+    return 0;
+    }
+  header << 1 << da->GetDataType() << da->GetNumberOfComponents()
+         << static_cast<vtkTypeInt64>(da->GetNumberOfTuples());
+  if (da->GetName())
+    {
+    header << 1 << vtkstd::string(da->GetName());
+    }
+  else
+    {
+    header << 0;
+    }
+  if (da->GetNumberOfTuples()*da->GetNumberOfComponents() > 0)
+    {
+    segments.push_back(da);
+    }
+  return 1;
+}
+
+static int vtkCommunicatorDescribeCells(vtkCellArray *cells,
+                                        vtkMultiProcessStream &header,
+                                        vtkCommunicatorSegments &segments)
+{
+  if (cells == NULL || cells->GetNumberOfCells() == 0)
+    {
+    header << static_cast<vtkTypeInt64>(0);
+    return 1;
+    }
+  header << static_cast<vtkTypeInt64>(cells->GetNumberOfCells());
+  if (cells->IsStorageOffsets())
+    {
+    // Send the offsets and the connectivity as they are stored; GetData()
+    // would convert the cells of the sender to the legacy storage.
+    header << 1;
+    return vtkCommunicatorDescribeArray(cells->GetOffsetsArray(),
+                                        header, segments) &&
+      vtkCommunicatorDescribeArray(cells->GetConnectivityArray(),
+                                   header, segments);
+    }
+  header << 0;
+  return vtkCommunicatorDescribeArray(cells->GetData(), header, segments);
+}
+
+static int vtkCommunicatorDescribeFieldData(vtkFieldData *fd,
+                                            vtkMultiProcessStream &header,
+                                            vtkCommunicatorSegments &segments)
+{
+  vtkDataSetAttributes *dsa = vtkDataSetAttributes::SafeDownCast(fd);
+  int numArrays = fd->GetNumberOfArrays();
+  header << numArrays;
+  for (int i = 0; i < numArrays; i++)
+    {
+    vtkAbstractArray *array = fd->GetAbstractArray(i);
+    if (array == NULL ||
+        !vtkCommunicatorDescribeArray(array, header, segments))
+      {
+      return 0;
+      }
+    header << (dsa ? dsa->IsArrayAnAttribute(i) : -1);
+    }
+  return 1;
+}
+
+static int vtkCommunicatorDescribeStructure(vtkDataObject *object,
+                                            vtkMultiProcessStream &header,
+                                            vtkCommunicatorSegments &segments)
+{
+  if (object == NULL)
+    {
+    return 0;
+    }
+
+  int extent[6] = {0,0,0,0,0,0};
+  int type = object->GetDataObjectType();
+  header << static_cast<int>(VTK_SIZEOF_ID_TYPE) << type;
+  switch (type)
+    {
+    case VTK_IMAGE_DATA:
+    case VTK_STRUCTURED_POINTS:
+      {
+      vtkImageData *id = vtkImageData::SafeDownCast(object);
+      double *origin = id->GetOrigin();
+      double *spacing = id->GetSpacing();
+      id->GetExtent(extent);
+      for (int i = 0; i < 6; i++)
+        {
+        header << extent[i];
+        }
+      header << origin[0] << origin[1] << origin[2]
+             << spacing[0] << spacing[1] << spacing[2];
+      }
+      break;
+
+    case VTK_RECTILINEAR_GRID:
+      {
+      vtkRectilinearGrid *rg = vtkRectilinearGrid::SafeDownCast(object);
+      rg->GetExtent(extent);
+      for (int i = 0; i < 6; i++)
+        {
+        header << extent[i];
+        }
+      if (!vtkCommunicatorDescribeArray(rg->GetXCoordinates(), header, segments) ||
+          !vtkCommunicatorDescribeArray(rg->GetYCoordinates(), header, segments) ||
+          !vtkCommunicatorDescribeArray(rg->GetZCoordinates(), header, segments))
+        {
+        return 0;
+        }
+      }
+      break;
+
+    case VTK_STRUCTURED_GRID:
+      {
+      vtkStructuredGrid *sg = vtkStructuredGrid::SafeDownCast(object);
+      sg->GetExtent(extent);
+      for (int i = 0; i < 6; i++)
+        {
+        header << extent[i];
+        }
+      vtkPoints *points = sg->GetPoints();
+      if (!vtkCommunicatorDescribeArray(points ? points->GetData() : NULL,
+                                        header, segments))
+        {
+        return 0;
+        }
+      }
+      break;
+
+    case VTK_POLY_DATA:
+      {
+      vtkPolyData *pd = vtkPolyData::SafeDownCast(object);
+      vtkPoints *points = pd->GetPoints();
+      if (!vtkCommunicatorDescribeArray(points ? points->GetData() : NULL,
+                                        header, segments) ||
+          !vtkCommunicatorDescribeCells(pd->GetVerts(), header, segments) ||
+          !vtkCommunicatorDescribeCells(pd->GetLines(), header, segments) ||
+          !vtkCommunicatorDescribeCells(pd->GetPolys(), header, segments) ||
+          !vtkCommunicatorDescribeCells(pd->GetStrips(), header, segments))
+        {
+        return 0;
+        }
+      }
+      break;
+
+    case VTK_UNSTRUCTURED_GRID:
+      {
+      vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(object);
+      if (ug->GetFaces())
+        {
+        // Polyhedra go through the legacy writer.
+        return 0;
+        }
+      vtkPoints *points = ug->GetPoints();
+      if (!vtkCommunicatorDescribeArray(points ? points->GetData() : NULL,
+                                        header, segments) ||
+          !vtkCommunicatorDescribeCells(ug->GetCells(), header, segments))
+        {
+        return 0;
+        }
+      if (ug->GetCells() && ug->GetCells()->GetNumberOfCells() > 0 &&
+          (!vtkCommunicatorDescribeArray(ug->GetCellTypesArray(),
+                                         header, segments) ||
+           !vtkCommunicatorDescribeArray(ug->GetCellLocationsArray(),
+                                         header, segments)))
+        {
+        return 0;
+        }
+      }
+      break;
+
+    default:
+      return 0;
+    }
+
+  if (!vtkCommunicatorDescribeFieldData(object->GetFieldData(),
+                                        header, segments))
+    {
+    return 0;
+    }
+  vtkDataSet *ds = vtkDataSet::SafeDownCast(object);
+  return vtkCommunicatorDescribeFieldData(ds->GetPointData(), header, segments)
+    && vtkCommunicatorDescribeFieldData(ds->GetCellData(), header, segments);
+}
+
+// Create an empty array of the size given by the header.  Returns NULL if
+// the header says there is no array or on error, which is flagged in ok.
+static vtkDataArray *vtkCommunicatorBuildArray(vtkMultiProcessStream &header,
+                                               vtkCommunicatorSegments &segments,
+                                               int &ok)
+{
+  int present = 0;
+  header >> present;
+  if (!present)
+    {
+    return NULL;
+    }
+
+  int type, numComponents, hasName;
+  vtkTypeInt64 numTuples;
+  header >> type >> numComponents >> numTuples >> hasName;
+  vtkDataArray *array = vtkDataArray::CreateDataArray(type);
+  if (array == NULL || numComponents < 1 || numTuples < 0)
+    {
+    vtkGenericWarningMacro("Bad array while unmarshaling data.");
+    if (array)
+      {
+      array->Delete();
+      }
+    ok = 0;
+    return NULL;
+    }
+  if (hasName)
+    {
+    vtkstd::string name;
+    header >> name;
+    array->SetName(name.c_str());
+    }
+  array->SetNumberOfComponents(numComponents);
+  array->SetNumberOfTuples(static_cast<vtkIdType>(numTuples));
+  if (numTuples*numComponents > 0)
+    {
+    segments.push_back(array);
+    }
+  return array;
+}
+
+static vtkPoints *vtkCommunicatorBuildPoints(vtkMultiProcessStream &header,
+                                             vtkCommunicatorSegments &segments,
+                                             int &ok)
+{
+  vtkDataArray *array = vtkCommunicatorBuildArray(header, segments, ok);
+  if (array == NULL)
+    {
+    return NULL;
+    }
+  vtkPoints *points = vtkPoints::New(array->GetDataType());
+  points->SetData(array);
+  array->Delete();
+  return points;
+}
+
+static vtkCellArray *vtkCommunicatorBuildCells(vtkMultiProcessStream &header,
+                                               vtkCommunicatorSegments &segments,
+                                               int &ok)
+{
+  vtkTypeInt64 numCells = 0;
+  header >> numCells;
+  if (numCells == 0)
+    {
+    return NULL;
+    }
+  int offsetsStorage = 0;
+  header >> offsetsStorage;
+  if (offsetsStorage)
+    {
+    vtkDataArray *offsets = vtkCommunicatorBuildArray(header, segments, ok);
+    vtkDataArray *connectivity =
+      vtkCommunicatorBuildArray(header, segments, ok);
+    vtkCellArray *cells = NULL;
+    if (offsets && connectivity &&
+        offsets->GetNumberOfTuples() == numCells + 1)
+      {
+      cells = vtkCellArray::New();
+      if (!cells->SetData(offsets, connectivity))
+        {
+        cells->Delete();
+        cells = NULL;
+        }
+      }
+    if (cells == NULL)
+      {
+      vtkGenericWarningMacro("Bad cells while unmarshaling data.");
+      ok = 0;
+      }
+    if (offsets)
+      {
+      offsets->Delete();
+      }
+    if (connectivity)
+      {
+      connectivity->Delete();
+      }
+    return cells;
+    }
+  vtkDataArray *array = vtkCommunicatorBuildArray(header, segments, ok);
+  vtkIdTypeArray *ids = vtkIdTypeArray::SafeDownCast(array);
+  if (ids == NULL)
+    {
+    vtkGenericWarningMacro("Bad cells while unmarshaling data.");
+    if (array)
+      {
+      array->Delete();
+      }
+    ok = 0;
+    return NULL;
+    }
+  vtkCellArray *cells = vtkCellArray::New();
+  cells->SetCells(static_cast<vtkIdType>(numCells), ids);
+  ids->Delete();
+  return cells;
+}
+
+static int vtkCommunicatorBuildFieldData(vtkMultiProcessStream &header,
+                                         vtkFieldData *fd,
+                                         vtkCommunicatorSegments &segments)
+{
+  vtkDataSetAttributes *dsa = vtkDataSetAttributes::SafeDownCast(fd);
+  int ok = 1;
+  int numArrays = 0;
+  header >> numArrays;
+  for (int i = 0; i < numArrays && ok; i++)
+    {
+    vtkDataArray *array = vtkCommunicatorBuildArray(header, segments, ok);
+    int attribute = -1;
+    header >> attribute;
+    if (array)
+      {
+      int idx = fd->AddArray(array);
+      if (dsa && attribute >= 0)
+        {
+        dsa->SetActiveAttribute(idx, attribute);
+        }
+      array->Delete();
+      }
+    }
+  return ok;
+}
+
+// Give the object the structure described by the header, with arrays that
+// are still to be filled from the segments.
+static int vtkCommunicatorBuildStructure(vtkMultiProcessStream &header,
+                                         vtkDataObject *object,
+                                         vtkCommunicatorSegments &segments)
+{
+  int idTypeSize = 0;
+  int type = -1;
+  header >> idTypeSize >> type;
+  if (idTypeSize != VTK_SIZEOF_ID_TYPE)
+    {
+    vtkGenericWarningMacro("Received a data set with " << 8*idTypeSize
+                           << " bit ids, which this build of VTK can not use.");
+    return 0;
+    }
+  if (object->GetDataObjectType() != type)
+    {
+    vtkGenericWarningMacro("Type mismatch while unmarshaling data.");
+    return 0;
+    }
+  object->Initialize();
+
+  int ok = 1;
+  int extent[6];
+  switch (type)
+    {
+    case VTK_IMAGE_DATA:
+    case VTK_STRUCTURED_POINTS:
+      {
+      vtkImageData *id = vtkImageData::SafeDownCast(object);
+      double origin[3], spacing[3];
+      for (int i = 0; i < 6; i++)
+        {
+        header >> extent[i];
+        }
+      header >> origin[0] >> origin[1] >> origin[2]
+             >> spacing[0] >> spacing[1] >> spacing[2];
+      id->SetExtent(extent);
+      id->SetOrigin(origin);
+      id->SetSpacing(spacing);
+      }
+      break;
+
+    case VTK_RECTILINEAR_GRID:
+      {
+      vtkRectilinearGrid *rg = vtkRectilinearGrid::SafeDownCast(object);
+      for (int i = 0; i < 6; i++)
+        {
+        header >> extent[i];
+        }
+      rg->SetExtent(extent);
+      vtkDataArray *coords[3];
+      for (int i = 0; i < 3; i++)
+        {
+        coords[i] = vtkCommunicatorBuildArray(header, segments, ok);
+        }
+      rg->SetXCoordinates(coords[0]);
+      rg->SetYCoordinates(coords[1]);
+      rg->SetZCoordinates(coords[2]);
+      for (int i = 0; i < 3; i++)
+        {
+        if (coords[i])
+          {
+          coords[i]->Delete();
+          }
+        }
+      }
+      break;
+
+    case VTK_STRUCTURED_GRID:
+      {
+      vtkStructuredGrid *sg = vtkStructuredGrid::SafeDownCast(object);
+      for (int i = 0; i < 6; i++)
+        {
+        header >> extent[i];
+        }
+      sg->SetExtent(extent);
+      vtkPoints *points = vtkCommunicatorBuildPoints(header, segments, ok);
+      if (points)
+        {
+        sg->SetPoints(points);
+        points->Delete();
+        }
+      }
+      break;
+
+    case VTK_POLY_DATA:
+      {
+      vtkPolyData *pd = vtkPolyData::SafeDownCast(object);
+      vtkPoints *points = vtkCommunicatorBuildPoints(header, segments, ok);
+      if (points)
+        {
+        pd->SetPoints(points);
+        points->Delete();
+        }
+      vtkCellArray *cells[4];
+      for (int i = 0; i < 4; i++)
+        {
+        cells[i] = vtkCommunicatorBuildCells(header, segments, ok);
+        }
+      pd->SetVerts(cells[0]);
+      pd->SetLines(cells[1]);
+      pd->SetPolys(cells[2]);
+      pd->SetStrips(cells[3]);
+      for (int i = 0; i < 4; i++)
+        {
+        if (cells[i])
+          {
+          cells[i]->Delete();
+          }
+        }
+      }
+      break;
+
+    case VTK_UNSTRUCTURED_GRID:
+      {
+      vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(object);
+      vtkPoints *points = vtkCommunicatorBuildPoints(header, segments, ok);
+      if (points)
+        {
+        ug->SetPoints(points);
+        points->Delete();
+        }
+      vtkCellArray *cells = vtkCommunicatorBuildCells(header, segments, ok);
+      if (cells)
+        {
+        vtkDataArray *types = vtkCommunicatorBuildArray(header, segments, ok);
+        vtkDataArray *locations =
+          vtkCommunicatorBuildArray(header, segments, ok);
+        if (vtkUnsignedCharArray::SafeDownCast(types) &&
+            vtkIdTypeArray::SafeDownCast(locations))
+          {
+          ug->SetCells(static_cast<vtkUnsignedCharArray*>(types),
+                       static_cast<vtkIdTypeArray*>(locations), cells,
+                       NULL, NULL);
+          }
+        else
+          {
+          vtkGenericWarningMacro("Bad cells while unmarshaling data.");
+          ok = 0;
+          }
+        if (types)
+          {
+          types->Delete();
+          }
+        if (locations)
+          {
+          locations->Delete();
+          }
+        cells->Delete();
+        }
+      }
+      break;
+
+    default:
+      vtkGenericWarningMacro("Cannot unmarshal " << object->GetClassName());
+      return 0;
+    }
+
+  vtkDataSet *ds = vtkDataSet::SafeDownCast(object);
+  return ok
+    && vtkCommunicatorBuildFieldData(header, object->GetFieldData(), segments)
+    && vtkCommunicatorBuildFieldData(header, ds->GetPointData(), segments)
+    && vtkCommunicatorBuildFieldData(header, ds->GetCellData(), segments);
+}
+
+static int vtkCommunicatorDescribeDataObject(vtkDataObject *object,
+                                             vtkMultiProcessStream &header,
+                                             vtkCommunicatorSegments &segments)
+{
+  vtkMultiProcessStream structure;
+  if (!vtkCommunicatorDescribeStructure(object, structure, segments))
+    {
+    return 0;
+    }
+  vtkCommunicatorSegmentSizes sizes;
+  vtkCommunicatorGetSegmentSizes(segments, sizes);
+  header << static_cast<int>(sizes.size());
+  for (size_t i = 0; i < sizes.size(); i++)
+    {
+    header << sizes[i].Type << sizes[i].Length;
+    }
+  header << structure;
+  return 1;
+}
+
+// Build the object from the header.  The sizes of the segments announced
+// by the header are returned even if the object could not be built, unless
+// the header is too broken to tell.  On error the segments must not be
+// used.
+static int vtkCommunicatorBuildDataObject(vtkMultiProcessStream &header,
+                                          vtkDataObject *object,
+                                          vtkCommunicatorSegments &segments,
+                                          vtkCommunicatorSegmentSizes &sizes)
+{
+  int numSegments = -1;
+  header >> numSegments;
+  if (numSegments < 0)
+    {
+    vtkGenericWarningMacro("Bad header while unmarshaling data.");
+    return 0;
+    }
+  sizes.resize(numSegments);
+  for (int i = 0; i < numSegments; i++)
+    {
+    header >> sizes[i].Type >> sizes[i].Length;
+    }
+  vtkMultiProcessStream structure;
+  header >> structure;
+  if (!vtkCommunicatorBuildStructure(structure, object, segments))
+    {
+    return 0;
+    }
+
+  // The arrays must take exactly the values that will be sent.
+  vtkCommunicatorSegmentSizes built;
+  vtkCommunicatorGetSegmentSizes(segments, built);
+  for (size_t i = 0; i < sizes.size(); i++)
+    {
+    if (built.size() != sizes.size() || built[i].Type != sizes[i].Type ||
+        built[i].Length != sizes[i].Length)
+      {
+      vtkGenericWarningMacro("Bad segments while unmarshaling data.");
+      return 0;
+      }
+    }
+  return built.size() == sizes.size();
+}
+
+//----------------------------------------------------------------------------
+int vtkCommunicator::DescribeDataObject(vtkDataObject *object,
+                                        vtkMultiProcessStream &header,
+                                        vtkstd::vector<vtkDataArray*> &segments)
+{
+  return vtkCommunicatorDescribeDataObject(object, header, segments);
+}
+
+//----------------------------------------------------------------------------
+int vtkCommunicator::BuildDataObject(vtkMultiProcessStream &header,
+                                     vtkDataObject *object,
+                                     vtkstd::vector<vtkDataArray*> &segments)
+{
+  vtkCommunicatorSegmentSizes sizes;
+  return vtkCommunicatorBuildDataObject(header, object, segments, sizes);
+}
+
+//=============================================================================
+// A request queued on a communicator, with the process its point-to-point
+// operation exchanges with, or -1 for any other operation.
+struct vtkCommunicatorQueueEntry
+{
+  vtkCommunicatorRequest *Request;
+  int Peer;
+  int Send;
+};
+
+// Requests queued on a communicator, oldest first.  The queue holds a
+// reference to each of them.
+class vtkCommunicatorRequestQueue
+  : public vtkstd::deque<vtkCommunicatorQueueEntry>
+{
+};
+
+// Orders point-to-point operations pair by pair, in the same order on
+// every process: by the higher and then the lower process of the pair,
+// the lower process sending before it receives and the higher one
+// receiving before it sends.  The sort is stable, so the operations of
+// a pair in the same direction keep their issue order.
+class vtkCommunicatorPairOrder
+{
+public:
+  vtkCommunicatorPairOrder(int localProcessId)
+    {
+    this->LocalProcessId = localProcessId;
+    }
+
+  bool operator()(const vtkCommunicatorQueueEntry &a,
+                  const vtkCommunicatorQueueEntry &b) const
+    {
+    int ka[3], kb[3];
+    this->Key(a, ka);
+    this->Key(b, kb);
+    return vtkstd::lexicographical_compare(ka, ka + 3, kb, kb + 3);
+    }
+
+  void Key(const vtkCommunicatorQueueEntry &e, int key[3]) const
+    {
+    int me = this->LocalProcessId;
+    key[0] = (me > e.Peer) ? me : e.Peer;
+    key[1] = (me > e.Peer) ? e.Peer : me;
+    key[2] = ((me <= e.Peer) == (e.Send != 0)) ? 0 : 1;
+    }
+
+  int LocalProcessId;
+};
+
+//-----------------------------------------------------------------------------
+// A queued operation, carried out with the blocking methods.
+class vtkCommunicatorQueuedOperation : public vtkCommunicatorRequest::Operation
+{
+public:
+  enum Kinds
+  {
+    SEND_DATA_OBJECT,
+    SEND_DATA_ARRAY,
+    SEND_VOID_ARRAY,
+    RECEIVE_DATA_OBJECT,
+    RECEIVE_DATA_ARRAY,
+    RECEIVE_VOID_ARRAY,
+    BARRIER,
+    BROADCAST_DATA_OBJECT,
+    BROADCAST_DATA_ARRAY,
+    GATHER,
+    REDUCE,
+    ALL_REDUCE
+  };
+
+  // Description:
+  // Return the process a send or a receive exchanges with, or -1 for
+  // collective operations and receives from any process.
+  int GetPeer()
+    {
+    switch (this->Kind)
+      {
+      case SEND_DATA_OBJECT:
+      case SEND_DATA_ARRAY:
+      case SEND_VOID_ARRAY:
+      case RECEIVE_DATA_OBJECT:
+      case RECEIVE_DATA_ARRAY:
+      case RECEIVE_VOID_ARRAY:
+        return (this->ProcessId >= 0) ? this->ProcessId : -1;
+      default:
+        return -1;
+      }
+    }
+
+  int IsSend()
+    {
+    return this->Kind == SEND_DATA_OBJECT || this->Kind == SEND_DATA_ARRAY ||
+      this->Kind == SEND_VOID_ARRAY;
+    }
+
+  vtkCommunicatorQueuedOperation(vtkCommunicator *comm, int kind)
+    {
+    this->Communicator = comm;
+    this->Kind = kind;
+    this->Buffer = NULL;
+    this->Length = 0;
+    this->Type = 0;
+    this->ProcessId = 0;
+    this->Tag = 0;
+    this->Op = 0;
+    }
+
+  int Progress(int, int &status)
+    {
+    vtkCommunicator *c = this->Communicator;
+    switch (this->Kind)
+      {
+      case SEND_DATA_OBJECT:
+        status = c->Send(this->Object, this->ProcessId, this->Tag);
+        break;
+      case SEND_DATA_ARRAY:
+        status = c->Send(this->SendArray, this->ProcessId, this->Tag);
+        break;
+      case SEND_VOID_ARRAY:
+        status = c->SendVoidArray(this->Buffer, this->Length, this->Type,
+                                  this->ProcessId, this->Tag);
+        break;
+      case RECEIVE_DATA_OBJECT:
+        status = c->Receive(this->Object, this->ProcessId, this->Tag);
+        break;
+      case RECEIVE_DATA_ARRAY:
+        status = c->Receive(this->RecvArray, this->ProcessId, this->Tag);
+        break;
+      case RECEIVE_VOID_ARRAY:
+        status = c->ReceiveVoidArray(this->Buffer, this->Length, this->Type,
+                                     this->ProcessId, this->Tag);
+        break;
+      case BARRIER:
+        c->Barrier();
+        status = 1;
+        break;
+      case BROADCAST_DATA_OBJECT:
+        status = c->Broadcast(this->Object, this->ProcessId);
+        break;
+      case BROADCAST_DATA_ARRAY:
+        status = c->Broadcast(this->RecvArray, this->ProcessId);
+        break;
+      case GATHER:
+        status = c->Gather(this->SendArray, this->RecvArray, this->ProcessId);
+        break;
+      case REDUCE:
+        status = c->Reduce(this->SendArray, this->RecvArray, this->Op,
+                           this->ProcessId);
+        break;
+      case ALL_REDUCE:
+        status = c->AllReduce(this->SendArray, this->RecvArray, this->Op);
+        break;
+      default:
+        status = 0;
+      }
+    return 1;
+    }
+
+  vtkCommunicator *Communicator;
+  int Kind;
+  vtkSmartPointer<vtkDataObject> Object;
+  vtkSmartPointer<vtkDataArray> SendArray;
+  vtkSmartPointer<vtkDataArray> RecvArray;
+  void *Buffer;
+  vtkIdType Length;
+  int Type;
+  int ProcessId;
+  int Tag;
+  int Op;
+};
+
 //=============================================================================
 vtkCommunicator::vtkCommunicator()
 {
@@ -111,11 +931,255 @@ vtkCommunicator::vtkCommunicator()
   this->NumberOfProcesses = 1;
   this->MaximumNumberOfProcesses = vtkTypeTraits<int>::Max();
   this->Count = 0;
+  this->RequestQueue = new vtkCommunicatorRequestQueue;
 }
 
 //----------------------------------------------------------------------------
 vtkCommunicator::~vtkCommunicator()
 {
+  // The operations of requests still queued can no longer be carried out.
+  while (!this->RequestQueue->empty())
+    {
+    vtkCommunicatorRequest *request = this->RequestQueue->front().Request;
+    this->RequestQueue->pop_front();
+    request->Queue = NULL;
+    request->Complete(0);
+    request->UnRegister(this);
+    }
+  delete this->RequestQueue;
+}
+
+//----------------------------------------------------------------------------
+void vtkCommunicator::QueueRequest(vtkCommunicatorRequest *request)
+{
+  this->QueueRequest(request, -1, 0);
+}
+
+//----------------------------------------------------------------------------
+void vtkCommunicator::QueueRequest(vtkCommunicatorRequest *request,
+                                   int peer, int send)
+{
+  request->Register(this);
+  request->Queue = this;
+  vtkCommunicatorQueueEntry entry;
+  entry.Request = request;
+  entry.Peer = peer;
+  entry.Send = send;
+  this->RequestQueue->push_back(entry);
+}
+
+//----------------------------------------------------------------------------
+void vtkCommunicator::CompleteQueuedRequests(vtkCommunicatorRequest *last)
+{
+  while (!this->RequestQueue->empty() && !last->Completed)
+    {
+    // Take the point-to-point operations at the front of the queue, or
+    // else the first operation, and carry them out pair by pair.
+    size_t count = 0;
+    while (count < this->RequestQueue->size() &&
+           (*this->RequestQueue)[count].Peer >= 0)
+      {
+      count++;
+      }
+    count = (count > 0) ? count : 1;
+    vtkstd::vector<vtkCommunicatorQueueEntry> batch(
+      this->RequestQueue->begin(), this->RequestQueue->begin() + count);
+    this->RequestQueue->erase(this->RequestQueue->begin(),
+                              this->RequestQueue->begin() + count);
+    vtkstd::stable_sort(batch.begin(), batch.end(),
+                        vtkCommunicatorPairOrder(this->LocalProcessId));
+    for (size_t i = 0; i < batch.size(); i++)
+      {
+      vtkCommunicatorRequest *request = batch[i].Request;
+      request->Queue = NULL;
+      int status = 0;
+      if (request->Op)
+        {
+        request->Op->Progress(1, status);
+        }
+      request->Complete(status);
+      request->UnRegister(this);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCommunicator::DequeueRequest(vtkCommunicatorRequest *request)
+{
+  vtkCommunicatorRequestQueue::iterator it;
+  for (it = this->RequestQueue->begin(); it != this->RequestQueue->end(); ++it)
+    {
+    if (it->Request == request)
+      {
+      this->RequestQueue->erase(it);
+      request->Queue = NULL;
+      request->UnRegister(this);
+      return;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkCommunicator::HasQueuedRequests()
+{
+  return this->RequestQueue->empty() ? 0 : 1;
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkCommunicator::NewQueuedRequest(
+  vtkCommunicatorQueuedOperation *operation)
+{
+  vtkCommunicatorRequest *request = vtkCommunicatorRequest::New();
+  request->SetOperation(operation, NULL);
+  this->QueueRequest(request, operation->GetPeer(), operation->IsSend());
+  return request;
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkCommunicator::NoBlockSend(vtkDataObject *data,
+                                                     int remoteHandle, int tag)
+{
+  vtkCommunicatorQueuedOperation *op = new vtkCommunicatorQueuedOperation(
+    this, vtkCommunicatorQueuedOperation::SEND_DATA_OBJECT);
+  op->Object = data;
+  op->ProcessId = remoteHandle;
+  op->Tag = tag;
+  return this->NewQueuedRequest(op);
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkCommunicator::NoBlockSend(vtkDataArray *data,
+                                                     int remoteHandle, int tag)
+{
+  vtkCommunicatorQueuedOperation *op = new vtkCommunicatorQueuedOperation(
+    this, vtkCommunicatorQueuedOperation::SEND_DATA_ARRAY);
+  op->SendArray = data;
+  op->ProcessId = remoteHandle;
+  op->Tag = tag;
+  return this->NewQueuedRequest(op);
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkCommunicator::NoBlockReceive(vtkDataObject *data,
+                                                        int remoteHandle,
+                                                        int tag)
+{
+  vtkCommunicatorQueuedOperation *op = new vtkCommunicatorQueuedOperation(
+    this, vtkCommunicatorQueuedOperation::RECEIVE_DATA_OBJECT);
+  op->Object = data;
+  op->ProcessId = remoteHandle;
+  op->Tag = tag;
+  return this->NewQueuedRequest(op);
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkCommunicator::NoBlockReceive(vtkDataArray *data,
+                                                        int remoteHandle,
+                                                        int tag)
+{
+  vtkCommunicatorQueuedOperation *op = new vtkCommunicatorQueuedOperation(
+    this, vtkCommunicatorQueuedOperation::RECEIVE_DATA_ARRAY);
+  op->RecvArray = data;
+  op->ProcessId = remoteHandle;
+  op->Tag = tag;
+  return this->NewQueuedRequest(op);
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkCommunicator::NoBlockSendVoidArray(
+  const void *data, vtkIdType length, int type, int remoteHandle, int tag)
+{
+  vtkCommunicatorQueuedOperation *op = new vtkCommunicatorQueuedOperation(
+    this, vtkCommunicatorQueuedOperation::SEND_VOID_ARRAY);
+  op->Buffer = const_cast<void*>(data);
+  op->Length = length;
+  op->Type = type;
+  op->ProcessId = remoteHandle;
+  op->Tag = tag;
+  return this->NewQueuedRequest(op);
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkCommunicator::NoBlockReceiveVoidArray(
+  void *data, vtkIdType maxlength, int type, int remoteHandle, int tag)
+{
+  vtkCommunicatorQueuedOperation *op = new vtkCommunicatorQueuedOperation(
+    this, vtkCommunicatorQueuedOperation::RECEIVE_VOID_ARRAY);
+  op->Buffer = data;
+  op->Length = maxlength;
+  op->Type = type;
+  op->ProcessId = remoteHandle;
+  op->Tag = tag;
+  return this->NewQueuedRequest(op);
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkCommunicator::NoBlockBarrier()
+{
+  return this->NewQueuedRequest(new vtkCommunicatorQueuedOperation(
+      this, vtkCommunicatorQueuedOperation::BARRIER));
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkCommunicator::NoBlockBroadcast(vtkDataObject *data,
+                                                          int srcProcessId)
+{
+  vtkCommunicatorQueuedOperation *op = new vtkCommunicatorQueuedOperation(
+    this, vtkCommunicatorQueuedOperation::BROADCAST_DATA_OBJECT);
+  op->Object = data;
+  op->ProcessId = srcProcessId;
+  return this->NewQueuedRequest(op);
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkCommunicator::NoBlockBroadcast(vtkDataArray *data,
+                                                          int srcProcessId)
+{
+  vtkCommunicatorQueuedOperation *op = new vtkCommunicatorQueuedOperation(
+    this, vtkCommunicatorQueuedOperation::BROADCAST_DATA_ARRAY);
+  op->RecvArray = data;
+  op->ProcessId = srcProcessId;
+  return this->NewQueuedRequest(op);
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkCommunicator::NoBlockGather(vtkDataArray *sendBuffer,
+                                                       vtkDataArray *recvBuffer,
+                                                       int destProcessId)
+{
+  vtkCommunicatorQueuedOperation *op = new vtkCommunicatorQueuedOperation(
+    this, vtkCommunicatorQueuedOperation::GATHER);
+  op->SendArray = sendBuffer;
+  op->RecvArray = recvBuffer;
+  op->ProcessId = destProcessId;
+  return this->NewQueuedRequest(op);
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkCommunicator::NoBlockReduce(vtkDataArray *sendBuffer,
+                                                       vtkDataArray *recvBuffer,
+                                                       int operation,
+                                                       int destProcessId)
+{
+  vtkCommunicatorQueuedOperation *op = new vtkCommunicatorQueuedOperation(
+    this, vtkCommunicatorQueuedOperation::REDUCE);
+  op->SendArray = sendBuffer;
+  op->RecvArray = recvBuffer;
+  op->Op = operation;
+  op->ProcessId = destProcessId;
+  return this->NewQueuedRequest(op);
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkCommunicator::NoBlockAllReduce(
+  vtkDataArray *sendBuffer, vtkDataArray *recvBuffer, int operation)
+{
+  vtkCommunicatorQueuedOperation *op = new vtkCommunicatorQueuedOperation(
+    this, vtkCommunicatorQueuedOperation::ALL_REDUCE);
+  op->SendArray = sendBuffer;
+  op->RecvArray = recvBuffer;
+  op->Op = operation;
+  return this->NewQueuedRequest(op);
 }
 
 //----------------------------------------------------------------------------
@@ -125,6 +1189,18 @@ void vtkCommunicator::SetUseCopy(int useCopy)
   vtkCommunicator::UseCopy = useCopy;
 }
 
+//----------------------------------------------------------------------------
+int vtkCommunicator::UseNativeMarshaling = 1;
+void vtkCommunicator::SetUseNativeMarshaling(int useNative)
+{
+  vtkCommunicator::UseNativeMarshaling = useNative;
+}
+
+int vtkCommunicator::GetUseNativeMarshaling()
+{
+  return vtkCommunicator::UseNativeMarshaling;
+}
+
 //----------------------------------------------------------------------------
 void vtkCommunicator::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -277,6 +1353,41 @@ int vtkCommunicator::SendElementalDataObject(
   vtkDataObject* data, int remoteHandle, 
   int tag)
 {
+  vtkMultiProcessStream header;
+  vtkCommunicatorSegments segments;
+  int format = VTK_COMMUNICATOR_LEGACY_FORMAT;
+  if (vtkCommunicator::UseNativeMarshaling &&
+      this->RemoteHasSameIdTypeSize(remoteHandle) &&
+      vtkCommunicatorDescribeDataObject(data, header, segments))
+    {
+    format = VTK_COMMUNICATOR_NATIVE_FORMAT;
+    }
+  if (!this->Send(&format, 1, remoteHandle, tag))
+    {
+    return 0;
+    }
+
+  if (format == VTK_COMMUNICATOR_NATIVE_FORMAT)
+    {
+    if (!this->Send(header, remoteHandle, tag))
+      {
+      return 0;
+      }
+    // Send each array from its own memory.
+    for (size_t i = 0; i < segments.size(); i++)
+      {
+      vtkDataArray *array = segments[i];
+      if (!this->SendVoidArray(array->GetVoidPointer(0),
+                               array->GetNumberOfTuples()*
+                               array->GetNumberOfComponents(),
+                               array->GetDataType(), remoteHandle, tag))
+        {
+        return 0;
+        }
+      }
+    return 1;
+    }
+
   VTK_CREATE(vtkCharArray, buffer);
   if (vtkCommunicator::MarshalDataObject(data, buffer))
     {
@@ -529,6 +1640,47 @@ int vtkCommunicator::ReceiveElementalDataObject(
   vtkDataObject* data, int remoteHandle, 
   int tag)
 {
+  int format = VTK_COMMUNICATOR_LEGACY_FORMAT;
+  if (!this->Receive(&format, 1, remoteHandle, tag))
+    {
+    return 0;
+    }
+
+  if (format == VTK_COMMUNICATOR_NATIVE_FORMAT)
+    {
+    vtkMultiProcessStream header;
+    vtkCommunicatorSegments segments;
+    vtkCommunicatorSegmentSizes sizes;
+    if (!this->Receive(header, remoteHandle, tag))
+      {
+      return 0;
+      }
+    int built = vtkCommunicatorBuildDataObject(header, data, segments, sizes);
+    // Receive each array straight into its own memory.  If the data set
+    // could not be built, receive into scratch arrays that are dropped, so
+    // that no segment is left to be taken for a later message.
+    int result = built;
+    for (size_t i = 0; i < sizes.size(); i++)
+      {
+      vtkDataArray *array = built ? segments[i]
+        : vtkCommunicatorNewScratchSegment(sizes[i]);
+      if (array == NULL)
+        {
+        vtkErrorMacro("Could not receive the values of a data set.");
+        return 0;
+        }
+      result &= this->ReceiveVoidArray(array->GetVoidPointer(0),
+                                       static_cast<vtkIdType>(
+                                         sizes[i].Length),
+                                       sizes[i].Type, remoteHandle, tag);
+      if (!built)
+        {
+        array->Delete();
+        }
+      }
+    return result;
+    }
+
   VTK_CREATE(vtkCharArray, buffer);
   if (!this->Receive(buffer, remoteHandle, tag))
     {
@@ -931,6 +2083,71 @@ int vtkCommunicator::BroadcastVoidArray(void *data, vtkIdType length,
 //-----------------------------------------------------------------------------
 int vtkCommunicator::Broadcast(vtkDataObject *data, int srcProcessId)
 {
+  vtkMultiProcessStream header;
+  vtkCommunicatorSegments segments;
+  int format = VTK_COMMUNICATOR_LEGACY_FORMAT;
+  if (this->LocalProcessId == srcProcessId &&
+      vtkCommunicator::UseNativeMarshaling)
+    {
+    format = VTK_COMMUNICATOR_NATIVE_FORMAT;
+    for (int i = 0; i < this->NumberOfProcesses; i++)
+      {
+      if (i != srcProcessId && !this->RemoteHasSameIdTypeSize(i))
+        {
+        format = VTK_COMMUNICATOR_LEGACY_FORMAT;
+        }
+      }
+    if (format == VTK_COMMUNICATOR_NATIVE_FORMAT &&
+        !vtkCommunicatorDescribeDataObject(data, header, segments))
+      {
+      format = VTK_COMMUNICATOR_LEGACY_FORMAT;
+      }
+    }
+  if (!this->Broadcast(&format, 1, srcProcessId))
+    {
+    return 0;
+    }
+
+  if (format == VTK_COMMUNICATOR_NATIVE_FORMAT)
+    {
+    if (!this->Broadcast(header, srcProcessId))
+      {
+      return 0;
+      }
+    vtkCommunicatorSegmentSizes sizes;
+    int built = 1;
+    if (this->LocalProcessId == srcProcessId)
+      {
+      vtkCommunicatorGetSegmentSizes(segments, sizes);
+      }
+    else
+      {
+      built = vtkCommunicatorBuildDataObject(header, data, segments, sizes);
+      }
+    // Every process takes part in the broadcast of every segment, also
+    // after an error, since the others wait for it.
+    int result = built;
+    for (size_t i = 0; i < sizes.size(); i++)
+      {
+      vtkDataArray *array = built ? segments[i]
+        : vtkCommunicatorNewScratchSegment(sizes[i]);
+      if (array == NULL)
+        {
+        vtkErrorMacro("Could not take part in the broadcast of a data set.");
+        return 0;
+        }
+      result &= this->BroadcastVoidArray(array->GetVoidPointer(0),
+                                         static_cast<vtkIdType>(
+                                           sizes[i].Length),
+                                         sizes[i].Type, srcProcessId);
+      if (!built)
+        {
+        array->Delete();
+        }
+      }
+    return result;
+    }
+
   VTK_CREATE(vtkCharArray, buffer);
   if (this->LocalProcessId == srcProcessId)
     {
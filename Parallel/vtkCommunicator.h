@@ -17,7 +17,9 @@
 // This is an abstact class which contains functionality for sending
 // and receiving inter-process messages. It contains methods for marshaling
 // an object into a string (currently used by the MPI communicator but
-// not the shared memory communicator).
+// not the shared memory communicator).  Data sets are sent in a native
+// format that transfers their arrays without copying them; see
+// SetUseNativeMarshaling().
 
 // .SECTION Caveats
 // Communication between systems with different vtkIdTypes is not
@@ -30,9 +32,14 @@
 #define __vtkCommunicator_h
 
 #include "vtkObject.h"
+#include "vtkCommunicatorRequest.h" // for vtkCommunicatorRequest::Operation
+
+#include <vtkstd/vector> // for the segments of the native format
 
 class vtkBoundingBox;
 class vtkCharArray;
+class vtkCommunicatorQueuedOperation;
+class vtkCommunicatorRequestQueue;
 class vtkDataArray;
 class vtkDataObject;
 class vtkDataSet;
@@ -231,6 +238,41 @@ public:
   int Receive(vtkMultiProcessStream& stream, int remoteId, int tag);
 //ETX
 
+  // Description:
+  // Nonblocking versions of Send() and Receive().  They return a request
+  // that the caller must delete; the data must not be touched before the
+  // request completes (see vtkCommunicatorRequest).  Unless a subclass
+  // overrides these methods with operations that overlap computation,
+  // the operations are queued and carried out by the blocking methods
+  // once a request is tested or waited on.  The sends and receives with a
+  // given process queued at that time are then carried out pair by pair,
+  // in the same order on every process: the lower process of a pair sends
+  // before it receives and the higher one receives before it sends.  So
+  // exchanges of any size do not deadlock as long as every process posts
+  // all sends and receives of the exchange before it tests or waits on
+  // any of them.  A message is only sent once its process tests or waits
+  // on a request, receives from ANY_SOURCE and the collective operations
+  // are carried out in issue order, and pending requests must complete
+  // before the blocking methods are used again.
+  virtual vtkCommunicatorRequest *NoBlockSend(vtkDataObject *data,
+                                              int remoteHandle, int tag);
+  virtual vtkCommunicatorRequest *NoBlockSend(vtkDataArray *data,
+                                              int remoteHandle, int tag);
+  virtual vtkCommunicatorRequest *NoBlockReceive(vtkDataObject *data,
+                                                 int remoteHandle, int tag);
+  virtual vtkCommunicatorRequest *NoBlockReceive(vtkDataArray *data,
+                                                 int remoteHandle, int tag);
+  virtual vtkCommunicatorRequest *NoBlockSendVoidArray(const void *data,
+                                                       vtkIdType length,
+                                                       int type,
+                                                       int remoteHandle,
+                                                       int tag);
+  virtual vtkCommunicatorRequest *NoBlockReceiveVoidArray(void *data,
+                                                          vtkIdType maxlength,
+                                                          int type,
+                                                          int remoteHandle,
+                                                          int tag);
+
   // Description:
   // Returns the number of words received by the most recent Receive().
   // Note that this is not the number of bytes received, but the number of items
@@ -247,6 +289,25 @@ public:
   // function.
   virtual void Barrier();
 
+  // Description:
+  // Nonblocking versions of Barrier(), Broadcast(), Gather(), Reduce() and
+  // AllReduce().  They return a request like NoBlockSend().  All processes
+  // must issue the same collective operations in the same order.
+  vtkCommunicatorRequest *NoBlockBarrier();
+  vtkCommunicatorRequest *NoBlockBroadcast(vtkDataObject *data,
+                                           int srcProcessId);
+  vtkCommunicatorRequest *NoBlockBroadcast(vtkDataArray *data,
+                                           int srcProcessId);
+  vtkCommunicatorRequest *NoBlockGather(vtkDataArray *sendBuffer,
+                                        vtkDataArray *recvBuffer,
+                                        int destProcessId);
+  vtkCommunicatorRequest *NoBlockReduce(vtkDataArray *sendBuffer,
+                                        vtkDataArray *recvBuffer,
+                                        int operation, int destProcessId);
+  vtkCommunicatorRequest *NoBlockAllReduce(vtkDataArray *sendBuffer,
+                                           vtkDataArray *recvBuffer,
+                                           int operation);
+
   // Description:
   // Broadcast sends the array in the process with id \c srcProcessId to all of
   // the other processes.  All processes must call these method with the same
@@ -801,6 +862,18 @@ public:
 
   static void SetUseCopy(int useCopy);
 
+  // Description:
+  // Set/Get whether data sets are sent, received and broadcast in the
+  // native format.  It describes the structure of the data set in a small
+  // header and sends each of its arrays straight from, and receives it
+  // straight into, the memory of the array, instead of marshaling the data
+  // set into a legacy VTK file.  Data objects the native format does not
+  // cover (graphs, tables, polyhedra, string arrays, ...) are always
+  // marshaled, and so are data sets sent to a process whose vtkIdType has
+  // a different size (see RemoteHasSameIdTypeSize()).  On by default.
+  static void SetUseNativeMarshaling(int useNative);
+  static int GetUseNativeMarshaling();
+
 //BTX
   // Description:
   // Determine the global bounds for a set of processes.  BBox is
@@ -835,6 +908,24 @@ public:
   static int MarshalDataObject(vtkDataObject *object, vtkCharArray *buffer);
   static int UnMarshalDataObject(vtkCharArray *buffer, vtkDataObject *object);
 
+//BTX
+  // Description:
+  // The native format, in which SendElementalDataObject() sends data sets
+  // without copying their arrays.  DescribeDataObject() writes the
+  // structure of the data set to the header and appends the arrays whose
+  // values follow it to \c segments, in order; it returns 0 for data
+  // objects the native format does not cover.  BuildDataObject() reads
+  // such a header into a data object of the same type and appends the
+  // arrays it allocates to \c segments, to be filled with those values.
+  // It returns 0 on error.
+  static int DescribeDataObject(vtkDataObject *object,
+                                vtkMultiProcessStream &header,
+                                vtkstd::vector<vtkDataArray*> &segments);
+  static int BuildDataObject(vtkMultiProcessStream &header,
+                             vtkDataObject *object,
+                             vtkstd::vector<vtkDataArray*> &segments);
+//ETX
+
 protected:
 
   int WriteDataArray(vtkDataArray *object);
@@ -856,12 +947,45 @@ protected:
   int ReceiveTemporalDataSet(
     vtkTemporalDataSet* data, int remoteHandle, int tag);
 
+  // Description:
+  // Return 0 if the given process is known to use a vtkIdType of another
+  // size, in which case data sets are sent to it in the legacy format
+  // rather than in the native one.  The processes of a communicator are
+  // assumed to be built alike, so this returns 1 unless overridden.
+  virtual int RemoteHasSameIdTypeSize(int vtkNotUsed(remoteHandle))
+    { return 1; }
+
+  // Description:
+  // Queue a request, whose operation is then carried out when it or a
+  // request queued after it is tested or waited on.  A point-to-point
+  // operation gives the process it exchanges with and whether it sends.
+  // CompleteQueuedRequests() carries out the queued operations until the
+  // given request has completed, the point-to-point ones pair by pair
+  // (see NoBlockSend()) and the others in order.  DequeueRequest() takes
+  // a request off the queue without carrying out its operation.
+  void QueueRequest(vtkCommunicatorRequest *request);
+  void QueueRequest(vtkCommunicatorRequest *request, int peer, int send);
+  void CompleteQueuedRequests(vtkCommunicatorRequest *last);
+  void DequeueRequest(vtkCommunicatorRequest *request);
+  int HasQueuedRequests();
+//BTX
+  friend class vtkCommunicatorRequest;
+
+  // Description:
+  // Return a new request for the operation, queued.
+  vtkCommunicatorRequest *NewQueuedRequest(
+    vtkCommunicatorQueuedOperation *operation);
+//ETX
+
+  vtkCommunicatorRequestQueue *RequestQueue;
+
   int MaximumNumberOfProcesses;
   int NumberOfProcesses;
 
   int LocalProcessId;
 
   static int UseCopy;
+  static int UseNativeMarshaling;
 
   vtkIdType Count;
 
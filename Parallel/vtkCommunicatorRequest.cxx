@@ -0,0 +1,138 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCommunicatorRequest.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCommunicatorRequest.h"
+
+#include "vtkCommunicator.h"
+#include "vtkObjectFactory.h"
+
+vtkStandardNewMacro(vtkCommunicatorRequest);
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest::vtkCommunicatorRequest()
+{
+  this->Op = NULL;
+  this->Queue = NULL;
+  this->Completed = 0;
+  this->Status = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest::~vtkCommunicatorRequest()
+{
+  // A queued request is referenced by its communicator, so it cannot be
+  // destroyed before it completes.
+  delete this->Op;
+}
+
+//----------------------------------------------------------------------------
+void vtkCommunicatorRequest::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Completed: " << this->Completed << endl;
+  os << indent << "Status: " << this->Status << endl;
+  os << indent << "Queued: " << (this->Queue ? 1 : 0) << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkCommunicatorRequest::SetOperation(Operation *operation,
+                                          vtkCommunicator *queue)
+{
+  delete this->Op;
+  this->Op = operation;
+  this->Completed = 0;
+  this->Status = 0;
+  if (queue)
+    {
+    queue->QueueRequest(this);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCommunicatorRequest::Complete(int status)
+{
+  delete this->Op;
+  this->Op = NULL;
+  this->Completed = 1;
+  this->Status = status;
+}
+
+//----------------------------------------------------------------------------
+int vtkCommunicatorRequest::Progress(int block)
+{
+  if (this->Completed)
+    {
+    return 1;
+    }
+  if (this->Queue)
+    {
+    // Queued operations run in issue order.
+    this->Queue->CompleteQueuedRequests(this);
+    return this->Completed;
+    }
+  if (!this->Op)
+    {
+    this->Complete(0);
+    return 1;
+    }
+  int status = 0;
+  if (this->Op->Progress(block, status))
+    {
+    this->Complete(status);
+    }
+  return this->Completed;
+}
+
+//----------------------------------------------------------------------------
+int vtkCommunicatorRequest::Test()
+{
+  return this->Progress(0);
+}
+
+//----------------------------------------------------------------------------
+int vtkCommunicatorRequest::Wait()
+{
+  this->Progress(1);
+  return this->Status;
+}
+
+//----------------------------------------------------------------------------
+void vtkCommunicatorRequest::Cancel()
+{
+  if (this->Completed)
+    {
+    return;
+    }
+  if (this->Queue)
+    {
+    this->Queue->DequeueRequest(this);
+    }
+  // Deleting the operation cancels what it has posted.
+  this->Complete(0);
+}
+
+//----------------------------------------------------------------------------
+int vtkCommunicatorRequest::WaitAll(int numberOfRequests,
+                                    vtkCommunicatorRequest **requests)
+{
+  int status = 1;
+  for (int i = 0; i < numberOfRequests; i++)
+    {
+    if (requests[i] && !requests[i]->Wait())
+      {
+      status = 0;
+      }
+    }
+  return status;
+}
@@ -0,0 +1,131 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCommunicatorRequest.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkCommunicatorRequest - handle on a nonblocking communication
+// .SECTION Description
+// The NoBlock methods of vtkCommunicator and vtkMultiProcessController
+// start an operation and return a vtkCommunicatorRequest for it.  The
+// buffers, arrays and data objects given to the operation must not be
+// touched until Test() returns 1 or Wait() returns.  The caller owns the
+// request and deletes it when done, completed or not.
+//
+// Communicators that cannot overlap an operation with computation queue
+// it instead and carry it out with their blocking methods when the
+// request, or a request issued after it, is tested or waited on.  Their
+// sends and receives complete pair by pair and their other operations in
+// the order they were issued (see vtkCommunicator::NoBlockSend()), so
+// Test() on such a request may block.
+//
+// .SECTION See Also
+// vtkCommunicator vtkMultiProcessController
+
+#ifndef __vtkCommunicatorRequest_h
+#define __vtkCommunicatorRequest_h
+
+#include "vtkObject.h"
+
+class vtkCommunicator;
+
+class VTK_PARALLEL_EXPORT vtkCommunicatorRequest : public vtkObject
+{
+public:
+  static vtkCommunicatorRequest *New();
+  vtkTypeMacro(vtkCommunicatorRequest, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Move the operation forward and return 1 if it has completed and 0
+  // otherwise.
+  int Test();
+
+  // Description:
+  // Block until the operation completes.  Returns 1 if it succeeded and 0
+  // if it failed.
+  int Wait();
+
+  // Description:
+  // Wait for all of the given requests.  NULL entries are skipped.
+  // Returns 1 if all operations succeeded and 0 otherwise.
+  static int WaitAll(int numberOfRequests, vtkCommunicatorRequest **requests);
+
+  // Description:
+  // Give up on the operation: a queued request is taken off its
+  // communicator's queue and a posted one is cancelled.  The request is
+  // then completed with a status of 0, unless it had already completed.
+  // Cancel receives that may never be matched before deleting them.
+  void Cancel();
+
+  // Description:
+  // Get whether the operation has completed and, once it has, whether it
+  // succeeded (1) or failed (0).
+  vtkGetMacro(Completed, int);
+  vtkGetMacro(Status, int);
+
+  // Description:
+  // Returns 1 while the request waits in its communicator's queue to be
+  // carried out by the blocking methods.  Test() may block on such a
+  // request.
+  int GetQueued() { return this->Queue ? 1 : 0; }
+
+//BTX
+  // Description:
+  // The work behind a request.  Communicators derive from it to implement
+  // their operations.
+  class VTK_PARALLEL_EXPORT Operation
+  {
+  public:
+    // Description:
+    // Carry the operation forward.  If \c block is nonzero, only return
+    // once it has completed.  Returns 1 once the operation has completed,
+    // with its result in \c status, and 0 otherwise.
+    virtual int Progress(int block, int &status) = 0;
+
+    virtual ~Operation() {}
+  };
+
+  // Description:
+  // Give the request the operation it stands for; the request deletes it
+  // once it completes.  If \c queue is given, the operation is queued on
+  // that communicator (see vtkCommunicator::QueueRequest()).
+  void SetOperation(Operation *operation, vtkCommunicator *queue);
+
+  // Description:
+  // Mark the request as completed with the given status, dropping its
+  // operation.
+  void Complete(int status);
+//ETX
+
+protected:
+  vtkCommunicatorRequest();
+  ~vtkCommunicatorRequest();
+
+  int Progress(int block);
+
+//BTX
+  Operation *Op;
+//ETX
+  vtkCommunicator *Queue;
+  int Completed;
+  int Status;
+
+//BTX
+  friend class vtkCommunicator;
+//ETX
+
+private:
+  vtkCommunicatorRequest(const vtkCommunicatorRequest&);  // Not implemented.
+  void operator=(const vtkCommunicatorRequest&);  // Not implemented.
+};
+
+#endif
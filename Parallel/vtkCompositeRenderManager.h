@@ -37,7 +37,9 @@ public:
   virtual void PrintSelf(ostream &os, vtkIndent indent);
 
   // Description:
-  // Set/Get the composite algorithm.
+  // Set/Get the composite algorithm.  The default is a
+  // vtkCompressCompositer; vtkRadixKCompositer sends less data per
+  // process on many processes.
   void SetCompositer(vtkCompositer *c);
   vtkGetObjectMacro(Compositer, vtkCompositer);
 
@@ -71,7 +71,7 @@ void vtkExtractUnstructuredGridPiece::ComputeCellTags(vtkIntArray *tags,
 {
   int j;
   vtkIdType idx, numCells, ptId;
-  vtkIdType* cellPointer;
+  vtkCellArray* cells = input->GetCells();
   vtkIdType* ids;
   vtkIdType numCellPts;
 
@@ -87,8 +87,12 @@ void vtkExtractUnstructuredGridPiece::ComputeCellTags(vtkIntArray *tags,
       }
     }
     
-  // Brute force division.
-  cellPointer = (input->GetCells() ? input->GetCells()->GetPointer() : 0);
+  // Brute force division.  The cells are traversed rather than read from
+  // their interleaved list, which would convert the offsets storage.
+  if (cells)
+    {
+    cells->InitTraversal();
+    }
   for (idx = 0; idx < numCells; ++idx)
     {
     if ((idx * numPieces / numCells) == piece)
@@ -102,10 +106,7 @@ void vtkExtractUnstructuredGridPiece::ComputeCellTags(vtkIntArray *tags,
     // Fill in point ownership mapping.
     if (pointOwnership)
       {
-      numCellPts = cellPointer[0];
-      ids = cellPointer+1;
-      // Move to the next cell.
-      cellPointer += (1 + numCellPts);
+      cells->GetNextCell(numCellPts, ids);
       for (j = 0; j < numCellPts; ++j)
         {
         ptId = ids[j];
@@ -147,8 +148,8 @@ int vtkExtractUnstructuredGridPiece::RequestData(
   vtkIdList *pointOwnership = 0;
   vtkUnsignedCharArray* pointGhostLevels = 0;
   vtkIdType i, ptId, newId, numPts, numCells;
-  int numCellPts;
-  vtkIdType *cellPointer;
+  vtkIdType numCellPts;
+  vtkCellArray *cells;
   vtkIdType *ids;
   double *x;
 
@@ -211,15 +212,16 @@ int vtkExtractUnstructuredGridPiece::RequestData(
     }
 
   // Filter the cells
-  cellPointer = (input->GetCells() ? input->GetCells()->GetPointer() : 0);
+  cells = input->GetCells();
+  if (cells)
+    {
+    cells->InitTraversal();
+    }
   for (cellId=0; cellId < numCells; cellId++)
     {
     // Direct access to cells.
     cellType = cellTypes[cellId];
-    numCellPts = cellPointer[0];
-    ids = cellPointer+1;
-    // Move to the next cell.
-    cellPointer += (1 + *cellPointer);
+    cells->GetNextCell(numCellPts, ids);
 
     if ( cellTags->GetValue(cellId) != -1) // satisfied thresholding
       {
@@ -15,8 +15,12 @@
 
 #include "vtkMPICommunicator.h"
 
+#include "vtkCharArray.h"
+#include "vtkCommunicatorRequest.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkImageData.h"
 #include "vtkMPIController.h"
+#include "vtkMultiProcessStream.h"
 //#include "vtkMPIGroup.h"
 #include "vtkProcessGroup.h"
 #include "vtkObjectFactory.h"
@@ -30,6 +34,7 @@
 
 #include <vtkstd/vector>
 #include <assert.h>
+#include <string.h>
 
 static inline void  vtkMPICommunicatorDebugBarrier(MPI_Comm* handle)
 {
@@ -960,6 +965,687 @@ int vtkMPICommunicator::NoBlockReceive(vtkIdType* data, int length,
 }
 #endif
 
+//----------------------------------------------------------------------------
+// A nonblocking MPI send or receive behind a vtkCommunicatorRequest.
+class vtkMPICommunicatorRequestOperation
+  : public vtkCommunicatorRequest::Operation
+{
+public:
+  vtkMPICommunicatorRequestOperation()
+    {
+    this->Req.Req->Handle = MPI_REQUEST_NULL;
+    }
+
+  // A request deleted before it completes cancels its message; waiting on
+  // a cancelled request returns without waiting for the remote process.
+  ~vtkMPICommunicatorRequestOperation()
+    {
+    if (this->Req.Req->Handle != MPI_REQUEST_NULL)
+      {
+      MPI_Status mpiStatus;
+      MPI_Cancel(&this->Req.Req->Handle);
+      MPI_Wait(&this->Req.Req->Handle, &mpiStatus);
+      }
+    }
+
+  int Progress(int block, int &status)
+    {
+    MPI_Status mpiStatus;
+    int done = 1;
+    int err = block ? MPI_Wait(&this->Req.Req->Handle, &mpiStatus)
+      : MPI_Test(&this->Req.Req->Handle, &done, &mpiStatus);
+    if (err != MPI_SUCCESS)
+      {
+      char *msg = vtkMPIController::ErrorString(err);
+      vtkGenericWarningMacro("MPI error occured: " << msg);
+      delete[] msg;
+      status = 0;
+      return 1;
+      }
+    status = 1;
+    return done;
+    }
+
+  vtkMPICommunicator::Request Req;
+};
+
+//----------------------------------------------------------------------------
+// Nonblocking MPI messages behind a vtkCommunicatorRequest, posted in
+// stages: Advance() is called once the messages of a stage completed, and
+// either posts those of the next stage or finishes the operation.
+class vtkMPICommunicatorMessagesOperation
+  : public vtkCommunicatorRequest::Operation
+{
+public:
+  vtkMPICommunicatorMessagesOperation(MPI_Comm comm)
+    {
+    this->Comm = comm;
+    this->Source = 0;
+    this->Receiving = 0;
+    }
+
+  // A request deleted before it completes cancels its messages.
+  virtual ~vtkMPICommunicatorMessagesOperation()
+    {
+    for (size_t i = 0; i < this->Handles.size(); i++)
+      {
+      if (this->Handles[i] != MPI_REQUEST_NULL)
+        {
+        MPI_Status mpiStatus;
+        MPI_Cancel(&this->Handles[i]);
+        MPI_Wait(&this->Handles[i], &mpiStatus);
+        }
+      }
+    }
+
+  int Progress(int block, int &status)
+    {
+    for (;;)
+      {
+      int count = static_cast<int>(this->Handles.size());
+      if (count > 0)
+        {
+        vtkstd::vector<MPI_Status> statuses(count);
+        int done = 1;
+        int err = block
+          ? MPI_Waitall(count, &this->Handles[0], &statuses[0])
+          : MPI_Testall(count, &this->Handles[0], &done, &statuses[0]);
+        if (!vtkMPICommunicatorMessagesOperation::Check(err))
+          {
+          status = 0;
+          return 1;
+          }
+        if (!done)
+          {
+          return 0;
+          }
+        this->Handles.clear();
+        if (this->Source == vtkMultiProcessController::ANY_SOURCE)
+          {
+          // The rest of the message comes from the same process.
+          this->Source = statuses[0].MPI_SOURCE;
+          }
+        }
+      if (!this->Receiving || this->Advance(status))
+        {
+        status = this->Receiving ? status : 1;
+        return 1;
+        }
+      }
+    }
+
+  // Description:
+  // Return 1 if the MPI call succeeded and warn otherwise.
+  static int Check(int err)
+    {
+    if (err == MPI_SUCCESS)
+      {
+      return 1;
+      }
+    char *msg = vtkMPIController::ErrorString(err);
+    vtkGenericWarningMacro("MPI error occured: " << msg);
+    delete[] msg;
+    return 0;
+    }
+
+  // Description:
+  // Return the number of messages PostPieces() posts for \c count values.
+  static vtkTypeInt64 CountPieces(vtkIdType count)
+    {
+    vtkIdType maxCount = VTK_INT_MAX - 1;
+    return (count + maxCount - 1) / maxCount;
+    }
+
+protected:
+  // Description:
+  // Post the messages of the next stage of a receive and return 0, or
+  // return 1 once it is over, with its result in \c status.
+  virtual int Advance(int &status) = 0;
+
+  // Description:
+  // Post a send or a receive of the values, in pieces MPI can count in an
+  // int.
+  int PostPieces(void *data, vtkIdType count, int type, int remoteProcessId,
+                 int tag, int send)
+    {
+    MPI_Datatype mpiType = vtkMPICommunicatorGetMPIType(type);
+    int size;
+    MPI_Type_size(mpiType, &size);
+    char *values = static_cast<char*>(data);
+    vtkIdType maxCount = VTK_INT_MAX - 1;
+    while (count > 0)
+      {
+      int n = static_cast<int>(count < maxCount ? count : maxCount);
+      MPI_Request handle = MPI_REQUEST_NULL;
+      int err = send
+        ? MPI_Isend(values, n, mpiType, remoteProcessId, tag, this->Comm,
+                    &handle)
+        : MPI_Irecv(values, n, mpiType, remoteProcessId, tag, this->Comm,
+                    &handle);
+      if (!vtkMPICommunicatorMessagesOperation::Check(err))
+        {
+        return 0;
+        }
+      this->Handles.push_back(handle);
+      values += static_cast<vtkIdType>(n)*size;
+      count -= n;
+      }
+    return 1;
+    }
+
+  // Description:
+  // Return the tag of the payload of a new message sent on \c tag.  As
+  // with the blocking sends, it is mangled so that the pieces of the
+  // payload can not be taken for another message.
+  static int NewPayloadTag(int tag)
+    {
+    static int tagMangler = 1000;
+    return tag + tagMangler++;
+    }
+
+  MPI_Comm Comm;
+  int Source;
+  int Receiving;
+  vtkstd::vector<MPI_Request> Handles;
+};
+
+//----------------------------------------------------------------------------
+// A data array sent or received with nonblocking MPI calls.  The sender
+// posts a length message on the tag of the request, holding the tag of the
+// payload, the type of the values, the number of components and tuples
+// and the length of the name, and then the payload on that tag: the name
+// and the values.  The receiver posts the receive of the length message,
+// then the receives of the payload once it knows its size.
+class vtkMPICommunicatorArrayOperation
+  : public vtkMPICommunicatorMessagesOperation
+{
+public:
+  vtkMPICommunicatorArrayOperation(MPI_Comm comm)
+    : vtkMPICommunicatorMessagesOperation(comm)
+    {
+    this->Stage = LENGTH;
+    for (int i = 0; i < 5; i++)
+      {
+      this->Length[i] = 0;
+      }
+    }
+
+  // Description:
+  // Post the messages of a send of the array, or of a NULL one.
+  int PostSend(vtkDataArray *array, int remoteProcessId, int tag)
+    {
+    this->Array = array;
+    this->Source = remoteProcessId;
+    this->Length[0] = NewPayloadTag(tag);
+    this->Length[1] = array ? array->GetDataType() : -1;
+    if (array)
+      {
+      const char *name = array->GetName();
+      this->Length[2] = array->GetNumberOfComponents();
+      this->Length[3] = array->GetNumberOfTuples();
+      if (name)
+        {
+        this->Length[4] = static_cast<vtkTypeInt64>(strlen(name)) + 1;
+        this->Name.assign(name, name + this->Length[4]);
+        }
+      }
+    if (!this->PostPieces(this->Length, 5, VTK_TYPE_INT64, remoteProcessId,
+                          tag, 1))
+      {
+      return 0;
+      }
+    return array ? this->PostPayload(1) : 1;
+    }
+
+  // Description:
+  // Post the receive of the length message into the array.
+  int PostReceive(vtkDataArray *array, int remoteProcessId, int tag)
+    {
+    this->Array = array;
+    this->Receiving = 1;
+    this->Source = remoteProcessId;
+    if (remoteProcessId == vtkMultiProcessController::ANY_SOURCE)
+      {
+      remoteProcessId = MPI_ANY_SOURCE;
+      }
+    return this->PostPieces(this->Length, 5, VTK_TYPE_INT64, remoteProcessId,
+                            tag, 0);
+    }
+
+protected:
+  enum Stages
+  {
+    LENGTH,
+    PAYLOAD
+  };
+
+  int Advance(int &status)
+    {
+    if (this->Stage == PAYLOAD)
+      {
+      if (this->Name.empty())
+        {
+        this->Array->SetName(NULL);
+        }
+      else
+        {
+        this->Name.back() = '\0';
+        this->Array->SetName(&this->Name[0]);
+        }
+      status = 1;
+      return 1;
+      }
+    // The length message arrived, receive the payload it announces.
+    this->Stage = PAYLOAD;
+    if (this->Length[1] == -1)
+      {
+      // A NULL array was sent.
+      status = 1;
+      return 1;
+      }
+    if (this->Length[1] != this->Array->GetDataType())
+      {
+      vtkGenericWarningMacro("Send/receive data types do not match!");
+      status = 0;
+      return 1;
+      }
+    if (this->Length[2] < 1 || this->Length[3] < 0 || this->Length[4] < 0)
+      {
+      vtkGenericWarningMacro("Bad data length");
+      status = 0;
+      return 1;
+      }
+    this->Array->SetNumberOfComponents(static_cast<int>(this->Length[2]));
+    this->Array->SetNumberOfTuples(static_cast<vtkIdType>(this->Length[3]));
+    this->Name.resize(static_cast<size_t>(this->Length[4]));
+    if (!this->PostPayload(0))
+      {
+      status = 0;
+      return 1;
+      }
+    return 0;
+    }
+
+  // Description:
+  // Post the sends or the receives of the name and the values.
+  int PostPayload(int send)
+    {
+    int tag = static_cast<int>(this->Length[0]);
+    return (this->Name.empty() ||
+            this->PostPieces(&this->Name[0],
+                             static_cast<vtkIdType>(this->Name.size()),
+                             VTK_CHAR, this->Source, tag, send)) &&
+      this->PostPieces(this->Array->GetVoidPointer(0),
+                       this->Array->GetNumberOfTuples()*
+                       this->Array->GetNumberOfComponents(),
+                       this->Array->GetDataType(), this->Source, tag, send);
+    }
+
+  vtkSmartPointer<vtkDataArray> Array;
+  int Stage;
+  vtkTypeInt64 Length[5];
+  vtkstd::vector<char> Name;
+};
+
+//----------------------------------------------------------------------------
+// A data object sent or received with nonblocking MPI calls.  Data sets
+// are sent in the native format of vtkCommunicator, their arrays straight
+// from and into their memory, and other data objects are marshaled.  The
+// length message holds the tag of the payload, the format, the size of the
+// header and the number of messages of the payload.  The payload is the
+// header, the native header or the marshaled data object, followed by the
+// values of the arrays of the native format, all sent as bytes.
+class vtkMPICommunicatorObjectOperation
+  : public vtkMPICommunicatorMessagesOperation
+{
+public:
+  vtkMPICommunicatorObjectOperation(MPI_Comm comm)
+    : vtkMPICommunicatorMessagesOperation(comm)
+    {
+    this->Stage = LENGTH;
+    for (int i = 0; i < 4; i++)
+      {
+      this->Length[i] = 0;
+      }
+    }
+
+  // Description:
+  // Post the messages of a send of the data object, or of a NULL one.
+  int PostSend(vtkDataObject *object, int remoteProcessId, int tag)
+    {
+    this->Object = object;
+    this->Source = remoteProcessId;
+    this->Length[0] = NewPayloadTag(tag);
+    this->Length[1] = NULL_OBJECT;
+    if (object)
+      {
+      vtkMultiProcessStream header;
+      if (vtkCommunicator::GetUseNativeMarshaling() &&
+          vtkCommunicator::DescribeDataObject(object, header, this->Segments))
+        {
+        this->Length[1] = NATIVE;
+        header.GetRawData(this->Header);
+        }
+      else
+        {
+        this->Segments.clear();
+        this->Buffer = vtkSmartPointer<vtkCharArray>::New();
+        if (!vtkCommunicator::MarshalDataObject(object, this->Buffer))
+          {
+          return 0;
+          }
+        this->Length[1] = LEGACY;
+        }
+      this->Length[2] = this->GetHeaderSize();
+      this->Length[3] = CountPieces(this->GetHeaderSize()) +
+        this->CountSegmentPieces();
+      }
+    if (!this->PostPieces(this->Length, 4, VTK_TYPE_INT64, remoteProcessId,
+                          tag, 1))
+      {
+      return 0;
+      }
+    return object ? this->PostHeader(1) && this->PostSegments(1) : 1;
+    }
+
+  // Description:
+  // Post the receive of the length message for the data object.
+  int PostReceive(vtkDataObject *object, int remoteProcessId, int tag)
+    {
+    this->Object = object;
+    this->Receiving = 1;
+    this->Source = remoteProcessId;
+    if (remoteProcessId == vtkMultiProcessController::ANY_SOURCE)
+      {
+      remoteProcessId = MPI_ANY_SOURCE;
+      }
+    return this->PostPieces(this->Length, 4, VTK_TYPE_INT64, remoteProcessId,
+                            tag, 0);
+    }
+
+protected:
+  enum Formats
+  {
+    NULL_OBJECT = -1,
+    LEGACY,
+    NATIVE
+  };
+
+  enum Stages
+  {
+    LENGTH,
+    HEADER,
+    PAYLOAD
+  };
+
+  int Advance(int &status)
+    {
+    status = 0;
+    switch (this->Stage)
+      {
+      case LENGTH:
+        if (this->Length[1] == NULL_OBJECT)
+          {
+          status = 1;
+          return 1;
+          }
+        if ((this->Length[1] != LEGACY && this->Length[1] != NATIVE) ||
+            this->Length[2] < 0 || this->Length[3] < 0)
+          {
+          vtkGenericWarningMacro("Bad data length");
+          return 1;
+          }
+        this->Stage = HEADER;
+        if (this->Length[1] == LEGACY)
+          {
+          this->Buffer = vtkSmartPointer<vtkCharArray>::New();
+          this->Buffer->SetNumberOfTuples(
+            static_cast<vtkIdType>(this->Length[2]));
+          }
+        else
+          {
+          this->Header.resize(static_cast<size_t>(this->Length[2]));
+          }
+        return !this->PostHeader(0);
+
+      case HEADER:
+        if (this->Length[1] == LEGACY)
+          {
+          status = vtkCommunicator::UnMarshalDataObject(this->Buffer,
+                                                        this->Object);
+          return 1;
+          }
+        else
+          {
+          vtkMultiProcessStream header;
+          header.SetRawData(this->Header.empty() ? NULL : &this->Header[0],
+                            static_cast<unsigned int>(this->Header.size()));
+          if (!vtkCommunicator::BuildDataObject(header, this->Object,
+                                                this->Segments) ||
+              CountPieces(this->GetHeaderSize()) + this->CountSegmentPieces()
+              != this->Length[3])
+            {
+            // Take the values in flight off the tag of the payload.
+            this->Drain(this->Length[3] - CountPieces(this->GetHeaderSize()));
+            return 1;
+            }
+          }
+        this->Stage = PAYLOAD;
+        return !this->PostSegments(0);
+
+      default:
+        status = 1;
+        return 1;
+      }
+    }
+
+  vtkIdType GetHeaderSize()
+    {
+    return this->Buffer ? this->Buffer->GetNumberOfTuples()
+      : static_cast<vtkIdType>(this->Header.size());
+    }
+
+  vtkTypeInt64 CountSegmentPieces()
+    {
+    vtkTypeInt64 count = 0;
+    for (size_t i = 0; i < this->Segments.size(); i++)
+      {
+      count += CountPieces(this->GetSegmentSize(i));
+      }
+    return count;
+    }
+
+  vtkIdType GetSegmentSize(size_t i)
+    {
+    vtkDataArray *array = this->Segments[i];
+    return array->GetNumberOfTuples()*array->GetNumberOfComponents()*
+      array->GetDataTypeSize();
+    }
+
+  int PostHeader(int send)
+    {
+    void *data = this->Buffer
+      ? this->Buffer->GetVoidPointer(0)
+      : static_cast<void*>(this->Header.empty() ? NULL : &this->Header[0]);
+    return this->PostPieces(data, this->GetHeaderSize(), VTK_UNSIGNED_CHAR,
+                            this->Source, static_cast<int>(this->Length[0]),
+                            send);
+    }
+
+  int PostSegments(int send)
+    {
+    for (size_t i = 0; i < this->Segments.size(); i++)
+      {
+      if (!this->PostPieces(this->Segments[i]->GetVoidPointer(0),
+                            this->GetSegmentSize(i), VTK_UNSIGNED_CHAR,
+                            this->Source, static_cast<int>(this->Length[0]),
+                            send))
+        {
+        return 0;
+        }
+      }
+    return 1;
+    }
+
+  // Description:
+  // Receive and drop the given number of messages of the payload, which
+  // the sender has already posted.
+  void Drain(vtkTypeInt64 count)
+    {
+    int tag = static_cast<int>(this->Length[0]);
+    for (vtkTypeInt64 i = 0; i < count; i++)
+      {
+      MPI_Status mpiStatus;
+      int size = 0;
+      if (!Check(MPI_Probe(this->Source, tag, this->Comm, &mpiStatus)) ||
+          !Check(MPI_Get_count(&mpiStatus, MPI_BYTE, &size)))
+        {
+        return;
+        }
+      vtkstd::vector<unsigned char> scratch(size > 0 ? size : 1);
+      Check(MPI_Recv(&scratch[0], size, MPI_BYTE, this->Source, tag,
+                     this->Comm, &mpiStatus));
+      }
+    }
+
+  vtkSmartPointer<vtkDataObject> Object;
+  vtkSmartPointer<vtkCharArray> Buffer;
+  vtkstd::vector<unsigned char> Header;
+  vtkstd::vector<vtkDataArray*> Segments;
+  int Stage;
+  vtkTypeInt64 Length[4];
+};
+
+//----------------------------------------------------------------------------
+// Return a request for the operation, or a failed one if it could not be
+// posted.
+static vtkCommunicatorRequest *vtkMPICommunicatorNewDataRequest(
+  vtkCommunicatorRequest::Operation *op, int posted)
+{
+  vtkCommunicatorRequest *request = vtkCommunicatorRequest::New();
+  if (posted)
+    {
+    request->SetOperation(op, NULL);
+    }
+  else
+    {
+    delete op;
+    request->Complete(0);
+    }
+  return request;
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkMPICommunicator::NoBlockSend(vtkDataArray *data,
+                                                        int remoteProcessId,
+                                                        int tag)
+{
+  vtkMPICommunicatorArrayOperation *op =
+    new vtkMPICommunicatorArrayOperation(*this->MPIComm->Handle);
+  return vtkMPICommunicatorNewDataRequest(
+    op, op->PostSend(data, remoteProcessId, tag));
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkMPICommunicator::NoBlockSend(vtkDataObject *data,
+                                                        int remoteProcessId,
+                                                        int tag)
+{
+  if (vtkCompositeDataSet::SafeDownCast(data))
+    {
+    // Composite data sets are sent block by block.
+    return this->Superclass::NoBlockSend(data, remoteProcessId, tag);
+    }
+  vtkMPICommunicatorObjectOperation *op =
+    new vtkMPICommunicatorObjectOperation(*this->MPIComm->Handle);
+  return vtkMPICommunicatorNewDataRequest(
+    op, op->PostSend(data, remoteProcessId, tag));
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkMPICommunicator::NoBlockReceive(vtkDataArray *data,
+                                                           int remoteProcessId,
+                                                           int tag)
+{
+  vtkMPICommunicatorArrayOperation *op =
+    new vtkMPICommunicatorArrayOperation(*this->MPIComm->Handle);
+  return vtkMPICommunicatorNewDataRequest(
+    op, data && op->PostReceive(data, remoteProcessId, tag));
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkMPICommunicator::NoBlockReceive(
+  vtkDataObject *data, int remoteProcessId, int tag)
+{
+  if (vtkCompositeDataSet::SafeDownCast(data))
+    {
+    return this->Superclass::NoBlockReceive(data, remoteProcessId, tag);
+    }
+  vtkMPICommunicatorObjectOperation *op =
+    new vtkMPICommunicatorObjectOperation(*this->MPIComm->Handle);
+  return vtkMPICommunicatorNewDataRequest(
+    op, data && op->PostReceive(data, remoteProcessId, tag));
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkMPICommunicator::NoBlockSendVoidArray(
+  const void *data, vtkIdType length, int type, int remoteProcessId, int tag)
+{
+  if (length >= VTK_INT_MAX)
+    {
+    // Leave messages MPI cannot count in an int to the blocking send.
+    return this->Superclass::NoBlockSendVoidArray(data, length, type,
+                                                  remoteProcessId, tag);
+    }
+  vtkMPICommunicatorRequestOperation *op =
+    new vtkMPICommunicatorRequestOperation;
+  vtkCommunicatorRequest *request = vtkCommunicatorRequest::New();
+  if (CheckForMPIError(
+        MPI_Isend(const_cast<void*>(data), static_cast<int>(length),
+                  vtkMPICommunicatorGetMPIType(type), remoteProcessId, tag,
+                  *this->MPIComm->Handle, &op->Req.Req->Handle)))
+    {
+    request->SetOperation(op, NULL);
+    }
+  else
+    {
+    delete op;
+    request->Complete(0);
+    }
+  return request;
+}
+
+//----------------------------------------------------------------------------
+vtkCommunicatorRequest *vtkMPICommunicator::NoBlockReceiveVoidArray(
+  void *data, vtkIdType maxlength, int type, int remoteProcessId, int tag)
+{
+  if (this->HasQueuedRequests() || maxlength >= VTK_INT_MAX)
+    {
+    return this->Superclass::NoBlockReceiveVoidArray(data, maxlength, type,
+                                                     remoteProcessId, tag);
+    }
+  if (remoteProcessId == vtkMultiProcessController::ANY_SOURCE)
+    {
+    remoteProcessId = MPI_ANY_SOURCE;
+    }
+  vtkMPICommunicatorRequestOperation *op =
+    new vtkMPICommunicatorRequestOperation;
+  vtkCommunicatorRequest *request = vtkCommunicatorRequest::New();
+  if (CheckForMPIError(
+        MPI_Irecv(data, static_cast<int>(maxlength),
+                  vtkMPICommunicatorGetMPIType(type), remoteProcessId, tag,
+                  *this->MPIComm->Handle, &op->Req.Req->Handle)))
+    {
+    request->SetOperation(op, NULL);
+    }
+  else
+    {
+    delete op;
+    request->Complete(0);
+    }
+  return request;
+}
+
 //----------------------------------------------------------------------------
 vtkMPICommunicator::Request::Request()
 {
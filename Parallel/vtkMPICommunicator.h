@@ -126,6 +126,36 @@ public:
                      int tag, Request& req);
 #endif
 
+  // Description:
+  // The request based nonblocking methods of vtkCommunicator.  They post
+  // MPI_Isend and MPI_Irecv, so they overlap with computation.  A data
+  // array or data object is sent as a message with its length followed by
+  // its payload, so it must be received with NoBlockReceive(), not with the
+  // blocking Receive(), and the reverse.  Data sets go in the native format
+  // (see vtkCommunicator::SetUseNativeMarshaling()): their arrays are sent
+  // from and received into their own memory, without copies, and their
+  // cells keep their storage.  Composite data sets and raw
+  // arrays of VTK_INT_MAX values or more fall back to
+  // vtkCommunicator::NoBlockSend() and its companions.
+  virtual vtkCommunicatorRequest *NoBlockSend(vtkDataObject *data,
+                                              int remoteProcessId, int tag);
+  virtual vtkCommunicatorRequest *NoBlockSend(vtkDataArray *data,
+                                              int remoteProcessId, int tag);
+  virtual vtkCommunicatorRequest *NoBlockReceive(vtkDataObject *data,
+                                                 int remoteProcessId, int tag);
+  virtual vtkCommunicatorRequest *NoBlockReceive(vtkDataArray *data,
+                                                 int remoteProcessId, int tag);
+  virtual vtkCommunicatorRequest *NoBlockSendVoidArray(const void *data,
+                                                       vtkIdType length,
+                                                       int type,
+                                                       int remoteProcessId,
+                                                       int tag);
+  virtual vtkCommunicatorRequest *NoBlockReceiveVoidArray(void *data,
+                                                          vtkIdType maxlength,
+                                                          int type,
+                                                          int remoteProcessId,
+                                                          int tag);
+
 
   // Description:
   // More efficient implementations of collective operations that use
@@ -176,6 +176,21 @@ public:
         (data, length, remoteProcessId, tag, req); }
 #endif
 
+  // Description:
+  // The request based nonblocking methods of vtkMultiProcessController.
+  vtkCommunicatorRequest *NoBlockSend(vtkDataObject *data,
+                                      int remoteProcessId, int tag)
+    { return this->Superclass::NoBlockSend(data, remoteProcessId, tag); }
+  vtkCommunicatorRequest *NoBlockSend(vtkDataArray *data,
+                                      int remoteProcessId, int tag)
+    { return this->Superclass::NoBlockSend(data, remoteProcessId, tag); }
+  vtkCommunicatorRequest *NoBlockReceive(vtkDataObject *data,
+                                         int remoteProcessId, int tag)
+    { return this->Superclass::NoBlockReceive(data, remoteProcessId, tag); }
+  vtkCommunicatorRequest *NoBlockReceive(vtkDataArray *data,
+                                         int remoteProcessId, int tag)
+    { return this->Superclass::NoBlockReceive(data, remoteProcessId, tag); }
+
 //ETX
 
   static const char* GetProcessorName();
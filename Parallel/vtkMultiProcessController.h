@@ -390,9 +390,62 @@ public:
   // received etc. The return value is valid only after a successful Receive().
   vtkIdType GetCount();
 
+  // Description:
+  // Nonblocking versions of Send() and Receive().  They return a request
+  // that the caller must delete.  See vtkCommunicator::NoBlockSend().
+  vtkCommunicatorRequest *NoBlockSend(vtkDataObject *data, int remoteId,
+                                      int tag) {
+    return this->Communicator->NoBlockSend(data, remoteId, tag);
+  }
+  vtkCommunicatorRequest *NoBlockSend(vtkDataArray *data, int remoteId,
+                                      int tag) {
+    return this->Communicator->NoBlockSend(data, remoteId, tag);
+  }
+  vtkCommunicatorRequest *NoBlockReceive(vtkDataObject *data, int remoteId,
+                                         int tag) {
+    return this->Communicator->NoBlockReceive(data, remoteId, tag);
+  }
+  vtkCommunicatorRequest *NoBlockReceive(vtkDataArray *data, int remoteId,
+                                         int tag) {
+    return this->Communicator->NoBlockReceive(data, remoteId, tag);
+  }
+
 
   //---------------------- Collective Operations ----------------------
 
+  // Description:
+  // Nonblocking versions of Barrier(), Broadcast(), Gather(), Reduce() and
+  // AllReduce().  See vtkCommunicator::NoBlockBroadcast().
+  vtkCommunicatorRequest *NoBlockBarrier() {
+    return this->Communicator->NoBlockBarrier();
+  }
+  vtkCommunicatorRequest *NoBlockBroadcast(vtkDataObject *data,
+                                           int srcProcessId) {
+    return this->Communicator->NoBlockBroadcast(data, srcProcessId);
+  }
+  vtkCommunicatorRequest *NoBlockBroadcast(vtkDataArray *data,
+                                           int srcProcessId) {
+    return this->Communicator->NoBlockBroadcast(data, srcProcessId);
+  }
+  vtkCommunicatorRequest *NoBlockGather(vtkDataArray *sendBuffer,
+                                        vtkDataArray *recvBuffer,
+                                        int destProcessId) {
+    return this->Communicator->NoBlockGather(sendBuffer, recvBuffer,
+                                             destProcessId);
+  }
+  vtkCommunicatorRequest *NoBlockReduce(vtkDataArray *sendBuffer,
+                                        vtkDataArray *recvBuffer,
+                                        int operation, int destProcessId) {
+    return this->Communicator->NoBlockReduce(sendBuffer, recvBuffer,
+                                             operation, destProcessId);
+  }
+  vtkCommunicatorRequest *NoBlockAllReduce(vtkDataArray *sendBuffer,
+                                           vtkDataArray *recvBuffer,
+                                           int operation) {
+    return this->Communicator->NoBlockAllReduce(sendBuffer, recvBuffer,
+                                                operation);
+  }
+
   // Description:
   // Broadcast sends the array in the process with id \c srcProcessId to all of
   // the other processes.  All processes must call these method with the same
@@ -262,6 +262,19 @@ void vtkPStreamTracer::SendCellPoint(vtkPolyData* togo,
   copy->Delete();
 }
 
+void vtkPStreamTracer::FillGaps(vtkPolyData *output)
+{
+  int myid = this->Controller->GetLocalProcessId();
+  if (myid == 0)
+    {
+    this->SendFirstPoints(output);
+    }
+  else
+    {
+    this->ReceiveLastPoints(output);
+    }
+}
+
 int vtkPStreamTracer::RequestUpdateExtent(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **inputVector,
@@ -413,15 +426,7 @@ int vtkPStreamTracer::RequestData(
 
   // Fill the gaps between streamlines.
   output->BuildCells();
-  int myid = this->Controller->GetLocalProcessId();
-  if (myid == 0)
-    {
-    this->SendFirstPoints(output);
-    }
-  else
-    {
-    this->ReceiveLastPoints(output);
-    }
+  this->FillGaps(output);
 
   if (this->Seeds) 
     {
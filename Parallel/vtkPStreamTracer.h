@@ -72,6 +72,13 @@ protected:
 
   virtual void ParallelIntegrate() = 0;
 
+  // Description:
+  // Close the gaps between pieces of a streamline that were integrated
+  // on different processes.  Called on all processes once the streamlines
+  // have been appended.  The default passes the first points from one
+  // process to the next with SendFirstPoints() and ReceiveLastPoints().
+  virtual void FillGaps(vtkPolyData *output);
+
   vtkDataArray* Seeds;
   vtkIdList* SeedIds;
   vtkIntArray* IntegrationDirections;
@@ -0,0 +1,496 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkRadixKCompositer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkRadixKCompositer.h"
+
+#include "vtkCommunicator.h"
+#include "vtkCommunicatorRequest.h"
+#include "vtkFloatArray.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <vtkstd/vector>
+
+vtkStandardNewMacro(vtkRadixKCompositer);
+
+// Tags of the messages exchanged within rounds and of the pieces
+// gathered on process 0.
+#define VTK_RADIXK_ROUND_TAG  96
+#define VTK_RADIXK_GATHER_TAG 97
+
+// Pixels of 3 and 4 unsigned chars and of 4 floats, copied as a whole.
+template <int N>
+struct vtkRadixKPixel
+{
+  unsigned char Bytes[N];
+};
+
+//-------------------------------------------------------------------------
+// Rounds a length in bytes up to a multiple of the size of an int.
+static vtkIdType vtkRadixKAlign(vtkIdType length)
+{
+  vtkIdType align = static_cast<vtkIdType>(sizeof(int));
+  return (length + align - 1) / align * align;
+}
+
+//-------------------------------------------------------------------------
+// The maximum length, in bytes, of n encoded pixels of the given size,
+// rounded up to keep the following encodings aligned.
+static vtkIdType vtkRadixKMaximumLength(vtkIdType n, int pixelSize)
+{
+  vtkIdType length = static_cast<vtkIdType>(sizeof(int)) * (2 + 2*(n/2 + 1)) +
+    n * (static_cast<vtkIdType>(sizeof(float)) + pixelSize);
+  return vtkRadixKAlign(length);
+}
+
+//-------------------------------------------------------------------------
+// Encodes n pixels into out and returns the length in bytes.  The
+// encoding starts with the number of runs and of active pixels, followed
+// by the runs as pairs of counts of background and active pixels, the
+// depths of the active pixels and their colors.
+template <class P>
+static vtkIdType vtkRadixKEncodePixels(const float *z, const P *p,
+                                       vtkIdType n, unsigned char *out)
+{
+  int numRuns = 0;
+  int numActive = 0;
+  vtkIdType i = 0;
+  while (i < n)
+    {
+    while (i < n && z[i] >= 1.0f)
+      {
+      ++i;
+      }
+    while (i < n && z[i] < 1.0f)
+      {
+      ++i;
+      ++numActive;
+      }
+    ++numRuns;
+    }
+
+  int *runs = reinterpret_cast<int*>(out);
+  *runs++ = numRuns;
+  *runs++ = numActive;
+  float *outZ = reinterpret_cast<float*>(runs + 2 * numRuns);
+  P *outP = reinterpret_cast<P*>(outZ + numActive);
+  i = 0;
+  while (i < n)
+    {
+    vtkIdType start = i;
+    while (i < n && z[i] >= 1.0f)
+      {
+      ++i;
+      }
+    *runs++ = static_cast<int>(i - start);
+    start = i;
+    while (i < n && z[i] < 1.0f)
+      {
+      *outZ++ = z[i];
+      *outP++ = p[i];
+      ++i;
+      }
+    *runs++ = static_cast<int>(i - start);
+    }
+  return reinterpret_cast<unsigned char*>(outP) - out;
+}
+
+//-------------------------------------------------------------------------
+// Composites encoded pixels over z and p.  A remote pixel replaces the
+// local one when it is nearer, or as near and remoteFirst is set, that is
+// when it comes from lower processes.
+template <class P>
+static void vtkRadixKCompositePixels(const unsigned char *in, float *z,
+                                     P *p, int remoteFirst)
+{
+  const int *runs = reinterpret_cast<const int*>(in);
+  int numRuns = *runs++;
+  int numActive = *runs++;
+  const float *inZ = reinterpret_cast<const float*>(runs + 2 * numRuns);
+  const P *inP = reinterpret_cast<const P*>(inZ + numActive);
+  vtkIdType i = 0;
+  for (int r = 0; r < numRuns; ++r)
+    {
+    i += runs[2 * r];
+    vtkIdType end = i + runs[2 * r + 1];
+    if (remoteFirst)
+      {
+      for (; i < end; ++i, ++inZ, ++inP)
+        {
+        if (*inZ <= z[i])
+          {
+          z[i] = *inZ;
+          p[i] = *inP;
+          }
+        }
+      }
+    else
+      {
+      for (; i < end; ++i, ++inZ, ++inP)
+        {
+        if (*inZ < z[i])
+          {
+          z[i] = *inZ;
+          p[i] = *inP;
+          }
+        }
+      }
+    }
+}
+
+//-------------------------------------------------------------------------
+// Calls the templated functions above for the size of the pixels.
+static vtkIdType vtkRadixKEncode(int pixelSize, const float *z,
+                                 const void *p, vtkIdType start,
+                                 vtkIdType n, unsigned char *out)
+{
+  switch (pixelSize)
+    {
+    case 3:
+      return vtkRadixKEncodePixels(
+        z + start, static_cast<const vtkRadixKPixel<3>*>(p) + start, n, out);
+    case 4:
+      return vtkRadixKEncodePixels(
+        z + start, static_cast<const vtkRadixKPixel<4>*>(p) + start, n, out);
+    default:
+      return vtkRadixKEncodePixels(
+        z + start, static_cast<const vtkRadixKPixel<16>*>(p) + start, n, out);
+    }
+}
+
+static void vtkRadixKComposite(int pixelSize, const unsigned char *in,
+                               float *z, void *p, vtkIdType start,
+                               int remoteFirst)
+{
+  switch (pixelSize)
+    {
+    case 3:
+      vtkRadixKCompositePixels(
+        in, z + start, static_cast<vtkRadixKPixel<3>*>(p) + start,
+        remoteFirst);
+      break;
+    case 4:
+      vtkRadixKCompositePixels(
+        in, z + start, static_cast<vtkRadixKPixel<4>*>(p) + start,
+        remoteFirst);
+      break;
+    default:
+      vtkRadixKCompositePixels(
+        in, z + start, static_cast<vtkRadixKPixel<16>*>(p) + start,
+        remoteFirst);
+      break;
+    }
+}
+
+//-------------------------------------------------------------------------
+// Splits numProcs into the group sizes of the rounds: its prime factors,
+// in increasing order, multiplied together as long as they fit in radix.
+static void vtkRadixKRounds(int numProcs, int radix,
+                            vtkstd::vector<int> &rounds)
+{
+  rounds.clear();
+  int size = 1;
+  int factor = 2;
+  while (numProcs > 1)
+    {
+    if (factor * factor > numProcs)
+      {
+      factor = numProcs;
+      }
+    if (numProcs % factor)
+      {
+      ++factor;
+      continue;
+      }
+    numProcs /= factor;
+    if (size > 1 && size * factor > radix)
+      {
+      rounds.push_back(size);
+      size = 1;
+      }
+    size *= factor;
+    }
+  if (size > 1)
+    {
+    rounds.push_back(size);
+    }
+}
+
+//-------------------------------------------------------------------------
+// The first pixel of piece i of k of the length pixels starting at start.
+static vtkIdType vtkRadixKPieceStart(vtkIdType start, vtkIdType length,
+                                     int i, int k)
+{
+  vtkIdType extra = length % k;
+  return start + (length / k) * i + (i < extra ? i : extra);
+}
+
+//-------------------------------------------------------------------------
+// The pixels process id owns after the rounds.  After round r, the
+// processes sharing a piece are the blocks of consecutive ids of the
+// size of the product of the groups so far.
+static void vtkRadixKRegion(const vtkstd::vector<int> &rounds, int id,
+                            vtkIdType numPixels,
+                            vtkIdType &start, vtkIdType &end)
+{
+  start = 0;
+  end = numPixels;
+  int stride = 1;
+  for (size_t r = 0; r < rounds.size(); ++r)
+    {
+    int k = rounds[r];
+    int member = (id / stride) % k;
+    vtkIdType length = end - start;
+    end = vtkRadixKPieceStart(start, length, member + 1, k);
+    start = vtkRadixKPieceStart(start, length, member, k);
+    stride *= k;
+    }
+}
+
+//-------------------------------------------------------------------------
+vtkRadixKCompositer::vtkRadixKCompositer()
+{
+  this->Radix = 8;
+  this->SendBuffer = vtkUnsignedCharArray::New();
+  this->ReceiveBuffer = vtkUnsignedCharArray::New();
+}
+
+//-------------------------------------------------------------------------
+vtkRadixKCompositer::~vtkRadixKCompositer()
+{
+  vtkCompositer::DeleteArray(this->SendBuffer);
+  vtkCompositer::DeleteArray(this->ReceiveBuffer);
+}
+
+//-------------------------------------------------------------------------
+void vtkRadixKCompositer::CompositeBuffer(vtkDataArray *pBuf,
+                                          vtkFloatArray *zBuf,
+                                          vtkDataArray *vtkNotUsed(pTmp),
+                                          vtkFloatArray *vtkNotUsed(zTmp))
+{
+  int myId = this->Controller->GetLocalProcessId();
+  int numProcs = this->NumberOfProcesses;
+  if (numProcs <= 1 || myId >= numProcs)
+    {
+    return;
+    }
+
+  int pixelSize;
+  if (pBuf->GetDataType() == VTK_UNSIGNED_CHAR &&
+      (pBuf->GetNumberOfComponents() == 3 ||
+       pBuf->GetNumberOfComponents() == 4))
+    {
+    pixelSize = pBuf->GetNumberOfComponents();
+    }
+  else if (pBuf->GetDataType() == VTK_FLOAT &&
+           pBuf->GetNumberOfComponents() == 4)
+    {
+    pixelSize = 4 * static_cast<int>(sizeof(float));
+    }
+  else
+    {
+    vtkErrorMacro("Unexpected pixel type.");
+    return;
+    }
+
+  vtkCommunicator *comm = this->Controller->GetCommunicator();
+  vtkIdType numPixels = zBuf->GetNumberOfTuples();
+  float *z = zBuf->GetPointer(0);
+  void *p = pBuf->GetVoidPointer(0);
+
+  vtkstd::vector<int> rounds;
+  vtkRadixKRounds(numProcs, this->Radix, rounds);
+
+  vtkstd::vector<vtkCommunicatorRequest*> sends;
+  vtkstd::vector<vtkCommunicatorRequest*> receives;
+  vtkstd::vector<vtkIdType> receiveOffsets;
+  vtkIdType start = 0;
+  vtkIdType end = numPixels;
+  int stride = 1;
+  int ok = 1;
+  for (size_t r = 0; r < rounds.size(); ++r)
+    {
+    int k = rounds[r];
+    int me = (myId / stride) % k;
+    int first = myId - me * stride;
+    vtkIdType length = end - start;
+
+    // Encode the pieces of the other members.
+    vtkIdType sendLength = 0;
+    vtkIdType maxPiece = 0;
+    int i;
+    for (i = 0; i < k; ++i)
+      {
+      vtkIdType n = vtkRadixKPieceStart(start, length, i + 1, k) -
+        vtkRadixKPieceStart(start, length, i, k);
+      sendLength += (i == me) ? 0 : vtkRadixKMaximumLength(n, pixelSize);
+      maxPiece = (n > maxPiece) ? n : maxPiece;
+      }
+    vtkIdType slotLength = vtkRadixKMaximumLength(maxPiece, pixelSize);
+    vtkCompositer::ResizeUnsignedCharArray(this->SendBuffer, 1, sendLength);
+    vtkCompositer::ResizeUnsignedCharArray(this->ReceiveBuffer, 1,
+                                           slotLength * (k - 1));
+    unsigned char *sendBuf = this->SendBuffer->GetPointer(0);
+    unsigned char *receiveBuf = this->ReceiveBuffer->GetPointer(0);
+
+    // Requests are started in the order of the pairs of members, a
+    // member sending to higher members first and receiving from lower
+    // ones first.  Communicators that emulate the requests carry them out
+    // with blocking calls, so a queued receive is completed before the
+    // next pair starts: the pairs then exchange one after the other, in
+    // the same order on every member.
+    sends.assign(k, static_cast<vtkCommunicatorRequest*>(NULL));
+    receives.assign(k, static_cast<vtkCommunicatorRequest*>(NULL));
+    receiveOffsets.assign(k, 0);
+    vtkIdType offset = 0;
+    for (i = 0; i < k; ++i)
+      {
+      if (i == me)
+        {
+        continue;
+        }
+      int remote = first + i * stride;
+      vtkIdType pieceStart = vtkRadixKPieceStart(start, length, i, k);
+      vtkIdType n = vtkRadixKPieceStart(start, length, i + 1, k) - pieceStart;
+      vtkIdType encoded = vtkRadixKEncode(pixelSize, z, p, pieceStart, n,
+                                          sendBuf + offset);
+      receiveOffsets[i] = slotLength * (i < me ? i : i - 1);
+      if (i > me)
+        {
+        sends[i] = comm->NoBlockSendVoidArray(
+          sendBuf + offset, encoded, VTK_UNSIGNED_CHAR, remote,
+          VTK_RADIXK_ROUND_TAG);
+        }
+      receives[i] = comm->NoBlockReceiveVoidArray(
+        receiveBuf + receiveOffsets[i], slotLength, VTK_UNSIGNED_CHAR,
+        remote, VTK_RADIXK_ROUND_TAG);
+      if (receives[i]->GetQueued())
+        {
+        receives[i]->Wait();
+        }
+      if (i < me)
+        {
+        sends[i] = comm->NoBlockSendVoidArray(
+          sendBuf + offset, encoded, VTK_UNSIGNED_CHAR, remote,
+          VTK_RADIXK_ROUND_TAG);
+        }
+      offset += vtkRadixKAlign(encoded);
+      }
+
+    // Composite the pieces as they arrive: lower members from the
+    // nearest down, as they win ties, then higher members from the
+    // nearest up, as they lose them.
+    vtkIdType myStart = vtkRadixKPieceStart(start, length, me, k);
+    for (i = me - 1; i >= 0; --i)
+      {
+      if (receives[i]->Wait())
+        {
+        vtkRadixKComposite(pixelSize, receiveBuf + receiveOffsets[i],
+                           z, p, myStart, 1);
+        }
+      else
+        {
+        ok = 0;
+        }
+      }
+    for (i = me + 1; i < k; ++i)
+      {
+      if (receives[i]->Wait())
+        {
+        vtkRadixKComposite(pixelSize, receiveBuf + receiveOffsets[i],
+                           z, p, myStart, 0);
+        }
+      else
+        {
+        ok = 0;
+        }
+      }
+    ok &= vtkCommunicatorRequest::WaitAll(k, &sends[0]);
+    for (i = 0; i < k; ++i)
+      {
+      if (sends[i])
+        {
+        sends[i]->Delete();
+        receives[i]->Delete();
+        }
+      }
+
+    end = vtkRadixKPieceStart(start, length, me + 1, k);
+    start = myStart;
+    stride *= k;
+    }
+
+  // Gather the pieces on process 0.  The composited pixels are never
+  // farther than the ones of process 0, so it keeps its own pixels where
+  // the pieces have background.
+  if (myId != 0)
+    {
+    vtkCompositer::ResizeUnsignedCharArray(
+      this->SendBuffer, 1, vtkRadixKMaximumLength(end - start, pixelSize));
+    unsigned char *sendBuf = this->SendBuffer->GetPointer(0);
+    vtkIdType encoded = vtkRadixKEncode(pixelSize, z, p, start,
+                                        end - start, sendBuf);
+    ok &= comm->Send(sendBuf, encoded, 0, VTK_RADIXK_GATHER_TAG);
+    }
+  else
+    {
+    vtkstd::vector<vtkIdType> starts(numProcs);
+    receiveOffsets.assign(numProcs + 1, 0);
+    int id;
+    for (id = 1; id < numProcs; ++id)
+      {
+      vtkIdType idEnd;
+      vtkRadixKRegion(rounds, id, numPixels, starts[id], idEnd);
+      receiveOffsets[id + 1] = receiveOffsets[id] +
+        vtkRadixKMaximumLength(idEnd - starts[id], pixelSize);
+      }
+    vtkCompositer::ResizeUnsignedCharArray(this->ReceiveBuffer, 1,
+                                           receiveOffsets[numProcs]);
+    unsigned char *receiveBuf = this->ReceiveBuffer->GetPointer(0);
+    receives.assign(numProcs, static_cast<vtkCommunicatorRequest*>(NULL));
+    for (id = 1; id < numProcs; ++id)
+      {
+      receives[id] = comm->NoBlockReceiveVoidArray(
+        receiveBuf + receiveOffsets[id],
+        receiveOffsets[id + 1] - receiveOffsets[id], VTK_UNSIGNED_CHAR,
+        id, VTK_RADIXK_GATHER_TAG);
+      }
+    for (id = 1; id < numProcs; ++id)
+      {
+      if (receives[id]->Wait())
+        {
+        vtkRadixKComposite(pixelSize, receiveBuf + receiveOffsets[id],
+                           z, p, starts[id], 1);
+        }
+      else
+        {
+        ok = 0;
+        }
+      receives[id]->Delete();
+      }
+    }
+
+  if (!ok)
+    {
+    vtkErrorMacro("Could not exchange the image pieces.");
+    }
+}
+
+//-------------------------------------------------------------------------
+void vtkRadixKCompositer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Radix: " << this->Radix << endl;
+}
@@ -0,0 +1,81 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkRadixKCompositer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkRadixKCompositer - Implements radix-k (and binary swap) compositing.
+//
+// .SECTION Description
+// vtkRadixKCompositer composites the color and depth buffers of all
+// processes into the buffers of process 0, like vtkTreeCompositer, but
+// every process composites a part of the image.  The processes are split
+// into groups of at most Radix processes (more when the number of
+// processes has a larger prime factor) in a sequence of rounds.  In a
+// round, the part of the image owned by a group is cut into one piece
+// per member, and every member receives its piece from all the others
+// and composites it.  The pieces are then gathered on process 0.  With a
+// Radix of 2 this is binary swap compositing.  The amount of data a
+// process sends shrinks as the number of processes grows, while the tree
+// compositers send whole images to the root.
+//
+// Only active pixels, whose depth is less than 1, are sent, with run
+// lengths of background pixels.  The composited image on process 0 is
+// the same as the one of vtkTreeCompositer: the nearest pixel wins, and
+// the lowest process on a tie.  Messages are exchanged with the NoBlock
+// methods of vtkCommunicator, so pieces are composited while others are
+// still in transit when the communicator supports it (as
+// vtkMPICommunicator does).  It will not handle transparency.
+//
+// .SECTION See Also
+// vtkCompositer vtkTreeCompositer vtkCompressCompositer
+// vtkCompositeRenderManager
+
+#ifndef __vtkRadixKCompositer_h
+#define __vtkRadixKCompositer_h
+
+#include "vtkCompositer.h"
+
+class vtkUnsignedCharArray;
+
+class VTK_PARALLEL_EXPORT vtkRadixKCompositer : public vtkCompositer
+{
+public:
+  static vtkRadixKCompositer *New();
+  vtkTypeMacro(vtkRadixKCompositer,vtkCompositer);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  virtual void CompositeBuffer(vtkDataArray *pBuf, vtkFloatArray *zBuf,
+                               vtkDataArray *pTmp, vtkFloatArray *zTmp);
+
+  // Description:
+  // The largest number of processes exchanging pieces in a round, unless
+  // the number of processes has a larger prime factor.  2 gives binary
+  // swap; larger values make fewer, smaller messages.  The default is 8.
+  vtkSetClampMacro(Radix, int, 2, VTK_INT_MAX);
+  vtkGetMacro(Radix, int);
+
+protected:
+  vtkRadixKCompositer();
+  ~vtkRadixKCompositer();
+
+  int Radix;
+
+  // Encoded pieces being sent and received.
+  vtkUnsignedCharArray *SendBuffer;
+  vtkUnsignedCharArray *ReceiveBuffer;
+
+private:
+  vtkRadixKCompositer(const vtkRadixKCompositer&); // Not implemented
+  void operator=(const vtkRadixKCompositer&); // Not implemented
+};
+
+#endif
@@ -177,6 +177,20 @@ int vtkSocketCommunicator::LogToFile(const char* name, int append)
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+int vtkSocketCommunicator::RemoteHasSameIdTypeSize(int vtkNotUsed(remoteHandle))
+{
+  if (this->RemoteHas64BitIds < 0)
+    {
+    return 1;
+    }
+#ifdef VTK_USE_64BIT_IDS
+  return this->RemoteHas64BitIds ? 1 : 0;
+#else
+  return this->RemoteHas64BitIds ? 0 : 1;
+#endif
+}
+
 //-----------------------------------------------------------------------------
 int vtkSocketCommunicator::SendVoidArray(const void *data, vtkIdType length,
                                          int type, int remoteProcessId, int tag)
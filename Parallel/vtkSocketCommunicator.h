@@ -193,6 +193,11 @@ public:
 //BTX
 protected:
 
+  // Description:
+  // Compare the size of vtkIdType with the one the remote reported in the
+  // handshake.  Without a handshake, the sizes are assumed to match.
+  virtual int RemoteHasSameIdTypeSize(int remoteHandle);
+
   vtkClientSocket* Socket;
   int SwapBytesInReceivedData;
   int RemoteHas64BitIds;